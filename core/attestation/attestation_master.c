@@ -118,27 +118,87 @@ release_cert_store:
 }
 
 /**
- * Load and authenticate certifcate chain then return leaf certificate public key.
+ * Discard all cached information for a device certificate chain.
+ *
+ * @param attestation The attestation manager to utilize.
+ * @param cache The cache entry to invalidate.
+ */
+static void attestation_invalidate_chain_cache (struct attestation_master *attestation,
+	struct attestation_chain_cache *cache)
+{
+	platform_free (cache->digests);
+	cache->digests = NULL;
+
+	if (cache->key_valid &&
+		(attestation->encryption_algorithm == ATTESTATION_ECDHE_KEY_EXCHANGE)) {
+		attestation->ecc->release_key_pair (attestation->ecc, NULL, &cache->key.ecc);
+	}
+
+	cache->key_valid = false;
+}
+
+/**
+ * Get the cache entry for a device certificate chain.  If the chain or the RIoT CA certificates
+ * have changed since the cache was populated, any cached information will be discarded.
+ *
+ * @param attestation The attestation manager to utilize.
+ * @param device_num Device number.
+ * @param chain The current certificate chain for the device.
+ * @param cache Output for the cache entry for the device.
+ *
+ * @return 0 if the cache entry was found or an error code.
+ */
+static int attestation_get_chain_cache (struct attestation_master *attestation, int device_num,
+	const struct device_manager_cert_chain *chain, struct attestation_chain_cache **cache)
+{
+	uint32_t ca_version;
+
+	if (device_num >= attestation->num_devices) {
+		return ATTESTATION_INVALID_DEVICE_NUM;
+	}
+
+	*cache = &attestation->chain_cache[device_num];
+	ca_version = riot_key_manager_get_ca_version (attestation->riot);
+
+	if (((*cache)->version != chain->version) || ((*cache)->ca_version != ca_version)) {
+		attestation_invalidate_chain_cache (attestation, *cache);
+		(*cache)->version = chain->version;
+		(*cache)->ca_version = ca_version;
+	}
+
+	return 0;
+}
+
+/**
+ * Load and authenticate certifcate chain then return leaf certificate public key.  The chain will
+ * only be authenticated if there is no key already cached for it.
  *
  * @param attestation The attestation manager to utilize.
  * @param chain Certificate chain buffer.
- * @param key Output ECC public key.
+ * @param cache Cache entry for the certificate chain that will hold the ECC public key.
  *
  * @return 0 if completed successfully or an error code.
  */
 static int attestation_verify_and_load_ecc_leaf_key (struct attestation_master *attestation,
-	struct device_manager_cert_chain *chain, struct ecc_public_key *key)
+	struct device_manager_cert_chain *chain, struct attestation_chain_cache *cache)
 {
 	uint8_t *der;
 	size_t length;
 	int status;
 
+	if (cache->key_valid) {
+		return 0;
+	}
+
 	status = attestation_verify_and_load_leaf_key (attestation, chain, &der, &length);
 	if (status != 0) {
 		return status;
 	}
 
-	status = attestation->ecc->init_public_key (attestation->ecc, der, length, key);
+	status = attestation->ecc->init_public_key (attestation->ecc, der, length, &cache->key.ecc);
+	if (status == 0) {
+		cache->key_valid = true;
+	}
 
 	platform_free (der);
 
@@ -146,27 +206,35 @@ static int attestation_verify_and_load_ecc_leaf_key (struct attestation_master *
 }
 
 /**
- * Load and authenticate certifcate chain then return leaf certificate public key.
+ * Load and authenticate certifcate chain then return leaf certificate public key.  The chain will
+ * only be authenticated if there is no key already cached for it.
  *
  * @param attestation The attestation manager to utilize.
  * @param chain Certificate chain buffer.
- * @param key Output RSA public key.
+ * @param cache Cache entry for the certificate chain that will hold the RSA public key.
  *
  * @return 0 if completed successfully or an error code.
  */
 static int attestation_verify_and_load_rsa_leaf_key (struct attestation_master *attestation,
-	struct device_manager_cert_chain *chain, struct rsa_public_key *key)
+	struct device_manager_cert_chain *chain, struct attestation_chain_cache *cache)
 {
 	uint8_t *der;
 	size_t length;
 	int status;
 
+	if (cache->key_valid) {
+		return 0;
+	}
+
 	status = attestation_verify_and_load_leaf_key (attestation, chain, &der, &length);
 	if (status != 0) {
 		return status;
 	}
 
-	status = attestation->rsa->init_public_key (attestation->rsa, key, der, length);
+	status = attestation->rsa->init_public_key (attestation->rsa, &cache->key.rsa, der, length);
+	if (status == 0) {
+		cache->key_valid = true;
+	}
 
 	platform_free (der);
 
@@ -174,50 +242,46 @@ static int attestation_verify_and_load_rsa_leaf_key (struct attestation_master *
 }
 
 /**
- * Generate digests for certificates in device certificate chain
+ * Generate digests for certificates in device certificate chain.  The digests will only be
+ * calculated if they are not already cached for the chain.
  *
  * @param attestation The attestation manager to utilize.
- * @param device_num Device number.
- * @param digest_buffer Output digest buffer. CALLER MUST FREE.
+ * @param chain The device certificate chain.
+ * @param cache Cache entry for the certificate chain that will hold the digests.
  *
  * @return 0 if the digests were successfully computed or an error code.
  */
 static int attestation_get_chain_digests (struct attestation_master *attestation,
-	uint8_t device_num, struct attestation_chain_digest *digests)
+	struct device_manager_cert_chain *chain, struct attestation_chain_cache *cache)
 {
-	struct device_manager_cert_chain chain;
 	uint8_t i_cert;
 	int status;
 
-	status = device_manager_get_device_cert_chain (attestation->device_manager, device_num,
-		&chain);
-	if (status != 0) {
-		return status;
+	if (cache->digests != NULL) {
+		return 0;
 	}
 
-	digests->digest = platform_calloc (chain.num_cert, SHA256_HASH_LENGTH);
-	if (digests->digest == NULL) {
+	cache->digests = platform_calloc (chain->num_cert, SHA256_HASH_LENGTH);
+	if (cache->digests == NULL) {
 		return ATTESTATION_NO_MEMORY;
 	}
 
-	for (i_cert = 0; i_cert < chain.num_cert; ++i_cert) {
-		if ((chain.cert[i_cert].cert == NULL) || (chain.cert[i_cert].length == 0)) {
+	for (i_cert = 0; i_cert < chain->num_cert; ++i_cert) {
+		if ((chain->cert[i_cert].cert == NULL) || (chain->cert[i_cert].length == 0)) {
 			continue;
 		}
 
-		status = attestation->hash->calculate_sha256 (attestation->hash, chain.cert[i_cert].cert,
-			chain.cert[i_cert].length, &digests->digest[i_cert * SHA256_HASH_LENGTH],
+		status = attestation->hash->calculate_sha256 (attestation->hash, chain->cert[i_cert].cert,
+			chain->cert[i_cert].length, &cache->digests[i_cert * SHA256_HASH_LENGTH],
 			SHA256_HASH_LENGTH);
 		if (status != 0) {
-			platform_free (digests->digest);
+			platform_free (cache->digests);
+			cache->digests = NULL;
 
 			return status;
 		}
 	}
 
-	digests->digest_len = SHA256_HASH_LENGTH;
-	digests->num_cert = chain.num_cert;
-
 	return 0;
 }
 
@@ -246,6 +310,10 @@ static int attestation_issue_challenge (struct attestation_master *attestation,
 		return device_num;
 	}
 
+	if (device_num >= attestation->num_devices) {
+		return ATTESTATION_INVALID_DEVICE_NUM;
+	}
+
 	memset (challenge, 0, sizeof (struct attestation_challenge));
 
 	challenge->slot_num = slot_num;
@@ -264,7 +332,7 @@ static int attestation_issue_challenge (struct attestation_master *attestation,
 static int attestation_compare_digests (struct attestation_master *attestation, uint8_t eid,
 	struct attestation_chain_digest *digests)
 {
-	struct attestation_chain_digest computed_digests;
+	struct attestation_chain_cache *cache;
 	struct device_manager_cert_chain chain;
 	uint8_t i_digest;
 	int device_num;
@@ -294,21 +362,24 @@ static int attestation_compare_digests (struct attestation_master *attestation,
 		return 1;
 	}
 
-	status = attestation_get_chain_digests (attestation, device_num, &computed_digests);
+	status = attestation_get_chain_cache (attestation, device_num, &chain, &cache);
+	if (status != 0) {
+		return status;
+	}
+
+	status = attestation_get_chain_digests (attestation, &chain, cache);
 	if (status != 0) {
 		return status;
 	}
 
-	for (i_digest = 0; i_digest < computed_digests.num_cert; ++i_digest) {
-		if (memcmp (&computed_digests.digest[computed_digests.digest_len * i_digest],
-			&digests->digest[computed_digests.digest_len * i_digest], computed_digests.digest_len)){
+	for (i_digest = 0; i_digest < chain.num_cert; ++i_digest) {
+		if (memcmp (&cache->digests[SHA256_HASH_LENGTH * i_digest],
+			&digests->digest[SHA256_HASH_LENGTH * i_digest], SHA256_HASH_LENGTH)) {
 			status = i_digest + 1;
 			break;
 		}
 	}
 
-	platform_free (computed_digests.digest);
-
 	return status;
 }
 
@@ -337,8 +408,7 @@ static int attestation_store_certificate (struct attestation_master *attestation
 static int attestation_process_challenge_response (struct attestation_master *attestation,
 	uint8_t *buf, int buf_len, uint8_t eid)
 {
-	struct ecc_public_key ecc_key;
-	struct rsa_public_key rsa_key;
+	struct attestation_chain_cache *cache;
 	struct device_manager_cert_chain chain;
 	uint8_t challenge[ATTESTATION_NONCE_LEN + 2];
 	uint8_t digest[SHA256_HASH_LENGTH];
@@ -374,6 +444,11 @@ static int attestation_process_challenge_response (struct attestation_master *at
 		return status;
 	}
 
+	status = attestation_get_chain_cache (attestation, device_num, &chain, &cache);
+	if (status != 0) {
+		return status;
+	}
+
 	memcpy (&challenge, (uint8_t*)&attestation->challenge[device_num],
 		sizeof (struct attestation_challenge));
 
@@ -398,24 +473,22 @@ static int attestation_process_challenge_response (struct attestation_master *at
 	}
 
 	if (attestation->encryption_algorithm == ATTESTATION_ECDHE_KEY_EXCHANGE) {
-		status = attestation_verify_and_load_ecc_leaf_key (attestation, &chain, &ecc_key);
+		status = attestation_verify_and_load_ecc_leaf_key (attestation, &chain, cache);
 		if (status != 0) {
 			return status;
 		}
 
-		status = attestation->ecc->verify (attestation->ecc, &ecc_key, digest, SHA256_HASH_LENGTH,
-			&buf[buf_len - sig_len], sig_len);
-
-		attestation->ecc->release_key_pair (attestation->ecc, NULL, &ecc_key);
+		status = attestation->ecc->verify (attestation->ecc, &cache->key.ecc, digest,
+			SHA256_HASH_LENGTH, &buf[buf_len - sig_len], sig_len);
 	}
 	else if (attestation->encryption_algorithm == ATTESTATION_RSA_KEY_EXCHANGE) {
-		status = attestation_verify_and_load_rsa_leaf_key (attestation, &chain, &rsa_key);
+		status = attestation_verify_and_load_rsa_leaf_key (attestation, &chain, cache);
 		if (status != 0) {
 			return status;
 		}
 
-		status = attestation->rsa->sig_verify (attestation->rsa, &rsa_key, &buf[buf_len - sig_len],
-			sig_len, digest, SHA256_HASH_LENGTH);
+		status = attestation->rsa->sig_verify (attestation->rsa, &cache->key.rsa,
+			&buf[buf_len - sig_len], sig_len, digest, SHA256_HASH_LENGTH);
 	}
 	else {
 		return ATTESTATION_UNSUPPORTED_ALGORITHM;
@@ -479,6 +552,13 @@ int attestation_master_init (struct attestation_master *attestation,
 		return ATTESTATION_NO_MEMORY;
 	}
 
+	attestation->chain_cache = platform_calloc (device_manager->num_devices,
+		sizeof (struct attestation_chain_cache));
+	if (attestation->chain_cache == NULL) {
+		platform_free (attestation->challenge);
+		return ATTESTATION_NO_MEMORY;
+	}
+
 	attestation->riot = riot;
 	attestation->hash = hash;
 	attestation->ecc = ecc;
@@ -487,6 +567,7 @@ int attestation_master_init (struct attestation_master *attestation,
 	attestation->rng = rng;
 	attestation->device_manager = device_manager;
 	attestation->encryption_algorithm = encryption_algo;
+	attestation->num_devices = device_manager->num_devices;
 	attestation->version = 0;
 
 	attestation->issue_challenge = attestation_issue_challenge;
@@ -504,7 +585,17 @@ int attestation_master_init (struct attestation_master *attestation,
  */
 void attestation_master_release (struct attestation_master *attestation)
 {
+	uint8_t i;
+
 	if (attestation) {
+		if (attestation->chain_cache != NULL) {
+			for (i = 0; i < attestation->num_devices; i++) {
+				attestation_invalidate_chain_cache (attestation, &attestation->chain_cache[i]);
+			}
+
+			platform_free (attestation->chain_cache);
+		}
+
 		platform_free (attestation->challenge);
 	}
 }
@@ -5,6 +5,7 @@
 #define ATTESTATION_MASTER_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "status/rot_status.h"
 #include "crypto/ecc.h"
 #include "crypto/rsa.h"
@@ -16,6 +17,21 @@
 #include "attestation.h"
 
 
+/**
+ * Cached information for a device certificate chain.  The cache is only valid for the version of
+ * the certificate chain and the RIoT CA certificates that were used to populate it.
+ */
+struct attestation_chain_cache {
+	uint32_t version;									/**< Version of the certificate chain that is cached. */
+	uint32_t ca_version;								/**< Version of the RIoT CA certificates used to authenticate the chain. */
+	uint8_t *digests;									/**< Digests of each certificate in the chain.  Null if not calculated. */
+	bool key_valid;										/**< Flag indicating the chain has been authenticated and the leaf key loaded. */
+	union {
+		struct ecc_public_key ecc;						/**< Leaf key for ECC attestation. */
+		struct rsa_public_key rsa;						/**< Leaf key for RSA attestation. */
+	} key;												/**< Public key from the authenticated leaf certificate. */
+};
+
 struct attestation_master {
 	/**
 	 * Create an authentication challenge request.
@@ -80,6 +96,8 @@ struct attestation_master {
 	struct device_manager *device_manager;				/**< Device manager */
 	struct rsa_engine *rsa;								/**< The RSA engine for attestation authentication operations. */
 	struct attestation_challenge *challenge;			/**< Store challenge sent out to device. */
+	struct attestation_chain_cache *chain_cache;		/**< Authenticated certificate chain for each device. */
+	uint8_t num_devices;								/**< Number of devices with challenge and chain cache entries. */
 	uint8_t version;									/**< Authentication protocol version. */
 	uint8_t encryption_algorithm;						/**< Encryption algorithm */
 };
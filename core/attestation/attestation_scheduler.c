@@ -0,0 +1,422 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "attestation_scheduler.h"
+
+
+/**
+ * Initialize a scheduler for attesting downstream devices.
+ *
+ * @param scheduler The attestation scheduler to initialize.
+ * @param device_manager Device manager containing the devices to attest.  The scheduler will track
+ * every device in the device table at the time of initialization.
+ * @param max_per_bus The maximum number of devices on a single bus that can be attested at the
+ * same time.
+ *
+ * @return 0 if the scheduler was successfully initialized or an error code.
+ */
+int attestation_scheduler_init (struct attestation_scheduler *scheduler,
+	struct device_manager *device_manager, uint8_t max_per_bus)
+{
+	int status;
+
+	if ((scheduler == NULL) || (device_manager == NULL) || (max_per_bus == 0)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	memset (scheduler, 0, sizeof (struct attestation_scheduler));
+
+	scheduler->device = platform_calloc (device_manager->num_devices,
+		sizeof (struct attestation_scheduler_device));
+	if (scheduler->device == NULL) {
+		return ATTESTATION_SCHEDULER_NO_MEMORY;
+	}
+
+	status = platform_mutex_init (&scheduler->lock);
+	if (status != 0) {
+		platform_free (scheduler->device);
+		return status;
+	}
+
+	scheduler->device_manager = device_manager;
+	scheduler->num_devices = device_manager->num_devices;
+	scheduler->max_per_bus = max_per_bus;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by an attestation scheduler.
+ *
+ * @param scheduler The attestation scheduler to release.
+ */
+void attestation_scheduler_release (struct attestation_scheduler *scheduler)
+{
+	if (scheduler != NULL) {
+		platform_mutex_free (&scheduler->lock);
+		platform_free (scheduler->device);
+	}
+}
+
+/**
+ * Assign a device to a bus.  Devices on different buses can be attested in parallel.  By default,
+ * all devices are on the same bus.
+ *
+ * @param scheduler The attestation scheduler to update.
+ * @param device_num The device to update.
+ * @param bus Identifier for the bus used to communicate with the device.
+ *
+ * @return 0 if the bus was assigned successfully or an error code.
+ */
+int attestation_scheduler_set_device_bus (struct attestation_scheduler *scheduler, int device_num,
+	uint8_t bus)
+{
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	if ((device_num < 0) || (device_num >= scheduler->num_devices)) {
+		return ATTESTATION_SCHEDULER_UNKNOWN_DEVICE;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+	scheduler->device[device_num].bus = bus;
+	platform_mutex_unlock (&scheduler->lock);
+
+	return 0;
+}
+
+/**
+ * Mark attestation of a device as failed.
+ *
+ * @param scheduler The attestation scheduler to update.
+ * @param device_num The device that failed attestation.
+ * @param status The reason for the failure.
+ */
+static void attestation_scheduler_fail_device (struct attestation_scheduler *scheduler,
+	int device_num, int status)
+{
+	scheduler->device[device_num].state = ATTESTATION_SCHEDULER_FAILED;
+	scheduler->device[device_num].status = status;
+	scheduler->device[device_num].command = ATTESTATION_SCHEDULER_NO_COMMAND;
+
+	device_manager_update_device_state (scheduler->device_manager, device_num,
+		DEVICE_MANAGER_AVAILABLE);
+}
+
+/**
+ * Track a new request sent to a device.  The amount of time allowed for the device to respond is
+ * determined by the device capabilities.
+ *
+ * @param scheduler The attestation scheduler to update.
+ * @param device_num The device the request was sent to.
+ * @param command The command ID of the request.
+ */
+static void attestation_scheduler_start_request (struct attestation_scheduler *scheduler,
+	int device_num, int command)
+{
+	struct attestation_scheduler_device *device = &scheduler->device[device_num];
+	uint32_t timeout;
+
+	if (command == CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE) {
+		timeout = device_manager_get_crypto_timeout (scheduler->device_manager, device_num);
+	}
+	else {
+		timeout = device_manager_get_reponse_timeout (scheduler->device_manager, device_num);
+	}
+
+	device->state = ATTESTATION_SCHEDULER_IN_PROGRESS;
+	device->command = command;
+	platform_init_timeout (timeout, &device->timeout);
+}
+
+/**
+ * Fail any devices that have not responded to a request within the allowed time.
+ *
+ * @param scheduler The attestation scheduler to check.
+ */
+static void attestation_scheduler_check_timeouts (struct attestation_scheduler *scheduler)
+{
+	int i;
+
+	for (i = 0; i < scheduler->num_devices; i++) {
+		if ((scheduler->device[i].state == ATTESTATION_SCHEDULER_IN_PROGRESS) &&
+			(platform_has_timeout_expired (&scheduler->device[i].timeout) == 1)) {
+			attestation_scheduler_fail_device (scheduler, i, ATTESTATION_SCHEDULER_TIMEOUT);
+		}
+	}
+}
+
+/**
+ * End the current sweep if there are no devices left to attest.
+ *
+ * @param scheduler The attestation scheduler to check.
+ */
+static void attestation_scheduler_check_complete (struct attestation_scheduler *scheduler)
+{
+	platform_clock now;
+	int i;
+
+	if (!scheduler->sweep_active) {
+		return;
+	}
+
+	for (i = 0; i < scheduler->num_devices; i++) {
+		if ((scheduler->device[i].state == ATTESTATION_SCHEDULER_QUEUED) ||
+			(scheduler->device[i].state == ATTESTATION_SCHEDULER_IN_PROGRESS)) {
+			return;
+		}
+	}
+
+	platform_init_current_tick (&now);
+	scheduler->sweep_duration = platform_get_duration (&scheduler->sweep_start, &now);
+	scheduler->sweep_active = false;
+}
+
+/**
+ * Start attestation of all downstream devices.  Every downstream device that is available for
+ * communication will be queued for attestation.
+ *
+ * @param scheduler The attestation scheduler to start.
+ *
+ * @return The number of devices queued for attestation or an error code.
+ */
+int attestation_scheduler_start_sweep (struct attestation_scheduler *scheduler)
+{
+	struct attestation_scheduler_device *device;
+	int count = 0;
+	int i;
+
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	if (scheduler->sweep_active) {
+		platform_mutex_unlock (&scheduler->lock);
+		return ATTESTATION_SCHEDULER_SWEEP_ACTIVE;
+	}
+
+	for (i = 0; i < scheduler->num_devices; i++) {
+		device = &scheduler->device[i];
+
+		device->status = 0;
+		device->command = ATTESTATION_SCHEDULER_NO_COMMAND;
+
+		if ((device_manager_get_device_direction (scheduler->device_manager, i) ==
+				DEVICE_MANAGER_DOWNSTREAM) &&
+			(device_manager_get_device_state (scheduler->device_manager, i) !=
+				DEVICE_MANAGER_NOT_READY)) {
+			device->state = ATTESTATION_SCHEDULER_QUEUED;
+			count++;
+		}
+		else {
+			device->state = ATTESTATION_SCHEDULER_IDLE;
+		}
+	}
+
+	platform_init_current_tick (&scheduler->sweep_start);
+	scheduler->sweep_duration = 0;
+	scheduler->sweep_active = (count != 0);
+
+	platform_mutex_unlock (&scheduler->lock);
+	return count;
+}
+
+/**
+ * Get the next device that should be sent a request to start attestation.  Attestation starts with
+ * a Get Digests request, and the remaining exchanges are driven by processing the device
+ * responses.  Any outstanding requests that have timed out will be failed.
+ *
+ * @param scheduler The attestation scheduler to query.
+ * @param request Output for the request that should be sent.
+ *
+ * @return 0 if there is a request to send or an error code.  If no device can be sent a request
+ * at this time, ATTESTATION_SCHEDULER_NO_REQUEST will be returned.
+ */
+int attestation_scheduler_get_next_request (struct attestation_scheduler *scheduler,
+	struct attestation_scheduler_request *request)
+{
+	int device_num = -1;
+	int active;
+	int i;
+	int j;
+
+	if ((scheduler == NULL) || (request == NULL)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	attestation_scheduler_check_timeouts (scheduler);
+
+	for (i = 0; (i < scheduler->num_devices) && (device_num < 0); i++) {
+		if (scheduler->device[i].state != ATTESTATION_SCHEDULER_QUEUED) {
+			continue;
+		}
+
+		active = 0;
+		for (j = 0; j < scheduler->num_devices; j++) {
+			if ((scheduler->device[j].state == ATTESTATION_SCHEDULER_IN_PROGRESS) &&
+				(scheduler->device[j].bus == scheduler->device[i].bus)) {
+				active++;
+			}
+		}
+
+		if (active < scheduler->max_per_bus) {
+			device_num = i;
+		}
+	}
+
+	if (device_num < 0) {
+		attestation_scheduler_check_complete (scheduler);
+
+		platform_mutex_unlock (&scheduler->lock);
+		return ATTESTATION_SCHEDULER_NO_REQUEST;
+	}
+
+	attestation_scheduler_start_request (scheduler, device_num, CERBERUS_PROTOCOL_GET_DIGEST);
+
+	request->device_num = device_num;
+	request->eid = device_manager_get_device_eid (scheduler->device_manager, device_num);
+	request->smbus_addr = device_manager_get_device_addr (scheduler->device_manager, device_num);
+	request->bus = scheduler->device[device_num].bus;
+	request->command = CERBERUS_PROTOCOL_GET_DIGEST;
+
+	platform_mutex_unlock (&scheduler->lock);
+	return 0;
+}
+
+/**
+ * Update the attestation state of a device after processing a response from that device.
+ *
+ * @param scheduler The attestation scheduler to update.
+ * @param device_num The device that sent the response.
+ * @param status The result of processing the response.
+ * @param next_command The command ID of the next request sent to the device.  This is
+ * ATTESTATION_SCHEDULER_NO_COMMAND if the response completed the attestation exchange.
+ *
+ * @return 0 if the device state was updated or an error code.  Responses from devices not being
+ * attested are ignored.
+ */
+int attestation_scheduler_update (struct attestation_scheduler *scheduler, int device_num,
+	int status, int next_command)
+{
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	if ((device_num < 0) || (device_num >= scheduler->num_devices)) {
+		return ATTESTATION_SCHEDULER_UNKNOWN_DEVICE;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	if (scheduler->device[device_num].state == ATTESTATION_SCHEDULER_IN_PROGRESS) {
+		if (status != 0) {
+			attestation_scheduler_fail_device (scheduler, device_num, status);
+		}
+		else if (next_command == ATTESTATION_SCHEDULER_NO_COMMAND) {
+			scheduler->device[device_num].state = ATTESTATION_SCHEDULER_PASSED;
+			scheduler->device[device_num].command = ATTESTATION_SCHEDULER_NO_COMMAND;
+		}
+		else {
+			attestation_scheduler_start_request (scheduler, device_num, next_command);
+		}
+
+		attestation_scheduler_check_complete (scheduler);
+	}
+
+	platform_mutex_unlock (&scheduler->lock);
+	return 0;
+}
+
+/**
+ * Get the attestation state of a device in the current or last sweep.
+ *
+ * @param scheduler The attestation scheduler to query.
+ * @param device_num The device to query.
+ *
+ * @return The attestation state of the device or an error code.
+ */
+int attestation_scheduler_get_device_state (struct attestation_scheduler *scheduler,
+	int device_num)
+{
+	int state;
+
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	if ((device_num < 0) || (device_num >= scheduler->num_devices)) {
+		return ATTESTATION_SCHEDULER_UNKNOWN_DEVICE;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+	state = scheduler->device[device_num].state;
+	platform_mutex_unlock (&scheduler->lock);
+
+	return state;
+}
+
+/**
+ * Get a summary of the current or last attestation sweep.
+ *
+ * @param scheduler The attestation scheduler to query.
+ * @param results Output for the sweep results.  If the sweep has not completed, the duration is
+ * the amount of time elapsed since the sweep started.
+ *
+ * @return 0 if the results were retrieved successfully or an error code.
+ */
+int attestation_scheduler_get_results (struct attestation_scheduler *scheduler,
+	struct attestation_scheduler_results *results)
+{
+	platform_clock now;
+	int i;
+
+	if ((scheduler == NULL) || (results == NULL)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	memset (results, 0, sizeof (struct attestation_scheduler_results));
+
+	platform_mutex_lock (&scheduler->lock);
+
+	for (i = 0; i < scheduler->num_devices; i++) {
+		switch (scheduler->device[i].state) {
+			case ATTESTATION_SCHEDULER_IDLE:
+				break;
+
+			case ATTESTATION_SCHEDULER_PASSED:
+				results->passed++;
+				results->scheduled++;
+				break;
+
+			case ATTESTATION_SCHEDULER_FAILED:
+				results->failed++;
+				results->scheduled++;
+				break;
+
+			default:
+				results->scheduled++;
+				break;
+		}
+	}
+
+	results->complete = !scheduler->sweep_active;
+	if (scheduler->sweep_active) {
+		platform_init_current_tick (&now);
+		results->duration_ms = platform_get_duration (&scheduler->sweep_start, &now);
+	}
+	else {
+		results->duration_ms = scheduler->sweep_duration;
+	}
+
+	platform_mutex_unlock (&scheduler->lock);
+	return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef ATTESTATION_SCHEDULER_H_
+#define ATTESTATION_SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "status/rot_status.h"
+#include "cmd_interface/device_manager.h"
+
+
+/**
+ * Indicator that no additional request was issued to a device after processing a response.
+ */
+#define	ATTESTATION_SCHEDULER_NO_COMMAND		-1
+
+/**
+ * Attestation states for a single device in an attestation sweep.
+ */
+enum attestation_scheduler_state {
+	ATTESTATION_SCHEDULER_IDLE = 0,				/**< The device is not part of the current sweep. */
+	ATTESTATION_SCHEDULER_QUEUED,				/**< Attestation of the device has not started. */
+	ATTESTATION_SCHEDULER_IN_PROGRESS,			/**< A request to the device is outstanding. */
+	ATTESTATION_SCHEDULER_PASSED,				/**< The device was successfully authenticated. */
+	ATTESTATION_SCHEDULER_FAILED,				/**< Attestation of the device failed or timed out. */
+};
+
+/**
+ * Attestation context for a single device.
+ */
+struct attestation_scheduler_device {
+	platform_clock timeout;						/**< Time at which the outstanding request expires. */
+	enum attestation_scheduler_state state;		/**< Current attestation state of the device. */
+	int status;									/**< Error status if attestation failed. */
+	int command;								/**< Command ID of the outstanding request. */
+	uint8_t bus;								/**< Identifier for the bus used to reach the device. */
+};
+
+/**
+ * The next device that should be sent a request to start attestation.
+ */
+struct attestation_scheduler_request {
+	int device_num;								/**< Device manager index for the device. */
+	uint8_t eid;								/**< EID of the device. */
+	uint8_t smbus_addr;							/**< SMBus address of the device. */
+	uint8_t bus;								/**< Bus to use to send the request. */
+	uint8_t command;							/**< Command ID of the request to send. */
+};
+
+/**
+ * Summary of an attestation sweep.
+ */
+struct attestation_scheduler_results {
+	uint8_t scheduled;							/**< Number of devices included in the sweep. */
+	uint8_t passed;								/**< Number of devices that were authenticated. */
+	uint8_t failed;								/**< Number of devices that failed attestation. */
+	bool complete;								/**< Flag indicating the sweep has completed. */
+	uint32_t duration_ms;						/**< Time taken to complete the sweep. */
+};
+
+/**
+ * Scheduler to attest all downstream devices.  Attestation exchanges are run for multiple devices
+ * at the same time, limited only by the number of outstanding exchanges allowed on each bus.  Each
+ * exchange is bounded by the response timeouts reported in the device capabilities.
+ */
+struct attestation_scheduler {
+	struct device_manager *device_manager;		/**< Device manager for the devices to attest. */
+	struct attestation_scheduler_device *device;	/**< Attestation context for each device. */
+	uint8_t num_devices;						/**< Number of device contexts. */
+	uint8_t max_per_bus;						/**< Maximum outstanding exchanges on a single bus. */
+	platform_clock sweep_start;					/**< Time the current sweep was started. */
+	uint32_t sweep_duration;					/**< Time taken to complete the last sweep. */
+	bool sweep_active;							/**< Flag indicating a sweep is in progress. */
+	platform_mutex lock;						/**< Synchronization for scheduler state. */
+};
+
+
+int attestation_scheduler_init (struct attestation_scheduler *scheduler,
+	struct device_manager *device_manager, uint8_t max_per_bus);
+void attestation_scheduler_release (struct attestation_scheduler *scheduler);
+
+int attestation_scheduler_set_device_bus (struct attestation_scheduler *scheduler, int device_num,
+	uint8_t bus);
+
+int attestation_scheduler_start_sweep (struct attestation_scheduler *scheduler);
+int attestation_scheduler_get_next_request (struct attestation_scheduler *scheduler,
+	struct attestation_scheduler_request *request);
+int attestation_scheduler_update (struct attestation_scheduler *scheduler, int device_num,
+	int status, int next_command);
+
+int attestation_scheduler_get_device_state (struct attestation_scheduler *scheduler,
+	int device_num);
+int attestation_scheduler_get_results (struct attestation_scheduler *scheduler,
+	struct attestation_scheduler_results *results);
+
+
+#define	ATTESTATION_SCHEDULER_ERROR(code)		ROT_ERROR (ROT_MODULE_ATTESTATION_SCHEDULER, code)
+
+/**
+ * Error codes that can be generated by the attestation scheduler.
+ */
+enum {
+	ATTESTATION_SCHEDULER_INVALID_ARGUMENT = ATTESTATION_SCHEDULER_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	ATTESTATION_SCHEDULER_NO_MEMORY = ATTESTATION_SCHEDULER_ERROR (0x01),			/**< Memory allocation failed. */
+	ATTESTATION_SCHEDULER_UNKNOWN_DEVICE = ATTESTATION_SCHEDULER_ERROR (0x02),		/**< Invalid device number. */
+	ATTESTATION_SCHEDULER_SWEEP_ACTIVE = ATTESTATION_SCHEDULER_ERROR (0x03),		/**< An attestation sweep is already in progress. */
+	ATTESTATION_SCHEDULER_NO_REQUEST = ATTESTATION_SCHEDULER_ERROR (0x04),			/**< No device is ready for a new request. */
+	ATTESTATION_SCHEDULER_TIMEOUT = ATTESTATION_SCHEDULER_ERROR (0x05),				/**< The device did not respond in time. */
+};
+
+
+#endif /* ATTESTATION_SCHEDULER_H_ */
@@ -85,6 +85,24 @@ int pcr_check_measurement_index (struct pcr_bank *pcr, uint8_t measurement_index
 	return 0;
 }
 
+/**
+ * Flag a measurement as changed.  The aggregate and log entry for the measurement and all
+ * subsequent measurements in the bank will need to be updated.  The PCR bank lock must be held.
+ *
+ * @param pcr The PCR bank that was updated.
+ * @param measurement_index Index of the measurement that changed.
+ */
+static void pcr_mark_stale (struct pcr_bank *pcr, uint8_t measurement_index)
+{
+	if (measurement_index < pcr->compute_index) {
+		pcr->compute_index = measurement_index;
+	}
+
+	if (measurement_index < pcr->log_index) {
+		pcr->log_index = measurement_index;
+	}
+}
+
 /**
  * Update digest in PCR bank's list of measurements
  *
@@ -113,6 +131,7 @@ int pcr_update_digest (struct pcr_bank *pcr, uint8_t measurement_index, const ui
 	platform_mutex_lock (&pcr->lock);
 
 	memcpy (pcr->measurement_list[measurement_index].digest, digest, digest_len);
+	pcr_mark_stale (pcr, measurement_index);
 
 	platform_mutex_unlock (&pcr->lock);
 
@@ -170,6 +189,9 @@ int pcr_update_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint
 	platform_mutex_lock (&pcr->lock);
 
 	pcr->measurement_list[measurement_index].event_type = event_type;
+	if (measurement_index < pcr->log_index) {
+		pcr->log_index = measurement_index;
+	}
 
 	platform_mutex_unlock (&pcr->lock);
 
@@ -177,7 +199,9 @@ int pcr_update_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint
 }
 
 /**
- * Compute aggregate of all measurements that have added to PCR bank
+ * Compute aggregate of all measurements that have added to PCR bank.  The aggregate for each
+ * measurement is cached, so only measurements at or after the first one that has changed since the
+ * last computation need to be extended again.
  *
  * @param pcr The PCR bank to compute aggregate measurement of
  * @param hash Hashing engine to utilize
@@ -201,7 +225,17 @@ int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measur
 	}
 
 	if (!pcr->explicit) {
-		for (i_measurement = 0; i_measurement < pcr->num_measurements; ++i_measurement) {
+		if (pcr->compute_index < pcr->log_index) {
+			pcr->log_index = pcr->compute_index;
+		}
+
+		if (pcr->compute_index > 0) {
+			memcpy (prev_measurement, pcr->measurement_list[pcr->compute_index - 1].measurement,
+				sizeof (prev_measurement));
+		}
+
+		for (i_measurement = pcr->compute_index; i_measurement < pcr->num_measurements;
+			++i_measurement) {
 			status = hash->start_sha256 (hash);
 			if (status != 0) {
 				goto exit;
@@ -225,6 +259,7 @@ int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measur
 
 			memcpy (pcr->measurement_list[i_measurement].measurement, prev_measurement,
 				sizeof (prev_measurement));
+			pcr->compute_index = i_measurement + 1;
 		}
 	}
 	else {
@@ -505,12 +540,50 @@ int pcr_invalidate_measurement_index (struct pcr_bank *pcr, uint8_t measurement_
 
 	memset (pcr->measurement_list[measurement_index].digest, 0,
 		sizeof (pcr->measurement_list[measurement_index].digest));
+	pcr_mark_stale (pcr, measurement_index);
 
 	platform_mutex_unlock (&pcr->lock);
 
 	return 0;
 }
 
+/**
+ * Get the index of the first measurement whose TCG log entry has changed since the log was last
+ * marked as current.  The PCR bank lock must be held by the caller.
+ *
+ * @param pcr The PCR bank to query.
+ *
+ * @return The index of the first changed log entry or an error code.  If no entries have changed,
+ * the number of measurements in the bank is returned.
+ */
+int pcr_get_stale_log_index (struct pcr_bank *pcr)
+{
+	if (pcr == NULL) {
+		return PCR_INVALID_ARGUMENT;
+	}
+
+	return pcr->log_index;
+}
+
+/**
+ * Indicate that the TCG log entries for all measurements in the PCR bank are current.  The PCR
+ * bank lock must be held by the caller.
+ *
+ * @param pcr The PCR bank to update.
+ *
+ * @return 0 if successful or an error code.
+ */
+int pcr_set_log_current (struct pcr_bank *pcr)
+{
+	if (pcr == NULL) {
+		return PCR_INVALID_ARGUMENT;
+	}
+
+	pcr->log_index = pcr->num_measurements;
+
+	return 0;
+}
+
 /**
  * Acquire lock dedicated to PCR bank
  *
@@ -31,6 +31,8 @@ struct pcr_bank {
 	struct pcr_measurement *measurement_list;				/**< List of measurements */
 	size_t num_measurements;								/**< Number of measurements */
 	bool explicit;											/**< PCR bank contains an explicit measurement. */
+	size_t compute_index;									/**< First measurement with a stale aggregate. */
+	size_t log_index;										/**< First measurement with a stale log entry. */
 	platform_mutex lock;									/**< Synchronization lock */
 };
 
@@ -53,6 +55,9 @@ int pcr_get_all_measurements (struct pcr_bank *pcr, const uint8_t **measurement_
 int pcr_get_num_measurements (struct pcr_bank *pcr);
 int pcr_invalidate_measurement_index (struct pcr_bank *pcr, uint8_t measurement_index);
 
+int pcr_get_stale_log_index (struct pcr_bank *pcr);
+int pcr_set_log_current (struct pcr_bank *pcr);
+
 int pcr_set_measurement_data (struct pcr_bank *pcr, uint8_t measurement_index,
 	struct pcr_measured_data *measurement_data);
 int pcr_get_measurement_data (struct pcr_bank *pcr, uint8_t measurement_index, size_t offset,
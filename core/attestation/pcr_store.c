@@ -21,7 +21,10 @@
  */
 int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size_t num_pcr)
 {
+	struct pcr_store_tcg_log_entry *log_entry;
 	size_t i_pcr;
+	size_t i_measurement;
+	size_t num_entries = 0;
 	int status;
 
 	if ((store == NULL) || (num_pcr_measurements == NULL) || (num_pcr == 0)) {
@@ -47,6 +50,39 @@ int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size
 
 			return status;
 		}
+
+		num_entries += pcr_get_num_measurements (&store->banks[i_pcr]);
+	}
+
+	store->tcg_log = NULL;
+	if (num_entries != 0) {
+		store->tcg_log = platform_calloc (num_entries, sizeof (struct pcr_store_tcg_log_entry));
+		if (store->tcg_log == NULL) {
+			for (i_pcr = 0; i_pcr < num_pcr; ++i_pcr) {
+				pcr_release (&store->banks[i_pcr]);
+			}
+
+			platform_free (store->banks);
+
+			return PCR_NO_MEMORY;
+		}
+	}
+
+	/* The fields of each log entry that don't depend on the measurement are only set once. */
+	log_entry = store->tcg_log;
+	for (i_pcr = 0; i_pcr < num_pcr; ++i_pcr) {
+		for (i_measurement = 0;
+			i_measurement < (size_t) pcr_get_num_measurements (&store->banks[i_pcr]);
+			++i_measurement, ++log_entry) {
+			log_entry->header.log_magic = LOGGING_MAGIC_START;
+			log_entry->header.length = sizeof (struct pcr_store_tcg_log_entry);
+			log_entry->header.entry_id = (uint32_t) (log_entry - store->tcg_log);
+
+			log_entry->entry.digest_algorithm_id = 0x0B;
+			log_entry->entry.digest_count = 1;
+			log_entry->entry.measurement_type = PCR_MEASUREMENT (i_pcr, i_measurement);
+			log_entry->entry.measurement_size = PCR_DIGEST_LENGTH;
+		}
 	}
 
 	return status;
@@ -67,6 +103,7 @@ void pcr_store_release (struct pcr_store *store)
 		}
 
 		platform_free (store->banks);
+		platform_free (store->tcg_log);
 	}
 }
 
@@ -372,7 +409,47 @@ int pcr_store_get_tcg_log_size (struct pcr_store *store)
 }
 
 /**
- * Generate TCG log from PCR banks.
+ * Bring the cached TCG log entries for a PCR bank up to date.  Only entries for measurements that
+ * have changed since the last update are regenerated.  The PCR bank lock must be held and the bank
+ * measurements must have already been computed.
+ *
+ * @param pcr The PCR bank to update the log for.
+ * @param bank_log The cached log entries for the bank.
+ *
+ * @return 0 if the log entries were updated successfully or an error code.
+ */
+static int pcr_store_update_tcg_log (struct pcr_bank *pcr, struct pcr_store_tcg_log_entry *bank_log)
+{
+	const struct pcr_measurement *measurements;
+	int num_measurements;
+	int i_measurement;
+
+	i_measurement = pcr_get_stale_log_index (pcr);
+	if (ROT_IS_ERROR (i_measurement)) {
+		return i_measurement;
+	}
+
+	num_measurements = pcr_get_all_measurements (pcr, (const uint8_t**) &measurements);
+	if (ROT_IS_ERROR (num_measurements)) {
+		return num_measurements;
+	}
+
+	for (; i_measurement < num_measurements; ++i_measurement) {
+		bank_log[i_measurement].entry.event_type = measurements[i_measurement].event_type;
+
+		memcpy (bank_log[i_measurement].entry.digest, measurements[i_measurement].digest,
+			sizeof (measurements[i_measurement].digest));
+		memcpy (bank_log[i_measurement].entry.measurement,
+			measurements[i_measurement].measurement,
+			sizeof (measurements[i_measurement].measurement));
+	}
+
+	return pcr_set_log_current (pcr);
+}
+
+/**
+ * Generate TCG log from PCR banks.  Log entries are cached and only regenerated for measurements
+ * that have changed since the last time the log was read.
  *
  * @param store PCR store to get measurements from.
  * @param hash Hashing engine to utilize in PCR bank operations.
@@ -385,17 +462,15 @@ int pcr_store_get_tcg_log_size (struct pcr_store *store)
 int pcr_store_get_tcg_log (struct pcr_store *store, struct hash_engine *hash, uint32_t offset,
 	uint8_t *contents, size_t length)
 {
-	struct pcr_store_tcg_log_entry log_entry;
-	const struct pcr_measurement *measurements;
-	uint32_t contents_offset = 0;
-	uint32_t entry_length;
-	uint32_t entry_offset;
+	struct pcr_store_tcg_log_entry *bank_log;
+	size_t contents_offset = 0;
+	size_t total_log_size = 0;
+	size_t bank_log_size;
+	size_t entry_offset;
+	size_t entry_length;
 	uint32_t i_entry = 0;
 	uint8_t i_bank;
-	int starting_measurement;
-	int total_log_size = 0;
 	int num_measurements;
-	int i_measurement;
 	int status;
 
 	if ((store == NULL) || (hash == NULL) || (contents == NULL)) {
@@ -425,58 +500,20 @@ int pcr_store_get_tcg_log (struct pcr_store *store, struct hash_engine *hash, ui
 			continue;
 		}
 
-		num_measurements = pcr_get_all_measurements (&store->banks[i_bank],
-			(const uint8_t**) &measurements);
-		if (ROT_IS_ERROR (num_measurements)) {
-			pcr_unlock (&store->banks[i_bank]);
-			return num_measurements;
-		}
+		bank_log = &store->tcg_log[i_entry];
+		bank_log_size = num_measurements * sizeof (struct pcr_store_tcg_log_entry);
 
-		if (total_log_size >= offset) {
-			total_log_size += num_measurements * sizeof (struct pcr_store_tcg_log_entry);
-			starting_measurement = 0;
-			entry_offset = 0;
-		}
-		else {
-			starting_measurement = (offset - total_log_size) /
-				sizeof (struct pcr_store_tcg_log_entry);
-			entry_offset = (offset - total_log_size) - (starting_measurement) *
-				sizeof (struct pcr_store_tcg_log_entry);
-			total_log_size += num_measurements * sizeof (struct pcr_store_tcg_log_entry);
-
-			if (total_log_size <= offset) {
-				i_entry += num_measurements;
-				pcr_unlock (&store->banks[i_bank]);
-				continue;
-			}
-
-			i_entry += starting_measurement;
+		status = pcr_store_update_tcg_log (&store->banks[i_bank], bank_log);
+		if (status != 0) {
+			pcr_unlock (&store->banks[i_bank]);
+			return status;
 		}
 
-		for (i_measurement = 0; i_measurement < num_measurements; ++i_measurement) {
-			if (i_measurement < starting_measurement) {
-				continue;
-			}
-
-			log_entry.header.log_magic = LOGGING_MAGIC_START;
-			log_entry.header.length = sizeof (struct pcr_store_tcg_log_entry);
-			log_entry.header.entry_id = i_entry++;
-
-			log_entry.entry.digest_algorithm_id = 0x0B;
-			log_entry.entry.digest_count = 1;
-			log_entry.entry.event_type = measurements[i_measurement].event_type;
-			log_entry.entry.measurement_type = PCR_MEASUREMENT (i_bank, i_measurement);
-			log_entry.entry.measurement_size = sizeof (measurements[i_measurement].digest);
-
-			memcpy (log_entry.entry.digest, measurements[i_measurement].digest,
-				sizeof (measurements[i_measurement].digest));
-			memcpy (log_entry.entry.measurement, measurements[i_measurement].measurement,
-				sizeof (measurements[i_measurement].measurement));
+		if ((total_log_size + bank_log_size) > offset) {
+			entry_offset = (offset > total_log_size) ? (offset - total_log_size) : 0;
+			entry_length = min (length - contents_offset, bank_log_size - entry_offset);
 
-			entry_length = min (length - contents_offset,
-				sizeof (struct pcr_store_tcg_log_entry) - entry_offset);
-
-			memcpy (&contents[contents_offset], ((uint8_t*) &log_entry) + entry_offset,
+			memcpy (&contents[contents_offset], ((uint8_t*) bank_log) + entry_offset,
 				entry_length);
 
 			contents_offset += entry_length;
@@ -484,11 +521,12 @@ int pcr_store_get_tcg_log (struct pcr_store *store, struct hash_engine *hash, ui
 				pcr_unlock (&store->banks[i_bank]);
 				return contents_offset;
 			}
-
-			entry_offset = 0;
 		}
 
 		pcr_unlock (&store->banks[i_bank]);
+
+		total_log_size += bank_log_size;
+		i_entry += num_measurements;
 	}
 
 	return contents_offset;
@@ -20,6 +20,7 @@
 struct pcr_store {
 	struct pcr_bank *banks;						/**< PCR banks */
 	size_t num_pcr_banks;						/**< Number of PCR banks */
+	struct pcr_store_tcg_log_entry *tcg_log;	/**< Cached TCG log entries for all measurements. */
 };
 
 #pragma pack(push, 1)
@@ -0,0 +1,175 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <string.h>
+#include "cmd_async.h"
+
+
+/**
+ * Initialize a context for deferred command execution.
+ *
+ * @param async The deferred execution context to initialize.
+ *
+ * @return 0 if the context was successfully initialized or an error code.
+ */
+int cmd_async_init (struct cmd_async *async)
+{
+	if (async == NULL) {
+		return CMD_ASYNC_INVALID_ARGUMENT;
+	}
+
+	memset (async, 0, sizeof (struct cmd_async));
+
+	return platform_mutex_init (&async->lock);
+}
+
+/**
+ * Release the resources used for deferred command execution.
+ *
+ * @param async The deferred execution context to release.
+ */
+void cmd_async_release (struct cmd_async *async)
+{
+	if (async != NULL) {
+		platform_mutex_free (&async->lock);
+	}
+}
+
+/**
+ * Defer execution of a request.  The request is copied, so the original request buffer can be
+ * reused as soon as this call returns.
+ *
+ * @param async The deferred execution context.
+ * @param intf The command interface that is deferring the request.
+ * @param execute The handler that will execute the request.
+ * @param request The request to defer.
+ *
+ * @return 0 if the request was deferred or an error code.  If there is already an outstanding
+ * deferred request, CMD_ASYNC_BUSY will be returned and the request should be processed
+ * immediately.
+ */
+int cmd_async_submit (struct cmd_async *async, struct cmd_interface *intf,
+	cmd_async_execute_request execute, const struct cmd_interface_request *request)
+{
+	int status = 0;
+
+	if ((async == NULL) || (intf == NULL) || (execute == NULL) || (request == NULL)) {
+		return CMD_ASYNC_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&async->lock);
+
+	if (async->state != CMD_ASYNC_STATE_IDLE) {
+		status = CMD_ASYNC_BUSY;
+		goto exit;
+	}
+
+	memcpy (&async->request, request, sizeof (async->request));
+	async->intf = intf;
+	async->execute = execute;
+	async->status = 0;
+	async->state = CMD_ASYNC_STATE_PENDING;
+
+exit:
+	platform_mutex_unlock (&async->lock);
+	return status;
+}
+
+/**
+ * Execute the deferred request.  This is called from the worker task and will block until request
+ * processing has completed.
+ *
+ * @param async The deferred execution context.
+ *
+ * @return 0 if the request was executed or an error code.  The status of the request processing is
+ * reported with the response.
+ */
+int cmd_async_execute (struct cmd_async *async)
+{
+	int status;
+
+	if (async == NULL) {
+		return CMD_ASYNC_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&async->lock);
+
+	if (async->state != CMD_ASYNC_STATE_PENDING) {
+		platform_mutex_unlock (&async->lock);
+		return CMD_ASYNC_NO_REQUEST;
+	}
+
+	async->state = CMD_ASYNC_STATE_RUNNING;
+	platform_mutex_unlock (&async->lock);
+
+	/* The request buffer is only accessed by the worker while the request is running, so the lock
+	 * does not need to be held during processing. */
+	status = async->execute (async->intf, &async->request);
+
+	platform_mutex_lock (&async->lock);
+
+	async->status = status;
+	async->state = CMD_ASYNC_STATE_COMPLETE;
+
+	platform_mutex_unlock (&async->lock);
+	return 0;
+}
+
+/**
+ * Get the response for a deferred request that has completed.  Retrieving the response allows a
+ * new request to be deferred.
+ *
+ * @param async The deferred execution context.
+ * @param response Output for the response data.  The response contains the same routing
+ * information that was provided with the request.
+ *
+ * @return The status from processing the request or an error code.  If there is no response
+ * available, CMD_ASYNC_NO_RESPONSE will be returned.
+ */
+int cmd_async_get_response (struct cmd_async *async, struct cmd_interface_request *response)
+{
+	int status;
+
+	if ((async == NULL) || (response == NULL)) {
+		return CMD_ASYNC_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&async->lock);
+
+	if (async->state != CMD_ASYNC_STATE_COMPLETE) {
+		status = CMD_ASYNC_NO_RESPONSE;
+		goto exit;
+	}
+
+	memcpy (response, &async->request, sizeof (async->request));
+	status = async->status;
+	async->state = CMD_ASYNC_STATE_IDLE;
+
+exit:
+	platform_mutex_unlock (&async->lock);
+	return status;
+}
+
+/**
+ * Determine if there is a deferred request that has not been completed.
+ *
+ * @param async The deferred execution context to query.
+ *
+ * @return true if there is a request waiting for or undergoing execution.
+ */
+bool cmd_async_is_pending (struct cmd_async *async)
+{
+	bool pending;
+
+	if (async == NULL) {
+		return false;
+	}
+
+	platform_mutex_lock (&async->lock);
+	pending = (async->state == CMD_ASYNC_STATE_PENDING) ||
+		(async->state == CMD_ASYNC_STATE_RUNNING);
+	platform_mutex_unlock (&async->lock);
+
+	return pending;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_ASYNC_H_
+#define CMD_ASYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "status/rot_status.h"
+#include "cmd_interface.h"
+
+
+/**
+ * Handler that will execute a deferred request.
+ *
+ * @param intf The command interface that submitted the request.
+ * @param request The request to process.  This will be updated with the response.
+ *
+ * @return 0 if the request was processed successfully or an error code.
+ */
+typedef int (*cmd_async_execute_request) (struct cmd_interface *intf,
+	struct cmd_interface_request *request);
+
+/**
+ * Processing states for a deferred request.
+ */
+enum cmd_async_state {
+	CMD_ASYNC_STATE_IDLE = 0,				/**< No deferred request is outstanding. */
+	CMD_ASYNC_STATE_PENDING,				/**< A request is waiting to be executed. */
+	CMD_ASYNC_STATE_RUNNING,				/**< The request is being executed. */
+	CMD_ASYNC_STATE_COMPLETE,				/**< The response is ready to be sent. */
+};
+
+/**
+ * Context for executing command requests outside of the command processing task.  Long-running
+ * requests are handed off to a worker task so the command channel can continue to process other
+ * requests.  The response is retrieved once the worker has completed the request.
+ *
+ * Only a single request can be deferred at a time.
+ */
+struct cmd_async {
+	struct cmd_interface_request request;	/**< The deferred request and response. */
+	struct cmd_interface *intf;				/**< Command interface that submitted the request. */
+	cmd_async_execute_request execute;		/**< Handler to execute the request. */
+	platform_mutex lock;					/**< Synchronization for the request state. */
+	enum cmd_async_state state;				/**< Current state of the deferred request. */
+	int status;								/**< Result of executing the request. */
+};
+
+
+int cmd_async_init (struct cmd_async *async);
+void cmd_async_release (struct cmd_async *async);
+
+int cmd_async_submit (struct cmd_async *async, struct cmd_interface *intf,
+	cmd_async_execute_request execute, const struct cmd_interface_request *request);
+int cmd_async_execute (struct cmd_async *async);
+int cmd_async_get_response (struct cmd_async *async, struct cmd_interface_request *response);
+bool cmd_async_is_pending (struct cmd_async *async);
+
+
+#define	CMD_ASYNC_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_ASYNC, code)
+
+/**
+ * Error codes that can be generated by deferred command execution.
+ */
+enum {
+	CMD_ASYNC_INVALID_ARGUMENT = CMD_ASYNC_ERROR (0x00),		/**< Input parameter is null or not valid. */
+	CMD_ASYNC_NO_MEMORY = CMD_ASYNC_ERROR (0x01),				/**< Memory allocation failed. */
+	CMD_ASYNC_BUSY = CMD_ASYNC_ERROR (0x02),					/**< A deferred request is already outstanding. */
+	CMD_ASYNC_NO_REQUEST = CMD_ASYNC_ERROR (0x03),				/**< There is no request waiting to be executed. */
+	CMD_ASYNC_NO_RESPONSE = CMD_ASYNC_ERROR (0x04),				/**< There is no completed response available. */
+};
+
+
+#endif /* CMD_ASYNC_H_ */
@@ -59,22 +59,63 @@ int cmd_channel_get_id (struct cmd_channel *channel)
 }
 
 /**
- * Receive a single packet from the command channel and process it.  Errors will be logged.
+ * Send the response packets that were generated for a received packet.
+ *
+ * @param channel The channel to send the packets on.
+ * @param mctp The MCTP interface that generated the response.
+ * @param tx_packets The dynamically allocated response packets.  If this is null, the response
+ * packets will be constructed from the MCTP interface one at a time.
+ * @param num_packets The number of response packets to send.
+ *
+ * @return 0 if all packets were sent successfully or an error code.
+ */
+static int cmd_channel_send_response (struct cmd_channel *channel, struct mctp_interface *mctp,
+	struct cmd_packet *tx_packets, size_t num_packets)
+{
+	struct cmd_packet tx_packet;
+	size_t i = 0;
+	int status = 0;
+
+	while ((i < num_packets) && (status == 0)) {
+		if (tx_packets != NULL) {
+			status = channel->send_packet (channel, &tx_packets[i]);
+		}
+		else {
+			status = mctp_interface_get_response_packet (mctp, i, &tx_packet);
+			if (status == 0) {
+				status = channel->send_packet (channel, &tx_packet);
+			}
+		}
+
+		if (status != 0) {
+			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR,
+				DEBUG_LOG_COMPONENT_CMD_INTERFACE, CMD_LOGGING_SEND_PACKET_FAIL,
+				channel->id, status);
+		}
+
+		i++;
+	}
+
+	return status;
+}
+
+/**
+ * Receive a single packet from the command channel and process it.
  *
  * @param channel The channel to receive a packet from.
  * @param mctp The MCTP interface to use for processing the received packet.
- * @param ms_timeout The amount of time to wait to receive a packet, in milliseconds.  A negative
- * value will wait forever, and a value of 0 will return immediately.
+ * @param ms_timeout The amount of time to wait to receive a packet, in milliseconds.
+ * @param in_place Flag indicating if the response should be packetized in place instead of using
+ * dynamically allocated packets.
  *
  * @return 0 if a packet was processed successfully or an error code.
  */
-int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_interface *mctp,
-	int ms_timeout)
+static int cmd_channel_receive_and_process_packet (struct cmd_channel *channel,
+	struct mctp_interface *mctp, int ms_timeout, bool in_place)
 {
 	struct cmd_packet rx_packet;
-	struct cmd_packet *tx_packets;
+	struct cmd_packet *tx_packets = NULL;
 	size_t num_packets;
-	int i;
 	int status;
 
 	if ((channel == NULL) || (mctp == NULL)) {
@@ -83,8 +124,11 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 
 	status = channel->receive_packet (channel, &rx_packet, ms_timeout);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
-			CMD_LOGGING_RECEIVE_PACKET_FAIL, channel->id, status);
+		/* A timeout is expected when the caller limits the time to wait for a packet. */
+		if (status != CMD_CHANNEL_RX_TIMEOUT) {
+			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
+				CMD_LOGGING_RECEIVE_PACKET_FAIL, channel->id, status);
+		}
 		return status;
 	}
 
@@ -106,20 +150,16 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 		return 0;
 	}
 
-	status = mctp_interface_process_packet (mctp, &rx_packet, &tx_packets, &num_packets);
+	if (in_place) {
+		status = mctp_interface_process_packet_in_place (mctp, &rx_packet, &num_packets);
+	}
+	else {
+		status = mctp_interface_process_packet (mctp, &rx_packet, &tx_packets, &num_packets);
+	}
+
 	if (status == 0) {
 		if (!rx_packet.timeout_valid || !platform_has_timeout_expired (&rx_packet.pkt_timeout)) {
-			i = 0;
-			while ((i < num_packets) && (status == 0)) {
-				status = channel->send_packet (channel, &tx_packets[i]);
-				if (status != 0) {
-					debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR,
-						DEBUG_LOG_COMPONENT_CMD_INTERFACE, CMD_LOGGING_SEND_PACKET_FAIL,
-						channel->id, status);
-				}
-
-				i++;
-			}
+			status = cmd_channel_send_response (channel, mctp, tx_packets, num_packets);
 		}
 		else {
 			debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
@@ -135,3 +175,108 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 
 	return status;
 }
+
+/**
+ * Receive a single packet from the command channel and process it.  Errors will be logged.
+ *
+ * @param channel The channel to receive a packet from.
+ * @param mctp The MCTP interface to use for processing the received packet.
+ * @param ms_timeout The amount of time to wait to receive a packet, in milliseconds.  A negative
+ * value will wait forever, and a value of 0 will return immediately.
+ *
+ * @return 0 if a packet was processed successfully or an error code.
+ */
+int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_interface *mctp,
+	int ms_timeout)
+{
+	return cmd_channel_receive_and_process_packet (channel, mctp, ms_timeout, false);
+}
+
+/**
+ * Receive a single packet from the command channel and process it without any dynamic memory
+ * allocation.  The response is packetized directly from the MCTP interface message buffer, with
+ * each packet constructed immediately before it is sent.  Errors will be logged.
+ *
+ * @param channel The channel to receive a packet from.
+ * @param mctp The MCTP interface to use for processing the received packet.
+ * @param ms_timeout The amount of time to wait to receive a packet, in milliseconds.  A negative
+ * value will wait forever, and a value of 0 will return immediately.
+ *
+ * @return 0 if a packet was processed successfully or an error code.
+ */
+int cmd_channel_receive_and_process_in_place (struct cmd_channel *channel,
+	struct mctp_interface *mctp, int ms_timeout)
+{
+	return cmd_channel_receive_and_process_packet (channel, mctp, ms_timeout, true);
+}
+
+/**
+ * Send the response for a request that was deferred by the command interface.
+ *
+ * @param channel The channel to send the response on.
+ * @param mctp The MCTP interface that received the request.
+ * @param in_place Flag indicating if the response should be packetized in place instead of using
+ * dynamically allocated packets.
+ *
+ * @return 0 if the response was sent or there is no response ready or an error code.
+ */
+static int cmd_channel_send_deferred (struct cmd_channel *channel, struct mctp_interface *mctp,
+	bool in_place)
+{
+	struct cmd_packet *tx_packets = NULL;
+	size_t num_packets;
+	int status;
+
+	if ((channel == NULL) || (mctp == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	if (in_place) {
+		status = mctp_interface_get_deferred_response_in_place (mctp, &num_packets);
+	}
+	else {
+		status = mctp_interface_get_deferred_response (mctp, &tx_packets, &num_packets);
+	}
+
+	if (status == 0) {
+		status = cmd_channel_send_response (channel, mctp, tx_packets, num_packets);
+		platform_free (tx_packets);
+	}
+	else {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
+			CMD_LOGGING_PROCESS_FAIL, status, channel->id);
+	}
+
+	return status;
+}
+
+/**
+ * Send the response for a request that was deferred by the command interface, if the response is
+ * ready.  This should be called by the task processing received packets after the worker
+ * executing the deferred request has completed.  Errors will be logged.
+ *
+ * @param channel The channel to send the response on.
+ * @param mctp The MCTP interface that received the request.
+ *
+ * @return 0 if the response was sent or there is no response ready or an error code.
+ */
+int cmd_channel_send_deferred_response (struct cmd_channel *channel, struct mctp_interface *mctp)
+{
+	return cmd_channel_send_deferred (channel, mctp, false);
+}
+
+/**
+ * Send the response for a request that was deferred by the command interface, if the response is
+ * ready.  The response is packetized directly from the MCTP interface message buffer without any
+ * dynamic memory allocation.  Errors will be logged.
+ *
+ * @param channel The channel to send the response on.
+ * @param mctp The MCTP interface that received the request.
+ *
+ * @return 0 if the response was sent or there is no response ready or an error code.
+ */
+int cmd_channel_send_deferred_response_in_place (struct cmd_channel *channel,
+	struct mctp_interface *mctp)
+{
+	return cmd_channel_send_deferred (channel, mctp, true);
+}
@@ -78,6 +78,12 @@ int cmd_channel_get_id (struct cmd_channel *channel);
 
 int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_interface *mctp,
 	int ms_timeout);
+int cmd_channel_receive_and_process_in_place (struct cmd_channel *channel,
+	struct mctp_interface *mctp, int ms_timeout);
+
+int cmd_channel_send_deferred_response (struct cmd_channel *channel, struct mctp_interface *mctp);
+int cmd_channel_send_deferred_response_in_place (struct cmd_channel *channel,
+	struct mctp_interface *mctp);
 
 /* Internal functions for use by derived types. */
 int cmd_channel_init (struct cmd_channel *channel, int id);
@@ -55,3 +55,50 @@ int cmd_interface_process_request (struct cmd_interface *intf,
 
 	return 0;
 }
+
+/**
+ * Find the definition for a command in a command table.
+ *
+ * @param commands The command table, indexed by command ID.
+ * @param count The number of entries in the command table.
+ * @param command_id ID of the command to find.
+ *
+ * @return The command definition or null if the command is not supported.
+ */
+const struct cmd_interface_command* cmd_interface_find_command (
+	const struct cmd_interface_command *commands, size_t count, uint8_t command_id)
+{
+	if ((commands == NULL) || (command_id >= count) || (commands[command_id].handler == NULL)) {
+		return NULL;
+	}
+
+	return &commands[command_id];
+}
+
+/**
+ * Execute the handler for a command after checking that the request is allowed.
+ *
+ * @param intf The command interface processing the request.
+ * @param command The definition for the requested command.  Null if the command is not supported.
+ * @param request The request data to process.
+ * @param device_num Device manager index of the device that sent the request.
+ * @param direction Direction of the device that sent the request.
+ *
+ * @return 0 if the request was successfully processed or an error code.
+ */
+int cmd_interface_execute_command (struct cmd_interface *intf,
+	const struct cmd_interface_command *command, struct cmd_interface_request *request,
+	int device_num, int direction)
+{
+	if (command == NULL) {
+		return CMD_HANDLER_UNKNOWN_COMMAND;
+	}
+
+	if ((command->directions != CMD_INTERFACE_ANY_DIRECTION) &&
+		((direction < 0) || (direction > 7) ||
+			!(command->directions & CMD_INTERFACE_DIRECTION (direction)))) {
+		return CMD_HANDLER_INVALID_DEVICE_MODE;
+	}
+
+	return command->handler (intf, request, device_num, direction);
+}
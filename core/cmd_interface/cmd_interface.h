@@ -16,6 +16,12 @@
  */
 #define CMD_ERROR_MESSAGE_ESCAPE_SEQ 			0xDDFF
 
+/**
+ * Escape sequence to indicate the request will be completed later and the response sent once it is
+ * available.
+ */
+#define CMD_RESPONSE_DEFERRED_ESCAPE_SEQ		0xDDFE
+
 
 /**
  * Container for request data.
@@ -35,6 +41,10 @@ struct cmd_interface_request {
 	bool crypto_timeout;			/**< Flag indicating if the request required cryptographic
 										operations and should be granted a longer timeout.  This is
 										set for every request, even when there is an error. */
+	bool can_defer;					/**< Flag indicating if the transport is able to send the
+										response after request processing returns.  The request
+										will only be deferred for background execution if this is
+										set. */
 	int channel_id;					/**< Channel on which the request is received. */
 };
 
@@ -90,10 +100,58 @@ struct cmd_interface {
 };
 
 
+/**
+ * Handler for a single command received by a command interface.
+ *
+ * @param intf The command interface processing the request.
+ * @param request The request data to process.  This will be updated to contain a response, if
+ * necessary.
+ * @param device_num Device manager index of the device that sent the request.
+ * @param direction Direction of the device that sent the request.
+ *
+ * @return 0 if the request was successfully processed or an error code.
+ */
+typedef int (*cmd_interface_command_handler) (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction);
+
+/**
+ * Get the bitmask value to use for a device direction in a command definition.
+ *
+ * @param direction The device direction.
+ */
+#define	CMD_INTERFACE_DIRECTION(direction)		(1U << (direction))
+
+/**
+ * Bitmask to use in a command definition to allow any device direction.
+ */
+#define	CMD_INTERFACE_ANY_DIRECTION				0xff
+
+/**
+ * Definition for a command supported by a command interface.  Command tables are indexed by the
+ * command ID, so the handler for a request can be found without searching.  Any entry that does
+ * not have a handler is not a supported command.
+ */
+struct cmd_interface_command {
+	cmd_interface_command_handler handler;	/**< Handler to process the command. */
+	uint8_t directions;						/**< Bitmask of device directions that can send the
+												command. */
+	uint8_t defer;							/**< Bitmask of device directions for which the
+												command can be executed in the background.  The
+												handler runs concurrently with other commands, so
+												it must not use unsynchronized shared state. */
+};
+
+
 /* Internal functions for use by derived types. */
 int cmd_interface_process_request (struct cmd_interface *intf,
 	struct cmd_interface_request *request, uint8_t *command_id, uint8_t *command_set);
 
+const struct cmd_interface_command* cmd_interface_find_command (
+	const struct cmd_interface_command *commands, size_t count, uint8_t command_id);
+int cmd_interface_execute_command (struct cmd_interface *intf,
+	const struct cmd_interface_command *command, struct cmd_interface_request *request,
+	int device_num, int direction);
+
 
 #define	CMD_HANDLER_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_HANDLER, code)
 
@@ -10,12 +10,208 @@
 #include "cerberus_protocol.h"
 #include "cerberus_protocol_required_commands.h"
 #include "cmd_interface_slave.h"
+#include "common/unused.h"
+
+
+/*
+ * Handlers for each command supported by the slave command interface.
+ */
+
+static int cmd_interface_slave_get_fw_version (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_fw_version (interface->fw_version, request);
+}
+
+static int cmd_interface_slave_get_device_capabilities (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (direction);
+
+	return cerberus_protocol_get_device_capabilities (interface->device_manager, request,
+		device_num);
+}
+
+static int cmd_interface_slave_get_device_id (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_device_id (&interface->device_id, request);
+}
+
+static int cmd_interface_slave_get_device_info (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_device_info (interface->cmd_device, request);
+}
+
+static int cmd_interface_slave_export_csr (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_export_csr (interface->riot, request);
+}
+
+static int cmd_interface_slave_import_ca_signed_cert (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_import_ca_signed_cert (interface->riot, interface->background,
+		request);
+}
+
+static int cmd_interface_slave_get_signed_cert_state (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_signed_cert_state (interface->background, request);
+}
+
+static int cmd_interface_slave_get_digest (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_certificate_digest (interface->slave_attestation, request);
+}
+
+static int cmd_interface_slave_get_certificate (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_certificate (interface->slave_attestation, request);
+}
+
+static int cmd_interface_slave_attestation_challenge (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_challenge_response (interface->slave_attestation, request);
+}
+
+static int cmd_interface_slave_reset_counter (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_reset_counter (interface->cmd_device, request);
+}
+
+/**
+ * Commands supported by the slave command interface, indexed by command ID.
+ */
+static const struct cmd_interface_command cmd_interface_slave_commands[] = {
+	[CERBERUS_PROTOCOL_GET_FW_VERSION] = {
+		cmd_interface_slave_get_fw_version,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DEVICE_CAPABILITIES] = {
+		cmd_interface_slave_get_device_capabilities,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DEVICE_ID] = {
+		cmd_interface_slave_get_device_id,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DEVICE_INFO] = {
+		cmd_interface_slave_get_device_info,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_EXPORT_CSR] = {
+		cmd_interface_slave_export_csr,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_IMPORT_CA_SIGNED_CERT] = {
+		cmd_interface_slave_import_ca_signed_cert,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_SIGNED_CERT_STATE] = {
+		cmd_interface_slave_get_signed_cert_state,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DIGEST] = {
+		cmd_interface_slave_get_digest,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_CERTIFICATE] = {
+		cmd_interface_slave_get_certificate,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE] = {
+		cmd_interface_slave_attestation_challenge,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_RESET_COUNTER] = {
+		cmd_interface_slave_reset_counter,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+};
+
+/**
+ * The number of entries in the slave command table.
+ */
+#define	CMD_INTERFACE_SLAVE_COMMAND_COUNT	\
+	(sizeof (cmd_interface_slave_commands) / sizeof (cmd_interface_slave_commands[0]))
 
 
 static int cmd_interface_slave_process_request (struct cmd_interface *intf,
 	struct cmd_interface_request *request)
 {
 	struct cmd_interface_slave *interface = (struct cmd_interface_slave*) intf;
+	const struct cmd_interface_command *command;
 	uint8_t command_id;
 	uint8_t command_set;
 	int device_num;
@@ -34,45 +230,12 @@ static int cmd_interface_slave_process_request (struct cmd_interface *intf,
 		return device_num;
 	}
 
-	switch (command_id) {
-		case CERBERUS_PROTOCOL_GET_FW_VERSION:
-			return cerberus_protocol_get_fw_version (interface->fw_version, request);
-
-		case CERBERUS_PROTOCOL_GET_DIGEST:
-			return cerberus_protocol_get_certificate_digest (interface->slave_attestation, request);
+	command = cmd_interface_find_command (cmd_interface_slave_commands,
+		CMD_INTERFACE_SLAVE_COMMAND_COUNT, command_id);
 
-		case CERBERUS_PROTOCOL_GET_CERTIFICATE:
-			return cerberus_protocol_get_certificate (interface->slave_attestation, request);
-
-		case CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE:
-			return cerberus_protocol_get_challenge_response (interface->slave_attestation, request);
-
-		case CERBERUS_PROTOCOL_GET_DEVICE_CAPABILITIES:
-			return cerberus_protocol_get_device_capabilities (interface->device_manager,
-				request, device_num);
-
-		case CERBERUS_PROTOCOL_EXPORT_CSR:
-			return cerberus_protocol_export_csr (interface->riot, request);
-
-		case CERBERUS_PROTOCOL_IMPORT_CA_SIGNED_CERT:
-			return cerberus_protocol_import_ca_signed_cert (interface->riot, interface->background,
-				request);
-
-		case CERBERUS_PROTOCOL_GET_SIGNED_CERT_STATE:
-			return cerberus_protocol_get_signed_cert_state (interface->background, request);
-
-		case CERBERUS_PROTOCOL_GET_DEVICE_INFO:
-			return cerberus_protocol_get_device_info (interface->cmd_device, request);
-
-		case CERBERUS_PROTOCOL_GET_DEVICE_ID:
-			return cerberus_protocol_get_device_id (&interface->device_id, request);
-
-		case CERBERUS_PROTOCOL_RESET_COUNTER:
-			return cerberus_protocol_reset_counter (interface->cmd_device, request);
-
-		default:
-			return CMD_HANDLER_UNKNOWN_COMMAND;
-	}
+	/* All requests received by a slave device come from upstream. */
+	return cmd_interface_execute_command (intf, command, request, device_num,
+		DEVICE_MANAGER_UPSTREAM);
 }
 
 int cmd_interface_slave_issue_request (struct cmd_interface *intf, uint8_t command_id,
@@ -13,226 +13,941 @@
 #include "cerberus_protocol_optional_commands.h"
 #include "cerberus_protocol_debug_commands.h"
 #include "cmd_interface_system.h"
+#include "common/unused.h"
 
 
-int cmd_interface_system_process_request (struct cmd_interface *intf,
-	struct cmd_interface_request *request)
+static int cmd_interface_system_process_deferred_request (struct cmd_interface *intf,
+	struct cmd_interface_request *request);
+
+
+/*
+ * Handlers for each command supported by the System command interface.  Each handler passes the
+ * request to the Cerberus protocol implementation of the command using the components required by
+ * that command.
+ */
+
+static int cmd_interface_system_get_fw_version (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
 {
 	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
-	uint8_t command_id;
-	uint8_t command_set;
-	int device_num;
-	int direction;
-	int status;
 
-	status = cmd_interface_process_request (&interface->base, request, &command_id, &command_set);
-	if (status != 0) {
-		return status;
-	}
+	UNUSED (device_num);
+	UNUSED (direction);
 
-	device_num = device_manager_get_device_num (interface->device_manager, request->source_eid);
-	if (ROT_IS_ERROR (device_num)) {
-		return device_num;
-	}
+	return cerberus_protocol_get_fw_version (interface->fw_version, request);
+}
 
-	direction = device_manager_get_device_direction (interface->device_manager, device_num);
-	if (ROT_IS_ERROR (direction)) {
-		return direction;
-	}
+static int cmd_interface_system_get_device_capabilities (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-	switch (command_id) {
-		case CERBERUS_PROTOCOL_GET_FW_VERSION:
-			return cerberus_protocol_get_fw_version (interface->fw_version, request);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_GET_DIGEST:
-			if (direction == DEVICE_MANAGER_UPSTREAM) {
-				return cerberus_protocol_get_certificate_digest (interface->slave_attestation,
-					request);
-			}
-			else if (direction == DEVICE_MANAGER_DOWNSTREAM) {
-				return cerberus_protocol_process_certificate_digest (interface->master_attestation,
-					request);
-			}
+	return cerberus_protocol_get_device_capabilities (interface->device_manager, request,
+		device_num);
+}
 
-			return CMD_HANDLER_INVALID_DEVICE_MODE;
+static int cmd_interface_system_get_device_id (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_GET_CERTIFICATE:
-			if (direction == DEVICE_MANAGER_UPSTREAM) {
-				return cerberus_protocol_get_certificate (interface->slave_attestation, request);
-			}
-			if (direction == DEVICE_MANAGER_DOWNSTREAM) {
-				return cerberus_protocol_process_certificate (interface->master_attestation,
-					request);
-			}
+	UNUSED (device_num);
+	UNUSED (direction);
 
-			return CMD_HANDLER_INVALID_DEVICE_MODE;
+	return cerberus_protocol_get_device_id (&interface->device_id, request);
+}
 
-		case CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE:
-			if (direction == DEVICE_MANAGER_UPSTREAM) {
-				return cerberus_protocol_get_challenge_response (interface->slave_attestation,
-					request);
-			}
-			if (direction == DEVICE_MANAGER_DOWNSTREAM) {
-				return cerberus_protocol_process_challenge_response (interface->master_attestation,
-					request);
-			}
+static int cmd_interface_system_get_device_info (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_device_info (interface->cmd_device, request);
+}
+
+static int cmd_interface_system_export_csr (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_export_csr (interface->riot, request);
+}
+
+static int cmd_interface_system_import_ca_signed_cert (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_import_ca_signed_cert (interface->riot, interface->background,
+		request);
+}
+
+static int cmd_interface_system_get_signed_cert_state (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
 
-			return CMD_HANDLER_INVALID_DEVICE_MODE;
+	return cerberus_protocol_get_signed_cert_state (interface->background, request);
+}
 
-		case CERBERUS_PROTOCOL_GET_LOG_INFO:
-			return cerberus_protocol_get_log_info (interface->pcr_store, request);
+static int cmd_interface_system_get_host_state (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_host_reset_status (interface->host_0_ctrl, interface->host_1_ctrl,
+		request);
+}
+
+static int cmd_interface_system_get_log_info (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_log_info (interface->pcr_store, request);
+}
+
+static int cmd_interface_system_read_log (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_READ_LOG:
-			return cerberus_protocol_log_read (interface->pcr_store, interface->hash, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_CLEAR_LOG:
-			return cerberus_protocol_log_clear (interface->background, request);
+	return cerberus_protocol_log_read (interface->pcr_store, interface->hash, request);
+}
 
-		case CERBERUS_PROTOCOL_GET_PFM_ID:
-			return cerberus_protocol_get_pfm_id (interface->pfm_manager_0, interface->pfm_manager_1,
-				request);
+static int cmd_interface_system_clear_log (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_GET_PFM_SUPPORTED_FW:
-			return cerberus_protocol_get_pfm_fw (interface->pfm_0, interface->pfm_1,
-				interface->pfm_manager_0, interface->pfm_manager_1, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_INIT_PFM_UPDATE:
-			return cerberus_protocol_pfm_update_init (interface->pfm_0, interface->pfm_1, request);
+	return cerberus_protocol_log_clear (interface->background, request);
+}
 
-		case CERBERUS_PROTOCOL_PFM_UPDATE:
-			return cerberus_protocol_pfm_update (interface->pfm_0, interface->pfm_1, request);
+static int cmd_interface_system_get_attestation_data (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE:
-			return cerberus_protocol_pfm_update_complete (interface->pfm_0, interface->pfm_1,
-				request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_GET_CFM_ID:
-			return cerberus_protocol_get_cfm_id (interface->cfm_manager, request);
+	return cerberus_protocol_get_attestation_data (interface->pcr_store, request);
+}
 
-		case CERBERUS_PROTOCOL_INIT_CFM_UPDATE:
-			return cerberus_protocol_cfm_update_init (interface->cfm, request);
+static int cmd_interface_system_get_pfm_id (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_CFM_UPDATE:
-			return cerberus_protocol_cfm_update (interface->cfm, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_COMPLETE_CFM_UPDATE:
-			return cerberus_protocol_cfm_update_complete (interface->cfm, request);
+	return cerberus_protocol_get_pfm_id (interface->pfm_manager_0, interface->pfm_manager_1,
+		request);
+}
 
-		case CERBERUS_PROTOCOL_GET_PCD_ID:
-			return cerberus_protocol_get_pcd_id (interface->pcd_manager, request);
+static int cmd_interface_system_get_pfm_supported_fw (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_INIT_PCD_UPDATE:
-			return cerberus_protocol_pcd_update_init (interface->pcd, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_PCD_UPDATE:
-			return cerberus_protocol_pcd_update (interface->pcd, request);
+	return cerberus_protocol_get_pfm_fw (interface->pfm_0, interface->pfm_1,
+		interface->pfm_manager_0, interface->pfm_manager_1, request);
+}
 
-		case CERBERUS_PROTOCOL_COMPLETE_PCD_UPDATE:
-			return cerberus_protocol_pcd_update_complete (interface->pcd, request);
+static int cmd_interface_system_init_pfm_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_GET_CFM_SUPPORTED_COMPONENT_IDS:
-			return cerberus_protocol_get_cfm_component_ids (interface->cfm_manager, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_INIT_FW_UPDATE:
-			return cerberus_protocol_fw_update_init (interface->control, request);
+	return cerberus_protocol_pfm_update_init (interface->pfm_0, interface->pfm_1, request);
+}
 
-		case CERBERUS_PROTOCOL_FW_UPDATE:
-			return cerberus_protocol_fw_update (interface->control, request);
+static int cmd_interface_system_pfm_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_COMPLETE_FW_UPDATE:
-			return cerberus_protocol_fw_update_start (interface->control, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_GET_UPDATE_STATUS:
-			return cerberus_protocol_get_update_status (interface->control, interface->pfm_0,
-				interface->pfm_1, interface->cfm, interface->pcd, interface->host_0,
-				interface->host_1, interface->recovery_cmd_0, interface->recovery_cmd_1,
-				interface->background, request);
+	return cerberus_protocol_pfm_update (interface->pfm_0, interface->pfm_1, request);
+}
 
-		case CERBERUS_PROTOCOL_GET_EXT_UPDATE_STATUS:
-			return cerberus_protocol_get_extended_update_status (interface->control,
-				interface->recovery_manager_0, interface->recovery_manager_1,
-				interface->recovery_cmd_0, interface->recovery_cmd_1, request);
+static int cmd_interface_system_complete_pfm_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_GET_DEVICE_CAPABILITIES:
-			return cerberus_protocol_get_device_capabilities (interface->device_manager,
-				request, device_num);
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_pfm_update_complete (interface->pfm_0, interface->pfm_1, request);
+}
+
+static int cmd_interface_system_get_cfm_id (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_cfm_id (interface->cfm_manager, request);
+}
+
+static int cmd_interface_system_init_cfm_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_cfm_update_init (interface->cfm, request);
+}
+
+static int cmd_interface_system_cfm_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_cfm_update (interface->cfm, request);
+}
+
+static int cmd_interface_system_complete_cfm_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_cfm_update_complete (interface->cfm, request);
+}
+
+static int cmd_interface_system_get_pcd_id (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_pcd_id (interface->pcd_manager, request);
+}
+
+static int cmd_interface_system_init_pcd_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_pcd_update_init (interface->pcd, request);
+}
+
+static int cmd_interface_system_pcd_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_pcd_update (interface->pcd, request);
+}
+
+static int cmd_interface_system_complete_pcd_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_pcd_update_complete (interface->pcd, request);
+}
+
+static int cmd_interface_system_init_fw_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_fw_update_init (interface->control, request);
+}
+
+static int cmd_interface_system_fw_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_fw_update (interface->control, request);
+}
+
+static int cmd_interface_system_get_update_status (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_update_status (interface->control, interface->pfm_0,
+		interface->pfm_1, interface->cfm, interface->pcd, interface->host_0, interface->host_1,
+		interface->recovery_cmd_0, interface->recovery_cmd_1, interface->background, request);
+}
+
+static int cmd_interface_system_complete_fw_update (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_fw_update_start (interface->control, request);
+}
+
+static int cmd_interface_system_reset_config (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_reset_config (interface->auth, interface->background, request);
+}
+
+static int cmd_interface_system_prepare_recovery_image (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_prepare_recovery_image (interface->recovery_cmd_0,
+		interface->recovery_cmd_1, request);
+}
+
+static int cmd_interface_system_update_recovery_image (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_update_recovery_image (interface->recovery_cmd_0,
+		interface->recovery_cmd_1, request);
+}
 
-		case CERBERUS_PROTOCOL_RESET_COUNTER:
-			return cerberus_protocol_reset_counter (interface->cmd_device, request);
+static int cmd_interface_system_activate_recovery_image (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_activate_recovery_image (interface->recovery_cmd_0,
+		interface->recovery_cmd_1, request);
+}
+
+static int cmd_interface_system_get_recovery_image_version (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_recovery_image_id (interface->recovery_manager_0,
+		interface->recovery_manager_1, request);
+}
+
+/**
+ * Report the result of processing an attestation response from a downstream device to the
+ * attestation scheduler.
+ *
+ * @param interface The System command interface that processed the response.
+ * @param request The processed response.  This will contain the next request to send to the
+ * device, if there is one.
+ * @param device_num Device manager index of the device that sent the response.
+ * @param status The result of processing the response.
+ *
+ * @return The response processing status.
+ */
+static int cmd_interface_system_attestation_response (struct cmd_interface_system *interface,
+	struct cmd_interface_request *request, int device_num, int status)
+{
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) request->data;
+	int next_command = ATTESTATION_SCHEDULER_NO_COMMAND;
+
+	if (interface->attestation_scheduler != NULL) {
+		if ((status == 0) && request->new_request && (request->length != 0)) {
+			next_command = header->command;
+		}
+
+		attestation_scheduler_update (interface->attestation_scheduler, device_num, status,
+			next_command);
+	}
+
+	return status;
+}
+
+static int cmd_interface_system_get_digest (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+	int status;
+
+	if (direction == DEVICE_MANAGER_UPSTREAM) {
+		return cerberus_protocol_get_certificate_digest (interface->slave_attestation, request);
+	}
+
+	status = cerberus_protocol_process_certificate_digest (interface->master_attestation,
+		request);
+
+	return cmd_interface_system_attestation_response (interface, request, device_num, status);
+}
+
+static int cmd_interface_system_get_certificate (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+	int status;
+
+	if (direction == DEVICE_MANAGER_UPSTREAM) {
+		return cerberus_protocol_get_certificate (interface->slave_attestation, request);
+	}
+
+	status = cerberus_protocol_process_certificate (interface->master_attestation, request);
+
+	return cmd_interface_system_attestation_response (interface, request, device_num, status);
+}
+
+static int cmd_interface_system_attestation_challenge (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+	int status;
+
+	if (direction == DEVICE_MANAGER_UPSTREAM) {
+		return cerberus_protocol_get_challenge_response (interface->slave_attestation, request);
+	}
 
-		case CERBERUS_PROTOCOL_UNSEAL_MESSAGE:
-			return cerberus_protocol_unseal_message (interface->background, request);
+	status = cerberus_protocol_process_challenge_response (interface->master_attestation,
+		request);
 
-		case CERBERUS_PROTOCOL_UNSEAL_MESSAGE_RESULT:
-			return cerberus_protocol_unseal_message_result (interface->background, request);
+	return cmd_interface_system_attestation_response (interface, request, device_num, status);
+}
 
-		case CERBERUS_PROTOCOL_EXPORT_CSR:
-			return cerberus_protocol_export_csr (interface->riot, request);
+static int cmd_interface_system_reset_counter (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_IMPORT_CA_SIGNED_CERT:
-			return cerberus_protocol_import_ca_signed_cert (interface->riot, interface->background,
-				request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_GET_SIGNED_CERT_STATE:
-			return cerberus_protocol_get_signed_cert_state (interface->background, request);
+	return cerberus_protocol_reset_counter (interface->cmd_device, request);
+}
 
-		case CERBERUS_PROTOCOL_RESET_CONFIG:
-			return cerberus_protocol_reset_config (interface->auth, interface->background, request);
+static int cmd_interface_system_unseal_message (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_PREPARE_RECOVERY_IMAGE:
-			return cerberus_protocol_prepare_recovery_image (interface->recovery_cmd_0,
-				interface->recovery_cmd_1, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_UPDATE_RECOVERY_IMAGE:
-			return cerberus_protocol_update_recovery_image (interface->recovery_cmd_0,
-				interface->recovery_cmd_1, request);
+	return cerberus_protocol_unseal_message (interface->background, request);
+}
 
-		case CERBERUS_PROTOCOL_ACTIVATE_RECOVERY_IMAGE:
-			return cerberus_protocol_activate_recovery_image (interface->recovery_cmd_0,
-				interface->recovery_cmd_1, request);
+static int cmd_interface_system_unseal_message_result (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_GET_RECOVERY_IMAGE_VERSION:
-			return cerberus_protocol_get_recovery_image_id (interface->recovery_manager_0,
-				interface->recovery_manager_1, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_GET_HOST_STATE:
-			return cerberus_protocol_get_host_reset_status (interface->host_0_ctrl,
-				interface->host_1_ctrl, request);
+	return cerberus_protocol_unseal_message_result (interface->background, request);
+}
 
-		case CERBERUS_PROTOCOL_GET_DEVICE_INFO:
-			return cerberus_protocol_get_device_info (interface->cmd_device, request);
+static int cmd_interface_system_get_cfm_supported_component_ids (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_GET_DEVICE_ID:
-			return cerberus_protocol_get_device_id (&interface->device_id, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_GET_ATTESTATION_DATA:
-			return cerberus_protocol_get_attestation_data (interface->pcr_store, request);
+	return cerberus_protocol_get_cfm_component_ids (interface->cfm_manager, request);
+}
+
+static int cmd_interface_system_get_ext_update_status (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_extended_update_status (interface->control,
+		interface->recovery_manager_0, interface->recovery_manager_1, interface->recovery_cmd_0,
+		interface->recovery_cmd_1, request);
+}
 
 #ifdef ENABLE_DEBUG_COMMANDS
-		case CERBERUS_PROTOCOL_DEBUG_START_ATTESTATION:
-			return cerberus_protocol_start_attestation (request);
+static int cmd_interface_system_debug_start_attestation (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	UNUSED (intf);
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_start_attestation (request);
+}
+
+static int cmd_interface_system_debug_get_attestation_state (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_attestation_state (interface->device_manager, request);
+}
+
+static int cmd_interface_system_debug_fill_log (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_DEBUG_GET_ATTESTATION_STATE:
-			return cerberus_protocol_get_attestation_state (interface->device_manager, request);
+	return cerberus_protocol_debug_fill_log (interface->background, request);
+}
 
-		case CERBERUS_PROTOCOL_DEBUG_FILL_LOG:
-			return cerberus_protocol_debug_fill_log (interface->background, request);
+static int cmd_interface_system_debug_get_device_manager_cert (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_device_certificate (interface->device_manager, request);
+}
+
+static int cmd_interface_system_debug_get_device_manager_cert_digest (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+
+	UNUSED (device_num);
+	UNUSED (direction);
+
+	return cerberus_protocol_get_device_cert_digest (interface->device_manager,
+		interface->hash, request);
+}
+
+static int cmd_interface_system_debug_get_device_manager_challenge (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
 
-		case CERBERUS_PROTOCOL_DEBUG_GET_DEVICE_MANAGER_CERT:
-			return cerberus_protocol_get_device_certificate (interface->device_manager, request);
+	UNUSED (device_num);
+	UNUSED (direction);
 
-		case CERBERUS_PROTOCOL_DEBUG_GET_DEVICE_MANAGER_CERT_DIGEST:
-			return cerberus_protocol_get_device_cert_digest (interface->device_manager,
-				interface->hash, request);
+	return cerberus_protocol_get_device_challenge (interface->device_manager,
+		interface->master_attestation, interface->hash, request);
+}
+#endif
 
-		case CERBERUS_PROTOCOL_DEBUG_GET_DEVICE_MANAGER_CHALLENGE:
-			return cerberus_protocol_get_device_challenge (interface->device_manager,
-				interface->master_attestation, interface->hash, request);
+/**
+ * Commands supported by the System command interface, indexed by command ID.
+ */
+static const struct cmd_interface_command cmd_interface_system_commands[] = {
+	[CERBERUS_PROTOCOL_GET_FW_VERSION] = {
+		cmd_interface_system_get_fw_version,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DEVICE_CAPABILITIES] = {
+		cmd_interface_system_get_device_capabilities,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DEVICE_ID] = {
+		cmd_interface_system_get_device_id,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DEVICE_INFO] = {
+		cmd_interface_system_get_device_info,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_EXPORT_CSR] = {
+		cmd_interface_system_export_csr,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_IMPORT_CA_SIGNED_CERT] = {
+		cmd_interface_system_import_ca_signed_cert,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_SIGNED_CERT_STATE] = {
+		cmd_interface_system_get_signed_cert_state,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_HOST_STATE] = {
+		cmd_interface_system_get_host_state,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_LOG_INFO] = {
+		cmd_interface_system_get_log_info,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_READ_LOG] = {
+		cmd_interface_system_read_log,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_CLEAR_LOG] = {
+		cmd_interface_system_clear_log,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_ATTESTATION_DATA] = {
+		cmd_interface_system_get_attestation_data,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_PFM_ID] = {
+		cmd_interface_system_get_pfm_id,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_PFM_SUPPORTED_FW] = {
+		cmd_interface_system_get_pfm_supported_fw,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_INIT_PFM_UPDATE] = {
+		cmd_interface_system_init_pfm_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_PFM_UPDATE] = {
+		cmd_interface_system_pfm_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE] = {
+		cmd_interface_system_complete_pfm_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_CFM_ID] = {
+		cmd_interface_system_get_cfm_id,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_INIT_CFM_UPDATE] = {
+		cmd_interface_system_init_cfm_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_CFM_UPDATE] = {
+		cmd_interface_system_cfm_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_COMPLETE_CFM_UPDATE] = {
+		cmd_interface_system_complete_cfm_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_PCD_ID] = {
+		cmd_interface_system_get_pcd_id,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_INIT_PCD_UPDATE] = {
+		cmd_interface_system_init_pcd_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_PCD_UPDATE] = {
+		cmd_interface_system_pcd_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_COMPLETE_PCD_UPDATE] = {
+		cmd_interface_system_complete_pcd_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_INIT_FW_UPDATE] = {
+		cmd_interface_system_init_fw_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_FW_UPDATE] = {
+		cmd_interface_system_fw_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_UPDATE_STATUS] = {
+		cmd_interface_system_get_update_status,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_COMPLETE_FW_UPDATE] = {
+		cmd_interface_system_complete_fw_update,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_RESET_CONFIG] = {
+		cmd_interface_system_reset_config,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_PREPARE_RECOVERY_IMAGE] = {
+		cmd_interface_system_prepare_recovery_image,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_UPDATE_RECOVERY_IMAGE] = {
+		cmd_interface_system_update_recovery_image,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_ACTIVATE_RECOVERY_IMAGE] = {
+		cmd_interface_system_activate_recovery_image,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_RECOVERY_IMAGE_VERSION] = {
+		cmd_interface_system_get_recovery_image_version,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_DIGEST] = {
+		cmd_interface_system_get_digest,
+		CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_UPSTREAM) |
+			CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_DOWNSTREAM),
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_CERTIFICATE] = {
+		cmd_interface_system_get_certificate,
+		CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_UPSTREAM) |
+			CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_DOWNSTREAM),
+		0
+	},
+	[CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE] = {
+		cmd_interface_system_attestation_challenge,
+		CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_UPSTREAM) |
+			CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_DOWNSTREAM),
+		CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_UPSTREAM)
+	},
+	[CERBERUS_PROTOCOL_RESET_COUNTER] = {
+		cmd_interface_system_reset_counter,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_UNSEAL_MESSAGE] = {
+		cmd_interface_system_unseal_message,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_UNSEAL_MESSAGE_RESULT] = {
+		cmd_interface_system_unseal_message_result,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_CFM_SUPPORTED_COMPONENT_IDS] = {
+		cmd_interface_system_get_cfm_supported_component_ids,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_GET_EXT_UPDATE_STATUS] = {
+		cmd_interface_system_get_ext_update_status,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+#ifdef ENABLE_DEBUG_COMMANDS
+	[CERBERUS_PROTOCOL_DEBUG_START_ATTESTATION] = {
+		cmd_interface_system_debug_start_attestation,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_DEBUG_GET_ATTESTATION_STATE] = {
+		cmd_interface_system_debug_get_attestation_state,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_DEBUG_FILL_LOG] = {
+		cmd_interface_system_debug_fill_log,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_DEBUG_GET_DEVICE_MANAGER_CERT] = {
+		cmd_interface_system_debug_get_device_manager_cert,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_DEBUG_GET_DEVICE_MANAGER_CERT_DIGEST] = {
+		cmd_interface_system_debug_get_device_manager_cert_digest,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
+	[CERBERUS_PROTOCOL_DEBUG_GET_DEVICE_MANAGER_CHALLENGE] = {
+		cmd_interface_system_debug_get_device_manager_challenge,
+		CMD_INTERFACE_ANY_DIRECTION,
+		0
+	},
 #endif
+};
 
-		default:
-			return CMD_HANDLER_UNKNOWN_COMMAND;
+/**
+ * The number of entries in the System command table.
+ */
+#define	CMD_INTERFACE_SYSTEM_COMMAND_COUNT	\
+	(sizeof (cmd_interface_system_commands) / sizeof (cmd_interface_system_commands[0]))
+
+
+/**
+ * Process a received request.
+ *
+ * @param intf The command interface that will process the request.
+ * @param request The request data to process.
+ * @param allow_defer Flag indicating if long-running requests can be deferred to the worker task.
+ *
+ * @return 0 if the request was successfully processed or an error code.
+ */
+static int cmd_interface_system_process (struct cmd_interface *intf,
+	struct cmd_interface_request *request, bool allow_defer)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+	const struct cmd_interface_command *command;
+	uint8_t command_id;
+	uint8_t command_set;
+	int device_num;
+	int direction;
+	int status;
+
+	status = cmd_interface_process_request (&interface->base, request, &command_id, &command_set);
+	if (status != 0) {
+		return status;
+	}
+
+	device_num = device_manager_get_device_num (interface->device_manager, request->source_eid);
+	if (ROT_IS_ERROR (device_num)) {
+		return device_num;
 	}
+
+	direction = device_manager_get_device_direction (interface->device_manager, device_num);
+	if (ROT_IS_ERROR (direction)) {
+		return direction;
+	}
+
+	command = cmd_interface_find_command (interface->platform_cmds, interface->platform_cmd_count,
+		command_id);
+	if (command == NULL) {
+		command = cmd_interface_find_command (cmd_interface_system_commands,
+			CMD_INTERFACE_SYSTEM_COMMAND_COUNT, command_id);
+	}
+
+	if (allow_defer && request->can_defer && (interface->async != NULL) && (command != NULL) &&
+		(command->defer & CMD_INTERFACE_DIRECTION (direction))) {
+		status = cmd_async_submit (interface->async, intf,
+			cmd_interface_system_process_deferred_request, request);
+		if (status == 0) {
+			return CMD_RESPONSE_DEFERRED_ESCAPE_SEQ;
+		}
+		else if (status != CMD_ASYNC_BUSY) {
+			return status;
+		}
+
+		/* Only one request can be deferred at a time, so process this one immediately. */
+	}
+
+	return cmd_interface_execute_command (intf, command, request, device_num, direction);
+}
+
+/**
+ * Process a request that was deferred to the worker task.
+ *
+ * @param intf The command interface that deferred the request.
+ * @param request The request data to process.  This will be updated with the response.
+ *
+ * @return 0 if the request was successfully processed or an error code.
+ */
+static int cmd_interface_system_process_deferred_request (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	return cmd_interface_system_process (intf, request, false);
+}
+
+int cmd_interface_system_process_request (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	return cmd_interface_system_process (intf, request, true);
 }
 
 int cmd_interface_system_issue_request (struct cmd_interface *intf, uint8_t command_id,
@@ -389,6 +1104,81 @@ int cmd_interface_system_init (struct cmd_interface_system *intf,
 	return 0;
 }
 
+/**
+ * Enable deferred execution of long-running requests.  Commands that are marked for deferral will
+ * be executed by a worker task, allowing other requests to be processed while the operation
+ * completes.
+ *
+ * Of the standard System commands, only attestation challenges from upstream devices are deferred.
+ * Generating the signed challenge response is the slowest of these commands, and the attestation
+ * responder serializes access to its keys and hash engine.  Other commands share attestation and
+ * device state that is not protected against concurrent access, so they are always processed
+ * immediately.
+ *
+ * @param intf The System command interface instance to configure.
+ * @param async The context for deferred request execution.  Set this to null to process all
+ * requests immediately.
+ *
+ * @return 0 if deferred execution was configured or an error code.
+ */
+int cmd_interface_system_set_async (struct cmd_interface_system *intf, struct cmd_async *async)
+{
+	if (intf == NULL) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	intf->async = async;
+
+	return 0;
+}
+
+/**
+ * Enable tracking of downstream device attestation.  The scheduler will be updated as attestation
+ * responses are received from devices.
+ *
+ * @param intf The System command interface instance to configure.
+ * @param scheduler The attestation scheduler to update.  Set this to null to disable tracking.
+ *
+ * @return 0 if the scheduler was configured or an error code.
+ */
+int cmd_interface_system_set_attestation_scheduler (struct cmd_interface_system *intf,
+	struct attestation_scheduler *scheduler)
+{
+	if (intf == NULL) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	intf->attestation_scheduler = scheduler;
+
+	return 0;
+}
+
+/**
+ * Register additional commands to be handled by the System command interface.  Platform commands
+ * are checked before the standard command set, so a platform command will replace a standard
+ * command with the same ID.  Handlers for platform commands will be called with the System command
+ * interface instance.
+ *
+ * @param intf The System command interface instance to configure.
+ * @param commands The platform command table, indexed by command ID.  This must remain valid for
+ * the lifetime of the command interface.  Set this to null to remove any platform commands.
+ * @param count The number of entries in the platform command table.
+ *
+ * @return 0 if the platform commands were registered or an error code.
+ */
+int cmd_interface_system_set_platform_commands (struct cmd_interface_system *intf,
+	const struct cmd_interface_command *commands, size_t count)
+{
+	if ((intf == NULL) || ((commands == NULL) && (count != 0))) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	intf->platform_cmds = commands;
+	intf->platform_cmd_count = (commands != NULL) ? count : 0;
+
+	return 0;
+}
+
 /**
  * Deinitialize System command interface instance
  *
@@ -8,9 +8,11 @@
 #include <stdbool.h>
 #include "attestation/attestation_master.h"
 #include "attestation/attestation_slave.h"
+#include "attestation/attestation_scheduler.h"
 #include "cmd_interface.h"
 #include "device_manager.h"
 #include "cmd_background.h"
+#include "cmd_async.h"
 #include "cmd_authorization.h"
 #include "crypto/hash.h"
 #include "firmware/firmware_update_control.h"
@@ -58,6 +60,10 @@ struct cmd_interface_system {
 	struct recovery_image_cmd_interface *recovery_cmd_1;	/**< Recovery image update command interface instance for port 1 */
 	struct cmd_device *cmd_device;							/**< Device command handler instance */
 	struct cmd_interface_device_id device_id;				/**< Device ID information */
+	struct cmd_async *async;								/**< Context for deferred request execution */
+	const struct cmd_interface_command *platform_cmds;		/**< Platform command table, indexed by command ID */
+	size_t platform_cmd_count;								/**< Number of entries in the platform command table */
+	struct attestation_scheduler *attestation_scheduler;	/**< Scheduler for attesting downstream devices */
 };
 
 
@@ -80,6 +86,12 @@ int cmd_interface_system_init (struct cmd_interface_system *intf,
 );
 void cmd_interface_system_deinit (struct cmd_interface_system *intf);
 
+int cmd_interface_system_set_async (struct cmd_interface_system *intf, struct cmd_async *async);
+int cmd_interface_system_set_attestation_scheduler (struct cmd_interface_system *intf,
+	struct attestation_scheduler *scheduler);
+int cmd_interface_system_set_platform_commands (struct cmd_interface_system *intf,
+	const struct cmd_interface_command *commands, size_t count);
+
 /* Internal functions for use by derived types. */
 int cmd_interface_system_process_request (struct cmd_interface *intf,
 	struct cmd_interface_request *request);
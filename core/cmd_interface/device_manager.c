@@ -10,6 +10,23 @@
 #include "mctp/mctp_protocol.h"
 
 
+/**
+ * Rebuild the index used to look up device table entries by EID.  If multiple entries have the same
+ * EID, the index will refer to the first matching entry.
+ *
+ * @param mgr The device manager to update.
+ */
+static void device_manager_update_eid_index (struct device_manager *mgr)
+{
+	int i_device;
+
+	memset (mgr->eid_index, 0, sizeof (mgr->eid_index));
+
+	for (i_device = mgr->num_devices; i_device > 0; --i_device) {
+		mgr->eid_index[mgr->entries[i_device - 1].info.eid] = i_device;
+	}
+}
+
 /**
  * Initialize a device manager.
  *
@@ -49,10 +66,24 @@ int device_manager_init (struct device_manager *mgr, int num_devices, uint8_t hi
 	mgr->entries[0].info.capabilities.max_sig = MCTP_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
 
 	mgr->num_devices = num_devices;
+	mgr->last_chain_version = 0;
+	device_manager_update_eid_index (mgr);
 
 	return 0;
 }
 
+/**
+ * Assign a new version to the certificate chain for a single device entry.  Versions are unique
+ * across all entries, so a change to any chain can be detected by comparing the version.
+ *
+ * @param mgr Device manager instance.
+ * @param device_num Device table entry that was modified.
+ */
+static void device_manager_update_cert_chain_version (struct device_manager *mgr, int device_num)
+{
+	mgr->entries[device_num].cert_chain.version = ++mgr->last_chain_version;
+}
+
 /**
  * Release a single certificate.
  *
@@ -105,6 +136,7 @@ void device_manager_release (struct device_manager *mgr)
 		platform_free (mgr->entries);
 
 		mgr->num_devices = 0;
+		memset (mgr->eid_index, 0, sizeof (mgr->eid_index));
 	}
 }
 
@@ -144,6 +176,7 @@ int device_manager_resize_entries_table (struct device_manager *mgr, int num_dev
 
 	mgr->entries = (struct device_manager_entry*) temp;
 	mgr->num_devices = num_devices;
+	device_manager_update_eid_index (mgr);
 
 	return 0;
 }
@@ -158,19 +191,15 @@ int device_manager_resize_entries_table (struct device_manager *mgr, int num_dev
  */
 int device_manager_get_device_num (struct device_manager *mgr, uint8_t eid)
 {
-	int i_device;
-
 	if (mgr == NULL) {
 		return DEVICE_MGR_INVALID_ARGUMENT;
 	}
 
-	for (i_device = 0; i_device < mgr->num_devices; ++i_device) {
-		if (mgr->entries[i_device].info.eid == eid) {
-			return i_device;
-		}
+	if (mgr->eid_index[eid] == 0) {
+		return DEVICE_MGR_UNKNOWN_DEVICE;
 	}
 
-	return DEVICE_MGR_UNKNOWN_DEVICE;
+	return mgr->eid_index[eid] - 1;
 }
 
 /**
@@ -256,6 +285,7 @@ int device_manager_update_device_eid (struct device_manager *mgr, int device_num
 	}
 
 	mgr->entries[device_num].info.eid = eid;
+	device_manager_update_eid_index (mgr);
 
 	return 0;
 }
@@ -285,6 +315,7 @@ int device_manager_update_device_entry (struct device_manager *mgr, int device_n
 	mgr->entries[device_num].direction = direction;
 	mgr->entries[device_num].info.eid = eid;
 	mgr->entries[device_num].info.smbus_addr = smbus_addr;
+	device_manager_update_eid_index (mgr);
 
 	return 0;
 }
@@ -588,6 +619,7 @@ int device_manager_init_cert_chain (struct device_manager *mgr, int device_num,
 	}
 
 	device_manager_release_cert_chain (mgr, device_num);
+	device_manager_update_cert_chain_version (mgr, device_num);
 
 	mgr->entries[device_num].cert_chain.cert = platform_calloc (num_cert, sizeof (struct der_cert));
 
@@ -627,6 +659,7 @@ int device_manager_update_cert (struct device_manager *mgr, int device_num, uint
 	}
 
 	device_manager_release_cert (&mgr->entries[device_num].cert_chain.cert[cert_num]);
+	device_manager_update_cert_chain_version (mgr, device_num);
 
 	mgr->entries[device_num].cert_chain.cert[cert_num].cert = platform_malloc (buf_len);
 
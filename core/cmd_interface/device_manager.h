@@ -139,6 +139,7 @@ struct device_manager_info {
 struct device_manager_cert_chain {
 	struct der_cert *cert;								/**< Certificate. */
 	uint8_t num_cert;									/**< Number of certificates in chain. */
+	uint32_t version;									/**< Identifier for the chain contents.  This changes every time the chain is modified. */
 };
 
 /**
@@ -151,6 +152,11 @@ struct device_manager_entry {
 	uint8_t state;										/**< Device state */
 };
 
+/**
+ * Number of entries in the EID lookup index.  There is an entry for every possible EID.
+ */
+#define	DEVICE_MANAGER_EID_INDEX_SIZE					256
+
 /**
  * Module which holds a table of all devices Cerberus expects to communicate with and itself,
  * to be populated from PCD
@@ -158,6 +164,8 @@ struct device_manager_entry {
 struct device_manager {
 	struct device_manager_entry *entries;				/**< Device table entries */
 	uint8_t num_devices;								/**< Number of device table entries */
+	uint8_t eid_index[DEVICE_MANAGER_EID_INDEX_SIZE];	/**< Device table entry for each EID, offset by one.  0 for unknown EIDs. */
+	uint32_t last_chain_version;						/**< The last version assigned to a certificate chain. */
 };
 
 
@@ -5,9 +5,13 @@
 #define CHECKSUM_H_
 
 #include <stdint.h>
+#include <stddef.h>
 
 
 uint8_t checksum_crc8 (uint8_t smbus_addr, const uint8_t *data, uint8_t len);
 
+uint8_t checksum_init_smbus_crc8 (uint8_t smbus_addr);
+uint8_t checksum_update_crc8 (uint8_t crc, const uint8_t *data, size_t len);
+
 
 #endif //CHECKSUM_H_
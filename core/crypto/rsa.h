@@ -155,6 +155,16 @@ struct rsa_engine {
 	 */
 	int (*sig_verify) (struct rsa_engine *engine, const struct rsa_public_key *key,
 		const uint8_t *signature, size_t sig_length, const uint8_t *match, size_t match_length);
+
+	/**
+	 * Discard any state the engine has retained for an RSA public key.  This must be called when
+	 * a public key is revoked so the engine does not keep it available for verification.
+	 *
+	 * @param engine The RSA engine to update.
+	 * @param key The public key to discard.  If this is null, state for all public keys will be
+	 * discarded.
+	 */
+	void (*invalidate_public_key) (struct rsa_engine *engine, const struct rsa_public_key *key);
 };
 
 
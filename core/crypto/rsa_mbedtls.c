@@ -388,10 +388,78 @@ exit:
 	return status;
 }
 
+/**
+ * Discard a loaded public key from the cache.
+ *
+ * @param cached The cache entry to clear.
+ */
+static void rsa_mbedtls_clear_cached_pubkey (struct rsa_mbedtls_key_cache *cached)
+{
+	if (cached->valid) {
+		mbedtls_rsa_free (&cached->context);
+		memset (&cached->key, 0, sizeof (cached->key));
+		cached->valid = false;
+	}
+}
+
+/**
+ * Get an RSA context loaded with a public key.  If the key is not already in the cache, it will be
+ * loaded, replacing the least recently used key if necessary.  The cache lock must be held by the
+ * caller.
+ *
+ * @param engine The RSA engine that contains the key cache.
+ * @param key The public key to get a context for.
+ * @param cached Output for the cache entry that contains the loaded key.
+ *
+ * @return 0 if the key context is available or an error code.
+ */
+static int rsa_mbedtls_get_cached_pubkey (struct rsa_engine_mbedtls *engine,
+	const struct rsa_public_key *key, struct rsa_mbedtls_key_cache **cached)
+{
+	struct rsa_mbedtls_key_cache *entry;
+	struct rsa_mbedtls_key_cache *replace = &engine->key_cache[0];
+	int i;
+	int status;
+
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		entry = &engine->key_cache[i];
+
+		if (entry->valid) {
+			if (rsa_same_public_key (&entry->key, key)) {
+				entry->last_used = ++engine->cache_access;
+				*cached = entry;
+				return 0;
+			}
+
+			if (replace->valid && (entry->last_used < replace->last_used)) {
+				replace = entry;
+			}
+		}
+		else if (replace->valid) {
+			replace = entry;
+		}
+	}
+
+	rsa_mbedtls_clear_cached_pubkey (replace);
+
+	status = rsa_mbedtls_load_pubkey (&replace->context, key);
+	if (status != 0) {
+		return status;
+	}
+
+	memcpy (&replace->key, key, sizeof (replace->key));
+	replace->last_used = ++engine->cache_access;
+	replace->valid = true;
+
+	*cached = replace;
+	return 0;
+}
+
 static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_public_key *key,
 	const uint8_t *signature, size_t sig_length, const uint8_t *match, size_t match_length)
 {
-	mbedtls_rsa_context rsa;
+	struct rsa_engine_mbedtls *mbedtls = (struct rsa_engine_mbedtls*) engine;
+	struct rsa_mbedtls_key_cache *cached;
 	int status;
 
 	if ((engine == NULL) || (key == NULL) || (signature == NULL) || (match == NULL) ||
@@ -399,21 +467,25 @@ static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_p
 		return RSA_ENGINE_INVALID_ARGUMENT;
 	}
 
-	status = rsa_mbedtls_load_pubkey (&rsa, key);
+	platform_mutex_lock (&mbedtls->cache_lock);
+
+	status = rsa_mbedtls_get_cached_pubkey (mbedtls, key, &cached);
 	if (status != 0) {
 		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_RSA_PUBKEY_LOAD_EC, status, 0);
-		return status;
+		goto exit;
 	}
 
-	status = mbedtls_rsa_pkcs1_verify (&rsa, NULL, NULL, MBEDTLS_RSA_PUBLIC, MBEDTLS_MD_SHA256,
-		match_length, match, signature);
+	status = mbedtls_rsa_pkcs1_verify (&cached->context, NULL, NULL, MBEDTLS_RSA_PUBLIC,
+		MBEDTLS_MD_SHA256, match_length, match, signature);
 	if (status != 0) {
 		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_RSA_PKCS1_VERIFY_EC, status, 0);
 
 		if ((status == MBEDTLS_ERR_MPI_ALLOC_FAILED) ||
 			(status == (MBEDTLS_ERR_MPI_ALLOC_FAILED + MBEDTLS_ERR_RSA_PUBLIC_FAILED))) {
+			/* Release the key context to give back as much memory as possible. */
+			rsa_mbedtls_clear_cached_pubkey (cached);
 			status = RSA_ENGINE_NO_MEMORY;
 		}
 		else {
@@ -421,10 +493,32 @@ static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_p
 		}
 	}
 
-	mbedtls_rsa_free (&rsa);
+exit:
+	platform_mutex_unlock (&mbedtls->cache_lock);
 	return status;
 }
 
+static void rsa_mbedtls_invalidate_public_key (struct rsa_engine *engine,
+	const struct rsa_public_key *key)
+{
+	struct rsa_engine_mbedtls *mbedtls = (struct rsa_engine_mbedtls*) engine;
+	int i;
+
+	if (mbedtls == NULL) {
+		return;
+	}
+
+	platform_mutex_lock (&mbedtls->cache_lock);
+
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		if ((key == NULL) || rsa_same_public_key (&mbedtls->key_cache[i].key, key)) {
+			rsa_mbedtls_clear_cached_pubkey (&mbedtls->key_cache[i]);
+		}
+	}
+
+	platform_mutex_unlock (&mbedtls->cache_lock);
+}
+
 /**
  * Initialize an mbedTLS RSA engine.
  *
@@ -442,6 +536,11 @@ int rsa_mbedtls_init (struct rsa_engine_mbedtls *engine)
 
 	memset (engine, 0, sizeof (struct rsa_engine_mbedtls));
 
+	status = platform_mutex_init (&engine->cache_lock);
+	if (status != 0) {
+		return status;
+	}
+
 	mbedtls_ctr_drbg_init (&engine->ctr_drbg);
 	mbedtls_entropy_init (&engine->entropy);
 
@@ -461,12 +560,14 @@ int rsa_mbedtls_init (struct rsa_engine_mbedtls *engine)
 	engine->base.get_public_key_der = rsa_mbedtls_get_public_key_der;
 	engine->base.decrypt = rsa_mbedtls_decrypt;
 	engine->base.sig_verify = rsa_mbedtls_sig_verify;
+	engine->base.invalidate_public_key = rsa_mbedtls_invalidate_public_key;
 
 	return 0;
 
 exit:
 	mbedtls_entropy_free (&engine->entropy);
 	mbedtls_ctr_drbg_free (&engine->ctr_drbg);
+	platform_mutex_free (&engine->cache_lock);
 	return status;
 }
 
@@ -477,8 +578,15 @@ exit:
  */
 void rsa_mbedtls_release (struct rsa_engine_mbedtls *engine)
 {
+	int i;
+
 	if (engine) {
+		for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+			rsa_mbedtls_clear_cached_pubkey (&engine->key_cache[i]);
+		}
+
 		mbedtls_entropy_free (&engine->entropy);
 		mbedtls_ctr_drbg_free (&engine->ctr_drbg);
+		platform_mutex_free (&engine->cache_lock);
 	}
 }
@@ -4,18 +4,46 @@
 #ifndef RSA_MBEDTLS_H_
 #define RSA_MBEDTLS_H_
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "rsa.h"
+#include "platform.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/entropy.h"
+#include "mbedtls/rsa.h"
 
 
+/* Configurable RSA engine parameters.  Defaults can be overridden in platform_config.h. */
+#ifndef RSA_MBEDTLS_KEY_CACHE_SIZE
+#define	RSA_MBEDTLS_KEY_CACHE_SIZE		4
+#endif
+
+
+/**
+ * A public key that has been loaded into an mbedTLS RSA context for signature verification.
+ */
+struct rsa_mbedtls_key_cache {
+	struct rsa_public_key key;			/**< The public key loaded in the context. */
+	mbedtls_rsa_context context;		/**< The prepared RSA context for the key. */
+	uint32_t last_used;					/**< Access count when the key was last used. */
+	bool valid;							/**< Flag indicating the context contains a key. */
+};
+
 /**
  * An mbedTLS context for RSA encryption.
+ *
+ * Public keys used for signature verification are kept loaded in a small cache, so repeated
+ * verifications with the same key don't need to import the key and recompute the modular
+ * arithmetic constants for every signature.  When the cache is full, the least recently used key
+ * is replaced.
  */
 struct rsa_engine_mbedtls {
 	struct rsa_engine base;				/**< The base RSA engine. */
 	mbedtls_ctr_drbg_context ctr_drbg;	/**< A random number generator for the engine. */
 	mbedtls_entropy_context entropy;	/**< Entropy source for the random number generator. */
+	struct rsa_mbedtls_key_cache key_cache[RSA_MBEDTLS_KEY_CACHE_SIZE];	/**< Loaded public keys. */
+	uint32_t cache_access;				/**< Counter for tracking key usage. */
+	platform_mutex cache_lock;			/**< Synchronization for the public key cache. */
 };
 
 
@@ -254,6 +254,140 @@ hash_fail:
 	return status;
 }
 
+/**
+ * Load the application image from flash into memory and verify its integrity in a single pass.
+ * Each chunk of the image is hashed as soon as it has been loaded, instead of hashing the image in
+ * memory after it has been completely loaded.  The results are identical to
+ * app_image_load_and_verify.
+ *
+ * @param flash The flash device that contains the application image.
+ * @param start_addr The start address of the image header.
+ * @param load_addr The memory location where the image should be loaded.
+ * @param max_length The largest application image that can be loaded.
+ * @param hash The hash engine to use for verification.
+ * @param rsa The RSA engine to use for signature validation.
+ * @param pub_key The key to use to validate the signature.
+ * @param hash_out Optional output parameter that will contain the SHA256 hash of the application
+ * image.  This can be null if the image hash does not need to be returned.
+ * @param hash_length The length of the hash output buffer.
+ * @param load_length Optional output parameter that will contain the amount of data loaded to the
+ * destination address.
+ *
+ * @return 0 if the application image was loaded to memory and verified as good or an error code.
+ */
+int app_image_load_and_verify_streaming (struct flash *flash, uint32_t start_addr,
+	uint8_t *load_addr, size_t max_length, struct hash_engine *hash, struct rsa_engine *rsa,
+	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length,
+	size_t *load_length)
+{
+	return app_image_load_and_verify_with_header_streaming (flash, start_addr, 0, load_addr,
+		max_length, hash, rsa, pub_key, hash_out, hash_length, load_length);
+}
+
+/**
+ * Load the application image from flash into memory and verify its integrity in a single pass.
+ * The image signature includes header data that is prepended to the image on flash.  The results
+ * are identical to app_image_load_and_verify_with_header.
+ *
+ * The image signature is read before any image data so that hashing of the image is the last flash
+ * access.  The prepended header is hashed directly from flash without a temporary allocation.
+ *
+ * @param flash The flash device that contains the application image.
+ * @param start_addr The start address of the additional image header.
+ * @param header_length The length of the prepended image header.
+ * @param load_addr The memory location where the image should be loaded.
+ * @param max_length The largest application image that can be loaded.
+ * @param hash The hash engine to use for verification.
+ * @param rsa The RSA engine to use for signature validation.
+ * @param pub_key The key to use to validate the signature.
+ * @param hash_out Optional output parameter that will contain the SHA256 hash of the application
+ * image.  This can be null if the image hash does not need to be returned.
+ * @param hash_length The length of the hash output buffer.
+ * @param load_length Optional output parameter that will contain the amount of data loaded to the
+ * destination address.
+ *
+ * @return 0 if the application image was loaded to memory and verified as good or an error code.
+ */
+int app_image_load_and_verify_with_header_streaming (struct flash *flash, uint32_t start_addr,
+	size_t header_length, uint8_t *load_addr, size_t max_length, struct hash_engine *hash,
+	struct rsa_engine *rsa, const struct rsa_public_key *pub_key, uint8_t *hash_out,
+	size_t hash_length, size_t *load_length)
+{
+	uint32_t app_length;
+	uint8_t app_hash[SHA256_HASH_LENGTH];
+	uint8_t app_sig[APP_IMAGE_SIG_LENGTH];
+	int status;
+
+	if ((flash == NULL) || (load_addr == NULL) || (hash == NULL) || (rsa == NULL) ||
+		(pub_key == NULL)) {
+		return APP_IMAGE_INVALID_ARGUMENT;
+	}
+
+	if (hash_out == NULL) {
+		hash_out = app_hash;
+		hash_length = sizeof (app_hash);
+	}
+	else if (hash_length < SHA256_HASH_LENGTH) {
+		return APP_IMAGE_HASH_BUFFER_TOO_SMALL;
+	}
+
+	status = flash->read (flash, start_addr + header_length, (uint8_t*) &app_length, 4);
+	if (status != 0) {
+		return status;
+	}
+
+	if (app_length > max_length) {
+		return APP_IMAGE_TOO_LARGE;
+	}
+
+	status = flash->read (flash, start_addr + header_length + 4 + app_length, app_sig,
+		APP_IMAGE_SIG_LENGTH);
+	if (status != 0) {
+		return status;
+	}
+
+	status = hash->start_sha256 (hash);
+	if (status != 0) {
+		return status;
+	}
+
+	if (header_length != 0) {
+		status = flash_hash_update_contents (flash, start_addr, header_length, hash);
+		if (status != 0) {
+			goto hash_fail;
+		}
+	}
+
+	status = hash->update (hash, (uint8_t*) &app_length, 4);
+	if (status != 0) {
+		goto hash_fail;
+	}
+
+	status = flash_load_and_hash_update (flash, start_addr + header_length + 4, load_addr,
+		app_length, hash);
+	if (status != 0) {
+		goto hash_fail;
+	}
+
+	status = hash->finish (hash, hash_out, hash_length);
+	if (status != 0) {
+		goto hash_fail;
+	}
+
+	status = rsa->sig_verify (rsa, pub_key, app_sig, APP_IMAGE_SIG_LENGTH, hash_out,
+		SHA256_HASH_LENGTH);
+
+	if (load_length != NULL) {
+		*load_length = app_length;
+	}
+
+	return status;
+
+hash_fail:
+	hash->cancel (hash);
+	return status;
+}
+
 /**
  * Get the signature of an application image stored in flash.
  *
@@ -35,6 +35,14 @@ int app_image_load_and_verify_with_header (struct flash *flash, uint32_t start_a
 	size_t header_length, uint8_t *load_addr, size_t max_length, struct hash_engine *hash,
 	struct rsa_engine *rsa, const struct rsa_public_key *pub_key, uint8_t *hash_out,
 	size_t hash_length, size_t *load_length);
+int app_image_load_and_verify_streaming (struct flash *flash, uint32_t start_addr,
+	uint8_t *load_addr, size_t max_length, struct hash_engine *hash, struct rsa_engine *rsa,
+	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length,
+	size_t *load_length);
+int app_image_load_and_verify_with_header_streaming (struct flash *flash, uint32_t start_addr,
+	size_t header_length, uint8_t *load_addr, size_t max_length, struct hash_engine *hash,
+	struct rsa_engine *rsa, const struct rsa_public_key *pub_key, uint8_t *hash_out,
+	size_t hash_length, size_t *load_length);
 
 int app_image_get_signature (struct flash *flash, uint32_t start_addr, uint8_t *sig_out,
 	size_t sig_length);
@@ -367,6 +367,116 @@ hash_fail:
 	return status;
 }
 
+/**
+ * Load the component from flash into memory and verify its integrity in a single pass.  Each chunk
+ * of the component is hashed as soon as it has been loaded, instead of hashing the component in
+ * memory after it has been completely loaded.  The results are identical to
+ * firmware_component_load_and_verify.
+ *
+ * The image signature is read before any component data so that hashing of the component is the
+ * last flash access.  Any additional header data is hashed directly from flash without a temporary
+ * allocation.
+ *
+ * @param image The image to load.
+ * @param load_addr The memory location where the image should be loaded.
+ * @param max_length The largest firmware component that can be loaded.
+ * @param hash The hash engine to use for image validation.
+ * @param verification Context to use for signature verification.
+ * @param hash_out Optional output parameter that will contain the SHA-256 hash of the application
+ * image.  This can be null if the image hash does not need to be returned.
+ * @param hash_length The length of the hash output buffer.
+ * @param load_length Optional output parameter that will contain the amount of data loaded to the
+ * destination address.
+ *
+ * @return 0 if the component was loaded to memory and verified as good or an error code.
+ */
+int firmware_component_load_and_verify_streaming (struct firmware_component *image,
+	uint8_t *load_addr, size_t max_length, struct hash_engine *hash,
+	struct signature_verification *verification, uint8_t *hash_out, size_t hash_length,
+	size_t *load_length)
+{
+	size_t img_length;
+	uint8_t img_hash[SHA256_HASH_LENGTH];
+	uint8_t *signature;
+	size_t sig_length;
+	int status;
+
+	if ((image == NULL) || (load_addr == NULL) || (hash == NULL) || (verification == NULL)) {
+		return FIRMWARE_COMPONENT_INVALID_ARGUMENT;
+	}
+
+	if (hash_out == NULL) {
+		hash_out = img_hash;
+		hash_length = sizeof (img_hash);
+	}
+	else if (hash_length < SHA256_HASH_LENGTH) {
+		return FIRMWARE_COMPONENT_HASH_BUFFER_TOO_SMALL;
+	}
+
+	img_length = FW_COMPONENT_HDR (image, 0).length;
+	if (img_length > max_length) {
+		return FIRMWARE_COMPONENT_TOO_LARGE;
+	}
+
+	status = firmware_component_read_signature_data (image, &signature, &sig_length);
+	if (status != 0) {
+		return status;
+	}
+
+	status = hash->start_sha256 (hash);
+	if (status != 0) {
+		goto exit;
+	}
+
+	if (image->offset) {
+		status = flash_hash_update_contents (image->flash, image->start_addr, image->offset, hash);
+		if (status != 0) {
+			goto hash_fail;
+		}
+	}
+
+	status = hash->update (hash, (uint8_t*) &image->header.info, sizeof (struct image_header_info));
+	if (status != 0) {
+		goto hash_fail;
+	}
+
+	status = hash->update (hash, image->header.data,
+		image->header.info.length - sizeof (struct image_header_info));
+	if (status != 0) {
+		goto hash_fail;
+	}
+
+	status = flash_load_and_hash_update (image->flash,
+		firmware_component_get_data_addr (image), load_addr, img_length, hash);
+	if (status != 0) {
+		goto hash_fail;
+	}
+
+	status = hash->finish (hash, hash_out, hash_length);
+	if (status != 0) {
+		goto hash_fail;
+	}
+
+	status = verification->verify_signature (verification, hash_out, SHA256_HASH_LENGTH, signature,
+		sig_length);
+	if (status != 0) {
+		goto exit;
+	}
+
+	if (load_length != NULL) {
+		*load_length = img_length;
+	}
+
+exit:
+	platform_free (signature);
+	return status;
+
+hash_fail:
+	hash->cancel (hash);
+	platform_free (signature);
+	return status;
+}
+
 /**
  * Copy a firmware component to flash.  Nothing will be done if the component data is already on the
  * flash, but the copy can be optionally forced.
@@ -38,6 +38,10 @@ int firmware_component_load (struct firmware_component *image, uint8_t *load_add
 int firmware_component_load_and_verify (struct firmware_component *image, uint8_t *load_addr,
 	size_t max_length, struct hash_engine *hash, struct signature_verification *verification,
 	uint8_t *hash_out, size_t hash_length, size_t *load_length);
+int firmware_component_load_and_verify_streaming (struct firmware_component *image,
+	uint8_t *load_addr, size_t max_length, struct hash_engine *hash,
+	struct signature_verification *verification, uint8_t *hash_out, size_t hash_length,
+	size_t *load_length);
 
 int firmware_component_copy (struct firmware_component *image, struct flash *flash,
 	uint32_t dest_addr, size_t max_length, size_t *copy_length);
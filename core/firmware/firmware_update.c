@@ -691,6 +691,9 @@ int firmware_update_run_update (struct firmware_update *updater,
 				firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_FAILED);
 				return status;
 			}
+
+			/* The keys from the revoked manifest are not known, so discard all public keys. */
+			updater->rsa->invalidate_public_key (updater->rsa, NULL);
 		}
 	}
 
@@ -151,6 +151,8 @@ enum {
 	FLASH_NOT_BLANK = FLASH_ERROR (0x0c),				/**< The flash is expected to be blank but is not. */
 	FLASH_HW_NOT_INIT = FLASH_ERROR (0x0d),				/**< The flash hardware interface was not initialized. */
 	FLASH_MINIMUM_WRITE_FAILED = FLASH_ERROR (0x0e),	/**< Failed to determine the minimum write size. */
+	FLASH_READ_IN_PROGRESS = FLASH_ERROR (0x0f),		/**< A background read request is already outstanding. */
+	FLASH_NO_READ_PENDING = FLASH_ERROR (0x10),			/**< There is no background read request to wait on. */
 };
 
 
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_ASYNC_READ_H_
+#define FLASH_ASYNC_READ_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "status/rot_status.h"
+
+
+/**
+ * Interface for flash devices that are able to execute read requests in the background, such as
+ * drivers that transfer flash data using DMA.  This allows data processing to overlap with the
+ * flash transfer of the next block of data.
+ *
+ * Only a single read request can be outstanding at any time.
+ */
+struct flash_async_read {
+	/**
+	 * Start reading data from flash.  The call will return once the request has been submitted and
+	 * the read will complete in the background.  The data buffer must not be accessed until the
+	 * request has been completed.
+	 *
+	 * @param async The flash to read from.
+	 * @param address The address to start reading from.
+	 * @param data The buffer that will hold the data that is read.
+	 * @param length The number of bytes to read.
+	 *
+	 * @return 0 if the read request was started successfully or an error code.
+	 */
+	int (*start_read) (struct flash_async_read *async, uint32_t address, uint8_t *data,
+		size_t length);
+
+	/**
+	 * Wait for the outstanding read request to complete.
+	 *
+	 * @param async The flash to wait on.
+	 *
+	 * @return 0 if the read request completed successfully or an error code.
+	 */
+	int (*wait_for_read) (struct flash_async_read *async);
+};
+
+
+#endif /* FLASH_ASYNC_READ_H_ */
@@ -21,6 +21,7 @@ enum {
 	FLASH_CMD_WREN = 0x06,				/**< Write enable */
 	FLASH_CMD_FAST_READ = 0x0b,			/**< Fast read */
 	FLASH_CMD_4BYTE_FAST_READ = 0x0c,	/**< Fast read with 4 byte address */
+	FLASH_CMD_WRSR3 = 0x11,				/**< Write status register 3 (configuration register) */
 	FLASH_CMD_4BYTE_PP = 0x12,			/**< Page program with 4 byte address */
 	FLASH_CMD_4BYTE_READ = 0x13,		/**< Normal read with 4 byte address */
 	FLASH_CMD_RDSR3 = 0x15,				/**< Read status register 3 (configuration register) */
@@ -0,0 +1,319 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "flash_compare.h"
+
+#if FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_SSE2
+#include <emmintrin.h>
+#elif FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+
+#if FLASH_COMPARE_KERNEL != FLASH_COMPARE_KERNEL_BYTE
+/**
+ * Load a native word from a buffer with no alignment requirements.
+ *
+ * @param data The buffer to load from.
+ *
+ * @return The word value.
+ */
+static inline uintptr_t flash_compare_load_word (const uint8_t *data)
+{
+	uintptr_t word;
+
+	memcpy (&word, data, sizeof (word));
+	return word;
+}
+
+/**
+ * Check that every byte of a buffer matches a constant value, comparing a native word at a time.
+ *
+ * @param data The buffer to check.
+ * @param length The length of the buffer.
+ * @param value The expected value.
+ *
+ * @return true if all bytes match or false if not.
+ */
+static bool flash_compare_const_byte_word (const uint8_t *data, size_t length, uint8_t value)
+{
+	uintptr_t pattern = ((uintptr_t) -1 / 0xff) * value;
+	size_t i;
+
+	while (length >= (sizeof (uintptr_t) * 4)) {
+		if ((flash_compare_load_word (data) ^ pattern) |
+			(flash_compare_load_word (data + sizeof (uintptr_t)) ^ pattern) |
+			(flash_compare_load_word (data + (sizeof (uintptr_t) * 2)) ^ pattern) |
+			(flash_compare_load_word (data + (sizeof (uintptr_t) * 3)) ^ pattern)) {
+			return false;
+		}
+
+		data += sizeof (uintptr_t) * 4;
+		length -= sizeof (uintptr_t) * 4;
+	}
+
+	while (length >= sizeof (uintptr_t)) {
+		if (flash_compare_load_word (data) != pattern) {
+			return false;
+		}
+
+		data += sizeof (uintptr_t);
+		length -= sizeof (uintptr_t);
+	}
+
+	for (i = 0; i < length; i++) {
+		if (data[i] != value) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check that two buffers contain the same data, comparing a native word at a time.
+ *
+ * @param data1 The first buffer to compare.
+ * @param data2 The second buffer to compare.
+ * @param length The length of the buffers.
+ *
+ * @return true if the buffers match or false if not.
+ */
+static bool flash_compare_data_word (const uint8_t *data1, const uint8_t *data2, size_t length)
+{
+	size_t i;
+
+	while (length >= (sizeof (uintptr_t) * 4)) {
+		if ((flash_compare_load_word (data1) ^ flash_compare_load_word (data2)) |
+			(flash_compare_load_word (data1 + sizeof (uintptr_t)) ^
+				flash_compare_load_word (data2 + sizeof (uintptr_t))) |
+			(flash_compare_load_word (data1 + (sizeof (uintptr_t) * 2)) ^
+				flash_compare_load_word (data2 + (sizeof (uintptr_t) * 2))) |
+			(flash_compare_load_word (data1 + (sizeof (uintptr_t) * 3)) ^
+				flash_compare_load_word (data2 + (sizeof (uintptr_t) * 3)))) {
+			return false;
+		}
+
+		data1 += sizeof (uintptr_t) * 4;
+		data2 += sizeof (uintptr_t) * 4;
+		length -= sizeof (uintptr_t) * 4;
+	}
+
+	while (length >= sizeof (uintptr_t)) {
+		if (flash_compare_load_word (data1) != flash_compare_load_word (data2)) {
+			return false;
+		}
+
+		data1 += sizeof (uintptr_t);
+		data2 += sizeof (uintptr_t);
+		length -= sizeof (uintptr_t);
+	}
+
+	for (i = 0; i < length; i++) {
+		if (data1[i] != data2[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+#endif
+
+#if FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_SSE2
+/**
+ * Check that every byte of a buffer matches a constant value using SSE2 vectors.
+ *
+ * @param data The buffer to check.
+ * @param length The length of the buffer.
+ * @param value The expected value.
+ *
+ * @return true if all bytes match or false if not.
+ */
+static bool flash_compare_const_byte_vector (const uint8_t *data, size_t length, uint8_t value)
+{
+	const __m128i pattern = _mm_set1_epi8 ((char) value);
+	__m128i match;
+
+	while (length >= 64) {
+		match = _mm_and_si128 (
+			_mm_and_si128 (
+				_mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i*) data), pattern),
+				_mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 16)), pattern)),
+			_mm_and_si128 (
+				_mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 32)), pattern),
+				_mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 48)), pattern)));
+		if (_mm_movemask_epi8 (match) != 0xffff) {
+			return false;
+		}
+
+		data += 64;
+		length -= 64;
+	}
+
+	while (length >= 16) {
+		match = _mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i*) data), pattern);
+		if (_mm_movemask_epi8 (match) != 0xffff) {
+			return false;
+		}
+
+		data += 16;
+		length -= 16;
+	}
+
+	return flash_compare_const_byte_word (data, length, value);
+}
+
+/**
+ * Check that two buffers contain the same data using SSE2 vectors.
+ *
+ * @param data1 The first buffer to compare.
+ * @param data2 The second buffer to compare.
+ * @param length The length of the buffers.
+ *
+ * @return true if the buffers match or false if not.
+ */
+static bool flash_compare_data_vector (const uint8_t *data1, const uint8_t *data2, size_t length)
+{
+	__m128i match;
+
+	while (length >= 16) {
+		match = _mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i*) data1),
+			_mm_loadu_si128 ((const __m128i*) data2));
+		if (_mm_movemask_epi8 (match) != 0xffff) {
+			return false;
+		}
+
+		data1 += 16;
+		data2 += 16;
+		length -= 16;
+	}
+
+	return flash_compare_data_word (data1, data2, length);
+}
+#elif FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_NEON
+/**
+ * Check that every byte of a buffer matches a constant value using NEON vectors.
+ *
+ * @param data The buffer to check.
+ * @param length The length of the buffer.
+ * @param value The expected value.
+ *
+ * @return true if all bytes match or false if not.
+ */
+static bool flash_compare_const_byte_vector (const uint8_t *data, size_t length, uint8_t value)
+{
+	const uint8x16_t pattern = vdupq_n_u8 (value);
+	uint8x16_t match;
+
+	while (length >= 64) {
+		match = vandq_u8 (
+			vandq_u8 (vceqq_u8 (vld1q_u8 (data), pattern),
+				vceqq_u8 (vld1q_u8 (data + 16), pattern)),
+			vandq_u8 (vceqq_u8 (vld1q_u8 (data + 32), pattern),
+				vceqq_u8 (vld1q_u8 (data + 48), pattern)));
+		if (vminvq_u8 (match) != 0xff) {
+			return false;
+		}
+
+		data += 64;
+		length -= 64;
+	}
+
+	while (length >= 16) {
+		if (vminvq_u8 (vceqq_u8 (vld1q_u8 (data), pattern)) != 0xff) {
+			return false;
+		}
+
+		data += 16;
+		length -= 16;
+	}
+
+	return flash_compare_const_byte_word (data, length, value);
+}
+
+/**
+ * Check that two buffers contain the same data using NEON vectors.
+ *
+ * @param data1 The first buffer to compare.
+ * @param data2 The second buffer to compare.
+ * @param length The length of the buffers.
+ *
+ * @return true if the buffers match or false if not.
+ */
+static bool flash_compare_data_vector (const uint8_t *data1, const uint8_t *data2, size_t length)
+{
+	while (length >= 16) {
+		if (vminvq_u8 (vceqq_u8 (vld1q_u8 (data1), vld1q_u8 (data2))) != 0xff) {
+			return false;
+		}
+
+		data1 += 16;
+		data2 += 16;
+		length -= 16;
+	}
+
+	return flash_compare_data_word (data1, data2, length);
+}
+#endif
+
+/**
+ * Check that every byte of a buffer matches a constant value, such as when checking for blank
+ * flash.
+ *
+ * @param data The buffer to check.
+ * @param length The length of the buffer.
+ * @param value The expected value for every byte.
+ *
+ * @return true if all bytes match the value or false if not.
+ */
+bool flash_compare_const_byte (const uint8_t *data, size_t length, uint8_t value)
+{
+#if (FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_SSE2) || \
+	(FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_NEON)
+	return flash_compare_const_byte_vector (data, length, value);
+#elif FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_WORD
+	return flash_compare_const_byte_word (data, length, value);
+#else
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		if (data[i] != value) {
+			return false;
+		}
+	}
+
+	return true;
+#endif
+}
+
+/**
+ * Check that two buffers contain the same data.
+ *
+ * @param data1 The first buffer to compare.
+ * @param data2 The second buffer to compare.
+ * @param length The length of the buffers.
+ *
+ * @return true if the buffers contain the same data or false if not.
+ */
+bool flash_compare_data (const uint8_t *data1, const uint8_t *data2, size_t length)
+{
+#if (FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_SSE2) || \
+	(FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_NEON)
+	return flash_compare_data_vector (data1, data2, length);
+#elif FLASH_COMPARE_KERNEL == FLASH_COMPARE_KERNEL_WORD
+	return flash_compare_data_word (data1, data2, length);
+#else
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		if (data1[i] != data2[i]) {
+			return false;
+		}
+	}
+
+	return true;
+#endif
+}
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_COMPARE_H_
+#define FLASH_COMPARE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_config.h"
+
+
+/**
+ * Implementations available for comparing data read from flash.
+ */
+#define	FLASH_COMPARE_KERNEL_BYTE		0	/**< Compare one byte at a time. */
+#define	FLASH_COMPARE_KERNEL_WORD		1	/**< Compare using native word loads. */
+#define	FLASH_COMPARE_KERNEL_SSE2		2	/**< Compare using 128-bit SSE2 vectors. */
+#define	FLASH_COMPARE_KERNEL_NEON		3	/**< Compare using 128-bit AArch64 NEON vectors. */
+
+/* Configurable comparison kernel.  Defaults can be overridden in platform_config.h. */
+#ifndef FLASH_COMPARE_KERNEL
+#define	FLASH_COMPARE_KERNEL			FLASH_COMPARE_KERNEL_WORD
+#endif
+
+
+bool flash_compare_const_byte (const uint8_t *data, size_t length, uint8_t value);
+bool flash_compare_data (const uint8_t *data1, const uint8_t *data2, size_t length);
+
+
+#endif /* FLASH_COMPARE_H_ */
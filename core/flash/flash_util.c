@@ -2,10 +2,380 @@
 // Licensed under the MIT license.
 
 #include <stdbool.h>
+#include <string.h>
 #include "flash_util.h"
 #include "flash_common.h"
+#include "flash_compare.h"
 
 
+/**
+ * Initialize a pipeline for hashing flash contents in large chunks.
+ *
+ * @param pipeline The hash pipeline to initialize.
+ * @param flash The flash device that will be hashed using the pipeline.
+ * @param async Optional interface to read data from the flash device in the background.  If this is
+ * provided, two buffers will be allocated so that reading the next chunk of data can overlap with
+ * hashing the current one.  If this is null, a single buffer will be used for all flash reads.
+ * @param chunk_size The maximum amount of data to read from flash in a single request.
+ *
+ * @return 0 if the pipeline was successfully initialized or an error code.
+ */
+int flash_hash_pipeline_init (struct flash_hash_pipeline *pipeline, struct flash *flash,
+	struct flash_async_read *async, size_t chunk_size)
+{
+	int status;
+
+	if ((pipeline == NULL) || (flash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if ((chunk_size < FLASH_HASH_PIPELINE_MIN_CHUNK) ||
+		(chunk_size > FLASH_HASH_PIPELINE_MAX_CHUNK)) {
+		return FLASH_UTIL_UNSUPPORTED_CHUNK_SIZE;
+	}
+
+	memset (pipeline, 0, sizeof (struct flash_hash_pipeline));
+
+	pipeline->buffer[0] = platform_malloc ((async != NULL) ? (chunk_size * 2) : chunk_size);
+	if (pipeline->buffer[0] == NULL) {
+		return FLASH_UTIL_NO_MEMORY;
+	}
+
+	pipeline->buffer[1] = (async != NULL) ? &pipeline->buffer[0][chunk_size] : pipeline->buffer[0];
+
+	status = platform_mutex_init (&pipeline->lock);
+	if (status != 0) {
+		platform_free (pipeline->buffer[0]);
+		return status;
+	}
+
+	pipeline->flash = flash;
+	pipeline->async = async;
+	pipeline->chunk_size = chunk_size;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a flash hash pipeline.
+ *
+ * @param pipeline The hash pipeline to release.
+ */
+void flash_hash_pipeline_release (struct flash_hash_pipeline *pipeline)
+{
+	if (pipeline) {
+		platform_mutex_free (&pipeline->lock);
+		platform_free (pipeline->buffer[0]);
+	}
+}
+
+/**
+ * Determine the next chunk of flash data that should be hashed for a group of regions.  Chunks will
+ * never span multiple regions.
+ *
+ * @param pipeline The hash pipeline being used.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions being hashed.
+ * @param count The number of regions defined in the group.
+ * @param index The current region being processed.  This will be updated as regions are completed.
+ * @param processed The number of bytes that have been processed in the current region.  This will
+ * be updated to include the next chunk.
+ * @param addr Output for the flash address of the next chunk.
+ * @param length Output for the length of the next chunk.
+ *
+ * @return true if there is more data to hash or false if all regions have been processed.
+ */
+static bool flash_hash_pipeline_next_chunk (struct flash_hash_pipeline *pipeline, uint32_t offset,
+	const struct flash_region *regions, size_t count, size_t *index, size_t *processed,
+	uint32_t *addr, size_t *length)
+{
+	while (*index < count) {
+		if (*processed < regions[*index].length) {
+			*addr = regions[*index].start_addr + offset + *processed;
+			*length = regions[*index].length - *processed;
+			if (*length > pipeline->chunk_size) {
+				*length = pipeline->chunk_size;
+			}
+
+			*processed += *length;
+			return true;
+		}
+
+		*index += 1;
+		*processed = 0;
+	}
+
+	return false;
+}
+
+/**
+ * Pass the contents of a group of flash regions to a data handler using a hash pipeline.  The
+ * pipeline must be locked by the caller.
+ *
+ * @param pipeline The hash pipeline to use for reading the flash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions to read.
+ * @param count The number of regions defined in the group.
+ * @param handler The handler to call for each chunk of data read from flash.
+ * @param context Context to pass to the data handler.
+ *
+ * @return 0 if all data was processed successfully or an error code.
+ */
+static int flash_hash_pipeline_process (struct flash_hash_pipeline *pipeline, uint32_t offset,
+	const struct flash_region *regions, size_t count, flash_hash_pipeline_data_handler handler,
+	void *context)
+{
+	size_t index = 0;
+	size_t processed = 0;
+	uint32_t addr;
+	size_t length;
+	size_t next_length = 0;
+	int current = 0;
+	bool more;
+	int status;
+
+	more = flash_hash_pipeline_next_chunk (pipeline, offset, regions, count, &index, &processed,
+		&addr, &length);
+
+	if (pipeline->async == NULL) {
+		while (more) {
+			status = pipeline->flash->read (pipeline->flash, addr, pipeline->buffer[0], length);
+			if (status != 0) {
+				return status;
+			}
+
+			status = handler (context, pipeline->buffer[0], length);
+			if (status != 0) {
+				return status;
+			}
+
+			more = flash_hash_pipeline_next_chunk (pipeline, offset, regions, count, &index,
+				&processed, &addr, &length);
+		}
+
+		return 0;
+	}
+
+	if (more) {
+		status = pipeline->async->start_read (pipeline->async, addr, pipeline->buffer[current],
+			length);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	while (more) {
+		status = pipeline->async->wait_for_read (pipeline->async);
+		if (status != 0) {
+			return status;
+		}
+
+		more = flash_hash_pipeline_next_chunk (pipeline, offset, regions, count, &index,
+			&processed, &addr, &next_length);
+		if (more) {
+			status = pipeline->async->start_read (pipeline->async, addr,
+				pipeline->buffer[current ^ 1], next_length);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		status = handler (context, pipeline->buffer[current], length);
+		if (status != 0) {
+			if (more) {
+				pipeline->async->wait_for_read (pipeline->async);
+			}
+
+			return status;
+		}
+
+		length = next_length;
+		current ^= 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Data handler to add flash data read by a hash pipeline to an active hash.
+ *
+ * @param context The hash engine to update.
+ * @param data The data to add to the hash.
+ * @param length The amount of data to add.
+ *
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+static int flash_hash_pipeline_hash_data (void *context, const uint8_t *data, size_t length)
+{
+	struct hash_engine *hash = (struct hash_engine*) context;
+
+	return hash->update (hash, data, length);
+}
+
+/**
+ * Update a hash with the contents of a group of flash regions using a hash pipeline.  The pipeline
+ * must be locked by the caller.
+ *
+ * @param pipeline The hash pipeline to use for reading the flash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions to add to the hash.
+ * @param count The number of regions defined in the group.
+ * @param hash The hash engine to update.  A hash must already have been started.
+ *
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+static int flash_hash_pipeline_update (struct flash_hash_pipeline *pipeline, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash)
+{
+	return flash_hash_pipeline_process (pipeline, offset, regions, count,
+		flash_hash_pipeline_hash_data, hash);
+}
+
+/**
+ * Initialize a stream for copying data to a flash device in large chunks.
+ *
+ * @param stream The copy stream to initialize.
+ * @param flash The flash device that data will be copied to using the stream.
+ * @param chunk_size The maximum amount of data to copy in a single chunk.  Two buffers of this size
+ * will be allocated, one for source data and one for verification of the destination.
+ *
+ * @return 0 if the stream was successfully initialized or an error code.
+ */
+int flash_copy_stream_init (struct flash_copy_stream *stream, struct flash *flash,
+	size_t chunk_size)
+{
+	int status;
+
+	if ((stream == NULL) || (flash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if ((chunk_size < FLASH_COPY_STREAM_MIN_CHUNK) || (chunk_size > FLASH_COPY_STREAM_MAX_CHUNK)) {
+		return FLASH_UTIL_UNSUPPORTED_CHUNK_SIZE;
+	}
+
+	memset (stream, 0, sizeof (struct flash_copy_stream));
+
+	stream->data = platform_malloc (chunk_size * 2);
+	if (stream->data == NULL) {
+		return FLASH_UTIL_NO_MEMORY;
+	}
+
+	stream->verify = &stream->data[chunk_size];
+
+	status = platform_mutex_init (&stream->lock);
+	if (status != 0) {
+		platform_free (stream->data);
+		return status;
+	}
+
+	stream->flash = flash;
+	stream->chunk_size = chunk_size;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a flash copy stream.
+ *
+ * @param stream The copy stream to release.
+ */
+void flash_copy_stream_release (struct flash_copy_stream *stream)
+{
+	if (stream) {
+		platform_mutex_free (&stream->lock);
+		platform_free (stream->data);
+	}
+}
+
+/**
+ * Generate a hash for a group of noncontiguous blocks of data stored in a flash device.
+ *
+ * All regions will be hashed starting at a fixed offset in flash.
+ *
+ * If a hash pipeline is provided, it will be used to read the flash contents.  Otherwise, data will
+ * be read in small blocks.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ * @param type The type of hash to generate.
+ * @param hash_out The buffer to hold the generated hash value.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the hash was generated successfully or an error code.
+ */
+static int flash_hash_noncontiguous_contents_ext (struct flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, uint8_t *hash_out,
+	size_t hash_length)
+{
+	uint8_t data[FLASH_VERIFICATION_BLOCK];
+	size_t next_read;
+	uint32_t current_addr;
+	size_t remaining;
+	size_t i;
+	int status;
+
+	if ((flash == NULL) || (regions == NULL) || (hash == NULL) || (hash_out == NULL) ||
+		(count == 0) || (hash_length == 0)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	status = hash_start_new_hash (hash, type);
+	if (status != 0) {
+		return status;
+	}
+
+	if (pipeline != NULL) {
+		platform_mutex_lock (&pipeline->lock);
+		status = flash_hash_pipeline_update (pipeline, offset, regions, count, hash);
+		platform_mutex_unlock (&pipeline->lock);
+
+		if (status != 0) {
+			goto fail;
+		}
+	}
+	else {
+		for (i = 0; i < count; i++) {
+			current_addr = regions[i].start_addr + offset;
+			remaining = regions[i].length;
+
+			while (remaining > 0) {
+				next_read = (remaining < FLASH_VERIFICATION_BLOCK) ?
+					remaining : FLASH_VERIFICATION_BLOCK;
+
+				status = flash->read (flash, current_addr, data, next_read);
+				if (status != 0) {
+					return status;
+				}
+
+				status = hash->update (hash, data, next_read);
+				if (status != 0) {
+					goto fail;
+				}
+
+				remaining -= next_read;
+				current_addr += next_read;
+			}
+		}
+	}
+
+	status = hash->finish (hash, hash_out, hash_length);
+	if (status != 0) {
+		goto fail;
+	}
+
+	return 0;
+
+fail:
+	hash->cancel (hash);
+	return status;
+}
+
 /**
  * Validate the contents of a contiguous block of data stored in a flash device against an RSA
  * encrypted signature.
@@ -76,7 +446,11 @@ int flash_verify_noncontiguous_contents (struct flash *flash, const struct flash
  *
  * All regions will be verified starting at a fixed offset in flash.
  *
+ * If a hash pipeline is provided, it will be used to read the flash contents.  Otherwise, data will
+ * be read in small blocks.
+ *
  * @param flash The flash device that contains the data to verify.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
  * @param offset An offset to apply to each region address.
  * @param regions The group of flash regions that should be verified as a single region.
  * @param count The number of regions defined in the group.
@@ -92,10 +466,11 @@ int flash_verify_noncontiguous_contents (struct flash *flash, const struct flash
  *
  * @return 0 if the flash contents are valid or an error code.
  */
-int flash_verify_noncontiguous_contents_at_offset (struct flash *flash, uint32_t offset,
-	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
-	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
-	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length)
+static int flash_verify_noncontiguous_contents_ext (struct flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, struct rsa_engine *rsa,
+	const uint8_t *signature, size_t sig_length, const struct rsa_public_key *pub_key,
+	uint8_t *hash_out, size_t hash_length)
 {
 	uint8_t data_hash[SHA256_HASH_LENGTH];
 	int status;
@@ -124,8 +499,8 @@ int flash_verify_noncontiguous_contents_at_offset (struct flash *flash, uint32_t
 			return FLASH_UTIL_UNKNOWN_SIG_HASH;
 	}
 
-	status = flash_hash_noncontiguous_contents_at_offset (flash, offset, regions, count, hash, type,
-		hash_out, SHA256_HASH_LENGTH);
+	status = flash_hash_noncontiguous_contents_ext (flash, pipeline, offset, regions, count, hash,
+		type, hash_out, SHA256_HASH_LENGTH);
 	if (status != 0) {
 		return status;
 	}
@@ -133,6 +508,37 @@ int flash_verify_noncontiguous_contents_at_offset (struct flash *flash, uint32_t
 	return rsa->sig_verify (rsa, pub_key, signature, sig_length, hash_out, SHA256_HASH_LENGTH);
 }
 
+/**
+ * Validate the contents of a group of noncontiguous blocks of data stored in a flash device
+ * against an RSA encrypted signature.
+ *
+ * All regions will be verified starting at a fixed offset in flash.
+ *
+ * @param flash The flash device that contains the data to verify.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of flash regions that should be verified as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use for verification.
+ * @param type The hashing algorithm used for the signature.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param signature The signature for the data block.
+ * @param sig_length The length of the signature.
+ * @param pub_key The public key for the signature.
+ * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
+ * signature verification fails.  Set this to NULL if the hash is not needed.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the flash contents are valid or an error code.
+ */
+int flash_verify_noncontiguous_contents_at_offset (struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
+	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length)
+{
+	return flash_verify_noncontiguous_contents_ext (flash, NULL, offset, regions, count, hash, type,
+		rsa, signature, sig_length, pub_key, hash_out, hash_length);
+}
+
 /**
  * Validate the contents of a contiguous block of data stored in a flash device using a signature
  * verification module.
@@ -169,42 +575,429 @@ int flash_contents_verification (struct flash *flash, uint32_t start_addr, size_
 }
 
 /**
- * Validate the contents of a group of noncontiguous blocks of data stored in a flash device using
- * a signature verification module.
- *
- * @param flash The flash device that contains the data to verify.
- * @param regions The group of flash regions that should be verified as a single region.
- * @param count The number of regions defined in the group.
- * @param hash The hashing engine to use for verification.
- * @param type The hashing algorithm used for the signature.
- * @param verification The module to use for signature verification.
- * @param signature The signature for the data block.
- * @param sig_length The length of the signature.
- * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
- * signature verification fails.  Set this to NULL if the hash is not needed.
- * @param hash_length The length of the hash output buffer.
- *
- * @return 0 if the flash contents are valid or an error code.
+ * Validate the contents of a group of noncontiguous blocks of data stored in a flash device using
+ * a signature verification module.
+ *
+ * @param flash The flash device that contains the data to verify.
+ * @param regions The group of flash regions that should be verified as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use for verification.
+ * @param type The hashing algorithm used for the signature.
+ * @param verification The module to use for signature verification.
+ * @param signature The signature for the data block.
+ * @param sig_length The length of the signature.
+ * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
+ * signature verification fails.  Set this to NULL if the hash is not needed.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the flash contents are valid or an error code.
+ */
+int flash_noncontiguous_contents_verification (struct flash *flash,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	struct signature_verification *verification, const uint8_t *signature, size_t sig_length,
+	uint8_t *hash_out, size_t hash_length)
+{
+	return flash_noncontiguous_contents_verification_at_offset (flash, 0, regions, count, hash,
+		type, verification, signature, sig_length, hash_out, hash_length);
+}
+
+/**
+ * Validate the contents of a group of noncontiguous blocks of data stored in a flash device using
+ * a signature verification module.
+ *
+ * All regions will be verified starting at a fixed offset in flash.
+ *
+ * @param flash The flash device that contains the data to verify.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of flash regions that should be verified as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use for verification.
+ * @param type The hashing algorithm used for the signature.
+ * @param verification The module to use for signature verification.
+ * @param signature The signature for the data block.
+ * @param sig_length The length of the signature.
+ * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
+ * signature verification fails.  Set this to NULL if the hash is not needed.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the flash contents are valid or an error code.
+ */
+static int flash_noncontiguous_contents_verification_ext (struct flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type,
+	struct signature_verification *verification, const uint8_t *signature, size_t sig_length,
+	uint8_t *hash_out, size_t hash_length)
+{
+	uint8_t data_hash[SHA256_HASH_LENGTH];
+	int status;
+
+	if ((flash == NULL) || (hash == NULL) || (verification == NULL) || (signature == NULL) ||
+		(sig_length == 0) || (count == 0)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if ((hash_out != NULL) && (hash_length < SHA256_HASH_LENGTH)) {
+		return FLASH_UTIL_HASH_BUFFER_TOO_SMALL;
+	}
+
+	if (hash_out == NULL) {
+		hash_out = data_hash;
+	}
+
+	switch (type) {
+		case HASH_TYPE_SHA256:
+			break;
+
+		case HASH_TYPE_SHA1:
+			return FLASH_UTIL_UNSUPPORTED_SIG_HASH;
+
+		default:
+			return FLASH_UTIL_UNKNOWN_SIG_HASH;
+	}
+
+	status = flash_hash_noncontiguous_contents_ext (flash, pipeline, offset, regions, count, hash,
+		type, hash_out, SHA256_HASH_LENGTH);
+	if (status != 0) {
+		return status;
+	}
+
+	return verification->verify_signature (verification, hash_out, SHA256_HASH_LENGTH, signature,
+		sig_length);
+}
+
+/**
+ * Validate the contents of a group of noncontiguous blocks of data stored in a flash device using
+ * a signature verification module.
+ *
+ * All regions will be verified starting at a fixed offset in flash.
+ *
+ * @param flash The flash device that contains the data to verify.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of flash regions that should be verified as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use for verification.
+ * @param type The hashing algorithm used for the signature.
+ * @param verification The module to use for signature verification.
+ * @param signature The signature for the data block.
+ * @param sig_length The length of the signature.
+ * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
+ * signature verification fails.  Set this to NULL if the hash is not needed.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the flash contents are valid or an error code.
+ */
+int flash_noncontiguous_contents_verification_at_offset (struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	struct signature_verification *verification, const uint8_t *signature, size_t sig_length,
+	uint8_t *hash_out, size_t hash_length)
+{
+	return flash_noncontiguous_contents_verification_ext (flash, NULL, offset, regions, count, hash,
+		type, verification, signature, sig_length, hash_out, hash_length);
+}
+
+/**
+ * Generate a hash for a contiguous block of data stored in a flash device.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param start_addr The first address of the data that should be hashed.
+ * @param length The number of bytes to hash.
+ * @param hash The hashing engine to use to generate the hash.
+ * @param type The type of hash to generate.
+ * @param hash_out The buffer to hold the generated hash value.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the hash was generated successfully or an error code.
+ */
+int flash_hash_contents (struct flash *flash, uint32_t start_addr, size_t length,
+	struct hash_engine *hash, enum hash_type type, uint8_t *hash_out, size_t hash_length)
+{
+	struct flash_region region;
+
+	if (length == 0) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	region.start_addr = start_addr;
+	region.length = length;
+
+	return flash_hash_noncontiguous_contents (flash, &region, 1, hash, type, hash_out, hash_length);
+}
+
+/**
+ * Generate a hash for a group of noncontiguous blocks of data stored in a flash device.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ * @param type The type of hash to generate.
+ * @param hash_out The buffer to hold the generated hash value.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the hash was generated successfully or an error code.
+ */
+int flash_hash_noncontiguous_contents (struct flash *flash, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, uint8_t *hash_out,
+	size_t hash_length)
+{
+	return flash_hash_noncontiguous_contents_at_offset (flash, 0, regions, count, hash, type,
+		hash_out, hash_length);
+}
+
+/**
+ * Generate a hash for a group of noncontiguous blocks of data stored in a flash device.
+ *
+ * All regions will be hashed starting at a fixed offset in flash.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ * @param type The type of hash to generate.
+ * @param hash_out The buffer to hold the generated hash value.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the hash was generated successfully or an error code.
+ */
+int flash_hash_noncontiguous_contents_at_offset (struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+	uint8_t *hash_out, size_t hash_length)
+{
+	return flash_hash_noncontiguous_contents_ext (flash, NULL, offset, regions, count, hash, type,
+		hash_out, hash_length);
+}
+
+/**
+ * Update an active hash with a contiguous block of data stored in a flash device.  The hash will
+ * not be finished or canceled by this call, even if there is an error.
+ *
+ * If a hash pipeline is provided, it will be used to read the flash contents.  Otherwise, data will
+ * be read in small blocks.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param start_addr The first address of the data that should be hashed.
+ * @param length The number of bytes to hash.
+ * @param hash The hashing engine to update.  A hash must already have been started.
+ *
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+static int flash_hash_update_contents_ext (struct flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t start_addr, size_t length,
+	struct hash_engine *hash)
+{
+	uint8_t data[FLASH_VERIFICATION_BLOCK];
+	struct flash_region region;
+	size_t next_read;
+	int status;
+
+	if ((flash == NULL) || (hash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if (pipeline != NULL) {
+		region.start_addr = start_addr;
+		region.length = length;
+
+		platform_mutex_lock (&pipeline->lock);
+		status = flash_hash_pipeline_update (pipeline, 0, &region, 1, hash);
+		platform_mutex_unlock (&pipeline->lock);
+
+		return status;
+	}
+
+	while (length > 0) {
+		next_read = (length < FLASH_VERIFICATION_BLOCK) ? length : FLASH_VERIFICATION_BLOCK;
+
+		status = flash->read (flash, start_addr, data, next_read);
+		if (status != 0) {
+			return status;
+		}
+
+		status = hash->update (hash, data, next_read);
+		if (status != 0) {
+			return status;
+		}
+
+		length -= next_read;
+		start_addr += next_read;
+	}
+
+	return 0;
+}
+
+/**
+ * Update an active hash with a contiguous block of data stored in a flash device.  The hash will
+ * not be finished or canceled by this call, even if there is an error.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param start_addr The first address of the data that should be hashed.
+ * @param length The number of bytes to hash.
+ * @param hash The hashing engine to update.  A hash must already have been started.
+ *
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+int flash_hash_update_contents (struct flash *flash, uint32_t start_addr, size_t length,
+	struct hash_engine *hash)
+{
+	return flash_hash_update_contents_ext (flash, NULL, start_addr, length, hash);
+}
+
+/**
+ * Load flash data into memory using background reads from a hash pipeline.  Each chunk is read
+ * directly into the destination buffer, and the next chunk is read while the previous one is being
+ * hashed.  The pipeline must be locked by the caller.
+ *
+ * @param pipeline The hash pipeline to use for reading the flash.
+ * @param start_addr The first address of the data to load.
+ * @param load_addr The memory location where the data should be loaded.
+ * @param length The number of bytes to load.
+ * @param hash The hash engine to update.  A hash must already have been started.
+ *
+ * @return 0 if the data was loaded and hashed successfully or an error code.
+ */
+static int flash_load_and_hash_pipeline_update (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, uint8_t *load_addr, size_t length, struct hash_engine *hash)
+{
+	size_t current;
+	size_t next;
+	int status;
+
+	current = (length < pipeline->chunk_size) ? length : pipeline->chunk_size;
+	if (current != 0) {
+		status = pipeline->async->start_read (pipeline->async, start_addr, load_addr, current);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	while (current != 0) {
+		status = pipeline->async->wait_for_read (pipeline->async);
+		if (status != 0) {
+			return status;
+		}
+
+		length -= current;
+		next = (length < pipeline->chunk_size) ? length : pipeline->chunk_size;
+		if (next != 0) {
+			status = pipeline->async->start_read (pipeline->async, start_addr + current,
+				&load_addr[current], next);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		status = hash->update (hash, load_addr, current);
+		if (status != 0) {
+			if (next != 0) {
+				pipeline->async->wait_for_read (pipeline->async);
+			}
+
+			return status;
+		}
+
+		start_addr += current;
+		load_addr += current;
+		current = next;
+	}
+
+	return 0;
+}
+
+/**
+ * Load a contiguous block of data from a flash device into memory and update an active hash with
+ * the same data.  Each chunk is added to the hash as soon as it has been loaded, so the data is
+ * only traversed once.  The hash will not be finished or canceled by this call, even if there is
+ * an error.
+ *
+ * If a hash pipeline is provided, data will be loaded in chunks of the pipeline size.  If the
+ * pipeline supports background reads, the next chunk will be loaded while the previous one is being
+ * hashed.  Without a pipeline, data is loaded in FLASH_LOAD_HASH_BLOCK chunks.
+ *
+ * @param flash The flash device that contains the data to load.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param start_addr The first address of the data to load.
+ * @param load_addr The memory location where the data should be loaded.
+ * @param length The number of bytes to load.
+ * @param hash The hashing engine to update.  A hash must already have been started.
+ *
+ * @return 0 if the data was loaded and hashed successfully or an error code.
+ */
+static int flash_load_and_hash_update_ext (struct flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t start_addr, uint8_t *load_addr, size_t length,
+	struct hash_engine *hash)
+{
+	size_t chunk_size = FLASH_LOAD_HASH_BLOCK;
+	size_t next_read;
+	int status;
+
+	if ((flash == NULL) || (load_addr == NULL) || (hash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if (pipeline != NULL) {
+		if (pipeline->async != NULL) {
+			platform_mutex_lock (&pipeline->lock);
+			status = flash_load_and_hash_pipeline_update (pipeline, start_addr, load_addr, length,
+				hash);
+			platform_mutex_unlock (&pipeline->lock);
+
+			return status;
+		}
+
+		chunk_size = pipeline->chunk_size;
+	}
+
+	while (length > 0) {
+		next_read = (length < chunk_size) ? length : chunk_size;
+
+		status = flash->read (flash, start_addr, load_addr, next_read);
+		if (status != 0) {
+			return status;
+		}
+
+		status = hash->update (hash, load_addr, next_read);
+		if (status != 0) {
+			return status;
+		}
+
+		length -= next_read;
+		start_addr += next_read;
+		load_addr += next_read;
+	}
+
+	return 0;
+}
+
+/**
+ * Load a contiguous block of data from a flash device into memory and update an active hash with
+ * the same data.  Each chunk is added to the hash as soon as it has been loaded, so the data is
+ * only traversed once.  The hash will not be finished or canceled by this call, even if there is
+ * an error.
+ *
+ * @param flash The flash device that contains the data to load.
+ * @param start_addr The first address of the data to load.
+ * @param load_addr The memory location where the data should be loaded.
+ * @param length The number of bytes to load.
+ * @param hash The hashing engine to update.  A hash must already have been started.
+ *
+ * @return 0 if the data was loaded and hashed successfully or an error code.
  */
-int flash_noncontiguous_contents_verification (struct flash *flash,
-	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
-	struct signature_verification *verification, const uint8_t *signature, size_t sig_length,
-	uint8_t *hash_out, size_t hash_length)
+int flash_load_and_hash_update (struct flash *flash, uint32_t start_addr, uint8_t *load_addr,
+	size_t length, struct hash_engine *hash)
 {
-	return flash_noncontiguous_contents_verification_at_offset (flash, 0, regions, count, hash,
-		type, verification, signature, sig_length, hash_out, hash_length);
+	return flash_load_and_hash_update_ext (flash, NULL, start_addr, load_addr, length, hash);
 }
 
 /**
- * Validate the contents of a group of noncontiguous blocks of data stored in a flash device using
- * a signature verification module.
- *
- * All regions will be verified starting at a fixed offset in flash.
+ * Validate the contents of a contiguous block of data stored in a flash device using a signature
+ * verification module.  The flash contents will be read using a hash pipeline.
  *
- * @param flash The flash device that contains the data to verify.
- * @param offset An offset to apply to each region address.
- * @param regions The group of flash regions that should be verified as a single region.
- * @param count The number of regions defined in the group.
+ * @param pipeline The hash pipeline for the flash device that contains the data to verify.
+ * @param start_addr The first address of the data that should be verified.
+ * @param length The number of bytes to verify.
  * @param hash The hashing engine to use for verification.
  * @param type The hashing algorithm used for the signature.
  * @param verification The module to use for signature verification.
@@ -216,52 +1009,29 @@ int flash_noncontiguous_contents_verification (struct flash *flash,
  *
  * @return 0 if the flash contents are valid or an error code.
  */
-int flash_noncontiguous_contents_verification_at_offset (struct flash *flash, uint32_t offset,
-	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+int flash_hash_pipeline_contents_verification (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, size_t length, struct hash_engine *hash, enum hash_type type,
 	struct signature_verification *verification, const uint8_t *signature, size_t sig_length,
 	uint8_t *hash_out, size_t hash_length)
 {
-	uint8_t data_hash[SHA256_HASH_LENGTH];
-	int status;
+	struct flash_region region;
 
-	if ((flash == NULL) || (hash == NULL) || (verification == NULL) || (signature == NULL) ||
-		(sig_length == 0) || (count == 0)) {
+	if ((pipeline == NULL) || (length == 0)) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	if ((hash_out != NULL) && (hash_length < SHA256_HASH_LENGTH)) {
-		return FLASH_UTIL_HASH_BUFFER_TOO_SMALL;
-	}
-
-	if (hash_out == NULL) {
-		hash_out = data_hash;
-	}
-
-	switch (type) {
-		case HASH_TYPE_SHA256:
-			break;
-
-		case HASH_TYPE_SHA1:
-			return FLASH_UTIL_UNSUPPORTED_SIG_HASH;
-
-		default:
-			return FLASH_UTIL_UNKNOWN_SIG_HASH;
-	}
-
-	status = flash_hash_noncontiguous_contents_at_offset (flash, offset, regions, count, hash, type,
-		hash_out, SHA256_HASH_LENGTH);
-	if (status != 0) {
-		return status;
-	}
+	region.start_addr = start_addr;
+	region.length = length;
 
-	return verification->verify_signature (verification, hash_out, SHA256_HASH_LENGTH, signature,
-		sig_length);
+	return flash_noncontiguous_contents_verification_ext (pipeline->flash, pipeline, 0, &region, 1,
+		hash, type, verification, signature, sig_length, hash_out, hash_length);
 }
 
 /**
- * Generate a hash for a contiguous block of data stored in a flash device.
+ * Generate a hash for a contiguous block of data stored in a flash device.  The flash contents will
+ * be read using a hash pipeline.
  *
- * @param flash The flash device that contains the data to hash.
+ * @param pipeline The hash pipeline for the flash device that contains the data to hash.
  * @param start_addr The first address of the data that should be hashed.
  * @param length The number of bytes to hash.
  * @param hash The hashing engine to use to generate the hash.
@@ -271,8 +1041,9 @@ int flash_noncontiguous_contents_verification_at_offset (struct flash *flash, ui
  *
  * @return 0 if the hash was generated successfully or an error code.
  */
-int flash_hash_contents (struct flash *flash, uint32_t start_addr, size_t length,
-	struct hash_engine *hash, enum hash_type type, uint8_t *hash_out, size_t hash_length)
+int flash_hash_pipeline_hash_contents (struct flash_hash_pipeline *pipeline, uint32_t start_addr,
+	size_t length, struct hash_engine *hash, enum hash_type type, uint8_t *hash_out,
+	size_t hash_length)
 {
 	struct flash_region region;
 
@@ -283,13 +1054,18 @@ int flash_hash_contents (struct flash *flash, uint32_t start_addr, size_t length
 	region.start_addr = start_addr;
 	region.length = length;
 
-	return flash_hash_noncontiguous_contents (flash, &region, 1, hash, type, hash_out, hash_length);
+	return flash_hash_pipeline_hash_noncontiguous_contents_at_offset (pipeline, 0, &region, 1, hash,
+		type, hash_out, hash_length);
 }
 
 /**
- * Generate a hash for a group of noncontiguous blocks of data stored in a flash device.
+ * Generate a hash for a group of noncontiguous blocks of data stored in a flash device.  The flash
+ * contents will be read using a hash pipeline.
  *
- * @param flash The flash device that contains the data to hash.
+ * All regions will be hashed starting at a fixed offset in flash.
+ *
+ * @param pipeline The hash pipeline for the flash device that contains the data to hash.
+ * @param offset An offset to apply to each region address.
  * @param regions The group of regions that should be hashed as a single region.
  * @param count The number of regions defined in the group.
  * @param hash The hashing engine to use to generate the hash.
@@ -299,83 +1075,133 @@ int flash_hash_contents (struct flash *flash, uint32_t start_addr, size_t length
  *
  * @return 0 if the hash was generated successfully or an error code.
  */
-int flash_hash_noncontiguous_contents (struct flash *flash, const struct flash_region *regions,
+int flash_hash_pipeline_hash_noncontiguous_contents_at_offset (
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct flash_region *regions,
 	size_t count, struct hash_engine *hash, enum hash_type type, uint8_t *hash_out,
 	size_t hash_length)
 {
-	return flash_hash_noncontiguous_contents_at_offset (flash, 0, regions, count, hash, type,
-		hash_out, hash_length);
+	if (pipeline == NULL) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	return flash_hash_noncontiguous_contents_ext (pipeline->flash, pipeline, offset, regions, count,
+		hash, type, hash_out, hash_length);
 }
 
 /**
- * Generate a hash for a group of noncontiguous blocks of data stored in a flash device.
+ * Update an active hash with a contiguous block of data stored in a flash device.  The flash
+ * contents will be read using a hash pipeline.  The hash will not be finished or canceled by this
+ * call, even if there is an error.
  *
- * All regions will be hashed starting at a fixed offset in flash.
+ * @param pipeline The hash pipeline for the flash device that contains the data to hash.
+ * @param start_addr The first address of the data that should be hashed.
+ * @param length The number of bytes to hash.
+ * @param hash The hashing engine to update.  A hash must already have been started.
  *
- * @param flash The flash device that contains the data to hash.
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+int flash_hash_pipeline_update_contents (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, size_t length, struct hash_engine *hash)
+{
+	if (pipeline == NULL) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	return flash_hash_update_contents_ext (pipeline->flash, pipeline, start_addr, length, hash);
+}
+
+/**
+ * Load a contiguous block of data from a flash device into memory and update an active hash with
+ * the same data.  The flash contents will be loaded using a hash pipeline.  The hash will not be
+ * finished or canceled by this call, even if there is an error.
+ *
+ * @param pipeline The hash pipeline for the flash device that contains the data to load.
+ * @param start_addr The first address of the data to load.
+ * @param load_addr The memory location where the data should be loaded.
+ * @param length The number of bytes to load.
+ * @param hash The hashing engine to update.  A hash must already have been started.
+ *
+ * @return 0 if the data was loaded and hashed successfully or an error code.
+ */
+int flash_hash_pipeline_load_and_hash_update (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, uint8_t *load_addr, size_t length, struct hash_engine *hash)
+{
+	if (pipeline == NULL) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	return flash_load_and_hash_update_ext (pipeline->flash, pipeline, start_addr, load_addr, length,
+		hash);
+}
+
+/**
+ * Validate the contents of a group of noncontiguous blocks of data stored in a flash device
+ * against an RSA encrypted signature.  The flash contents will be read using a hash pipeline.
+ *
+ * All regions will be verified starting at a fixed offset in flash.
+ *
+ * @param pipeline The hash pipeline for the flash device that contains the data to verify.
  * @param offset An offset to apply to each region address.
- * @param regions The group of regions that should be hashed as a single region.
+ * @param regions The group of flash regions that should be verified as a single region.
  * @param count The number of regions defined in the group.
- * @param hash The hashing engine to use to generate the hash.
- * @param type The type of hash to generate.
- * @param hash_out The buffer to hold the generated hash value.
+ * @param hash The hashing engine to use for verification.
+ * @param type The hashing algorithm used for the signature.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param signature The signature for the data block.
+ * @param sig_length The length of the signature.
+ * @param pub_key The public key for the signature.
+ * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
+ * signature verification fails.  Set this to NULL if the hash is not needed.
  * @param hash_length The length of the hash output buffer.
  *
- * @return 0 if the hash was generated successfully or an error code.
+ * @return 0 if the flash contents are valid or an error code.
  */
-int flash_hash_noncontiguous_contents_at_offset (struct flash *flash, uint32_t offset,
-	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
+int flash_hash_pipeline_verify_noncontiguous_contents_at_offset (
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, struct rsa_engine *rsa,
+	const uint8_t *signature, size_t sig_length, const struct rsa_public_key *pub_key,
 	uint8_t *hash_out, size_t hash_length)
 {
-	uint8_t data[FLASH_VERIFICATION_BLOCK];
-	size_t next_read;
-	uint32_t current_addr;
-	size_t remaining;
-	size_t i;
-	int status;
-
-	if ((flash == NULL) || (regions == NULL) || (hash == NULL) || (hash_out == NULL) ||
-		(count == 0) || (hash_length == 0)) {
+	if (pipeline == NULL) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	status = hash_start_new_hash (hash, type);
-	if (status != 0) {
-		return status;
-	}
-
-	for (i = 0; i < count; i++) {
-		current_addr = regions[i].start_addr + offset;
-		remaining = regions[i].length;
-
-		while (remaining > 0) {
-			next_read = (remaining < FLASH_VERIFICATION_BLOCK) ?
-				remaining : FLASH_VERIFICATION_BLOCK;
-
-			status = flash->read (flash, current_addr, data, next_read);
-			if (status != 0) {
-				return status;
-			}
+	return flash_verify_noncontiguous_contents_ext (pipeline->flash, pipeline, offset, regions,
+		count, hash, type, rsa, signature, sig_length, pub_key, hash_out, hash_length);
+}
 
-			status = hash->update (hash, data, next_read);
-			if (status != 0) {
-				goto fail;
-			}
+/**
+ * Read a contiguous block of data from a flash device using a hash pipeline and pass the data to a
+ * handler for processing.  The handler will be called once for each chunk read from flash, in
+ * address order.  If the pipeline supports background reads, the next chunk will be read while the
+ * handler is processing the current one.
+ *
+ * @param pipeline The hash pipeline for the flash device that contains the data.
+ * @param start_addr The first address of the data to read.
+ * @param length The number of bytes to read.
+ * @param handler The handler to call for each chunk of data.  Processing stops if the handler
+ * returns an error.
+ * @param context Context to pass to the data handler.
+ *
+ * @return 0 if all data was processed successfully or an error code.
+ */
+int flash_hash_pipeline_process_contents (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, size_t length, flash_hash_pipeline_data_handler handler, void *context)
+{
+	struct flash_region region;
+	int status;
 
-			remaining -= next_read;
-			current_addr += next_read;
-		}
+	if ((pipeline == NULL) || (handler == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	status = hash->finish (hash, hash_out, hash_length);
-	if (status != 0) {
-		goto fail;
-	}
+	region.start_addr = start_addr;
+	region.length = length;
 
-return 0;
+	platform_mutex_lock (&pipeline->lock);
+	status = flash_hash_pipeline_process (pipeline, 0, &region, 1, handler, context);
+	platform_mutex_unlock (&pipeline->lock);
 
-fail:
-	hash->cancel (hash);
 	return status;
 }
 
@@ -475,11 +1301,10 @@ int flash_sector_erase_region (struct flash *flash, uint32_t start_addr, size_t
 static int flash_check_region_for_data (struct flash *flash, uint32_t start_addr,
 	const uint8_t *data, size_t length, bool const_byte)
 {
-	uint8_t block[FLASH_VERIFICATION_BLOCK];
-	uint8_t next = (const_byte) ? 0 : 1;
+	uint8_t block[FLASH_DATA_CHECK_BLOCK];
 	size_t read_len;
+	bool match;
 	int flash_good = 0;
-	size_t i;
 
 	if (flash == NULL) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
@@ -490,11 +1315,16 @@ static int flash_check_region_for_data (struct flash *flash, uint32_t start_addr
 
 		flash_good = flash->read (flash, start_addr, block, read_len);
 		if (flash_good == 0) {
-			for (i = 0; i < read_len; i++, data += next) {
-				if (*data != block[i]) {
-					flash_good = FLASH_UTIL_DATA_MISMATCH;
-					break;
-				}
+			if (const_byte) {
+				match = flash_compare_const_byte (block, read_len, *data);
+			}
+			else {
+				match = flash_compare_data (block, data, read_len);
+				data += read_len;
+			}
+
+			if (!match) {
+				flash_good = FLASH_UTIL_DATA_MISMATCH;
 			}
 
 			start_addr += read_len;
@@ -800,6 +1630,72 @@ static int flash_check_copy_region (uint32_t dest_addr, uint32_t src_addr, size_
 	return 0;
 }
 
+/**
+ * Copy data to a blank flash region using a copy stream.  The stream must be locked by the caller.
+ *
+ * @param stream The copy stream for the destination flash.
+ * @param dest_addr The starting address of the region to copy to.
+ * @param src_flash The flash device to copy data from.
+ * @param src_addr The starting address of the region to copy from.
+ * @param length The size of the region to copy.
+ * @param page The size of a flash page.
+ * @param verify Flag indicating if the copy should be verified after the data has been written to
+ * the destination.
+ *
+ * @return 0 if the data was successfully copied or an error code.
+ */
+static int flash_copy_stream_copy (struct flash_copy_stream *stream, uint32_t dest_addr,
+	struct flash *src_flash, uint32_t src_addr, size_t length, uint32_t page, uint8_t verify)
+{
+	size_t chunk;
+	size_t block_len;
+	size_t pos;
+	int status;
+
+	while (length != 0) {
+		chunk = (length > stream->chunk_size) ? stream->chunk_size : length;
+
+		status = src_flash->read (src_flash, src_addr, stream->data, chunk);
+		if (status != 0) {
+			return status;
+		}
+
+		pos = 0;
+		while (pos < chunk) {
+			block_len = page - FLASH_REGION_OFFSET (dest_addr + pos, page);
+			block_len = ((chunk - pos) > block_len) ? block_len : (chunk - pos);
+
+			status = stream->flash->write (stream->flash, dest_addr + pos, &stream->data[pos],
+				block_len);
+			if (ROT_IS_ERROR (status)) {
+				return status;
+			}
+			else if ((size_t) status != block_len) {
+				return FLASH_UTIL_INCOMPLETE_WRITE;
+			}
+
+			pos += block_len;
+		}
+
+		if (verify) {
+			status = stream->flash->read (stream->flash, dest_addr, stream->verify, chunk);
+			if (status != 0) {
+				return status;
+			}
+
+			if (!flash_compare_data (stream->data, stream->verify, chunk)) {
+				return FLASH_UTIL_DATA_MISMATCH;
+			}
+		}
+
+		length -= chunk;
+		src_addr += chunk;
+		dest_addr += chunk;
+	}
+
+	return 0;
+}
+
 /**
  * Copy data stored at one flash location to another flash location that must be blank.  The
  * destination will optionally be verified after the copy.
@@ -865,6 +1761,7 @@ static int flash_copy_data_to_blank_region (struct flash *dest_flash, uint32_t d
  * Erase blocks are on 64kB boundaries.
  *
  * @param dest_flash The flash device to copy data to.
+ * @param stream Optional copy stream to use for writing to the destination flash.
  * @param dest_addr The starting address of the region to copy to.
  * @param src_flash The flash device to copy data from.
  * @param src_addr The starting address of the region to copy from.
@@ -878,10 +1775,10 @@ static int flash_copy_data_to_blank_region (struct flash *dest_flash, uint32_t d
  *
  * @return 0 if the data was successfully copied or an error code.
  */
-static int flash_copy_data_region_ext (struct flash *dest_flash, uint32_t dest_addr,
-	struct flash *src_flash, uint32_t src_addr, size_t length,
-	int (*erase) (struct flash*, uint32_t, size_t), int (*block_size) (struct flash*, uint32_t*),
-	uint8_t verify)
+static int flash_copy_data_region_ext (struct flash *dest_flash,
+	struct flash_copy_stream *stream, uint32_t dest_addr, struct flash *src_flash,
+	uint32_t src_addr, size_t length, int (*erase) (struct flash*, uint32_t, size_t),
+	int (*block_size) (struct flash*, uint32_t*), uint8_t verify)
 {
 	uint32_t page;
 	int status;
@@ -924,6 +1821,15 @@ static int flash_copy_data_region_ext (struct flash *dest_flash, uint32_t dest_a
 		return FLASH_UTIL_UNSUPPORTED_PAGE_SIZE;
 	}
 
+	if (stream != NULL) {
+		platform_mutex_lock (&stream->lock);
+		status = flash_copy_stream_copy (stream, dest_addr, src_flash, src_addr, length, page,
+			verify);
+		platform_mutex_unlock (&stream->lock);
+
+		return status;
+	}
+
 	return flash_copy_data_to_blank_region (dest_flash, dest_addr, src_flash, src_addr, length,
 		page, verify);
 }
@@ -955,8 +1861,8 @@ static int flash_copy_data_region (struct flash *dest_flash, uint32_t dest_addr,
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	return flash_copy_data_region_ext (dest_flash, dest_addr, src_flash, src_addr, length, erase,
-		src_flash->get_block_size, verify);
+	return flash_copy_data_region_ext (dest_flash, NULL, dest_addr, src_flash, src_addr, length,
+		erase, src_flash->get_block_size, verify);
 }
 
 /**
@@ -982,7 +1888,7 @@ static int flash_sector_copy_data_region (struct flash *dest_flash, uint32_t des
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	return flash_copy_data_region_ext (dest_flash, dest_addr, src_flash, src_addr, length,
+	return flash_copy_data_region_ext (dest_flash, NULL, dest_addr, src_flash, src_addr, length,
 		flash_sector_erase_region, src_flash->get_sector_size, verify);
 }
 
@@ -1298,3 +2204,60 @@ int flash_copy_ext_to_blank_and_verify (struct flash *dest_flash, uint32_t dest_
 {
 	return flash_copy_data_region (dest_flash, dest_addr, src_flash, src_addr, length, NULL, 1);
 }
+
+/**
+ * Copy data stored at a location in flash to another flash location using a copy stream.  The
+ * destination is the flash device written by the stream.  The source and destination flash devices
+ * can be the same or different devices.  If they are the same, then the source and destination
+ * regions must not overlap or be within the same erase block.
+ *
+ * It is assumed that the destination flash region is already blank.  No erase or blank check will
+ * be performed.
+ *
+ * @param stream The copy stream for the flash device to write the copy to.
+ * @param dest_addr The flash address where the copy will be stored.
+ * @param src_flash The flash device to read the copy from.
+ * @param src_addr The flash address where the data will be copied from.
+ * @param length The number of bytes to copy.
+ *
+ * @return 0 if the data was successfully copied or an error code.
+ */
+int flash_copy_stream_copy_ext_to_blank (struct flash_copy_stream *stream, uint32_t dest_addr,
+	struct flash *src_flash, uint32_t src_addr, size_t length)
+{
+	if ((stream == NULL) || (src_flash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	return flash_copy_data_region_ext (stream->flash, stream, dest_addr, src_flash, src_addr,
+		length, NULL, src_flash->get_block_size, 0);
+}
+
+/**
+ * Copy data stored at a location in flash to another flash location using a copy stream.  The
+ * destination is the flash device written by the stream.  The source and destination flash devices
+ * can be the same or different devices.  If they are the same, then the source and destination
+ * regions must not overlap or be within the same erase block.  After each chunk has been copied,
+ * the copied contents will be verified.
+ *
+ * It is assumed that the destination flash region is already blank.  No erase or blank check will
+ * be performed.
+ *
+ * @param stream The copy stream for the flash device to write the copy to.
+ * @param dest_addr The flash address where the copy will be stored.
+ * @param src_flash The flash device to read the copy from.
+ * @param src_addr The flash address where the data will be copied from.
+ * @param length The number of bytes to copy.
+ *
+ * @return 0 if the data was successfully copied or an error code.
+ */
+int flash_copy_stream_copy_ext_to_blank_and_verify (struct flash_copy_stream *stream,
+	uint32_t dest_addr, struct flash *src_flash, uint32_t src_addr, size_t length)
+{
+	if ((stream == NULL) || (src_flash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	return flash_copy_data_region_ext (stream->flash, stream, dest_addr, src_flash, src_addr,
+		length, NULL, src_flash->get_block_size, 1);
+}
@@ -8,9 +8,12 @@
 #include <stddef.h>
 #include "status/rot_status.h"
 #include "flash.h"
+#include "flash_async_read.h"
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
 #include "common/signature_verification.h"
+#include "platform.h"
+#include "platform_config.h"
 
 
 /**
@@ -18,11 +21,40 @@
  */
 #define	FLASH_VERIFICATION_BLOCK	256
 
+/* Configurable flash utility parameters.  Defaults can be overridden in platform_config.h. */
+#ifndef FLASH_DATA_CHECK_BLOCK
+#define	FLASH_DATA_CHECK_BLOCK		FLASH_VERIFICATION_BLOCK
+#endif
+
+#ifndef FLASH_LOAD_HASH_BLOCK
+#define	FLASH_LOAD_HASH_BLOCK		(4 * 1024)
+#endif
+
 /**
  * The maximum block size supported for flash copy operations.
  */
 #define	FLASH_MAX_COPY_BLOCK		512
 
+/**
+ * The smallest chunk size supported for pipelined hashing of flash contents.
+ */
+#define	FLASH_HASH_PIPELINE_MIN_CHUNK	(4 * 1024)
+
+/**
+ * The largest chunk size supported for pipelined hashing of flash contents.
+ */
+#define	FLASH_HASH_PIPELINE_MAX_CHUNK	(64 * 1024)
+
+/**
+ * The smallest chunk size supported for streaming flash copy operations.
+ */
+#define	FLASH_COPY_STREAM_MIN_CHUNK		(4 * 1024)
+
+/**
+ * The largest chunk size supported for streaming flash copy operations.
+ */
+#define	FLASH_COPY_STREAM_MAX_CHUNK		(64 * 1024)
+
 
 /**
  * Defines a single region of flash memory.
@@ -32,6 +64,61 @@ struct flash_region {
 	size_t length;			/**< The size of the region. */
 };
 
+/**
+ * Context for hashing flash contents in large chunks using a pair of buffers.  If the flash device
+ * supports background reads, the next chunk will be read from flash while the previous one is
+ * being hashed.
+ *
+ * The pipeline is passed to the flash_hash_pipeline_* utility functions in place of the flash
+ * device.
+ */
+struct flash_hash_pipeline {
+	struct flash *flash;					/**< The flash device the pipeline reads from. */
+	struct flash_async_read *async;			/**< Optional interface for background flash reads. */
+	uint8_t *buffer[2];						/**< The buffers used to hold flash data. */
+	size_t chunk_size;						/**< The amount of data to read into each buffer. */
+	platform_mutex lock;					/**< Synchronization for using the data buffers. */
+};
+
+
+/**
+ * Handler for processing flash data read using a hash pipeline.
+ *
+ * @param context Context provided by the caller reading the flash.
+ * @param data The data that was read from flash.
+ * @param length The amount of data that was read.
+ *
+ * @return 0 if the data was processed successfully or an error code.
+ */
+typedef int (*flash_hash_pipeline_data_handler) (void *context, const uint8_t *data,
+	size_t length);
+
+
+int flash_hash_pipeline_init (struct flash_hash_pipeline *pipeline, struct flash *flash,
+	struct flash_async_read *async, size_t chunk_size);
+void flash_hash_pipeline_release (struct flash_hash_pipeline *pipeline);
+
+/**
+ * Context for copying data to a flash device in large chunks.  Each chunk is read from the source
+ * with a single request, programmed to the destination one page after another, and then verified
+ * with a single read of the destination.
+ *
+ * The stream is passed to the flash_copy_stream_* utility functions in place of the destination
+ * flash device.
+ */
+struct flash_copy_stream {
+	struct flash *flash;					/**< The flash device the stream writes to. */
+	uint8_t *data;							/**< Buffer for data read from the source. */
+	uint8_t *verify;						/**< Buffer for data read back from the destination. */
+	size_t chunk_size;						/**< The amount of data copied in each chunk. */
+	platform_mutex lock;					/**< Synchronization for using the data buffers. */
+};
+
+
+int flash_copy_stream_init (struct flash_copy_stream *stream, struct flash *flash,
+	size_t chunk_size);
+void flash_copy_stream_release (struct flash_copy_stream *stream);
+
 
 int flash_verify_contents (struct flash *flash, uint32_t start_addr, size_t length,
 	struct hash_engine *hash, enum hash_type type, struct rsa_engine *rsa, const uint8_t *signature,
@@ -66,6 +153,34 @@ int flash_hash_noncontiguous_contents_at_offset (struct flash *flash, uint32_t o
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	uint8_t *hash_out, size_t hash_length);
 
+int flash_hash_update_contents (struct flash *flash, uint32_t start_addr, size_t length,
+	struct hash_engine *hash);
+int flash_load_and_hash_update (struct flash *flash, uint32_t start_addr, uint8_t *load_addr,
+	size_t length, struct hash_engine *hash);
+
+int flash_hash_pipeline_contents_verification (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, size_t length, struct hash_engine *hash, enum hash_type type,
+	struct signature_verification *verification, const uint8_t *signature, size_t sig_length,
+	uint8_t *hash_out, size_t hash_length);
+int flash_hash_pipeline_hash_contents (struct flash_hash_pipeline *pipeline, uint32_t start_addr,
+	size_t length, struct hash_engine *hash, enum hash_type type, uint8_t *hash_out,
+	size_t hash_length);
+int flash_hash_pipeline_hash_noncontiguous_contents_at_offset (
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, uint8_t *hash_out,
+	size_t hash_length);
+int flash_hash_pipeline_verify_noncontiguous_contents_at_offset (
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, struct rsa_engine *rsa,
+	const uint8_t *signature, size_t sig_length, const struct rsa_public_key *pub_key,
+	uint8_t *hash_out, size_t hash_length);
+int flash_hash_pipeline_update_contents (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, size_t length, struct hash_engine *hash);
+int flash_hash_pipeline_load_and_hash_update (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, uint8_t *load_addr, size_t length, struct hash_engine *hash);
+int flash_hash_pipeline_process_contents (struct flash_hash_pipeline *pipeline,
+	uint32_t start_addr, size_t length, flash_hash_pipeline_data_handler handler, void *context);
+
 int flash_erase_region (struct flash *flash, uint32_t start_addr, size_t length);
 int flash_sector_erase_region (struct flash *flash, uint32_t start_addr, size_t length);
 int flash_blank_check (struct flash *flash, uint32_t start_addr, size_t length);
@@ -116,6 +231,11 @@ int flash_copy_ext_to_blank (struct flash *dest_flash, uint32_t dest_addr, struc
 int flash_copy_ext_to_blank_and_verify (struct flash *dest_flash, uint32_t dest_addr,
 	struct flash *src_flash, uint32_t src_addr, size_t length);
 
+int flash_copy_stream_copy_ext_to_blank (struct flash_copy_stream *stream, uint32_t dest_addr,
+	struct flash *src_flash, uint32_t src_addr, size_t length);
+int flash_copy_stream_copy_ext_to_blank_and_verify (struct flash_copy_stream *stream,
+	uint32_t dest_addr, struct flash *src_flash, uint32_t src_addr, size_t length);
+
 
 #define	FLASH_UTIL_ERROR(code)		ROT_ERROR (ROT_MODULE_FLASH_UTIL, code)
 
@@ -135,6 +255,7 @@ enum {
 	FLASH_UTIL_UNEXPECTED_VALUE = FLASH_UTIL_ERROR (0x09),		/**< The flash does not contain the expected value. */
 	FLASH_UTIL_HASH_BUFFER_TOO_SMALL = FLASH_UTIL_ERROR (0x0a),	/**< The hash out buffer is not large enough. */
 	FLASH_UTIL_UNSUPPORTED_PAGE_SIZE = FLASH_UTIL_ERROR (0x0b),	/**< Flash page size is unsupported. */
+	FLASH_UTIL_UNSUPPORTED_CHUNK_SIZE = FLASH_UTIL_ERROR (0x0c),	/**< The pipeline or stream chunk size is not supported. */
 };
 
 
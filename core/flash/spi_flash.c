@@ -451,6 +451,7 @@ static int spi_flash_simple_command (struct spi_flash *flash, uint8_t cmd)
  */
 static int spi_flash_write_enable (struct spi_flash *flash)
 {
+	flash->wip_state = SPI_FLASH_WIP_UNKNOWN;
 	return spi_flash_simple_command (flash, FLASH_CMD_WREN);
 }
 
@@ -463,6 +464,7 @@ static int spi_flash_write_enable (struct spi_flash *flash)
  */
 static int spi_flash_volatile_write_enable (struct spi_flash *flash)
 {
+	flash->wip_state = SPI_FLASH_WIP_UNKNOWN;
 	return spi_flash_simple_command (flash, FLASH_CMD_VOLATILE_WREN);
 }
 
@@ -550,6 +552,98 @@ static int spi_flash_wait_for_write_completion (struct spi_flash *flash, int32_t
 	return status;
 }
 
+/**
+ * Update the tracked write state after the device has finished executing a write.  The device is
+ * only tracked as idle while streaming writes are enabled, since other SPI masters could be writing
+ * to the device otherwise.
+ *
+ * @param flash The flash instance that is no longer executing a write.
+ */
+static void spi_flash_set_write_idle (struct spi_flash *flash)
+{
+	flash->wip_state = (flash->stream_mode) ? SPI_FLASH_WIP_IDLE : SPI_FLASH_WIP_UNKNOWN;
+}
+
+/**
+ * Check that the flash is not executing a write before sending a new command.  The device status
+ * will not be read if the device is already known to be idle.
+ *
+ * @param flash The flash instance to check.
+ *
+ * @return 0 if the device is idle or an error code.
+ */
+static int spi_flash_check_write_idle (struct spi_flash *flash)
+{
+	int status;
+
+	if (flash->wip_state == SPI_FLASH_WIP_IDLE) {
+		return 0;
+	}
+
+	status = spi_flash_is_wip_set (flash);
+	if (status == 0) {
+		spi_flash_set_write_idle (flash);
+	}
+	else if (status == 1) {
+		status = SPI_FLASH_WRITE_IN_PROGRESS;
+	}
+
+	return status;
+}
+
+/**
+ * Wait for a page program to complete.  Status polling is tuned using the typical page program
+ * time reported by the device.  Devices that program a page in less than a millisecond are polled
+ * continuously.  For slower devices, the first status read is deferred by the typical program time
+ * and the delay between any further reads backs off up to the same amount.
+ *
+ * @param flash The flash instance that is programming a page.
+ * @param timeout The maximum number of milliseconds to wait for completion.  A negative number will
+ * wait forever.  0 will return immediately.
+ *
+ * @return 0 if the page program was completed or an error code.
+ */
+static int spi_flash_wait_for_page_program (struct spi_flash *flash, int32_t timeout)
+{
+	platform_clock timeout_val;
+	uint32_t max_delay = flash->program_time / 1000;
+	uint32_t delay = 0;
+	int status;
+
+	if (timeout > 0) {
+		status = platform_init_timeout (timeout, &timeout_val);
+		if (status) {
+			return status;
+		}
+	}
+
+	if ((timeout != 0) && (max_delay != 0)) {
+		platform_msleep (max_delay);
+		delay = 1;
+	}
+
+	do {
+		status = spi_flash_is_wip_set (flash);
+		if (status == 1) {
+			if ((timeout == 0) ||
+				((timeout > 0) && (platform_has_timeout_expired (&timeout_val) == 1))) {
+				return SPI_FLASH_WIP_TIMEOUT;
+			}
+
+			if (delay != 0) {
+				platform_msleep (delay);
+				delay = ((delay * 2) > max_delay) ? max_delay : (delay * 2);
+			}
+		}
+	} while (status == 1);
+
+	if (status == 0) {
+		spi_flash_set_write_idle (flash);
+	}
+
+	return status;
+}
+
 /**
  * Send a write command that writes to register that requires no addressing.  This will block until
  * the register write has completed.
@@ -677,6 +771,12 @@ int spi_flash_discover_device_properties (struct spi_flash *flash, struct spi_fl
 	flash->use_busy_flag = spi_flash_sfdp_use_busy_flag_status (&parameters);
 	flash->sr1_volatile = spi_flash_sfdp_use_volatile_write_enable (&parameters);
 
+	status = spi_flash_sfdp_get_page_program_time (&parameters);
+	if (ROT_IS_ERROR (status)) {
+		goto exit;
+	}
+
+	flash->program_time = status;
 	status = 0;
 
 exit:
@@ -915,6 +1015,9 @@ int spi_flash_deep_power_down (struct spi_flash *flash, uint8_t enable)
 
 	platform_mutex_lock (&flash->lock);
 
+	/* The status register can't be trusted while the device is powered down. */
+	flash->wip_state = SPI_FLASH_WIP_UNKNOWN;
+
 	if (enable) {
 		status = spi_flash_simple_command (flash, flash->command.enter_pwrdown);
 	}
@@ -1415,9 +1518,8 @@ int spi_flash_read (struct spi_flash *flash, uint32_t address, uint8_t *data, si
 
 	platform_mutex_lock (&flash->lock);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_check_write_idle (flash);
 	if (status != 0) {
-		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
 	}
 
@@ -1473,6 +1575,10 @@ int spi_flash_minimum_write_per_page (struct spi_flash *flash, uint32_t *bytes)
 /**
  * Write data to the SPI flash.  The flash needs to be erased prior to writing.
  *
+ * Data is programmed one page at a time, waiting for each page to complete before starting the
+ * next.  When streaming writes are enabled, the device status will not be checked before the first
+ * page if the device is already known to be idle.
+ *
  * @param flash The flash to write to.
  * @param address The address to start writing to.
  * @param data The data to write.
@@ -1497,9 +1603,8 @@ int spi_flash_write (struct spi_flash *flash, uint32_t address, const uint8_t *d
 
 	platform_mutex_lock (&flash->lock);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_check_write_idle (flash);
 	if (status != 0) {
-		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
 	}
 
@@ -1524,7 +1629,9 @@ int spi_flash_write (struct spi_flash *flash, uint32_t address, const uint8_t *d
 
 		status = flash->spi->xfer (flash->spi, &xfer);
 		if (status == 0) {
-			status = spi_flash_wait_for_write_completion (flash, -1, 1);
+			flash->wip_state = SPI_FLASH_WIP_PROGRAM;
+
+			status = spi_flash_wait_for_page_program (flash, -1);
 			if (status == 0) {
 				remaining -= write_len;
 				data += write_len;
@@ -1551,6 +1658,120 @@ exit:
 	}
 }
 
+/**
+ * Enable or disable streaming writes to the SPI flash.  While streaming is enabled, the driver will
+ * track when the device is idle and skip reading the device status before reads and writes that
+ * don't need it.
+ *
+ * Streaming must only be enabled while no other SPI master is able to write to the flash device.
+ *
+ * @param flash The flash to configure.
+ * @param enable 1 to enable streaming writes or 0 to disable them.
+ *
+ * @return 0 if the streaming mode was configured successfully or an error code.
+ */
+int spi_flash_enable_stream_mode (struct spi_flash *flash, uint8_t enable)
+{
+	if (flash == NULL) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->lock);
+
+	flash->stream_mode = !!enable;
+	if (flash->wip_state == SPI_FLASH_WIP_IDLE) {
+		flash->wip_state = SPI_FLASH_WIP_UNKNOWN;
+	}
+
+	platform_mutex_unlock (&flash->lock);
+	return 0;
+}
+
+/**
+ * Start programming data to a single page of the SPI flash without waiting for the program to
+ * complete.  This allows the caller to prepare the next page of data while the current page is
+ * being programmed.  The page program must be completed with
+ * {@link spi_flash_program_page_complete} before any other flash operation is started.
+ *
+ * @param flash The flash to write to.
+ * @param address The address to start writing to.
+ * @param data The data to write.
+ * @param length The number of bytes to write.  Only the data that fits in the page containing the
+ * starting address will be programmed.
+ *
+ * @return The number of bytes being programmed or an error code.  Use ROT_IS_ERROR to check the
+ * return value.
+ */
+int spi_flash_program_page_submit (struct spi_flash *flash, uint32_t address, const uint8_t *data,
+	size_t length)
+{
+	struct flash_xfer xfer;
+	size_t write_len;
+	int status;
+
+	if ((flash == NULL) || (data == NULL) || (length == 0)) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	SPI_FLASH_BOUNDS_CHECK (flash->device_size, address, length);
+
+	write_len = (FLASH_PAGE_BASE (address) + FLASH_PAGE_SIZE) - address;
+	write_len = (length > write_len) ? write_len : length;
+
+	platform_mutex_lock (&flash->lock);
+
+	status = spi_flash_check_write_idle (flash);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = spi_flash_write_enable (flash);
+	if (status != 0) {
+		goto exit;
+	}
+
+	FLASH_XFER_INIT_WRITE (xfer, flash->command.write, address, 0, (uint8_t*) data, write_len,
+		flash->command.write_flags | flash->addr_mode);
+
+	status = flash->spi->xfer (flash->spi, &xfer);
+	if (status == 0) {
+		flash->wip_state = SPI_FLASH_WIP_PROGRAM;
+		status = write_len;
+	}
+
+exit:
+	platform_mutex_unlock (&flash->lock);
+	return status;
+}
+
+/**
+ * Wait for a page program started by {@link spi_flash_program_page_submit} to complete.
+ *
+ * @param flash The flash that is programming a page.
+ * @param timeout The maximum number of milliseconds to wait for completion.  A negative number will
+ * wait forever.  0 will check the device status once and return immediately.
+ *
+ * @return 0 if there is no page program in progress or an error code.  If the page program has
+ * not completed within the timeout, SPI_FLASH_WIP_TIMEOUT will be returned.
+ */
+int spi_flash_program_page_complete (struct spi_flash *flash, int32_t timeout)
+{
+	int status = 0;
+
+	if (flash == NULL) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->lock);
+
+	if (flash->wip_state == SPI_FLASH_WIP_PROGRAM) {
+		status = spi_flash_wait_for_page_program (flash, timeout);
+	}
+
+	platform_mutex_unlock (&flash->lock);
+	return status;
+}
+
 /**
  * Erase a region of flash.
  *
@@ -33,6 +33,15 @@ struct spi_flash_commands {
 	uint8_t release_pwrdown;			/**< The command to release deep powerdown. */
 };
 
+/**
+ * Write state of the flash device, as tracked by the driver.
+ */
+enum spi_flash_wip_state {
+	SPI_FLASH_WIP_UNKNOWN = 0,		/**< The write state is not known and must be read from the device. */
+	SPI_FLASH_WIP_IDLE,				/**< The device is known to not be executing a write. */
+	SPI_FLASH_WIP_PROGRAM,			/**< A page program has been started and not yet completed. */
+};
+
 /**
  * Interface to a single SPI flash.
  */
@@ -51,6 +60,9 @@ struct spi_flash {
 	bool reset_3byte;									/**< Flag to switch to 3-byte mode on reset. */
 	enum spi_flash_sfdp_quad_enable quad_enable;		/**< Method to enable QSPI. */
 	bool sr1_volatile;									/**< Flag to use volatile write enable for status register 1. */
+	bool stream_mode;									/**< Flag indicating streaming writes are enabled. */
+	enum spi_flash_wip_state wip_state;					/**< The tracked write state of the device. */
+	uint32_t program_time;								/**< Typical page program time, in microseconds. */
 };
 
 /**
@@ -122,6 +134,11 @@ int spi_flash_get_page_size (struct spi_flash *flash, uint32_t *bytes);
 int spi_flash_minimum_write_per_page (struct spi_flash *flash, uint32_t *bytes);
 int spi_flash_write (struct spi_flash *flash, uint32_t address, const uint8_t *data, size_t length);
 
+int spi_flash_enable_stream_mode (struct spi_flash *flash, uint8_t enable);
+int spi_flash_program_page_submit (struct spi_flash *flash, uint32_t address, const uint8_t *data,
+	size_t length);
+int spi_flash_program_page_complete (struct spi_flash *flash, int32_t timeout);
+
 int spi_flash_get_sector_size (struct spi_flash *flash, uint32_t *bytes);
 int spi_flash_sector_erase (struct spi_flash *flash, uint32_t sector_addr);
 
@@ -86,6 +86,8 @@ struct spi_flash_sfdp_basic_parameter_table_1_5 {
 	uint8_t page_size;				/**< 11th DWORD: Page size. */
 #define	SPI_FLASH_SFDP_PAGE_SIZE(x)			(((x) & 0xf0) >> 4)
 	uint16_t program_time;			/**< 11th DWORD: Page programming typical timing. */
+#define	SPI_FLASH_SFDP_PROGRAM_TIME_UNIT(x)	(((x) & (1U << 5)) ? 64 : 8)
+#define	SPI_FLASH_SFDP_PROGRAM_TIME_COUNT(x)	(((x) & 0x1f) + 1)
 	uint8_t chip_erase_time;		/**< 11th DWORD: Chip erase typical timing. */
 	uint32_t suspend_attr;			/**< 12th DWORD: Suspend/Resume attributes. */
 	uint8_t program_resume;			/**< 13th DWORD: Program Resume instruction. */
@@ -414,6 +416,31 @@ int spi_flash_sfdp_get_page_size (struct spi_flash_sfdp_basic_table *table)
 	return page;
 }
 
+/**
+ * Get the typical amount of time needed for the device to program a single page.
+ *
+ * @param table The basic parameters table that will be queried.
+ *
+ * @return The typical page program time, in microseconds, or an error code.  If the device does not
+ * report the program time, 0 will be returned.
+ */
+int spi_flash_sfdp_get_page_program_time (struct spi_flash_sfdp_basic_table *table)
+{
+	struct spi_flash_sfdp_basic_parameter_table_1_5 *params;
+
+	if (table == NULL) {
+		return SPI_FLASH_SFDP_INVALID_ARGUMENT;
+	}
+
+	if (table->sfdp->sfdp_header.parameter0.minor_revision < 5) {
+		return 0;
+	}
+
+	params = table->data;
+	return SPI_FLASH_SFDP_PROGRAM_TIME_UNIT (params->program_time) *
+		SPI_FLASH_SFDP_PROGRAM_TIME_COUNT (params->program_time);
+}
+
 /**
  * Parse read command information from the SFDP table.
  *
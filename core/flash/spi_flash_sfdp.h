@@ -112,6 +112,7 @@ int spi_flash_sfdp_get_device_capabilities (struct spi_flash_sfdp_basic_table *t
 	uint32_t *capabilities);
 int spi_flash_sfdp_get_device_size (struct spi_flash_sfdp_basic_table *table);
 int spi_flash_sfdp_get_page_size (struct spi_flash_sfdp_basic_table *table);
+int spi_flash_sfdp_get_page_program_time (struct spi_flash_sfdp_basic_table *table);
 
 int spi_flash_sfdp_get_read_commands (struct spi_flash_sfdp_basic_table *table,
 	struct spi_flash_sfdp_read_commands *read);
@@ -136,6 +136,7 @@ free_versions:
  * @param rsa The RSA engine to use for signature verification.
  * @param full_validation Flag to control level of flash validation.
  * @param flash The flash device to validate.
+ * @param pipeline Optional hash pipeline to use for reading the flash device.
  * @param writable Output for the read/write regions of the validated flash.  This will only be
  * valid if the flash is successfully validated.  This can be null if full_validation is false.
  *
@@ -143,10 +144,10 @@ free_versions:
  */
 int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash,
 	struct rsa_engine *rsa, bool full_validation, struct spi_flash *flash,
-	struct pfm_read_write_regions *writable)
+	struct flash_hash_pipeline *pipeline, struct pfm_read_write_regions *writable)
 {
-	return host_flash_manager_validate_offset_flash (pfm, hash, rsa, full_validation, flash, 0,
-		writable);
+	return host_flash_manager_validate_offset_flash (pfm, hash, rsa, full_validation, flash,
+		pipeline, 0, writable);
 }
 
 /**
@@ -157,6 +158,7 @@ int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash
  * @param rsa The RSA engine to use for signature verification.
  * @param full_validation Flag to control level of flash validation.
  * @param flash The flash device to validate.
+ * @param pipeline Optional hash pipeline to use for reading the flash device.
  * @param offset An offset in flash for images that will be validated.  Ignored if full_validation
  * is set.
  * @param writable Output for the read/write regions of the validated flash.  This will only be
@@ -165,8 +167,8 @@ int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash
  * @return 0 if the validation was successful or an error code.
  */
 int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engine *hash,
-	struct rsa_engine *rsa, bool full_validation, struct spi_flash *flash, uint32_t offset,
-	struct pfm_read_write_regions *writable)
+	struct rsa_engine *rsa, bool full_validation, struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t offset, struct pfm_read_write_regions *writable)
 {
 	struct pfm_firmware_versions versions;
 	const struct pfm_firmware_version *version;
@@ -180,11 +182,12 @@ int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engin
 	}
 
 	if (full_validation) {
-		status = host_fw_full_flash_verification (flash, &fw_images, writable, version->blank_byte,
-			hash, rsa);
+		status = host_fw_full_flash_verification (flash, pipeline, &fw_images, writable,
+			version->blank_byte, hash, rsa);
 	}
 	else {
-		status = host_fw_verify_offset_images (flash, &fw_images, offset, hash, rsa);
+		status = host_fw_verify_offset_images_batch (flash, pipeline, &fw_images, offset, &hash, 1,
+			rsa);
 	}
 
 	if ((status != 0) && writable) {
@@ -205,6 +208,7 @@ int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engin
  * @param hash The hash to use for image validation.
  * @param rsa The RSA engine to use for signature verification.
  * @param flash The flash device to validate.
+ * @param pipeline Optional hash pipeline to use for reading the flash device.
  * @param writable Output for the read/write regions of the validated flash.  This will only be
  * valid if the flash is successfully validated.  This can be null.
  *
@@ -212,7 +216,7 @@ int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engin
  */
 int host_flash_manager_validate_pfm (struct pfm *pfm, struct pfm *good_pfm,
 	struct hash_engine *hash, struct rsa_engine *rsa, struct spi_flash *flash,
-	struct pfm_read_write_regions *writable)
+	struct flash_hash_pipeline *pipeline, struct pfm_read_write_regions *writable)
 {
 	struct pfm_firmware_versions versions;
 	const struct pfm_firmware_version *version;
@@ -234,7 +238,7 @@ int host_flash_manager_validate_pfm (struct pfm *pfm, struct pfm *good_pfm,
 	}
 
 	if (status != 0) {
-		status = host_fw_verify_images (flash, &fw_images, hash, rsa);
+		status = host_fw_verify_images_batch (flash, pipeline, &fw_images, &hash, 1, rsa);
 	}
 
 	if ((status != 0) && writable) {
@@ -250,6 +254,7 @@ static int host_flash_manager_validate_read_only_flash (struct host_flash_manage
 	struct pfm *pfm, struct pfm *good_pfm, struct hash_engine *hash, struct rsa_engine *rsa,
 	bool full_validation, struct pfm_read_write_regions *writable)
 {
+	struct spi_flash *flash;
 	int status;
 
 	if ((manager == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
@@ -257,13 +262,15 @@ static int host_flash_manager_validate_read_only_flash (struct host_flash_manage
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
+	flash = host_flash_manager_get_read_only_flash (manager);
+
 	if (good_pfm && !full_validation) {
-		status = host_flash_manager_validate_pfm (pfm, good_pfm, hash, rsa,
-			host_flash_manager_get_read_only_flash (manager), writable);
+		status = host_flash_manager_validate_pfm (pfm, good_pfm, hash, rsa, flash,
+			host_flash_manager_get_hash_pipeline (manager, flash), writable);
 	}
 	else {
-		status = host_flash_manager_validate_flash (pfm, hash, rsa, full_validation,
-			host_flash_manager_get_read_only_flash (manager), writable);
+		status = host_flash_manager_validate_flash (pfm, hash, rsa, full_validation, flash,
+			host_flash_manager_get_hash_pipeline (manager, flash), writable);
 	}
 
 	return status;
@@ -273,13 +280,136 @@ static int host_flash_manager_validate_read_write_flash (struct host_flash_manag
 	struct pfm *pfm, struct hash_engine *hash, struct rsa_engine *rsa,
 	struct pfm_read_write_regions *writable)
 {
+	struct spi_flash *flash;
+
 	if ((manager == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
 		(writable == NULL)) {
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
-	return host_flash_manager_validate_flash (pfm, hash, rsa, true,
-		host_flash_manager_get_read_write_flash (manager), writable);
+	flash = host_flash_manager_get_read_write_flash (manager);
+
+	return host_flash_manager_validate_flash (pfm, hash, rsa, true, flash,
+		host_flash_manager_get_hash_pipeline (manager, flash), writable);
+}
+
+static int host_flash_manager_validate_read_write_flash_incremental (
+	struct host_flash_manager *manager, struct pfm *pfm, struct hash_engine *hash,
+	struct rsa_engine *rsa, const struct host_fw_dirty_map *dirty,
+	struct host_fw_image_digests *digests, struct pfm_read_write_regions *writable)
+{
+	struct pfm_firmware_versions versions;
+	const struct pfm_firmware_version *version;
+	struct pfm_image_list fw_images;
+	struct spi_flash *flash;
+	int index;
+	int status;
+
+	if ((manager == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
+		(digests == NULL) || (writable == NULL)) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	flash = host_flash_manager_get_read_write_flash (manager);
+
+	status = host_flash_manager_get_image_entry (pfm, flash, 0, &versions, &version, &fw_images,
+		writable);
+	if (status != 0) {
+		digests->valid = false;
+		return status;
+	}
+
+	index = version - versions.versions;
+
+	if ((digests->digest == NULL) || (fw_images.count > digests->max_images)) {
+		digests->valid = false;
+		status = host_fw_full_flash_verification (flash,
+			host_flash_manager_get_hash_pipeline (manager, flash), &fw_images, writable,
+			version->blank_byte, hash, rsa);
+	}
+	else {
+		if (!digests->valid || (digests->version != index) ||
+			(digests->count != fw_images.count)) {
+			dirty = NULL;
+		}
+
+		digests->valid = false;
+		status = host_fw_full_flash_verification_incremental (flash, &fw_images, writable,
+			version->blank_byte, dirty, digests->digest, hash, rsa);
+		if (status == 0) {
+			digests->count = fw_images.count;
+			digests->version = index;
+			digests->valid = true;
+		}
+	}
+
+	if (status != 0) {
+		pfm->free_read_write_regions (pfm, writable);
+	}
+
+	pfm->free_firmware_images (pfm, &fw_images);
+	pfm->free_fw_versions (pfm, &versions);
+	return status;
+}
+
+static int host_flash_manager_validate_read_only_flash_cached (struct host_flash_manager *manager,
+	struct pfm *pfm, struct pfm *good_pfm, struct hash_engine *hash, struct rsa_engine *rsa,
+	struct host_fw_verification_cache *cache, bool use_cache,
+	struct pfm_read_write_regions *writable)
+{
+	struct pfm_firmware_versions versions;
+	const struct pfm_firmware_version *version;
+	struct pfm_image_list fw_images;
+	struct pfm_image_list fw_images_good;
+	struct spi_flash *flash;
+	uint32_t pfm_id;
+	int status;
+
+	if ((manager == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
+		(cache == NULL) || (writable == NULL)) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	status = pfm->base.get_id (&pfm->base, &pfm_id);
+	if (status != 0) {
+		return status;
+	}
+
+	flash = host_flash_manager_get_read_only_flash (manager);
+
+	status = host_flash_manager_get_image_entry (pfm, flash, 0, &versions, &version, &fw_images,
+		writable);
+	if (status != 0) {
+		return status;
+	}
+
+	if (good_pfm) {
+		status = good_pfm->get_firmware_images (good_pfm, version->fw_version_id,
+			&fw_images_good);
+		if (status == 0) {
+			status = host_fw_are_images_different (&fw_images, &fw_images_good);
+
+			good_pfm->free_firmware_images (good_pfm, &fw_images_good);
+		}
+	}
+
+	if (!good_pfm || (status != 0)) {
+		status = host_fw_verify_images_cached (flash, &fw_images, cache,
+			host_state_manager_get_read_only_flash (manager->host_state), pfm_id, use_cache, hash,
+			rsa);
+		if (status == 0) {
+			/* Failing to save the cache only affects the next verification, not this one. */
+			host_fw_verification_cache_store (cache);
+		}
+	}
+
+	if (status != 0) {
+		pfm->free_read_write_regions (pfm, writable);
+	}
+
+	pfm->free_firmware_images (pfm, &fw_images);
+	pfm->free_fw_versions (pfm, &versions);
+	return status;
 }
 
 static int host_flash_manager_get_flash_read_write_regions (struct host_flash_manager *manager,
@@ -379,12 +509,12 @@ static int host_flash_manager_migrate_rw_data (struct host_flash_manager *manage
 	int status;
 
 	if (from == SPI_FILTER_CS_0) {
-		status = host_fw_migrate_read_write_data (manager->flash_cs1, writable,
-			manager->flash_cs0, NULL);
+		status = host_fw_migrate_read_write_data (manager->flash_cs1, manager->stream_cs1,
+			writable, manager->flash_cs0, NULL);
 	}
 	else {
-		status = host_fw_migrate_read_write_data (manager->flash_cs0, writable,
-			manager->flash_cs1, NULL);
+		status = host_fw_migrate_read_write_data (manager->flash_cs0, manager->stream_cs0,
+			writable, manager->flash_cs1, NULL);
 	}
 
 	return status;
@@ -658,6 +788,9 @@ int host_flash_manager_init (struct host_flash_manager *manager, struct spi_flas
 	manager->get_read_write_flash = host_flash_manager_get_read_write_flash;
 	manager->validate_read_only_flash = host_flash_manager_validate_read_only_flash;
 	manager->validate_read_write_flash = host_flash_manager_validate_read_write_flash;
+	manager->validate_read_write_flash_incremental =
+		host_flash_manager_validate_read_write_flash_incremental;
+	manager->validate_read_only_flash_cached = host_flash_manager_validate_read_only_flash_cached;
 	manager->get_flash_read_write_regions = host_flash_manager_get_flash_read_write_regions;
 	manager->config_spi_filter_flash_type = host_flash_manager_config_spi_filter_flash_type;
 	manager->config_spi_filter_flash_devices = host_flash_manager_config_spi_filter_flash_devices;
@@ -721,3 +854,110 @@ void host_flash_manager_release (struct host_flash_manager *manager)
 {
 
 }
+
+/**
+ * Provide copy streams to use when writing data to the host flash devices.  Without copy streams,
+ * data is copied to the flash devices one page at a time.
+ *
+ * @param manager The flash manager to update.
+ * @param cs0 The copy stream for the CS0 flash device.  Set to null to not use a copy stream.
+ * @param cs1 The copy stream for the CS1 flash device.  Set to null to not use a copy stream.
+ *
+ * @return 0 if the copy streams were set or an error code.
+ */
+int host_flash_manager_set_copy_streams (struct host_flash_manager *manager,
+	struct flash_copy_stream *cs0, struct flash_copy_stream *cs1)
+{
+	if (manager == NULL) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	if ((cs0 && (cs0->flash != &manager->flash_cs0->base)) ||
+		(cs1 && (cs1->flash != &manager->flash_cs1->base))) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	manager->stream_cs0 = cs0;
+	manager->stream_cs1 = cs1;
+
+	return 0;
+}
+
+/**
+ * Get the copy stream to use when writing data to a host flash device.
+ *
+ * @param manager The flash manager to query.
+ * @param flash The flash device that will be written.
+ *
+ * @return The copy stream for the flash device or null if there is no copy stream for the device.
+ */
+struct flash_copy_stream* host_flash_manager_get_copy_stream (struct host_flash_manager *manager,
+	struct spi_flash *flash)
+{
+	if ((manager == NULL) || (flash == NULL)) {
+		return NULL;
+	}
+
+	if (flash == manager->flash_cs0) {
+		return manager->stream_cs0;
+	}
+	else if (flash == manager->flash_cs1) {
+		return manager->stream_cs1;
+	}
+
+	return NULL;
+}
+
+/**
+ * Provide hash pipelines to use when verifying the contents of the host flash devices.  Without
+ * hash pipelines, flash contents are read for verification in small blocks.
+ *
+ * @param manager The flash manager to update.
+ * @param cs0 The hash pipeline for the CS0 flash device.  Set to null to not use a hash pipeline.
+ * @param cs1 The hash pipeline for the CS1 flash device.  Set to null to not use a hash pipeline.
+ *
+ * @return 0 if the hash pipelines were set or an error code.
+ */
+int host_flash_manager_set_hash_pipelines (struct host_flash_manager *manager,
+	struct flash_hash_pipeline *cs0, struct flash_hash_pipeline *cs1)
+{
+	if (manager == NULL) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	if ((cs0 && (cs0->flash != &manager->flash_cs0->base)) ||
+		(cs1 && (cs1->flash != &manager->flash_cs1->base))) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	manager->hash_cs0 = cs0;
+	manager->hash_cs1 = cs1;
+
+	return 0;
+}
+
+/**
+ * Get the hash pipeline to use when verifying the contents of a host flash device.
+ *
+ * @param manager The flash manager to query.
+ * @param flash The flash device that will be verified.
+ *
+ * @return The hash pipeline for the flash device or null if there is no hash pipeline for the
+ * device.
+ */
+struct flash_hash_pipeline* host_flash_manager_get_hash_pipeline (
+	struct host_flash_manager *manager, struct spi_flash *flash)
+{
+	if ((manager == NULL) || (flash == NULL)) {
+		return NULL;
+	}
+
+	if (flash == manager->flash_cs0) {
+		return manager->hash_cs0;
+	}
+	else if (flash == manager->flash_cs1) {
+		return manager->hash_cs1;
+	}
+
+	return NULL;
+}
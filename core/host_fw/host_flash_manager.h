@@ -8,6 +8,7 @@
 #include "status/rot_status.h"
 #include "host_control.h"
 #include "host_flash_initialization.h"
+#include "host_fw_util.h"
 #include "state_manager/state_manager.h"
 #include "flash/spi_flash.h"
 #include "spi_filter/spi_filter_interface.h"
@@ -82,6 +83,59 @@ struct host_flash_manager {
 	int (*validate_read_write_flash) (struct host_flash_manager *manager, struct pfm *pfm,
 		struct hash_engine *hash, struct rsa_engine *rsa, struct pfm_read_write_regions *writable);
 
+	/**
+	 * Validate the read/write flash device using image digests from a previous validation of the
+	 * same flash.  Only images that contain modified flash blocks will be hashed, and only the
+	 * modified blocks of unused flash will be checked.  If the stored digests don't apply to the
+	 * firmware version on flash, a full validation is run.
+	 *
+	 * @param manager The flash manager to use for validation.
+	 * @param pfm The PFM to validate the read/write flash against.  This must be the same PFM that
+	 * was used to calculate the stored digests.
+	 * @param hash The hash engine to use for validation.
+	 * @param rsa The RSA engine to use for signature verification.
+	 * @param dirty The map of flash blocks that have been modified since the stored digests were
+	 * calculated.  Set this to null to run a full validation.
+	 * @param digests The image digests for the read/write flash.  These will be updated with the
+	 * digests of the validated images and will be invalidated if the validation fails.
+	 * @param writable Output that will contain the list of read/write regions for the PFM entry
+	 * that validated the flash.  This will be uninitialized if the validation failed.  On
+	 * successful return, this structure must be freed through the PFM instance by the caller.
+	 *
+	 * @return 0 if the read/write flash was successfully validated or an error code.  Blank check
+	 * failures will be reported with FLASH_UTIL_UNEXPECTED_VALUE.
+	 */
+	int (*validate_read_write_flash_incremental) (struct host_flash_manager *manager,
+		struct pfm *pfm, struct hash_engine *hash, struct rsa_engine *rsa,
+		const struct host_fw_dirty_map *dirty, struct host_fw_image_digests *digests,
+		struct pfm_read_write_regions *writable);
+
+	/**
+	 * Validate the read-only flash device using a persistent cache of verified image digests.  Each
+	 * image that is hashed will be saved in the cache, and the cache will be stored in flash after
+	 * a successful validation.
+	 *
+	 * @param manager The flash manager to use for validation.
+	 * @param pfm The PFM to validate the read-only flash against.
+	 * @param good_pfm An optional PFM that is known to be good for the read-only flash.  If the
+	 * images defined in both PFMs are the same, no images will be verified.  Set this to null to
+	 * always verify the images.
+	 * @param hash The hash engine to use for validation.
+	 * @param rsa The RSA engine to use for signature verification.
+	 * @param cache The cache of verified image digests.
+	 * @param use_cache Flag indicating that the read-only flash is known to be unmodified since the
+	 * cached digests were calculated, so images with a cached digest do not need to be hashed.
+	 * @param writable Output that will contain the list of read/write regions for the PFM entry
+	 * that validated the flash.  This will be uninitialized if the validation failed.  On
+	 * successful return, this structure must be freed through the PFM instance by the caller.
+	 *
+	 * @return 0 if the read-only flash was successfully validated or an error code.
+	 */
+	int (*validate_read_only_flash_cached) (struct host_flash_manager *manager, struct pfm *pfm,
+		struct pfm *good_pfm, struct hash_engine *hash, struct rsa_engine *rsa,
+		struct host_fw_verification_cache *cache, bool use_cache,
+		struct pfm_read_write_regions *writable);
+
 	/**
 	 * Get the read/write regions defined in a PFM for the firmware on flash.  No validation of the
 	 * flash will be performed other than what is necessary to determine the appropriate read/write
@@ -191,6 +245,10 @@ struct host_flash_manager {
 	struct spi_filter_interface *filter;			/**< The SPI filter connected to the flash devices. */
 	struct flash_mfg_filter_handler *mfg_handler;	/**< The filter handler for flash device types. */
 	struct host_flash_initialization *flash_init;	/**< Host flash initialization manager. */
+	struct flash_copy_stream *stream_cs0;			/**< Optional copy stream for the CS0 flash device. */
+	struct flash_copy_stream *stream_cs1;			/**< Optional copy stream for the CS1 flash device. */
+	struct flash_hash_pipeline *hash_cs0;			/**< Optional hash pipeline for the CS0 flash device. */
+	struct flash_hash_pipeline *hash_cs1;			/**< Optional hash pipeline for the CS1 flash device. */
 };
 
 
@@ -203,16 +261,25 @@ int host_flash_manager_init_with_managed_flash_initialization (struct host_flash
 	struct host_flash_initialization *flash_init);
 void host_flash_manager_release (struct host_flash_manager *manager);
 
+int host_flash_manager_set_copy_streams (struct host_flash_manager *manager,
+	struct flash_copy_stream *cs0, struct flash_copy_stream *cs1);
+struct flash_copy_stream* host_flash_manager_get_copy_stream (struct host_flash_manager *manager,
+	struct spi_flash *flash);
+int host_flash_manager_set_hash_pipelines (struct host_flash_manager *manager,
+	struct flash_hash_pipeline *cs0, struct flash_hash_pipeline *cs1);
+struct flash_hash_pipeline* host_flash_manager_get_hash_pipeline (
+	struct host_flash_manager *manager, struct spi_flash *flash);
+
 /* Internal functions for use by derived types. */
 int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash,
 	struct rsa_engine *rsa, bool full_validation, struct spi_flash *flash,
-	struct pfm_read_write_regions *writable);
+	struct flash_hash_pipeline *pipeline, struct pfm_read_write_regions *writable);
 int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engine *hash,
-	struct rsa_engine *rsa, bool full_validation, struct spi_flash *flash, uint32_t offset,
-	struct pfm_read_write_regions *writable);
+	struct rsa_engine *rsa, bool full_validation, struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t offset, struct pfm_read_write_regions *writable);
 int host_flash_manager_validate_pfm (struct pfm *pfm, struct pfm *good_pfm,
 	struct hash_engine *hash, struct rsa_engine *rsa, struct spi_flash *flash,
-	struct pfm_read_write_regions *writable);
+	struct flash_hash_pipeline *pipeline, struct pfm_read_write_regions *writable);
 
 int host_flash_manager_configure_flash_for_rot_access (struct spi_flash *flash);
 
@@ -7,6 +7,7 @@
 #include "platform.h"
 #include "host_fw_util.h"
 #include "flash/flash_util.h"
+#include "flash/flash_compare.h"
 
 
 /**
@@ -291,141 +292,1172 @@ bool host_fw_are_images_different (const struct pfm_image_list *img_list1,
  * Verify that images on the flash are valid.  Only images flagged for validation will be checked.
  *
  * @param flash The flash that contains the images to validate.
+ * @param pipeline Optional hash pipeline to use for reading the flash.  If this is null, flash data
+ * will be read in small blocks.
  * @param img_list The list of images to validate.
  * @param hash The hashing engine to use for validation.
  * @param rsa The RSA engine to use for signature checking.
  *
  * @return 0 if all images that should be validated are good or an error code.
  */
-int host_fw_verify_images (struct spi_flash *flash, const struct pfm_image_list *img_list,
-	struct hash_engine *hash, struct rsa_engine *rsa)
+int host_fw_verify_images (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, struct hash_engine *hash, struct rsa_engine *rsa)
+{
+	return host_fw_verify_offset_images (flash, pipeline, img_list, 0, hash, rsa);
+}
+
+/**
+ * Check that a hash pipeline can be used to read a flash device.
+ *
+ * @param flash The flash device that will be read.
+ * @param pipeline The hash pipeline to check.  Null is always valid.
+ *
+ * @return true if the pipeline can be used with the flash or false if not.
+ */
+static bool host_fw_is_pipeline_valid (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline)
+{
+	return ((pipeline == NULL) || (pipeline->flash == &flash->base));
+}
+
+/**
+ * Read a contiguous block of data from flash and pass it to a handler for processing.
+ *
+ * @param flash The flash to read.
+ * @param pipeline Optional hash pipeline to use for reading the flash.  If this is null, the data
+ * will be read into the provided buffer one block at a time.
+ * @param addr The first address to read.
+ * @param length The number of bytes to read.
+ * @param data Buffer to use for reading flash when there is no pipeline.
+ * @param data_len The size of the read buffer.
+ * @param handler The handler to call for each block of data read from flash.
+ * @param context Context to pass to the data handler.
+ *
+ * @return 0 if all data was processed successfully or an error code.
+ */
+static int host_fw_process_flash_contents (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t addr, size_t length, uint8_t *data,
+	size_t data_len, flash_hash_pipeline_data_handler handler, void *context)
+{
+	size_t read_len;
+	int status;
+
+	if (pipeline) {
+		return flash_hash_pipeline_process_contents (pipeline, addr, length, handler, context);
+	}
+
+	while (length) {
+		read_len = (length > data_len) ? data_len : length;
+
+		status = spi_flash_read (flash, addr, data, read_len);
+		if (status != 0) {
+			return status;
+		}
+
+		status = handler (context, data, read_len);
+		if (status != 0) {
+			return status;
+		}
+
+		addr += read_len;
+		length -= read_len;
+	}
+
+	return 0;
+}
+
+/**
+ * Verify that images on the flash are valid.  Only images flagged for validation will be checked.
+ *
+ * All image addresses specified in the PFM will be offset by a fixed amount.
+ *
+ * @param flash The flash that contains the images to validate.
+ * @param pipeline Optional hash pipeline to use for reading the flash.  If this is null, flash data
+ * will be read in small blocks.
+ * @param img_list The list of images to validate.
+ * @param offset The offset to apply to image addresses.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ *
+ * @return 0 if all images that should be validated are good or an error code.
+ */
+int host_fw_verify_offset_images (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, uint32_t offset, struct hash_engine *hash,
+	struct rsa_engine *rsa)
+{
+	int i;
+	int status = 0;
+
+	if ((flash == NULL) || (img_list == NULL) || (hash == NULL) || (rsa == NULL) ||
+		!host_fw_is_pipeline_valid (flash, pipeline)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < img_list->count; i++) {
+		if (img_list->images[i].always_validate) {
+			if (pipeline) {
+				status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (pipeline,
+					offset, img_list->images[i].regions, img_list->images[i].count, hash,
+					HASH_TYPE_SHA256, rsa, img_list->images[i].signature,
+					img_list->images[i].sig_length, &img_list->images[i].key, NULL, 0);
+			}
+			else {
+				status = flash_verify_noncontiguous_contents_at_offset (&flash->base, offset,
+					img_list->images[i].regions, img_list->images[i].count, hash,
+					HASH_TYPE_SHA256, rsa, img_list->images[i].signature,
+					img_list->images[i].sig_length, &img_list->images[i].key, NULL, 0);
+			}
+			if (status != 0) {
+				return status;
+			}
+		}
+	}
+
+	return status;
+}
+
+/**
+ * A single image region scheduled for hashing during a batched image verification.
+ */
+struct host_fw_batch_region {
+	const struct flash_region *region;	/**< The image region to hash. */
+	size_t image;						/**< Index of the image that contains the region. */
+	bool first;							/**< Flag indicating the first region of the image. */
+	bool last;							/**< Flag indicating the last region of the image. */
+};
+
+/**
+ * Hashing state for a single image during a batched image verification.
+ */
+struct host_fw_batch_image {
+	struct hash_engine *hash;			/**< The hash engine currently assigned to the image. */
+	uint8_t digest[SHA256_HASH_LENGTH];	/**< The calculated image digest. */
+};
+
+/**
+ * Build the list of image regions that need to be hashed for a batched verification, sorted by
+ * flash address.
+ *
+ * A batched verification is only possible if the regions of each image are in ascending address
+ * order and no regions overlap, either within an image or across images.  Otherwise, data would
+ * need to be read from flash more than once or out of order.
+ *
+ * @param img_list The list of images to verify.
+ * @param all_images Flag indicating if all images should be included in the list.  If this is not
+ * set, only images flagged for validation will be included.
+ * @param sorted Output for the sorted list of image regions.  This must be large enough to hold
+ * every region of every image.
+ * @param count Output for the number of regions in the sorted list.
+ * @param max_active Output for the maximum number of images that will be hashed concurrently.
+ *
+ * @return true if the images can be verified in a single batch or false if not.
+ */
+static bool host_fw_batch_build_region_list (const struct pfm_image_list *img_list,
+	bool all_images, struct host_fw_batch_region *sorted, size_t *count, size_t *max_active)
+{
+	const struct pfm_image_signature *image;
+	struct host_fw_batch_region entry;
+	size_t active = 0;
+	size_t first;
+	size_t i;
+	size_t j;
+
+	*count = 0;
+	*max_active = 0;
+
+	for (i = 0; i < img_list->count; i++) {
+		image = &img_list->images[i];
+		if (!all_images && !image->always_validate) {
+			continue;
+		}
+
+		if ((image->regions == NULL) || (image->count == 0) || (image->sig_length == 0)) {
+			return false;
+		}
+
+		first = *count;
+		for (j = 0; j < image->count; j++) {
+			if ((j != 0) && (image->regions[j].start_addr <
+				(image->regions[j - 1].start_addr + image->regions[j - 1].length))) {
+				return false;
+			}
+
+			if (image->regions[j].length != 0) {
+				sorted[*count].region = &image->regions[j];
+				sorted[*count].image = i;
+				sorted[*count].first = (*count == first);
+				sorted[*count].last = false;
+				(*count)++;
+			}
+		}
+
+		if (*count == first) {
+			return false;
+		}
+
+		sorted[*count - 1].last = true;
+	}
+
+	for (i = 1; i < *count; i++) {
+		entry = sorted[i];
+		j = i;
+		while ((j > 0) && (sorted[j - 1].region->start_addr > entry.region->start_addr)) {
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+		sorted[j] = entry;
+	}
+
+	for (i = 0; i < *count; i++) {
+		if ((i != 0) && (sorted[i].region->start_addr <
+			(sorted[i - 1].region->start_addr + sorted[i - 1].region->length))) {
+			return false;
+		}
+
+		if (sorted[i].first) {
+			active++;
+			if (active > *max_active) {
+				*max_active = active;
+			}
+		}
+		if (sorted[i].last) {
+			active--;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Add data from an image region to the hash for the image.  A hash engine will be assigned to the
+ * image when the first data for the image is provided, and the final digest will be calculated
+ * once all image data has been hashed.
+ *
+ * @param region The image region that contains the data.
+ * @param offset The offset of the data within the region.
+ * @param data The data to add to the hash.
+ * @param length The amount of data to add.
+ * @param images The hashing state for each image.
+ * @param idle The list of hash engines available for use.
+ * @param idle_count The number of hash engines in the list.  This will be updated as hash engines
+ * are assigned to and released from the image.
+ *
+ * @return 0 if the data was added to the image hash or an error code.
+ */
+static int host_fw_batch_hash_region_data (const struct host_fw_batch_region *region,
+	size_t offset, const uint8_t *data, size_t length, struct host_fw_batch_image *images,
+	struct hash_engine **idle, size_t *idle_count)
+{
+	struct host_fw_batch_image *image = &images[region->image];
+	struct hash_engine *engine;
+	int status;
+
+	if (region->first && (offset == 0)) {
+		engine = idle[--(*idle_count)];
+		status = engine->start_sha256 (engine);
+		if (status != 0) {
+			return status;
+		}
+
+		image->hash = engine;
+	}
+
+	status = image->hash->update (image->hash, data, length);
+	if (status != 0) {
+		return status;
+	}
+
+	if (region->last && ((offset + length) == region->region->length)) {
+		status = image->hash->finish (image->hash, image->digest, sizeof (image->digest));
+		if (status != 0) {
+			return status;
+		}
+
+		idle[(*idle_count)++] = image->hash;
+		image->hash = NULL;
+	}
+
+	return 0;
+}
+
+/**
+ * Hashing context for routing flash data to image hashes during a batched image verification.
+ */
+struct host_fw_batch_context {
+	const struct host_fw_batch_region *sorted;	/**< The list of image regions, sorted by address. */
+	size_t index;								/**< The region that will receive the next data. */
+	size_t region_pos;							/**< Offset of the next data within the region. */
+	struct host_fw_batch_image *images;			/**< The hashing state for each image. */
+	struct hash_engine **idle;					/**< The list of hash engines available for use. */
+	size_t idle_count;							/**< The number of hash engines in the list. */
+};
+
+/**
+ * Route a block of contiguous image data to the hash for each image that contains the data.
+ *
+ * @param context The batch hashing context.
+ * @param data The image data read from flash.
+ * @param length The amount of image data.
+ *
+ * @return 0 if the data was added to the image hashes or an error code.
+ */
+static int host_fw_batch_hash_data (void *context, const uint8_t *data, size_t length)
+{
+	struct host_fw_batch_context *batch = (struct host_fw_batch_context*) context;
+	const struct host_fw_batch_region *region;
+	size_t chunk;
+	size_t pos = 0;
+	int status;
+
+	while (pos < length) {
+		region = &batch->sorted[batch->index];
+
+		chunk = region->region->length - batch->region_pos;
+		if (chunk > (length - pos)) {
+			chunk = length - pos;
+		}
+
+		status = host_fw_batch_hash_region_data (region, batch->region_pos, &data[pos], chunk,
+			batch->images, batch->idle, &batch->idle_count);
+		if (status != 0) {
+			return status;
+		}
+
+		pos += chunk;
+		batch->region_pos += chunk;
+
+		if (batch->region_pos == region->region->length) {
+			batch->region_pos = 0;
+			batch->index++;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Hash all images in a single linear pass over flash.  Contiguous regions are read from flash
+ * together, even if they belong to different images, and the data is routed to the hash engine
+ * assigned to each image.
+ *
+ * @param flash The flash that contains the images.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param offset The offset to apply to image addresses.
+ * @param sorted The list of image regions, sorted by address.
+ * @param count The number of regions in the list.
+ * @param images The hashing state for each image.
+ * @param idle The list of hash engines available for use.
+ * @param idle_count The number of hash engines in the list.  There must be enough to hash all
+ * concurrently active images.
+ *
+ * @return 0 if all images were hashed successfully or an error code.  On error, some images may
+ * have active hash engines assigned to them.
+ */
+static int host_fw_batch_hash_images (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t offset, const struct host_fw_batch_region *sorted,
+	size_t count, struct host_fw_batch_image *images, struct hash_engine **idle, size_t idle_count)
+{
+	uint8_t data[FLASH_VERIFICATION_BLOCK];
+	struct host_fw_batch_context batch;
+	uint32_t addr;
+	size_t end;
+	int status;
+
+	batch.sorted = sorted;
+	batch.index = 0;
+	batch.region_pos = 0;
+	batch.images = images;
+	batch.idle = idle;
+	batch.idle_count = idle_count;
+
+	while (batch.index < count) {
+		end = batch.index + 1;
+		while ((end < count) && (sorted[end].region->start_addr ==
+			(sorted[end - 1].region->start_addr + sorted[end - 1].region->length))) {
+			end++;
+		}
+
+		addr = sorted[batch.index].region->start_addr;
+
+		status = host_fw_process_flash_contents (flash, pipeline, addr + offset,
+			(sorted[end - 1].region->start_addr + sorted[end - 1].region->length) - addr, data,
+			sizeof (data), host_fw_batch_hash_data, &batch);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Verify that images on the flash are valid.  Only images flagged for validation will be checked.
+ *
+ * Unlike host_fw_verify_images, all images are hashed during a single pass over the flash, with
+ * multiple hash engines used to hash interleaved images concurrently.
+ *
+ * @param flash The flash that contains the images to validate.
+ * @param pipeline Optional hash pipeline to use for reading the flash.  If this is null, flash data
+ * will be read in small blocks.
+ * @param img_list The list of images to validate.
+ * @param hash The list of hashing engines to use for validation.
+ * @param hash_count The number of hashing engines in the list.
+ * @param rsa The RSA engine to use for signature checking.
+ *
+ * @return 0 if all images that should be validated are good or an error code.
+ */
+int host_fw_verify_images_batch (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, struct hash_engine **hash, size_t hash_count,
+	struct rsa_engine *rsa)
+{
+	return host_fw_verify_offset_images_batch (flash, pipeline, img_list, 0, hash, hash_count,
+		rsa);
+}
+
+/**
+ * Verify that images on the flash are valid.  Only images flagged for validation will be checked.
+ *
+ * Unlike host_fw_verify_offset_images, all images are hashed during a single pass over the flash,
+ * with multiple hash engines used to hash interleaved images concurrently.  If the image regions
+ * can't be processed in a single pass, either because regions overlap or there are not enough hash
+ * engines, the images will be verified one at a time using the first hash engine.
+ *
+ * All image addresses specified in the PFM will be offset by a fixed amount.
+ *
+ * @param flash The flash that contains the images to validate.
+ * @param pipeline Optional hash pipeline to use for reading the flash.  If this is null, flash data
+ * will be read in small blocks.
+ * @param img_list The list of images to validate.
+ * @param offset The offset to apply to image addresses.
+ * @param hash The list of hashing engines to use for validation.
+ * @param hash_count The number of hashing engines in the list.
+ * @param rsa The RSA engine to use for signature checking.
+ *
+ * @return 0 if all images that should be validated are good or an error code.
+ */
+int host_fw_verify_offset_images_batch (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, const struct pfm_image_list *img_list, uint32_t offset,
+	struct hash_engine **hash, size_t hash_count, struct rsa_engine *rsa)
+{
+	struct host_fw_batch_region *sorted = NULL;
+	struct host_fw_batch_image *images = NULL;
+	struct hash_engine **idle = NULL;
+	size_t total = 0;
+	size_t count;
+	size_t max_active;
+	size_t i;
+	int status;
+
+	if ((flash == NULL) || (img_list == NULL) || (hash == NULL) || (hash_count == 0) ||
+		(rsa == NULL) || !host_fw_is_pipeline_valid (flash, pipeline)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < hash_count; i++) {
+		if (hash[i] == NULL) {
+			return HOST_FW_UTIL_INVALID_ARGUMENT;
+		}
+	}
+
+	for (i = 0; i < img_list->count; i++) {
+		if (img_list->images[i].always_validate) {
+			total += img_list->images[i].count;
+		}
+	}
+
+	if (total == 0) {
+		return host_fw_verify_offset_images (flash, pipeline, img_list, offset, hash[0], rsa);
+	}
+
+	sorted = platform_malloc (sizeof (struct host_fw_batch_region) * total);
+	images = platform_calloc (img_list->count, sizeof (struct host_fw_batch_image));
+	idle = platform_malloc (sizeof (struct hash_engine*) * hash_count);
+	if ((sorted == NULL) || (images == NULL) || (idle == NULL)) {
+		status = HOST_FW_UTIL_NO_MEMORY;
+		goto exit;
+	}
+
+	if (!host_fw_batch_build_region_list (img_list, false, sorted, &count, &max_active) ||
+		(max_active > hash_count)) {
+		status = host_fw_verify_offset_images (flash, pipeline, img_list, offset, hash[0], rsa);
+		goto exit;
+	}
+
+	memcpy (idle, hash, sizeof (struct hash_engine*) * hash_count);
+
+	status = host_fw_batch_hash_images (flash, pipeline, offset, sorted, count, images, idle,
+		hash_count);
+	if (status != 0) {
+		for (i = 0; i < img_list->count; i++) {
+			if (images[i].hash) {
+				images[i].hash->cancel (images[i].hash);
+			}
+		}
+
+		goto exit;
+	}
+
+	for (i = 0; i < img_list->count; i++) {
+		if (img_list->images[i].always_validate) {
+			status = rsa->sig_verify (rsa, &img_list->images[i].key, img_list->images[i].signature,
+				img_list->images[i].sig_length, images[i].digest, SHA256_HASH_LENGTH);
+			if (status != 0) {
+				goto exit;
+			}
+		}
+	}
+
+exit:
+	platform_free (sorted);
+	platform_free (images);
+	platform_free (idle);
+	return status;
+}
+
+/**
+ * Find the next read/write region defined in the flash.
+ *
+ * @param last_addr The flash address to start looking for the next region.
+ * @param writable The list of read/write regions in flash.
+ *
+ * @return The region description for the next defined read/write region or null if there are no
+ * more defined regions.
+ */
+static const struct flash_region* host_fw_find_next_rw_region (uint32_t last_addr,
+	const struct pfm_read_write_regions *writable)
+{
+	return host_fw_find_next_region (last_addr, writable->regions, writable->count);
+}
+
+/**
+ * Sort a list of flash regions by starting address.  Regions that start at the same address will
+ * retain their relative order in the list.
+ *
+ * @param regions The list of regions to sort.
+ * @param count The number of regions in the list.
+ */
+static void host_fw_sort_regions (const struct flash_region **regions, size_t count)
+{
+	const struct flash_region *entry;
+	size_t i;
+	size_t j;
+
+	for (i = 1; i < count; i++) {
+		entry = regions[i];
+		j = i;
+		while ((j > 0) && (regions[j - 1]->start_addr > entry->start_addr)) {
+			regions[j] = regions[j - 1];
+			j--;
+		}
+		regions[j] = entry;
+	}
+}
+
+/**
+ * Build a map of the used regions of flash, sorted by starting address.  For regions that start at
+ * the same address, image regions will be ordered before read/write regions.
+ *
+ * @param img_list The list of images in the flash.
+ * @param writable The list of read/write regions in the flash.
+ * @param map Output for the sorted list of used regions.  This must be freed by the caller.
+ * @param count Output for the number of regions in the map.
+ *
+ * @return 0 if the region map was created successfully or an error code.
+ */
+static int host_fw_build_flash_region_map (const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable, const struct flash_region ***map, size_t *count)
+{
+	size_t total = writable->count;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < img_list->count; i++) {
+		total += img_list->images[i].count;
+	}
+
+	*map = platform_malloc (sizeof (struct flash_region*) * ((total != 0) ? total : 1));
+	if (*map == NULL) {
+		return HOST_FW_UTIL_NO_MEMORY;
+	}
+
+	*count = 0;
+	for (i = 0; i < img_list->count; i++) {
+		for (j = 0; j < img_list->images[i].count; j++) {
+			(*map)[(*count)++] = &img_list->images[i].regions[j];
+		}
+	}
+
+	for (i = 0; i < writable->count; i++) {
+		(*map)[(*count)++] = &writable->regions[i];
+	}
+
+	host_fw_sort_regions (*map, *count);
+	return 0;
+}
+
+/**
+ * Check that a block of flash data contains only a single byte value.
+ *
+ * @param context The expected byte value.
+ * @param data The data read from flash.
+ * @param length The amount of data to check.
+ *
+ * @return 0 if all bytes match the expected value or an error code.
+ */
+static int host_fw_check_unused_data (void *context, const uint8_t *data, size_t length)
+{
+	if (!flash_compare_const_byte (data, length, *((uint8_t*) context))) {
+		return FLASH_UTIL_UNEXPECTED_VALUE;
+	}
+
+	return 0;
+}
+
+/**
+ * Check that a region of flash contains only a single byte value.
+ *
+ * @param flash The flash to check.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param addr The first address to check.
+ * @param length The number of bytes to check.
+ * @param unused_byte The byte value to check for.
+ *
+ * @return 0 if the region contains only the expected value or an error code.
+ */
+static int host_fw_unused_value_check (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t addr, size_t length, uint8_t unused_byte)
+{
+	if (pipeline) {
+		return flash_hash_pipeline_process_contents (pipeline, addr, length,
+			host_fw_check_unused_data, &unused_byte);
+	}
+
+	return flash_value_check (&flash->base, addr, length, unused_byte);
+}
+
+/**
+ * Verify that the entire flash contains are good by checking each image and unused region
+ * separately.  This is used when the flash cannot be verified in a single pass.
+ *
+ * @param flash The flash that should be validated.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param img_list The list of images contained in the flash.
+ * @param writable The list of writable regions of flash.
+ * @param unused_byte The byte value to check for in unused flash regions.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ *
+ * @return 0 if the flash contents are good or an error code.
+ */
+static int host_fw_full_flash_verification_per_image (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable, uint8_t unused_byte, struct hash_engine *hash,
+	struct rsa_engine *rsa)
+{
+	const struct flash_region **map;
+	size_t count;
+	uint32_t flash_size;
+	uint32_t last_addr;
+	int status;
+	size_t i;
+
+	status = spi_flash_get_device_size (flash, &flash_size);
+	if (status != 0) {
+		return status;
+	}
+
+	for (i = 0; i < img_list->count; i++) {
+		if (pipeline) {
+			status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (pipeline, 0,
+				img_list->images[i].regions, img_list->images[i].count, hash, HASH_TYPE_SHA256, rsa,
+				img_list->images[i].signature, img_list->images[i].sig_length,
+				&img_list->images[i].key, NULL, 0);
+		}
+		else {
+			status = flash_verify_noncontiguous_contents (&flash->base,
+				img_list->images[i].regions, img_list->images[i].count, hash, HASH_TYPE_SHA256, rsa,
+				img_list->images[i].signature, img_list->images[i].sig_length,
+				&img_list->images[i].key, NULL, 0);
+		}
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	status = host_fw_build_flash_region_map (img_list, writable, &map, &count);
+	if (status != 0) {
+		return status;
+	}
+
+	last_addr = 0;
+	for (i = 0; i < count; i++) {
+		if (map[i]->start_addr >= last_addr) {
+			status = host_fw_unused_value_check (flash, pipeline, last_addr,
+				map[i]->start_addr - last_addr, unused_byte);
+			if (status != 0) {
+				goto exit;
+			}
+
+			last_addr = map[i]->start_addr + map[i]->length;
+		}
+	}
+
+	status = host_fw_unused_value_check (flash, pipeline, last_addr, flash_size - last_addr,
+		unused_byte);
+
+exit:
+	platform_free (map);
+	return status;
+}
+
+/**
+ * Checking context for processing flash data during a single pass verification.
+ */
+struct host_fw_single_pass_context {
+	const struct host_fw_batch_region *sorted;	/**< The list of image regions, sorted by address. */
+	size_t count;								/**< The number of image regions in the list. */
+	size_t index;								/**< The next image region in the flash. */
+	uint32_t addr;								/**< Flash address of the next data to process. */
+	uint32_t flash_size;						/**< The size of the flash. */
+	uint8_t unused_byte;						/**< The byte value expected in unused regions. */
+	struct host_fw_batch_image *images;			/**< The hashing state for each image. */
+	struct hash_engine **idle;					/**< The list of hash engines available for use. */
+	size_t idle_count;							/**< The number of hash engines in the list. */
+};
+
+/**
+ * Process a block of flash data during a single pass verification.  Data that belongs to an image
+ * is added to the image hash and all other data is checked against the unused byte value.
+ *
+ * @param context The single pass checking context.
+ * @param data The data read from flash.
+ * @param length The amount of data to process.
+ *
+ * @return 0 if the data was processed successfully or an error code.
+ */
+static int host_fw_single_pass_check_data (void *context, const uint8_t *data, size_t length)
+{
+	struct host_fw_single_pass_context *check = (struct host_fw_single_pass_context*) context;
+	const struct host_fw_batch_region *region;
+	uint32_t next;
+	size_t chunk;
+	size_t pos = 0;
+	int status;
+
+	while (pos < length) {
+		region = &check->sorted[check->index];
+
+		if ((check->index < check->count) && (region->region->start_addr <= check->addr)) {
+			next = region->region->start_addr + region->region->length;
+			chunk = ((next - check->addr) > (length - pos)) ?
+				(length - pos) : (next - check->addr);
+
+			status = host_fw_batch_hash_region_data (region,
+				check->addr - region->region->start_addr, &data[pos], chunk, check->images,
+				check->idle, &check->idle_count);
+			if (status != 0) {
+				return status;
+			}
+
+			if ((check->addr + chunk) == next) {
+				check->index++;
+			}
+		}
+		else {
+			next = (check->index < check->count) ?
+				region->region->start_addr : check->flash_size;
+			chunk = ((next - check->addr) > (length - pos)) ?
+				(length - pos) : (next - check->addr);
+
+			if (!flash_compare_const_byte (&data[pos], chunk, check->unused_byte)) {
+				return FLASH_UTIL_UNEXPECTED_VALUE;
+			}
+		}
+
+		pos += chunk;
+		check->addr += chunk;
+	}
+
+	return 0;
+}
+
+/**
+ * Verify the entire flash in a single linear pass.  Each block of data read from flash is either
+ * added to the hash of the image that contains it or checked against the unused byte value.
+ * Read/write regions are skipped.
+ *
+ * @param flash The flash that should be validated.
+ * @param pipeline Optional hash pipeline to use for reading the flash.
+ * @param flash_size The size of the flash.
+ * @param sorted The list of image regions, sorted by address.
+ * @param count The number of image regions in the list.
+ * @param rw The list of read/write regions, sorted by address.
+ * @param rw_count The number of read/write regions in the list.
+ * @param unused_byte The byte value to check for in unused flash regions.
+ * @param images The hashing state for each image.
+ * @param idle The list of hash engines available for use.
+ * @param idle_count The number of hash engines in the list.  There must be enough to hash all
+ * concurrently active images.
+ *
+ * @return 0 if all images were hashed and all unused regions are good or an error code.  On error,
+ * some images may have active hash engines assigned to them.
+ */
+static int host_fw_single_pass_check_flash (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, uint32_t flash_size,
+	const struct host_fw_batch_region *sorted, size_t count, const struct flash_region **rw,
+	size_t rw_count, uint8_t unused_byte, struct host_fw_batch_image *images,
+	struct hash_engine **idle, size_t idle_count)
 {
-	return host_fw_verify_offset_images (flash, img_list, 0, hash, rsa);
+	uint8_t data[FLASH_DATA_CHECK_BLOCK];
+	struct host_fw_single_pass_context check;
+	uint32_t span_end;
+	size_t j = 0;
+	int status;
+
+	check.sorted = sorted;
+	check.count = count;
+	check.index = 0;
+	check.addr = 0;
+	check.flash_size = flash_size;
+	check.unused_byte = unused_byte;
+	check.images = images;
+	check.idle = idle;
+	check.idle_count = idle_count;
+
+	while (check.addr < flash_size) {
+		if ((j < rw_count) && (rw[j]->start_addr <= check.addr)) {
+			if ((rw[j]->start_addr + rw[j]->length) > check.addr) {
+				check.addr = rw[j]->start_addr + rw[j]->length;
+			}
+
+			j++;
+			continue;
+		}
+
+		span_end = ((j < rw_count) && (rw[j]->start_addr < flash_size)) ?
+			rw[j]->start_addr : flash_size;
+
+		status = host_fw_process_flash_contents (flash, pipeline, check.addr,
+			span_end - check.addr, data, sizeof (data), host_fw_single_pass_check_data, &check);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
 }
 
 /**
- * Verify that images on the flash are valid.  Only images flagged for validation will be checked.
+ * Verify that the entire flash contains are good.  All images will be verified and unused regions
+ * of read-only flash will be verified to be empty.
  *
- * All image addresses specified in the PFM will be offset by a fixed amount.
+ * The flash is read only once.  Image hashing and unused region checks are done on the same pass
+ * over the flash, with multiple hash engines used to hash interleaved images concurrently.  If the
+ * flash can't be checked in a single pass, either because regions overlap or there are not enough
+ * hash engines, each image and unused region will be checked separately using the first hash
+ * engine.
  *
- * @param flash The flash that contains the images to validate.
- * @param img_list The list of images to validate.
- * @param offset The offset to apply to image addresses.
- * @param hash The hashing engine to use for validation.
+ * @param flash The flash that should be validated.
+ * @param pipeline Optional hash pipeline to use for reading the flash.  If this is null, flash data
+ * will be read in small blocks.
+ * @param img_list The list of images contained in the flash.
+ * @param writable The list of writable regions of flash.
+ * @param unused_byte The byte value to check for in unused flash regions.
+ * @param hash The list of hashing engines to use for validation.
+ * @param hash_count The number of hashing engines in the list.
  * @param rsa The RSA engine to use for signature checking.
  *
- * @return 0 if all images that should be validated are good or an error code.
+ * @return 0 if the flash contents are good or an error code.
  */
-int host_fw_verify_offset_images (struct spi_flash *flash, const struct pfm_image_list *img_list,
-	uint32_t offset, struct hash_engine *hash, struct rsa_engine *rsa)
+int host_fw_full_flash_verification_single_pass (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable, uint8_t unused_byte, struct hash_engine **hash,
+	size_t hash_count, struct rsa_engine *rsa)
 {
-	int i;
-	int status = 0;
+	struct host_fw_batch_region *sorted = NULL;
+	struct host_fw_batch_image *images = NULL;
+	struct hash_engine **idle = NULL;
+	const struct flash_region **rw = NULL;
+	uint32_t flash_size;
+	size_t total = 0;
+	size_t count;
+	size_t max_active;
+	size_t i;
+	size_t j;
+	int status;
 
-	if ((flash == NULL) || (img_list == NULL) || (hash == NULL) || (rsa == NULL)) {
+	if ((flash == NULL) || (img_list == NULL) || (writable == NULL) || (hash == NULL) ||
+		(hash_count == 0) || (rsa == NULL) || !host_fw_is_pipeline_valid (flash, pipeline)) {
 		return HOST_FW_UTIL_INVALID_ARGUMENT;
 	}
 
+	for (i = 0; i < hash_count; i++) {
+		if (hash[i] == NULL) {
+			return HOST_FW_UTIL_INVALID_ARGUMENT;
+		}
+	}
+
+	status = spi_flash_get_device_size (flash, &flash_size);
+	if (status != 0) {
+		return status;
+	}
+
 	for (i = 0; i < img_list->count; i++) {
-		if (img_list->images[i].always_validate) {
-			status = flash_verify_noncontiguous_contents_at_offset (&flash->base, offset,
-				img_list->images[i].regions, img_list->images[i].count, hash, HASH_TYPE_SHA256, rsa,
-				img_list->images[i].signature, img_list->images[i].sig_length,
-				&img_list->images[i].key, NULL, 0);
-			if (status != 0) {
-				return status;
+		total += img_list->images[i].count;
+	}
+
+	sorted = platform_malloc (sizeof (struct host_fw_batch_region) * ((total != 0) ? total : 1));
+	images = platform_calloc ((img_list->count != 0) ? img_list->count : 1,
+		sizeof (struct host_fw_batch_image));
+	idle = platform_malloc (sizeof (struct hash_engine*) * hash_count);
+	rw = platform_malloc (sizeof (struct flash_region*) *
+		((writable->count != 0) ? writable->count : 1));
+	if ((sorted == NULL) || (images == NULL) || (idle == NULL) || (rw == NULL)) {
+		status = HOST_FW_UTIL_NO_MEMORY;
+		goto exit;
+	}
+
+	for (i = 0; i < writable->count; i++) {
+		rw[i] = &writable->regions[i];
+	}
+	host_fw_sort_regions (rw, writable->count);
+
+	if (!host_fw_batch_build_region_list (img_list, true, sorted, &count, &max_active) ||
+		(max_active > hash_count) || ((count != 0) &&
+			((sorted[count - 1].region->start_addr + sorted[count - 1].region->length) >
+				flash_size))) {
+		goto fallback;
+	}
+
+	/* Image data in read/write regions would not be hashed. */
+	for (i = 0, j = 0; (i < count) && (j < writable->count);) {
+		if ((rw[j]->start_addr + rw[j]->length) <= sorted[i].region->start_addr) {
+			j++;
+		}
+		else if ((sorted[i].region->start_addr + sorted[i].region->length) <=
+			rw[j]->start_addr) {
+			i++;
+		}
+		else if (rw[j]->length == 0) {
+			j++;
+		}
+		else {
+			goto fallback;
+		}
+	}
+
+	memcpy (idle, hash, sizeof (struct hash_engine*) * hash_count);
+
+	status = host_fw_single_pass_check_flash (flash, pipeline, flash_size, sorted, count, rw,
+		writable->count, unused_byte, images, idle, hash_count);
+	if (status != 0) {
+		for (i = 0; i < img_list->count; i++) {
+			if (images[i].hash) {
+				images[i].hash->cancel (images[i].hash);
 			}
 		}
+
+		goto exit;
+	}
+
+	for (i = 0; i < img_list->count; i++) {
+		status = rsa->sig_verify (rsa, &img_list->images[i].key, img_list->images[i].signature,
+			img_list->images[i].sig_length, images[i].digest, SHA256_HASH_LENGTH);
+		if (status != 0) {
+			goto exit;
+		}
 	}
 
+	goto exit;
+
+fallback:
+	status = host_fw_full_flash_verification_per_image (flash, pipeline, img_list, writable,
+		unused_byte, hash[0], rsa);
+
+exit:
+	platform_free (sorted);
+	platform_free (images);
+	platform_free (idle);
+	platform_free (rw);
 	return status;
 }
 
 /**
- * Find the next read/write region defined in the flash.
+ * Verify that the entire flash contains are good.  All images will be verified and unused regions
+ * of read-only flash will be verified to be empty.
  *
- * @param last_addr The flash address to start looking for the next region.
- * @param writable The list of read/write regions in flash.
+ * The flash is checked in a single pass when possible.  See
+ * host_fw_full_flash_verification_single_pass.
  *
- * @return The region description for the next defined read/write region or null if there are no
- * more defined regions.
+ * @param flash The flash that should be validated.
+ * @param pipeline Optional hash pipeline to use for reading the flash.  If this is null, flash data
+ * will be read in small blocks.
+ * @param img_list The list of images contained in the flash.
+ * @param writable The list of writable regions of flash.
+ * @param unused_byte The byte value to check for in unused flash regions.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ *
+ * @return 0 if the flash contents are good or an error code.
  */
-static const struct flash_region* host_fw_find_next_rw_region (uint32_t last_addr,
-	const struct pfm_read_write_regions *writable)
+int host_fw_full_flash_verification (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
+	uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa)
 {
-	return host_fw_find_next_region (last_addr, writable->regions, writable->count);
+	return host_fw_full_flash_verification_single_pass (flash, pipeline, img_list, writable,
+		unused_byte, &hash, 1, rsa);
 }
 
 /**
- * Find the next used region of flash.
+ * Determine if a region of flash contains any modified blocks.
  *
- * @param last_addr The flash address to start looking for the next region.
- * @param img_list The list of images in the flash.
- * @param writable The list of read/write regions in the flash.
+ * @param dirty The map of modified flash blocks.
+ * @param addr The starting address of the region.
+ * @param length The length of the region.
  *
- * @return The region description for the next used region or null if there are no more used
- * regions.
+ * @return true if any part of the region has been modified or false if not.  Blocks that are not
+ * covered by the map are always considered to be modified.
  */
-static const struct flash_region* host_fw_find_next_flash_region (uint32_t last_addr,
-	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable)
+static bool host_fw_is_region_dirty (const struct host_fw_dirty_map *dirty, uint32_t addr,
+	size_t length)
 {
-	const struct flash_region *next = NULL;
-	const struct flash_region *rw_next;
-	int i;
-	int j;
+	uint32_t block;
+	uint32_t last;
 
-	for (i = 0; i < img_list->count; i++) {
-		for (j = 0; j < img_list->images[i].count; j++) {
-			if (img_list->images[i].regions[j].start_addr >= last_addr) {
-				if (img_list->images[i].regions[j].start_addr == last_addr) {
-					return &img_list->images[i].regions[j];
-				}
+	if (length == 0) {
+		return false;
+	}
 
-				if (!next || (img_list->images[i].regions[j].start_addr < next->start_addr)) {
-					next = &img_list->images[i].regions[j];
-				}
-			}
+	block = addr / dirty->block_size;
+	last = (addr + (length - 1)) / dirty->block_size;
+
+	for (; block <= last; block++) {
+		if (((block / 8) >= dirty->length) || (dirty->map[block / 8] & (1U << (block % 8)))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Determine if an image contains any modified flash blocks.
+ *
+ * @param dirty The map of modified flash blocks.
+ * @param image The image to check.
+ *
+ * @return true if any region of the image has been modified or false if not.
+ */
+static bool host_fw_is_image_dirty (const struct host_fw_dirty_map *dirty,
+	const struct pfm_image_signature *image)
+{
+	size_t i;
+
+	for (i = 0; i < image->count; i++) {
+		if (host_fw_is_region_dirty (dirty, image->regions[i].start_addr,
+			image->regions[i].length)) {
+			return true;
 		}
 	}
 
-	rw_next = host_fw_find_next_rw_region (last_addr, writable);
-	if (rw_next) {
-		if (!next || (rw_next->start_addr == last_addr)) {
-			next = rw_next;
+	return false;
+}
+
+/**
+ * Check that the modified blocks in a region of flash contain only a single value.  Blocks that
+ * have not been modified are not read.
+ *
+ * @param flash The flash to check.
+ * @param dirty The map of modified flash blocks.  If this is null, the entire region is checked.
+ * @param addr The starting address of the region.
+ * @param length The length of the region.
+ * @param value The value that should be in the region.
+ *
+ * @return 0 if the modified blocks contain only the expected value or an error code.
+ */
+static int host_fw_dirty_value_check (struct spi_flash *flash,
+	const struct host_fw_dirty_map *dirty, uint32_t addr, size_t length, uint8_t value)
+{
+	uint32_t end = addr + length;
+	uint32_t next;
+	uint32_t run = 0;
+	bool in_run = false;
+	int status;
+
+	if (dirty == NULL) {
+		return flash_value_check (&flash->base, addr, length, value);
+	}
+
+	while (addr < end) {
+		next = (addr - (addr % dirty->block_size)) + dirty->block_size;
+		if ((next > end) || (next <= addr)) {
+			next = end;
 		}
-		else if (rw_next->start_addr < next->start_addr) {
-			next = rw_next;
+
+		if (host_fw_is_region_dirty (dirty, addr, next - addr)) {
+			if (!in_run) {
+				run = addr;
+				in_run = true;
+			}
+		}
+		else if (in_run) {
+			status = flash_value_check (&flash->base, run, addr - run, value);
+			if (status != 0) {
+				return status;
+			}
+
+			in_run = false;
 		}
+
+		addr = next;
 	}
 
-	return next;
+	if (in_run) {
+		return flash_value_check (&flash->base, run, end - run, value);
+	}
+
+	return 0;
 }
 
 /**
- * Verify that the entire flash contains are good.  All images will be verified and unused regions
- * of read-only flash will be verified to be empty.
+ * Verify that the entire flash contents are good, using a map of modified flash blocks to limit the
+ * amount of data that needs to be read.  Images that contain no modified blocks are verified
+ * against digests calculated during a previous verification of the same images.  Only the modified
+ * blocks of unused flash are checked for the unused value.
  *
  * @param flash The flash that should be validated.
  * @param img_list The list of images contained in the flash.
  * @param writable The list of writable regions of flash.
  * @param unused_byte The byte value to check for in unused flash regions.
+ * @param dirty The map of flash blocks that have been modified since the digests were calculated.
+ * If this is null, every image will be hashed and all unused regions will be checked, the same as
+ * host_fw_full_flash_verification.
+ * @param digests The digest of each image in the list.  The digest of each image that is hashed
+ * will be updated with the calculated value.  The contents are undefined if verification fails.
  * @param hash The hashing engine to use for validation.
  * @param rsa The RSA engine to use for signature checking.
  *
  * @return 0 if the flash contents are good or an error code.
  */
-int host_fw_full_flash_verification (struct spi_flash *flash, const struct pfm_image_list *img_list,
-	const struct pfm_read_write_regions *writable, uint8_t unused_byte, struct hash_engine *hash,
-	struct rsa_engine *rsa)
+int host_fw_full_flash_verification_incremental (struct spi_flash *flash,
+	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
+	uint8_t unused_byte, const struct host_fw_dirty_map *dirty,
+	uint8_t (*digests)[SHA256_HASH_LENGTH], struct hash_engine *hash, struct rsa_engine *rsa)
 {
-	const struct flash_region *pos;
+	const struct pfm_image_signature *image;
+	const struct flash_region **map;
+	size_t count;
 	uint32_t flash_size;
 	uint32_t last_addr;
 	int status;
-	int i;
+	size_t i;
 
-	if ((flash == NULL) || (img_list == NULL) || (writable == NULL) || (hash == NULL) ||
-		(rsa == NULL)) {
+	if ((flash == NULL) || (img_list == NULL) || (writable == NULL) || (digests == NULL) ||
+		(hash == NULL) || (rsa == NULL)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	if (dirty && ((dirty->block_size == 0) || ((dirty->map == NULL) && (dirty->length != 0)))) {
 		return HOST_FW_UTIL_INVALID_ARGUMENT;
 	}
 
@@ -435,28 +1467,176 @@ int host_fw_full_flash_verification (struct spi_flash *flash, const struct pfm_i
 	}
 
 	for (i = 0; i < img_list->count; i++) {
-		status = flash_verify_noncontiguous_contents (&flash->base, img_list->images[i].regions,
-			img_list->images[i].count, hash, HASH_TYPE_SHA256, rsa, img_list->images[i].signature,
-			img_list->images[i].sig_length, &img_list->images[i].key, NULL, 0);
+		image = &img_list->images[i];
+
+		if (!dirty || host_fw_is_image_dirty (dirty, image)) {
+			status = flash_verify_noncontiguous_contents (&flash->base, image->regions,
+				image->count, hash, HASH_TYPE_SHA256, rsa, image->signature, image->sig_length,
+				&image->key, digests[i], SHA256_HASH_LENGTH);
+		}
+		else {
+			status = rsa->sig_verify (rsa, &image->key, image->signature, image->sig_length,
+				digests[i], SHA256_HASH_LENGTH);
+		}
+
 		if (status != 0) {
 			return status;
 		}
 	}
 
+	status = host_fw_build_flash_region_map (img_list, writable, &map, &count);
+	if (status != 0) {
+		return status;
+	}
+
 	last_addr = 0;
-	pos = host_fw_find_next_flash_region (last_addr, img_list, writable);
-	while (pos) {
-		status = flash_value_check (&flash->base, last_addr, pos->start_addr - last_addr,
-			unused_byte);
+	for (i = 0; i < count; i++) {
+		if (map[i]->start_addr >= last_addr) {
+			status = host_fw_dirty_value_check (flash, dirty, last_addr,
+				map[i]->start_addr - last_addr, unused_byte);
+			if (status != 0) {
+				goto exit;
+			}
+
+			last_addr = map[i]->start_addr + map[i]->length;
+		}
+	}
+
+	status = host_fw_dirty_value_check (flash, dirty, last_addr, flash_size - last_addr,
+		unused_byte);
+
+exit:
+	platform_free (map);
+	return status;
+}
+
+/**
+ * Calculate an identifier for an image definition in a PFM.  The identifier covers the flash
+ * regions, signature, and key for the image, so any change to the image definition will result in
+ * a different identifier.
+ *
+ * @param image The image definition.
+ * @param hash The hash engine to use to calculate the identifier.
+ * @param image_id Output for the image identifier.  This must be at least SHA256_HASH_LENGTH bytes.
+ *
+ * @return 0 if the identifier was calculated successfully or an error code.
+ */
+static int host_fw_get_image_id (const struct pfm_image_signature *image,
+	struct hash_engine *hash, uint8_t *image_id)
+{
+	uint32_t region[2];
+	size_t i;
+	int status;
+
+	status = hash->start_sha256 (hash);
+	if (status != 0) {
+		return status;
+	}
+
+	for (i = 0; i < image->count; i++) {
+		region[0] = image->regions[i].start_addr;
+		region[1] = image->regions[i].length;
+
+		status = hash->update (hash, (uint8_t*) region, sizeof (region));
+		if (status != 0) {
+			goto error;
+		}
+	}
+
+	status = hash->update (hash, image->signature, image->sig_length);
+	if (status != 0) {
+		goto error;
+	}
+
+	status = hash->update (hash, image->key.modulus, image->key.mod_length);
+	if (status != 0) {
+		goto error;
+	}
+
+	status = hash->update (hash, (uint8_t*) &image->key.exponent, sizeof (image->key.exponent));
+	if (status != 0) {
+		goto error;
+	}
+
+	return hash->finish (hash, image_id, SHA256_HASH_LENGTH);
+
+error:
+	hash->cancel (hash);
+	return status;
+}
+
+/**
+ * Verify that images on the flash are valid, using a cache of previously verified image digests.
+ * Only images flagged for validation will be checked.
+ *
+ * Cached digests are only used when the caller can guarantee that the flash has not been modified
+ * since the digests were cached.  In this case, the image data is not read and the signature is
+ * checked against the cached digest.  Every image that gets hashed will have its digest updated in
+ * the cache.  If verification fails, the cache is invalidated.
+ *
+ * @param flash The flash that contains the images to validate.
+ * @param img_list The list of images to validate.
+ * @param cache The cache of verified image digests.
+ * @param flash_id Identifier for the flash device being verified.
+ * @param pfm_id ID of the PFM that contains the image list.
+ * @param use_cache Flag indicating if the flash is known to be unmodified since the cached digests
+ * were calculated.  If this is not set, every image will be hashed.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ *
+ * @return 0 if all images that should be validated are good or an error code.
+ */
+int host_fw_verify_images_cached (struct spi_flash *flash, const struct pfm_image_list *img_list,
+	struct host_fw_verification_cache *cache, uint8_t flash_id, uint32_t pfm_id, bool use_cache,
+	struct hash_engine *hash, struct rsa_engine *rsa)
+{
+	const struct pfm_image_signature *image;
+	uint8_t image_id[SHA256_HASH_LENGTH];
+	uint8_t digest[SHA256_HASH_LENGTH];
+	size_t i;
+	int status;
+
+	if ((flash == NULL) || (img_list == NULL) || (cache == NULL) || (hash == NULL) ||
+		(rsa == NULL)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < img_list->count; i++) {
+		image = &img_list->images[i];
+
+		if (!image->always_validate) {
+			continue;
+		}
+
+		status = host_fw_get_image_id (image, hash, image_id);
 		if (status != 0) {
 			return status;
 		}
 
-		last_addr = pos->start_addr + pos->length;
-		pos = host_fw_find_next_flash_region (last_addr, img_list, writable);
+		if (use_cache && (i <= UINT8_MAX) &&
+			(host_fw_verification_cache_find (cache, flash_id, pfm_id, i, image_id,
+				digest) == 0)) {
+			status = rsa->sig_verify (rsa, &image->key, image->signature, image->sig_length,
+				digest, sizeof (digest));
+			if (status == 0) {
+				continue;
+			}
+		}
+
+		status = flash_verify_noncontiguous_contents (&flash->base, image->regions, image->count,
+			hash, HASH_TYPE_SHA256, rsa, image->signature, image->sig_length, &image->key, digest,
+			sizeof (digest));
+		if (status != 0) {
+			host_fw_verification_cache_invalidate (cache);
+			return status;
+		}
+
+		if (i <= UINT8_MAX) {
+			host_fw_verification_cache_update (cache, flash_id, pfm_id, i, image_id, digest);
+		}
 	}
 
-	return flash_value_check (&flash->base, last_addr, flash_size - last_addr, unused_byte);
+	return 0;
 }
 
 /**
@@ -492,6 +1672,8 @@ bool host_fw_are_read_write_regions_different (const struct pfm_read_write_regio
  * data previously in that location to persist.
  *
  * @param dest The flash device that will receive the read/write data.
+ * @param stream Optional copy stream for the destination flash.  If this is null, data will be
+ * copied one flash page at a time.
  * @param dest_writable The read/write regions defined on the destination flash.
  * @param src The flash device that contains the read/write data to migrate.
  * @param src_writable The read/write regions that should be migrated.  This can be null to force
@@ -503,7 +1685,7 @@ bool host_fw_are_read_write_regions_different (const struct pfm_read_write_regio
  * 		- HOST_FW_UTIL_DIFF_REGION_ADDR
  * 		- HOST_FW_UTIL_DIFF_REGION_SIZE
  */
-int host_fw_migrate_read_write_data (struct spi_flash *dest,
+int host_fw_migrate_read_write_data (struct spi_flash *dest, struct flash_copy_stream *stream,
 	const struct pfm_read_write_regions *dest_writable, struct spi_flash *src,
 	const struct pfm_read_write_regions *src_writable)
 {
@@ -517,6 +1699,10 @@ int host_fw_migrate_read_write_data (struct spi_flash *dest,
 		return HOST_FW_UTIL_INVALID_ARGUMENT;
 	}
 
+	if (stream && (stream->flash != &dest->base)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
 	if (src_writable && (src_writable->count != dest_writable->count)) {
 		migrate_fail = HOST_FW_UTIL_DIFF_REGION_COUNT;
 	}
@@ -553,8 +1739,14 @@ int host_fw_migrate_read_write_data (struct spi_flash *dest,
 	last_addr = 0;
 	dest_pos = host_fw_find_next_rw_region (last_addr, dest_writable);
 	while (dest_pos) {
-		status = flash_copy_ext_to_blank_and_verify (&dest->base, dest_pos->start_addr, &src->base,
-			dest_pos->start_addr, dest_pos->length);
+		if (stream) {
+			status = flash_copy_stream_copy_ext_to_blank_and_verify (stream, dest_pos->start_addr,
+				&src->base, dest_pos->start_addr, dest_pos->length);
+		}
+		else {
+			status = flash_copy_ext_to_blank_and_verify (&dest->base, dest_pos->start_addr,
+				&src->base, dest_pos->start_addr, dest_pos->length);
+		}
 		if (status != 0) {
 			return status;
 		}
@@ -571,14 +1763,17 @@ int host_fw_migrate_read_write_data (struct spi_flash *dest,
  * verification will be performed on the restored device.
  *
  * @param restore The flash device that should be restored.
+ * @param stream Optional copy stream for the flash device being restored.  If this is null, data
+ * will be copied one flash page at a time.
  * @param from The device to restore from.
  * @param img_list The list of firmware images in the good flash device.
  * @param writable The list of read/write regions in the good flash device.
  *
  * @return 0 if the bad flash was restored to a good state or an error code.
  */
-int host_fw_restore_flash_device (struct spi_flash *restore, struct spi_flash *from,
-	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable)
+int host_fw_restore_flash_device (struct spi_flash *restore, struct flash_copy_stream *stream,
+	struct spi_flash *from, const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable)
 {
 	uint32_t flash_size;
 	uint32_t last_addr;
@@ -591,6 +1786,10 @@ int host_fw_restore_flash_device (struct spi_flash *restore, struct spi_flash *f
 		return HOST_FW_UTIL_INVALID_ARGUMENT;
 	}
 
+	if (stream && (stream->flash != &restore->base)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
 	status = spi_flash_get_device_size (restore, &flash_size);
 	if (status != 0) {
 		return status;
@@ -617,9 +1816,18 @@ int host_fw_restore_flash_device (struct spi_flash *restore, struct spi_flash *f
 	/* Copy firmware images. */
 	for (i = 0; i < img_list->count; i++) {
 		for (j = 0; j < img_list->images->count; j++) {
-			status = flash_copy_ext_to_blank (&restore->base,
-				img_list->images[i].regions[j].start_addr, &from->base,
-				img_list->images[i].regions[j].start_addr, img_list->images[i].regions[j].length);
+			if (stream) {
+				status = flash_copy_stream_copy_ext_to_blank (stream,
+					img_list->images[i].regions[j].start_addr, &from->base,
+					img_list->images[i].regions[j].start_addr,
+					img_list->images[i].regions[j].length);
+			}
+			else {
+				status = flash_copy_ext_to_blank (&restore->base,
+					img_list->images[i].regions[j].start_addr, &from->base,
+					img_list->images[i].regions[j].start_addr,
+					img_list->images[i].regions[j].length);
+			}
 			if (status != 0) {
 				return status;
 			}
@@ -9,9 +9,33 @@
 #include "status/rot_status.h"
 #include "manifest/pfm/pfm.h"
 #include "flash/spi_flash.h"
+#include "flash/flash_util.h"
 #include "spi_filter/spi_filter_interface.h"
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
+#include "host_fw_verification_cache.h"
+
+
+/**
+ * Map of host flash blocks that have been modified since the flash was last verified.
+ */
+struct host_fw_dirty_map {
+	const uint8_t *map;						/**< Bitmap of dirty blocks, one bit per block. */
+	size_t length;							/**< The length of the bitmap, in bytes. */
+	uint32_t block_size;					/**< The number of bytes in each block. */
+};
+
+/**
+ * Image digests calculated during a previous verification of a flash device.  These allow images
+ * that have not been modified to be verified without reading the image data from flash again.
+ */
+struct host_fw_image_digests {
+	uint8_t (*digest)[SHA256_HASH_LENGTH];	/**< Storage for the digest of each image. */
+	size_t max_images;						/**< The maximum number of digests to store. */
+	size_t count;							/**< The number of images with a stored digest. */
+	int version;							/**< Index of the PFM version for the digests. */
+	bool valid;								/**< Flag indicating if the stored digests are valid. */
+};
 
 
 int host_fw_determine_version (struct spi_flash *flash, const struct pfm_firmware_versions *allowed,
@@ -21,22 +45,41 @@ int host_fw_determine_offset_version (struct spi_flash *flash, uint32_t offset,
 
 bool host_fw_are_images_different (const struct pfm_image_list *img_list1,
 	const struct pfm_image_list *img_list2);
-int host_fw_verify_images (struct spi_flash *flash, const struct pfm_image_list *img_list,
-	struct hash_engine *hash, struct rsa_engine *rsa);
-int host_fw_verify_offset_images (struct spi_flash *flash, const struct pfm_image_list *img_list,
-	uint32_t offset, struct hash_engine *hash, struct rsa_engine *rsa);
-int host_fw_full_flash_verification (struct spi_flash *flash, const struct pfm_image_list *img_list,
-	const struct pfm_read_write_regions *writable, uint8_t unused_byte, struct hash_engine *hash,
+int host_fw_verify_images (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, struct hash_engine *hash, struct rsa_engine *rsa);
+int host_fw_verify_offset_images (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, uint32_t offset, struct hash_engine *hash,
 	struct rsa_engine *rsa);
+int host_fw_verify_images_batch (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, struct hash_engine **hash, size_t hash_count,
+	struct rsa_engine *rsa);
+int host_fw_verify_offset_images_batch (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, const struct pfm_image_list *img_list, uint32_t offset,
+	struct hash_engine **hash, size_t hash_count, struct rsa_engine *rsa);
+int host_fw_full_flash_verification (struct spi_flash *flash, struct flash_hash_pipeline *pipeline,
+	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
+	uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa);
+int host_fw_full_flash_verification_single_pass (struct spi_flash *flash,
+	struct flash_hash_pipeline *pipeline, const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable, uint8_t unused_byte, struct hash_engine **hash,
+	size_t hash_count, struct rsa_engine *rsa);
+int host_fw_full_flash_verification_incremental (struct spi_flash *flash,
+	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
+	uint8_t unused_byte, const struct host_fw_dirty_map *dirty,
+	uint8_t (*digests)[SHA256_HASH_LENGTH], struct hash_engine *hash, struct rsa_engine *rsa);
+int host_fw_verify_images_cached (struct spi_flash *flash, const struct pfm_image_list *img_list,
+	struct host_fw_verification_cache *cache, uint8_t flash_id, uint32_t pfm_id, bool use_cache,
+	struct hash_engine *hash, struct rsa_engine *rsa);
 
 bool host_fw_are_read_write_regions_different (const struct pfm_read_write_regions *rw1,
 	const struct pfm_read_write_regions *rw2);
-int host_fw_migrate_read_write_data (struct spi_flash *dest,
+int host_fw_migrate_read_write_data (struct spi_flash *dest, struct flash_copy_stream *stream,
 	const struct pfm_read_write_regions *dest_writable, struct spi_flash *src,
 	const struct pfm_read_write_regions *src_writable);
 
-int host_fw_restore_flash_device (struct spi_flash *restore, struct spi_flash *from,
-	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable);
+int host_fw_restore_flash_device (struct spi_flash *restore, struct flash_copy_stream *stream,
+	struct spi_flash *from, const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable);
 
 int host_fw_config_spi_filter_read_write_regions (struct spi_filter_interface *filter,
 	const struct pfm_read_write_regions *writable);
@@ -0,0 +1,311 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "host_fw_verification_cache.h"
+#include "flash/flash_common.h"
+#include "flash/flash_util.h"
+
+
+/**
+ * Marker used to identify a stored verification cache record.
+ */
+#define	HOST_FW_VERIFICATION_CACHE_MARKER		0xcac4
+
+
+/**
+ * Calculate the integrity check HMAC for a cache record.
+ *
+ * @param cache The verification cache that contains the hash engine and device key.
+ * @param record The record to check.
+ * @param check Output for the integrity check HMAC.
+ *
+ * @return 0 if the HMAC was calculated successfully or an error code.
+ */
+static int host_fw_verification_cache_calculate_check (struct host_fw_verification_cache *cache,
+	const struct host_fw_verification_cache_record *record, uint8_t *check)
+{
+	return hash_generate_hmac (cache->hash, cache->key, cache->key_length, (uint8_t*) record,
+		offsetof (struct host_fw_verification_cache_record, check), HMAC_SHA256, check,
+		SHA256_HASH_LENGTH);
+}
+
+/**
+ * Reset the cache contents so that no images are cached.
+ *
+ * @param cache The cache to reset.
+ */
+static void host_fw_verification_cache_clear (struct host_fw_verification_cache *cache)
+{
+	memset (&cache->record, 0, sizeof (cache->record));
+	cache->record.marker = HOST_FW_VERIFICATION_CACHE_MARKER;
+}
+
+/**
+ * Initialize a persistent cache of verified host images.  Any cache contents already in flash will
+ * be loaded.  If the stored contents fail the integrity check, the cache will be empty.
+ *
+ * The stored record is authenticated with an HMAC using a device-unique key, so a record written
+ * to flash by anything other than this device will be discarded.
+ *
+ * @param cache The verification cache to initialize.
+ * @param flash The flash that stores the cache.
+ * @param addr The address of the cache storage.  This must be aligned to the start of a flash
+ * sector, and the entire sector will be used to store the cache.
+ * @param hash The hash engine to use for integrity checking of the stored cache.
+ * @param key The device-unique key used to authenticate the stored cache.  This must remain valid
+ * for the lifetime of the cache.
+ * @param key_length Length of the device key.
+ *
+ * @return 0 if the cache was successfully initialized or an error code.
+ */
+int host_fw_verification_cache_init (struct host_fw_verification_cache *cache,
+	struct flash *flash, uint32_t addr, struct hash_engine *hash, const uint8_t *key,
+	size_t key_length)
+{
+	uint8_t check[SHA256_HASH_LENGTH];
+	uint32_t sector_size;
+	size_t i;
+	int status;
+
+	if ((cache == NULL) || (flash == NULL) || (hash == NULL) || (key == NULL) ||
+		(key_length == 0)) {
+		return HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT;
+	}
+
+	status = flash->get_sector_size (flash, &sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	if (FLASH_REGION_BASE (addr, sector_size) != addr) {
+		return HOST_FW_VERIFICATION_CACHE_NOT_SECTOR_ALIGNED;
+	}
+
+	if (sector_size < sizeof (struct host_fw_verification_cache_record)) {
+		return HOST_FW_VERIFICATION_CACHE_SECTOR_TOO_SMALL;
+	}
+
+	memset (cache, 0, sizeof (struct host_fw_verification_cache));
+
+	cache->hash = hash;
+	cache->key = key;
+	cache->key_length = key_length;
+
+	status = flash->read (flash, addr, (uint8_t*) &cache->record, sizeof (cache->record));
+	if (status != 0) {
+		return status;
+	}
+
+	for (i = 0; i < sizeof (cache->record); i++) {
+		if (((uint8_t*) &cache->record)[i] != 0xff) {
+			cache->programmed = true;
+			break;
+		}
+	}
+
+	if ((cache->record.marker == HOST_FW_VERIFICATION_CACHE_MARKER) &&
+		(cache->record.count <= HOST_FW_VERIFICATION_CACHE_MAX_IMAGES)) {
+		status = host_fw_verification_cache_calculate_check (cache, &cache->record, check);
+		if (status != 0) {
+			return status;
+		}
+
+		if (memcmp (check, cache->record.check, sizeof (check)) != 0) {
+			host_fw_verification_cache_clear (cache);
+		}
+	}
+	else {
+		host_fw_verification_cache_clear (cache);
+	}
+
+	cache->flash = flash;
+	cache->addr = addr;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a verification cache.
+ *
+ * @param cache The verification cache to release.
+ */
+void host_fw_verification_cache_release (struct host_fw_verification_cache *cache)
+{
+
+}
+
+/**
+ * Find the digest for a verified image in the cache.
+ *
+ * @param cache The verification cache to query.
+ * @param flash_id Identifier for the flash device that contains the image.
+ * @param pfm_id ID of the PFM that defines the image.
+ * @param image_index Index of the image in the PFM image list.
+ * @param image_id Hash of the image definition in the PFM.
+ * @param digest Output for the cached image digest.  This must be at least SHA256_HASH_LENGTH
+ * bytes.
+ *
+ * @return 0 if the image digest was found in the cache or an error code.
+ */
+int host_fw_verification_cache_find (struct host_fw_verification_cache *cache, uint8_t flash_id,
+	uint32_t pfm_id, uint8_t image_index, const uint8_t *image_id, uint8_t *digest)
+{
+	const struct host_fw_verification_cache_entry *entry;
+	uint8_t i;
+
+	if ((cache == NULL) || (image_id == NULL) || (digest == NULL)) {
+		return HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT;
+	}
+
+	if ((cache->record.flash_id != flash_id) || (cache->record.pfm_id != pfm_id)) {
+		return HOST_FW_VERIFICATION_CACHE_NO_ENTRY;
+	}
+
+	for (i = 0; i < cache->record.count; i++) {
+		entry = &cache->record.entry[i];
+
+		if ((entry->image_index == image_index) &&
+			(memcmp (entry->image_id, image_id, SHA256_HASH_LENGTH) == 0)) {
+			memcpy (digest, entry->digest, SHA256_HASH_LENGTH);
+			return 0;
+		}
+	}
+
+	return HOST_FW_VERIFICATION_CACHE_NO_ENTRY;
+}
+
+/**
+ * Add the digest for a verified image to the cache.  If the flash or PFM is different from the
+ * current cache contents, all cached images will be discarded.  The update will not be stored in
+ * flash until host_fw_verification_cache_store is called.
+ *
+ * @param cache The verification cache to update.
+ * @param flash_id Identifier for the flash device that contains the image.
+ * @param pfm_id ID of the PFM that defines the image.
+ * @param image_index Index of the image in the PFM image list.
+ * @param image_id Hash of the image definition in the PFM.
+ * @param digest The digest of the image data that was successfully verified.
+ *
+ * @return 0 if the image was added to the cache or an error code.
+ */
+int host_fw_verification_cache_update (struct host_fw_verification_cache *cache,
+	uint8_t flash_id, uint32_t pfm_id, uint8_t image_index, const uint8_t *image_id,
+	const uint8_t *digest)
+{
+	struct host_fw_verification_cache_entry *entry = NULL;
+	uint8_t i;
+
+	if ((cache == NULL) || (image_id == NULL) || (digest == NULL)) {
+		return HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT;
+	}
+
+	if ((cache->record.count != 0) &&
+		((cache->record.flash_id != flash_id) || (cache->record.pfm_id != pfm_id))) {
+		host_fw_verification_cache_clear (cache);
+		cache->modified = true;
+	}
+
+	for (i = 0; i < cache->record.count; i++) {
+		if (cache->record.entry[i].image_index == image_index) {
+			entry = &cache->record.entry[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		if (cache->record.count == HOST_FW_VERIFICATION_CACHE_MAX_IMAGES) {
+			return HOST_FW_VERIFICATION_CACHE_FULL;
+		}
+
+		entry = &cache->record.entry[cache->record.count++];
+		entry->image_index = image_index;
+		cache->modified = true;
+	}
+	else if ((memcmp (entry->image_id, image_id, SHA256_HASH_LENGTH) == 0) &&
+		(memcmp (entry->digest, digest, SHA256_HASH_LENGTH) == 0)) {
+		return 0;
+	}
+
+	cache->record.flash_id = flash_id;
+	cache->record.pfm_id = pfm_id;
+	memcpy (entry->image_id, image_id, SHA256_HASH_LENGTH);
+	memcpy (entry->digest, digest, SHA256_HASH_LENGTH);
+	cache->modified = true;
+
+	return 0;
+}
+
+/**
+ * Store any updates to the cache in flash.  Nothing will be written if the cache has not changed
+ * since it was last stored.
+ *
+ * @param cache The verification cache to store.
+ *
+ * @return 0 if the cache was successfully stored or an error code.
+ */
+int host_fw_verification_cache_store (struct host_fw_verification_cache *cache)
+{
+	int status;
+
+	if (cache == NULL) {
+		return HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT;
+	}
+
+	if (!cache->modified) {
+		return 0;
+	}
+
+	if (cache->record.count == 0) {
+		return host_fw_verification_cache_invalidate (cache);
+	}
+
+	status = host_fw_verification_cache_calculate_check (cache, &cache->record,
+		cache->record.check);
+	if (status != 0) {
+		return status;
+	}
+
+	cache->programmed = true;
+	status = flash_sector_program_and_verify (cache->flash, cache->addr,
+		(uint8_t*) &cache->record, sizeof (cache->record));
+	if (status != 0) {
+		return status;
+	}
+
+	cache->modified = false;
+	return 0;
+}
+
+/**
+ * Discard all cached images.  The cache storage will be erased immediately so that no cached
+ * images will be used, even if the device is reset before the cache is updated again.
+ *
+ * @param cache The verification cache to invalidate.
+ *
+ * @return 0 if the cache was successfully invalidated or an error code.
+ */
+int host_fw_verification_cache_invalidate (struct host_fw_verification_cache *cache)
+{
+	int status;
+
+	if (cache == NULL) {
+		return HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT;
+	}
+
+	host_fw_verification_cache_clear (cache);
+	cache->modified = false;
+
+	if (cache->programmed) {
+		status = flash_sector_erase_region (cache->flash, cache->addr, sizeof (cache->record));
+		if (status != 0) {
+			return status;
+		}
+
+		cache->programmed = false;
+	}
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HOST_FW_VERIFICATION_CACHE_H_
+#define HOST_FW_VERIFICATION_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "status/rot_status.h"
+#include "flash/flash.h"
+#include "crypto/hash.h"
+
+
+/**
+ * The maximum number of image digests that can be stored in the verification cache.
+ */
+#ifndef HOST_FW_VERIFICATION_CACHE_MAX_IMAGES
+#define	HOST_FW_VERIFICATION_CACHE_MAX_IMAGES		8
+#endif
+
+
+#pragma pack(push, 1)
+/**
+ * A single verified image stored in the cache.
+ */
+struct host_fw_verification_cache_entry {
+	uint8_t image_index;						/**< Index of the image in the PFM image list. */
+	uint8_t reserved[3];						/**< Unused. */
+	uint8_t image_id[SHA256_HASH_LENGTH];		/**< Hash of the image regions and signature. */
+	uint8_t digest[SHA256_HASH_LENGTH];			/**< Digest of the verified image data. */
+};
+
+/**
+ * The format of the verification cache as it is stored in flash.
+ */
+struct host_fw_verification_cache_record {
+	uint16_t marker;							/**< Marker indicating a valid record. */
+	uint8_t flash_id;							/**< Identifier for the verified flash device. */
+	uint8_t count;								/**< The number of valid image entries. */
+	uint32_t pfm_id;							/**< ID of the PFM used for verification. */
+	/** The verified images. */
+	struct host_fw_verification_cache_entry entry[HOST_FW_VERIFICATION_CACHE_MAX_IMAGES];
+	uint8_t check[SHA256_HASH_LENGTH];			/**< HMAC-SHA256 of the record contents. */
+};
+#pragma pack(pop)
+
+/**
+ * A persistent cache of image digests that have been verified on a protected flash device.  The
+ * cache is stored in a single flash sector and is authenticated with a device key when it is
+ * loaded.  A cache that fails the check is discarded.
+ *
+ * The cache does not provide any synchronization.  Callers must serialize access.
+ */
+struct host_fw_verification_cache {
+	struct flash *flash;						/**< The flash that stores the cache. */
+	uint32_t addr;								/**< The address of the cache storage. */
+	struct hash_engine *hash;					/**< Hash engine for integrity checking. */
+	const uint8_t *key;							/**< Device key for the record HMAC. */
+	size_t key_length;							/**< Length of the device key. */
+	struct host_fw_verification_cache_record record;	/**< The current cache contents. */
+	bool modified;								/**< Flag indicating the record needs storing. */
+	bool programmed;							/**< Flag indicating the flash is not blank. */
+};
+
+
+int host_fw_verification_cache_init (struct host_fw_verification_cache *cache,
+	struct flash *flash, uint32_t addr, struct hash_engine *hash, const uint8_t *key,
+	size_t key_length);
+void host_fw_verification_cache_release (struct host_fw_verification_cache *cache);
+
+int host_fw_verification_cache_find (struct host_fw_verification_cache *cache, uint8_t flash_id,
+	uint32_t pfm_id, uint8_t image_index, const uint8_t *image_id, uint8_t *digest);
+int host_fw_verification_cache_update (struct host_fw_verification_cache *cache,
+	uint8_t flash_id, uint32_t pfm_id, uint8_t image_index, const uint8_t *image_id,
+	const uint8_t *digest);
+int host_fw_verification_cache_store (struct host_fw_verification_cache *cache);
+int host_fw_verification_cache_invalidate (struct host_fw_verification_cache *cache);
+
+
+#define	HOST_FW_VERIFICATION_CACHE_ERROR(code)		ROT_ERROR (ROT_MODULE_HOST_FW_VERIFICATION_CACHE, code)
+
+/**
+ * Error codes that can be generated by the host firmware verification cache.
+ */
+enum {
+	HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT = HOST_FW_VERIFICATION_CACHE_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	HOST_FW_VERIFICATION_CACHE_NO_MEMORY = HOST_FW_VERIFICATION_CACHE_ERROR (0x01),			/**< Memory allocation failed. */
+	HOST_FW_VERIFICATION_CACHE_NOT_SECTOR_ALIGNED = HOST_FW_VERIFICATION_CACHE_ERROR (0x02),	/**< The storage address is not aligned to a sector. */
+	HOST_FW_VERIFICATION_CACHE_SECTOR_TOO_SMALL = HOST_FW_VERIFICATION_CACHE_ERROR (0x03),	/**< The cache does not fit in a single sector. */
+	HOST_FW_VERIFICATION_CACHE_NO_ENTRY = HOST_FW_VERIFICATION_CACHE_ERROR (0x04),			/**< There is no cached digest for the image. */
+	HOST_FW_VERIFICATION_CACHE_FULL = HOST_FW_VERIFICATION_CACHE_ERROR (0x05),				/**< There is no space for another image. */
+};
+
+
+#endif /* HOST_FW_VERIFICATION_CACHE_H_ */
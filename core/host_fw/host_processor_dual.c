@@ -110,6 +110,20 @@ static void host_processor_dual_set_host_flash_access (struct host_processor_dua
 	}
 }
 
+/**
+ * Discard the persistent cache of verified read-only flash images.  This must be called whenever
+ * the contents of the read-only flash could change without being verified.
+ *
+ * @param host The host instance to update.
+ */
+static void host_processor_dual_invalidate_verification_cache (struct host_processor_dual *host)
+{
+	host->verify_cache_trusted = false;
+	if (host->verify_cache) {
+		host_fw_verification_cache_invalidate (host->verify_cache);
+	}
+}
+
 /**
  * Configure the filter for bypass mode.
  *
@@ -126,6 +140,8 @@ static void host_processor_dual_config_bypass (struct host_processor_dual *host)
 	int log_status = 0;
 	uint32_t retries = 0;
 
+	host_processor_dual_invalidate_verification_cache (host);
+
 	do {
 		retries++;
 		status = host->internal.enable_bypass_mode (host);
@@ -315,6 +331,123 @@ static void host_processor_dual_swap_flash (struct host_processor_dual *host,
 	host_state_manager_set_run_time_validation (host->state, HOST_STATE_PREVALIDATED_NONE);
 }
 
+/**
+ * Discard any image digests calculated during a previous run-time verification.  This must be done
+ * whenever the contents of the read/write flash could change without being tracked by the SPI
+ * filter.
+ *
+ * @param host The host instance to update.
+ */
+static void host_processor_dual_invalidate_digests (struct host_processor_dual *host)
+{
+	host->digests.valid = false;
+	host->digests_pfm = NULL;
+}
+
+/**
+ * Determine if the SPI filter has been protecting the read-only flash since before the current
+ * reset.  This can only be true on platforms where the SPI filter configuration is retained across
+ * a reset of the RoT.
+ *
+ * @param host The host instance to check.
+ *
+ * @return true if the read-only flash is known to be protected or false if not.
+ */
+static bool host_processor_dual_is_read_only_flash_protected (struct host_processor_dual *host)
+{
+	spi_filter_bypass_mode bypass;
+	spi_filter_cs ro;
+	bool enabled;
+
+	if ((host->filter->get_filter_enabled (host->filter, &enabled) != 0) || !enabled) {
+		return false;
+	}
+
+	if ((host->filter->get_bypass_mode (host->filter, &bypass) != 0) ||
+		(bypass != SPI_FILTER_OPERATE)) {
+		return false;
+	}
+
+	if (host->filter->get_ro_cs (host->filter, &ro) != 0) {
+		return false;
+	}
+
+	return (ro == host_state_manager_get_read_only_flash (host->state));
+}
+
+/**
+ * Determine if cached verification results for the read-only flash can be used without hashing
+ * the flash.  The SPI filter must have been protecting the read-only flash since before the
+ * current reset, and it must not have seen any flash writes since its dirty state was last cleared.
+ *
+ * @param host The host instance to check.
+ *
+ * @return true if the verification cache can be trusted or false if not.
+ */
+static bool host_processor_dual_is_verification_cache_trusted (struct host_processor_dual *host)
+{
+	spi_filter_flash_state state;
+
+	if ((host->verify_cache == NULL) || !host_processor_dual_is_read_only_flash_protected (host)) {
+		return false;
+	}
+
+	if (host->filter->get_flash_dirty_state (host->filter, &state) != 0) {
+		return false;
+	}
+
+	return (state == SPI_FILTER_FLASH_STATE_NORMAL);
+}
+
+/**
+ * Validate the read/write flash using the SPI filter map of modified flash blocks.  Only the
+ * portions of flash that have been modified since the last run-time verification will be checked.
+ * A full validation is run if there are no image digests available for the PFM.
+ *
+ * This must only be called when the SPI filter supports tracking modified flash blocks.
+ *
+ * @param host The host instance to validate.
+ * @param pfm The PFM to use for validation.
+ * @param hash The hash engine to use for validation.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param writable Output for the read/write regions of the validated flash.
+ *
+ * @return 0 if the read/write flash was successfully validated or an error code.
+ */
+static int host_processor_dual_validate_read_write_flash_incremental (
+	struct host_processor_dual *host, struct pfm *pfm, struct hash_engine *hash,
+	struct rsa_engine *rsa, struct pfm_read_write_regions *writable)
+{
+	struct host_fw_dirty_map dirty;
+	struct host_fw_dirty_map *changed = NULL;
+	uint32_t id;
+	int id_status;
+	int status;
+
+	id_status = pfm->base.get_id (&pfm->base, &id);
+	if ((id_status == 0) && (host->digests_pfm == pfm) && (host->digests_pfm_id == id)) {
+		status = host->filter->get_flash_dirty_blocks (host->filter, host->dirty_map,
+			host->dirty_map_length, &dirty.block_size);
+		if (!ROT_IS_ERROR (status) && (dirty.block_size != 0)) {
+			dirty.map = host->dirty_map;
+			dirty.length = status;
+			changed = &dirty;
+		}
+	}
+
+	status = host->flash->validate_read_write_flash_incremental (host->flash, pfm, hash, rsa,
+		changed, &host->digests, writable);
+	if ((status == 0) && (id_status == 0)) {
+		host->digests_pfm = pfm;
+		host->digests_pfm_id = id;
+	}
+	else {
+		host_processor_dual_invalidate_digests (host);
+	}
+
+	return status;
+}
+
 /**
  * Validate the flash against a single PFM.
  *
@@ -347,11 +480,25 @@ static int host_processor_dual_validate_flash (struct host_processor_dual *host,
 	int dirty_fail = 0;
 	bool checked_rw = true;
 	bool pfm_dirty = host_state_manager_is_pfm_dirty (host->state);
+	bool incremental = (host->dirty_map != NULL) &&
+		(host->filter->get_flash_dirty_blocks != NULL) && !is_pending && !is_bypass &&
+		!apply_filter_cfg;
+
+	if (!incremental) {
+		host_processor_dual_invalidate_digests (host);
+	}
 
 	if (!is_bypass && host_state_manager_is_inactive_dirty (host->state)) {
 		if (!is_validated) {
 			host_state_manager_set_run_time_validation (host->state, HOST_STATE_PREVALIDATED_NONE);
-			status = host->flash->validate_read_write_flash (host->flash, pfm, hash, rsa, &rw_list);
+			if (incremental) {
+				status = host_processor_dual_validate_read_write_flash_incremental (host, pfm, hash,
+					rsa, &rw_list);
+			}
+			else {
+				status = host->flash->validate_read_write_flash (host->flash, pfm, hash, rsa,
+					&rw_list);
+			}
 		}
 		else {
 			status = host->flash->get_flash_read_write_regions (host->flash, pfm, true, &rw_list);
@@ -435,8 +582,14 @@ static int host_processor_dual_validate_flash (struct host_processor_dual *host,
 	}
 
 	if (!skip_ro && (status != 0) && (!is_pending || is_bypass || pfm_dirty)) {
-		status = host->flash->validate_read_only_flash (host->flash, pfm, active, hash, rsa,
-			is_bypass, &rw_list);
+		if (host->verify_cache && !is_bypass) {
+			status = host->flash->validate_read_only_flash_cached (host->flash, pfm, active, hash,
+				rsa, host->verify_cache, host->verify_cache_trusted, &rw_list);
+		}
+		else {
+			status = host->flash->validate_read_only_flash (host->flash, pfm, active, hash, rsa,
+				is_bypass, &rw_list);
+		}
 
 		if (is_pending) {
 			debug_log_create_entry (
@@ -559,6 +712,11 @@ static int host_processor_dual_power_on_reset (struct host_processor *host,
 	}
 
 	platform_mutex_lock (&dual->lock);
+	host_processor_dual_invalidate_digests (dual);
+
+	/* Cached verification results for the read-only flash can only be trusted if the SPI filter
+	 * has prevented any modification to the flash since the results were cached. */
+	dual->verify_cache_trusted = host_processor_dual_is_verification_cache_trusted (dual);
 
 	host_state_manager_set_pfm_dirty (dual->state, true);
 	host_state_manager_set_bypass_mode (dual->state, false);
@@ -630,11 +788,13 @@ exit:
 		dual->pfm->free_pfm (dual->pfm, pending_pfm);
 	}
 	if (status != 0) {
+		dual->verify_cache_trusted = false;
 		platform_mutex_unlock (&dual->lock);
 		return status;
 	}
 
 exit_host:
+	dual->verify_cache_trusted = false;
 	host_processor_dual_set_host_flash_access (dual);
 
 	platform_mutex_unlock (&dual->lock);
@@ -663,6 +823,7 @@ static int host_processor_dual_soft_reset (struct host_processor *host, struct h
 	}
 
 	platform_mutex_lock (&dual->lock);
+	host_processor_dual_invalidate_digests (dual);
 
 	active_pfm = dual->pfm->get_active_pfm (dual->pfm);
 	pending_pfm = dual->pfm->get_pending_pfm (dual->pfm);
@@ -713,10 +874,16 @@ static int host_processor_dual_soft_reset (struct host_processor *host, struct h
 			}
 
 			if (status == 0) {
+				if (active_pfm && !bypass) {
+					dual->verify_cache_trusted =
+						host_processor_dual_is_verification_cache_trusted (dual);
+				}
+
 				only_validated = prevalidated;
 				status = host_processor_dual_validate_flash (dual, hash, rsa, pending_pfm,
 					bypass ? NULL : active_pfm, true, !active_pfm || bypass, only_validated, true,
 					true, prevalidated, NULL);
+				dual->verify_cache_trusted = false;
 			}
 		}
 		else {
@@ -858,6 +1025,7 @@ static int host_processor_dual_run_time_verification (struct host_processor *hos
 	else {
 		host_state_manager_set_pfm_dirty (dual->state, false);
 		if (!active_pfm && !pending_pfm) {
+			host_processor_dual_invalidate_digests (dual);
 			dual->filter->clear_flash_dirty_state (dual->filter);
 			host_state_manager_save_inactive_dirty (dual->state, false);
 		}
@@ -888,6 +1056,7 @@ static int host_processor_dual_flash_rollback (struct host_processor *host,
 	struct pfm_read_write_regions rw_list;
 	struct spi_flash *ro_flash;
 	struct spi_flash *rw_flash;
+	struct flash_copy_stream *stream;
 	uint32_t dev_size;
 	int status = 0;
 
@@ -896,6 +1065,8 @@ static int host_processor_dual_flash_rollback (struct host_processor *host,
 	}
 
 	platform_mutex_lock (&dual->lock);
+	host_processor_dual_invalidate_digests (dual);
+	host_processor_dual_invalidate_verification_cache (dual);
 
 	debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_HOST_FW,
 		HOST_LOGGING_ROLLBACK_STARTED, dual->base.port, 0);
@@ -955,8 +1126,15 @@ static int host_processor_dual_flash_rollback (struct host_processor *host,
 				goto return_flash;
 			}
 
-			status = flash_copy_ext_to_blank_and_verify (&ro_flash->base, 0, &rw_flash->base, 0,
-				dev_size);
+			stream = host_flash_manager_get_copy_stream (dual->flash, ro_flash);
+			if (stream) {
+				status = flash_copy_stream_copy_ext_to_blank_and_verify (stream, 0,
+					&rw_flash->base, 0, dev_size);
+			}
+			else {
+				status = flash_copy_ext_to_blank_and_verify (&ro_flash->base, 0, &rw_flash->base,
+					0, dev_size);
+			}
 		}
 
 return_flash:
@@ -1092,6 +1270,8 @@ static int host_processor_dual_apply_recovery_image (struct host_processor *host
 	}
 
 	platform_mutex_lock (&dual->lock);
+	host_processor_dual_invalidate_digests (dual);
+	host_processor_dual_invalidate_verification_cache (dual);
 
 	debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_HOST_FW,
 		HOST_LOGGING_RECOVERY_STARTED, dual->base.port, 0);
@@ -1133,7 +1313,8 @@ static int host_processor_dual_apply_recovery_image (struct host_processor *host
 		goto return_flash;
 	}
 
-	status = active_image->apply_to_flash (active_image, ro_flash);
+	status = active_image->apply_to_flash (active_image, ro_flash,
+		host_flash_manager_get_copy_stream (dual->flash, ro_flash));
 	if (status != 0) {
 		goto return_flash;
 	}
@@ -1181,6 +1362,7 @@ static int host_processor_dual_bypass_mode (struct host_processor *host, bool sw
 	}
 
 	platform_mutex_lock (&dual->lock);
+	host_processor_dual_invalidate_digests (dual);
 	host_processor_dual_force_bypass_mode (dual, swap_flash);
 	host_processor_dual_set_host_flash_access (dual);
 	platform_mutex_unlock (&dual->lock);
@@ -1346,7 +1528,85 @@ int host_processor_dual_init_pulse_reset (struct host_processor_dual *host,
 void host_processor_dual_release (struct host_processor_dual *host)
 {
 	if (host) {
+		platform_free (host->dirty_map);
+		platform_free (host->digests.digest);
 		platform_mutex_free (&host->lock);
 		host_processor_release (&host->base);
 	}
 }
+
+/**
+ * Enable incremental run-time verification of the read/write flash.  Image digests calculated
+ * during run-time verification will be saved so that subsequent verifications only need to check
+ * the flash blocks the SPI filter reports as modified.  This requires a SPI filter that supports
+ * tracking dirty flash blocks.  If the filter doesn't, a full verification is always run.
+ *
+ * @param host The host processor instance to configure.
+ * @param max_images The maximum number of images in a single PFM firmware entry that will have
+ * digests saved.  Flash containing more images than this will always be fully verified.
+ * @param map_length The size of the buffer to use for the SPI filter dirty block map.  Flash blocks
+ * beyond the end of the map will always be verified.
+ *
+ * @return 0 if incremental verification was enabled or an error code.
+ */
+int host_processor_dual_enable_incremental_verification (struct host_processor_dual *host,
+	size_t max_images, size_t map_length)
+{
+	uint8_t (*digest)[SHA256_HASH_LENGTH];
+	uint8_t *dirty_map;
+
+	if ((host == NULL) || (max_images == 0) || (map_length == 0)) {
+		return HOST_PROCESSOR_INVALID_ARGUMENT;
+	}
+
+	digest = platform_calloc (max_images, SHA256_HASH_LENGTH);
+	dirty_map = platform_malloc (map_length);
+	if ((digest == NULL) || (dirty_map == NULL)) {
+		platform_free (digest);
+		platform_free (dirty_map);
+		return HOST_PROCESSOR_NO_MEMORY;
+	}
+
+	platform_mutex_lock (&host->lock);
+
+	platform_free (host->dirty_map);
+	platform_free (host->digests.digest);
+
+	host->dirty_map = dirty_map;
+	host->dirty_map_length = map_length;
+	host->digests.digest = digest;
+	host->digests.max_images = max_images;
+	host->digests.count = 0;
+	host_processor_dual_invalidate_digests (host);
+
+	platform_mutex_unlock (&host->lock);
+
+	return 0;
+}
+
+/**
+ * Use a persistent cache of verified images for read-only flash validation during power-on and
+ * soft resets.  Image digests are cached after each successful validation.  On subsequent resets,
+ * the cached digests are used instead of hashing the flash if the SPI filter shows that it has been
+ * protecting the read-only flash across the reset and has not detected any flash writes.  Any flow
+ * that can modify the read-only flash without validating it will discard the cache.
+ *
+ * @param host The host processor instance to configure.
+ * @param cache The cache of verified images to use.  Set this to null to disable the cache.
+ *
+ * @return 0 if the cache was configured or an error code.
+ */
+int host_processor_dual_set_verification_cache (struct host_processor_dual *host,
+	struct host_fw_verification_cache *cache)
+{
+	if (host == NULL) {
+		return HOST_PROCESSOR_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&host->lock);
+	host->verify_cache = cache;
+	host->verify_cache_trusted = false;
+	platform_mutex_unlock (&host->lock);
+
+	return 0;
+}
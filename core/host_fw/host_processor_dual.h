@@ -8,6 +8,7 @@
 #include "host_processor.h"
 #include "host_control.h"
 #include "host_flash_manager.h"
+#include "host_fw_util.h"
 #include "state_manager/state_manager.h"
 #include "spi_filter/spi_filter_interface.h"
 #include "manifest/pfm/pfm_manager.h"
@@ -28,6 +29,13 @@ struct host_processor_dual {
 	struct recovery_image_manager *recovery;	/**< The manager for recovery of the host processor. */
 	int reset_pulse;							/**< The length of the reset pulse for the host. */
 	platform_mutex lock;						/**< Synchronization for verification routines. */
+	uint8_t *dirty_map;							/**< Buffer for the SPI filter dirty block map. */
+	size_t dirty_map_length;					/**< The length of the dirty block map buffer. */
+	struct host_fw_image_digests digests;		/**< Image digests for the read/write flash. */
+	struct pfm *digests_pfm;					/**< The PFM used to calculate the image digests. */
+	uint32_t digests_pfm_id;					/**< ID of the PFM used to calculate the digests. */
+	struct host_fw_verification_cache *verify_cache;	/**< Cache of verified read-only images. */
+	bool verify_cache_trusted;					/**< Flag indicating the cache can be used. */
 
 	/**
 	 * Private functions for customizing internal flows.
@@ -55,6 +63,11 @@ int host_processor_dual_init_pulse_reset (struct host_processor_dual *host,
 	struct recovery_image_manager *recovery);
 void host_processor_dual_release (struct host_processor_dual *host);
 
+int host_processor_dual_enable_incremental_verification (struct host_processor_dual *host,
+	size_t max_images, size_t map_length);
+int host_processor_dual_set_verification_cache (struct host_processor_dual *host,
+	struct host_fw_verification_cache *cache);
+
 /* Internal functions for use by derived types. */
 int host_processor_dual_init_internal (struct host_processor_dual *host,
 	struct host_control *control, struct host_flash_manager *flash, struct state_manager *state,
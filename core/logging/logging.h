@@ -39,6 +39,14 @@ struct logging_entry_header {
 
 #pragma pack(pop)
 
+/**
+ * Policies for handling new entries when a log has no space left to buffer them.
+ */
+enum logging_overflow_policy {
+	LOGGING_OVERFLOW_BLOCK = 0,		/**< Wait for buffered entries to be stored before adding the entry. */
+	LOGGING_OVERFLOW_DROP,			/**< Discard the new entry without waiting. */
+};
+
 /**
  * Defines the API for logging information.
  */
@@ -101,6 +109,27 @@ struct logging {
 	 */
 	int (*read_contents) (struct logging *logging, uint32_t offset, uint8_t *contents,
 		size_t length);
+
+	/**
+	 * Set how the log handles new entries when there is no space left to buffer them.  Logs that
+	 * never need to wait to add an entry accept either policy.
+	 *
+	 * @param logging The log to configure.
+	 * @param policy The overflow policy to use for new entries.
+	 *
+	 * @return 0 if the policy was set or an error code.
+	 */
+	int (*set_overflow_policy) (struct logging *logging, enum logging_overflow_policy policy);
+
+	/**
+	 * Get the number of entries that were discarded because there was no space to buffer them.
+	 *
+	 * @param logging The log to query.
+	 *
+	 * @return The number of dropped entries or an error code.  Use ROT_IS_ERROR to check the
+	 * return value.
+	 */
+	int (*get_dropped_count) (struct logging *logging);
 };
 
 
@@ -122,6 +151,9 @@ enum {
 	LOGGING_STORAGE_NOT_ALIGNED = LOGGING_ERROR (0x09),		/**< Memory for the log is not aligned correctly. */
 	LOGGING_BAD_ENTRY_LENGTH = LOGGING_ERROR (0x0a),		/**< The entry data is not the right size for the log. */
 	LOGGING_NO_LOG_AVAILABLE = LOGGING_ERROR (0x0b),		/**< There is no log available for the operation. */
+	LOGGING_SET_POLICY_FAILED = LOGGING_ERROR (0x0c),		/**< The overflow policy was not changed. */
+	LOGGING_GET_DROPPED_FAILED = LOGGING_ERROR (0x0d),		/**< The dropped entry count could not be determined. */
+	LOGGING_BUFFER_FULL = LOGGING_ERROR (0x0e),				/**< There is no space to buffer the entry. */
 };
 
 
@@ -14,6 +14,49 @@
 #define	LOGGING_FLASH_TERMINATOR	(1U << 15)
 
 
+/**
+ * Remove a sector from the log in preparation for erasing it.
+ *
+ * @param logging The log being updated.
+ * @param sector The sector that will be erased.
+ */
+static void logging_flash_release_sector (struct logging_flash *logging, int sector)
+{
+	logging->flash_used[sector] = 0;
+
+	if (logging->log_start == sector) {
+		int next_sector = (logging->log_start + 1) % LOGGING_FLASH_SECTORS;
+		if (logging->flash_used[next_sector] != 0) {
+			logging->log_start = next_sector;
+		}
+	}
+}
+
+/**
+ * Update the log state after a buffer has been completely written to flash.
+ *
+ * @param logging The log being updated.
+ * @param sector The sector that was written.
+ * @param remain The unused space in the buffer that was written.
+ * @param terminated Flag indicating if the buffer was terminated.
+ */
+static void logging_flash_complete_buffer (struct logging_flash *logging, int sector, int remain,
+	bool terminated)
+{
+	if (((remain < (int) sizeof (struct logging_entry_header)) || terminated) &&
+		(FLASH_SECTOR_OFFSET (logging->next_addr) != 0)) {
+		logging->next_addr = FLASH_SECTOR_BASE (logging->next_addr) + FLASH_SECTOR_SIZE;
+	}
+
+	if (logging->next_addr >= (logging->base_addr + LOGGING_FLASH_AREA_LEN)) {
+		logging->next_addr = logging->base_addr;
+	}
+
+	if (terminated) {
+		logging->flash_used[sector] -= sizeof (struct logging_entry_header);
+	}
+}
+
 /**
  * Save the entry buffer to flash.
  *
@@ -38,14 +81,7 @@ static int logging_flash_save_buffer (struct logging_flash *logging)
 				return status;
 			}
 
-			logging->flash_used[curr_sector_num] = 0;
-
-			if (logging->log_start == curr_sector_num) {
-				int next_sector = (logging->log_start + 1) % LOGGING_FLASH_SECTORS;
-				if (logging->flash_used[next_sector] != 0) {
-					logging->log_start = next_sector;
-				}
-			}
+			logging_flash_release_sector (logging, curr_sector_num);
 		}
 
 		status = spi_flash_write (logging->flash, logging->next_addr, logging->entry_buffer,
@@ -65,22 +101,12 @@ static int logging_flash_save_buffer (struct logging_flash *logging)
 		logging->flash_used[curr_sector_num] += write_len;
 
 		if (status == 0) {
-			if (((logging->write_remain < sizeof (struct logging_entry_header)) ||
-				logging->terminated) && (FLASH_SECTOR_OFFSET (logging->next_addr) != 0)) {
-				logging->next_addr = FLASH_SECTOR_BASE (logging->next_addr) + FLASH_SECTOR_SIZE;
-			}
-
-			if (logging->next_addr >= (logging->base_addr + LOGGING_FLASH_AREA_LEN)) {
-				logging->next_addr = logging->base_addr;
-			}
+			logging_flash_complete_buffer (logging, curr_sector_num, logging->write_remain,
+				logging->terminated);
 
 			logging->next_write = logging->entry_buffer;
-			logging->write_remain =
-				sizeof (logging->entry_buffer) - FLASH_SECTOR_OFFSET (logging->next_addr);
-			if (logging->terminated) {
-				logging->flash_used[curr_sector_num] -= sizeof (struct logging_entry_header);
-				logging->terminated = false;
-			}
+			logging->write_remain = FLASH_SECTOR_SIZE - FLASH_SECTOR_OFFSET (logging->next_addr);
+			logging->terminated = false;
 		}
 		else {
 			/* The write was not fully complete, so move the remaining data to be at the beginning
@@ -94,6 +120,114 @@ static int logging_flash_save_buffer (struct logging_flash *logging)
 	return status;
 }
 
+/**
+ * Hand off the entry buffer to be written to flash by the next flush.  New entries will be added
+ * to the other buffer.
+ *
+ * @param logging The log to update.
+ *
+ * @return 0 if the entry buffer is available for new entries or LOGGING_BUFFER_FULL if there is
+ * already a buffer waiting to be written to flash.
+ */
+static int logging_flash_queue_buffer (struct logging_flash *logging)
+{
+	if (logging->next_write == logging->entry_buffer) {
+		return 0;
+	}
+
+	if (logging->pending != NULL) {
+		return LOGGING_BUFFER_FULL;
+	}
+
+	logging->pending = logging->entry_buffer;
+	logging->pending_len = logging->next_write - logging->entry_buffer;
+	logging->pending_remain = logging->write_remain;
+	logging->pending_terminated = logging->terminated;
+
+	/* New entries will start wherever the pending buffer ends on flash.  That will be the next
+	 * sector if the pending buffer fills the current one. */
+	if (logging->terminated ||
+		(logging->write_remain < (int) sizeof (struct logging_entry_header))) {
+		logging->write_remain = FLASH_SECTOR_SIZE;
+	}
+
+	logging->entry_buffer = (logging->entry_buffer == logging->buffer[0]) ?
+		logging->buffer[1] : logging->buffer[0];
+	logging->next_write = logging->entry_buffer;
+	logging->terminated = false;
+
+	return 0;
+}
+
+/**
+ * Write the pending buffer to flash.  The log lock is released while flash is being updated so new
+ * entries can continue to be added.  Reading the log contents requires the flush lock, so no reads
+ * will happen while flash is being updated.  The caller must hold both the flush lock and the log
+ * lock.
+ *
+ * @param logging The log that should be saved.
+ *
+ * @return 0 if the data was successfully saved or an error code.
+ */
+static int logging_flash_write_pending (struct logging_flash *logging)
+{
+	uint32_t addr = logging->next_addr;
+	uint8_t *buffer = logging->pending;
+	size_t write_len = logging->pending_len;
+	int curr_sector_num;
+	int status;
+
+	if (buffer == NULL) {
+		return 0;
+	}
+
+	curr_sector_num = (FLASH_SECTOR_BASE (addr) - logging->base_addr) / FLASH_SECTOR_SIZE;
+
+	platform_mutex_unlock (&logging->lock);
+
+	if (FLASH_SECTOR_OFFSET (addr) == 0) {
+		status = spi_flash_sector_erase (logging->flash, addr);
+
+		platform_mutex_lock (&logging->lock);
+		if (status != 0) {
+			return status;
+		}
+
+		logging_flash_release_sector (logging, curr_sector_num);
+		platform_mutex_unlock (&logging->lock);
+	}
+
+	status = spi_flash_write (logging->flash, addr, buffer, write_len);
+
+	platform_mutex_lock (&logging->lock);
+
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	else if ((size_t) status != write_len) {
+		write_len = status;
+		status = LOGGING_INCOMPLETE_FLUSH;
+	}
+	else {
+		status = 0;
+	}
+
+	logging->next_addr += write_len;
+	logging->flash_used[curr_sector_num] += write_len;
+
+	if (status == 0) {
+		logging_flash_complete_buffer (logging, curr_sector_num, logging->pending_remain,
+			logging->pending_terminated);
+		logging->pending = NULL;
+	}
+	else {
+		memmove (buffer, &buffer[write_len], logging->pending_len - write_len);
+		logging->pending_len -= write_len;
+	}
+
+	return status;
+}
+
 /**
  * Write an entry header to the entry buffer.  It assumed there is sufficient space for the header.
  *
@@ -117,14 +251,14 @@ static void logging_flash_write_header (struct logging_flash *logging, uint16_t
 static int logging_flash_create_entry (struct logging *logging, uint8_t *entry, size_t length)
 {
 	struct logging_flash *flash_log = (struct logging_flash*) logging;
+	bool queued = false;
 	int status;
 
 	if ((flash_log == NULL) || (entry == NULL)) {
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
-	if ((length == 0) ||
-		((length + sizeof (struct logging_entry_header) > sizeof (flash_log->entry_buffer)))) {
+	if ((length == 0) || ((length + sizeof (struct logging_entry_header) > FLASH_SECTOR_SIZE))) {
 		return LOGGING_BAD_ENTRY_LENGTH;
 	}
 
@@ -139,7 +273,19 @@ static int logging_flash_create_entry (struct logging *logging, uint8_t *entry,
 			flash_log->terminated = true;
 		}
 
-		status = logging_flash_save_buffer (flash_log);
+		if (flash_log->policy == LOGGING_OVERFLOW_DROP) {
+			status = logging_flash_queue_buffer (flash_log);
+			if (status != 0) {
+				flash_log->dropped++;
+			}
+			else {
+				queued = (flash_log->pending != NULL);
+			}
+		}
+		else {
+			status = logging_flash_save_buffer (flash_log);
+		}
+
 		if (status != 0) {
 			platform_mutex_unlock (&flash_log->lock);
 			return status;
@@ -153,6 +299,11 @@ static int logging_flash_create_entry (struct logging *logging, uint8_t *entry,
 
 	platform_mutex_unlock (&flash_log->lock);
 
+	if (queued) {
+		observable_notify_observers_with_ptr (&flash_log->observable,
+			offsetof (struct logging_flash_observer, on_flush_needed), flash_log);
+	}
+
 	return 0;
 }
 
@@ -165,9 +316,22 @@ static int logging_flash_flush (struct logging *logging)
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
+	platform_mutex_lock (&flash_log->flush_lock);
 	platform_mutex_lock (&flash_log->lock);
-	status = logging_flash_save_buffer (flash_log);
+
+	if (flash_log->policy == LOGGING_OVERFLOW_DROP) {
+		status = logging_flash_write_pending (flash_log);
+		if (status == 0) {
+			logging_flash_queue_buffer (flash_log);
+			status = logging_flash_write_pending (flash_log);
+		}
+	}
+	else {
+		status = logging_flash_save_buffer (flash_log);
+	}
+
 	platform_mutex_unlock (&flash_log->lock);
+	platform_mutex_unlock (&flash_log->flush_lock);
 
 	return status;
 }
@@ -181,6 +345,7 @@ static int logging_flash_clear (struct logging *logging)
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
+	platform_mutex_lock (&flash_log->flush_lock);
 	platform_mutex_lock (&flash_log->lock);
 
 	status = spi_flash_block_erase (flash_log->flash, flash_log->base_addr);
@@ -194,11 +359,13 @@ static int logging_flash_clear (struct logging *logging)
 
 	flash_log->next_addr = flash_log->base_addr;
 	flash_log->next_write = flash_log->entry_buffer;
-	flash_log->write_remain = sizeof (flash_log->entry_buffer);
+	flash_log->write_remain = FLASH_SECTOR_SIZE;
 	flash_log->terminated = false;
+	flash_log->pending = NULL;
 
 exit:
 	platform_mutex_unlock (&flash_log->lock);
+	platform_mutex_unlock (&flash_log->flush_lock);
 	return status;
 }
 
@@ -218,6 +385,13 @@ static int logging_flash_get_size (struct logging *logging)
 		log_size += flash_log->flash_used[sector];
 	}
 
+	if (flash_log->pending != NULL) {
+		log_size += flash_log->pending_len;
+		if (flash_log->pending_terminated) {
+			log_size -= sizeof (struct logging_entry_header);
+		}
+	}
+
 	log_size += (flash_log->next_write - flash_log->entry_buffer);
 	if (flash_log->terminated) {
 		log_size -= sizeof (struct logging_entry_header);
@@ -228,6 +402,87 @@ static int logging_flash_get_size (struct logging *logging)
 	return log_size;
 }
 
+/**
+ * Copy entries from a buffer that has not been written to flash.
+ *
+ * @param buffer The buffer containing the entries.
+ * @param buffer_len The length of the data in the buffer.
+ * @param terminated Flag indicating if the buffer has been terminated.
+ * @param offset The offset within the buffer to start reading.  This will be reduced by the amount
+ * of buffered data that was skipped.
+ * @param contents Output buffer for the entries.
+ * @param length The maximum length of data to read.
+ *
+ * @return The number of bytes read from the buffer.
+ */
+static int logging_flash_read_buffer (const uint8_t *buffer, size_t buffer_len, bool terminated,
+	uint32_t *offset, uint8_t *contents, size_t length)
+{
+	size_t read_offset;
+	size_t read_len;
+
+	if (terminated) {
+		buffer_len -= sizeof (struct logging_entry_header);
+	}
+
+	read_offset = (*offset < buffer_len) ? *offset : buffer_len;
+	read_len = (length < (buffer_len - read_offset)) ? length : (buffer_len - read_offset);
+
+	memcpy (contents, buffer + read_offset, read_len);
+	*offset -= read_offset;
+
+	return read_len;
+}
+
+static int logging_flash_set_overflow_policy (struct logging *logging,
+	enum logging_overflow_policy policy)
+{
+	struct logging_flash *flash_log = (struct logging_flash*) logging;
+	int status = 0;
+
+	if (flash_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if ((policy != LOGGING_OVERFLOW_BLOCK) && (policy != LOGGING_OVERFLOW_DROP)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash_log->flush_lock);
+	platform_mutex_lock (&flash_log->lock);
+
+	/* Entries are only written from the active buffer when blocking, so anything waiting to be
+	 * flushed must be stored first. */
+	if (policy == LOGGING_OVERFLOW_BLOCK) {
+		status = logging_flash_write_pending (flash_log);
+	}
+
+	if (status == 0) {
+		flash_log->policy = policy;
+	}
+
+	platform_mutex_unlock (&flash_log->lock);
+	platform_mutex_unlock (&flash_log->flush_lock);
+
+	return status;
+}
+
+static int logging_flash_get_dropped_count (struct logging *logging)
+{
+	struct logging_flash *flash_log = (struct logging_flash*) logging;
+	int dropped;
+
+	if (flash_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash_log->lock);
+	dropped = flash_log->dropped;
+	platform_mutex_unlock (&flash_log->lock);
+
+	return dropped;
+}
+
 static int logging_flash_read_contents (struct logging *logging, uint32_t offset, uint8_t *contents,
 	size_t length)
 {
@@ -243,6 +498,7 @@ static int logging_flash_read_contents (struct logging *logging, uint32_t offset
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
+	platform_mutex_lock (&flash_log->flush_lock);
 	platform_mutex_lock (&flash_log->lock);
 
 	i = flash_log->log_start;
@@ -258,6 +514,7 @@ static int logging_flash_read_contents (struct logging *logging, uint32_t offset
 				flash_log->base_addr + (FLASH_SECTOR_SIZE * i) + read_offset, contents, read_len);
 			if (status != 0) {
 				platform_mutex_unlock (&flash_log->lock);
+				platform_mutex_unlock (&flash_log->flush_lock);
 				return status;
 			}
 		}
@@ -272,17 +529,20 @@ static int logging_flash_read_contents (struct logging *logging, uint32_t offset
 	}
 
 	/* After reading all data from flash, read buffered entries that haven't been flushed yet. */
-	read_len = flash_log->next_write - flash_log->entry_buffer;
-	if (flash_log->terminated) {
-		read_len -= sizeof (struct logging_entry_header);
+	if (flash_log->pending != NULL) {
+		read_len = logging_flash_read_buffer (flash_log->pending, flash_log->pending_len,
+			flash_log->pending_terminated, &offset, contents, length);
+		bytes_read += read_len;
+		contents += read_len;
+		length -= read_len;
 	}
-	read_offset = (offset < read_len) ? offset : read_len;
-	read_len = (length < (read_len - read_offset)) ? length : (read_len - read_offset);
 
-	memcpy (contents, flash_log->entry_buffer + read_offset, read_len);
-	bytes_read += read_len;
+	bytes_read += logging_flash_read_buffer (flash_log->entry_buffer,
+		flash_log->next_write - flash_log->entry_buffer, flash_log->terminated, &offset, contents,
+		length);
 
 	platform_mutex_unlock (&flash_log->lock);
+	platform_mutex_unlock (&flash_log->flush_lock);
 
 	return bytes_read;
 }
@@ -321,12 +581,14 @@ int logging_flash_init (struct logging_flash *logging, struct spi_flash *flash,
 
 	memset (logging, 0, sizeof (struct logging_flash));
 
+	logging->entry_buffer = logging->buffer[0];
+
 	flash_addr = base_addr;
-	end = logging->entry_buffer + sizeof (logging->entry_buffer);
+	end = logging->entry_buffer + FLASH_SECTOR_SIZE;
 
 	for (curr_sector_num = 0; curr_sector_num < LOGGING_FLASH_SECTORS; ++curr_sector_num) {
 		status = spi_flash_read (flash, base_addr + (FLASH_SECTOR_SIZE * curr_sector_num),
-			logging->entry_buffer, sizeof (logging->entry_buffer));
+			logging->entry_buffer, FLASH_SECTOR_SIZE);
 		if (status != 0) {
 			return status;
 		}
@@ -414,18 +676,33 @@ int logging_flash_init (struct logging_flash *logging, struct spi_flash *flash,
 		return status;
 	}
 
+	status = platform_mutex_init (&logging->flush_lock);
+	if (status != 0) {
+		platform_mutex_free (&logging->lock);
+		return status;
+	}
+
+	status = observable_init (&logging->observable);
+	if (status != 0) {
+		platform_mutex_free (&logging->lock);
+		platform_mutex_free (&logging->flush_lock);
+		return status;
+	}
+
 	logging->flash = flash;
 	logging->base_addr = base_addr;
 	logging->next_addr = flash_addr;
 	logging->next_entry_id = entry_id;
 	logging->next_write = logging->entry_buffer;
-	logging->write_remain = sizeof (logging->entry_buffer) - FLASH_SECTOR_OFFSET (flash_addr);
+	logging->write_remain = FLASH_SECTOR_SIZE - FLASH_SECTOR_OFFSET (flash_addr);
 
 	logging->base.create_entry = logging_flash_create_entry;
 	logging->base.flush = logging_flash_flush;
 	logging->base.clear = logging_flash_clear;
 	logging->base.get_size = logging_flash_get_size;
 	logging->base.read_contents = logging_flash_read_contents;
+	logging->base.set_overflow_policy = logging_flash_set_overflow_policy;
+	logging->base.get_dropped_count = logging_flash_get_dropped_count;
 
 	return 0;
 }
@@ -440,5 +717,43 @@ void logging_flash_release (struct logging_flash *logging)
 {
 	if (logging) {
 		platform_mutex_free (&logging->lock);
+		platform_mutex_free (&logging->flush_lock);
+		observable_release (&logging->observable);
+	}
+}
+
+/**
+ * Add an observer for flash log notifications.
+ *
+ * @param logging The log to register with.
+ * @param observer The observer to add.
+ *
+ * @return 0 if the observer was successfully added or an error code.
+ */
+int logging_flash_add_observer (struct logging_flash *logging,
+	struct logging_flash_observer *observer)
+{
+	if (logging == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
 	}
+
+	return observable_add_observer (&logging->observable, observer);
+}
+
+/**
+ * Remove an observer from flash log notifications.
+ *
+ * @param logging The log to deregister from.
+ * @param observer The observer to remove.
+ *
+ * @return 0 if the observer was successfully removed or an error code.
+ */
+int logging_flash_remove_observer (struct logging_flash *logging,
+	struct logging_flash_observer *observer)
+{
+	if (logging == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return observable_remove_observer (&logging->observable, observer);
 }
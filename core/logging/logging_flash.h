@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include "logging.h"
 #include "platform.h"
+#include "common/observable.h"
 #include "flash/flash_common.h"
 #include "flash/spi_flash.h"
 
@@ -19,27 +20,67 @@
 #define LOGGING_FLASH_SECTORS 		(LOGGING_FLASH_AREA_LEN / FLASH_SECTOR_SIZE)
 
 
+struct logging_flash;
+
+/**
+ * Interface for notifying observers of flash log events.  Unwanted event notifications will be set
+ * to null.
+ */
+struct logging_flash_observer {
+	/**
+	 * Notification that a full buffer of log entries has been handed off to be written to flash.
+	 * The entries will be written on the next flush of the log.
+	 *
+	 * Arguments sent with this notification will not be null.
+	 *
+	 * @param observer The observer being notified.
+	 * @param logging The log that needs to be flushed.
+	 */
+	void (*on_flush_needed) (struct logging_flash_observer *observer,
+		struct logging_flash *logging);
+};
+
 /**
  * A log that will persistently store entries on flash.
+ *
+ * Entries are buffered in RAM until they are flushed to flash.  By default, the buffer is written
+ * to flash by the task adding the entry when the buffer is full.  With the LOGGING_OVERFLOW_DROP
+ * policy, a full buffer is instead handed off to be written by the next flush while new entries are
+ * added to a second buffer, so adding entries never waits on flash.  Observers are notified each
+ * time a buffer is handed off.  If both buffers are full, new entries are dropped.
  */
 struct logging_flash {
 	struct logging base;						/**< The base logging instance. */
 	struct spi_flash *flash;					/**< The flash where log entries are stored. */
 	uint32_t base_addr;							/**< The base address of the log data on flash. */
 	platform_mutex lock;						/**< Synchronization for log accesses. */
-	uint8_t entry_buffer[FLASH_SECTOR_SIZE];	/**< Buffered entries waiting to be flushed. */
+	platform_mutex flush_lock;					/**< Synchronization for flash updates. */
+	uint8_t buffer[2][FLASH_SECTOR_SIZE];		/**< Memory for buffering log entries. */
+	uint8_t *entry_buffer;						/**< Buffered entries waiting to be flushed. */
 	uint8_t *next_write;						/**< The next write position in the entry buffer. */
 	int write_remain;							/**< Remaining space in the entry buffer. */
 	bool terminated;							/**< Entry buffer has been terminated. */
+	uint8_t *pending;							/**< Full buffer waiting to be written to flash. */
+	size_t pending_len;							/**< Length of the data in the pending buffer. */
+	int pending_remain;							/**< Unused space in the pending buffer. */
+	bool pending_terminated;					/**< Pending buffer has been terminated. */
+	enum logging_overflow_policy policy;		/**< Handling for entries when the buffer is full. */
+	uint32_t dropped;							/**< Number of entries that have been dropped. */
 	uint32_t next_entry_id;						/**< Next ID to assign to a log entry. */
 	int flash_used[LOGGING_FLASH_SECTORS];		/**< Number of valid bytes stored in each sector. */
 	uint32_t next_addr;							/**< Next flash address to write to. */
 	int log_start;								/**< The sector that contains the first entries. */
+	struct observable observable;				/**< Observer manager for the log. */
 };
 
 
 int logging_flash_init (struct logging_flash *logging, struct spi_flash *flash, uint32_t base_addr);
 void logging_flash_release (struct logging_flash *logging);
 
+int logging_flash_add_observer (struct logging_flash *logging,
+	struct logging_flash_observer *observer);
+int logging_flash_remove_observer (struct logging_flash *logging,
+	struct logging_flash_observer *observer);
+
 
 #endif /* LOGGING_FLASH_H_ */
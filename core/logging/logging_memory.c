@@ -133,6 +133,33 @@ static int logging_memory_read_contents (struct logging *logging, uint32_t offse
 	return bytes_read;
 }
 
+static int logging_memory_set_overflow_policy (struct logging *logging,
+	enum logging_overflow_policy policy)
+{
+	if (logging == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	/* Entries are never buffered, so there is never a need to wait or drop entries. */
+	switch (policy) {
+		case LOGGING_OVERFLOW_BLOCK:
+		case LOGGING_OVERFLOW_DROP:
+			return 0;
+
+		default:
+			return LOGGING_INVALID_ARGUMENT;
+	}
+}
+
+static int logging_memory_get_dropped_count (struct logging *logging)
+{
+	if (logging == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return 0;
+}
+
 /**
  * Initialize a log that store contents in volatile memory.
  *
@@ -174,6 +201,8 @@ int logging_memory_init (struct logging_memory *logging, size_t entry_count, siz
 	logging->base.clear = logging_memory_clear;
 	logging->base.get_size = logging_memory_get_size;
 	logging->base.read_contents = logging_memory_read_contents;
+	logging->base.set_overflow_policy = logging_memory_set_overflow_policy;
+	logging->base.get_dropped_count = logging_memory_get_dropped_count;
 
 	return 0;
 }
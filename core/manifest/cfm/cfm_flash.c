@@ -119,9 +119,16 @@ static int cfm_flash_get_supported_component_ids (struct cfm *cfm,
 		return status;
 	}
 
-	ids = platform_calloc (components_header.components_count, sizeof (uint32_t));
+	status = manifest_flash_begin_query (&cfm_flash->base_flash);
+	if (status != 0) {
+		return status;
+	}
+
+	ids = manifest_flash_alloc (&cfm_flash->base_flash, components_header.components_count,
+		sizeof (uint32_t));
 
 	if (ids == NULL) {
+		manifest_flash_end_query (&cfm_flash->base_flash, false);
 		return CFM_NO_MEMORY;
 	}
 
@@ -132,13 +139,16 @@ static int cfm_flash_get_supported_component_ids (struct cfm *cfm,
 			(uint8_t*) &component_header, sizeof (component_header));
 
 		if (status != 0) {
-			platform_free (ids);
+			manifest_flash_free (&cfm_flash->base_flash, ids);
+			manifest_flash_end_query (&cfm_flash->base_flash, false);
 			return status;
 		}
 
 		ids[i] = component_header.component_id;
 	}
 
+	manifest_flash_end_query (&cfm_flash->base_flash, true);
+
 	id_list->ids = ids;
 	id_list->count = components_header.components_count;
 
@@ -147,7 +157,13 @@ static int cfm_flash_get_supported_component_ids (struct cfm *cfm,
 
 static void cfm_flash_free_component_ids (struct cfm *cfm, struct cfm_component_ids *id_list)
 {
+	struct cfm_flash *cfm_flash = (struct cfm_flash*) cfm;
+
 	if (id_list != NULL) {
+		if (cfm_flash && manifest_flash_free_result (&cfm_flash->base_flash, id_list->ids)) {
+			return;
+		}
+
 		platform_free ((void*) id_list->ids);
 	}
 }
@@ -175,7 +191,7 @@ static int cfm_flash_process_signed_img (struct manifest_flash *cfm_flash, uint3
 		return status;
 	}
 
-	digest = platform_calloc (img_header.digest_length, sizeof (uint8_t));
+	digest = manifest_flash_alloc (cfm_flash, img_header.digest_length, sizeof (uint8_t));
 
 	if (digest == NULL) {
 		return CFM_NO_MEMORY;
@@ -186,7 +202,7 @@ static int cfm_flash_process_signed_img (struct manifest_flash *cfm_flash, uint3
 	status = spi_flash_read (cfm_flash->flash, *addr, (uint8_t*) digest, img_header.digest_length);
 
 	if (status != 0) {
-		platform_free (digest);
+		manifest_flash_free (cfm_flash, digest);
 		return status;
 	}
 
@@ -224,14 +240,15 @@ static int cfm_flash_process_fw (struct manifest_flash *cfm_flash, uint32_t *add
 		return status;
 	}
 
-	fw_version_id = platform_calloc (fw_header.version_length + 1, sizeof (char));
+	fw_version_id = manifest_flash_alloc (cfm_flash, fw_header.version_length + 1, sizeof (char));
 
 	if (fw_version_id == NULL) {
 		status = CFM_NO_MEMORY;
 		goto cleanup;
 	}
 
-	imgs = platform_calloc (fw_header.img_count, sizeof (struct cfm_component_signed_img));
+	imgs = manifest_flash_alloc (cfm_flash, fw_header.img_count,
+		sizeof (struct cfm_component_signed_img));
 
 	if (imgs == NULL) {
 		status = CFM_NO_MEMORY;
@@ -270,8 +287,8 @@ static int cfm_flash_process_fw (struct manifest_flash *cfm_flash, uint32_t *add
 	return 0;
 
 cleanup:
-	platform_free (fw_version_id);
-	platform_free (imgs);
+	manifest_flash_free (cfm_flash, fw_version_id);
+	manifest_flash_free (cfm_flash, imgs);
 
 	return status;
 }
@@ -324,9 +341,15 @@ static int cfm_flash_get_component (struct cfm *cfm, uint32_t component_id,
 		}
 
 		if (component_header.component_id == component_id) {
-			fw = platform_calloc (component_header.fw_count,
+			status = manifest_flash_begin_query (&cfm_flash->base_flash);
+			if (status != 0) {
+				return status;
+			}
+
+			fw = manifest_flash_alloc (&cfm_flash->base_flash, component_header.fw_count,
 				sizeof (struct cfm_component_firmware));
 			if (fw == NULL) {
+				manifest_flash_end_query (&cfm_flash->base_flash, false);
 				return CFM_NO_MEMORY;
 			}
 
@@ -337,23 +360,28 @@ static int cfm_flash_get_component (struct cfm *cfm, uint32_t component_id,
 
 				if (status != 0) {
 					for (i_fw_free = 0; i_fw_free < i_fw; ++i_fw_free) {
-						platform_free ((void*) fw[i_fw_free].fw_version_id);
+						manifest_flash_free (&cfm_flash->base_flash,
+							(void*) fw[i_fw_free].fw_version_id);
 
 						if (fw[i_fw_free].imgs != NULL) {
 							for (i_img_free = 0; i_img_free < fw[i_fw_free].img_count;
 								++i_img_free) {
-								platform_free ((void*) fw[i_fw_free].imgs[i_img_free].digest);
+								manifest_flash_free (&cfm_flash->base_flash,
+									(void*) fw[i_fw_free].imgs[i_img_free].digest);
 							}
 
-							platform_free (fw[i_fw_free].imgs);
+							manifest_flash_free (&cfm_flash->base_flash, fw[i_fw_free].imgs);
 						}
 					}
 
-					platform_free (fw);
+					manifest_flash_free (&cfm_flash->base_flash, fw);
+					manifest_flash_end_query (&cfm_flash->base_flash, false);
 					return status;
 				}
 			}
 
+			manifest_flash_end_query (&cfm_flash->base_flash, true);
+
 			component->component_id = component_header.component_id;
 			component->fw = fw;
 			component->fw_count = component_header.fw_count;
@@ -370,9 +398,14 @@ static int cfm_flash_get_component (struct cfm *cfm, uint32_t component_id,
 
 static void cfm_flash_free_component (struct cfm *cfm, struct cfm_component *component)
 {
+	struct cfm_flash *cfm_flash = (struct cfm_flash*) cfm;
 	int i_fw, i_img;
 
 	if ((component != NULL) && component->fw != NULL) {
+		if (cfm_flash && manifest_flash_free_result (&cfm_flash->base_flash, component->fw)) {
+			return;
+		}
+
 		for (i_fw = 0; i_fw < component->fw_count; ++i_fw) {
 			platform_free ((void*) component->fw[i_fw].fw_version_id);
 
@@ -0,0 +1,454 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "manifest_arena.h"
+#include "manifest.h"
+
+
+/**
+ * Marker for no blocks allocated in the arena.
+ */
+#define	MANIFEST_ARENA_NO_BLOCK		((size_t) -1)
+
+/**
+ * Alignment of allocations from the arena.
+ */
+#define	MANIFEST_ARENA_ALIGNMENT	8
+
+/**
+ * Round a length up to the arena alignment.
+ */
+#define	MANIFEST_ARENA_ALIGN(x)		\
+	(((x) + (MANIFEST_ARENA_ALIGNMENT - 1)) & ~((size_t) MANIFEST_ARENA_ALIGNMENT - 1))
+
+/**
+ * Header placed in the arena before the data for each query result.
+ */
+struct manifest_arena_block {
+	uint32_t prev;						/**< Offset of the previous block. */
+	uint32_t live;						/**< Flag indicating the block has not been freed. */
+};
+
+/**
+ * Header placed before memory for a query result that was allocated from the heap because there
+ * was not enough space in the arena.
+ */
+struct manifest_arena_heap {
+	struct manifest_arena_heap *next;	/**< The next heap allocation for the same result. */
+};
+
+/**
+ * Length of the header for heap allocations, keeping the data aligned.
+ */
+#define	MANIFEST_ARENA_HEAP_HEADER_LEN	\
+	MANIFEST_ARENA_ALIGN (sizeof (struct manifest_arena_heap))
+
+/**
+ * Heap allocations that belong to a single query result.
+ */
+struct manifest_arena_spill {
+	struct manifest_arena_spill *next;	/**< The next result with heap allocations. */
+	const void *result;					/**< The first allocation made for the result. */
+	size_t block;						/**< Offset of the result block in the arena, if any. */
+	struct manifest_arena_heap *heap;	/**< The heap allocations for the result. */
+};
+
+
+/**
+ * Initialize an arena for manifest query results.  The storage for the arena is allocated once
+ * during initialization.
+ *
+ * @param arena The arena to initialize.
+ * @param size The amount of storage to allocate for the arena.
+ *
+ * @return 0 if the arena was successfully initialized or an error code.
+ */
+int manifest_arena_init (struct manifest_arena *arena, size_t size)
+{
+	int status;
+
+	if ((arena == NULL) || (size < (sizeof (struct manifest_arena_block) * 2))) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+
+#if SIZE_MAX > UINT32_MAX
+	if (size > UINT32_MAX) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+#endif
+
+	memset (arena, 0, sizeof (struct manifest_arena));
+
+	arena->buffer = platform_malloc (MANIFEST_ARENA_ALIGN (size));
+	if (arena->buffer == NULL) {
+		return MANIFEST_NO_MEMORY;
+	}
+
+	status = platform_mutex_init (&arena->lock);
+	if (status != 0) {
+		platform_free (arena->buffer);
+		return status;
+	}
+
+	arena->size = MANIFEST_ARENA_ALIGN (size);
+	arena->top = MANIFEST_ARENA_NO_BLOCK;
+
+	return 0;
+}
+
+/**
+ * Free the heap allocations that belong to a query result.
+ *
+ * @param spill The heap allocations to free.
+ */
+static void manifest_arena_free_spill (struct manifest_arena_spill *spill)
+{
+	struct manifest_arena_heap *heap;
+
+	while (spill->heap) {
+		heap = spill->heap;
+		spill->heap = heap->next;
+		platform_free (heap);
+	}
+
+	platform_free (spill);
+}
+
+/**
+ * Release the resources used by a manifest arena.  Any query results still allocated from the
+ * arena will no longer be valid.
+ *
+ * @param arena The arena to release.
+ */
+void manifest_arena_release (struct manifest_arena *arena)
+{
+	struct manifest_arena_spill *spill;
+
+	if (arena) {
+		while (arena->spilled) {
+			spill = arena->spilled;
+			arena->spilled = spill->next;
+			manifest_arena_free_spill (spill);
+		}
+
+		platform_mutex_free (&arena->lock);
+		platform_free (arena->buffer);
+	}
+}
+
+/**
+ * Start a new query result in the arena.  All allocations made until the result is ended will be
+ * part of the same block in the arena.  The arena is locked until the result is ended.
+ *
+ * @param arena The arena to use for the query result.
+ *
+ * @return 0 if a new query result was started or an error code.
+ */
+int manifest_arena_begin (struct manifest_arena *arena)
+{
+	struct manifest_arena_block *block;
+
+	if (arena == NULL) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&arena->lock);
+
+	arena->spill = NULL;
+	arena->first = NULL;
+	arena->in_arena = ((arena->size - arena->used) >= sizeof (struct manifest_arena_block));
+
+	if (arena->in_arena) {
+		block = (struct manifest_arena_block*) &arena->buffer[arena->used];
+		block->prev = arena->top;
+		block->live = 1;
+
+		arena->top = arena->used;
+		arena->used += sizeof (struct manifest_arena_block);
+	}
+
+	return 0;
+}
+
+/**
+ * Allocate zeroed memory from the heap for the query result currently being built.
+ *
+ * @param arena The arena being used for the query result.
+ * @param length The number of bytes to allocate.
+ *
+ * @return The allocated memory or null if the allocation failed.
+ */
+static void* manifest_arena_alloc_heap (struct manifest_arena *arena, size_t length)
+{
+	struct manifest_arena_heap *heap;
+
+	if (length > (SIZE_MAX - MANIFEST_ARENA_HEAP_HEADER_LEN)) {
+		return NULL;
+	}
+
+	if (arena->spill == NULL) {
+		arena->spill = platform_calloc (1, sizeof (struct manifest_arena_spill));
+		if (arena->spill == NULL) {
+			return NULL;
+		}
+
+		arena->spill->block = (arena->in_arena) ? arena->top : MANIFEST_ARENA_NO_BLOCK;
+	}
+
+	heap = platform_calloc (1, MANIFEST_ARENA_HEAP_HEADER_LEN + length);
+	if (heap == NULL) {
+		return NULL;
+	}
+
+	heap->next = arena->spill->heap;
+	arena->spill->heap = heap;
+	arena->failures++;
+
+	return ((uint8_t*) heap) + MANIFEST_ARENA_HEAP_HEADER_LEN;
+}
+
+/**
+ * Allocate zeroed memory for the query result currently being built.  Zero length allocations will
+ * still reserve space in the arena.  If there is not enough space in the arena, the memory will be
+ * allocated from the heap.
+ *
+ * @param arena The arena to allocate from.
+ * @param length The number of bytes to allocate.
+ *
+ * @return The allocated memory or null if the allocation failed.
+ */
+void* manifest_arena_alloc (struct manifest_arena *arena, size_t length)
+{
+	uint8_t *data;
+
+	if (arena == NULL) {
+		return NULL;
+	}
+
+	length = (length == 0) ? MANIFEST_ARENA_ALIGNMENT : MANIFEST_ARENA_ALIGN (length);
+	if (!arena->in_arena || (length > (arena->size - arena->used))) {
+		data = manifest_arena_alloc_heap (arena, length);
+	}
+	else {
+		data = &arena->buffer[arena->used];
+		memset (data, 0, length);
+
+		arena->used += length;
+		if (arena->used > arena->peak) {
+			arena->peak = arena->used;
+		}
+	}
+
+	if (arena->first == NULL) {
+		arena->first = data;
+	}
+
+	return data;
+}
+
+/**
+ * Remove freed blocks from the end of the arena.
+ *
+ * @param arena The arena to update.
+ */
+static void manifest_arena_pop_free (struct manifest_arena *arena)
+{
+	struct manifest_arena_block *block;
+
+	while (arena->top != MANIFEST_ARENA_NO_BLOCK) {
+		block = (struct manifest_arena_block*) &arena->buffer[arena->top];
+		if (block->live) {
+			return;
+		}
+
+		arena->used = arena->top;
+		arena->top = (block->prev == (uint32_t) MANIFEST_ARENA_NO_BLOCK) ?
+			MANIFEST_ARENA_NO_BLOCK : block->prev;
+	}
+}
+
+/**
+ * Mark a block in the arena as freed and reclaim any space that is no longer used.
+ *
+ * @param arena The arena that contains the block.
+ * @param offset Offset of the block to free.
+ */
+static void manifest_arena_free_block (struct manifest_arena *arena, size_t offset)
+{
+	struct manifest_arena_block *block;
+
+	block = (struct manifest_arena_block*) &arena->buffer[offset];
+	block->live = 0;
+	manifest_arena_pop_free (arena);
+}
+
+/**
+ * Remove the heap allocations for a query result from the list of results with heap allocations.
+ *
+ * @param arena The arena that contains the result.
+ * @param result The first memory allocation made for the query result.
+ * @param block Offset of the result block in the arena.  This is only used if the result was not
+ * found.
+ *
+ * @return The heap allocations for the query result or null if there are none.
+ */
+static struct manifest_arena_spill* manifest_arena_remove_spill (struct manifest_arena *arena,
+	const void *result, size_t block)
+{
+	struct manifest_arena_spill **prev = &arena->spilled;
+	struct manifest_arena_spill *spill;
+
+	while (*prev) {
+		spill = *prev;
+		if ((spill->result == result) ||
+			((block != MANIFEST_ARENA_NO_BLOCK) && (spill->block == block))) {
+			*prev = spill->next;
+			return spill;
+		}
+
+		prev = &spill->next;
+	}
+
+	return NULL;
+}
+
+/**
+ * Finish building a query result and unlock the arena.
+ *
+ * @param arena The arena used for the query result.
+ * @param keep Flag indicating if the result should be kept.  If the query failed, all memory
+ * allocated for the result will be returned to the arena.
+ */
+void manifest_arena_end (struct manifest_arena *arena, bool keep)
+{
+	if (arena == NULL) {
+		return;
+	}
+
+	if (keep && (arena->first != NULL)) {
+		arena->results++;
+
+		if (arena->spill) {
+			arena->spill->result = arena->first;
+			arena->spill->next = arena->spilled;
+			arena->spilled = arena->spill;
+		}
+	}
+	else {
+		if (arena->spill) {
+			manifest_arena_free_spill (arena->spill);
+		}
+
+		if (arena->in_arena) {
+			manifest_arena_free_block (arena, arena->top);
+		}
+	}
+
+	arena->spill = NULL;
+	arena->first = NULL;
+
+	platform_mutex_unlock (&arena->lock);
+}
+
+/**
+ * Free a query result that was allocated from the arena.
+ *
+ * @param arena The arena that contains the result.
+ * @param result The first memory allocation made for the query result.
+ *
+ * @return true if the result was allocated from the arena and has been freed or false if the
+ * memory does not belong to the arena.
+ */
+bool manifest_arena_free (struct manifest_arena *arena, const void *result)
+{
+	const uint8_t *data = result;
+	struct manifest_arena_block *block;
+	struct manifest_arena_spill *spill;
+	size_t offset = MANIFEST_ARENA_NO_BLOCK;
+	bool found = false;
+
+	if ((arena == NULL) || (data == NULL)) {
+		return false;
+	}
+
+	platform_mutex_lock (&arena->lock);
+
+	if ((data >= &arena->buffer[sizeof (struct manifest_arena_block)]) &&
+		(data < &arena->buffer[arena->size])) {
+		found = true;
+
+		block = (struct manifest_arena_block*) (data - sizeof (struct manifest_arena_block));
+		if (block->live) {
+			offset = (uint8_t*) block - arena->buffer;
+		}
+		else {
+			/* The result has already been freed. */
+			goto exit;
+		}
+	}
+
+	spill = manifest_arena_remove_spill (arena, result, offset);
+	if (spill) {
+		found = true;
+		if (offset == MANIFEST_ARENA_NO_BLOCK) {
+			offset = spill->block;
+		}
+
+		manifest_arena_free_spill (spill);
+	}
+
+	if (found) {
+		arena->results--;
+		if (offset != MANIFEST_ARENA_NO_BLOCK) {
+			manifest_arena_free_block (arena, offset);
+		}
+	}
+
+exit:
+	platform_mutex_unlock (&arena->lock);
+	return found;
+}
+
+/**
+ * Get the current usage statistics for the arena.
+ *
+ * @param arena The arena to query.
+ * @param stats Output for the arena statistics.
+ *
+ * @return 0 if the statistics were retrieved successfully or an error code.
+ */
+int manifest_arena_get_stats (struct manifest_arena *arena, struct manifest_arena_stats *stats)
+{
+	if ((arena == NULL) || (stats == NULL)) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&arena->lock);
+
+	stats->size = arena->size;
+	stats->used = arena->used;
+	stats->peak = arena->peak;
+	stats->results = arena->results;
+	stats->failures = arena->failures;
+
+	platform_mutex_unlock (&arena->lock);
+	return 0;
+}
+
+/**
+ * Reset the peak usage tracking for the arena to the current usage.
+ *
+ * @param arena The arena to update.
+ */
+void manifest_arena_reset_peak (struct manifest_arena *arena)
+{
+	if (arena) {
+		platform_mutex_lock (&arena->lock);
+		arena->peak = arena->used;
+		arena->failures = 0;
+		platform_mutex_unlock (&arena->lock);
+	}
+}
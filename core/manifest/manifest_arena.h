@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef MANIFEST_ARENA_H_
+#define MANIFEST_ARENA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform.h"
+
+
+/**
+ * Usage statistics for a manifest arena.
+ */
+struct manifest_arena_stats {
+	size_t size;						/**< The total size of the arena storage. */
+	size_t used;						/**< The number of bytes currently allocated. */
+	size_t peak;						/**< The maximum number of bytes that have been allocated. */
+	uint32_t results;					/**< The number of query results currently allocated. */
+	uint32_t failures;					/**< The number of allocations made from the heap. */
+};
+
+/**
+ * A contiguous memory arena for manifest query results.  Each query result is allocated as a single
+ * block at the end of the arena and the complete result is freed at once, without needing to free
+ * each component of the result.  This avoids fragmenting the heap with the many small objects
+ * that make up manifest query results.
+ *
+ * Only one query result can be under construction at a time.  Results can be freed in any order,
+ * but space is only reclaimed once all newer results have also been freed.  If there is not enough
+ * space in the arena, allocations for the result are made from the heap instead and are freed
+ * along with the rest of the result.
+ */
+struct manifest_arena {
+	uint8_t *buffer;					/**< Storage for the arena. */
+	size_t size;						/**< The size of the arena storage. */
+	size_t used;						/**< The number of bytes in use. */
+	size_t peak;						/**< The peak number of bytes used. */
+	size_t top;							/**< Offset of the newest block in the arena. */
+	uint32_t results;					/**< The number of allocated query results. */
+	uint32_t failures;					/**< The number of allocations made from the heap. */
+	struct manifest_arena_spill *spilled;	/**< Results that contain heap allocations. */
+	struct manifest_arena_spill *spill;	/**< Heap allocations for the result being built. */
+	const void *first;					/**< The first allocation for the result being built. */
+	bool in_arena;						/**< Flag indicating the result being built has a block. */
+	platform_mutex lock;				/**< Synchronization for arena allocations. */
+};
+
+
+int manifest_arena_init (struct manifest_arena *arena, size_t size);
+void manifest_arena_release (struct manifest_arena *arena);
+
+int manifest_arena_begin (struct manifest_arena *arena);
+void* manifest_arena_alloc (struct manifest_arena *arena, size_t length);
+void manifest_arena_end (struct manifest_arena *arena, bool keep);
+bool manifest_arena_free (struct manifest_arena *arena, const void *result);
+
+int manifest_arena_get_stats (struct manifest_arena *arena, struct manifest_arena_stats *stats);
+void manifest_arena_reset_peak (struct manifest_arena *arena);
+
+
+#endif /* MANIFEST_ARENA_H_ */
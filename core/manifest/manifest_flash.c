@@ -33,6 +33,7 @@ int manifest_flash_init (struct manifest_flash *manifest, struct spi_flash *flas
 	manifest->addr = base_addr;
 	manifest->magic_num = magic_num;
 	manifest->cache_valid = false;
+	manifest->arena = NULL;
 
 	return 0;
 }
@@ -246,3 +247,105 @@ int manifest_flash_get_signature (struct manifest_flash *manifest, uint8_t *sign
 
 	return header.sig_length;
 }
+
+/**
+ * Use an arena for the results of manifest queries.  When an arena is used, each query result is
+ * stored as a single contiguous block in the arena instead of as individual heap allocations.
+ *
+ * This must be set before any queries are run against the manifest.
+ *
+ * @param manifest The manifest to update.
+ * @param arena The arena to use for query results.  Set this to null to use the heap.
+ *
+ * @return 0 if the arena was set successfully or an error code.
+ */
+int manifest_flash_set_arena (struct manifest_flash *manifest, struct manifest_arena *arena)
+{
+	if (manifest == NULL) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+
+	manifest->arena = arena;
+	return 0;
+}
+
+/**
+ * Start building the result for a manifest query.  This must be called before any memory is
+ * allocated for the result and must be followed by a call to manifest_flash_end_query.
+ *
+ * @param manifest The manifest being queried.
+ *
+ * @return 0 if the query result was started successfully or an error code.
+ */
+int manifest_flash_begin_query (struct manifest_flash *manifest)
+{
+	if (manifest->arena) {
+		return manifest_arena_begin (manifest->arena);
+	}
+
+	return 0;
+}
+
+/**
+ * Finish building the result for a manifest query.
+ *
+ * @param manifest The manifest being queried.
+ * @param keep Flag indicating if the query result should be kept.  This should be false if the
+ * query failed.
+ */
+void manifest_flash_end_query (struct manifest_flash *manifest, bool keep)
+{
+	if (manifest->arena) {
+		manifest_arena_end (manifest->arena, keep);
+	}
+}
+
+/**
+ * Allocate zeroed memory for a query result.
+ *
+ * @param manifest The manifest being queried.
+ * @param count The number of elements to allocate.
+ * @param size The size of each element.
+ *
+ * @return The allocated memory or null if the allocation failed.
+ */
+void* manifest_flash_alloc (struct manifest_flash *manifest, size_t count, size_t size)
+{
+	if (manifest->arena) {
+		if ((size != 0) && (count > (SIZE_MAX / size))) {
+			return NULL;
+		}
+
+		return manifest_arena_alloc (manifest->arena, count * size);
+	}
+
+	return platform_calloc (count, size);
+}
+
+/**
+ * Free memory allocated for a query result that is being discarded.  Memory allocated from an
+ * arena is not freed individually, but is reclaimed when the query is ended.
+ *
+ * @param manifest The manifest being queried.
+ * @param data The memory to free.
+ */
+void manifest_flash_free (struct manifest_flash *manifest, void *data)
+{
+	if (manifest->arena == NULL) {
+		platform_free (data);
+	}
+}
+
+/**
+ * Free a complete query result, if it was allocated from an arena.
+ *
+ * @param manifest The manifest that generated the result.
+ * @param result The first allocation made for the query result.
+ *
+ * @return true if the result was freed from the arena or false if the individual allocations that
+ * make up the result need to be freed.
+ */
+bool manifest_flash_free_result (struct manifest_flash *manifest, const void *result)
+{
+	return manifest_arena_free (manifest->arena, result);
+}
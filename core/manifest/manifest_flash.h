@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "manifest_format.h"
+#include "manifest_arena.h"
 #include "flash/spi_flash.h"
 #include "crypto/hash.h"
 #include "common/signature_verification.h"
@@ -25,6 +26,7 @@ struct manifest_flash {
 	uint16_t magic_num;						/**< The magic number identifying the manifest. */
 	uint8_t hash_cache[SHA256_HASH_LENGTH];	/**< Cache for the manifest hash. */
 	bool cache_valid;						/**< Flag indicating if the cached hash is valid. */
+	struct manifest_arena *arena;			/**< Optional arena for query results. */
 };
 
 
@@ -41,5 +43,13 @@ int manifest_flash_get_hash (struct manifest_flash *manifest, struct hash_engine
 int manifest_flash_get_signature (struct manifest_flash *manifest, uint8_t *signature,
 	size_t length);
 
+int manifest_flash_set_arena (struct manifest_flash *manifest, struct manifest_arena *arena);
+
+int manifest_flash_begin_query (struct manifest_flash *manifest);
+void manifest_flash_end_query (struct manifest_flash *manifest, bool keep);
+void* manifest_flash_alloc (struct manifest_flash *manifest, size_t count, size_t size);
+void manifest_flash_free (struct manifest_flash *manifest, void *data);
+bool manifest_flash_free_result (struct manifest_flash *manifest, const void *result);
+
 
 #endif //MANIFEST_FLASH_H
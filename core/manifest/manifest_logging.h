@@ -33,6 +33,7 @@ enum {
 	MANIFEST_LOGGING_EMPTY_PFM,						/**< An empty PFM caused manifests to be cleared. */
 	MANIFEST_LOGGING_GET_ID_FAIL,					/**< Failed to get manifest ID for measurement. */
 	MANIFEST_LOGGING_GET_PLATFORM_ID_FAIL,			/**< Failed to get manifest platform ID for measurement. */
+	MANIFEST_LOGGING_PFM_INDEX_FAIL,				/**< Failed to build the index for a PFM. */
 };
 
 
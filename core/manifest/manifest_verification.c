@@ -72,6 +72,7 @@ static void manifest_verification_on_manifest_activated (struct pfm_observer *ob
 			status = manifest->keystore->save_key (manifest->keystore, manifest->key_id,
 				(const uint8_t*) manifest->default_key, sizeof (struct manifest_verification_key));
 
+			manifest->rsa->invalidate_public_key (manifest->rsa, &manifest->stored_key->key);
 			platform_free (manifest->stored_key);
 			manifest->stored_key = NULL;
 			manifest->save_failed = (status != 0);
@@ -48,7 +48,7 @@ struct pcd {
 	 *
 	 * @param pcd The PCD to query.
 	 * @param devices Device info list for all components on platform.  This will be
-	 * dynamically allocated and must be freed by the caller.  This will be null on error.
+	 * dynamically allocated and must be freed with free_devices_info.  This will be null on error.
 	 * @param num_devices Number of components on platform.
 	 *
 	 * @return 0 if the devices info list was retrieved successfully or an error code.
@@ -56,6 +56,14 @@ struct pcd {
 	int (*get_devices_info) (struct pcd *pcd, struct device_manager_info **devices,
 		size_t *num_devices);
 
+	/**
+	 * Free a device info list.
+	 *
+	 * @param pcd The PCD instance that provided the list.
+	 * @param devices The device info list to free.
+	 */
+	void (*free_devices_info) (struct pcd *pcd, struct device_manager_info *devices);
+
 	/**
 	 * Get RoT info.
 	 *
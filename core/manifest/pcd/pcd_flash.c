@@ -179,10 +179,16 @@ static int pcd_flash_get_devices_info (struct pcd *pcd, struct device_manager_in
 		return status;
 	}
 
-	*devices = platform_calloc (components_header.num_components,
+	status = manifest_flash_begin_query (&pcd_flash->base_flash);
+	if (status != 0) {
+		return status;
+	}
+
+	*devices = manifest_flash_alloc (&pcd_flash->base_flash, components_header.num_components,
 		sizeof (struct device_manager_info));
 
 	if (*devices == NULL) {
+		manifest_flash_end_query (&pcd_flash->base_flash, false);
 		return PCD_NO_MEMORY;
 	}
 
@@ -193,7 +199,8 @@ static int pcd_flash_get_devices_info (struct pcd *pcd, struct device_manager_in
 		status = flash_device->read (flash_device, next_addr, (uint8_t*) &component_header,
 			sizeof (struct pcd_component_header));
 		if (status != 0) {
-			platform_free ((void*) *devices);
+			manifest_flash_free (&pcd_flash->base_flash, (void*) *devices);
+			manifest_flash_end_query (&pcd_flash->base_flash, false);
 			*num_devices = 0;
 			*devices = NULL;
 
@@ -206,9 +213,22 @@ static int pcd_flash_get_devices_info (struct pcd *pcd, struct device_manager_in
 		(*devices)[i_component].eid = component_header.eid;
 	}
 
+	manifest_flash_end_query (&pcd_flash->base_flash, true);
+
 	return 0;
 }
 
+static void pcd_flash_free_devices_info (struct pcd *pcd, struct device_manager_info *devices)
+{
+	struct pcd_flash *pcd_flash = (struct pcd_flash*) pcd;
+
+	if (pcd_flash && manifest_flash_free_result (&pcd_flash->base_flash, devices)) {
+		return;
+	}
+
+	platform_free (devices);
+}
+
 static int pcd_flash_get_platform_id (struct manifest *pcd, char **id)
 {
 	struct pcd_flash *pcd_flash = (struct pcd_flash*) pcd;
@@ -500,6 +520,7 @@ int pcd_flash_init (struct pcd_flash *pcd, struct spi_flash *flash, uint32_t bas
 	}
 
 	pcd->base.get_devices_info = pcd_flash_get_devices_info;
+	pcd->base.free_devices_info = pcd_flash_free_devices_info;
 	pcd->base.get_rot_info = pcd_flash_get_rot_info;
 	pcd->base.get_port_info = pcd_flash_get_port_info;
 
@@ -27,6 +27,7 @@ struct pfm_firmware_version {
 struct pfm_firmware_versions {
 	const struct pfm_firmware_version *versions;	/**< A list of version identifiers. */
 	size_t count;									/**< The number of items in the list. */
+	void *context;									/**< Internal context of the PFM that provided the list. */
 };
 
 /**
@@ -35,6 +36,7 @@ struct pfm_firmware_versions {
 struct pfm_read_write_regions {
 	const struct flash_region *regions;				/**< The list of read/write regions. */
 	size_t count;									/**< The number of regions defined. */
+	void *context;									/**< Internal context of the PFM that provided the list. */
 };
 
 /**
@@ -56,6 +58,7 @@ struct pfm_image_signature {
 struct pfm_image_list {
 	const struct pfm_image_signature *images;		/**< The list of images. */
 	size_t count;									/**< The number of images in the list. */
+	void *context;									/**< Internal context of the PFM that provided the list. */
 };
 
 /**
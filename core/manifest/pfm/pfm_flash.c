@@ -26,6 +26,9 @@ static int pfm_flash_verify (struct manifest *pfm, struct hash_engine *hash,
 		return PFM_INVALID_ARGUMENT;
 	}
 
+	/* The PFM contents may have changed, so any previously parsed index is no longer valid. */
+	pfm_flash_release_index (pfm_flash);
+
 	status = manifest_flash_verify (&pfm_flash->base_flash, hash, verification, hash_out,
 		hash_length);
 	if (status != 0) {
@@ -174,9 +177,140 @@ static int pfm_flash_get_platform_id (struct manifest *pfm, char **id)
 	return 0;
 }
 
+/**
+ * Compute the hash of a firmware version identifier for lookup in the PFM index.
+ *
+ * @param version The version identifier to hash.
+ *
+ * @return The hash of the version identifier.
+ */
+static uint32_t pfm_flash_index_hash (const char *version)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*version != '\0') {
+		hash ^= (uint8_t) *version++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/**
+ * Find the index entry for a firmware version.
+ *
+ * @param index The PFM index to search.
+ * @param version The version identifier to find.
+ * @param entry Output for the matching index entry.
+ *
+ * @return 0 if a matching entry was found or an error code.
+ */
+static int pfm_flash_index_find (struct pfm_flash_index *index, const char *version,
+	struct pfm_flash_index_entry **entry)
+{
+	uint32_t hash;
+	int i;
+
+	if (*version == '\0') {
+		return PFM_INVALID_ARGUMENT;
+	}
+
+	hash = pfm_flash_index_hash (version);
+	i = index->buckets[hash % PFM_FLASH_INDEX_BUCKETS];
+	while (i >= 0) {
+		if ((index->entries[i].hash == hash) &&
+			(strcmp (index->fw.versions[i].fw_version_id, version) == 0)) {
+			*entry = &index->entries[i];
+			return 0;
+		}
+
+		i = index->entries[i].next;
+	}
+
+	return PFM_UNSUPPORTED_VERSION;
+}
+
+/**
+ * Free the storage used by a PFM index.
+ *
+ * @param index The index to free.
+ */
+static void pfm_flash_index_free (struct pfm_flash_index *index)
+{
+	platform_free ((void*) index->fw.versions);
+	platform_free (index->entries);
+	platform_free (index->regions);
+	platform_free (index->images);
+	platform_free (index->ids);
+	platform_free (index);
+}
+
+/**
+ * Get a reference to the current index for a PFM.
+ *
+ * @param pfm The PFM to query.
+ *
+ * @return The current index or null if the PFM has not been indexed.  A reference to the index
+ * must be released with pfm_flash_index_put.
+ */
+static struct pfm_flash_index* pfm_flash_index_get (struct pfm_flash *pfm)
+{
+	struct pfm_flash_index *index;
+
+	platform_mutex_lock (&pfm->index_lock);
+
+	index = pfm->index;
+	if (index != NULL) {
+		index->refs++;
+	}
+
+	platform_mutex_unlock (&pfm->index_lock);
+	return index;
+}
+
+/**
+ * Release a reference to a PFM index.  The index is freed once there are no more references to it.
+ *
+ * @param pfm The PFM that owns the index.
+ * @param index The index being released.
+ */
+static void pfm_flash_index_put (struct pfm_flash *pfm, struct pfm_flash_index *index)
+{
+	bool unused;
+
+	platform_mutex_lock (&pfm->index_lock);
+	unused = (--index->refs == 0);
+	platform_mutex_unlock (&pfm->index_lock);
+
+	if (unused) {
+		pfm_flash_index_free (index);
+	}
+}
+
+/**
+ * Replace the current index for a PFM.
+ *
+ * @param pfm The PFM to update.
+ * @param index The new index to use.  This can be null to remove the current index.
+ */
+static void pfm_flash_index_set (struct pfm_flash *pfm, struct pfm_flash_index *index)
+{
+	struct pfm_flash_index *current;
+
+	platform_mutex_lock (&pfm->index_lock);
+	current = pfm->index;
+	pfm->index = index;
+	platform_mutex_unlock (&pfm->index_lock);
+
+	if (current != NULL) {
+		pfm_flash_index_put (pfm, current);
+	}
+}
+
 static int pfm_flash_get_supported_versions (struct pfm *pfm, struct pfm_firmware_versions *fw)
 {
 	struct pfm_flash *pfm_flash = (struct pfm_flash*) pfm;
+	struct pfm_flash_index *index;
 	struct manifest_header header;
 	struct pfm_allowable_firmware_header fw_section;
 	struct pfm_firmware_header fw_header;
@@ -189,6 +323,13 @@ static int pfm_flash_get_supported_versions (struct pfm *pfm, struct pfm_firmwar
 		return PFM_INVALID_ARGUMENT;
 	}
 
+	index = pfm_flash_index_get (pfm_flash);
+	if (index != NULL) {
+		*fw = index->fw;
+		fw->context = index;
+		return 0;
+	}
+
 	status = spi_flash_read (pfm_flash->base_flash.flash, pfm_flash->base_flash.addr,
 		(uint8_t*) &header, sizeof (header));
 	if (status != 0) {
@@ -211,8 +352,15 @@ static int pfm_flash_get_supported_versions (struct pfm *pfm, struct pfm_firmwar
 		return 0;
 	}
 
-	version_list = platform_calloc (fw_section.fw_count, sizeof (struct pfm_firmware_version));
+	status = manifest_flash_begin_query (&pfm_flash->base_flash);
+	if (status != 0) {
+		return status;
+	}
+
+	version_list = manifest_flash_alloc (&pfm_flash->base_flash, fw_section.fw_count,
+		sizeof (struct pfm_firmware_version));
 	if (version_list == NULL) {
+		manifest_flash_end_query (&pfm_flash->base_flash, false);
 		return PFM_NO_MEMORY;
 	}
 
@@ -225,7 +373,8 @@ static int pfm_flash_get_supported_versions (struct pfm *pfm, struct pfm_firmwar
 			goto exit_error;
 		}
 
-		version_list[i].fw_version_id = platform_malloc (fw_header.version_length + 1);
+		version_list[i].fw_version_id = manifest_flash_alloc (&pfm_flash->base_flash,
+			fw_header.version_length + 1, sizeof (char));
 		if (version_list[i].fw_version_id == NULL) {
 			status = PFM_NO_MEMORY;
 			goto exit_error;
@@ -245,25 +394,40 @@ static int pfm_flash_get_supported_versions (struct pfm *pfm, struct pfm_firmwar
 		next_addr += fw_header.length;
 	}
 
+	manifest_flash_end_query (&pfm_flash->base_flash, true);
+
 	fw->versions = version_list;
 	fw->count = fw_section.fw_count;
+	fw->context = NULL;
 
 	return 0;
 
 exit_error:
 	for (i = 0; i < fw_section.fw_count; i++) {
-		platform_free ((void*) version_list[i].fw_version_id);
+		manifest_flash_free (&pfm_flash->base_flash, (void*) version_list[i].fw_version_id);
 	}
-	platform_free (version_list);
+	manifest_flash_free (&pfm_flash->base_flash, version_list);
+	manifest_flash_end_query (&pfm_flash->base_flash, false);
 
 	return status;
 }
 
 static void pfm_flash_free_fw_versions (struct pfm *pfm, struct pfm_firmware_versions *fw)
 {
+	struct pfm_flash *pfm_flash = (struct pfm_flash*) pfm;
 	int i;
 
-	if ((fw != NULL) && (fw->versions != NULL)) {
+	if ((fw != NULL) && (fw->context != NULL)) {
+		/* The list is owned by the index. */
+		if (pfm_flash) {
+			pfm_flash_index_put (pfm_flash, fw->context);
+		}
+	}
+	else if ((fw != NULL) && (fw->versions != NULL)) {
+		if (pfm_flash && manifest_flash_free_result (&pfm_flash->base_flash, fw->versions)) {
+			return;
+		}
+
 		for (i = 0; i < fw->count; i++) {
 			platform_free ((void*) fw->versions[i].fw_version_id);
 		}
@@ -424,6 +588,7 @@ static int pfm_flash_get_read_write_regions (struct pfm *pfm, const char *versio
 	struct pfm_read_write_regions *writable)
 {
 	struct pfm_flash *pfm_flash = (struct pfm_flash*) pfm;
+	struct pfm_flash_index *index;
 	struct pfm_firmware_header fw_header;
 	struct flash_region *region_list;
 	uint32_t next_addr;
@@ -433,14 +598,37 @@ static int pfm_flash_get_read_write_regions (struct pfm *pfm, const char *versio
 		return PFM_INVALID_ARGUMENT;
 	}
 
+	index = pfm_flash_index_get (pfm_flash);
+	if (index != NULL) {
+		struct pfm_flash_index_entry *entry;
+
+		status = pfm_flash_index_find (index, version, &entry);
+		if (status == 0) {
+			*writable = entry->writable;
+			writable->context = index;
+		}
+		else {
+			pfm_flash_index_put (pfm_flash, index);
+		}
+
+		return status;
+	}
+
 	status = pfm_flash_find_version_entry (&pfm_flash->base_flash, version, &fw_header, &next_addr,
 		NULL);
 	if (status != 0) {
 		return status;
 	}
 
-	region_list = platform_calloc (fw_header.rw_count, sizeof (struct flash_region));
+	status = manifest_flash_begin_query (&pfm_flash->base_flash);
+	if (status != 0) {
+		return status;
+	}
+
+	region_list = manifest_flash_alloc (&pfm_flash->base_flash, fw_header.rw_count,
+		sizeof (struct flash_region));
 	if (region_list == NULL) {
+		manifest_flash_end_query (&pfm_flash->base_flash, false);
 		return PFM_NO_MEMORY;
 	}
 
@@ -452,12 +640,16 @@ static int pfm_flash_get_read_write_regions (struct pfm *pfm, const char *versio
 	status = pfm_flash_read_multiple_regions (&pfm_flash->base_flash, fw_header.rw_count,
 		region_list, &next_addr);
 	if (status != 0) {
-		platform_free (region_list);
+		manifest_flash_free (&pfm_flash->base_flash, region_list);
+		manifest_flash_end_query (&pfm_flash->base_flash, false);
 		return status;
 	}
 
+	manifest_flash_end_query (&pfm_flash->base_flash, true);
+
 	writable->regions = region_list;
 	writable->count = fw_header.rw_count;
+	writable->context = NULL;
 
 	return 0;
 }
@@ -465,7 +657,19 @@ static int pfm_flash_get_read_write_regions (struct pfm *pfm, const char *versio
 static void pfm_flash_free_read_write_regions (struct pfm *pfm,
 	struct pfm_read_write_regions *writable)
 {
-	if (writable != NULL) {
+	struct pfm_flash *pfm_flash = (struct pfm_flash*) pfm;
+
+	if ((writable != NULL) && (writable->context != NULL)) {
+		/* The list is owned by the index. */
+		if (pfm_flash) {
+			pfm_flash_index_put (pfm_flash, writable->context);
+		}
+	}
+	else if (writable != NULL) {
+		if (pfm_flash && manifest_flash_free_result (&pfm_flash->base_flash, writable->regions)) {
+			return;
+		}
+
 		platform_free ((void*) writable->regions);
 	}
 }
@@ -474,6 +678,7 @@ static int pfm_flash_get_firmware_images (struct pfm *pfm, const char *version,
 	struct pfm_image_list *img_list)
 {
 	struct pfm_flash *pfm_flash = (struct pfm_flash*) pfm;
+	struct pfm_flash_index *index;
 	struct pfm_firmware_header fw_header;
 	struct pfm_image_header img_header;
 	struct pfm_key_manifest_header key_section;
@@ -492,14 +697,37 @@ static int pfm_flash_get_firmware_images (struct pfm *pfm, const char *version,
 		return PFM_INVALID_ARGUMENT;
 	}
 
+	index = pfm_flash_index_get (pfm_flash);
+	if (index != NULL) {
+		struct pfm_flash_index_entry *entry;
+
+		status = pfm_flash_index_find (index, version, &entry);
+		if (status == 0) {
+			*img_list = entry->images;
+			img_list->context = index;
+		}
+		else {
+			pfm_flash_index_put (pfm_flash, index);
+		}
+
+		return status;
+	}
+
 	status = pfm_flash_find_version_entry (&pfm_flash->base_flash, version, &fw_header, &next_addr,
 		&key_addr);
 	if (status != 0) {
 		return status;
 	}
 
-	images = platform_calloc (fw_header.img_count, sizeof (struct pfm_image_signature));
+	status = manifest_flash_begin_query (&pfm_flash->base_flash);
+	if (status != 0) {
+		return status;
+	}
+
+	images = manifest_flash_alloc (&pfm_flash->base_flash, fw_header.img_count,
+		sizeof (struct pfm_image_signature));
 	if (images == NULL) {
+		manifest_flash_end_query (&pfm_flash->base_flash, false);
 		return PFM_NO_MEMORY;
 	}
 
@@ -516,7 +744,8 @@ static int pfm_flash_get_firmware_images (struct pfm *pfm, const char *version,
 			goto exit;
 		}
 
-		region_list = platform_calloc (img_header.region_count, sizeof (struct flash_region));
+		region_list = manifest_flash_alloc (&pfm_flash->base_flash, img_header.region_count,
+			sizeof (struct flash_region));
 		if (region_list == NULL) {
 			status = PFM_NO_MEMORY;
 			goto exit;
@@ -587,24 +816,39 @@ static int pfm_flash_get_firmware_images (struct pfm *pfm, const char *version,
 		goto exit;
 	}
 
+	manifest_flash_end_query (&pfm_flash->base_flash, true);
+
 	img_list->images = images;
 	img_list->count = fw_header.img_count;
+	img_list->context = NULL;
 
 	return 0;
 
 exit:
 	for (i = 0; i < fw_header.img_count; i++) {
-		platform_free ((void*) images[i].regions);
+		manifest_flash_free (&pfm_flash->base_flash, (void*) images[i].regions);
 	}
-	platform_free (images);
+	manifest_flash_free (&pfm_flash->base_flash, images);
+	manifest_flash_end_query (&pfm_flash->base_flash, false);
 	return status;
 }
 
 static void pfm_flash_free_firmware_images (struct pfm *pfm, struct pfm_image_list *img_list)
 {
+	struct pfm_flash *pfm_flash = (struct pfm_flash*) pfm;
 	int i;
 
-	if ((img_list != NULL) && (img_list->images != NULL)) {
+	if ((img_list != NULL) && (img_list->context != NULL)) {
+		/* The list is owned by the index. */
+		if (pfm_flash) {
+			pfm_flash_index_put (pfm_flash, img_list->context);
+		}
+	}
+	else if ((img_list != NULL) && (img_list->images != NULL)) {
+		if (pfm_flash && manifest_flash_free_result (&pfm_flash->base_flash, img_list->images)) {
+			return;
+		}
+
 		for (i = 0; i < img_list->count; i++) {
 			platform_free ((void*) img_list->images[i].regions);
 		}
@@ -637,6 +881,11 @@ int pfm_flash_init (struct pfm_flash *pfm, struct spi_flash *flash, uint32_t bas
 		return status;
 	}
 
+	status = platform_mutex_init (&pfm->index_lock);
+	if (status != 0) {
+		return status;
+	}
+
 	pfm->base.base.verify = pfm_flash_verify;
 	pfm->base.base.get_id = pfm_flash_get_id;
 	pfm->base.base.get_hash = pfm_flash_get_hash;
@@ -660,7 +909,10 @@ int pfm_flash_init (struct pfm_flash *pfm, struct spi_flash *flash, uint32_t bas
  */
 void pfm_flash_release (struct pfm_flash *pfm)
 {
-
+	if (pfm) {
+		pfm_flash_release_index (pfm);
+		platform_mutex_free (&pfm->index_lock);
+	}
 }
 
 /**
@@ -696,3 +948,402 @@ struct spi_flash* pfm_flash_get_flash (struct pfm_flash *pfm)
 		return NULL;
 	}
 }
+
+/**
+ * Read data from a PFM that has been loaded into memory.
+ *
+ * @param data The PFM data.
+ * @param length The length of the PFM data.
+ * @param offset Offset in the PFM to read from.
+ * @param out Output buffer for the data.
+ * @param out_length The number of bytes to read.
+ *
+ * @return 0 if the data was read successfully or MANIFEST_MALFORMED if the data extends past the
+ * end of the PFM.
+ */
+static int pfm_flash_index_read (const uint8_t *data, size_t length, size_t offset, void *out,
+	size_t out_length)
+{
+	if ((offset > length) || (out_length > (length - offset))) {
+		return MANIFEST_MALFORMED;
+	}
+
+	memcpy (out, &data[offset], out_length);
+	return 0;
+}
+
+/**
+ * Read multiple flash region definitions from a PFM loaded into memory.
+ *
+ * @param data The PFM data.
+ * @param length The length of the PFM data.
+ * @param offset Offset of the first region definition.
+ * @param count The number of regions to read.
+ * @param region_list The list of regions to populate.  Set this to null to only check the region
+ * definitions.
+ *
+ * @return 0 if the regions were read successfully or an error code.
+ */
+static int pfm_flash_index_read_regions (const uint8_t *data, size_t length, size_t offset,
+	size_t count, struct flash_region *region_list)
+{
+	struct pfm_flash_region region;
+	size_t i;
+	int status;
+
+	for (i = 0; i < count; i++) {
+		status = pfm_flash_index_read (data, length, offset, &region, sizeof (region));
+		if (status != 0) {
+			return status;
+		}
+
+		if (region_list != NULL) {
+			region_list[i].start_addr = region.start_addr;
+			region_list[i].length = (region.end_addr - region.start_addr) + 1;
+		}
+
+		offset += sizeof (struct pfm_flash_region);
+	}
+
+	return 0;
+}
+
+/**
+ * Find the public key used to sign an image in a PFM loaded into memory.
+ *
+ * @param data The PFM data.
+ * @param length The length of the PFM data.
+ * @param key_offset Offset of the key manifest in the PFM.
+ * @param key_id The ID of the key to find.
+ * @param key Output for the public key.
+ *
+ * @return 0 if the key was found or an error code.
+ */
+static int pfm_flash_index_find_key (const uint8_t *data, size_t length, size_t key_offset,
+	uint8_t key_id, struct rsa_public_key *key)
+{
+	struct pfm_key_manifest_header key_section;
+	struct pfm_public_key_header key_header;
+	int i;
+	int status;
+
+	status = pfm_flash_index_read (data, length, key_offset, &key_section, sizeof (key_section));
+	if (status != 0) {
+		return status;
+	}
+
+	key_offset += sizeof (struct pfm_key_manifest_header);
+	for (i = 0; i < key_section.key_count; i++) {
+		status = pfm_flash_index_read (data, length, key_offset, &key_header, sizeof (key_header));
+		if (status != 0) {
+			return status;
+		}
+
+		key_offset += sizeof (struct pfm_public_key_header);
+		if (key_header.id == key_id) {
+			if (key_header.key_length > sizeof (key->modulus)) {
+				return MANIFEST_MALFORMED;
+			}
+
+			key->exponent = key_header.key_exponent;
+			key->mod_length = key_header.key_length;
+			return pfm_flash_index_read (data, length, key_offset, key->modulus,
+				key_header.key_length);
+		}
+
+		key_offset += key_header.key_length;
+	}
+
+	return PFM_UNKNOWN_KEY_ID;
+}
+
+/**
+ * Parse the firmware versions of a PFM loaded into memory.  This is run twice when building the
+ * index:  once to determine the amount of storage needed and once to populate the index.
+ *
+ * @param index The index to populate.  When counting, only the counters in the index are updated.
+ * @param data The PFM data.
+ * @param length The length of the PFM data.
+ * @param id_length Output for the total storage needed for the version identifiers.
+ * @param fill Flag indicating if the index storage should be populated.
+ *
+ * @return 0 if the PFM was parsed successfully or an error code.
+ */
+static int pfm_flash_index_parse (struct pfm_flash_index *index, const uint8_t *data,
+	size_t length, size_t *id_length, bool fill)
+{
+	struct pfm_allowable_firmware_header fw_section;
+	struct pfm_firmware_header fw_header;
+	struct pfm_image_header img_header;
+	struct pfm_firmware_version *version;
+	struct pfm_image_signature *image;
+	size_t key_offset;
+	size_t next_offset;
+	size_t fw_offset;
+	size_t regions = 0;
+	size_t images = 0;
+	size_t ids = 0;
+	int i;
+	int j;
+	int status;
+
+	status = pfm_flash_index_read (data, length, sizeof (struct manifest_header), &fw_section,
+		sizeof (fw_section));
+	if (status != 0) {
+		return status;
+	}
+
+	key_offset = sizeof (struct manifest_header) + fw_section.length;
+	fw_offset = sizeof (struct manifest_header) + sizeof (struct pfm_allowable_firmware_header);
+	for (i = 0; i < fw_section.fw_count; i++) {
+		status = pfm_flash_index_read (data, length, fw_offset, &fw_header, sizeof (fw_header));
+		if (status != 0) {
+			return status;
+		}
+
+		next_offset = fw_offset + sizeof (struct pfm_firmware_header);
+		if (fill) {
+			version = (struct pfm_firmware_version*) &index->fw.versions[i];
+			version->fw_version_id = &index->ids[ids];
+			version->version_addr = fw_header.version_addr;
+			version->blank_byte = fw_header.blank_byte;
+
+			status = pfm_flash_index_read (data, length, next_offset, &index->ids[ids],
+				fw_header.version_length);
+			if (status != 0) {
+				return status;
+			}
+
+			index->ids[ids + fw_header.version_length] = '\0';
+			index->entries[i].hash = pfm_flash_index_hash (version->fw_version_id);
+		}
+		ids += fw_header.version_length + 1;
+
+		next_offset += fw_header.version_length;
+		if ((fw_header.version_length % 4) != 0) {
+			next_offset += (4 - (fw_header.version_length % 4));
+		}
+
+		status = pfm_flash_index_read_regions (data, length, next_offset, fw_header.rw_count,
+			(fill) ? &index->regions[regions] : NULL);
+		if (status != 0) {
+			return status;
+		}
+
+		if (fill && (fw_header.rw_count != 0)) {
+			index->entries[i].writable.regions = &index->regions[regions];
+			index->entries[i].writable.count = fw_header.rw_count;
+		}
+		regions += fw_header.rw_count;
+		next_offset += sizeof (struct pfm_flash_region) * fw_header.rw_count;
+
+		if (fill && (fw_header.img_count != 0)) {
+			index->entries[i].images.images = &index->images[images];
+			index->entries[i].images.count = fw_header.img_count;
+		}
+
+		for (j = 0; j < fw_header.img_count; j++, images++) {
+			status = pfm_flash_index_read (data, length, next_offset, &img_header,
+				sizeof (img_header));
+			if (status != 0) {
+				return status;
+			}
+
+			if (img_header.sig_length > RSA_MAX_KEY_LENGTH) {
+				return MANIFEST_MALFORMED;
+			}
+
+			next_offset += sizeof (struct pfm_image_header);
+			if (fill) {
+				image = &index->images[images];
+				image->count = img_header.region_count;
+				image->always_validate = !!(img_header.flags & PFM_IMAGE_MUST_VALIDATE);
+				image->sig_length = img_header.sig_length;
+
+				status = pfm_flash_index_read (data, length, next_offset, image->signature,
+					img_header.sig_length);
+				if (status != 0) {
+					return status;
+				}
+
+				status = pfm_flash_index_find_key (data, length, key_offset, img_header.key_id,
+					&image->key);
+				if (status != 0) {
+					return status;
+				}
+
+				if (img_header.region_count != 0) {
+					image->regions = &index->regions[regions];
+				}
+			}
+			next_offset += img_header.sig_length;
+
+			status = pfm_flash_index_read_regions (data, length, next_offset,
+				img_header.region_count, (fill) ? &index->regions[regions] : NULL);
+			if (status != 0) {
+				return status;
+			}
+
+			regions += img_header.region_count;
+			next_offset += sizeof (struct pfm_flash_region) * img_header.region_count;
+		}
+
+		fw_offset += fw_header.length;
+	}
+
+	index->fw.count = fw_section.fw_count;
+	index->region_count = regions;
+	index->image_count = images;
+	*id_length = ids;
+
+	return 0;
+}
+
+/**
+ * Parse the PFM and build an in-memory index of its contents.  The PFM is read from flash only once
+ * and, while the index is current, requests for supported versions, read/write regions, and
+ * firmware images are answered from the index without accessing flash or allocating memory.  Lists
+ * returned from the index hold a reference to it and remain valid until they are freed, even if the
+ * index is rebuilt or released in the meantime.
+ *
+ * Any existing index for the PFM will be replaced.  The index is released whenever the PFM is
+ * verified, since the contents may have changed.
+ *
+ * @param pfm The PFM to index.
+ *
+ * @return 0 if the index was built successfully or an error code.
+ */
+int pfm_flash_build_index (struct pfm_flash *pfm)
+{
+	struct pfm_flash_index *index;
+	struct manifest_header header;
+	uint8_t *data;
+	size_t length;
+	size_t id_length;
+	int i;
+	int status;
+
+	if (pfm == NULL) {
+		return PFM_INVALID_ARGUMENT;
+	}
+
+	status = spi_flash_read (pfm->base_flash.flash, pfm->base_flash.addr, (uint8_t*) &header,
+		sizeof (header));
+	if (status != 0) {
+		return status;
+	}
+
+	if (header.magic != PFM_MAGIC_NUM) {
+		return MANIFEST_BAD_MAGIC_NUMBER;
+	}
+
+	if (header.length < (sizeof (header) + header.sig_length)) {
+		return MANIFEST_MALFORMED;
+	}
+
+	length = header.length - header.sig_length;
+	data = platform_malloc (length);
+	if (data == NULL) {
+		return PFM_NO_MEMORY;
+	}
+
+	status = spi_flash_read (pfm->base_flash.flash, pfm->base_flash.addr, data, length);
+	if (status != 0) {
+		goto exit;
+	}
+
+	index = platform_calloc (1, sizeof (struct pfm_flash_index));
+	if (index == NULL) {
+		status = PFM_NO_MEMORY;
+		goto exit;
+	}
+
+	status = pfm_flash_index_parse (index, data, length, &id_length, false);
+	if (status != 0) {
+		goto exit_index;
+	}
+
+	if (index->fw.count != 0) {
+		index->fw.versions = platform_calloc (index->fw.count, sizeof (struct pfm_firmware_version));
+		index->entries = platform_calloc (index->fw.count, sizeof (struct pfm_flash_index_entry));
+		index->ids = platform_malloc (id_length);
+		if ((index->fw.versions == NULL) || (index->entries == NULL) || (index->ids == NULL)) {
+			status = PFM_NO_MEMORY;
+			goto exit_index;
+		}
+	}
+
+	if (index->region_count != 0) {
+		index->regions = platform_calloc (index->region_count, sizeof (struct flash_region));
+		if (index->regions == NULL) {
+			status = PFM_NO_MEMORY;
+			goto exit_index;
+		}
+	}
+
+	if (index->image_count != 0) {
+		index->images = platform_calloc (index->image_count, sizeof (struct pfm_image_signature));
+		if (index->images == NULL) {
+			status = PFM_NO_MEMORY;
+			goto exit_index;
+		}
+	}
+
+	status = pfm_flash_index_parse (index, data, length, &id_length, true);
+	if (status != 0) {
+		goto exit_index;
+	}
+
+	/* Insert in reverse order so the first matching version in the PFM is found first. */
+	for (i = 0; i < PFM_FLASH_INDEX_BUCKETS; i++) {
+		index->buckets[i] = -1;
+	}
+	for (i = index->fw.count - 1; i >= 0; i--) {
+		index->entries[i].next = index->buckets[index->entries[i].hash % PFM_FLASH_INDEX_BUCKETS];
+		index->buckets[index->entries[i].hash % PFM_FLASH_INDEX_BUCKETS] = i;
+	}
+
+	index->refs = 1;
+	pfm_flash_index_set (pfm, index);
+
+	platform_free (data);
+	return 0;
+
+exit_index:
+	pfm_flash_index_free (index);
+exit:
+	platform_free (data);
+	return status;
+}
+
+/**
+ * Release the in-memory index for a PFM.  Subsequent queries will parse the PFM from flash.
+ *
+ * @param pfm The PFM whose index should be released.
+ */
+void pfm_flash_release_index (struct pfm_flash *pfm)
+{
+	if (pfm) {
+		pfm_flash_index_set (pfm, NULL);
+	}
+}
+
+/**
+ * Determine if queries to a PFM are being answered from an in-memory index.
+ *
+ * @param pfm The PFM to query.
+ *
+ * @return true if the PFM has a valid index or false if not.
+ */
+bool pfm_flash_is_indexed (struct pfm_flash *pfm)
+{
+	bool indexed = false;
+
+	if (pfm) {
+		platform_mutex_lock (&pfm->index_lock);
+		indexed = (pfm->index != NULL);
+		platform_mutex_unlock (&pfm->index_lock);
+	}
+
+	return indexed;
+}
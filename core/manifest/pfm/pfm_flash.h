@@ -5,17 +5,58 @@
 #define PFM_FLASH_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
 #include "pfm.h"
 #include "manifest/manifest_flash.h"
 #include "flash/spi_flash.h"
 
 
+/**
+ * The number of hash buckets used to look up firmware versions in the PFM index.
+ */
+#ifndef PFM_FLASH_INDEX_BUCKETS
+#define	PFM_FLASH_INDEX_BUCKETS		16
+#endif
+
+
+/**
+ * Parsed information for a single firmware version in the PFM index.
+ */
+struct pfm_flash_index_entry {
+	uint32_t hash;								/**< Hash of the version identifier. */
+	int next;									/**< Next entry in the same hash bucket, or -1. */
+	struct pfm_read_write_regions writable;		/**< Read/write regions for the version. */
+	struct pfm_image_list images;				/**< Signed images for the version. */
+};
+
+/**
+ * An immutable, in-memory copy of the parsed PFM contents.  While the index is current, PFM queries
+ * are answered without reading flash or allocating memory.
+ *
+ * Lists returned from the index hold a reference to it, so an index that is replaced or released
+ * is not freed until all lists that refer to it have also been freed.
+ */
+struct pfm_flash_index {
+	int refs;									/**< The number of references to the index. */
+	struct pfm_firmware_versions fw;			/**< The list of supported firmware versions. */
+	struct pfm_flash_index_entry *entries;		/**< Parsed data for each firmware version. */
+	int buckets[PFM_FLASH_INDEX_BUCKETS];		/**< Hash buckets of version entries. */
+	struct flash_region *regions;				/**< Storage for all flash regions in the index. */
+	size_t region_count;						/**< The number of flash regions in the index. */
+	struct pfm_image_signature *images;			/**< Storage for all images in the index. */
+	size_t image_count;							/**< The number of images in the index. */
+	char *ids;									/**< Storage for all version identifiers. */
+};
+
 /**
  * Defines a PFM that is stored in flash memory.
  */
 struct pfm_flash {
 	struct pfm base;							/**< The base PFM instance. */
 	struct manifest_flash base_flash;			/**< The base PFM flash instance. */
+	struct pfm_flash_index *index;				/**< Parsed index of the PFM contents. */
+	platform_mutex index_lock;					/**< Synchronization for index references. */
 };
 
 
@@ -25,5 +66,9 @@ void pfm_flash_release (struct pfm_flash *pfm);
 uint32_t pfm_flash_get_addr (struct pfm_flash *pfm);
 struct spi_flash* pfm_flash_get_flash (struct pfm_flash *pfm);
 
+int pfm_flash_build_index (struct pfm_flash *pfm);
+void pfm_flash_release_index (struct pfm_flash *pfm);
+bool pfm_flash_is_indexed (struct pfm_flash *pfm);
+
 
 #endif //PFM_FLASH_H
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "pfm_observer_index.h"
+#include "manifest/manifest_logging.h"
+
+
+/**
+ * Find the flash PFM instance for a PFM notification.
+ *
+ * @param index The observer instance.
+ * @param pfm The PFM from the notification.
+ *
+ * @return The flash PFM instance or null if the PFM is not managed by the observer.
+ */
+static struct pfm_flash* pfm_observer_index_find_region (struct pfm_observer_index *index,
+	struct pfm *pfm)
+{
+	if (pfm == &index->region1->base) {
+		return index->region1;
+	}
+	else if (pfm == &index->region2->base) {
+		return index->region2;
+	}
+	else {
+		return NULL;
+	}
+}
+
+/**
+ * Build the index for a PFM.  Failures are logged, but otherwise ignored, since the PFM will still
+ * be parsed from flash without an index.
+ *
+ * @param pfm The PFM to index.
+ */
+static void pfm_observer_index_build (struct pfm_flash *pfm)
+{
+	int status;
+
+	status = pfm_flash_build_index (pfm);
+	if (status != 0) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_MANIFEST,
+			MANIFEST_LOGGING_PFM_INDEX_FAIL, pfm_flash_get_addr (pfm), status);
+	}
+}
+
+static void pfm_observer_index_on_pfm_verified (struct pfm_observer *observer,
+	struct pfm *pending)
+{
+	struct pfm_flash *pfm = pfm_observer_index_find_region ((struct pfm_observer_index*) observer,
+		pending);
+
+	if (pfm != NULL) {
+		pfm_observer_index_build (pfm);
+	}
+}
+
+static void pfm_observer_index_on_pfm_activated (struct pfm_observer *observer,
+	struct pfm *active)
+{
+	struct pfm_flash *pfm = pfm_observer_index_find_region ((struct pfm_observer_index*) observer,
+		active);
+
+	if ((pfm != NULL) && !pfm_flash_is_indexed (pfm)) {
+		pfm_observer_index_build (pfm);
+	}
+}
+
+/**
+ * Initialize a PFM observer to maintain the in-memory index of flash PFMs.
+ *
+ * @param observer The observer to initialize.
+ * @param region1 The PFM stored in the first flash region.
+ * @param region2 The PFM stored in the second flash region.
+ *
+ * @return 0 if the observer was successfully initialized or an error code.
+ */
+int pfm_observer_index_init (struct pfm_observer_index *observer, struct pfm_flash *region1,
+	struct pfm_flash *region2)
+{
+	if ((observer == NULL) || (region1 == NULL) || (region2 == NULL)) {
+		return PFM_OBSERVER_INVALID_ARGUMENT;
+	}
+
+	memset (observer, 0, sizeof (struct pfm_observer_index));
+
+	observer->base.on_pfm_verified = pfm_observer_index_on_pfm_verified;
+	observer->base.on_pfm_activated = pfm_observer_index_on_pfm_activated;
+
+	observer->region1 = region1;
+	observer->region2 = region2;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by the PFM index observer.  The indexes maintained by the observer
+ * will be released, since they will no longer be kept up to date.
+ *
+ * @param observer The observer to release.
+ */
+void pfm_observer_index_release (struct pfm_observer_index *observer)
+{
+	if (observer) {
+		pfm_flash_release_index (observer->region1);
+		pfm_flash_release_index (observer->region2);
+	}
+}
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef PFM_OBSERVER_INDEX_H_
+#define PFM_OBSERVER_INDEX_H_
+
+#include "pfm_manager.h"
+#include "pfm_flash.h"
+
+
+/**
+ * PFM observer to maintain the in-memory index of PFMs stored in flash.  The index is rebuilt
+ * whenever a PFM is verified and built on activation if it does not already exist.
+ */
+struct pfm_observer_index {
+	struct pfm_observer base;			/**< The base observer interface. */
+	struct pfm_flash *region1;			/**< The PFM stored in the first flash region. */
+	struct pfm_flash *region2;			/**< The PFM stored in the second flash region. */
+};
+
+
+int pfm_observer_index_init (struct pfm_observer_index *observer, struct pfm_flash *region1,
+	struct pfm_flash *region2);
+void pfm_observer_index_release (struct pfm_observer_index *observer);
+
+
+#endif /* PFM_OBSERVER_INDEX_H_ */
@@ -78,12 +78,50 @@ int mctp_interface_set_channel_id (struct mctp_interface *interface, int channel
 	return 0;
 }
 
+/**
+ * Enable tracking of multiple partially received requests.  Each request is reassembled in a
+ * separate context identified by the source EID and message tag, allowing packets from different
+ * requesters to be interleaved without disrupting each other.  If all contexts are in use when a
+ * new request is started, the least recently used context will be discarded.
+ *
+ * Without reassembly contexts, only a single request can be received at a time.
+ *
+ * @param interface The MCTP interface to configure.
+ * @param contexts The contexts to use for request reassembly.  This memory must remain valid for
+ * the lifetime of the MCTP interface.  Set this to null to disable multiple contexts.
+ * @param count The number of reassembly contexts.
+ * @param timeout_ms The amount of time allowed between packets of a single request before the
+ * partial request is discarded.  Set this to 0 for no timeout.
+ *
+ * @return 0 if the reassembly contexts were configured successfully or an error code.
+ */
+int mctp_interface_set_reassembly_contexts (struct mctp_interface *interface,
+	struct mctp_interface_rx_context *contexts, size_t count, uint32_t timeout_ms)
+{
+	if ((interface == NULL) || ((contexts == NULL) && (count != 0)) ||
+		((contexts != NULL) && (count == 0))) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	if (contexts != NULL) {
+		memset (contexts, 0, sizeof (struct mctp_interface_rx_context) * count);
+	}
+
+	interface->rx_ctx = contexts;
+	interface->rx_ctx_count = count;
+	interface->rx_ctx_timeout_ms = timeout_ms;
+	interface->rx_ctx_use = 0;
+
+	return 0;
+}
+
 /**
  * Construct an MCTP packet for an error response.
  *
  * @param interface MCTP interface instance.
  * @param packets Output for the buffer of response packets.  This is dynamically allocated and must
- * be freed by the caller.
+ * be freed by the caller.  If this is null, the error response will be generated in place and can
+ * be retrieved with mctp_interface_get_response_packet.
  * @param num_packets Output for the number of packets in the response buffer.
  * @param error_code Identifier for the error.
  * @param error_data Data for the error condition.
@@ -114,6 +152,36 @@ static int mctp_interface_generate_error_packet (struct mctp_interface *interfac
 		return 0;
 	}
 
+	if (packets == NULL) {
+		memset (&interface->error_msg, 0, sizeof (interface->error_msg));
+
+		interface->error_msg.header.rq = cmd_set;
+		interface->error_msg.header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+		interface->error_msg.header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+		interface->error_msg.header.command = CERBERUS_PROTOCOL_ERROR;
+
+		interface->error_msg.error_code = error_code;
+		interface->error_msg.error_data = error_data;
+
+		interface->tx_msg.packet[0].payload = (uint8_t*) &interface->error_msg;
+		interface->tx_msg.packet[0].length = sizeof (interface->error_msg);
+		interface->tx_msg.packet[0].packet_seq = 0;
+		interface->tx_msg.packet[0].som = true;
+		interface->tx_msg.packet[0].eom = true;
+
+		interface->tx_msg.source_addr = source_addr;
+		interface->tx_msg.dest_addr = response_addr;
+		interface->tx_msg.source_eid = dest_eid;
+		interface->tx_msg.dest_eid = src_eid;
+		interface->tx_msg.msg_tag = msg_tag;
+		interface->tx_msg.tag_owner = MCTP_PROTOCOL_TO_RESPONSE;
+		interface->tx_msg.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+		interface->tx_msg.num_packets = 1;
+
+		*num_packets = 1;
+		return 0;
+	}
+
 	*num_packets = 1;
 	*packets = platform_calloc (1, sizeof (struct cmd_packet));
 	if (*packets == NULL) {
@@ -146,23 +214,390 @@ static int mctp_interface_generate_error_packet (struct mctp_interface *interfac
 }
 
 /**
- * MCTP interface message processing function
+ * Split the response message into packet descriptors without copying the message data.
  *
- * @param interface MCTP interface instance
- * @param rx_packet The received packet to process
- * @param tx_packets Pointer to buffer of response packets - NEEDS TO BE FREED BY CONSUMER IF
- * COMPLETION CODE IS 0 AND num_packets > 0
- * @param num_packets Number of packets in packets buffer
+ * @param interface MCTP interface instance.
+ * @param max_packet Maximum payload length for each packet.
+ * @param source_addr SMBUS address responding from.
+ * @param response_addr SMBUS address to respond to.
+ * @param tag_owner Tag owner for the response message.
  *
- * @return Completion status, 0 if success or an error code.
+ * @return 0 if the response was split successfully or an error code.
  */
-int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_packet *rx_packet,
+static int mctp_interface_slice_response (struct mctp_interface *interface, size_t max_packet,
+	uint8_t source_addr, uint8_t response_addr, uint8_t tag_owner)
+{
+	struct mctp_interface_tx_message *tx_msg = &interface->tx_msg;
+	size_t n_packets;
+	size_t offset = 0;
+	size_t i;
+
+	if ((max_packet == 0) || (max_packet > MCTP_PROTOCOL_MAX_TRANSMISSION_UNIT)) {
+		return MCTP_PROTOCOL_BAD_BUFFER_LENGTH;
+	}
+
+	n_packets = (interface->msg_buffer.length + (max_packet - 1)) / max_packet;
+	if (n_packets > MCTP_INTERFACE_MAX_RESPONSE_PACKETS) {
+		return MCTP_PROTOCOL_MSG_TOO_LARGE;
+	}
+
+	for (i = 0; i < n_packets; i++) {
+		tx_msg->packet[i].payload = &interface->msg_buffer.data[offset];
+		tx_msg->packet[i].length = min (max_packet, interface->msg_buffer.length - offset);
+		tx_msg->packet[i].packet_seq = i % 4;
+		tx_msg->packet[i].som = (i == 0);
+		tx_msg->packet[i].eom = (i == (n_packets - 1));
+
+		offset += tx_msg->packet[i].length;
+	}
+
+	tx_msg->source_addr = source_addr;
+	tx_msg->dest_addr = response_addr;
+	tx_msg->source_eid = interface->msg_buffer.target_eid;
+	tx_msg->dest_eid = interface->msg_buffer.source_eid;
+	tx_msg->msg_tag = interface->msg_tag;
+	tx_msg->tag_owner = tag_owner;
+	tx_msg->msg_type = interface->msg_type;
+	tx_msg->num_packets = n_packets;
+
+	interface->packet_seq = n_packets % 4;
+	interface->msg_buffer.length = 0;
+
+	return 0;
+}
+
+/**
+ * Configure the context used to retrieve responses for requests that were deferred by the command
+ * interface.  The same context must be provided to the command interface.  Requests will not be
+ * deferred unless a context has been configured.
+ *
+ * @param interface The MCTP interface to configure.
+ * @param async The context for deferred requests.  Set this to null if no requests are deferred.
+ *
+ * @return 0 if the context was configured successfully or an error code.
+ */
+int mctp_interface_set_async (struct mctp_interface *interface, struct cmd_async *async)
+{
+	if (interface == NULL) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	interface->async = async;
+	interface->deferred.pending = false;
+
+	return 0;
+}
+
+/**
+ * Determine if a reassembly context contains a partial request that is still valid.
+ *
+ * @param interface MCTP interface instance.
+ * @param context The reassembly context to check.
+ *
+ * @return true if the context is being used for a request or false if it is available.
+ */
+static bool mctp_interface_rx_context_is_active (struct mctp_interface *interface,
+	struct mctp_interface_rx_context *context)
+{
+	if (context->active && (interface->rx_ctx_timeout_ms != 0) &&
+		(platform_has_timeout_expired (&context->expiration) == 1)) {
+		context->active = false;
+	}
+
+	return context->active;
+}
+
+/**
+ * Find the reassembly context to use for a received packet.
+ *
+ * @param interface MCTP interface instance.
+ * @param src_eid EID of the requester.
+ * @param msg_tag Message tag of the request.
+ * @param som Flag indicating if the packet starts a new request.  A context will be allocated if
+ * there is none currently assigned to the request.
+ *
+ * @return The reassembly context or null if there is no active request for a non-SOM packet.
+ */
+static struct mctp_interface_rx_context* mctp_interface_find_rx_context (
+	struct mctp_interface *interface, uint8_t src_eid, uint8_t msg_tag, bool som)
+{
+	struct mctp_interface_rx_context *free_ctx = NULL;
+	struct mctp_interface_rx_context *lru_ctx = NULL;
+	struct mctp_interface_rx_context *context;
+	size_t i;
+
+	for (i = 0; i < interface->rx_ctx_count; i++) {
+		context = &interface->rx_ctx[i];
+
+		if (!mctp_interface_rx_context_is_active (interface, context)) {
+			if (free_ctx == NULL) {
+				free_ctx = context;
+			}
+		}
+		else if ((context->source_eid == src_eid) && (context->msg_tag == msg_tag)) {
+			return context;
+		}
+		else if ((lru_ctx == NULL) ||
+			((interface->rx_ctx_use - context->last_use) >
+				(interface->rx_ctx_use - lru_ctx->last_use))) {
+			lru_ctx = context;
+		}
+	}
+
+	if (!som) {
+		return NULL;
+	}
+
+	if (free_ctx != NULL) {
+		return free_ctx;
+	}
+
+	debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_MCTP,
+		MCTP_LOGGING_RX_CONTEXT_EVICTED, (lru_ctx->source_eid << 8) | lru_ctx->msg_tag,
+		(src_eid << 8) | msg_tag);
+
+	return lru_ctx;
+}
+
+/**
+ * Restore the message type for a packet that continues a partially received request.  Only the
+ * first packet of a message indicates the message type, so the type must be restored from the
+ * request context before the packet can be parsed.
+ *
+ * @param interface MCTP interface instance.
+ * @param rx_packet The received packet that will be processed.
+ */
+static void mctp_interface_restore_rx_msg_type (struct mctp_interface *interface,
+	struct cmd_packet *rx_packet)
+{
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx_packet->data;
+	struct mctp_interface_rx_context *context;
+
+	if ((rx_packet->pkt_size < sizeof (struct mctp_protocol_transport_header)) || header->som) {
+		return;
+	}
+
+	context = mctp_interface_find_rx_context (interface, header->source_eid, header->msg_tag,
+		false);
+	if (context != NULL) {
+		interface->msg_type = context->msg_type;
+	}
+}
+
+/**
+ * Add a received packet to the reassembly context for the request.  When the last packet of the
+ * request is received, the complete message is moved to the interface message buffer for
+ * processing.
+ *
+ * @param interface MCTP interface instance.
+ * @param src_eid EID of the requester.
+ * @param dest_eid EID the request was sent to.
+ * @param msg_tag Message tag of the request.
+ * @param packet_seq Sequence number of the packet.
+ * @param som Flag indicating the first packet of the request.
+ * @param eom Flag indicating the last packet of the request.
+ * @param payload Payload data for the packet.
+ * @param payload_len Length of the packet payload.
+ * @param error_data Output for additional data about any error condition.
+ *
+ * @return CERBERUS_PROTOCOL_NO_ERROR if the packet was added to the request or the error code that
+ * should be reported to the requester.
+ */
+static uint8_t mctp_interface_reassemble_packet (struct mctp_interface *interface,
+	uint8_t src_eid, uint8_t dest_eid, uint8_t msg_tag, uint8_t packet_seq, bool som, bool eom,
+	const uint8_t *payload, size_t payload_len, uint32_t *error_data)
+{
+	struct mctp_interface_rx_context *context;
+
+	context = mctp_interface_find_rx_context (interface, src_eid, msg_tag, som);
+	if (context == NULL) {
+		return CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG;
+	}
+
+	if (som) {
+		context->length = 0;
+		context->source_eid = src_eid;
+		context->msg_tag = msg_tag;
+		context->msg_type = interface->msg_type;
+		context->start_packet_len = payload_len;
+		context->packet_seq = 0;
+		context->active = true;
+	}
+	else if (packet_seq != context->packet_seq) {
+		context->active = false;
+		return CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW;
+	}
+	else if (((int) payload_len != context->start_packet_len) &&
+		!(eom && ((int) payload_len < context->start_packet_len))) {
+		context->active = false;
+		*error_data = payload_len;
+		return CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN;
+	}
+
+	if ((payload_len + context->length) > sizeof (context->data)) {
+		context->active = false;
+		*error_data = payload_len + context->length;
+		return CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW;
+	}
+
+	memcpy (&context->data[context->length], payload, payload_len);
+	context->length += payload_len;
+	context->packet_seq = (context->packet_seq + 1) % 4;
+	context->last_use = ++interface->rx_ctx_use;
+
+	if (interface->rx_ctx_timeout_ms != 0) {
+		platform_init_timeout (interface->rx_ctx_timeout_ms, &context->expiration);
+	}
+
+	if (eom) {
+		memcpy (interface->msg_buffer.data, context->data, context->length);
+		interface->msg_buffer.length = context->length;
+		interface->msg_buffer.source_eid = src_eid;
+		interface->msg_buffer.target_eid = dest_eid;
+		interface->msg_buffer.channel_id = interface->channel_id;
+		interface->msg_tag = context->msg_tag;
+		interface->msg_type = context->msg_type;
+
+		context->active = false;
+	}
+
+	return CERBERUS_PROTOCOL_NO_ERROR;
+}
+
+/**
+ * Split the response message in the interface message buffer into packets.
+ *
+ * @param interface MCTP interface instance.
+ * @param tx_packets Output for the dynamically allocated response packets.  If this is null, the
+ * response will be packetized in place.
+ * @param num_packets Output for the number of response packets.
+ * @param src_eid EID of the original message source.
+ * @param dest_eid EID of the original message destination.
+ * @param msg_tag Tag of the original message.
+ * @param response_addr SMBUS address to respond to.
+ * @param source_addr SMBUS address responding from.
+ * @param cmd_set Command set to respond on.
+ *
+ * @return 0 if the response was packetized successfully or an error code.
+ */
+static int mctp_interface_packetize_response (struct mctp_interface *interface,
+	struct cmd_packet **tx_packets, size_t *num_packets, uint8_t src_eid, uint8_t dest_eid,
+	uint8_t msg_tag, uint8_t response_addr, uint8_t source_addr, uint8_t cmd_set)
+{
+	uint8_t i_packet;
+	uint8_t tag_owner;
+	size_t n_packets;
+	size_t payload_len;
+	size_t max_packet;
+	bool som;
+	bool eom;
+	int i_buf;
+	int status;
+
+	if (interface->msg_buffer.new_request) {
+		tag_owner = MCTP_PROTOCOL_TO_REQUEST;
+	}
+	else {
+		tag_owner = MCTP_PROTOCOL_TO_RESPONSE;
+	}
+
+	if (interface->msg_buffer.length > 0) {
+		interface->packet_seq = 0;
+		i_buf = 0;
+		som = true;
+
+		max_packet = device_manager_get_max_transmission_unit_by_eid (interface->device_manager,
+			src_eid);
+
+		if (tx_packets == NULL) {
+			status = mctp_interface_slice_response (interface, max_packet, source_addr,
+				response_addr, tag_owner);
+			if (ROT_IS_ERROR (status)) {
+				if (MCTP_PROTOCOL_IS_VENDOR_MSG (interface->msg_type)) {
+					return mctp_interface_generate_error_packet (interface, tx_packets,
+						num_packets, CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status, src_eid,
+						dest_eid, msg_tag, response_addr, source_addr, cmd_set);
+				}
+
+				return status;
+			}
+
+			*num_packets = interface->tx_msg.num_packets;
+			interface->msg_tag = (interface->msg_tag + 1) % 8;
+
+			return 0;
+		}
+
+		n_packets = ceil (interface->msg_buffer.length / (1.0 * max_packet));
+		*tx_packets = platform_calloc (n_packets, sizeof (struct cmd_packet));
+
+		if ((*tx_packets == NULL) && (MCTP_PROTOCOL_IS_VENDOR_MSG (interface->msg_type))) {
+			return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+				CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, MCTP_PROTOCOL_NO_MEMORY, src_eid, dest_eid,
+				msg_tag, response_addr, source_addr, cmd_set);
+		}
+
+		for (i_packet = 0; i_packet < n_packets; ++i_packet) {
+			eom = (i_packet == (n_packets - 1));
+			payload_len = (interface->msg_buffer.length > max_packet) ?
+				max_packet : interface->msg_buffer.length;
+
+			status = mctp_protocol_construct (&interface->msg_buffer.data[i_buf], payload_len,
+				(*tx_packets)[i_packet].data, CMD_MAX_PACKET_SIZE, source_addr,
+				interface->msg_buffer.source_eid, interface->msg_buffer.target_eid, som, eom,
+				interface->packet_seq, interface->msg_tag, tag_owner, response_addr,
+				&interface->msg_type);
+
+			if ((ROT_IS_ERROR (status)) &&
+				(MCTP_PROTOCOL_IS_VENDOR_MSG (interface->msg_type))) {
+				platform_free (*tx_packets);
+				return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+					CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status, src_eid, dest_eid, msg_tag,
+					response_addr, source_addr, cmd_set);
+			}
+			else {
+				som = false;
+				interface->packet_seq = (interface->packet_seq + 1) % 4;
+				interface->msg_buffer.length -= payload_len;
+				i_buf += payload_len;
+				(*tx_packets)[i_packet].state = CMD_VALID_PACKET;
+				(*tx_packets)[i_packet].pkt_size = status;
+				(*tx_packets)[i_packet].dest_addr = response_addr;
+			}
+		}
+
+		*num_packets = n_packets;
+		interface->msg_tag = (interface->msg_tag + 1) % 8;
+	}
+	else if (tx_packets != NULL) {
+		*tx_packets = NULL;
+		*num_packets = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * Process a received MCTP packet.
+ *
+ * @param interface MCTP interface instance.
+ * @param rx_packet The received packet to process.
+ * @param tx_packets Output for the dynamically allocated response packets.  If this is null, the
+ * response will be packetized in place.
+ * @param num_packets Output for the number of response packets.
+ *
+ * @return 0 if the packet was processed successfully or an error code.
+ */
+static int mctp_interface_process (struct mctp_interface *interface, struct cmd_packet *rx_packet,
 	struct cmd_packet **tx_packets, size_t *num_packets)
 {
 	struct cerberus_protocol_header *header;
 	uint32_t msg1 = 0;
 	uint32_t msg2 = 0;
+	uint32_t error_data = 0;
 	uint8_t i_byte;
+	uint8_t error_code;
 	uint8_t *payload;
 	uint8_t source_addr;
 	uint8_t src_eid;
@@ -170,26 +605,20 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 	uint8_t msg_tag;
 	uint8_t packet_seq;
 	uint8_t crc;
-	uint8_t i_packet;
-	uint8_t tag_owner;
 	uint8_t response_addr;
 	uint8_t cmd_set = 0;
 	size_t msg_len;
-	size_t n_packets;
 	size_t payload_len;
-	size_t max_packet;
 	bool som;
 	bool eom;
-	int i_buf;
 	int status;
 
-	if ((interface == NULL) || (rx_packet == NULL) || (tx_packets == NULL) ||
-		(num_packets == NULL)) {
-		return MCTP_PROTOCOL_INVALID_ARGUMENT;
-	}
-
 	*num_packets = 0;
-	*tx_packets = NULL;
+	interface->tx_msg.num_packets = 0;
+
+	if (interface->rx_ctx != NULL) {
+		mctp_interface_restore_rx_msg_type (interface, rx_packet);
+	}
 
 	status = mctp_protocol_interpret (rx_packet->data, rx_packet->pkt_size, rx_packet->dest_addr,
 		&source_addr, &som, &eom, &src_eid, &dest_eid, &payload, &payload_len, &msg_tag,
@@ -233,55 +662,67 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 		return 0;
 	}
 
-	if (som) {
-		interface->msg_buffer.length = 0;
-		interface->msg_buffer.source_eid = src_eid;
-		interface->msg_buffer.target_eid = dest_eid;
-		interface->start_packet_len = payload_len;
-		interface->msg_buffer.channel_id = interface->channel_id;
-		interface->packet_seq = 0;
-		interface->msg_tag = msg_tag;
-	}
-	else if (interface->start_packet_len == 0) {
-		// If this packet is not a SOM, and we haven't received a SOM packet yet
-		return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
-			CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, 0, src_eid, dest_eid, msg_tag, response_addr,
-			rx_packet->dest_addr, cmd_set);
-	}
-	else if (packet_seq != interface->packet_seq) {
-		return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
-			CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW, 0, src_eid, dest_eid, msg_tag, response_addr,
-			rx_packet->dest_addr, cmd_set);
-	}
-	else if (msg_tag != interface->msg_tag) {
-		return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
-			CERBERUS_PROTOCOL_ERROR_INVALID_REQ, 0, src_eid, dest_eid, msg_tag, response_addr,
-			rx_packet->dest_addr, cmd_set);
-	}
-	else if ((src_eid != interface->msg_buffer.source_eid) ||
-		(dest_eid != interface->msg_buffer.target_eid)) {
-		return 0;
+	if (interface->rx_ctx != NULL) {
+		error_code = mctp_interface_reassemble_packet (interface, src_eid, dest_eid, msg_tag,
+			packet_seq, som, eom, payload, payload_len, &error_data);
+		if (error_code != CERBERUS_PROTOCOL_NO_ERROR) {
+			return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+				error_code, error_data, src_eid, dest_eid, msg_tag, response_addr,
+				rx_packet->dest_addr, cmd_set);
+		}
 	}
 	else {
-		if ((payload_len != interface->start_packet_len) &&
-		   !(eom && (payload_len < interface->start_packet_len))) {
-			// Can only have different size than SOM if EOM and smaller than SOM
+		if (som) {
+			interface->msg_buffer.length = 0;
+			interface->msg_buffer.source_eid = src_eid;
+			interface->msg_buffer.target_eid = dest_eid;
+			interface->start_packet_len = payload_len;
+			interface->msg_buffer.channel_id = interface->channel_id;
+			interface->packet_seq = 0;
+			interface->msg_tag = msg_tag;
+		}
+		else if (interface->start_packet_len == 0) {
+			// If this packet is not a SOM, and we haven't received a SOM packet yet
 			return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
-				CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN, payload_len, src_eid, dest_eid, msg_tag,
+				CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, 0, src_eid, dest_eid, msg_tag,
 				response_addr, rx_packet->dest_addr, cmd_set);
 		}
-	}
+		else if (packet_seq != interface->packet_seq) {
+			return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+				CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW, 0, src_eid, dest_eid, msg_tag,
+				response_addr, rx_packet->dest_addr, cmd_set);
+		}
+		else if (msg_tag != interface->msg_tag) {
+			return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+				CERBERUS_PROTOCOL_ERROR_INVALID_REQ, 0, src_eid, dest_eid, msg_tag, response_addr,
+				rx_packet->dest_addr, cmd_set);
+		}
+		else if ((src_eid != interface->msg_buffer.source_eid) ||
+			(dest_eid != interface->msg_buffer.target_eid)) {
+			return 0;
+		}
+		else {
+			if ((payload_len != interface->start_packet_len) &&
+			   !(eom && (payload_len < interface->start_packet_len))) {
+				// Can only have different size than SOM if EOM and smaller than SOM
+				return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+					CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN, payload_len, src_eid, dest_eid,
+					msg_tag, response_addr, rx_packet->dest_addr, cmd_set);
+			}
+		}
 
-	if ((payload_len + interface->msg_buffer.length) > sizeof (interface->msg_buffer.data)) {
-		return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
-			CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW, payload_len + interface->msg_buffer.length,
-			src_eid, dest_eid, msg_tag, response_addr, rx_packet->dest_addr, cmd_set);
-	}
+		if ((payload_len + interface->msg_buffer.length) >
+			sizeof (interface->msg_buffer.data)) {
+			return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+				CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW, payload_len + interface->msg_buffer.length,
+				src_eid, dest_eid, msg_tag, response_addr, rx_packet->dest_addr, cmd_set);
+		}
 
-	// Assemble packets into message and process message when EOM is received
-	memcpy (&interface->msg_buffer.data[interface->msg_buffer.length], payload, payload_len);
-	interface->msg_buffer.length += payload_len;
-	interface->packet_seq = (interface->packet_seq + 1) % 4;
+		// Assemble packets into message and process message when EOM is received
+		memcpy (&interface->msg_buffer.data[interface->msg_buffer.length], payload, payload_len);
+		interface->msg_buffer.length += payload_len;
+		interface->packet_seq = (interface->packet_seq + 1) % 4;
+	}
 
 	if (eom) {
 		if (MCTP_PROTOCOL_IS_CONTROL_MSG (interface->msg_type)) {
@@ -300,6 +741,8 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 
 			interface->msg_buffer.max_response = device_manager_get_max_message_len_by_eid (
 				interface->device_manager, src_eid);
+			interface->msg_buffer.can_defer =
+				(interface->async != NULL) && !interface->deferred.pending;
 			status = interface->cmd_interface->process_request (interface->cmd_interface,
 				&interface->msg_buffer);
 
@@ -310,6 +753,18 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 					&rx_packet->pkt_timeout);
 			}
 
+			if (status == CMD_RESPONSE_DEFERRED_ESCAPE_SEQ) {
+				interface->deferred.source_addr = rx_packet->dest_addr;
+				interface->deferred.response_addr = response_addr;
+				interface->deferred.msg_tag = msg_tag;
+				interface->deferred.msg_type = interface->msg_type;
+				interface->deferred.cmd_set = cmd_set;
+				interface->deferred.pending = true;
+
+				interface->msg_buffer.length = 0;
+				return 0;
+			}
+
 			if (status == CMD_ERROR_MESSAGE_ESCAPE_SEQ) {
 				if (interface->msg_buffer.length == sizeof (struct cerberus_protocol_error)) {
 					struct cerberus_protocol_error *error_msg =
@@ -337,7 +792,6 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 						interface->msg_buffer.source_eid = device_manager_get_device_eid (
 							interface->device_manager, device_num);
 						interface->msg_buffer.length = status;
-						tag_owner = MCTP_PROTOCOL_TO_REQUEST;
 						interface->msg_buffer.new_request = true;
 						status = 0;
 					}
@@ -373,70 +827,216 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 				dest_eid, msg_tag, response_addr, rx_packet->dest_addr, cmd_set);
 		}
 
-		if (interface->msg_buffer.new_request) {
-			tag_owner = MCTP_PROTOCOL_TO_REQUEST;
-		}
-		else {
-			tag_owner = MCTP_PROTOCOL_TO_RESPONSE;
-		}
+		return mctp_interface_packetize_response (interface, tx_packets, num_packets, src_eid,
+			dest_eid, msg_tag, response_addr, rx_packet->dest_addr, cmd_set);
+	}
 
-		if (interface->msg_buffer.length > 0) {
-			interface->packet_seq = 0;
-			i_buf = 0;
-			som = true;
+	return 0;
+}
 
-			max_packet = device_manager_get_max_transmission_unit_by_eid (interface->device_manager,
-				src_eid);
-			n_packets = ceil (interface->msg_buffer.length / (1.0 * max_packet));
-			*tx_packets = platform_calloc (n_packets, sizeof (struct cmd_packet));
+/**
+ * MCTP interface message processing function
+ *
+ * @param interface MCTP interface instance
+ * @param rx_packet The received packet to process
+ * @param tx_packets Pointer to buffer of response packets - NEEDS TO BE FREED BY CONSUMER IF
+ * COMPLETION CODE IS 0 AND num_packets > 0
+ * @param num_packets Number of packets in packets buffer
+ *
+ * @return Completion status, 0 if success or an error code.
+ */
+int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_packet *rx_packet,
+	struct cmd_packet **tx_packets, size_t *num_packets)
+{
+	if ((interface == NULL) || (rx_packet == NULL) || (tx_packets == NULL) ||
+		(num_packets == NULL)) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
+	}
 
-			if ((*tx_packets == NULL) && (MCTP_PROTOCOL_IS_VENDOR_MSG (interface->msg_type))) {
-				return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
-					CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, MCTP_PROTOCOL_NO_MEMORY, src_eid, dest_eid,
-					msg_tag, response_addr, rx_packet->dest_addr, cmd_set);
-			}
+	*tx_packets = NULL;
 
-			for (i_packet = 0; i_packet < n_packets; ++i_packet) {
-				eom = (i_packet == (n_packets - 1));
-				payload_len = (interface->msg_buffer.length > max_packet) ?
-					max_packet : interface->msg_buffer.length;
-
-				status = mctp_protocol_construct (&interface->msg_buffer.data[i_buf], payload_len,
-					(*tx_packets)[i_packet].data, CMD_MAX_PACKET_SIZE, rx_packet->dest_addr,
-					interface->msg_buffer.source_eid, interface->msg_buffer.target_eid, som, eom,
-					interface->packet_seq, interface->msg_tag, tag_owner, response_addr,
-					&interface->msg_type);
-
-				if ((ROT_IS_ERROR (status)) &&
-					(MCTP_PROTOCOL_IS_VENDOR_MSG (interface->msg_type))) {
-					platform_free (*tx_packets);
-					return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
-						CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status, src_eid, dest_eid, msg_tag,
-						response_addr, rx_packet->dest_addr, cmd_set);
-				}
-				else {
-					som = false;
-					interface->packet_seq = (interface->packet_seq + 1) % 4;
-					interface->msg_buffer.length -= payload_len;
-					i_buf += payload_len;
-					(*tx_packets)[i_packet].state = CMD_VALID_PACKET;
-					(*tx_packets)[i_packet].pkt_size = status;
-					(*tx_packets)[i_packet].dest_addr = response_addr;
-				}
-			}
+	return mctp_interface_process (interface, rx_packet, tx_packets, num_packets);
+}
 
-			*num_packets = n_packets;
-			interface->msg_tag = (interface->msg_tag + 1) % 8;
-		}
-		else {
-			*tx_packets = NULL;
-			*num_packets = 0;
-		}
+/**
+ * Process a received MCTP packet without allocating memory for the response.  Any response message
+ * is left in the MCTP interface buffer and split into packet descriptors that reference the
+ * message data.  Each response packet must be retrieved with mctp_interface_get_response_packet
+ * before the next packet is processed.
+ *
+ * @param interface MCTP interface instance.
+ * @param rx_packet The received packet to process.
+ * @param num_packets Output for the number of response packets that are available.
+ *
+ * @return 0 if the packet was processed successfully or an error code.
+ */
+int mctp_interface_process_packet_in_place (struct mctp_interface *interface,
+	struct cmd_packet *rx_packet, size_t *num_packets)
+{
+	if ((interface == NULL) || (rx_packet == NULL) || (num_packets == NULL)) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	return mctp_interface_process (interface, rx_packet, NULL, num_packets);
+}
+
+/**
+ * Construct one packet of a response generated by mctp_interface_process_packet_in_place.
+ *
+ * @param interface MCTP interface instance.
+ * @param index Index of the response packet to construct.
+ * @param packet Output for the response packet.  The same packet buffer can be reused for every
+ * packet in the response.
+ *
+ * @return 0 if the packet was constructed successfully or an error code.
+ */
+int mctp_interface_get_response_packet (struct mctp_interface *interface, size_t index,
+	struct cmd_packet *packet)
+{
+	struct mctp_interface_tx_message *tx_msg;
+	uint8_t msg_type;
+	int status;
+
+	if ((interface == NULL) || (packet == NULL)) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	tx_msg = &interface->tx_msg;
+	if (index >= tx_msg->num_packets) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
 	}
 
+	msg_type = tx_msg->msg_type;
+	status = mctp_protocol_construct (tx_msg->packet[index].payload, tx_msg->packet[index].length,
+		packet->data, sizeof (packet->data), tx_msg->source_addr, tx_msg->dest_eid,
+		tx_msg->source_eid, tx_msg->packet[index].som, tx_msg->packet[index].eom,
+		tx_msg->packet[index].packet_seq, tx_msg->msg_tag, tx_msg->tag_owner, tx_msg->dest_addr,
+		&msg_type);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	packet->state = CMD_VALID_PACKET;
+	packet->pkt_size = status;
+	packet->dest_addr = tx_msg->dest_addr;
+	packet->timeout_valid = false;
+
 	return 0;
 }
 
+/**
+ * Generate the response for a request that was deferred by the command interface.
+ *
+ * @param interface MCTP interface instance.
+ * @param tx_packets Output for the dynamically allocated response packets.  If this is null, the
+ * response will be packetized in place.
+ * @param num_packets Output for the number of response packets.  This will be 0 if there is no
+ * response ready to send.
+ *
+ * @return 0 if the response was processed successfully or an error code.
+ */
+static int mctp_interface_deferred_response (struct mctp_interface *interface,
+	struct cmd_packet **tx_packets, size_t *num_packets)
+{
+	struct mctp_interface_deferred_response *deferred = &interface->deferred;
+	uint8_t src_eid;
+	uint8_t dest_eid;
+	int status;
+
+	*num_packets = 0;
+	interface->tx_msg.num_packets = 0;
+
+	if (!deferred->pending || (interface->async == NULL)) {
+		return 0;
+	}
+
+	/* Without reassembly contexts, the message buffer holds any request that is being received.
+	 * Hold the response until that request has been processed. */
+	if ((interface->rx_ctx == NULL) && (interface->msg_buffer.length != 0)) {
+		return 0;
+	}
+
+	status = cmd_async_get_response (interface->async, &interface->msg_buffer);
+	if (status == CMD_ASYNC_NO_RESPONSE) {
+		return 0;
+	}
+
+	deferred->pending = false;
+
+	src_eid = interface->msg_buffer.source_eid;
+	dest_eid = interface->msg_buffer.target_eid;
+	interface->msg_tag = deferred->msg_tag;
+	interface->msg_type = deferred->msg_type;
+
+	if (status != 0) {
+		interface->msg_buffer.length = 0;
+		return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+			CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status, src_eid, dest_eid, deferred->msg_tag,
+			deferred->response_addr, deferred->source_addr, deferred->cmd_set);
+	}
+	else if (interface->msg_buffer.length == 0) {
+		return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+			CERBERUS_PROTOCOL_NO_ERROR, status, src_eid, dest_eid, deferred->msg_tag,
+			deferred->response_addr, deferred->source_addr, deferred->cmd_set);
+	}
+
+	if (interface->msg_buffer.length >
+		device_manager_get_max_message_len_by_eid (interface->device_manager, src_eid)) {
+		interface->msg_buffer.length = 0;
+		return mctp_interface_generate_error_packet (interface, tx_packets, num_packets,
+			CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, MCTP_PROTOCOL_MSG_TOO_LARGE, src_eid, dest_eid,
+			deferred->msg_tag, deferred->response_addr, deferred->source_addr, deferred->cmd_set);
+	}
+
+	return mctp_interface_packetize_response (interface, tx_packets, num_packets, src_eid,
+		dest_eid, deferred->msg_tag, deferred->response_addr, deferred->source_addr,
+		deferred->cmd_set);
+}
+
+/**
+ * Get the response packets for a request that was deferred by the command interface.
+ *
+ * @param interface MCTP interface instance.
+ * @param tx_packets Output for the dynamically allocated response packets.  These must be freed by
+ * the caller if num_packets is not 0.
+ * @param num_packets Output for the number of response packets.  This will be 0 if there is no
+ * response ready to send.
+ *
+ * @return 0 if the deferred response was checked successfully or an error code.
+ */
+int mctp_interface_get_deferred_response (struct mctp_interface *interface,
+	struct cmd_packet **tx_packets, size_t *num_packets)
+{
+	if ((interface == NULL) || (tx_packets == NULL) || (num_packets == NULL)) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	*tx_packets = NULL;
+
+	return mctp_interface_deferred_response (interface, tx_packets, num_packets);
+}
+
+/**
+ * Get the response for a request that was deferred by the command interface without allocating
+ * memory for the response.  Each response packet must be retrieved with
+ * mctp_interface_get_response_packet before the next packet is processed.
+ *
+ * @param interface MCTP interface instance.
+ * @param num_packets Output for the number of response packets.  This will be 0 if there is no
+ * response ready to send.
+ *
+ * @return 0 if the deferred response was checked successfully or an error code.
+ */
+int mctp_interface_get_deferred_response_in_place (struct mctp_interface *interface,
+	size_t *num_packets)
+{
+	if ((interface == NULL) || (num_packets == NULL)) {
+		return MCTP_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	return mctp_interface_deferred_response (interface, NULL, num_packets);
+}
+
 /**
  * Reset the MCTP layer.  This discards previously received packets and begins looking for a new
  * message.
@@ -445,8 +1045,14 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
  */
 void mctp_interface_reset_message_processing (struct mctp_interface *interface)
 {
+	size_t i;
+
 	interface->msg_buffer.length = 0;
 	interface->start_packet_len = 0;
+
+	for (i = 0; i < interface->rx_ctx_count; i++) {
+		interface->rx_ctx[i].active = false;
+	}
 }
 
 /**
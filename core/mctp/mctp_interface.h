@@ -5,12 +5,84 @@
 #define MCTP_INTERFACE_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
 #include "cmd_interface/cmd_channel.h"
 #include "cmd_interface/device_manager.h"
 #include "cmd_interface/cmd_interface.h"
+#include "cmd_interface/cmd_async.h"
+#include "cmd_interface/cerberus_protocol.h"
 #include "mctp_protocol.h"
 
 
+/**
+ * The maximum number of packets that can be generated for a single response message when the
+ * response is packetized in place.
+ */
+#ifndef MCTP_INTERFACE_MAX_RESPONSE_PACKETS
+#define	MCTP_INTERFACE_MAX_RESPONSE_PACKETS	\
+	((MCTP_PROTOCOL_MAX_MESSAGE_BODY + MCTP_PROTOCOL_MIN_TRANSMISSION_UNIT - 1) / \
+		MCTP_PROTOCOL_MIN_TRANSMISSION_UNIT)
+#endif
+
+
+/**
+ * Descriptor for a single packet of a response message.  The packet payload is not copied and
+ * references the message data held by the MCTP interface.
+ */
+struct mctp_interface_tx_packet {
+	uint8_t *payload;								/**< Payload data for the packet. */
+	uint8_t length;									/**< Length of the packet payload. */
+	uint8_t packet_seq;								/**< Sequence number for the packet. */
+	bool som;										/**< Flag for the first packet. */
+	bool eom;										/**< Flag for the last packet. */
+};
+
+/**
+ * A response message that has been split into packets without being copied.
+ */
+struct mctp_interface_tx_message {
+	/** Descriptors for each packet in the response. */
+	struct mctp_interface_tx_packet packet[MCTP_INTERFACE_MAX_RESPONSE_PACKETS];
+	size_t num_packets;								/**< Number of packets in the response. */
+	uint8_t source_addr;							/**< SMBus address sending the response. */
+	uint8_t dest_addr;								/**< SMBus address to send the response to. */
+	uint8_t source_eid;								/**< EID sending the response. */
+	uint8_t dest_eid;								/**< EID receiving the response. */
+	uint8_t msg_tag;								/**< Message tag for the response. */
+	uint8_t tag_owner;								/**< Tag owner for the response. */
+	uint8_t msg_type;								/**< Message type of the response. */
+};
+
+/**
+ * Reassembly state for a single multi-packet request.  Requests are tracked separately for each
+ * source EID and message tag so that packets from different requesters can be interleaved.
+ */
+struct mctp_interface_rx_context {
+	uint8_t data[MCTP_PROTOCOL_MAX_MESSAGE_BODY];	/**< Message data received so far. */
+	size_t length;									/**< Length of the received message data. */
+	platform_clock expiration;						/**< Time when the partial message expires. */
+	uint32_t last_use;								/**< Age counter for LRU eviction. */
+	int start_packet_len;							/**< Length of the SOM packet payload. */
+	uint8_t source_eid;								/**< EID of the requester. */
+	uint8_t msg_tag;								/**< Message tag for the request. */
+	uint8_t packet_seq;								/**< Next expected packet sequence. */
+	uint8_t msg_type;								/**< Message type from the SOM packet. */
+	bool active;									/**< Flag indicating the context is in use. */
+};
+
+/**
+ * Information needed to send the response for a request that was deferred.
+ */
+struct mctp_interface_deferred_response {
+	uint8_t source_addr;							/**< SMBus address that received the request. */
+	uint8_t response_addr;							/**< SMBus address to send the response to. */
+	uint8_t msg_tag;								/**< Message tag of the request. */
+	uint8_t msg_type;								/**< Message type of the request. */
+	uint8_t cmd_set;								/**< Command set of the request. */
+	bool pending;									/**< Flag indicating a response is expected. */
+};
+
 /**
  * MCTP interface context
  */
@@ -26,6 +98,14 @@ struct mctp_interface {
 	uint8_t msg_type;								/**< Current MCTP exchange message type */
 	uint8_t eid;									/**< MCTP EID to listen to */
 	int channel_id;									/**< Channel ID associated with the interface. */
+	struct mctp_interface_tx_message tx_msg;		/**< Response packets generated in place. */
+	struct cerberus_protocol_error error_msg;		/**< Buffer for in place error responses. */
+	struct mctp_interface_rx_context *rx_ctx;		/**< Per-requester reassembly contexts. */
+	size_t rx_ctx_count;							/**< Number of reassembly contexts. */
+	uint32_t rx_ctx_timeout_ms;						/**< Timeout for partial messages. */
+	uint32_t rx_ctx_use;							/**< Counter for context LRU tracking. */
+	struct cmd_async *async;						/**< Context for deferred requests. */
+	struct mctp_interface_deferred_response deferred;	/**< Routing for a deferred response. */
 };
 
 
@@ -34,11 +114,23 @@ int mctp_interface_init (struct mctp_interface *interface, struct cmd_interface
 void mctp_interface_deinit (struct mctp_interface *interface);
 
 int mctp_interface_set_channel_id (struct mctp_interface *interface, int channel_id);
+int mctp_interface_set_reassembly_contexts (struct mctp_interface *interface,
+	struct mctp_interface_rx_context *contexts, size_t count, uint32_t timeout_ms);
+int mctp_interface_set_async (struct mctp_interface *interface, struct cmd_async *async);
 
 int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_packet *rx_packet,
 	struct cmd_packet **tx_packets, size_t *num_packets);
+int mctp_interface_process_packet_in_place (struct mctp_interface *interface,
+	struct cmd_packet *rx_packet, size_t *num_packets);
+int mctp_interface_get_response_packet (struct mctp_interface *interface, size_t index,
+	struct cmd_packet *packet);
 void mctp_interface_reset_message_processing (struct mctp_interface *interface);
 
+int mctp_interface_get_deferred_response (struct mctp_interface *interface,
+	struct cmd_packet **tx_packets, size_t *num_packets);
+int mctp_interface_get_deferred_response_in_place (struct mctp_interface *interface,
+	size_t *num_packets);
+
 int mctp_interface_issue_request (struct mctp_interface *interface, uint8_t dest_addr,
 	uint8_t dest_eid, uint8_t src_addr, uint8_t src_eid, uint8_t command_id, void *request_params,
 	uint8_t *buf, int buf_len, uint8_t msg_type);
@@ -15,6 +15,7 @@ enum {
 	MCTP_LOGGING_ERR_MSG,					/**< Cerberus protocol error message recevied. */
 	MCTP_LOGGING_CONTROL_FAIL,				/**< Failure while processing MCTP control message. */
 	MCTP_LOGGING_PKT_DROPPED,				/**< MCTP packet dropped. */
+	MCTP_LOGGING_RX_CONTEXT_EVICTED,		/**< Partial request discarded for a new request. */
 };
 
 
@@ -123,6 +123,7 @@ int mctp_protocol_construct (uint8_t *buf, size_t buf_len, uint8_t *out_buf, siz
 		(struct mctp_protocol_transport_header*) out_buf;
 	size_t msg_offset = sizeof (struct mctp_protocol_transport_header);
 	size_t out_len;
+	uint8_t pec;
 	bool crc;
 
 	if ((buf == NULL) || (out_buf == NULL) || (msg_type == NULL)) {
@@ -170,7 +171,10 @@ int mctp_protocol_construct (uint8_t *buf, size_t buf_len, uint8_t *out_buf, siz
 
 	memcpy (&out_buf[msg_offset], buf, buf_len);
 	if (crc) {
-		out_buf[msg_offset + buf_len] = checksum_crc8 ((dest_addr << 1), out_buf, out_len - 1);
+		/* The PEC covers the SMBus address, header, and payload, which are folded in separately. */
+		pec = checksum_update_crc8 (checksum_init_smbus_crc8 (dest_addr << 1), out_buf,
+			msg_offset);
+		out_buf[msg_offset + buf_len] = checksum_update_crc8 (pec, buf, buf_len);
 	}
 
 	return out_len;
@@ -232,7 +232,8 @@ static int recovery_image_get_version (struct recovery_image *image, char *versi
 	return status;
 }
 
-static int recovery_image_apply_to_flash (struct recovery_image *image, struct spi_flash *flash)
+static int recovery_image_apply_to_flash (struct recovery_image *image, struct spi_flash *flash,
+	struct flash_copy_stream *stream)
 {
 	struct recovery_image_header header;
 	struct recovery_image_section_header section_header;
@@ -250,6 +251,10 @@ static int recovery_image_apply_to_flash (struct recovery_image *image, struct s
 		return RECOVERY_IMAGE_INVALID_ARGUMENT;
 	}
 
+	if (stream && (stream->flash != &flash->base)) {
+		return RECOVERY_IMAGE_INVALID_ARGUMENT;
+	}
+
 	status = recovery_image_header_init (&header, image->flash, image->addr);
 	if (status != 0) {
 		return status;
@@ -274,8 +279,14 @@ static int recovery_image_apply_to_flash (struct recovery_image *image, struct s
 		recovery_image_section_header_get_section_image_length (&section_header, &section_img_len);
 		recovery_image_section_header_release (&section_header);
 
-		status = flash_copy_ext_to_blank_and_verify (&flash->base, host_addr, image->flash,
-			next_img_addr + section_hdr_len, section_img_len);
+		if (stream) {
+			status = flash_copy_stream_copy_ext_to_blank_and_verify (stream, host_addr,
+				image->flash, next_img_addr + section_hdr_len, section_img_len);
+		}
+		else {
+			status = flash_copy_ext_to_blank_and_verify (&flash->base, host_addr, image->flash,
+				next_img_addr + section_hdr_len, section_img_len);
+		}
 		if (status != 0) {
 			return status;
 		}
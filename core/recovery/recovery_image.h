@@ -12,6 +12,7 @@
 #include "flash/flash.h"
 #include "manifest/pfm/pfm_manager.h"
 #include "flash/spi_flash.h"
+#include "flash/flash_util.h"
 
 
 /**
@@ -65,10 +66,13 @@ struct recovery_image {
 	 *
 	 * @param image The recovery image to query.
 	 * @param flash The flash device to write the recovery image to.
+	 * @param stream Optional copy stream for the host flash.  If this is null, the recovery image
+	 * will be written one flash page at a time.
 	 *
 	 * @return 0 if applying the recovery image to host flash was successful or an error code.
 	 */
-	int (*apply_to_flash) (struct recovery_image *image, struct spi_flash *flash);
+	int (*apply_to_flash) (struct recovery_image *image, struct spi_flash *flash,
+		struct flash_copy_stream *stream);
 
 	struct flash *flash;							/**< The flash device that contains the recovery image. */
  	uint32_t addr;									/**< The starting address in flash of the recovery image. */
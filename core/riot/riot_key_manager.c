@@ -50,6 +50,7 @@ static int riot_key_manager_authenticate_stored_certificates (struct riot_key_ma
 				(uint8_t**) &riot->intermediate_ca.cert, &riot->intermediate_ca.length);
 			if ((status != 0) && (status != KEYSTORE_NO_KEY) && (status != KEYSTORE_BAD_KEY)) {
 				riot_key_manager_free_ca_cert (&riot->root_ca);
+				riot->ca_version++;
 				platform_free (signed_devid);
 
 				platform_mutex_unlock (&riot->store_lock);
@@ -75,6 +76,7 @@ static int riot_key_manager_authenticate_stored_certificates (struct riot_key_ma
 		return status;
 	}
 
+	riot->ca_version++;
 	platform_mutex_unlock (&riot->store_lock);
 
 	/* Validate that the signed Device ID is valid for the current certificate chain. */
@@ -137,6 +139,7 @@ auth_load_error:
 	platform_free (signed_devid);
 	riot_key_manager_free_ca_cert (&riot->root_ca);
 	riot_key_manager_free_ca_cert (&riot->intermediate_ca);
+	riot->ca_version++;
 
 	return status;
 }
@@ -465,3 +468,22 @@ const struct der_cert* riot_key_manager_get_intermediate_ca (struct riot_key_man
 		return NULL;
 	}
 }
+
+/**
+ * Get the current version of the RIoT CA certificates.  The version changes every time the root or
+ * intermediate CA certificates are updated, so users that cache information derived from the CA
+ * certificates can detect when it is no longer valid.
+ *
+ * @param riot The RIoT key manager to query.
+ *
+ * @return The CA certificate version.
+ */
+uint32_t riot_key_manager_get_ca_version (struct riot_key_manager *riot)
+{
+	if (riot) {
+		return riot->ca_version;
+	}
+	else {
+		return 0;
+	}
+}
@@ -24,6 +24,7 @@ struct riot_key_manager {
 	struct x509_engine *x509;				/**< X.509 engine for certificate authentication. */
 	struct der_cert root_ca;				/**< The RIoT root CA certificate. */
 	struct der_cert intermediate_ca;		/**< The RIoT intermediate CA certificate. */
+	uint32_t ca_version;					/**< Identifier for the CA certificates.  This changes every time they are updated. */
 	bool static_keys;						/**< Flag indicating static key buffers. */
 	bool static_devid;						/**< Flag indicating a static device ID cert buffer. */
 	platform_mutex store_lock;				/**< Synchronization for cert storage. */
@@ -53,6 +54,7 @@ void riot_key_manager_release_riot_keys (struct riot_key_manager *riot,
 
 const struct der_cert* riot_key_manager_get_root_ca (struct riot_key_manager *riot);
 const struct der_cert* riot_key_manager_get_intermediate_ca (struct riot_key_manager *riot);
+uint32_t riot_key_manager_get_ca_version (struct riot_key_manager *riot);
 
 
 #define	RIOT_KEY_MANAGER_ERROR(code)		ROT_ERROR (ROT_MODULE_RIOT_KEY_MANAGER, code)
@@ -5,6 +5,7 @@
 #define SPI_FILTER_INTERFACE_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include "status/rot_status.h"
 
@@ -248,6 +249,25 @@ struct spi_filter_interface {
 	 */
 	int (*clear_flash_dirty_state) (struct spi_filter_interface *filter);
 
+	/**
+	 * Get SPI filter map of flash blocks that have been written or erased since the flash dirty
+	 * state was last cleared.  Each bit in the map represents a single block of flash, with bit 0
+	 * of the first byte representing the block at address 0.  A set bit indicates a dirty block.
+	 *
+	 * Filters that don't track writes at block granularity should return
+	 * SPI_FILTER_UNSUPPORTED_OPERATION or leave this function null.
+	 *
+	 * @param filter The SPI filter instance to use
+	 * @param map Output buffer for the dirty block map
+	 * @param length Length of the map buffer
+	 * @param block_size Output for the number of flash bytes represented by each bit in the map
+	 *
+	 * @return The number of bytes of map data or an error code.  Use ROT_IS_ERROR to check the
+	 * return value.  Flash blocks not covered by the returned map must be treated as dirty.
+	 */
+	int (*get_flash_dirty_blocks) (struct spi_filter_interface *filter, uint8_t *map,
+		size_t length, uint32_t *block_size);
+
 	/**
 	 * Get SPI filter bypass mode
 	 *
@@ -91,6 +91,9 @@ enum {
 	ROT_MODULE_CMD_DEVICE = 0x004f,						/**< Command handler for device-specific workflows. */
 	ROT_MODULE_HOST_PROCESSOR_OBSERVER = 0x0050,		/**< Observers for host processor management. */
 	ROT_MODULE_COUNTER_MANAGER = 0x0051,				/**< Counter operation management. */
+	ROT_MODULE_HOST_FW_VERIFICATION_CACHE = 0x0052,		/**< Persistent cache of verified host images. */
+	ROT_MODULE_CMD_ASYNC = 0x0053,						/**< Deferred execution of command requests. */
+	ROT_MODULE_ATTESTATION_SCHEDULER = 0x0054,			/**< Scheduler for attesting multiple devices. */
 };
 
 
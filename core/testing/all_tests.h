@@ -14,10 +14,13 @@
 //#define	TESTING_RUN_HASH_SUITE
 //#define	TESTING_RUN_RSA_MBEDTLS_SUITE
 //#define	TESTING_RUN_FLASH_UTIL_SUITE
+//#define	TESTING_RUN_FLASH_COMPARE_SUITE
 //#define	TESTING_RUN_APP_IMAGE_SUITE
 //#define	TESTING_RUN_FIRMWARE_UPDATE_SUITE
 //#define	TESTING_RUN_HOST_FW_UTIL_SUITE
+//#define	TESTING_RUN_HOST_FW_VERIFICATION_CACHE_SUITE
 //#define	TESTING_RUN_MANIFEST_FLASH_SUITE
+//#define	TESTING_RUN_MANIFEST_ARENA_SUITE
 //#define	TESTING_RUN_PFM_FLASH_SUITE
 //#define	TESTING_RUN_CFM_FLASH_SUITE
 //#define	TESTING_RUN_CERBERUS_PROTOCOL_REQUIRED_COMMANDS_SUITE
@@ -58,6 +61,7 @@
 //#define	TESTING_RUN_SPI_FILTER_IRQ_HANDLER_DIRTY_SUITE
 //#define	TESTING_RUN_HOST_IRQ_HANDLER_PFM_CHECK_SUITE
 //#define	TESTING_RUN_ATTESTATION_MASTER_SUITE
+//#define	TESTING_RUN_ATTESTATION_SCHEDULER_SUITE
 //#define	TESTING_RUN_ATTESTATION_SLAVE_SUITE
 //#define	TESTING_RUN_RNG_MBEDTLS_SUITE
 //#define	TESTING_RUN_DEVICE_MANAGER_SUITE
@@ -73,6 +77,7 @@
 //#define	TESTING_RUN_CFM_MANAGER_SUITE
 //#define	TESTING_RUN_PFM_OBSERVER_PENDING_RESET_SUITE
 //#define	TESTING_RUN_PFM_OBSERVER_PCR_SUITE
+//#define	TESTING_RUN_PFM_OBSERVER_INDEX_SUITE
 //#define	TESTING_RUN_CFM_OBSERVER_PCR_SUITE
 //#define	TESTING_RUN_SIGNATURE_VERIFICATION_RSA_SUITE
 //#define	TESTING_RUN_SIGNATURE_VERIFICATION_ECC_SUITE
@@ -87,9 +92,11 @@
 //#define	TESTING_RUN_SPI_FILTER_SUITE
 //#define	TESTING_RUN_IMAGE_HEADER_SUITE
 //#define	TESTING_RUN_CMD_CHANNEL_SUITE
+//#define	TESTING_RUN_CMD_ASYNC_SUITE
 //#define	TESTING_RUN_FIRMWARE_COMPONENT_SUITE
 //#define	TESTING_RUN_FLASH_UPDATER_SUITE
 //#define	TESTING_RUN_TPM_SUITE
+//#define	TESTING_RUN_TPM_NV_LOG_SUITE
 //#define	TESTING_RUN_AUTHORIZATION_ALLOWED_SUITE
 //#define	TESTING_RUN_AUTHORIZATION_DISALLOWED_SUITE
 //#define	TESTING_RUN_AUTHORIZATION_CHALLENGE_SUITE
@@ -113,10 +120,13 @@ CuSuite* get_hash_mbedtls_suite (void);
 CuSuite* get_hash_suite (void);
 CuSuite* get_rsa_mbedtls_suite (void);
 CuSuite* get_flash_util_suite (void);
+CuSuite* get_flash_compare_suite (void);
 CuSuite* get_app_image_suite (void);
 CuSuite* get_firmware_update_suite (void);
 CuSuite* get_host_fw_util_suite (void);
+CuSuite* get_host_fw_verification_cache_suite (void);
 CuSuite* get_manifest_flash_suite (void);
+CuSuite* get_manifest_arena_suite (void);
 CuSuite* get_pfm_flash_suite (void);
 CuSuite* get_cfm_flash_suite (void);
 CuSuite* get_cerberus_protocol_required_commands_suite (void);
@@ -163,6 +173,7 @@ CuSuite* get_firmware_header_suite (void);
 CuSuite* get_spi_filter_irq_handler_dirty_suite (void);
 CuSuite* get_host_irq_handler_pfm_check_suite (void);
 CuSuite* get_attestation_master_suite (void);
+CuSuite* get_attestation_scheduler_suite (void);
 CuSuite* get_attestation_slave_suite (void);
 CuSuite* get_rng_mbedtls_suite (void);
 CuSuite* get_device_manager_suite (void);
@@ -178,6 +189,7 @@ CuSuite* get_pfm_manager_suite (void);
 CuSuite* get_cfm_manager_suite (void);
 CuSuite* get_pfm_observer_pending_reset_suite (void);
 CuSuite* get_pfm_observer_pcr_suite (void);
+CuSuite* get_pfm_observer_index_suite (void);
 CuSuite* get_cfm_observer_pcr_suite (void);
 CuSuite* get_signature_verification_rsa_suite (void);
 CuSuite* get_signature_verification_ecc_suite (void);
@@ -192,9 +204,11 @@ CuSuite* get_manifest_manager_suite (void);
 CuSuite* get_spi_filter_suite (void);
 CuSuite* get_image_header_suite (void);
 CuSuite* get_cmd_channel_suite (void);
+CuSuite* get_cmd_async_suite (void);
 CuSuite* get_firmware_component_suite (void);
 CuSuite* get_flash_updater_suite (void);
 CuSuite* get_tpm_suite (void);
+CuSuite* get_tpm_nv_log_suite (void);
 CuSuite* get_authorization_allowed_suite (void);
 CuSuite* get_authorization_disallowed_suite (void);
 CuSuite* get_authorization_challenge_suite (void);
@@ -231,6 +245,9 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_FLASH_UTIL_SUITE
 	CuSuiteAddSuite (suite, get_flash_util_suite ());
 #endif
+#ifdef TESTING_RUN_FLASH_COMPARE_SUITE
+	CuSuiteAddSuite (suite, get_flash_compare_suite ());
+#endif
 #ifdef TESTING_RUN_APP_IMAGE_SUITE
 	CuSuiteAddSuite (suite, get_app_image_suite ());
 #endif
@@ -240,9 +257,15 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_HOST_FW_UTIL_SUITE
 	CuSuiteAddSuite (suite, get_host_fw_util_suite ());
 #endif
+#ifdef TESTING_RUN_HOST_FW_VERIFICATION_CACHE_SUITE
+	CuSuiteAddSuite (suite, get_host_fw_verification_cache_suite ());
+#endif
 #ifdef TESTING_RUN_MANIFEST_FLASH_SUITE
 	CuSuiteAddSuite (suite, get_manifest_flash_suite ());
 #endif
+#ifdef TESTING_RUN_MANIFEST_ARENA_SUITE
+	CuSuiteAddSuite (suite, get_manifest_arena_suite ());
+#endif
 #ifdef TESTING_RUN_PFM_FLASH_SUITE
 	CuSuiteAddSuite (suite, get_pfm_flash_suite ());
 #endif
@@ -369,6 +392,9 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_ATTESTATION_MASTER_SUITE
 	CuSuiteAddSuite (suite, get_attestation_master_suite ());
 #endif
+#ifdef TESTING_RUN_ATTESTATION_SCHEDULER_SUITE
+	CuSuiteAddSuite (suite, get_attestation_scheduler_suite ());
+#endif
 #ifdef TESTING_RUN_ATTESTATION_SLAVE_SUITE
 	CuSuiteAddSuite (suite, get_attestation_slave_suite ());
 #endif
@@ -414,6 +440,9 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_PFM_OBSERVER_PCR_SUITE
 	CuSuiteAddSuite (suite, get_pfm_observer_pcr_suite ());
 #endif
+#ifdef TESTING_RUN_PFM_OBSERVER_INDEX_SUITE
+	CuSuiteAddSuite (suite, get_pfm_observer_index_suite ());
+#endif
 #ifdef TESTING_RUN_CFM_OBSERVER_PCR_SUITE
 	CuSuiteAddSuite (suite, get_cfm_observer_pcr_suite ());
 #endif
@@ -456,6 +485,9 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_CMD_CHANNEL_SUITE
 	CuSuiteAddSuite (suite, get_cmd_channel_suite ());
 #endif
+#ifdef TESTING_RUN_CMD_ASYNC_SUITE
+	CuSuiteAddSuite (suite, get_cmd_async_suite ());
+#endif
 #ifdef TESTING_RUN_FIRMWARE_COMPONENT_SUITE
 	CuSuiteAddSuite (suite, get_firmware_component_suite ());
 #endif
@@ -465,6 +497,9 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_TPM_SUITE
 	CuSuiteAddSuite(suite, get_tpm_suite ());
 #endif
+#ifdef TESTING_RUN_TPM_NV_LOG_SUITE
+	CuSuiteAddSuite (suite, get_tpm_nv_log_suite ());
+#endif
 #ifdef TESTING_RUN_AUTHORIZATION_ALLOWED_SUITE
 	CuSuiteAddSuite (suite, get_authorization_allowed_suite ());
 #endif
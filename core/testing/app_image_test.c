@@ -12,6 +12,7 @@
 #include "engines/rsa_testing_engine.h"
 #include "mock/flash_mock.h"
 #include "mock/hash_mock.h"
+#include "mock/rsa_mock.h"
 
 
 static const char *SUITE = "app_image";
@@ -3276,6 +3277,913 @@ static void app_image_test_load_and_verify_with_header_finish_hash_error (CuTest
 }
 
 
+static void app_image_test_load_and_verify_streaming (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len = 0;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20004),
+		MOCK_ARG (load_data), MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA + 4, APP_IMAGE_DATA_LENGTH - 4, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, APP_IMAGE_DATA_LENGTH - 4, app_len);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (APP_IMAGE_DATA + 4, load_data, APP_IMAGE_DATA_LENGTH - 4);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (APP_IMAGE_HASH, hash_out, sizeof (APP_IMAGE_HASH));
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_bad_data (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t bad_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len = 0;
+
+	TEST_START;
+
+	memcpy (bad_data, APP_IMAGE_DATA, sizeof (bad_data));
+	bad_data[15] ^= 0x55;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, bad_data, sizeof (bad_data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20004),
+		MOCK_ARG (load_data), MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+	status |= mock_expect_output (&flash.mock, 1, bad_data + 4, sizeof (bad_data) - 4, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_no_hash_out (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	size_t app_len = 0;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20004),
+		MOCK_ARG (load_data), MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA + 4, APP_IMAGE_DATA_LENGTH - 4, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, NULL, 0, &app_len);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, APP_IMAGE_DATA_LENGTH - 4, app_len);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (APP_IMAGE_DATA + 4, load_data, APP_IMAGE_DATA_LENGTH - 4);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_multiple_chunks (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct rsa_engine_mock rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t image[APP_IMAGE_HEADER_LENGTH + 4 + (FLASH_LOAD_HASH_BLOCK * 2) + 16];
+	uint32_t length = (FLASH_LOAD_HASH_BLOCK * 2) + 16;
+	uint8_t *data = &image[APP_IMAGE_HEADER_LENGTH + 4];
+	uint8_t load_data[(FLASH_LOAD_HASH_BLOCK * 2) + 16];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len = 0;
+	size_t i;
+
+	TEST_START;
+
+	memcpy (image, APP_IMAGE_HEADER_DATA, APP_IMAGE_HEADER_LENGTH);
+	memcpy (&image[APP_IMAGE_HEADER_LENGTH], &length, 4);
+	for (i = 0; i < length; i++) {
+		data[i] = i * 7;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, image, sizeof (image), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_init (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, &length, 4, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + sizeof (image)), MOCK_ARG_NOT_NULL, MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (APP_IMAGE_HEADER_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, image, APP_IMAGE_HEADER_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20004 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG (load_data),
+		MOCK_ARG (FLASH_LOAD_HASH_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, data, length, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20004 + APP_IMAGE_HEADER_LENGTH + FLASH_LOAD_HASH_BLOCK),
+		MOCK_ARG (&load_data[FLASH_LOAD_HASH_BLOCK]), MOCK_ARG (FLASH_LOAD_HASH_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_LOAD_HASH_BLOCK],
+		length - FLASH_LOAD_HASH_BLOCK, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20004 + APP_IMAGE_HEADER_LENGTH + (FLASH_LOAD_HASH_BLOCK * 2)),
+		MOCK_ARG (&load_data[FLASH_LOAD_HASH_BLOCK * 2]), MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_LOAD_HASH_BLOCK * 2], 16, 2);
+
+	status |= mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0, MOCK_ARG (&RSA_PUBLIC_KEY),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN),
+		MOCK_ARG_PTR_CONTAINS (hash_expected, SHA256_HASH_LENGTH), MOCK_ARG (SHA256_HASH_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_with_header_streaming (&flash.base, 0x20000,
+		APP_IMAGE_HEADER_LENGTH, load_data, sizeof (load_data), &hash.base, &rsa.base,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out), &app_len);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, length, app_len);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_validate_and_release (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, load_data, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_out, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void app_image_test_load_and_verify_streaming_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (NULL, 0x20000, load_data, sizeof (load_data),
+		&hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out), &app_len);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, NULL, sizeof (load_data),
+		&hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out), &app_len);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), NULL, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, NULL, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, NULL, hash_out, sizeof (hash_out), &app_len);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_small_hash_buffer (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, APP_IMAGE_HASH_BUFFER_TOO_SMALL, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_image_too_large (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH - 5];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, APP_IMAGE_TOO_LARGE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_read_length_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_read_signature_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_read_image_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (4));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x20004), MOCK_ARG (load_data), MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_start_hash_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash,
+		HASH_ENGINE_START_SHA256_FAILED);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_update_hash_length_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_update_hash_image_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (4));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20004),
+		MOCK_ARG (load_data), MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA + 4, APP_IMAGE_DATA_LENGTH - 4, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG (load_data), MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_streaming_finish_hash_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (4));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20004),
+		MOCK_ARG (load_data), MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA + 4, APP_IMAGE_DATA_LENGTH - 4, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG (load_data),
+		MOCK_ARG (APP_IMAGE_DATA_LENGTH - 4));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
+		MOCK_ARG (hash_out), MOCK_ARG (sizeof (hash_out)));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_streaming (&flash.base, 0x20000, load_data,
+		sizeof (load_data), &hash.base, &rsa.base, &RSA_PUBLIC_KEY, hash_out, sizeof (hash_out),
+		&app_len);
+	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_with_header_streaming (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_HEADER_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len = 0;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA + APP_IMAGE_HEADER_LENGTH,
+		sizeof (APP_IMAGE_HEADER_DATA) - APP_IMAGE_HEADER_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (APP_IMAGE_HEADER_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA,
+		sizeof (APP_IMAGE_HEADER_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20004 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG (load_data),
+		MOCK_ARG (APP_IMAGE_HEADER_DATA_LENGTH - 4 - APP_IMAGE_HEADER_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1,
+		APP_IMAGE_HEADER_DATA + 4 + APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_DATA_LENGTH - 4 - APP_IMAGE_HEADER_LENGTH, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_with_header_streaming (&flash.base, 0x20000,
+		APP_IMAGE_HEADER_LENGTH, load_data, sizeof (load_data), &hash.base, &rsa.base,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out), &app_len);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, APP_IMAGE_HEADER_DATA_LENGTH - 4 - APP_IMAGE_HEADER_LENGTH, app_len);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (APP_IMAGE_HEADER_DATA + 4 + APP_IMAGE_HEADER_LENGTH,
+		load_data, APP_IMAGE_HEADER_DATA_LENGTH - 4 - APP_IMAGE_HEADER_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (APP_IMAGE_HEADER_HASH, hash_out,
+		sizeof (APP_IMAGE_HEADER_HASH));
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_with_header_streaming_read_header_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_HEADER_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len = 0;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA + APP_IMAGE_HEADER_LENGTH,
+		sizeof (APP_IMAGE_HEADER_DATA) - APP_IMAGE_HEADER_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (APP_IMAGE_HEADER_LENGTH));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_with_header_streaming (&flash.base, 0x20000,
+		APP_IMAGE_HEADER_LENGTH, load_data, sizeof (load_data), &hash.base, &rsa.base,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out), &app_len);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_load_and_verify_with_header_streaming_hash_header_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	uint8_t load_data[APP_IMAGE_HEADER_DATA_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	size_t app_len = 0;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA + APP_IMAGE_HEADER_LENGTH,
+		sizeof (APP_IMAGE_HEADER_DATA) - APP_IMAGE_HEADER_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_DATA_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (APP_IMAGE_HEADER_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA,
+		sizeof (APP_IMAGE_HEADER_DATA), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_PTR_CONTAINS (APP_IMAGE_HEADER_DATA, APP_IMAGE_HEADER_LENGTH),
+		MOCK_ARG (APP_IMAGE_HEADER_LENGTH));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_with_header_streaming (&flash.base, 0x20000,
+		APP_IMAGE_HEADER_LENGTH, load_data, sizeof (load_data), &hash.base, &rsa.base,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out), &app_len);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
 CuSuite* get_app_image_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -3356,6 +4264,23 @@ CuSuite* get_app_image_suite ()
 	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_with_header_hash_length_error);
 	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_with_header_hash_image_error);
 	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_with_header_finish_hash_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_bad_data);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_no_hash_out);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_multiple_chunks);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_null);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_small_hash_buffer);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_image_too_large);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_read_length_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_read_signature_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_read_image_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_start_hash_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_update_hash_length_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_update_hash_image_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_streaming_finish_hash_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_with_header_streaming);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_with_header_streaming_read_header_error);
+	SUITE_ADD_TEST (suite, app_image_test_load_and_verify_with_header_streaming_hash_header_error);
 
 	return suite;
 }
@@ -3083,6 +3083,872 @@ static void attestation_master_test_process_challenge_response_null (CuTest *tes
 		&keystore, &manager, &riot);
 }
 
+static void attestation_master_test_compare_digests_cached (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+
+	TEST_START;
+
+	digests.num_cert = 2;
+	digests.digest_len = SHA256_HASH_LENGTH;
+	digests.digest = platform_calloc (2, SHA256_HASH_LENGTH);
+
+	digests.digest[32] = 0xAA;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_update_cert (attestation.device_manager, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_cert (attestation.device_manager, 0, 1, RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, digests.digest, SHA256_HASH_LENGTH, -1);
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, &digests.digest[32], SHA256_HASH_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 0, status);
+
+	digests.digest[32] = 0xBB;
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 2, status);
+
+	platform_free (digests.digest);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_compare_digests_cert_updated (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t updated[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	digests.num_cert = 2;
+	digests.digest_len = SHA256_HASH_LENGTH;
+	digests.digest = platform_calloc (2, SHA256_HASH_LENGTH);
+
+	memset (updated, 0x55, sizeof (updated));
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_update_cert (attestation.device_manager, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_cert (attestation.device_manager, 0, 1, RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, digests.digest, SHA256_HASH_LENGTH, -1);
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, &digests.digest[32], SHA256_HASH_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, digests.digest, SHA256_HASH_LENGTH, -1);
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, updated, SHA256_HASH_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 2, status);
+
+	platform_free (digests.digest);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_compare_digests_hash_fail_not_cached (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+
+	TEST_START;
+
+	digests.num_cert = 1;
+	digests.digest_len = SHA256_HASH_LENGTH;
+	digests.digest = platform_calloc (1, SHA256_HASH_LENGTH);
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_update_cert (attestation.device_manager, 0, 0, RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, -1,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, digests.digest, SHA256_HASH_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, -1, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 0, status);
+
+	platform_free (digests.digest);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_cached_key_ecc (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[137] = {0};
+	uint16_t buf_len = 137;
+	uint8_t *dev_id_der;
+	uint8_t *ca_der;
+	uint8_t *int_der;
+
+	buf[1] = 1;
+
+	digests.num_cert = 3;
+
+	TEST_START;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	add_int_ca_to_riot_key_manager (test, &riot, &keystore, &x509, &dev_id_der, &ca_der, &int_der);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 2);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (2),
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER,
+		X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 3);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (3));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 0);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 2, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_state (&manager, 0);
+	CuAssertIntEquals (test, DEVICE_MANAGER_AUTHENTICATED, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_cached_key_rsa (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[329] = {0};
+	uint16_t buf_len = 329;
+	uint8_t *dev_id_der;
+	uint8_t *ca_der;
+	uint8_t *int_der;
+
+	buf[1] = 1;
+
+	digests.num_cert = 3;
+
+	TEST_START;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_RSA_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	add_int_ca_to_riot_key_manager (test, &riot, &keystore, &x509, &dev_id_der, &ca_der, &int_der);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 2);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (2),
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER,
+		X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 3);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (3));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rsa.mock, rsa.base.init_public_key, &rsa, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG_ANY, MOCK_ARG_ANY);
+	status |= mock_expect_save_arg (&rsa.mock, 0, 0);
+	status |= mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (&buf[72], 257), MOCK_ARG (257), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (&buf[72], 257), MOCK_ARG (257), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 2, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_state (&manager, 0);
+	CuAssertIntEquals (test, DEVICE_MANAGER_AUTHENTICATED, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_chain_updated_ecc (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[137] = {0};
+	uint16_t buf_len = 137;
+	uint8_t *dev_id_der;
+	uint8_t *ca_der;
+	uint8_t *int_der;
+
+	buf[1] = 1;
+
+	digests.num_cert = 3;
+
+	TEST_START;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	add_int_ca_to_riot_key_manager (test, &riot, &keystore, &x509, &dev_id_der, &ca_der, &int_der);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 2);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (2),
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER,
+		X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 3);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (3));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 4);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (4),
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4), MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER,
+		X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 5);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (5),
+		MOCK_ARG_SAVED_ARG (4));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (5),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (5));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 0);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 2, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 2, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_state (&manager, 0);
+	CuAssertIntEquals (test, DEVICE_MANAGER_AUTHENTICATED, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_riot_ca_updated_ecc (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[137] = {0};
+	uint16_t buf_len = 137;
+	uint8_t *dev_id_der;
+	uint8_t *ca_der;
+	uint8_t *int_der;
+
+	buf[1] = 1;
+
+	digests.num_cert = 3;
+
+	TEST_START;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 2);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (2),
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 3);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (3));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 0);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 2, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	add_int_ca_to_riot_key_manager (test, &riot, &keystore, &x509, &dev_id_der, &ca_der, &int_der);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 4);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (4),
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4), MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER,
+		X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.add_intermediate_ca, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4), MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT,
+		RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 5);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (5),
+		MOCK_ARG_SAVED_ARG (4));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (5),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (5));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (4));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_state (&manager, 0);
+	CuAssertIntEquals (test, DEVICE_MANAGER_AUTHENTICATED, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_issue_challenge_device_not_in_cache (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+
+	TEST_START;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = device_manager_resize_entries_table (&manager, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 1, DEVICE_MANAGER_UPSTREAM, 0xCC, 0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xCC, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, ATTESTATION_INVALID_DEVICE_NUM, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_compare_digests_device_not_in_cache (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+
+	TEST_START;
+
+	digests.num_cert = 0;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = device_manager_resize_entries_table (&manager, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 1, DEVICE_MANAGER_UPSTREAM, 0xCC, 0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xCC, &digests);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_DEVICE_NUM, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_device_not_in_cache (
+	CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[137] = {0};
+	uint16_t buf_len = 137;
+
+	buf[1] = 1;
+
+	TEST_START;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = device_manager_resize_entries_table (&manager, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 1, DEVICE_MANAGER_UPSTREAM, 0xCC, 0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xCC);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_DEVICE_NUM, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
 CuSuite* get_attestation_master_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -3147,6 +4013,18 @@ CuSuite* get_attestation_master_suite ()
 	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_ecc_verify_failure);
 	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_rsa_verify_failure);
 	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_null);
+	SUITE_ADD_TEST (suite, attestation_master_test_compare_digests_cached);
+	SUITE_ADD_TEST (suite, attestation_master_test_compare_digests_cert_updated);
+	SUITE_ADD_TEST (suite, attestation_master_test_compare_digests_hash_fail_not_cached);
+	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_cached_key_ecc);
+	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_cached_key_rsa);
+	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_chain_updated_ecc);
+	SUITE_ADD_TEST (suite,
+		attestation_master_test_process_challenge_response_riot_ca_updated_ecc);
+	SUITE_ADD_TEST (suite, attestation_master_test_issue_challenge_device_not_in_cache);
+	SUITE_ADD_TEST (suite, attestation_master_test_compare_digests_device_not_in_cache);
+	SUITE_ADD_TEST (suite,
+		attestation_master_test_process_challenge_response_device_not_in_cache);
 
 	return suite;
 }
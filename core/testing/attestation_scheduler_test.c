@@ -0,0 +1,778 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "crypto/hash.h"
+#include "attestation/attestation.h"
+#include "attestation/attestation_scheduler.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "cmd_interface/device_manager.h"
+
+
+static const char *SUITE = "attestation_scheduler";
+
+
+/**
+ * Initialize a device manager for attestation scheduler testing.  The device table contains the
+ * local device, three downstream devices, and one upstream device.  All remote devices are
+ * available for communication.
+ *
+ * @param test The test framework.
+ * @param manager The device manager to initialize.
+ */
+static void attestation_scheduler_testing_init_device_manager (CuTest *test,
+	struct device_manager *manager)
+{
+	int status;
+	int i;
+
+	status = device_manager_init (manager, 5, DEVICE_MANAGER_PA_ROT_MODE,
+		DEVICE_MANAGER_MASTER_AND_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (manager, 0, DEVICE_MANAGER_SELF, 0x0B, 0x41);
+	status |= device_manager_update_device_entry (manager, 1, DEVICE_MANAGER_DOWNSTREAM, 0x10,
+		0x20);
+	status |= device_manager_update_device_entry (manager, 2, DEVICE_MANAGER_DOWNSTREAM, 0x11,
+		0x21);
+	status |= device_manager_update_device_entry (manager, 3, DEVICE_MANAGER_DOWNSTREAM, 0x12,
+		0x22);
+	status |= device_manager_update_device_entry (manager, 4, DEVICE_MANAGER_UPSTREAM, 0x13,
+		0x23);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 1; i < 5; i++) {
+		status = device_manager_update_device_state (manager, i, DEVICE_MANAGER_AVAILABLE);
+		CuAssertIntEquals (test, 0, status);
+	}
+}
+
+/**
+ * Set the response timeouts reported by a device.
+ *
+ * @param test The test framework.
+ * @param manager The device manager to update.
+ * @param device_num The device to update.
+ * @param max_timeout Response timeout, in 10ms increments.
+ * @param max_sig Cryptographic response timeout, in 100ms increments.
+ */
+static void attestation_scheduler_testing_set_timeouts (CuTest *test,
+	struct device_manager *manager, int device_num, uint8_t max_timeout, uint8_t max_sig)
+{
+	struct device_manager_full_capabilities capabilities;
+	int status;
+
+	status = device_manager_get_device_capabilities (manager, device_num, &capabilities);
+	CuAssertIntEquals (test, 0, status);
+
+	capabilities.max_timeout = max_timeout;
+	capabilities.max_sig = max_sig;
+
+	status = device_manager_update_device_capabilities (manager, device_num, &capabilities);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void attestation_scheduler_test_init (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 5, scheduler.num_devices);
+
+	status = attestation_scheduler_get_device_state (&scheduler, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IDLE, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_init_null (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (NULL, &manager, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_init (&scheduler, NULL, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 0);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	attestation_scheduler_release (NULL);
+}
+
+static void attestation_scheduler_test_set_device_bus_null (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_set_device_bus (NULL, 1, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_set_device_bus (&scheduler, 5, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_DEVICE, status);
+
+	status = attestation_scheduler_set_device_bus (&scheduler, -1, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_DEVICE, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_start_sweep (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_results results;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IDLE,
+		attestation_scheduler_get_device_state (&scheduler, 0));
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_QUEUED,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_QUEUED,
+		attestation_scheduler_get_device_state (&scheduler, 2));
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_QUEUED,
+		attestation_scheduler_get_device_state (&scheduler, 3));
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IDLE,
+		attestation_scheduler_get_device_state (&scheduler, 4));
+
+	status = attestation_scheduler_get_results (&scheduler, &results);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, results.scheduled);
+	CuAssertIntEquals (test, 0, results.passed);
+	CuAssertIntEquals (test, 0, results.failed);
+	CuAssertIntEquals (test, false, results.complete);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_start_sweep_device_not_ready (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = device_manager_update_device_state (&manager, 2, DEVICE_MANAGER_NOT_READY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 2, status);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_QUEUED,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IDLE,
+		attestation_scheduler_get_device_state (&scheduler, 2));
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_QUEUED,
+		attestation_scheduler_get_device_state (&scheduler, 3));
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_start_sweep_no_devices (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_results results;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 2, DEVICE_MANAGER_PA_ROT_MODE,
+		DEVICE_MANAGER_MASTER_AND_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NO_REQUEST, status);
+
+	status = attestation_scheduler_get_results (&scheduler, &results);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, results.scheduled);
+	CuAssertIntEquals (test, true, results.complete);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_start_sweep_active (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_SWEEP_ACTIVE, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_start_sweep_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = attestation_scheduler_start_sweep (NULL);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+}
+
+static void attestation_scheduler_test_get_next_request (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, request.device_num);
+	CuAssertIntEquals (test, 0x10, request.eid);
+	CuAssertIntEquals (test, 0x20, request.smbus_addr);
+	CuAssertIntEquals (test, 0, request.bus);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_DIGEST, request.command);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IN_PROGRESS,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+
+	/* All devices are on the same bus, so only one can be attested at a time. */
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NO_REQUEST, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_get_next_request_multiple_buses (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_set_device_bus (&scheduler, 3, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, request.device_num);
+	CuAssertIntEquals (test, 0, request.bus);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, request.device_num);
+	CuAssertIntEquals (test, 0x12, request.eid);
+	CuAssertIntEquals (test, 0x22, request.smbus_addr);
+	CuAssertIntEquals (test, 1, request.bus);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NO_REQUEST, status);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_QUEUED,
+		attestation_scheduler_get_device_state (&scheduler, 2));
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_get_next_request_multiple_per_bus (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, request.device_num);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, request.device_num);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NO_REQUEST, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_get_next_request_after_complete (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, request.device_num);
+
+	status = attestation_scheduler_update (&scheduler, 1, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, request.device_num);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_get_next_request_timeout (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	struct attestation_scheduler_results results;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+	attestation_scheduler_testing_set_timeouts (test, &manager, 1, 1, 10);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, request.device_num);
+
+	platform_msleep (20);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, request.device_num);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_FAILED,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+	CuAssertIntEquals (test, DEVICE_MANAGER_AVAILABLE,
+		device_manager_get_device_state (&manager, 1));
+
+	status = attestation_scheduler_get_results (&scheduler, &results);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, results.failed);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_get_next_request_null (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_next_request (NULL, &request);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, NULL);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_update_next_command (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+	attestation_scheduler_testing_set_timeouts (test, &manager, 1, 1, 10);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_update (&scheduler, 1, 0,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The challenge is allowed the longer cryptographic timeout. */
+	platform_msleep (20);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NO_REQUEST, status);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IN_PROGRESS,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_update_failure (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_state (&manager, 1, DEVICE_MANAGER_AUTHENTICATED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_update (&scheduler, 1, ATTESTATION_INVALID_CERT_CHAIN,
+		ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_FAILED,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+	CuAssertIntEquals (test, DEVICE_MANAGER_AVAILABLE,
+		device_manager_get_device_state (&manager, 1));
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_update_not_in_progress (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_update (&scheduler, 1, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IDLE,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_update (&scheduler, 1, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_QUEUED,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_update_null (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_update (NULL, 1, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_update (&scheduler, 5, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_DEVICE, status);
+
+	status = attestation_scheduler_update (&scheduler, -1, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_DEVICE, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_full_sweep (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	struct attestation_scheduler_results results;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_set_device_bus (&scheduler, 2, 1);
+	status |= attestation_scheduler_set_device_bus (&scheduler, 3, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	status |= attestation_scheduler_get_next_request (&scheduler, &request);
+	status |= attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_update (&scheduler, 1, 0, CERBERUS_PROTOCOL_GET_CERTIFICATE);
+	status |= attestation_scheduler_update (&scheduler, 2, 0,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	status |= attestation_scheduler_update (&scheduler, 3, 0,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	status |= attestation_scheduler_update (&scheduler, 1, 0, CERBERUS_PROTOCOL_GET_DIGEST);
+	status |= attestation_scheduler_update (&scheduler, 2, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	status |= attestation_scheduler_update (&scheduler, 3, ATTESTATION_INVALID_CERT_CHAIN,
+		ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_results (&scheduler, &results);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, results.scheduled);
+	CuAssertIntEquals (test, 1, results.passed);
+	CuAssertIntEquals (test, 1, results.failed);
+	CuAssertIntEquals (test, false, results.complete);
+
+	status = attestation_scheduler_update (&scheduler, 1, 0,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	status |= attestation_scheduler_update (&scheduler, 1, 0, ATTESTATION_SCHEDULER_NO_COMMAND);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_results (&scheduler, &results);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, results.scheduled);
+	CuAssertIntEquals (test, 2, results.passed);
+	CuAssertIntEquals (test, 1, results.failed);
+	CuAssertIntEquals (test, true, results.complete);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NO_REQUEST, status);
+
+	/* A new sweep can be started once the previous one has completed. */
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 3, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_get_device_state_null (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_device_state (NULL, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_get_device_state (&scheduler, 5);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_DEVICE, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+static void attestation_scheduler_test_get_results_null (CuTest *test)
+{
+	struct device_manager manager;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_results results;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_device_manager (test, &manager);
+
+	status = attestation_scheduler_init (&scheduler, &manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_results (NULL, &results);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_get_results (&scheduler, NULL);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	attestation_scheduler_release (&scheduler);
+	device_manager_release (&manager);
+}
+
+
+CuSuite* get_attestation_scheduler_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_init);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_init_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_release_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_set_device_bus_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_start_sweep);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_start_sweep_device_not_ready);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_start_sweep_no_devices);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_start_sweep_active);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_start_sweep_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_next_request);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_next_request_multiple_buses);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_next_request_multiple_per_bus);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_next_request_after_complete);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_next_request_timeout);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_next_request_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_update_next_command);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_update_failure);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_update_not_in_progress);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_update_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_full_sweep);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_device_state_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_results_null);
+
+	return suite;
+}
@@ -2006,6 +2006,95 @@ static void cfm_flash_test_get_platform_id_null (CuTest *test)
 }
 
 
+static void cfm_flash_test_get_supported_component_ids_arena (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct cfm_flash cfm;
+	struct cfm_component_ids ids;
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cfm_flash_init (&cfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_flash_set_arena (&cfm.base_flash, &arena);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, CFM_DATA, CFM_DATA_LEN,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, CFM_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0,
+		CFM_DATA + CFM_COMPONENTS_HDR_OFFSET, CFM_DATA_LEN - CFM_COMPONENTS_HDR_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + CFM_COMPONENTS_HDR_OFFSET, 0, -1,
+			CFM_COMPONENTS_HDR_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0,
+		CFM_DATA + CFM_2ND_COMPONENT_HDR_OFFSET, CFM_DATA_LEN - CFM_2ND_COMPONENT_HDR_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + CFM_2ND_COMPONENT_HDR_OFFSET, 0, -1,
+			CFM_COMPONENT_HDR_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0,
+		CFM_DATA + CFM_1ST_COMPONENT_HDR_OFFSET, CFM_DATA_LEN - CFM_1ST_COMPONENT_HDR_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + CFM_1ST_COMPONENT_HDR_OFFSET, 0, -1,
+			CFM_COMPONENT_HDR_SIZE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cfm.base.get_supported_component_ids (&cfm.base, &ids);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, ids.count);
+	CuAssertPtrNotNull (test, ids.ids);
+	CuAssertIntEquals (test, 2, ids.ids[0]);
+	CuAssertIntEquals (test, 1, ids.ids[1]);
+
+	CuAssertTrue (test, ((uint8_t*) ids.ids > arena.buffer));
+	CuAssertTrue (test, ((uint8_t*) ids.ids < &arena.buffer[arena.size]));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.results);
+	CuAssertIntEquals (test, 16, stats.used);
+
+	cfm.base.free_component_ids (&cfm.base, &ids);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.results);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 16, stats.peak);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	cfm_flash_release (&cfm);
+	spi_flash_release (&flash);
+	manifest_arena_release (&arena);
+}
+
 CuSuite* get_cfm_flash_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -2051,6 +2140,7 @@ CuSuite* get_cfm_flash_suite ()
 	SUITE_ADD_TEST (suite, cfm_flash_test_get_component_bad_magic_number);
 	SUITE_ADD_TEST (suite, cfm_flash_test_get_platform_id);
 	SUITE_ADD_TEST (suite, cfm_flash_test_get_platform_id_null);
+	SUITE_ADD_TEST (suite, cfm_flash_test_get_supported_component_ids_arena);
 
 	return suite;
 }
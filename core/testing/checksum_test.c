@@ -83,6 +83,90 @@ static void checksum_test_crc8_zero (CuTest *test)
 	CuAssertIntEquals (test, 0, crc);
 }
 
+static void checksum_test_init_smbus_crc8 (CuTest *test)
+{
+	uint8_t crc;
+	uint8_t addr = 0x2A;
+
+	TEST_START;
+
+	crc = checksum_init_smbus_crc8 (0x2A);
+	CuAssertIntEquals (test, checksum_crc8 (0, &addr, 1), crc);
+
+	crc = checksum_init_smbus_crc8 (0);
+	CuAssertIntEquals (test, 0, crc);
+}
+
+static void checksum_test_update_crc8 (CuTest *test)
+{
+	uint8_t crc;
+	uint8_t buf[16] = {
+		0x0F,0x0F,0xAA,0x01,0x0B,0x0A,0x80,0x7E,0x00,0x00,0x01,0xAA,0xBB,0xCC,0xDD,0xEE
+	};
+
+	TEST_START;
+
+	crc = checksum_init_smbus_crc8 (0x2A);
+	crc = checksum_update_crc8 (crc, buf, sizeof (buf));
+	CuAssertIntEquals (test, 0xF1, crc);
+}
+
+static void checksum_test_update_crc8_incremental (CuTest *test)
+{
+	uint8_t crc;
+	uint8_t buf[16] = {
+		0x0F,0x0F,0xAA,0x01,0x0B,0x0A,0x80,0x7E,0x00,0x00,0x01,0xAA,0xBB,0xCC,0xDD,0xEE
+	};
+
+	TEST_START;
+
+	crc = checksum_init_smbus_crc8 (0x2A);
+	crc = checksum_update_crc8 (crc, buf, 3);
+	crc = checksum_update_crc8 (crc, &buf[3], 0);
+	crc = checksum_update_crc8 (crc, &buf[3], 8);
+	crc = checksum_update_crc8 (crc, &buf[11], 5);
+	CuAssertIntEquals (test, 0xF1, crc);
+}
+
+static void checksum_test_update_crc8_null (CuTest *test)
+{
+	uint8_t crc;
+
+	TEST_START;
+
+	crc = checksum_update_crc8 (0x5A, NULL, 16);
+	CuAssertIntEquals (test, 0x5A, crc);
+}
+
+static void checksum_test_crc8_all_byte_values (CuTest *test)
+{
+	uint8_t buf[256];
+	uint8_t expected;
+	int i;
+	int j;
+
+	TEST_START;
+
+	for (i = 0; i < 256; i++) {
+		buf[i] = i;
+	}
+
+	/* Compare against a bit-wise CRC calculation. */
+	expected = 0x2A;
+	for (j = 0; j < 8; j++) {
+		expected = (expected & 0x80) ? (uint8_t) ((expected << 1) ^ 0x07) : (expected << 1);
+	}
+
+	for (i = 0; i < 255; i++) {
+		expected ^= buf[i];
+		for (j = 0; j < 8; j++) {
+			expected = (expected & 0x80) ? (uint8_t) ((expected << 1) ^ 0x07) : (expected << 1);
+		}
+	}
+
+	CuAssertIntEquals (test, expected, checksum_crc8 (0x2A, buf, 255));
+}
+
 CuSuite* get_checksum_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -90,6 +174,11 @@ CuSuite* get_checksum_suite ()
 	SUITE_ADD_TEST (suite, checksum_test_crc8);
 	SUITE_ADD_TEST (suite, checksum_test_crc8_null);
 	SUITE_ADD_TEST (suite, checksum_test_crc8_zero);
+	SUITE_ADD_TEST (suite, checksum_test_init_smbus_crc8);
+	SUITE_ADD_TEST (suite, checksum_test_update_crc8);
+	SUITE_ADD_TEST (suite, checksum_test_update_crc8_incremental);
+	SUITE_ADD_TEST (suite, checksum_test_update_crc8_null);
+	SUITE_ADD_TEST (suite, checksum_test_crc8_all_byte_values);
 
 	return suite;
 }
@@ -0,0 +1,406 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "testing.h"
+#include "cmd_interface/cmd_async.h"
+#include "mctp/mctp_protocol.h"
+#include "mock/cmd_interface_mock.h"
+
+
+static const char *SUITE = "cmd_async";
+
+
+/**
+ * Number of times the testing request handler has been called.
+ */
+static int cmd_async_testing_execute_count;
+
+/**
+ * Request handler for testing deferred execution.  The response is the request data with each byte
+ * incremented.
+ *
+ * @param intf The command interface that submitted the request.
+ * @param request The request to process.
+ *
+ * @return 0 always.
+ */
+static int cmd_async_testing_execute (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	size_t i;
+
+	cmd_async_testing_execute_count++;
+
+	for (i = 0; i < request->length; i++) {
+		request->data[i]++;
+	}
+
+	return 0;
+}
+
+/**
+ * Request handler for testing deferred execution that fails.
+ *
+ * @param intf The command interface that submitted the request.
+ * @param request The request to process.
+ *
+ * @return CMD_HANDLER_PROCESS_FAILED always.
+ */
+static int cmd_async_testing_execute_error (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	request->length = 0;
+	return CMD_HANDLER_PROCESS_FAILED;
+}
+
+/**
+ * Initialize a request for testing.
+ *
+ * @param request The request to initialize.
+ */
+static void cmd_async_testing_init_request (struct cmd_interface_request *request)
+{
+	memset (request, 0, sizeof (struct cmd_interface_request));
+
+	request->data[0] = 0x10;
+	request->data[1] = 0x20;
+	request->data[2] = 0x30;
+	request->length = 3;
+	request->max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request->source_eid = MCTP_PROTOCOL_BMC_EID;
+	request->target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	request->channel_id = 1;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_async_test_init (CuTest *test)
+{
+	struct cmd_async async;
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, cmd_async_is_pending (&async));
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_init_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_init (NULL);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+}
+
+static void cmd_async_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_async_release (NULL);
+}
+
+static void cmd_async_test_submit (CuTest *test)
+{
+	struct cmd_async async;
+	struct cmd_interface_mock intf;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_testing_init_request (&request);
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, true, cmd_async_is_pending (&async));
+
+	/* The request buffer can be reused immediately. */
+	memset (&request, 0, sizeof (request));
+	CuAssertIntEquals (test, 0x10, async.request.data[0]);
+
+	status = cmd_interface_mock_validate_and_release (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_submit_null (CuTest *test)
+{
+	struct cmd_async async;
+	struct cmd_interface_mock intf;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_testing_init_request (&request);
+
+	status = cmd_async_submit (NULL, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+
+	status = cmd_async_submit (&async, NULL, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+
+	status = cmd_async_submit (&async, &intf.base, NULL, &request);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, NULL);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, false, cmd_async_is_pending (&async));
+
+	status = cmd_interface_mock_validate_and_release (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_submit_busy (CuTest *test)
+{
+	struct cmd_async async;
+	struct cmd_interface_mock intf;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_testing_init_request (&request);
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, CMD_ASYNC_BUSY, status);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The response has not been retrieved yet. */
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, CMD_ASYNC_BUSY, status);
+
+	status = cmd_interface_mock_validate_and_release (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_execute (CuTest *test)
+{
+	struct cmd_async async;
+	struct cmd_interface_mock intf;
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_testing_init_request (&request);
+	cmd_async_testing_execute_count = 0;
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_get_response (&async, &response);
+	CuAssertIntEquals (test, CMD_ASYNC_NO_RESPONSE, status);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, cmd_async_testing_execute_count);
+
+	CuAssertIntEquals (test, false, cmd_async_is_pending (&async));
+
+	memset (&response, 0, sizeof (response));
+	status = cmd_async_get_response (&async, &response);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, response.length);
+	CuAssertIntEquals (test, 0x11, response.data[0]);
+	CuAssertIntEquals (test, 0x21, response.data[1]);
+	CuAssertIntEquals (test, 0x31, response.data[2]);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, response.source_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, response.target_eid);
+	CuAssertIntEquals (test, 1, response.channel_id);
+
+	/* The response can only be retrieved once. */
+	status = cmd_async_get_response (&async, &response);
+	CuAssertIntEquals (test, CMD_ASYNC_NO_RESPONSE, status);
+
+	/* A new request can be deferred. */
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_execute_request_error (CuTest *test)
+{
+	struct cmd_async async;
+	struct cmd_interface_mock intf;
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_testing_init_request (&request);
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute_error, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_get_response (&async, &response);
+	CuAssertIntEquals (test, CMD_HANDLER_PROCESS_FAILED, status);
+	CuAssertIntEquals (test, 0, response.length);
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_execute_no_request (CuTest *test)
+{
+	struct cmd_async async;
+	struct cmd_interface_mock intf;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, CMD_ASYNC_NO_REQUEST, status);
+
+	cmd_async_testing_init_request (&request);
+	cmd_async_testing_execute_count = 0;
+
+	status = cmd_async_submit (&async, &intf.base, cmd_async_testing_execute, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, CMD_ASYNC_NO_REQUEST, status);
+	CuAssertIntEquals (test, 1, cmd_async_testing_execute_count);
+
+	status = cmd_interface_mock_validate_and_release (&intf);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_execute_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_execute (NULL);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+}
+
+static void cmd_async_test_get_response_null (CuTest *test)
+{
+	struct cmd_async async;
+	struct cmd_interface_request response;
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_get_response (NULL, &response);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+
+	status = cmd_async_get_response (&async, NULL);
+	CuAssertIntEquals (test, CMD_ASYNC_INVALID_ARGUMENT, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_async_test_is_pending_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, false, cmd_async_is_pending (NULL));
+}
+
+
+CuSuite* get_cmd_async_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, cmd_async_test_init);
+	SUITE_ADD_TEST (suite, cmd_async_test_init_null);
+	SUITE_ADD_TEST (suite, cmd_async_test_release_null);
+	SUITE_ADD_TEST (suite, cmd_async_test_submit);
+	SUITE_ADD_TEST (suite, cmd_async_test_submit_null);
+	SUITE_ADD_TEST (suite, cmd_async_test_submit_busy);
+	SUITE_ADD_TEST (suite, cmd_async_test_execute);
+	SUITE_ADD_TEST (suite, cmd_async_test_execute_request_error);
+	SUITE_ADD_TEST (suite, cmd_async_test_execute_no_request);
+	SUITE_ADD_TEST (suite, cmd_async_test_execute_null);
+	SUITE_ADD_TEST (suite, cmd_async_test_get_response_null);
+	SUITE_ADD_TEST (suite, cmd_async_test_is_pending_null);
+
+	return suite;
+}
@@ -162,6 +162,7 @@ static void cmd_channel_test_receive_and_process_single_packet_response (CuTest
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -327,6 +328,7 @@ static void cmd_channel_test_receive_and_process_multi_packet_response (CuTest *
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -501,6 +503,7 @@ static void cmd_channel_test_receive_and_process_multi_packet_message (CuTest *t
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -615,6 +618,7 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout (CuT
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -749,6 +753,7 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout_not_
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -888,6 +893,7 @@ static void cmd_channel_test_receive_and_process_set_receive_timeout (CuTest *te
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1059,6 +1065,7 @@ static void cmd_channel_test_receive_and_process_null (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1241,6 +1248,7 @@ static void cmd_channel_test_receive_and_process_send_failure (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1595,6 +1603,7 @@ static void cmd_channel_test_receive_and_process_receive_failure (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1785,6 +1794,7 @@ static void cmd_channel_test_receive_and_process_receive_timeout (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -2303,6 +2313,447 @@ static void cmd_channel_test_receive_and_process_multiple_overflow_packet (CuTes
 }
 
 
+static void cmd_channel_test_receive_and_process_in_place_single_packet_response (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_interface_mock cmd;
+	struct device_manager device_mgr;
+	struct mctp_interface mctp;
+	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet;
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx_packet.data;
+	int status;
+
+	TEST_START;
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx_packet.data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = 0x0B;
+	rx_packet.data[12] = 0x0A;
+	rx_packet.data[13] = 0x01;
+	rx_packet.data[14] = 0x02;
+	rx_packet.data[15] = 0x03;
+	rx_packet.data[16] = 0x04;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.state = CMD_VALID_PACKET;
+	rx_packet.dest_addr = 0x5D;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_protocol_transport_header*) tx_packet.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet.data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet.data[8] = 0x00;
+	tx_packet.data[9] = 0x00;
+	tx_packet.data[10] = 0x00;
+	tx_packet.data[11] = 0x0B;
+	tx_packet.data[12] = 0x0A;
+	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x55;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&mctp, &cmd.base, &device_mgr, MCTP_PROTOCOL_PA_ROT_CTRL_EID,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	request.length = 10;
+	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.source_eid = 0x0A;
+	request.target_eid = 0x0B;
+	request.new_request = false;
+	request.crypto_timeout = false;
+	request.can_defer = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+
+	response.data[0] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	response.data[4] = 0x0B;
+	response.data[5] = 0x0A;
+	response.length = 6;
+	response.source_eid = 0x0A;
+	response.target_eid = 0x0B;
+	response.new_request = false;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&channel.mock, channel.base.receive_packet, &channel, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
+	status |= mock_expect_output (&channel.mock, 0, &rx_packet, sizeof (rx_packet), -1);
+
+	status |= mock_expect (&cmd.mock, cmd.base.process_request, &cmd, 0,
+		MOCK_ARG_VALIDATOR (cmd_interface_mock_validate_request, &request, sizeof (request)));
+	status |= mock_expect_output (&cmd.mock, 0, &response, sizeof (response), -1);
+
+	status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process_in_place (&channel.base, &mctp, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&device_mgr);
+
+	mctp_interface_deinit (&mctp);
+}
+static void cmd_channel_test_receive_and_process_in_place_multi_packet_response (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_interface_mock cmd;
+	struct device_manager device_mgr;
+	struct mctp_interface mctp;
+	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet[2];
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx_packet.data;
+	const int msg_size = 300;
+	uint8_t payload[msg_size];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx_packet.data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = 0x0B;
+	rx_packet.data[12] = 0x0A;
+	rx_packet.data[13] = 0x01;
+	rx_packet.data[14] = 0x02;
+	rx_packet.data[15] = 0x03;
+	rx_packet.data[16] = 0x04;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.state = CMD_VALID_PACKET;
+	rx_packet.dest_addr = 0x5D;
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_protocol_transport_header*) tx_packet[0].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet[0].data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
+
+	header = (struct mctp_protocol_transport_header*) tx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&mctp, &cmd.base, &device_mgr, MCTP_PROTOCOL_PA_ROT_CTRL_EID,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	request.length = 10;
+	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.source_eid = 0x0A;
+	request.target_eid = 0x0B;
+	request.new_request = false;
+	request.crypto_timeout = false;
+	request.can_defer = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+
+	response.length = msg_size + 4;
+	response.data[0] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	memcpy (&response.data[4], payload, msg_size);
+	response.source_eid = 0x0A;
+	response.target_eid = 0x0B;
+	response.new_request = false;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&channel.mock, channel.base.receive_packet, &channel, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
+	status |= mock_expect_output (&channel.mock, 0, &rx_packet, sizeof (rx_packet), -1);
+
+	status |= mock_expect (&cmd.mock, cmd.base.process_request, &cmd, 0,
+		MOCK_ARG_VALIDATOR (cmd_interface_mock_validate_request, &request, sizeof (request)));
+	status |= mock_expect_output (&cmd.mock, 0, &response, sizeof (response), -1);
+
+	status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+			sizeof (struct cmd_packet)));
+	status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
+			sizeof (struct cmd_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process_in_place (&channel.base, &mctp, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&device_mgr);
+
+	mctp_interface_deinit (&mctp);
+}
+static void cmd_channel_test_receive_and_process_in_place_null (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_interface_mock cmd;
+	struct device_manager device_mgr;
+	struct mctp_interface mctp;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&mctp, &cmd.base, &device_mgr, MCTP_PROTOCOL_PA_ROT_CTRL_EID,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process_in_place (NULL, &mctp, -1);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_receive_and_process_in_place (&channel.base, NULL, -1);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&device_mgr);
+
+	mctp_interface_deinit (&mctp);
+}
+
+static void cmd_channel_test_send_deferred_response_no_response (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_interface_mock cmd;
+	struct device_manager device_mgr;
+	struct mctp_interface mctp;
+	struct cmd_async async;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&mctp, &cmd.base, &device_mgr, MCTP_PROTOCOL_PA_ROT_CTRL_EID,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_set_async (&mctp, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_deferred_response (&channel.base, &mctp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_deferred_response_in_place (&channel.base, &mctp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&device_mgr);
+
+	mctp_interface_deinit (&mctp);
+	cmd_async_release (&async);
+}
+
+static void cmd_channel_test_send_deferred_response_null (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_interface_mock cmd;
+	struct device_manager device_mgr;
+	struct mctp_interface mctp;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&mctp, &cmd.base, &device_mgr, MCTP_PROTOCOL_PA_ROT_CTRL_EID,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_deferred_response (NULL, &mctp);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_send_deferred_response (&channel.base, NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_send_deferred_response_in_place (NULL, &mctp);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_send_deferred_response_in_place (&channel.base, NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&device_mgr);
+
+	mctp_interface_deinit (&mctp);
+}
+
 CuSuite* get_cmd_channel_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -2325,6 +2776,11 @@ CuSuite* get_cmd_channel_suite ()
 	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_send_failure);
 	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_overflow_packet);
 	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_multiple_overflow_packet);
+	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_in_place_single_packet_response);
+	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_in_place_multi_packet_response);
+	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_in_place_null);
+	SUITE_ADD_TEST (suite, cmd_channel_test_send_deferred_response_no_response);
+	SUITE_ADD_TEST (suite, cmd_channel_test_send_deferred_response_null);
 
 	return suite;
 }
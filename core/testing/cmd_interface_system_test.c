@@ -10,6 +10,7 @@
 #include "mctp/mctp_protocol.h"
 #include "cmd_interface/cmd_interface.h"
 #include "cmd_interface/cmd_interface_system.h"
+#include "cmd_interface/cmd_async.h"
 #include "cmd_interface/device_manager.h"
 #include "cmd_interface/cerberus_protocol.h"
 #include "cmd_interface/cerberus_protocol_required_commands.h"
@@ -533,6 +534,54 @@ static void setup_cmd_interface_system_mock_test (CuTest *test,
 	cmd_interface_system_deinit (&cmd->handler);
 }
 
+/**
+ * Direction reported for the last request processed by the platform command handler.
+ */
+static int cmd_interface_system_testing_platform_direction;
+
+/**
+ * Platform command handler for testing.  The response contains a single byte.
+ *
+ * @param intf The command interface processing the request.
+ * @param request The request to process.
+ * @param device_num Device manager index of the device that sent the request.
+ * @param direction Direction of the device that sent the request.
+ *
+ * @return 0 always.
+ */
+static int cmd_interface_system_testing_platform_command (struct cmd_interface *intf,
+	struct cmd_interface_request *request, int device_num, int direction)
+{
+	cmd_interface_system_testing_platform_direction = direction;
+
+	request->data[CERBERUS_PROTOCOL_MIN_MSG_LEN] = 0x5A;
+	request->length = CERBERUS_PROTOCOL_MIN_MSG_LEN + 1;
+
+	return 0;
+}
+
+/**
+ * Build a request for a command with no payload.
+ *
+ * @param request The request to build.
+ * @param command_id The command to request.
+ */
+static void cmd_interface_system_testing_build_request (struct cmd_interface_request *request,
+	uint8_t command_id)
+{
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) request->data;
+
+	memset (request, 0, sizeof (struct cmd_interface_request));
+	header->msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	header->pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	header->command = command_id;
+
+	request->length = CERBERUS_PROTOCOL_MIN_MSG_LEN;
+	request->max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request->source_eid = MCTP_PROTOCOL_BMC_EID;
+	request->target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+}
+
 /**
  * Tear down the test suite.
  *
@@ -6062,6 +6111,656 @@ static void cmd_interface_system_test_issue_challenge_null (CuTest *test)
 }
 
 
+static void cmd_interface_system_test_set_async (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_async async;
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_async (&cmd.handler, &async);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &async, cmd.handler.async);
+
+	status = cmd_interface_system_set_async (&cmd.handler, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, cmd.handler.async);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_set_async_null (CuTest *test)
+{
+	struct cmd_async async;
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_async (NULL, &async);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_process_get_challenge_response_deferred (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_async async;
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	struct cerberus_protocol_challenge *req = (struct cerberus_protocol_challenge*) request.data;
+	struct cerberus_protocol_challenge_response *resp =
+		(struct cerberus_protocol_challenge_response*) response.data;
+	uint8_t response_buf[136] = {0};
+	struct attestation_response *challenge = (struct attestation_response*) response_buf;
+	int max = CERBERUS_PROTOCOL_MAX_PAYLOAD_PER_MSG;
+	int status;
+
+	TEST_START;
+
+	challenge->slot_num = 0;
+	challenge->slot_mask = 1;
+	challenge->min_protocol_version = 1;
+	challenge->max_protocol_version = 1;
+	challenge->nonce[0] = 0xAA;
+	challenge->nonce[31] = 0xBB;
+	challenge->num_digests = 2;
+	challenge->digests_size = SHA256_HASH_LENGTH;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE;
+
+	memset (&req->challenge.nonce, 0x55, 32);
+	req->challenge.slot_num = 0;
+	request.length = sizeof (struct cerberus_protocol_challenge);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	request.can_defer = true;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_async (&cmd.handler, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	request.new_request = true;
+	request.crypto_timeout = false;
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, CMD_RESPONSE_DEFERRED_ESCAPE_SEQ, status);
+	CuAssertIntEquals (test, true, cmd_async_is_pending (&async));
+
+	status = mock_validate (&cmd.slave_attestation.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.slave_attestation.mock,
+		cmd.slave_attestation.base.challenge_response, &cmd.slave_attestation,
+		sizeof (response_buf), MOCK_ARG_NOT_NULL, MOCK_ARG (max));
+	status |= mock_expect_output (&cmd.slave_attestation.mock, 0, &response_buf,
+		sizeof (response_buf), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, cmd_async_is_pending (&async));
+
+	status = cmd_async_get_response (&async, &response);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MIN_MSG_LEN + sizeof (response_buf),
+		response.length);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, resp->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, resp->header.command);
+	CuAssertIntEquals (test, true, response.crypto_timeout);
+
+	status = testing_validate_array (response_buf, &response.data[CERBERUS_PROTOCOL_MIN_MSG_LEN],
+		sizeof (response_buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_process_get_challenge_response_cannot_defer (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_async async;
+	struct cmd_interface_request request;
+	struct cerberus_protocol_challenge *req = (struct cerberus_protocol_challenge*) request.data;
+	struct cerberus_protocol_challenge_response *resp =
+		(struct cerberus_protocol_challenge_response*) request.data;
+	uint8_t response_buf[136] = {0};
+	struct attestation_response *challenge = (struct attestation_response*) response_buf;
+	int max = CERBERUS_PROTOCOL_MAX_PAYLOAD_PER_MSG;
+	int status;
+
+	TEST_START;
+
+	challenge->slot_num = 0;
+	challenge->slot_mask = 1;
+	challenge->min_protocol_version = 1;
+	challenge->max_protocol_version = 1;
+	challenge->nonce[0] = 0xAA;
+	challenge->nonce[31] = 0xBB;
+	challenge->num_digests = 2;
+	challenge->digests_size = SHA256_HASH_LENGTH;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE;
+
+	memset (&req->challenge.nonce, 0x55, 32);
+	req->challenge.slot_num = 0;
+	request.length = sizeof (struct cerberus_protocol_challenge);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	request.can_defer = false;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_async (&cmd.handler, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.slave_attestation.mock,
+		cmd.slave_attestation.base.challenge_response, &cmd.slave_attestation,
+		sizeof (response_buf), MOCK_ARG_NOT_NULL, MOCK_ARG (max));
+	status |= mock_expect_output (&cmd.slave_attestation.mock, 0, &response_buf,
+		sizeof (response_buf), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	request.new_request = true;
+	request.crypto_timeout = false;
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, cmd_async_is_pending (&async));
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MIN_MSG_LEN + sizeof (response_buf),
+		request.length);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, resp->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, resp->header.command);
+	CuAssertIntEquals (test, true, request.crypto_timeout);
+
+	status = testing_validate_array (response_buf, &request.data[CERBERUS_PROTOCOL_MIN_MSG_LEN],
+		sizeof (response_buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_process_platform_command_deferred (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[0xC1];
+	struct cmd_async async;
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+	commands[0xC0].handler = cmd_interface_system_testing_platform_command;
+	commands[0xC0].directions = CMD_INTERFACE_ANY_DIRECTION;
+	commands[0xC0].defer = CMD_INTERFACE_ANY_DIRECTION;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, commands, 0xC1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_async (&cmd.handler, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_platform_direction = -1;
+	cmd_interface_system_testing_build_request (&request, 0xC0);
+	request.can_defer = true;
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, CMD_RESPONSE_DEFERRED_ESCAPE_SEQ, status);
+	CuAssertIntEquals (test, true, cmd_async_is_pending (&async));
+	CuAssertIntEquals (test, -1, cmd_interface_system_testing_platform_direction);
+
+	status = cmd_async_execute (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_async_get_response (&async, &response);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MIN_MSG_LEN + 1, response.length);
+	CuAssertIntEquals (test, 0x5A, response.data[CERBERUS_PROTOCOL_MIN_MSG_LEN]);
+	CuAssertIntEquals (test, DEVICE_MANAGER_UPSTREAM,
+		cmd_interface_system_testing_platform_direction);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_process_platform_command_deferred_busy (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[0xC1];
+	struct cmd_async async;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+	commands[0xC0].handler = cmd_interface_system_testing_platform_command;
+	commands[0xC0].directions = CMD_INTERFACE_ANY_DIRECTION;
+	commands[0xC0].defer = CMD_INTERFACE_ANY_DIRECTION;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, commands, 0xC1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_async (&cmd.handler, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Occupy the deferred execution context with another request. */
+	memset (&request, 0, sizeof (request));
+	status = cmd_async_submit (&async, &cmd.handler.base, cmd.handler.base.process_request,
+		&request);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_platform_direction = -1;
+	cmd_interface_system_testing_build_request (&request, 0xC0);
+	request.can_defer = true;
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MIN_MSG_LEN + 1, request.length);
+	CuAssertIntEquals (test, 0x5A, request.data[CERBERUS_PROTOCOL_MIN_MSG_LEN]);
+	CuAssertIntEquals (test, DEVICE_MANAGER_UPSTREAM,
+		cmd_interface_system_testing_platform_direction);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_process_platform_command_deferred_not_supported (
+	CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[0xC1];
+	struct cmd_async async;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+	commands[0xC0].handler = cmd_interface_system_testing_platform_command;
+	commands[0xC0].directions = CMD_INTERFACE_ANY_DIRECTION;
+	commands[0xC0].defer = CMD_INTERFACE_ANY_DIRECTION;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, commands, 0xC1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_async (&cmd.handler, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The transport is not able to send a response later, so the request is processed now. */
+	cmd_interface_system_testing_platform_direction = -1;
+	cmd_interface_system_testing_build_request (&request, 0xC0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, cmd_async_is_pending (&async));
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MIN_MSG_LEN + 1, request.length);
+	CuAssertIntEquals (test, 0x5A, request.data[CERBERUS_PROTOCOL_MIN_MSG_LEN]);
+	CuAssertIntEquals (test, DEVICE_MANAGER_UPSTREAM,
+		cmd_interface_system_testing_platform_direction);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_process_get_fw_version_not_deferred (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_async async;
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_async (&cmd.handler, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	cerberus_protocol_required_commands_testing_process_get_fw_version (test, &cmd.handler.base,
+		CERBERUS_FW_VERSION);
+	CuAssertIntEquals (test, false, cmd_async_is_pending (&async));
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+	cmd_async_release (&async);
+}
+
+static void cmd_interface_system_test_set_platform_commands (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[1];
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, commands, 1);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, commands, (void*) cmd.handler.platform_cmds);
+	CuAssertIntEquals (test, 1, cmd.handler.platform_cmd_count);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, (void*) cmd.handler.platform_cmds);
+	CuAssertIntEquals (test, 0, cmd.handler.platform_cmd_count);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_set_platform_commands_null (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[1];
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_platform_commands (NULL, commands, 1);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, NULL, 1);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, (void*) cmd.handler.platform_cmds);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_platform_command (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[0xC1];
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+	commands[0xC0].handler = cmd_interface_system_testing_platform_command;
+	commands[0xC0].directions = CMD_INTERFACE_ANY_DIRECTION;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	cmd_interface_system_testing_build_request (&request, 0xC0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_UNKNOWN_COMMAND, status);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, commands, 0xC1);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_platform_direction = -1;
+	cmd_interface_system_testing_build_request (&request, 0xC0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MIN_MSG_LEN + 1, request.length);
+	CuAssertIntEquals (test, 0x5A, request.data[CERBERUS_PROTOCOL_MIN_MSG_LEN]);
+	CuAssertIntEquals (test, DEVICE_MANAGER_UPSTREAM,
+		cmd_interface_system_testing_platform_direction);
+
+	/* Commands outside the platform table are still handled. */
+	cerberus_protocol_required_commands_testing_process_get_fw_version (test, &cmd.handler.base,
+		CERBERUS_FW_VERSION);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_platform_command_replace_standard_command (
+	CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[CERBERUS_PROTOCOL_GET_FW_VERSION + 1];
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+	commands[CERBERUS_PROTOCOL_GET_FW_VERSION].handler =
+		cmd_interface_system_testing_platform_command;
+	commands[CERBERUS_PROTOCOL_GET_FW_VERSION].directions = CMD_INTERFACE_ANY_DIRECTION;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, commands,
+		CERBERUS_PROTOCOL_GET_FW_VERSION + 1);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_build_request (&request, CERBERUS_PROTOCOL_GET_FW_VERSION);
+	request.data[CERBERUS_PROTOCOL_MIN_MSG_LEN] = 0;
+	request.length++;
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MIN_MSG_LEN + 1, request.length);
+	CuAssertIntEquals (test, 0x5A, request.data[CERBERUS_PROTOCOL_MIN_MSG_LEN]);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_platform_command_unsupported_direction (
+	CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_command commands[0xC1];
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	memset (commands, 0, sizeof (commands));
+	commands[0xC0].handler = cmd_interface_system_testing_platform_command;
+	commands[0xC0].directions = CMD_INTERFACE_DIRECTION (DEVICE_MANAGER_DOWNSTREAM);
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_platform_commands (&cmd.handler, commands, 0xC1);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_build_request (&request, 0xC0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_DEVICE_MODE, status);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_set_attestation_scheduler (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_DOWNSTREAM);
+
+	status = attestation_scheduler_init (&scheduler, &cmd.device_manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_attestation_scheduler (&cmd.handler, &scheduler);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &scheduler, cmd.handler.attestation_scheduler);
+
+	status = cmd_interface_system_set_attestation_scheduler (&cmd.handler, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, cmd.handler.attestation_scheduler);
+
+	attestation_scheduler_release (&scheduler);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_set_attestation_scheduler_null (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_DOWNSTREAM);
+
+	status = attestation_scheduler_init (&scheduler, &cmd.device_manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_attestation_scheduler (NULL, &scheduler);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	attestation_scheduler_release (&scheduler);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_attestation_scheduled (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_DOWNSTREAM);
+
+	status = device_manager_update_device_state (&cmd.device_manager, 1,
+		DEVICE_MANAGER_AVAILABLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_init (&scheduler, &cmd.device_manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_attestation_scheduler (&cmd.handler, &scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, request.device_num);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_DIGEST, request.command);
+
+	cerberus_protocol_master_commands_testing_process_process_certificate_digest (test,
+		&cmd.handler.base, &cmd.master_attestation);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_IN_PROGRESS,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+
+	cerberus_protocol_master_commands_testing_process_process_challenge_response (test,
+		&cmd.handler.base, &cmd.master_attestation);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_PASSED,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+
+	attestation_scheduler_release (&scheduler);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_attestation_scheduled_fail (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct attestation_scheduler scheduler;
+	struct attestation_scheduler_request request;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_DOWNSTREAM);
+
+	status = device_manager_update_device_state (&cmd.device_manager, 1,
+		DEVICE_MANAGER_AVAILABLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_init (&scheduler, &cmd.device_manager, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_system_set_attestation_scheduler (&cmd.handler, &scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_start_sweep (&scheduler);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation_scheduler_get_next_request (&scheduler, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	cerberus_protocol_master_commands_testing_process_process_challenge_response_fail (test,
+		&cmd.handler.base, &cmd.master_attestation);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_FAILED,
+		attestation_scheduler_get_device_state (&scheduler, 1));
+
+	attestation_scheduler_release (&scheduler);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
 CuSuite* get_cmd_interface_system_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -6499,6 +7198,26 @@ CuSuite* get_cmd_interface_system_suite ()
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_attestation_data_invalid_len);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_attestation_data_fail);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_attestation_data_no_data);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_async);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_async_null);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_challenge_response_deferred);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_challenge_response_cannot_defer);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_platform_command_deferred);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_platform_command_deferred_busy);
+	SUITE_ADD_TEST (suite,
+		cmd_interface_system_test_process_platform_command_deferred_not_supported);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_fw_version_not_deferred);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_platform_commands);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_platform_commands_null);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_platform_command);
+	SUITE_ADD_TEST (suite,
+		cmd_interface_system_test_process_platform_command_replace_standard_command);
+	SUITE_ADD_TEST (suite,
+		cmd_interface_system_test_process_platform_command_unsupported_direction);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_attestation_scheduler);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_attestation_scheduler_null);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_attestation_scheduled);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_attestation_scheduled_fail);
 
 	/* Tear down after the tests in this suite have run. */
 	SUITE_ADD_TEST (suite, cmd_interface_system_testing_suite_tear_down);
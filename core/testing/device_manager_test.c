@@ -884,6 +884,159 @@ static void device_manager_test_get_device_num_invalid_eid (CuTest *test)
 	device_manager_release (&manager);
 }
 
+static void device_manager_test_get_device_num_updated_eid (CuTest *test)
+{
+	struct device_manager manager;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 3, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 0, DEVICE_MANAGER_SELF, 0xAA, 0xBB);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 1, DEVICE_MANAGER_DOWNSTREAM, 0xCC,
+		0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 2, DEVICE_MANAGER_DOWNSTREAM, 0xEE,
+		0xFF);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_eid (&manager, 1, 0x11);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, DEVICE_MGR_UNKNOWN_DEVICE, status);
+
+	status = device_manager_get_device_num (&manager, 0x11);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_update_device_entry (&manager, 2, DEVICE_MANAGER_DOWNSTREAM, 0x22,
+		0xFF);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xEE);
+	CuAssertIntEquals (test, DEVICE_MGR_UNKNOWN_DEVICE, status);
+
+	status = device_manager_get_device_num (&manager, 0x22);
+	CuAssertIntEquals (test, 2, status);
+
+	status = device_manager_get_device_num (&manager, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&manager);
+}
+
+static void device_manager_test_get_device_num_duplicate_eid (CuTest *test)
+{
+	struct device_manager manager;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 3, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 0, DEVICE_MANAGER_SELF, 0xAA, 0xBB);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 2, DEVICE_MANAGER_DOWNSTREAM, 0xCC,
+		0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 1, DEVICE_MANAGER_DOWNSTREAM, 0xCC,
+		0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The first matching entry is reported. */
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_update_device_eid (&manager, 1, 0xEE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, 2, status);
+
+	status = device_manager_get_device_num (&manager, 0xEE);
+	CuAssertIntEquals (test, 1, status);
+
+	device_manager_release (&manager);
+}
+
+static void device_manager_test_get_device_num_after_resize (CuTest *test)
+{
+	struct device_manager manager;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 3, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 0, DEVICE_MANAGER_SELF, 0xAA, 0xBB);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 1, DEVICE_MANAGER_DOWNSTREAM, 0xCC,
+		0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 2, DEVICE_MANAGER_DOWNSTREAM, 0xEE,
+		0xFF);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_resize_entries_table (&manager, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xEE);
+	CuAssertIntEquals (test, DEVICE_MGR_UNKNOWN_DEVICE, status);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, 1, status);
+
+	status = device_manager_resize_entries_table (&manager, 4);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, 1, status);
+
+	/* New entries have not been assigned an EID. */
+	status = device_manager_get_device_num (&manager, 0);
+	CuAssertIntEquals (test, 2, status);
+
+	device_manager_release (&manager);
+}
+
+static void device_manager_test_get_device_num_after_release (CuTest *test)
+{
+	struct device_manager manager;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 2, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&manager, 1, DEVICE_MANAGER_DOWNSTREAM, 0xCC,
+		0xDD);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&manager);
+
+	status = device_manager_get_device_num (&manager, 0xCC);
+	CuAssertIntEquals (test, DEVICE_MGR_UNKNOWN_DEVICE, status);
+}
+
 static void device_manager_test_resize_entries_table_add_entries (CuTest *test)
 {
 	struct device_manager manager;
@@ -2555,6 +2708,99 @@ static void device_manager_test_get_crypto_timeout_by_eid_null (CuTest *test)
 }
 
 
+static void device_manager_test_cert_chain_version (CuTest *test)
+{
+	struct device_manager manager;
+	struct device_manager_cert_chain chain;
+	uint32_t version;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 2, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_cert_chain (&manager, 0, &chain);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, chain.version);
+
+	status = device_manager_init_cert_chain (&manager, 0, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_cert_chain (&manager, 0, &chain);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (chain.version != 0));
+
+	version = chain.version;
+
+	status = device_manager_update_cert (&manager, 0, 1, X509_CERTCA_ECC_CA_NOPL_DER,
+		X509_CERTCA_ECC_CA_NOPL_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_cert_chain (&manager, 0, &chain);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (chain.version != version));
+
+	version = chain.version;
+
+	status = device_manager_get_device_cert_chain (&manager, 0, &chain);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, version, chain.version);
+
+	status = device_manager_init_cert_chain (&manager, 0, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_cert_chain (&manager, 0, &chain);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (chain.version != version));
+
+	device_manager_release (&manager);
+}
+
+static void device_manager_test_cert_chain_version_2_devices (CuTest *test)
+{
+	struct device_manager manager;
+	struct device_manager_cert_chain chain;
+	uint32_t version;
+	int status;
+
+	TEST_START;
+
+	status = device_manager_init (&manager, 2, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init_cert_chain (&manager, 0, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_cert (&manager, 0, 1, X509_CERTCA_ECC_CA_NOPL_DER,
+		X509_CERTCA_ECC_CA_NOPL_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_cert_chain (&manager, 0, &chain);
+	CuAssertIntEquals (test, 0, status);
+
+	version = chain.version;
+
+	status = device_manager_init_cert_chain (&manager, 1, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_cert (&manager, 1, 1, X509_CERTCA_RSA_CA_NOPL_DER,
+		X509_CERTCA_RSA_CA_NOPL_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_cert_chain (&manager, 0, &chain);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, version, chain.version);
+
+	status = device_manager_get_device_cert_chain (&manager, 1, &chain);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (chain.version != version));
+
+	device_manager_release (&manager);
+}
+
 CuSuite* get_device_manager_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -2601,6 +2847,10 @@ CuSuite* get_device_manager_suite ()
 	SUITE_ADD_TEST (suite, device_manager_test_get_device_num);
 	SUITE_ADD_TEST (suite, device_manager_test_get_device_num_null);
 	SUITE_ADD_TEST (suite, device_manager_test_get_device_num_invalid_eid);
+	SUITE_ADD_TEST (suite, device_manager_test_get_device_num_updated_eid);
+	SUITE_ADD_TEST (suite, device_manager_test_get_device_num_duplicate_eid);
+	SUITE_ADD_TEST (suite, device_manager_test_get_device_num_after_resize);
+	SUITE_ADD_TEST (suite, device_manager_test_get_device_num_after_release);
 	SUITE_ADD_TEST (suite, device_manager_test_resize_entries_table_add_entries);
 	SUITE_ADD_TEST (suite, device_manager_test_resize_entries_table_remove_entries);
 	SUITE_ADD_TEST (suite, device_manager_test_resize_entries_table_invalid_arg);
@@ -2665,6 +2915,8 @@ CuSuite* get_device_manager_suite ()
 	SUITE_ADD_TEST (suite,
 		device_manager_test_get_crypto_timeout_by_eid_remote_device_unknown_device);
 	SUITE_ADD_TEST (suite, device_manager_test_get_crypto_timeout_by_eid_null);
+	SUITE_ADD_TEST (suite, device_manager_test_cert_chain_version);
+	SUITE_ADD_TEST (suite, device_manager_test_cert_chain_version_2_devices);
 
 	return suite;
 }
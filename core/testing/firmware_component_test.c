@@ -5249,6 +5249,892 @@ static void firmware_component_test_compare_and_copy_copy_error (CuTest *test)
 }
 
 
+static void firmware_component_test_load_and_verify_streaming (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH,
+		2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_OFFSET), MOCK_ARG (load_data),
+		MOCK_ARG (FW_COMPONENT_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT, FW_COMPONENT_LENGTH, 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		0, MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_HASH, SHA256_HASH_LENGTH),
+		MOCK_ARG (SHA256_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH),
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FW_COMPONENT_LENGTH, app_len);
+
+	status = testing_validate_array (FW_COMPONENT, load_data, FW_COMPONENT_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (FW_COMPONENT_HASH, hash_actual, SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_no_hash_out (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH,
+		2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_OFFSET), MOCK_ARG (load_data),
+		MOCK_ARG (FW_COMPONENT_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT, FW_COMPONENT_LENGTH, 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		0, MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_HASH, SHA256_HASH_LENGTH),
+		MOCK_ARG (SHA256_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH),
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, NULL, 0, &app_len);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FW_COMPONENT_LENGTH, app_len);
+
+	status = testing_validate_array (FW_COMPONENT, load_data, FW_COMPONENT_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_with_header (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_EXTRA_HDR_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1,
+		FW_COMPONENT_HEADER_DATA + FW_COMPONENT_EXTRA_HDR_LENGTH,
+		sizeof (FW_COMPONENT_HEADER_DATA) - FW_COMPONENT_EXTRA_HDR_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN + FW_COMPONENT_EXTRA_HDR_LENGTH),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1,
+		FW_COMPONENT_HEADER_DATA + IMAGE_HEADER_BASE_LEN + FW_COMPONENT_EXTRA_HDR_LENGTH,
+		sizeof (FW_COMPONENT_HEADER_DATA) - IMAGE_HEADER_BASE_LEN - FW_COMPONENT_EXTRA_HDR_LENGTH,
+		2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init_with_header (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER,
+		FW_COMPONENT_EXTRA_HDR_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_HEADER_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_HEADER_SIGNATURE,
+		FW_COMPONENT_SIG_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FW_COMPONENT_EXTRA_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_HEADER_DATA,
+		sizeof (FW_COMPONENT_HEADER_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_HEADER_OFFSET), MOCK_ARG (load_data),
+		MOCK_ARG (FW_COMPONENT_HEADER_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_HEADER, FW_COMPONENT_HEADER_LENGTH,
+		2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		0, MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_HEADER_HASH, SHA256_HASH_LENGTH),
+		MOCK_ARG (SHA256_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_HEADER_SIGNATURE, FW_COMPONENT_SIG_LENGTH),
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FW_COMPONENT_HEADER_LENGTH, app_len);
+
+	status = testing_validate_array (FW_COMPONENT_HEADER, load_data, FW_COMPONENT_HEADER_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (FW_COMPONENT_HEADER_HASH, hash_actual, SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (NULL, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_INVALID_ARGUMENT, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, NULL, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_INVALID_ARGUMENT, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		NULL, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_INVALID_ARGUMENT, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, NULL, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_small_hash_buffer (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH - 1];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_HASH_BUFFER_TOO_SMALL, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, 0, &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_HASH_BUFFER_TOO_SMALL, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_image_too_large (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[FW_COMPONENT_LENGTH - 1];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_TOO_LARGE, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, 0, &hash.base,
+		&verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FIRMWARE_COMPONENT_TOO_LARGE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_verify_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH,
+		2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_OFFSET), MOCK_ARG (load_data),
+		MOCK_ARG (FW_COMPONENT_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT, FW_COMPONENT_LENGTH, 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_VERIFY_SIG_FAILED,
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_HASH, SHA256_HASH_LENGTH),
+		MOCK_ARG (SHA256_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH),
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, SIG_VERIFICATION_VERIFY_SIG_FAILED, status);
+
+	status = testing_validate_array (FW_COMPONENT_HASH, hash_actual, SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_read_signature_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000 + FW_COMPONENT_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_with_header_read_extra_header_error (
+	CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_EXTRA_HDR_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1,
+		FW_COMPONENT_HEADER_DATA + FW_COMPONENT_EXTRA_HDR_LENGTH,
+		sizeof (FW_COMPONENT_HEADER_DATA) - FW_COMPONENT_EXTRA_HDR_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN + FW_COMPONENT_EXTRA_HDR_LENGTH),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1,
+		FW_COMPONENT_HEADER_DATA + IMAGE_HEADER_BASE_LEN + FW_COMPONENT_EXTRA_HDR_LENGTH,
+		sizeof (FW_COMPONENT_HEADER_DATA) - IMAGE_HEADER_BASE_LEN - FW_COMPONENT_EXTRA_HDR_LENGTH,
+		2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init_with_header (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER,
+		FW_COMPONENT_EXTRA_HDR_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_HEADER_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_HEADER_SIGNATURE,
+		FW_COMPONENT_SIG_LENGTH, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (FW_COMPONENT_EXTRA_HDR_LENGTH));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+}
+
+static void firmware_component_test_load_and_verify_streaming_with_header_hash_extra_header_error (
+	CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_EXTRA_HDR_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1,
+		FW_COMPONENT_HEADER_DATA + FW_COMPONENT_EXTRA_HDR_LENGTH,
+		sizeof (FW_COMPONENT_HEADER_DATA) - FW_COMPONENT_EXTRA_HDR_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN + FW_COMPONENT_EXTRA_HDR_LENGTH),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1,
+		FW_COMPONENT_HEADER_DATA + IMAGE_HEADER_BASE_LEN + FW_COMPONENT_EXTRA_HDR_LENGTH,
+		sizeof (FW_COMPONENT_HEADER_DATA) - IMAGE_HEADER_BASE_LEN - FW_COMPONENT_EXTRA_HDR_LENGTH,
+		2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init_with_header (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER,
+		FW_COMPONENT_EXTRA_HDR_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_HEADER_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_HEADER_SIGNATURE,
+		FW_COMPONENT_SIG_LENGTH, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FW_COMPONENT_EXTRA_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_HEADER_DATA,
+		sizeof (FW_COMPONENT_HEADER_DATA), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_HEADER_DATA, FW_COMPONENT_EXTRA_HDR_LENGTH),
+		MOCK_ARG (FW_COMPONENT_EXTRA_HDR_LENGTH));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+}
+
+static void firmware_component_test_load_and_verify_streaming_image_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH,
+		2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000 + FW_COMPONENT_OFFSET), MOCK_ARG (load_data),
+		MOCK_ARG (FW_COMPONENT_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_component_test_load_and_verify_streaming_hash_image_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct firmware_component image;
+	struct signature_verification_mock verification;
+	int status;
+	uint8_t load_data[sizeof (FW_COMPONENT_DATA)];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t app_len;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA, sizeof (FW_COMPONENT_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN,
+		sizeof (FW_COMPONENT_DATA) - IMAGE_HEADER_BASE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_init (&image, &flash.base, 0x10000, FW_COMPONENT_MARKER);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_SIG_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FW_COMPONENT_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT_SIGNATURE, FW_COMPONENT_SIG_LENGTH,
+		2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_DATA, IMAGE_HEADER_BASE_LEN),
+		MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT_DATA + IMAGE_HEADER_BASE_LEN, FW_COMPONENT_HDR_LENGTH),
+		MOCK_ARG (FW_COMPONENT_HDR_LENGTH));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FW_COMPONENT_OFFSET), MOCK_ARG (load_data),
+		MOCK_ARG (FW_COMPONENT_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, FW_COMPONENT, FW_COMPONENT_LENGTH, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_PTR_CONTAINS (FW_COMPONENT, FW_COMPONENT_LENGTH), MOCK_ARG (FW_COMPONENT_LENGTH));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_component_load_and_verify_streaming (&image, load_data, sizeof (load_data),
+		&hash.base, &verification.base, hash_actual, sizeof (hash_actual), &app_len);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_component_release (&image);
+}
+
 CuSuite* get_firmware_component_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -5363,6 +6249,20 @@ CuSuite* get_firmware_component_suite ()
 	SUITE_ADD_TEST (suite, firmware_component_test_compare_and_copy_compare_error);
 	SUITE_ADD_TEST (suite, firmware_component_test_compare_and_copy_erase_error);
 	SUITE_ADD_TEST (suite, firmware_component_test_compare_and_copy_copy_error);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_no_hash_out);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_with_header);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_null);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_small_hash_buffer);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_image_too_large);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_verify_error);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_read_signature_error);
+	SUITE_ADD_TEST (suite,
+		firmware_component_test_load_and_verify_streaming_with_header_read_extra_header_error);
+	SUITE_ADD_TEST (suite,
+		firmware_component_test_load_and_verify_streaming_with_header_hash_extra_header_error);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_image_error);
+	SUITE_ADD_TEST (suite, firmware_component_test_load_and_verify_streaming_hash_image_error);
 
 	return suite;
 }
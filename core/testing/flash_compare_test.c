@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "testing.h"
+#include "flash/flash_compare.h"
+
+
+static const char *SUITE = "flash_compare";
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_compare_test_const_byte_blank (CuTest *test)
+{
+	uint8_t data[4096];
+	bool match;
+
+	TEST_START;
+
+	memset (data, 0xff, sizeof (data));
+
+	match = flash_compare_const_byte (data, sizeof (data), 0xff);
+	CuAssertIntEquals (test, true, match);
+}
+
+static void flash_compare_test_const_byte_value (CuTest *test)
+{
+	uint8_t data[4096];
+	bool match;
+
+	TEST_START;
+
+	memset (data, 0x5a, sizeof (data));
+
+	match = flash_compare_const_byte (data, sizeof (data), 0x5a);
+	CuAssertIntEquals (test, true, match);
+
+	match = flash_compare_const_byte (data, sizeof (data), 0xff);
+	CuAssertIntEquals (test, false, match);
+}
+
+static void flash_compare_test_const_byte_zero_length (CuTest *test)
+{
+	uint8_t data[1] = {0};
+	bool match;
+
+	TEST_START;
+
+	match = flash_compare_const_byte (data, 0, 0xff);
+	CuAssertIntEquals (test, true, match);
+}
+
+static void flash_compare_test_const_byte_unaligned (CuTest *test)
+{
+	uint8_t data[160];
+	size_t offset;
+	size_t length;
+	bool match;
+
+	TEST_START;
+
+	memset (data, 0xff, sizeof (data));
+
+	for (offset = 0; offset < 16; offset++) {
+		for (length = 0; length <= (sizeof (data) - offset); length++) {
+			match = flash_compare_const_byte (&data[offset], length, 0xff);
+			CuAssertIntEquals (test, true, match);
+		}
+	}
+}
+
+static void flash_compare_test_const_byte_mismatch (CuTest *test)
+{
+	uint8_t data[160];
+	size_t offset;
+	size_t length;
+	size_t i;
+	bool match;
+
+	TEST_START;
+
+	memset (data, 0xff, sizeof (data));
+
+	for (offset = 0; offset < 16; offset++) {
+		for (length = 1; length <= (sizeof (data) - offset); length++) {
+			for (i = 0; i < length; i++) {
+				data[offset + i] = 0xfe;
+
+				match = flash_compare_const_byte (&data[offset], length, 0xff);
+				CuAssertIntEquals (test, false, match);
+
+				data[offset + i] = 0xff;
+			}
+		}
+	}
+}
+
+static void flash_compare_test_const_byte_mismatch_outside_length (CuTest *test)
+{
+	uint8_t data[160];
+	bool match;
+
+	TEST_START;
+
+	memset (data, 0, sizeof (data));
+	data[0] = 0x01;
+	data[sizeof (data) - 1] = 0x01;
+
+	match = flash_compare_const_byte (&data[1], sizeof (data) - 2, 0);
+	CuAssertIntEquals (test, true, match);
+}
+
+static void flash_compare_test_data (CuTest *test)
+{
+	uint8_t data1[4096];
+	uint8_t data2[4096];
+	size_t i;
+	bool match;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data1); i++) {
+		data1[i] = i;
+	}
+	memcpy (data2, data1, sizeof (data2));
+
+	match = flash_compare_data (data1, data2, sizeof (data1));
+	CuAssertIntEquals (test, true, match);
+}
+
+static void flash_compare_test_data_zero_length (CuTest *test)
+{
+	uint8_t data1[1] = {0};
+	uint8_t data2[1] = {1};
+	bool match;
+
+	TEST_START;
+
+	match = flash_compare_data (data1, data2, 0);
+	CuAssertIntEquals (test, true, match);
+}
+
+static void flash_compare_test_data_unaligned (CuTest *test)
+{
+	uint8_t data1[160];
+	uint8_t data2[176];
+	size_t offset1;
+	size_t offset2;
+	size_t length;
+	size_t i;
+	bool match;
+
+	TEST_START;
+
+	for (offset1 = 0; offset1 < 8; offset1++) {
+		for (offset2 = 0; offset2 < 8; offset2++) {
+			for (i = 0; i < (sizeof (data1) - offset1); i++) {
+				data1[offset1 + i] = i * 3;
+				data2[offset2 + i] = i * 3;
+			}
+
+			for (length = 0; length <= (sizeof (data1) - offset1); length++) {
+				match = flash_compare_data (&data1[offset1], &data2[offset2], length);
+				CuAssertIntEquals (test, true, match);
+			}
+		}
+	}
+}
+
+static void flash_compare_test_data_mismatch (CuTest *test)
+{
+	uint8_t data1[160];
+	uint8_t data2[160];
+	size_t offset;
+	size_t length;
+	size_t i;
+	bool match;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data1); i++) {
+		data1[i] = i;
+	}
+	memcpy (data2, data1, sizeof (data2));
+
+	for (offset = 0; offset < 16; offset++) {
+		for (length = 1; length <= (sizeof (data1) - offset); length++) {
+			for (i = 0; i < length; i++) {
+				data2[offset + i] ^= 0x80;
+
+				match = flash_compare_data (&data1[offset], &data2[offset], length);
+				CuAssertIntEquals (test, false, match);
+
+				data2[offset + i] ^= 0x80;
+			}
+		}
+	}
+}
+
+
+CuSuite* get_flash_compare_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, flash_compare_test_const_byte_blank);
+	SUITE_ADD_TEST (suite, flash_compare_test_const_byte_value);
+	SUITE_ADD_TEST (suite, flash_compare_test_const_byte_zero_length);
+	SUITE_ADD_TEST (suite, flash_compare_test_const_byte_unaligned);
+	SUITE_ADD_TEST (suite, flash_compare_test_const_byte_mismatch);
+	SUITE_ADD_TEST (suite, flash_compare_test_const_byte_mismatch_outside_length);
+	SUITE_ADD_TEST (suite, flash_compare_test_data);
+	SUITE_ADD_TEST (suite, flash_compare_test_data_zero_length);
+	SUITE_ADD_TEST (suite, flash_compare_test_data_unaligned);
+	SUITE_ADD_TEST (suite, flash_compare_test_data_mismatch);
+
+	return suite;
+}
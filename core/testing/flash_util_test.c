@@ -9,6 +9,7 @@
 #include "engines/hash_testing_engine.h"
 #include "engines/rsa_testing_engine.h"
 #include "mock/flash_mock.h"
+#include "mock/flash_async_read_mock.h"
 #include "mock/hash_mock.h"
 #include "mock/signature_verification_mock.h"
 #include "flash/flash_common.h"
@@ -1288,37 +1289,38 @@ static void flash_verify_data_test_multiple_blocks (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint8_t data[RSA_ENCRYPT_LEN * 3];
+	uint8_t data[FLASH_DATA_CHECK_BLOCK * 3];
 	int offset = 0;
+	size_t i;
 
 	TEST_START;
 
-	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
-	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
-	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	offset += FLASH_VERIFICATION_BLOCK;
+	offset += FLASH_DATA_CHECK_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
-		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
-	offset += FLASH_VERIFICATION_BLOCK;
+	offset += FLASH_DATA_CHECK_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
-		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
+		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK - 1));
 	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_data (&flash.base, 0x10000, data, (FLASH_VERIFICATION_BLOCK * 3) - 1);
+	status = flash_verify_data (&flash.base, 0x10000, data, (FLASH_DATA_CHECK_BLOCK * 3) - 1);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -1330,41 +1332,42 @@ static void flash_verify_data_test_multiple_blocks_mismatch_last_block (CuTest *
 {
 	struct flash_mock flash;
 	int status;
-	uint8_t data[RSA_ENCRYPT_LEN * 3];
+	uint8_t data[FLASH_DATA_CHECK_BLOCK * 3];
 	uint8_t bad_data[sizeof (data)];
 	int offset = 0;
+	size_t i;
 
 	TEST_START;
 
-	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
-	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
-	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
 
 	memcpy (bad_data, data, sizeof (data));
-	bad_data[(FLASH_VERIFICATION_BLOCK * 2) + 1] ^= 0x55;
+	bad_data[(FLASH_DATA_CHECK_BLOCK * 2) + 1] ^= 0x55;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, bad_data, sizeof (bad_data), 2);
 
-	offset += FLASH_VERIFICATION_BLOCK;
+	offset += FLASH_DATA_CHECK_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
-		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, bad_data + offset, sizeof (bad_data) - offset, 2);
 
-	offset += FLASH_VERIFICATION_BLOCK;
+	offset += FLASH_DATA_CHECK_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
-		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
+		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK - 1));
 	status |= mock_expect_output (&flash.mock, 1, bad_data + offset, sizeof (bad_data) - offset, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_data (&flash.base, 0x10000, data, (FLASH_VERIFICATION_BLOCK * 3) - 1);
+	status = flash_verify_data (&flash.base, 0x10000, data, (FLASH_DATA_CHECK_BLOCK * 3) - 1);
 	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -1375,35 +1378,36 @@ static void flash_verify_data_test_multiple_blocks_mismatch_middle_block (CuTest
 {
 	struct flash_mock flash;
 	int status;
-	uint8_t data[RSA_ENCRYPT_LEN * 3];
+	uint8_t data[FLASH_DATA_CHECK_BLOCK * 3];
 	uint8_t bad_data[sizeof (data)];
 	int offset = 0;
+	size_t i;
 
 	TEST_START;
 
-	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
-	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
-	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
 
 	memcpy (bad_data, data, sizeof (data));
-	bad_data[(FLASH_VERIFICATION_BLOCK * 1) + 1] ^= 0x55;
+	bad_data[(FLASH_DATA_CHECK_BLOCK * 1) + 1] ^= 0x55;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, bad_data, sizeof (bad_data), 2);
 
-	offset += FLASH_VERIFICATION_BLOCK;
+	offset += FLASH_DATA_CHECK_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
-		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG (0x10000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_DATA_CHECK_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, bad_data + offset, sizeof (bad_data) - offset, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_data (&flash.base, 0x10000, data, (FLASH_VERIFICATION_BLOCK * 3) - 1);
+	status = flash_verify_data (&flash.base, 0x10000, data, (FLASH_DATA_CHECK_BLOCK * 3) - 1);
 	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -1798,7 +1802,6 @@ static void flash_copy_test_multiple_pages (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -1806,7 +1809,6 @@ static void flash_copy_test_multiple_pages (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -1819,23 +1821,7 @@ static void flash_copy_test_multiple_pages (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -1882,13 +1868,11 @@ static void flash_copy_test_full_block (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_BLOCK_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -1901,11 +1885,7 @@ static void flash_copy_test_full_block (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	for (offset = 0; offset < FLASH_BLOCK_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-			MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, FLASH_BLOCK_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -1983,13 +1963,11 @@ static void flash_copy_test_source_higher_address_full_block (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_BLOCK_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -2002,11 +1980,7 @@ static void flash_copy_test_source_higher_address_full_block (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
 
-	for (offset = 0; offset < FLASH_BLOCK_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000 + offset),
-			MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x10000, FLASH_BLOCK_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -2084,7 +2058,6 @@ static void flash_copy_test_multiple_pages_page_not_256 (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -2093,7 +2066,6 @@ static void flash_copy_test_multiple_pages_page_not_256 (CuTest *test)
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -2106,41 +2078,7 @@ static void flash_copy_test_multiple_pages_page_not_256 (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -2187,7 +2125,6 @@ static void flash_copy_test_multiple_pages_page_offset (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -2195,7 +2132,6 @@ static void flash_copy_test_multiple_pages_page_offset (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -2208,23 +2144,7 @@ static void flash_copy_test_multiple_pages_page_offset (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20010, page * 3);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -2594,7 +2514,6 @@ static void flash_copy_test_multiple_pages_error (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -2602,7 +2521,6 @@ static void flash_copy_test_multiple_pages_error (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -2615,23 +2533,7 @@ static void flash_copy_test_multiple_pages_error (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -3094,7 +2996,6 @@ static void flash_copy_and_verify_test_multiple_pages_mismatch (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -3102,7 +3003,6 @@ static void flash_copy_and_verify_test_multiple_pages_mismatch (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -3115,23 +3015,7 @@ static void flash_copy_and_verify_test_multiple_pages_mismatch (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -3176,13 +3060,11 @@ static void flash_copy_and_verify_test_full_block (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_BLOCK_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -3195,11 +3077,7 @@ static void flash_copy_and_verify_test_full_block (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	for (offset = 0; offset < FLASH_BLOCK_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-			MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, FLASH_BLOCK_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -3285,9 +3163,7 @@ static void flash_copy_and_verify_test_multiple_pages_page_not_256 (CuTest *test
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
-	int verify;
 
 	TEST_START;
 
@@ -3295,7 +3171,6 @@ static void flash_copy_and_verify_test_multiple_pages_page_not_256 (CuTest *test
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -3308,42 +3183,7 @@ static void flash_copy_and_verify_test_multiple_pages_page_not_256 (CuTest *test
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
-	verify = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -3355,18 +3195,11 @@ static void flash_copy_and_verify_test_multiple_pages_page_not_256 (CuTest *test
 	status |= mock_expect (&flash.mock, flash.base.write, &flash, page, MOCK_ARG (0x20000 + offset),
 		MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
@@ -3375,18 +3208,11 @@ static void flash_copy_and_verify_test_multiple_pages_page_not_256 (CuTest *test
 	status |= mock_expect (&flash.mock, flash.base.write, &flash, page, MOCK_ARG (0x20000 + offset),
 		MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
@@ -3396,15 +3222,9 @@ static void flash_copy_and_verify_test_multiple_pages_page_not_256 (CuTest *test
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page - 1),
 		MOCK_ARG (page - 1));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
+	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -3422,7 +3242,6 @@ static void flash_copy_and_verify_test_multiple_pages_page_offset (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -3430,7 +3249,6 @@ static void flash_copy_and_verify_test_multiple_pages_page_offset (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -3443,23 +3261,7 @@ static void flash_copy_and_verify_test_multiple_pages_page_offset (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20010, page * 3);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -4065,7 +3867,6 @@ static void flash_copy_ext_test_multiple_pages (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -4073,7 +3874,6 @@ static void flash_copy_ext_test_multiple_pages (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -4088,23 +3888,7 @@ static void flash_copy_ext_test_multiple_pages (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -4156,13 +3940,11 @@ static void flash_copy_ext_test_full_block (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_BLOCK_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -4177,11 +3959,7 @@ static void flash_copy_ext_test_full_block (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	for (offset = 0; offset < FLASH_BLOCK_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
-			MOCK_ARG (0x20000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, FLASH_BLOCK_SIZE);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -4268,13 +4046,11 @@ static void flash_copy_ext_test_same_flash_full_block (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_BLOCK_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -4287,11 +4063,7 @@ static void flash_copy_ext_test_same_flash_full_block (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	for (offset = 0; offset < FLASH_BLOCK_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-			MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, FLASH_BLOCK_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -4376,7 +4148,6 @@ static void flash_copy_ext_test_multiple_pages_page_not_256 (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -4385,7 +4156,6 @@ static void flash_copy_ext_test_multiple_pages_page_not_256 (CuTest *test)
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -4400,51 +4170,17 @@ static void flash_copy_ext_test_multiple_pages_page_not_256 (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
-	offset += FLASH_VERIFICATION_BLOCK;
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash1.mock, 1, data + offset, sizeof (data) - offset, 2);
 
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
-
-	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
-
-	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
-	status |= mock_expect_output (&flash1.mock, 1, data + offset, sizeof (data) - offset, 2);
-
-	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, page,
-		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, page,
+		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
 	offset += page;
 
@@ -4485,7 +4221,6 @@ static void flash_copy_ext_test_multiple_pages_page_offset (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -4493,7 +4228,6 @@ static void flash_copy_ext_test_multiple_pages_page_offset (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -4508,23 +4242,7 @@ static void flash_copy_ext_test_multiple_pages_page_offset (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20010, page * 3);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -4964,7 +4682,6 @@ static void flash_copy_ext_test_multiple_pages_error (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -4972,7 +4689,6 @@ static void flash_copy_ext_test_multiple_pages_error (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -4987,23 +4703,7 @@ static void flash_copy_ext_test_multiple_pages_error (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -5593,7 +5293,6 @@ static void flash_copy_ext_and_verify_test_multiple_pages_mismatch (CuTest *test
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -5601,7 +5300,6 @@ static void flash_copy_ext_and_verify_test_multiple_pages_mismatch (CuTest *test
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -5616,23 +5314,7 @@ static void flash_copy_ext_and_verify_test_multiple_pages_mismatch (CuTest *test
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -5682,13 +5364,11 @@ static void flash_copy_ext_and_verify_test_full_block (CuTest *test)
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_BLOCK_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -5703,11 +5383,7 @@ static void flash_copy_ext_and_verify_test_full_block (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	for (offset = 0; offset < FLASH_BLOCK_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
-			MOCK_ARG (0x20000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, FLASH_BLOCK_SIZE);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -5805,9 +5481,7 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_not_256 (CuTest *
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
-	int verify;
 
 	TEST_START;
 
@@ -5815,7 +5489,6 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_not_256 (CuTest *
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -5830,42 +5503,7 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_not_256 (CuTest *
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
-	verify = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -5877,18 +5515,11 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_not_256 (CuTest *
 	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, page,
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash2.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
@@ -5897,18 +5528,11 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_not_256 (CuTest *
 	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, page,
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash2.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
@@ -5918,15 +5542,9 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_not_256 (CuTest *
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page - 1),
 		MOCK_ARG (page - 1));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
+	status |= mock_expect_output (&flash2.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -5949,7 +5567,6 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_offset (CuTest *t
 	uint32_t bytes = FLASH_BLOCK_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -5957,7 +5574,6 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_offset (CuTest *t
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -5972,23 +5588,7 @@ static void flash_copy_ext_and_verify_test_multiple_pages_page_offset (CuTest *t
 
 	status |= mock_expect (&flash2.mock, flash2.base.block_erase, &flash2, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20010, page * 3);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -8724,7 +8324,6 @@ static void flash_sector_copy_test_multiple_pages (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -8732,7 +8331,6 @@ static void flash_sector_copy_test_multiple_pages (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -8745,23 +8343,7 @@ static void flash_sector_copy_test_multiple_pages (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -8808,13 +8390,11 @@ static void flash_sector_copy_test_full_sector (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_SECTOR_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -8827,11 +8407,7 @@ static void flash_sector_copy_test_full_sector (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
 
-	for (offset = 0; offset < FLASH_SECTOR_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x11000 + offset),
-			MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x11000, FLASH_SECTOR_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -8909,13 +8485,11 @@ static void flash_sector_copy_test_source_higher_address_full_sector (CuTest *te
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_SECTOR_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -8928,11 +8502,7 @@ static void flash_sector_copy_test_source_higher_address_full_sector (CuTest *te
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
 
-	for (offset = 0; offset < FLASH_SECTOR_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000 + offset),
-			MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x10000, FLASH_SECTOR_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -9010,7 +8580,6 @@ static void flash_sector_copy_test_multiple_pages_page_not_256 (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -9019,7 +8588,6 @@ static void flash_sector_copy_test_multiple_pages_page_not_256 (CuTest *test)
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -9032,41 +8600,7 @@ static void flash_sector_copy_test_multiple_pages_page_not_256 (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -9113,7 +8647,6 @@ static void flash_sector_copy_test_multiple_pages_page_offset (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -9121,7 +8654,6 @@ static void flash_sector_copy_test_multiple_pages_page_offset (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -9134,23 +8666,7 @@ static void flash_sector_copy_test_multiple_pages_page_offset (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20010, page * 3);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -9520,7 +9036,6 @@ static void flash_sector_copy_test_multiple_pages_error (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -9528,7 +9043,6 @@ static void flash_sector_copy_test_multiple_pages_error (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -9541,23 +9055,7 @@ static void flash_sector_copy_test_multiple_pages_error (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -9812,7 +9310,6 @@ static void flash_sector_copy_and_verify_test_multiple_pages_mismatch (CuTest *t
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -9820,7 +9317,6 @@ static void flash_sector_copy_and_verify_test_multiple_pages_mismatch (CuTest *t
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -9833,23 +9329,7 @@ static void flash_sector_copy_and_verify_test_multiple_pages_mismatch (CuTest *t
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -9895,13 +9375,11 @@ static void flash_sector_copy_and_verify_test_full_sector (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_SECTOR_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -9914,11 +9392,7 @@ static void flash_sector_copy_and_verify_test_full_sector (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
 
-	for (offset = 0; offset < FLASH_SECTOR_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x11000 + offset),
-			MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x11000, FLASH_SECTOR_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -10004,9 +9478,7 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_not_256 (CuTes
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
-	int verify;
 
 	TEST_START;
 
@@ -10014,7 +9486,6 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_not_256 (CuTes
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -10027,42 +9498,7 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_not_256 (CuTes
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
-	verify = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -10074,18 +9510,11 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_not_256 (CuTes
 	status |= mock_expect (&flash.mock, flash.base.write, &flash, page, MOCK_ARG (0x20000 + offset),
 		MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
@@ -10094,18 +9523,11 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_not_256 (CuTes
 	status |= mock_expect (&flash.mock, flash.base.write, &flash, page, MOCK_ARG (0x20000 + offset),
 		MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
@@ -10115,15 +9537,9 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_not_256 (CuTes
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page - 1),
 		MOCK_ARG (page - 1));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
+	status |= mock_expect_output (&flash.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -10141,7 +9557,6 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_offset (CuTest
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -10149,7 +9564,6 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_offset (CuTest
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -10162,23 +9576,7 @@ static void flash_sector_copy_and_verify_test_multiple_pages_page_offset (CuTest
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash, 0x20010, page * 3);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -10746,7 +10144,6 @@ static void flash_sector_copy_ext_test_multiple_pages (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -10754,7 +10151,6 @@ static void flash_sector_copy_ext_test_multiple_pages (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -10769,23 +10165,7 @@ static void flash_sector_copy_ext_test_multiple_pages (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -10837,13 +10217,11 @@ static void flash_sector_copy_ext_test_full_sector (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_SECTOR_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -10858,11 +10236,7 @@ static void flash_sector_copy_ext_test_full_sector (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x11000));
 
-	for (offset = 0; offset < FLASH_SECTOR_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
-			MOCK_ARG (0x11000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash2, 0x11000, FLASH_SECTOR_SIZE);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -10949,13 +10323,11 @@ static void flash_sector_copy_ext_test_same_flash_full_sector (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_SECTOR_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -10968,11 +10340,7 @@ static void flash_sector_copy_ext_test_same_flash_full_sector (CuTest *test)
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
 
-	for (offset = 0; offset < FLASH_SECTOR_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
-			MOCK_ARG (0x11000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash, 0x11000, FLASH_SECTOR_SIZE);
 
 	status |= mock_expect (&flash.mock, flash.base.get_page_size, &flash, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash.mock, 0, &page, sizeof (page), -1);
@@ -11057,7 +10425,6 @@ static void flash_sector_copy_ext_test_multiple_pages_page_not_256 (CuTest *test
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -11066,7 +10433,6 @@ static void flash_sector_copy_ext_test_multiple_pages_page_not_256 (CuTest *test
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -11081,41 +10447,7 @@ static void flash_sector_copy_ext_test_multiple_pages_page_not_256 (CuTest *test
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -11166,7 +10498,6 @@ static void flash_sector_copy_ext_test_multiple_pages_page_offset (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -11174,7 +10505,6 @@ static void flash_sector_copy_ext_test_multiple_pages_page_offset (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -11189,23 +10519,7 @@ static void flash_sector_copy_ext_test_multiple_pages_page_offset (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20010, page * 3);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -11645,7 +10959,6 @@ static void flash_sector_copy_ext_test_multiple_pages_error (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -11653,7 +10966,6 @@ static void flash_sector_copy_ext_test_multiple_pages_error (CuTest *test)
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -11668,23 +10980,7 @@ static void flash_sector_copy_ext_test_multiple_pages_error (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -12015,7 +11311,6 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_mismatch (CuTes
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -12023,7 +11318,6 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_mismatch (CuTes
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -12038,23 +11332,7 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_mismatch (CuTes
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -12104,13 +11382,11 @@ static void flash_sector_copy_ext_and_verify_test_full_sector (CuTest *test)
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[FLASH_SECTOR_SIZE];
-	uint8_t blank[sizeof (data)];
 	int offset;
 
 	TEST_START;
 
 	memset (data, 0x55, sizeof (data));
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -12125,11 +11401,7 @@ static void flash_sector_copy_ext_and_verify_test_full_sector (CuTest *test)
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x11000));
 
-	for (offset = 0; offset < FLASH_SECTOR_SIZE; offset += FLASH_VERIFICATION_BLOCK) {
-		status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
-			MOCK_ARG (0x11000 + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-		status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-	}
+	status |= flash_mock_expect_blank_check (&flash2, 0x11000, FLASH_SECTOR_SIZE);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -12227,9 +11499,7 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_not_256 (C
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = 256 * 2;
 	uint8_t data[page * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
-	int verify;
 
 	TEST_START;
 
@@ -12237,7 +11507,6 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_not_256 (C
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 3], data, RSA_ENCRYPT_LEN * 3);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -12252,42 +11521,7 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_not_256 (C
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
-	verify = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20000, (page * 3) - 1);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -12299,18 +11533,11 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_not_256 (C
 	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, page,
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash2.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
@@ -12319,18 +11546,11 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_not_256 (C
 	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, page,
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page), MOCK_ARG (page));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page));
+	status |= mock_expect_output (&flash2.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	offset += page;
-	verify += FLASH_VERIFICATION_BLOCK;
 
 	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000 + offset),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
@@ -12340,15 +11560,9 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_not_256 (C
 		MOCK_ARG (0x20000 + offset), MOCK_ARG_PTR_CONTAINS (data + offset, page - 1),
 		MOCK_ARG (page - 1));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
-
-	verify += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + verify),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK - 1));
-	status |= mock_expect_output (&flash2.mock, 1, data + verify, sizeof (data) - verify, 2);
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000 + offset),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (page - 1));
+	status |= mock_expect_output (&flash2.mock, 1, data + offset, sizeof (data) - offset, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -12371,7 +11585,6 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_offset (Cu
 	uint32_t bytes = FLASH_SECTOR_SIZE;
 	uint32_t page = FLASH_PAGE_SIZE;
 	uint8_t data[RSA_ENCRYPT_LEN * 3];
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];
 	int offset = 0;
 
 	TEST_START;
@@ -12379,7 +11592,6 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_offset (Cu
 	memcpy (data, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN], RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN);
 	memcpy (&data[RSA_ENCRYPT_LEN * 2], RSA_ENCRYPT_BAD, RSA_ENCRYPT_LEN);
-	memset (blank, 0xff, sizeof (blank));
 
 	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
@@ -12394,23 +11606,7 @@ static void flash_sector_copy_ext_and_verify_test_multiple_pages_page_offset (Cu
 
 	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20010));
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset += FLASH_VERIFICATION_BLOCK;
-
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20010 + offset),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
-
-	offset = 0;
+	status |= flash_mock_expect_blank_check (&flash2, 0x20010, page * 3);
 
 	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
 	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
@@ -15538,240 +14734,2712 @@ static void flash_noncontiguous_contents_verification_at_offset_test_read_error_
 }
 
 
-CuSuite* get_flash_util_suite ()
+static void flash_hash_pipeline_test_init (CuTest *test)
 {
-	CuSuite *suite = CuSuiteNew ();
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
 
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_sha256);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_sha1);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_unknown);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_multiple_blocks);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_null);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_read_error);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_multiple_blocks_read_error);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_hash_start_error);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_hash_update_error);
-	SUITE_ADD_TEST (suite, flash_hash_contents_test_hash_finish_error);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256_with_hash_out);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256_no_match_signature);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256_no_match_signature_with_hash_out);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha1);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_unknown);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_null);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_small_hash_buffer);
-	SUITE_ADD_TEST (suite, flash_verify_contents_test_read_error_with_hash_out);
-	SUITE_ADD_TEST (suite, flash_erase_region_test);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_offset_start);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_offset_end);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_offset);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_offset_end_aligned);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_no_length);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_not_64k);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_offset_not_64k);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_null);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_block_size_error);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_error);
-	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_error);
-	SUITE_ADD_TEST (suite, flash_program_data_test);
-	SUITE_ADD_TEST (suite, flash_program_data_test_offset);
-	SUITE_ADD_TEST (suite, flash_program_data_test_null);
-	SUITE_ADD_TEST (suite, flash_program_data_test_erase_error);
-	SUITE_ADD_TEST (suite, flash_program_data_test_write_error);
-	SUITE_ADD_TEST (suite, flash_program_data_test_incomplete_write);
-	SUITE_ADD_TEST (suite, flash_verify_data_test);
-	SUITE_ADD_TEST (suite, flash_verify_data_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_verify_data_test_multiple_blocks);
-	SUITE_ADD_TEST (suite, flash_verify_data_test_multiple_blocks_mismatch_last_block);
-	SUITE_ADD_TEST (suite, flash_verify_data_test_multiple_blocks_mismatch_middle_block);
-	SUITE_ADD_TEST (suite, flash_verify_data_test_null);
-	SUITE_ADD_TEST (suite, flash_verify_data_test_error);
-	SUITE_ADD_TEST (suite, flash_program_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_program_and_verify_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_program_and_verify_test_null);
-	SUITE_ADD_TEST (suite, flash_program_and_verify_test_error);
-	SUITE_ADD_TEST (suite, flash_program_and_verify_test_verify_error);
-	SUITE_ADD_TEST (suite, flash_blank_check_test);
-	SUITE_ADD_TEST (suite, flash_blank_check_test_not_blank);
-	SUITE_ADD_TEST (suite, flash_blank_check_test_null);
-	SUITE_ADD_TEST (suite, flash_blank_check_test_error);
-	SUITE_ADD_TEST (suite, flash_copy_test);
-	SUITE_ADD_TEST (suite, flash_copy_test_across_erase_blocks);
-	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages);
-	SUITE_ADD_TEST (suite, flash_copy_test_full_block);
-	SUITE_ADD_TEST (suite, flash_copy_test_source_higher_address);
-	SUITE_ADD_TEST (suite, flash_copy_test_source_higher_address_full_block);
-	SUITE_ADD_TEST (suite, flash_copy_test_not_64k);
-	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages_page_not_256);
-	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages_page_offset);
-	SUITE_ADD_TEST (suite, flash_copy_test_null);
-	SUITE_ADD_TEST (suite, flash_copy_test_no_length);
-	SUITE_ADD_TEST (suite, flash_copy_test_block_check_error);
-	SUITE_ADD_TEST (suite, flash_copy_test_not_blank);
-	SUITE_ADD_TEST (suite, flash_copy_test_page_size_error);
-	SUITE_ADD_TEST (suite, flash_copy_test_page_size_unsupported);
-	SUITE_ADD_TEST (suite, flash_copy_test_read_error);
-	SUITE_ADD_TEST (suite, flash_copy_test_write_error);
-	SUITE_ADD_TEST (suite, flash_copy_test_partial_write);
-	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages_error);
-	SUITE_ADD_TEST (suite, flash_copy_test_overlapping_regions);
-	SUITE_ADD_TEST (suite, flash_copy_test_overlapping_regions_source_higher);
-	SUITE_ADD_TEST (suite, flash_copy_test_same_erase_block);
-	SUITE_ADD_TEST (suite, flash_copy_test_same_erase_block_at_source_end);
-	SUITE_ADD_TEST (suite, flash_copy_test_same_erase_block_at_destination_end);
-	SUITE_ADD_TEST (suite, flash_verify_copy_test);
-	SUITE_ADD_TEST (suite, flash_verify_copy_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_verify_copy_test_multiple_pages);
-	SUITE_ADD_TEST (suite, flash_verify_copy_test_multiple_pages_mismatch);
-	SUITE_ADD_TEST (suite, flash_verify_copy_test_null);
-	SUITE_ADD_TEST (suite, flash_verify_copy_test_read_error);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_multiple_pages_mismatch);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_full_block);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_not_64k);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_multiple_pages_page_not_256);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_multiple_pages_page_offset);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_null);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_block_check_error);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_not_blank);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_page_size_error);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_page_size_unsupported);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_read_error);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_write_error);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_partial_write);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_overlapping_regions);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_overlapping_regions_source_higher);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_same_erase_block);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_same_erase_block_at_source_end);
-	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_same_erase_block_at_destination_end);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_across_erase_blocks);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_full_block);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_source_same_address);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_full_block);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_not_64k);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages_page_not_256);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages_page_offset);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_null);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_no_length);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_block_check_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_not_blank);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_page_size_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_page_size_unsupported);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_read_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_write_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_partial_write);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_overlapping_regions);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_overlapping_regions_source_higher);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_same_erase_block);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_same_erase_block_at_source_end);
-	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_same_erase_block_at_destination_end);
-	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test);
-	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_multiple_pages);
-	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_multiple_pages_mismatch);
-	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_null);
-	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_read_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_address);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_multiple_pages_mismatch);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_full_block);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_not_64k);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_multiple_pages_page_not_256);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_multiple_pages_page_offset);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_null);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_block_check_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_not_blank);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_page_size_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_page_size_unsupported);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_read_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_write_error);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_partial_write);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_flash_overlapping_regions);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_flash_overlapping_source_higher);
-	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_flash_same_erase_block);
-	SUITE_ADD_TEST (suite,
-		flash_copy_ext_and_verify_test_same_flash_same_erase_block_at_source_end);
-	SUITE_ADD_TEST (suite,
-		flash_copy_ext_and_verify_test_same_flash_same_erase_block_at_destination_end);
-	SUITE_ADD_TEST (suite, flash_copy_to_blank_test);
-	SUITE_ADD_TEST (suite, flash_copy_to_blank_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_copy_ext_to_blank_test);
-	SUITE_ADD_TEST (suite, flash_copy_ext_to_blank_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_not_blank);
-	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_null);
-	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_block_check_error);
-	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_erase_error);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_sha256);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_sha1);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_unknown);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_blocks);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_regions);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_null);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_read_error);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_blocks_read_error);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_regions_read_error);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_hash_start_error);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_hash_update_error);
-	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_hash_finish_error);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha256);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha256_with_hash_out);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha256_no_match_signature);
-	SUITE_ADD_TEST (suite,
-		flash_verify_noncontiguous_contents_test_sha256_no_match_signature_with_hash_out);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha1);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_unknown);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_multiple_regions);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_null);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_hash_buffer_too_small);
-	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_read_error_with_hash_out);
-	SUITE_ADD_TEST (suite, flash_value_check_test);
-	SUITE_ADD_TEST (suite, flash_value_check_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_value_check_test_null);
-	SUITE_ADD_TEST (suite, flash_value_check_test_error);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_offset_start);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_offset_end);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_offset);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_offset_end_aligned);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_no_length);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_not_4k);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_offset_not_4k);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_null);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_sector_size_error);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_error);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_error);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_not_blank);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_null);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_sector_check_error);
-	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_erase_error);
-	SUITE_ADD_TEST (suite, flash_sector_program_data_test);
-	SUITE_ADD_TEST (suite, flash_sector_program_data_test_offset);
-	SUITE_ADD_TEST (suite, flash_sector_program_data_test_null);
-	SUITE_ADD_TEST (suite, flash_sector_program_data_test_erase_error);
-	SUITE_ADD_TEST (suite, flash_sector_program_data_test_write_error);
-	SUITE_ADD_TEST (suite, flash_sector_program_data_test_incomplete_write);
-	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test);
-	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_mismatch);
-	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_null);
-	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_error);
-	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_verify_error);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test_across_erase_blocks);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test_multiple_pages);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test_full_sector);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test_source_higher_address);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test_source_higher_address_full_sector);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test_not_4k);
-	SUITE_ADD_TEST (suite, flash_sector_copy_test_multiple_pages_page_not_256);
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, pipeline.buffer[0]);
+	CuAssertPtrEquals (test, pipeline.buffer[0], pipeline.buffer[1]);
+	CuAssertIntEquals (test, FLASH_HASH_PIPELINE_MIN_CHUNK, pipeline.chunk_size);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_test_init_async (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MAX_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, pipeline.buffer[0]);
+	CuAssertPtrEquals (test, &pipeline.buffer[0][FLASH_HASH_PIPELINE_MAX_CHUNK],
+		pipeline.buffer[1]);
+	CuAssertIntEquals (test, FLASH_HASH_PIPELINE_MAX_CHUNK, pipeline.chunk_size);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_test_init_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (NULL, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_init (&pipeline, NULL, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_pipeline_test_init_unsupported_chunk_size (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK -
+		1);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_CHUNK_SIZE, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MAX_CHUNK +
+		1);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_CHUNK_SIZE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_pipeline_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_hash_pipeline_release (NULL);
+}
+
+static void flash_hash_pipeline_hash_contents_test (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t data[(FLASH_HASH_PIPELINE_MIN_CHUNK * 2) + 16];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK],
+		sizeof (data) - FLASH_HASH_PIPELINE_MIN_CHUNK, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + (FLASH_HASH_PIPELINE_MIN_CHUNK * 2)), MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK * 2], 16, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x10000, sizeof (data), &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_hash_contents_test_async (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t data[(FLASH_HASH_PIPELINE_MIN_CHUNK * 2) + 16];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = ~i;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&async.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK), MOCK_ARG (pipeline.buffer[1]),
+		MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&async.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK],
+		sizeof (data) - FLASH_HASH_PIPELINE_MIN_CHUNK, 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + (FLASH_HASH_PIPELINE_MIN_CHUNK * 2)), MOCK_ARG (pipeline.buffer[0]),
+		MOCK_ARG (16));
+	status |= mock_expect_output (&async.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK * 2], 16, 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x10000, sizeof (data), &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_hash_contents_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_contents (NULL, 0x10000, 16, &hash.base, HASH_TYPE_SHA256,
+		hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x10000, 0, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x10000, 16, NULL, HASH_TYPE_SHA256,
+		hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x10000, 16, &hash.base,
+		HASH_TYPE_SHA256, NULL, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_hash_noncontiguous_contents_at_offset_test_async (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t data[FLASH_HASH_PIPELINE_MIN_CHUNK + 32];
+	struct flash_region regions[3];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i * 3;
+	}
+
+	regions[0].start_addr = 0x1000;
+	regions[0].length = 32;
+
+	regions[1].start_addr = 0x8000;
+	regions[1].length = 0;
+
+	regions[2].start_addr = 0x20000;
+	regions[2].length = FLASH_HASH_PIPELINE_MIN_CHUNK;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x101000),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (32));
+	status |= mock_expect_output (&async.mock, 1, data, 32, 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x120000),
+		MOCK_ARG (pipeline.buffer[1]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&async.mock, 1, &data[32], FLASH_HASH_PIPELINE_MIN_CHUNK, 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_noncontiguous_contents_at_offset (&pipeline, 0x100000,
+		regions, 3, &hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_hash_noncontiguous_contents_at_offset_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	struct flash_region region;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	region.start_addr = 0x10000;
+	region.length = 16;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_noncontiguous_contents_at_offset (NULL, 0x100000, &region, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_hash_noncontiguous_contents_at_offset (&pipeline, 0x100000, NULL,
+		1, &hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_hash_noncontiguous_contents_at_offset (&pipeline, 0x100000,
+		&region, 0, &hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_hash_contents_test_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x1122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x1122, 4, &hash.base, HASH_TYPE_SHA256,
+		hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_hash_contents_test_async_start_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&async.mock, async.base.start_read, &async, FLASH_READ_FAILED,
+		MOCK_ARG (0x1122), MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (4));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x1122, 4, &hash.base, HASH_TYPE_SHA256,
+		hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_hash_contents_test_async_wait_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x1122),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (4));
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, FLASH_READ_FAILED);
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x1122, 4, &hash.base, HASH_TYPE_SHA256,
+		hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_hash_contents_test_async_hash_update_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK), MOCK_ARG (pipeline.buffer[1]),
+		MOCK_ARG (16));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_hash_contents (&pipeline, 0x10000, FLASH_HASH_PIPELINE_MIN_CHUNK +
+		16, &hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_contents_verification_test (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_contents_verification (&pipeline, 0x4321, strlen (data),
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_contents_verification_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_contents_verification (NULL, 0x4321, 16, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_contents_verification (&pipeline, 0x4321, 0, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_contents_verification (&pipeline, 0x4321, 16, &hash.base,
+		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_verify_noncontiguous_contents_at_offset_test (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	struct flash_region regions;
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (&pipeline, 0x50000,
+		&regions, 1, &hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void flash_hash_pipeline_verify_noncontiguous_contents_at_offset_test_no_match_signature (
+	CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	struct flash_region regions;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (&pipeline, 0x50000,
+		&regions, 1, &hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void flash_hash_pipeline_verify_noncontiguous_contents_at_offset_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	struct flash_region regions;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = 4;
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (NULL, 0x50000,
+		&regions, 1, &hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (&pipeline, 0x50000,
+		NULL, 1, &hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (&pipeline, 0x50000,
+		&regions, 1, NULL, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (&pipeline, 0x50000,
+		&regions, 1, &hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (&pipeline, 0x50000,
+		&regions, 1, &hash.base, HASH_TYPE_SHA256, &rsa.base, NULL, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_verify_noncontiguous_contents_at_offset (&pipeline, 0x50000,
+		&regions, 1, &hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		NULL, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+/**
+ * Context for collecting data passed to a hash pipeline data handler.
+ */
+struct flash_util_testing_pipeline_data {
+	uint8_t *buffer;		/**< Buffer for the collected data. */
+	size_t length;			/**< The amount of data collected. */
+	int calls;				/**< The number of times the handler was called. */
+	int status;				/**< The status to return from the handler. */
+};
+
+/**
+ * Hash pipeline data handler that collects all data it is given.
+ *
+ * @param context The data collection context.
+ * @param data The data read from flash.
+ * @param length The length of the data.
+ *
+ * @return The status configured in the collection context.
+ */
+static int flash_util_testing_pipeline_collect_data (void *context, const uint8_t *data,
+	size_t length)
+{
+	struct flash_util_testing_pipeline_data *collect =
+		(struct flash_util_testing_pipeline_data*) context;
+
+	collect->calls++;
+	if (collect->status == 0) {
+		memcpy (&collect->buffer[collect->length], data, length);
+		collect->length += length;
+	}
+
+	return collect->status;
+}
+
+static void flash_hash_pipeline_process_contents_test (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_util_testing_pipeline_data collect;
+	int status;
+	uint8_t data[FLASH_HASH_PIPELINE_MIN_CHUNK + 16];
+	uint8_t actual[sizeof (data)];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	memset (&collect, 0, sizeof (collect));
+	collect.buffer = actual;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK), MOCK_ARG (pipeline.buffer[0]),
+		MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK], 16, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_process_contents (&pipeline, 0x10000, sizeof (data),
+		flash_util_testing_pipeline_collect_data, &collect);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, collect.calls);
+	CuAssertIntEquals (test, sizeof (data), collect.length);
+
+	status = testing_validate_array (data, actual, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_process_contents_test_async (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	struct flash_util_testing_pipeline_data collect;
+	int status;
+	uint8_t data[FLASH_HASH_PIPELINE_MIN_CHUNK + 16];
+	uint8_t actual[sizeof (data)];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = ~i;
+	}
+
+	memset (&collect, 0, sizeof (collect));
+	collect.buffer = actual;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&async.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK), MOCK_ARG (pipeline.buffer[1]),
+		MOCK_ARG (16));
+	status |= mock_expect_output (&async.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK], 16, 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_process_contents (&pipeline, 0x10000, sizeof (data),
+		flash_util_testing_pipeline_collect_data, &collect);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, collect.calls);
+	CuAssertIntEquals (test, sizeof (data), collect.length);
+
+	status = testing_validate_array (data, actual, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_process_contents_test_zero_length (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_util_testing_pipeline_data collect;
+	int status;
+	uint8_t actual[16];
+
+	TEST_START;
+
+	memset (&collect, 0, sizeof (collect));
+	collect.buffer = actual;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_process_contents (&pipeline, 0x10000, 0,
+		flash_util_testing_pipeline_collect_data, &collect);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, collect.calls);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_process_contents_test_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_util_testing_pipeline_data collect;
+	int status;
+	uint8_t actual[16];
+
+	TEST_START;
+
+	memset (&collect, 0, sizeof (collect));
+	collect.buffer = actual;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_process_contents (NULL, 0x10000, sizeof (actual),
+		flash_util_testing_pipeline_collect_data, &collect);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_process_contents (&pipeline, 0x10000, sizeof (actual), NULL,
+		&collect);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_process_contents_test_read_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_util_testing_pipeline_data collect;
+	int status;
+	uint8_t actual[16];
+
+	TEST_START;
+
+	memset (&collect, 0, sizeof (collect));
+	collect.buffer = actual;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (sizeof (actual)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_process_contents (&pipeline, 0x10000, sizeof (actual),
+		flash_util_testing_pipeline_collect_data, &collect);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	CuAssertIntEquals (test, 0, collect.calls);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_process_contents_test_async_handler_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	struct flash_util_testing_pipeline_data collect;
+	int status;
+	uint8_t data[FLASH_HASH_PIPELINE_MIN_CHUNK + 16];
+	uint8_t actual[sizeof (data)];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	memset (&collect, 0, sizeof (collect));
+	collect.buffer = actual;
+	collect.status = FLASH_UTIL_UNEXPECTED_VALUE;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&async.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK), MOCK_ARG (pipeline.buffer[1]),
+		MOCK_ARG (16));
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_process_contents (&pipeline, 0x10000, sizeof (data),
+		flash_util_testing_pipeline_collect_data, &collect);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+	CuAssertIntEquals (test, 1, collect.calls);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_copy_stream_test_init (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_copy_stream stream;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, stream.data);
+	CuAssertPtrEquals (test, &stream.data[FLASH_COPY_STREAM_MIN_CHUNK], stream.verify);
+	CuAssertIntEquals (test, FLASH_COPY_STREAM_MIN_CHUNK, stream.chunk_size);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_test_init_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_copy_stream stream;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (NULL, &flash.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_copy_stream_init (&stream, NULL, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_copy_stream_test_init_unsupported_chunk_size (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_copy_stream stream;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash.base, FLASH_COPY_STREAM_MIN_CHUNK - 1);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_CHUNK_SIZE, status);
+
+	status = flash_copy_stream_init (&stream, &flash.base, FLASH_COPY_STREAM_MAX_CHUNK + 1);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_CHUNK_SIZE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_copy_stream_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_copy_stream_release (NULL);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[(FLASH_PAGE_SIZE * 2) + 16];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 0x80, MOCK_ARG (0x20080),
+		MOCK_ARG_PTR_CONTAINS (data, 0x80), MOCK_ARG (0x80));
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, FLASH_PAGE_SIZE,
+		MOCK_ARG (0x20100), MOCK_ARG_PTR_CONTAINS (&data[0x80], FLASH_PAGE_SIZE),
+		MOCK_ARG (FLASH_PAGE_SIZE));
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 0x90, MOCK_ARG (0x20200),
+		MOCK_ARG_PTR_CONTAINS (&data[0x180], 0x90), MOCK_ARG (0x90));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20080),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20080, &flash1.base,
+		0x10000, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_multiple_chunks (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[FLASH_COPY_STREAM_MIN_CHUNK + 16];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_COPY_STREAM_MIN_CHUNK));
+	status |= mock_expect_output (&flash1.mock, 1, data, FLASH_COPY_STREAM_MIN_CHUNK, 2);
+
+	for (i = 0; i < FLASH_COPY_STREAM_MIN_CHUNK; i += FLASH_PAGE_SIZE) {
+		status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, FLASH_PAGE_SIZE,
+			MOCK_ARG (0x20000 + i), MOCK_ARG_PTR_CONTAINS (&data[i], FLASH_PAGE_SIZE),
+			MOCK_ARG (FLASH_PAGE_SIZE));
+	}
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_COPY_STREAM_MIN_CHUNK));
+	status |= mock_expect_output (&flash2.mock, 1, data, FLASH_COPY_STREAM_MIN_CHUNK, 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0,
+		MOCK_ARG (0x10000 + FLASH_COPY_STREAM_MIN_CHUNK), MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash1.mock, 1, &data[FLASH_COPY_STREAM_MIN_CHUNK], 16, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 16,
+		MOCK_ARG (0x20000 + FLASH_COPY_STREAM_MIN_CHUNK),
+		MOCK_ARG_PTR_CONTAINS (&data[FLASH_COPY_STREAM_MIN_CHUNK], 16), MOCK_ARG (16));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0,
+		MOCK_ARG (0x20000 + FLASH_COPY_STREAM_MIN_CHUNK), MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash2.mock, 1, &data[FLASH_COPY_STREAM_MIN_CHUNK], 16, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, &flash1.base,
+		0x10000, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_null (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (NULL, 0x20000, &flash1.base, 0x10000,
+		4);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, NULL, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_overlapping_regions (
+	CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t bytes = FLASH_BLOCK_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, &flash.base, 0x10000,
+		0x10001);
+	CuAssertIntEquals (test, FLASH_UTIL_COPY_OVERLAP, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_test (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[FLASH_PAGE_SIZE * 2];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = ~i;
+	}
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, FLASH_PAGE_SIZE,
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, FLASH_PAGE_SIZE),
+		MOCK_ARG (FLASH_PAGE_SIZE));
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, FLASH_PAGE_SIZE,
+		MOCK_ARG (0x20100), MOCK_ARG_PTR_CONTAINS (&data[FLASH_PAGE_SIZE], FLASH_PAGE_SIZE),
+		MOCK_ARG (FLASH_PAGE_SIZE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank (&stream, 0x20000, &flash1.base, 0x10000,
+		sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_test_null (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank (NULL, 0x20000, &flash1.base, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_copy_stream_copy_ext_to_blank (&stream, 0x20000, NULL, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_mismatch (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t bad[] = {0x01, 0x02, 0x03, 0x05};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, bad, sizeof (bad), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, &flash1.base,
+		0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_read_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, &flash1.base,
+		0x10000, 4);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_write_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, &flash1.base,
+		0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_incomplete_write (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data) - 1,
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, &flash1.base,
+		0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INCOMPLETE_WRITE, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_copy_stream_copy_ext_to_blank_and_verify_test_verify_read_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	struct flash_copy_stream stream;
+	int status;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, FLASH_READ_FAILED,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_copy_ext_to_blank_and_verify (&stream, 0x20000, &flash1.base,
+		0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+}
+
+static void flash_hash_update_contents_test (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t data[FLASH_VERIFICATION_BLOCK + 16];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FLASH_VERIFICATION_BLOCK), MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_VERIFICATION_BLOCK], 16, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_update_contents (&flash.base, 0x10000, sizeof (data), &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_update_contents_test (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t data[FLASH_HASH_PIPELINE_MIN_CHUNK + 16];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = ~i;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (pipeline.buffer[0]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK), MOCK_ARG (pipeline.buffer[0]),
+		MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK], 16, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_update_contents (&pipeline, 0x10000, sizeof (data), &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_update_contents_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_update_contents (NULL, 0x10000, 16, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_update_contents (&pipeline, 0x10000, 16, NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_update_contents_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_update_contents (NULL, 0x10000, 16, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_contents (&flash.base, 0x10000, 16, NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_update_contents_test_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_update_contents (&flash.base, 0x10000, 16, &hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_update_contents_test_hash_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t data[16];
+
+	TEST_START;
+
+	memset (data, 0x55, sizeof (data));
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_update_contents (&flash.base, 0x10000, sizeof (data), &hash.base);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_load_and_hash_update_test (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t data[(FLASH_LOAD_HASH_BLOCK * 2) + 16];
+	uint8_t load[sizeof (data)];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	memset (load, 0, sizeof (load));
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (load), MOCK_ARG (FLASH_LOAD_HASH_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + FLASH_LOAD_HASH_BLOCK), MOCK_ARG (&load[FLASH_LOAD_HASH_BLOCK]),
+		MOCK_ARG (FLASH_LOAD_HASH_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_LOAD_HASH_BLOCK],
+		sizeof (data) - FLASH_LOAD_HASH_BLOCK, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + (FLASH_LOAD_HASH_BLOCK * 2)),
+		MOCK_ARG (&load[FLASH_LOAD_HASH_BLOCK * 2]), MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_LOAD_HASH_BLOCK * 2], 16, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_load_and_hash_update (&flash.base, 0x10000, load, sizeof (data), &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, load, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_load_and_hash_update_test_zero_length (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t load[16];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_load_and_hash_update (&flash.base, 0x10000, load, 0, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_pipeline_load_and_hash_update_test (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t data[(FLASH_HASH_PIPELINE_MIN_CHUNK * 2) + 16];
+	uint8_t load[sizeof (data)];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = ~i;
+	}
+
+	memset (load, 0, sizeof (load));
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK *
+		2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (load), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK * 2));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + (FLASH_HASH_PIPELINE_MIN_CHUNK * 2)),
+		MOCK_ARG (&load[FLASH_HASH_PIPELINE_MIN_CHUNK * 2]), MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK * 2], 16, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (&pipeline, 0x10000, load, sizeof (data),
+		&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, load, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_load_and_hash_update_test_async (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t data[(FLASH_HASH_PIPELINE_MIN_CHUNK * 2) + 16];
+	uint8_t load[sizeof (data)];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i * 3;
+	}
+
+	memset (load, 0, sizeof (load));
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (load), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&async.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK),
+		MOCK_ARG (&load[FLASH_HASH_PIPELINE_MIN_CHUNK]), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect_output (&async.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK],
+		sizeof (data) - FLASH_HASH_PIPELINE_MIN_CHUNK, 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + (FLASH_HASH_PIPELINE_MIN_CHUNK * 2)),
+		MOCK_ARG (&load[FLASH_HASH_PIPELINE_MIN_CHUNK * 2]), MOCK_ARG (16));
+	status |= mock_expect_output (&async.mock, 1, &data[FLASH_HASH_PIPELINE_MIN_CHUNK * 2], 16, 2);
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (&pipeline, 0x10000, load, sizeof (data),
+		&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, load, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_load_and_hash_update_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t load[16];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL, FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (NULL, 0x10000, load, sizeof (load),
+		&hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (&pipeline, 0x10000, NULL, sizeof (load),
+		&hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (&pipeline, 0x10000, load, sizeof (load),
+		NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_load_and_hash_update_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t load[16];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_load_and_hash_update (NULL, 0x10000, load, sizeof (load), &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_load_and_hash_update (&flash.base, 0x10000, NULL, sizeof (load), &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_load_and_hash_update (&flash.base, 0x10000, load, sizeof (load), NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_load_and_hash_update_test_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t load[FLASH_LOAD_HASH_BLOCK + 16];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG (load), MOCK_ARG (FLASH_LOAD_HASH_BLOCK));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_load_and_hash_update (&flash.base, 0x10000, load, sizeof (load), &hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_load_and_hash_update_test_hash_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	uint8_t load[FLASH_LOAD_HASH_BLOCK + 16];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (load), MOCK_ARG (FLASH_LOAD_HASH_BLOCK));
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG (load), MOCK_ARG (FLASH_LOAD_HASH_BLOCK));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_load_and_hash_update (&flash.base, 0x10000, load, sizeof (load), &hash.base);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_pipeline_load_and_hash_update_test_async_start_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t load[FLASH_HASH_PIPELINE_MIN_CHUNK + 16];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG (load), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (&pipeline, 0x10000, load, sizeof (load),
+		&hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_load_and_hash_update_test_async_wait_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t load[FLASH_HASH_PIPELINE_MIN_CHUNK + 16];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (load), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, FLASH_READ_FAILED);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (&pipeline, 0x10000, load, sizeof (load),
+		&hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+static void flash_hash_pipeline_load_and_hash_update_test_async_hash_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	struct flash_async_read_mock async;
+	struct flash_hash_pipeline pipeline;
+	int status;
+	uint8_t load[FLASH_HASH_PIPELINE_MIN_CHUNK + 16];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, &async.base,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&async.mock, async.base.start_read, &async, 0, MOCK_ARG (0x10000),
+		MOCK_ARG (load), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+	status |= mock_expect (&async.mock, async.base.start_read, &async, 0,
+		MOCK_ARG (0x10000 + FLASH_HASH_PIPELINE_MIN_CHUNK),
+		MOCK_ARG (&load[FLASH_HASH_PIPELINE_MIN_CHUNK]), MOCK_ARG (16));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG (load), MOCK_ARG (FLASH_HASH_PIPELINE_MIN_CHUNK));
+	status |= mock_expect (&async.mock, async.base.wait_for_read, &async, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_load_and_hash_update (&pipeline, 0x10000, load, sizeof (load),
+		&hash.base);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_async_read_mock_validate_and_release (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+}
+
+CuSuite* get_flash_util_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_sha256);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_sha1);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_unknown);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_multiple_blocks);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_multiple_blocks_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_hash_start_error);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_hash_update_error);
+	SUITE_ADD_TEST (suite, flash_hash_contents_test_hash_finish_error);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256_with_hash_out);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256_no_match_signature);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha256_no_match_signature_with_hash_out);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_sha1);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_unknown);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_small_hash_buffer);
+	SUITE_ADD_TEST (suite, flash_verify_contents_test_read_error_with_hash_out);
+	SUITE_ADD_TEST (suite, flash_erase_region_test);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_offset_start);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_offset_end);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_offset);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_offset_end_aligned);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_no_length);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_not_64k);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_offset_not_64k);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_null);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_block_size_error);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_error);
+	SUITE_ADD_TEST (suite, flash_erase_region_test_multiple_blocks_error);
+	SUITE_ADD_TEST (suite, flash_program_data_test);
+	SUITE_ADD_TEST (suite, flash_program_data_test_offset);
+	SUITE_ADD_TEST (suite, flash_program_data_test_null);
+	SUITE_ADD_TEST (suite, flash_program_data_test_erase_error);
+	SUITE_ADD_TEST (suite, flash_program_data_test_write_error);
+	SUITE_ADD_TEST (suite, flash_program_data_test_incomplete_write);
+	SUITE_ADD_TEST (suite, flash_verify_data_test);
+	SUITE_ADD_TEST (suite, flash_verify_data_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_verify_data_test_multiple_blocks);
+	SUITE_ADD_TEST (suite, flash_verify_data_test_multiple_blocks_mismatch_last_block);
+	SUITE_ADD_TEST (suite, flash_verify_data_test_multiple_blocks_mismatch_middle_block);
+	SUITE_ADD_TEST (suite, flash_verify_data_test_null);
+	SUITE_ADD_TEST (suite, flash_verify_data_test_error);
+	SUITE_ADD_TEST (suite, flash_program_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_program_and_verify_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_program_and_verify_test_null);
+	SUITE_ADD_TEST (suite, flash_program_and_verify_test_error);
+	SUITE_ADD_TEST (suite, flash_program_and_verify_test_verify_error);
+	SUITE_ADD_TEST (suite, flash_blank_check_test);
+	SUITE_ADD_TEST (suite, flash_blank_check_test_not_blank);
+	SUITE_ADD_TEST (suite, flash_blank_check_test_null);
+	SUITE_ADD_TEST (suite, flash_blank_check_test_error);
+	SUITE_ADD_TEST (suite, flash_copy_test);
+	SUITE_ADD_TEST (suite, flash_copy_test_across_erase_blocks);
+	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages);
+	SUITE_ADD_TEST (suite, flash_copy_test_full_block);
+	SUITE_ADD_TEST (suite, flash_copy_test_source_higher_address);
+	SUITE_ADD_TEST (suite, flash_copy_test_source_higher_address_full_block);
+	SUITE_ADD_TEST (suite, flash_copy_test_not_64k);
+	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages_page_not_256);
+	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages_page_offset);
+	SUITE_ADD_TEST (suite, flash_copy_test_null);
+	SUITE_ADD_TEST (suite, flash_copy_test_no_length);
+	SUITE_ADD_TEST (suite, flash_copy_test_block_check_error);
+	SUITE_ADD_TEST (suite, flash_copy_test_not_blank);
+	SUITE_ADD_TEST (suite, flash_copy_test_page_size_error);
+	SUITE_ADD_TEST (suite, flash_copy_test_page_size_unsupported);
+	SUITE_ADD_TEST (suite, flash_copy_test_read_error);
+	SUITE_ADD_TEST (suite, flash_copy_test_write_error);
+	SUITE_ADD_TEST (suite, flash_copy_test_partial_write);
+	SUITE_ADD_TEST (suite, flash_copy_test_multiple_pages_error);
+	SUITE_ADD_TEST (suite, flash_copy_test_overlapping_regions);
+	SUITE_ADD_TEST (suite, flash_copy_test_overlapping_regions_source_higher);
+	SUITE_ADD_TEST (suite, flash_copy_test_same_erase_block);
+	SUITE_ADD_TEST (suite, flash_copy_test_same_erase_block_at_source_end);
+	SUITE_ADD_TEST (suite, flash_copy_test_same_erase_block_at_destination_end);
+	SUITE_ADD_TEST (suite, flash_verify_copy_test);
+	SUITE_ADD_TEST (suite, flash_verify_copy_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_verify_copy_test_multiple_pages);
+	SUITE_ADD_TEST (suite, flash_verify_copy_test_multiple_pages_mismatch);
+	SUITE_ADD_TEST (suite, flash_verify_copy_test_null);
+	SUITE_ADD_TEST (suite, flash_verify_copy_test_read_error);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_multiple_pages_mismatch);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_full_block);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_not_64k);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_multiple_pages_page_not_256);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_multiple_pages_page_offset);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_null);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_block_check_error);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_not_blank);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_page_size_error);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_page_size_unsupported);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_read_error);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_write_error);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_partial_write);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_overlapping_regions);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_overlapping_regions_source_higher);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_same_erase_block);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_same_erase_block_at_source_end);
+	SUITE_ADD_TEST (suite, flash_copy_and_verify_test_same_erase_block_at_destination_end);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_across_erase_blocks);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_full_block);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_source_same_address);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_full_block);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_not_64k);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages_page_not_256);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages_page_offset);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_null);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_no_length);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_block_check_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_not_blank);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_page_size_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_page_size_unsupported);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_read_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_write_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_partial_write);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_multiple_pages_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_overlapping_regions);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_overlapping_regions_source_higher);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_same_erase_block);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_same_erase_block_at_source_end);
+	SUITE_ADD_TEST (suite, flash_copy_ext_test_same_flash_same_erase_block_at_destination_end);
+	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test);
+	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_multiple_pages);
+	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_multiple_pages_mismatch);
+	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_null);
+	SUITE_ADD_TEST (suite, flash_verify_copy_ext_test_read_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_address);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_multiple_pages_mismatch);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_full_block);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_not_64k);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_multiple_pages_page_not_256);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_multiple_pages_page_offset);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_null);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_block_check_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_not_blank);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_page_size_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_page_size_unsupported);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_read_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_write_error);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_partial_write);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_flash_overlapping_regions);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_flash_overlapping_source_higher);
+	SUITE_ADD_TEST (suite, flash_copy_ext_and_verify_test_same_flash_same_erase_block);
+	SUITE_ADD_TEST (suite,
+		flash_copy_ext_and_verify_test_same_flash_same_erase_block_at_source_end);
+	SUITE_ADD_TEST (suite,
+		flash_copy_ext_and_verify_test_same_flash_same_erase_block_at_destination_end);
+	SUITE_ADD_TEST (suite, flash_copy_to_blank_test);
+	SUITE_ADD_TEST (suite, flash_copy_to_blank_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_copy_ext_to_blank_test);
+	SUITE_ADD_TEST (suite, flash_copy_ext_to_blank_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_not_blank);
+	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_null);
+	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_block_check_error);
+	SUITE_ADD_TEST (suite, flash_erase_region_and_verify_test_erase_error);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_sha256);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_sha1);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_unknown);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_blocks);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_regions);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_blocks_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_multiple_regions_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_hash_start_error);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_hash_update_error);
+	SUITE_ADD_TEST (suite, flash_hash_noncontiguous_contents_test_hash_finish_error);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha256);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha256_with_hash_out);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha256_no_match_signature);
+	SUITE_ADD_TEST (suite,
+		flash_verify_noncontiguous_contents_test_sha256_no_match_signature_with_hash_out);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_sha1);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_unknown);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_multiple_regions);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_hash_buffer_too_small);
+	SUITE_ADD_TEST (suite, flash_verify_noncontiguous_contents_test_read_error_with_hash_out);
+	SUITE_ADD_TEST (suite, flash_value_check_test);
+	SUITE_ADD_TEST (suite, flash_value_check_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_value_check_test_null);
+	SUITE_ADD_TEST (suite, flash_value_check_test_error);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_offset_start);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_offset_end);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_offset);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_offset_end_aligned);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_no_length);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_not_4k);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_offset_not_4k);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_null);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_sector_size_error);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_error);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_test_multiple_sectors_error);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_not_blank);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_null);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_sector_check_error);
+	SUITE_ADD_TEST (suite, flash_sector_erase_region_and_verify_test_erase_error);
+	SUITE_ADD_TEST (suite, flash_sector_program_data_test);
+	SUITE_ADD_TEST (suite, flash_sector_program_data_test_offset);
+	SUITE_ADD_TEST (suite, flash_sector_program_data_test_null);
+	SUITE_ADD_TEST (suite, flash_sector_program_data_test_erase_error);
+	SUITE_ADD_TEST (suite, flash_sector_program_data_test_write_error);
+	SUITE_ADD_TEST (suite, flash_sector_program_data_test_incomplete_write);
+	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_null);
+	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_error);
+	SUITE_ADD_TEST (suite, flash_sector_program_and_verify_test_verify_error);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test_across_erase_blocks);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test_multiple_pages);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test_full_sector);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test_source_higher_address);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test_source_higher_address_full_sector);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test_not_4k);
+	SUITE_ADD_TEST (suite, flash_sector_copy_test_multiple_pages_page_not_256);
 	SUITE_ADD_TEST (suite, flash_sector_copy_test_multiple_pages_page_offset);
 	SUITE_ADD_TEST (suite, flash_sector_copy_test_null);
 	SUITE_ADD_TEST (suite, flash_sector_copy_test_no_length);
@@ -15930,6 +17598,63 @@ CuSuite* get_flash_util_suite ()
 		flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small);
 	SUITE_ADD_TEST (suite,
 		flash_noncontiguous_contents_verification_at_offset_test_read_error_with_hash_out);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_test_init);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_test_init_async);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_test_init_null);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_test_init_unsupported_chunk_size);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_test_release_null);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_contents_test);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_contents_test_async);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_noncontiguous_contents_at_offset_test_async);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_noncontiguous_contents_at_offset_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_contents_test_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_contents_test_async_start_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_contents_test_async_wait_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_hash_contents_test_async_hash_update_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_contents_verification_test);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_contents_verification_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_verify_noncontiguous_contents_at_offset_test);
+	SUITE_ADD_TEST (suite,
+		flash_hash_pipeline_verify_noncontiguous_contents_at_offset_test_no_match_signature);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_verify_noncontiguous_contents_at_offset_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_process_contents_test);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_process_contents_test_async);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_process_contents_test_zero_length);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_process_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_process_contents_test_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_process_contents_test_async_handler_error);
+	SUITE_ADD_TEST (suite, flash_copy_stream_test_init);
+	SUITE_ADD_TEST (suite, flash_copy_stream_test_init_null);
+	SUITE_ADD_TEST (suite, flash_copy_stream_test_init_unsupported_chunk_size);
+	SUITE_ADD_TEST (suite, flash_copy_stream_test_release_null);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test_multiple_chunks);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test_null);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_test);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_test_null);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test_mismatch);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test_read_error);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test_write_error);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test_incomplete_write);
+	SUITE_ADD_TEST (suite, flash_copy_stream_copy_ext_to_blank_and_verify_test_verify_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_update_contents_test);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_update_contents_test);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_update_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_update_contents_test_null);
+	SUITE_ADD_TEST (suite, flash_hash_update_contents_test_read_error);
+	SUITE_ADD_TEST (suite, flash_hash_update_contents_test_hash_error);
+	SUITE_ADD_TEST (suite, flash_load_and_hash_update_test);
+	SUITE_ADD_TEST (suite, flash_load_and_hash_update_test_zero_length);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_load_and_hash_update_test);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_load_and_hash_update_test_async);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_load_and_hash_update_test_null);
+	SUITE_ADD_TEST (suite, flash_load_and_hash_update_test_null);
+	SUITE_ADD_TEST (suite, flash_load_and_hash_update_test_read_error);
+	SUITE_ADD_TEST (suite, flash_load_and_hash_update_test_hash_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_load_and_hash_update_test_async_start_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_load_and_hash_update_test_async_wait_error);
+	SUITE_ADD_TEST (suite, flash_hash_pipeline_load_and_hash_update_test_async_hash_error);
 
 	return suite;
 }
@@ -6,15 +6,18 @@
 #include <string.h>
 #include "testing.h"
 #include "rsa_testing.h"
+#include "signature_testing.h"
 #include "host_fw/host_flash_manager.h"
 #include "host_fw/host_state_manager.h"
 #include "flash/flash_common.h"
+#include "common/common_math.h"
 #include "mock/flash_master_mock.h"
 #include "mock/spi_filter_interface_mock.h"
 #include "mock/flash_mfg_filter_handler_mock.h"
 #include "mock/host_control_mock.h"
 #include "mock/pfm_mock.h"
 #include "mock/pfm_manager_mock.h"
+#include "mock/flash_mock.h"
 #include "engines/hash_testing_engine.h"
 #include "engines/rsa_testing_engine.h"
 #include "testing/spi_flash_sfdp_testing.h"
@@ -166,6 +169,44 @@ static void host_flash_manager_testing_initialize_flash_device (CuTest *test,
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Set up expectations for full verification of a flash device that contains a single image at the
+ * start of flash and a read/write region from 0x200 to 0x300.  The flash is read in a single pass.
+ *
+ * @param flash_mock The mock for the flash being verified.
+ * @param img_data The image data at the start of flash.
+ * @param unused_byte The value of unused flash.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int host_flash_manager_testing_expect_full_flash_verification (
+	struct flash_master_mock *flash_mock, const char *img_data, uint8_t unused_byte)
+{
+	uint8_t flash_data[0x1000];
+	uint32_t start[] = {0, 0x300};
+	uint32_t end[] = {0x200, 0x1000};
+	uint32_t addr;
+	size_t read_len;
+	int status = 0;
+	int i;
+
+	memset (flash_data, unused_byte, sizeof (flash_data));
+	memcpy (flash_data, img_data, strlen (img_data));
+
+	for (i = 0; i < 2; i++) {
+		for (addr = start[i]; addr < end[i]; addr += read_len) {
+			read_len = min (end[i] - addr, FLASH_DATA_CHECK_BLOCK);
+
+			status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, &WIP_STATUS, 1,
+				FLASH_EXP_READ_STATUS_REG);
+			status |= flash_master_mock_expect_rx_xfer_ext (flash_mock, 0, &flash_data[addr],
+				read_len, true, FLASH_EXP_READ_CMD (0x03, addr, 0, -1, read_len));
+		}
+	}
+
+	return status;
+}
+
 
 /*******************
  * Test cases
@@ -221,6 +262,8 @@ static void host_flash_manager_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, manager.get_read_write_flash);
 	CuAssertPtrNotNull (test, manager.validate_read_only_flash);
 	CuAssertPtrNotNull (test, manager.validate_read_write_flash);
+	CuAssertPtrNotNull (test, manager.validate_read_write_flash_incremental);
+	CuAssertPtrNotNull (test, manager.validate_read_only_flash_cached);
 	CuAssertPtrNotNull (test, manager.get_flash_read_write_regions);
 	CuAssertPtrNotNull (test, manager.config_spi_filter_flash_type);
 	CuAssertPtrNotNull (test, manager.config_spi_filter_flash_devices);
@@ -385,6 +428,8 @@ static void host_flash_manager_test_init_with_managed_flash_initialization (CuTe
 	CuAssertPtrNotNull (test, manager.get_read_write_flash);
 	CuAssertPtrNotNull (test, manager.validate_read_only_flash);
 	CuAssertPtrNotNull (test, manager.validate_read_write_flash);
+	CuAssertPtrNotNull (test, manager.validate_read_write_flash_incremental);
+	CuAssertPtrNotNull (test, manager.validate_read_only_flash_cached);
 	CuAssertPtrNotNull (test, manager.get_flash_read_write_regions);
 	CuAssertPtrNotNull (test, manager.config_spi_filter_flash_type);
 	CuAssertPtrNotNull (test, manager.config_spi_filter_flash_devices);
@@ -2457,6 +2502,169 @@ static void host_flash_manager_test_validate_read_only_flash_cs0 (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
+static void host_flash_manager_test_validate_read_only_flash_cs0_contiguous_images (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	char *img_data = "TestTest";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region[0].start_addr = 0;
+	img_region[0].length = 4;
+
+	img_region[1].start_addr = 4;
+	img_region[1].length = 4;
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash (&manager, &pfm.base, NULL, &hash.base, &rsa.base,
+		false, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
 static void host_flash_manager_test_validate_read_only_flash_cs1 (CuTest *test)
 {
 	struct flash_master_mock flash_mock0;
@@ -2724,14 +2932,8 @@ static void host_flash_manager_test_validate_read_only_flash_cs0_full_validation
 		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
 	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
-		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock0, 0 + strlen (img_data),
-		0x200 - strlen (img_data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock0, 0x300, 0x1000 - 0x300);
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock0, img_data,
+		0xff);
 
 	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
 		MOCK_ARG_SAVED_ARG (1));
@@ -2885,14 +3087,8 @@ static void host_flash_manager_test_validate_read_only_flash_cs1_full_validation
 		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
 	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) img_data,
-		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0 + strlen (img_data),
-		0x200 - strlen (img_data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0x300, 0x1000 - 0x300);
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock1, img_data,
+		0xff);
 
 	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
 		MOCK_ARG_SAVED_ARG (1));
@@ -3044,14 +3240,8 @@ static void host_flash_manager_test_validate_read_only_flash_full_validation_not
 		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
 	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
-		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
-
-	status |= flash_master_mock_expect_value_check (&flash_mock0, 0 + strlen (img_data),
-		0x200 - strlen (img_data), 0x45);
-	status |= flash_master_mock_expect_value_check (&flash_mock0, 0x300, 0x1000 - 0x300, 0x45);
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock0, img_data,
+		0x45);
 
 	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
 		MOCK_ARG_SAVED_ARG (1));
@@ -3906,14 +4096,8 @@ static void host_flash_manager_test_validate_read_only_flash_good_pfm_full_valid
 		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
 	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
-		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock0, 0 + strlen (img_data),
-		0x200 - strlen (img_data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock0, 0x300, 0x1000 - 0x300);
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock0, img_data,
+		0xff);
 
 	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
 		MOCK_ARG_SAVED_ARG (1));
@@ -5788,14 +5972,8 @@ static void host_flash_manager_test_validate_read_write_flash_cs1 (CuTest *test)
 		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
 	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) img_data,
-		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0 + strlen (img_data),
-		0x200 - strlen (img_data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0x300, 0x1000 - 0x300);
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock1, img_data,
+		0xff);
 
 	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
 		MOCK_ARG_SAVED_ARG (1));
@@ -5949,14 +6127,8 @@ static void host_flash_manager_test_validate_read_write_flash_cs0 (CuTest *test)
 		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
 	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
-		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock0, 0 + strlen (img_data),
-		0x200 - strlen (img_data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock0, 0x300, 0x1000 - 0x300);
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock0, img_data,
+		0xff);
 
 	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
 		MOCK_ARG_SAVED_ARG (1));
@@ -6107,14 +6279,8 @@ static void host_flash_manager_test_validate_read_write_flash_not_blank_byte (Cu
 		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
 	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) img_data,
-		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
-
-	status |= flash_master_mock_expect_value_check (&flash_mock1, 0 + strlen (img_data),
-		0x200 - strlen (img_data), 0xaa);
-	status |= flash_master_mock_expect_value_check (&flash_mock1, 0x300, 0x1000 - 0x300, 0xaa);
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock1, img_data,
+		0xaa);
 
 	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
 		MOCK_ARG_SAVED_ARG (1));
@@ -13054,48 +13220,3464 @@ static void host_flash_manager_test_host_has_flash_access_filter_check_error (Cu
 }
 
 
-CuSuite* get_host_flash_manager_suite ()
+static void host_flash_manager_test_validate_read_write_flash_incremental_no_digests (CuTest *test)
 {
-	CuSuite *suite = CuSuiteNew ();
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
 
-	SUITE_ADD_TEST (suite, host_flash_manager_test_init);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_init_null);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_init_with_managed_flash_initialization);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_init_with_managed_flash_initialization_null);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_release_null);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_only_flash_cs0);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_only_flash_cs1);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_only_flash_null);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_write_flash_cs1);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_write_flash_cs0);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_write_flash_null);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs1);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs0);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_activate_pending_pfm);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_no_data_migration);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_null);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_dirty_clear_error);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_spi_filter_error);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs1_data_copy_error);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs0_data_copy_error);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_activate_pending_pfm_error);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_cs0);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_cs1);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_null);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_error);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs0);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs1);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs0_full_validation);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs1_full_validation);
-	SUITE_ADD_TEST (suite,
-		host_flash_manager_test_validate_read_only_flash_full_validation_not_blank_byte);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs0_good_pfm);
-	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs1_good_pfm);
-	SUITE_ADD_TEST (suite,
-		host_flash_manager_test_validate_read_only_flash_cs0_good_pfm_no_match_image);
-	SUITE_ADD_TEST (suite,
-		host_flash_manager_test_validate_read_only_flash_cs1_good_pfm_no_match_image);
-	SUITE_ADD_TEST (suite,
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memset (digest, 0, sizeof (digest));
+	digests.digest = digest;
+	digests.max_images = 1;
+	digests.count = 0;
+	digests.version = 0;
+	digests.valid = false;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, &dirty, &digests, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, digests.valid);
+	CuAssertIntEquals (test, 1, digests.count);
+	CuAssertIntEquals (test, 0, digests.version);
+
+	status = testing_validate_array (SIG_HASH_TEST, digest[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_cached (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0x500, 0x100);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memcpy (digest[0], SIG_HASH_TEST, SHA256_HASH_LENGTH);
+	digests.digest = digest;
+	digests.max_images = 1;
+	digests.count = 1;
+	digests.version = 0;
+	digests.valid = true;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, &dirty, &digests, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, digests.valid);
+	CuAssertIntEquals (test, 1, digests.count);
+	CuAssertIntEquals (test, 0, digests.version);
+
+	status = testing_validate_array (SIG_HASH_TEST, digest[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_different_version (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memset (digest, 0, sizeof (digest));
+	digests.digest = digest;
+	digests.max_images = 1;
+	digests.count = 1;
+	digests.version = 1;
+	digests.valid = true;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, &dirty, &digests, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, digests.valid);
+	CuAssertIntEquals (test, 1, digests.count);
+	CuAssertIntEquals (test, 0, digests.version);
+
+	status = testing_validate_array (SIG_HASH_TEST, digest[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_different_image_count (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memset (digest, 0, sizeof (digest));
+	digests.digest = digest;
+	digests.max_images = 2;
+	digests.count = 2;
+	digests.version = 0;
+	digests.valid = true;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, &dirty, &digests, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, digests.valid);
+	CuAssertIntEquals (test, 1, digests.count);
+	CuAssertIntEquals (test, 0, digests.version);
+
+	status = testing_validate_array (SIG_HASH_TEST, digest[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_no_dirty_map (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (digest, 0, sizeof (digest));
+	digests.digest = digest;
+	digests.max_images = 1;
+	digests.count = 1;
+	digests.version = 0;
+	digests.valid = true;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, NULL, &digests, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, digests.valid);
+	CuAssertIntEquals (test, 1, digests.count);
+	CuAssertIntEquals (test, 0, digests.version);
+
+	status = testing_validate_array (SIG_HASH_TEST, digest[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_too_many_images (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= host_flash_manager_testing_expect_full_flash_verification (&flash_mock1, img_data,
+		0xff);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memset (digest, 0, sizeof (digest));
+	digests.digest = digest;
+	digests.max_images = 0;
+	digests.count = 0;
+	digests.version = 0;
+	digests.valid = true;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, &dirty, &digests, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, digests.valid);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_verify_error (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_read_write_regions, &pfm, 0,
+		MOCK_ARG (&rw_output));
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memset (digest, 0, sizeof (digest));
+	digests.digest = digest;
+	digests.max_images = 1;
+	digests.count = 1;
+	digests.version = 1;
+	digests.valid = true;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, &dirty, &digests, &rw_output);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, false, digests.valid);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_pfm_version_error (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, PFM_NO_MEMORY,
+		MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memset (digest, 0, sizeof (digest));
+	digests.digest = digest;
+	digests.max_images = 1;
+	digests.count = 1;
+	digests.version = 0;
+	digests.valid = true;
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, &dirty, &digests, &rw_output);
+	CuAssertIntEquals (test, PFM_NO_MEMORY, status);
+	CuAssertIntEquals (test, false, digests.valid);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+
+static void host_flash_manager_test_validate_read_write_flash_incremental_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint8_t digest[1][SHA256_HASH_LENGTH];
+	struct host_fw_image_digests digests;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash0, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	digests.digest = digest;
+	digests.max_images = 1;
+	digests.count = 0;
+	digests.version = 0;
+	digests.valid = false;
+
+	status = manager.validate_read_write_flash_incremental (NULL, &pfm.base, &hash.base,
+		&rsa.base, NULL, &digests, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_write_flash_incremental (&manager, NULL, &hash.base,
+		&rsa.base, NULL, &digests, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, NULL,
+		&rsa.base, NULL, &digests, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		NULL, NULL, &digests, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, NULL, NULL, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_write_flash_incremental (&manager, &pfm.base, &hash.base,
+		&rsa.base, NULL, &digests, NULL);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+/**
+ * Device key used to authenticate the verification cache for testing.
+ */
+static const uint8_t CACHE_KEY_TESTING[] = {
+	0x51,0x52,0x53,0x54,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f,0x60,
+	0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,0x70
+};
+
+/**
+ * Initialize a blank verification cache for testing.
+ *
+ * @param test The testing framework.
+ * @param cache The cache to initialize.
+ * @param cache_flash The mock for the flash that stores the cache.
+ * @param hash The hash engine to use.
+ */
+static void host_flash_manager_testing_init_verification_cache (CuTest *test,
+	struct host_fw_verification_cache *cache, struct flash_mock *cache_flash,
+	struct hash_engine *hash)
+{
+	struct host_fw_verification_cache_record blank;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	memset (&blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cache_flash->mock, cache_flash->base.get_sector_size, cache_flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cache_flash->mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&cache_flash->mock, cache_flash->base.read, cache_flash, 0,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (blank)));
+	status |= mock_expect_output (&cache_flash->mock, 1, &blank, sizeof (blank), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_init (cache, &cache_flash->base, 0x20000, hash,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&cache_flash->mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set up expectations for storing the verification cache contents.
+ *
+ * @param cache The cache that will be stored.
+ * @param cache_flash The mock for the flash that stores the cache.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int host_flash_manager_testing_expect_store_verification_cache (
+	struct host_fw_verification_cache *cache, struct flash_mock *cache_flash)
+{
+	static uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	status = mock_expect (&cache_flash->mock, cache_flash->base.get_sector_size, cache_flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cache_flash->mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&cache_flash->mock, cache_flash->base.sector_erase, cache_flash, 0,
+		MOCK_ARG (0x20000));
+
+	status |= mock_expect (&cache_flash->mock, cache_flash->base.write, cache_flash,
+		sizeof (cache->record), MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (cache->record)));
+
+	/* The record will have been populated by the time it is read back for verification. */
+	status |= flash_mock_expect_data_check (cache_flash, 0x20000, (uint8_t*) &cache->record,
+		sizeof (cache->record));
+
+	return status;
+}
+
+static void host_flash_manager_test_validate_read_only_flash_cached_cs0 (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint32_t pfm_id = 0x10;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+	host_flash_manager_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.base.get_id, &pfm, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= host_flash_manager_testing_expect_store_verification_cache (&cache, &cache_flash);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, &hash.base,
+		&rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, cache.record.count);
+	CuAssertIntEquals (test, SPI_FILTER_CS_0, cache.record.flash_id);
+	CuAssertIntEquals (test, pfm_id, cache.record.pfm_id);
+	CuAssertIntEquals (test, false, cache.modified);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_fw_verification_cache_release (&cache);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_flash_manager_test_validate_read_only_flash_cached_good_pfm_same_images (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_mock pfm_good;
+	struct pfm_read_write_regions rw_output;
+	uint32_t pfm_id = 0x10;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm_good);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+	host_flash_manager_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.base.get_id, &pfm, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= mock_expect (&pfm_good.mock, pfm_good.base.get_firmware_images, &pfm_good, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm_good.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm_good.mock, 1, 1);
+
+	status |= mock_expect (&pfm_good.mock, pfm_good.base.free_firmware_images, &pfm_good, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, &pfm_good.base,
+		&hash.base, &rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, cache.record.count);
+	CuAssertIntEquals (test, false, cache.modified);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm_good);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_fw_verification_cache_release (&cache);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_flash_manager_test_validate_read_only_flash_cached_good_pfm_different_images (
+	CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region img_region_good;
+	struct pfm_image_signature sig_good;
+	struct pfm_image_list img_list_good;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_mock pfm_good;
+	struct pfm_read_write_regions rw_output;
+	uint32_t pfm_id = 0x10;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm_good);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+	host_flash_manager_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	img_region_good.start_addr = 0;
+	img_region_good.length = strlen (img_data);
+
+	sig_good.regions = &img_region_good;
+	sig_good.count = 1;
+	memcpy (&sig_good.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig_good.signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig_good.sig_length = RSA_ENCRYPT_LEN;
+	sig_good.always_validate = 1;
+
+	img_list_good.images = &sig_good;
+	img_list_good.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.base.get_id, &pfm, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= mock_expect (&pfm_good.mock, pfm_good.base.get_firmware_images, &pfm_good, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm_good.mock, 1, &img_list_good, sizeof (img_list_good), -1);
+	status |= mock_expect_save_arg (&pfm_good.mock, 1, 1);
+
+	status |= mock_expect (&pfm_good.mock, pfm_good.base.free_firmware_images, &pfm_good, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= host_flash_manager_testing_expect_store_verification_cache (&cache, &cache_flash);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, &pfm_good.base,
+		&hash.base, &rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, cache.record.count);
+	CuAssertIntEquals (test, SPI_FILTER_CS_0, cache.record.flash_id);
+	CuAssertIntEquals (test, pfm_id, cache.record.pfm_id);
+	CuAssertIntEquals (test, false, cache.modified);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm_good);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_fw_verification_cache_release (&cache);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_flash_manager_test_validate_read_only_flash_cached_cache_hit (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint32_t pfm_id = 0x10;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+	host_flash_manager_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Verify the image to populate the cache. */
+	status = mock_expect (&pfm.mock, pfm.base.base.get_id, &pfm, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= host_flash_manager_testing_expect_store_verification_cache (&cache, &cache_flash);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	/* Verify the image again using the cache.  The image data is not read. */
+	status |= mock_expect (&pfm.mock, pfm.base.base.get_id, &pfm, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 2);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 3);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, &hash.base,
+		&rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, &hash.base,
+		&rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_fw_verification_cache_release (&cache);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_flash_manager_test_validate_read_only_flash_cached_verify_error (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	uint32_t pfm_id = 0x10;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+	host_flash_manager_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash0, 0x1000);
+	status |= spi_flash_set_device_size (&flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.base.get_id, &pfm, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_supported_versions, &pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 0, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 0, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_firmware_images, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&pfm.mock, 1, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 1);
+
+	status |= mock_expect (&pfm.mock, pfm.base.get_read_write_regions, &pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1), MOCK_ARG (&rw_output));
+	status |= mock_expect_output (&pfm.mock, 1, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&pfm.mock, 1, 2);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= mock_expect (&pfm.mock, pfm.base.free_read_write_regions, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&pfm.mock, pfm.base.free_firmware_images, &pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&pfm.mock, pfm.base.free_fw_versions, &pfm, 0, MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, &hash.base,
+		&rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	CuAssertIntEquals (test, 0, cache.record.count);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_fw_verification_cache_release (&cache);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_flash_manager_test_validate_read_only_flash_cached_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct host_fw_verification_cache cache;
+	struct pfm_mock pfm;
+	struct pfm_read_write_regions rw_output;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.validate_read_only_flash_cached (NULL, &pfm.base, NULL, &hash.base,
+		&rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, NULL, NULL, &hash.base,
+		&rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, NULL,
+		&rsa.base, &cache, true, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, &hash.base,
+		NULL, &cache, true, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, &hash.base,
+		&rsa.base, NULL, true, &rw_output);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = manager.validate_read_only_flash_cached (&manager, &pfm.base, NULL, &hash.base,
+		&rsa.base, &cache, true, NULL);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_flash_manager_test_set_copy_streams (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_copy_stream stream0;
+	struct flash_copy_stream stream1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream0, &flash0.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream1, &flash1.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash1));
+
+	status = host_flash_manager_set_copy_streams (&manager, &stream0, &stream1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, &stream0, host_flash_manager_get_copy_stream (&manager, &flash0));
+	CuAssertPtrEquals (test, &stream1, host_flash_manager_get_copy_stream (&manager, &flash1));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash_state));
+
+	status = host_flash_manager_set_copy_streams (&manager, NULL, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash1));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_copy_stream_release (&stream0);
+	flash_copy_stream_release (&stream1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_set_copy_streams_single_device (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_copy_stream stream0;
+	struct flash_copy_stream stream1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream0, &flash0.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream1, &flash1.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_copy_streams (&manager, NULL, &stream1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash0));
+	CuAssertPtrEquals (test, &stream1, host_flash_manager_get_copy_stream (&manager, &flash1));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_copy_stream_release (&stream0);
+	flash_copy_stream_release (&stream1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_set_copy_streams_wrong_flash (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_copy_stream stream0;
+	struct flash_copy_stream stream1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream0, &flash0.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream1, &flash1.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_copy_streams (&manager, &stream1, &stream0);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = host_flash_manager_set_copy_streams (&manager, &stream0, &stream0);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = host_flash_manager_set_copy_streams (&manager, &stream1, &stream1);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, &flash1));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_copy_stream_release (&stream0);
+	flash_copy_stream_release (&stream1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_set_copy_streams_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_copy_stream stream0;
+	struct flash_copy_stream stream1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream0, &flash0.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream1, &flash1.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_copy_streams (NULL, &stream0, &stream1);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_copy_stream_release (&stream0);
+	flash_copy_stream_release (&stream1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_get_copy_stream_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_copy_stream stream0;
+	struct flash_copy_stream stream1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream0, &flash0.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream1, &flash1.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_copy_streams (&manager, &stream0, &stream1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (NULL, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_copy_stream (&manager, NULL));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_copy_stream_release (&stream0);
+	flash_copy_stream_release (&stream1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_set_hash_pipelines (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_hash_pipeline pipeline0;
+	struct flash_hash_pipeline pipeline1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline0, &flash0.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline1, &flash1.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash1));
+
+	status = host_flash_manager_set_hash_pipelines (&manager, &pipeline0, &pipeline1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, &pipeline0, host_flash_manager_get_hash_pipeline (&manager, &flash0));
+	CuAssertPtrEquals (test, &pipeline1, host_flash_manager_get_hash_pipeline (&manager, &flash1));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash_state));
+
+	status = host_flash_manager_set_hash_pipelines (&manager, NULL, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash1));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_hash_pipeline_release (&pipeline0);
+	flash_hash_pipeline_release (&pipeline1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_set_hash_pipelines_single_device (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_hash_pipeline pipeline0;
+	struct flash_hash_pipeline pipeline1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline0, &flash0.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline1, &flash1.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_hash_pipelines (&manager, NULL, &pipeline1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash0));
+	CuAssertPtrEquals (test, &pipeline1, host_flash_manager_get_hash_pipeline (&manager, &flash1));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_hash_pipeline_release (&pipeline0);
+	flash_hash_pipeline_release (&pipeline1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_set_hash_pipelines_wrong_flash (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_hash_pipeline pipeline0;
+	struct flash_hash_pipeline pipeline1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline0, &flash0.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline1, &flash1.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_hash_pipelines (&manager, &pipeline1, &pipeline0);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = host_flash_manager_set_hash_pipelines (&manager, &pipeline0, &pipeline0);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = host_flash_manager_set_hash_pipelines (&manager, &pipeline1, &pipeline1);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, &flash1));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_hash_pipeline_release (&pipeline0);
+	flash_hash_pipeline_release (&pipeline1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_set_hash_pipelines_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_hash_pipeline pipeline0;
+	struct flash_hash_pipeline pipeline1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline0, &flash0.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline1, &flash1.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_hash_pipelines (NULL, &pipeline0, &pipeline1);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_hash_pipeline_release (&pipeline0);
+	flash_hash_pipeline_release (&pipeline1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+static void host_flash_manager_test_get_hash_pipeline_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock0;
+	struct flash_master_mock flash_mock1;
+	struct flash_master_mock flash_mock_state;
+	struct spi_flash flash0;
+	struct spi_flash flash1;
+	struct spi_flash flash_state;
+	struct state_manager host_state;
+	struct spi_filter_interface_mock filter;
+	struct flash_mfg_filter_handler_mock handler;
+	struct host_flash_manager manager;
+	struct flash_hash_pipeline pipeline0;
+	struct flash_hash_pipeline pipeline1;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash0, &flash_mock0.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_init (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline0, &flash0.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline1, &flash1.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_testing_init_host_state (test, &host_state, &flash_mock_state, &flash_state);
+
+	status = host_flash_manager_init (&manager, &flash0, &flash1, &host_state, &filter.base,
+		&handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_set_hash_pipelines (&manager, &pipeline0, &pipeline1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (NULL, &flash0));
+	CuAssertPtrEquals (test, NULL, host_flash_manager_get_hash_pipeline (&manager, NULL));
+
+	status = flash_master_mock_validate_and_release (&flash_mock0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock_state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mfg_filter_handler_mock_validate_and_release (&handler);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_manager_release (&manager);
+
+	flash_hash_pipeline_release (&pipeline0);
+	flash_hash_pipeline_release (&pipeline1);
+	host_state_manager_release (&host_state);
+	spi_flash_release (&flash0);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash_state);
+}
+
+
+CuSuite* get_host_flash_manager_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, host_flash_manager_test_init);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_init_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_init_with_managed_flash_initialization);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_init_with_managed_flash_initialization_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_release_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_only_flash_cs0);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_only_flash_cs1);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_only_flash_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_write_flash_cs1);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_write_flash_cs0);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_read_write_flash_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs1);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs0);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_activate_pending_pfm);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_no_data_migration);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_dirty_clear_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_spi_filter_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs1_data_copy_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_cs0_data_copy_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_swap_flash_devices_activate_pending_pfm_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_cs0);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_cs1);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_config_spi_filter_flash_devices_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs0);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs0_contiguous_images);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs1);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs0_full_validation);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs1_full_validation);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_only_flash_full_validation_not_blank_byte);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs0_good_pfm);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cs1_good_pfm);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_only_flash_cs0_good_pfm_no_match_image);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_only_flash_cs1_good_pfm_no_match_image);
+	SUITE_ADD_TEST (suite,
 		host_flash_manager_test_validate_read_only_flash_good_pfm_full_validation);
 	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_null);
 	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_pfm_version_error);
@@ -13192,6 +16774,40 @@ CuSuite* get_host_flash_manager_suite ()
 	SUITE_ADD_TEST (suite, host_flash_manager_test_host_has_flash_access_null);
 	SUITE_ADD_TEST (suite, host_flash_manager_test_host_has_flash_access_access_check_error);
 	SUITE_ADD_TEST (suite, host_flash_manager_test_host_has_flash_access_filter_check_error);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_write_flash_incremental_no_digests);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_write_flash_incremental_cached);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_write_flash_incremental_different_version);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_write_flash_incremental_different_image_count);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_write_flash_incremental_no_dirty_map);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_write_flash_incremental_too_many_images);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_write_flash_incremental_verify_error);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_write_flash_incremental_pfm_version_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_write_flash_incremental_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cached_cs0);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cached_cache_hit);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_only_flash_cached_good_pfm_same_images);
+	SUITE_ADD_TEST (suite,
+		host_flash_manager_test_validate_read_only_flash_cached_good_pfm_different_images);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cached_verify_error);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_validate_read_only_flash_cached_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_copy_streams);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_copy_streams_single_device);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_copy_streams_wrong_flash);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_copy_streams_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_copy_stream_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_hash_pipelines);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_hash_pipelines_single_device);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_hash_pipelines_wrong_flash);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_set_hash_pipelines_null);
+	SUITE_ADD_TEST (suite, host_flash_manager_test_get_hash_pipeline_null);
 
 	return suite;
 }
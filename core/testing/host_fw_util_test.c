@@ -8,9 +8,14 @@
 #include "host_fw/host_fw_util.h"
 #include "mock/flash_master_mock.h"
 #include "mock/spi_filter_interface_mock.h"
+#include "mock/hash_mock.h"
+#include "mock/flash_mock.h"
+#include "flash/flash_common.h"
+#include "common/common_math.h"
 #include "engines/hash_testing_engine.h"
 #include "engines/rsa_testing_engine.h"
 #include "rsa_testing.h"
+#include "signature_testing.h"
 
 
 static const char *SUITE = "host_fw_util";
@@ -1276,7 +1281,7 @@ static void host_fw_verify_images_test (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_images (&flash, &list, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -1336,7 +1341,7 @@ static void host_fw_verify_images_test_invalid (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_images (&flash, &list, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -1417,7 +1422,7 @@ static void host_fw_verify_images_test_not_contiguous (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_images (&flash, &list, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -1507,7 +1512,7 @@ static void host_fw_verify_images_test_multiple (CuTest *test)
 	list.images = sig;
 	list.count = 3;
 
-	status = host_fw_verify_images (&flash, &list, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -1592,7 +1597,7 @@ static void host_fw_verify_images_test_multiple_one_invalid (CuTest *test)
 	list.images = sig;
 	list.count = 3;
 
-	status = host_fw_verify_images (&flash, &list, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -1603,99 +1608,68 @@ static void host_fw_verify_images_test_multiple_one_invalid (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_test_partial_validation (CuTest *test)
+/**
+ * Device key used to authenticate the verification cache for testing.
+ */
+static const uint8_t CACHE_KEY_TESTING[] = {
+	0x51,0x52,0x53,0x54,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f,0x60,
+	0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,0x70
+};
+
+/**
+ * Initialize a blank verification cache for testing.
+ *
+ * @param test The testing framework.
+ * @param cache The cache to initialize.
+ * @param cache_flash The mock for the flash that stores the cache.
+ * @param hash The hash engine to use.
+ */
+static void host_fw_util_testing_init_verification_cache (CuTest *test,
+	struct host_fw_verification_cache *cache, struct flash_mock *cache_flash,
+	struct hash_engine *hash)
 {
-	struct flash_region region[3];
-	struct pfm_image_signature sig[3];
-	struct pfm_image_list list;
-	struct flash_master_mock flash_mock;
-	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct host_fw_verification_cache_record blank;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
-	char *data3 = "Nope";
-
-	TEST_START;
-
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &flash_mock.base);
-	CuAssertIntEquals (test, 0, status);
+	memset (&blank, 0xff, sizeof (blank));
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
+	status = flash_mock_init (cache_flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data1)));
+	status = mock_expect (&cache_flash->mock, cache_flash->base.get_sector_size, cache_flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cache_flash->mock, 0, &bytes, sizeof (bytes), -1);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, strlen (data3)));
+	status |= mock_expect (&cache_flash->mock, cache_flash->base.read, cache_flash, 0,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (blank)));
+	status |= mock_expect_output (&cache_flash->mock, 1, &blank, sizeof (blank), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	region[0].start_addr = 0x10000;
-	region[0].length = strlen (data1);
-	region[1].start_addr = 0x20000;
-	region[1].length = strlen (data2);
-	region[2].start_addr = 0x30000;
-	region[2].length = strlen (data3);
-
-	sig[0].regions = &region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
-
-	sig[1].regions = &region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 0;
-
-	sig[2].regions = &region[2];
-	sig[2].count = 1;
-	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
-	sig[2].sig_length = RSA_ENCRYPT_LEN;
-	sig[2].always_validate = 1;
-
-	list.images = sig;
-	list.count = 3;
-
-	status = host_fw_verify_images (&flash, &list, &hash.base, &rsa.base);
+	status = host_fw_verification_cache_init (cache, &cache_flash->base, 0x20000, hash,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock);
+	status = mock_validate (&cache_flash->mock);
 	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_test_no_images (CuTest *test)
+static void host_fw_verify_images_cached_test (CuTest *test)
 {
+	struct flash_region region;
+	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
+	uint8_t image_id[SHA256_HASH_LENGTH];
+	uint8_t digest[SHA256_HASH_LENGTH];
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
@@ -1714,27 +1688,63 @@ static void host_fw_verify_images_test_no_images (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	list.images = NULL;
-	list.count = 0;
+	host_fw_util_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images = &sig;
+	list.count = 1;
+
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, true, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The verified image digest has been added to the cache. */
+	CuAssertIntEquals (test, 1, cache.record.count);
+	memcpy (image_id, cache.record.entry[0].image_id, sizeof (image_id));
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, image_id, digest);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_verify_images (&flash, &list, &hash.base, &rsa.base);
+	status = testing_validate_array (SIG_HASH_TEST, digest, sizeof (digest));
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_test_null (CuTest *test)
+static void host_fw_verify_images_cached_test_cache_hit (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
@@ -1757,6 +1767,15 @@ static void host_fw_verify_images_test_null (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_util_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
 	region.start_addr = 0x10000;
 	region.length = strlen (data);
 
@@ -1770,33 +1789,42 @@ static void host_fw_verify_images_test_null (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_images (NULL, &list, &hash.base, &rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, true, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_verify_images (&flash, NULL, &hash.base, &rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_verify_images (&flash, &list, NULL, &rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_verify_images (&flash, &list, &hash.base, NULL);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	/* No flash accesses are necessary to verify the image from the cache. */
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, true, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test (CuTest *test)
+static void host_fw_verify_images_cached_test_cache_not_trusted (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
@@ -1819,10 +1847,17 @@ static void host_fw_verify_offset_images_test (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_util_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -1839,24 +1874,35 @@ static void host_fw_verify_offset_images_test (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, &hash.base, &rsa.base);
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, false, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, false, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test_no_offset (CuTest *test)
+static void host_fw_verify_images_cached_test_different_pfm (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
@@ -1879,11 +1925,18 @@ static void host_fw_verify_offset_images_test_no_offset (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_util_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
 	CuAssertIntEquals (test, 0, status);
 
 	region.start_addr = 0x10000;
@@ -1899,24 +1952,38 @@ static void host_fw_verify_offset_images_test_no_offset (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_offset_images (&flash, &list, 0, &hash.base, &rsa.base);
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, true, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x11, true, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
+	CuAssertIntEquals (test, 1, cache.record.count);
+	CuAssertIntEquals (test, 0x11, cache.record.pfm_id);
+
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test_invalid (CuTest *test)
+static void host_fw_verify_images_cached_test_invalid (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_mock cache_flash;
+	struct host_fw_verification_cache cache;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
@@ -1939,10 +2006,12 @@ static void host_fw_verify_offset_images_test_invalid (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_util_testing_init_verification_cache (test, &cache, &cache_flash, &hash.base);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x310000, 0, -1, strlen (data)));
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -1959,99 +2028,57 @@ static void host_fw_verify_offset_images_test_invalid (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x300000, &hash.base, &rsa.base);
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, true, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
+	CuAssertIntEquals (test, 0, cache.record.count);
+
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&cache_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test_not_contiguous (CuTest *test)
+static void host_fw_verify_images_cached_test_null (CuTest *test)
 {
-	struct flash_region region[4];
-	struct pfm_image_signature sig;
 	struct pfm_image_list list;
-	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct host_fw_verification_cache cache;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &flash_mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 1, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 2, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 3, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x440000, 0, -1, 1));
-
-	CuAssertIntEquals (test, 0, status);
-
-	region[0].start_addr = 0x10000;
-	region[0].length = 1;
-	region[1].start_addr = 0x20000;
-	region[1].length = 1;
-	region[2].start_addr = 0x30000;
-	region[2].length = 1;
-	region[3].start_addr = 0x40000;
-	region[3].length = 1;
-
-	sig.regions = region;
-	sig.count = 4;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	status = host_fw_verify_images_cached (NULL, &list, &cache, 1, 0x10, true, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	list.images = &sig;
-	list.count = 1;
+	status = host_fw_verify_images_cached (&flash, NULL, &cache, 1, 0x10, true, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, &hash.base, &rsa.base);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_images_cached (&flash, &list, NULL, 1, 0x10, true, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, true, NULL,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
+	status = host_fw_verify_images_cached (&flash, &list, &cache, 1, 0x10, true, &hash.base,
+		NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 }
 
-static void host_fw_verify_offset_images_test_multiple (CuTest *test)
+static void host_fw_verify_images_test_partial_validation (CuTest *test)
 {
 	struct flash_region region[3];
 	struct pfm_image_signature sig[3];
@@ -2085,17 +2112,12 @@ static void host_fw_verify_offset_images_test_multiple (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data1)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
+		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, strlen (data3)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -2118,7 +2140,7 @@ static void host_fw_verify_offset_images_test_multiple (CuTest *test)
 	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
 	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
+	sig[1].always_validate = 0;
 
 	sig[2].regions = &region[2];
 	sig[2].count = 1;
@@ -2130,7 +2152,7 @@ static void host_fw_verify_offset_images_test_multiple (CuTest *test)
 	list.images = sig;
 	list.count = 3;
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -2141,19 +2163,14 @@ static void host_fw_verify_offset_images_test_multiple (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test_multiple_one_invalid (CuTest *test)
+static void host_fw_verify_images_test_no_images (CuTest *test)
 {
-	struct flash_region region[3];
-	struct pfm_image_signature sig[3];
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
-	char *data3 = "Nope";
 
 	TEST_START;
 
@@ -2172,52 +2189,12 @@ static void host_fw_verify_offset_images_test_multiple_one_invalid (CuTest *test
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
+	list.images = NULL;
+	list.count = 0;
 
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	region[0].start_addr = 0x10000;
-	region[0].length = strlen (data1);
-	region[1].start_addr = 0x20000;
-	region[1].length = strlen (data2);
-	region[2].start_addr = 0x30000;
-	region[2].length = strlen (data3);
-
-	sig[0].regions = &region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
-
-	sig[1].regions = &region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
-
-	sig[2].regions = &region[2];
-	sig[2].count = 1;
-	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
-	sig[2].sig_length = RSA_ENCRYPT_LEN;
-	sig[2].always_validate = 1;
-
-	list.images = sig;
-	list.count = 3;
-
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, &hash.base, &rsa.base);
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
-
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
@@ -2226,19 +2203,18 @@ static void host_fw_verify_offset_images_test_multiple_one_invalid (CuTest *test
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test_partial_validation (CuTest *test)
+static void host_fw_verify_images_test_hash_pipeline (CuTest *test)
 {
-	struct flash_region region[3];
-	struct pfm_image_signature sig[3];
+	struct flash_region region;
+	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_hash_pipeline pipeline;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
-	char *data3 = "Nope";
+	char *data = "Test";
 
 	TEST_START;
 
@@ -2254,68 +2230,54 @@ static void host_fw_verify_offset_images_test_partial_validation (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	region[0].start_addr = 0x10000;
-	region[0].length = strlen (data1);
-	region[1].start_addr = 0x20000;
-	region[1].length = strlen (data2);
-	region[2].start_addr = 0x30000;
-	region[2].length = strlen (data3);
-
-	sig[0].regions = &region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
-
-	sig[1].regions = &region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 0;
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	sig[2].regions = &region[2];
-	sig[2].count = 1;
-	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
-	sig[2].sig_length = RSA_ENCRYPT_LEN;
-	sig[2].always_validate = 1;
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	list.images = sig;
-	list.count = 3;
+	list.images = &sig;
+	list.count = 1;
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, &pipeline, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	flash_hash_pipeline_release (&pipeline);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test_no_images (CuTest *test)
+static void host_fw_verify_images_test_hash_pipeline_wrong_flash (CuTest *test)
 {
+	struct flash_region region;
+	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_mock other;
+	struct flash_hash_pipeline pipeline;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
@@ -2334,24 +2296,42 @@ static void host_fw_verify_offset_images_test_no_images (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
+	status = flash_mock_init (&other);
 	CuAssertIntEquals (test, 0, status);
 
-	list.images = NULL;
-	list.count = 0;
+	status = flash_hash_pipeline_init (&pipeline, &other.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = 4;
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, &hash.base, &rsa.base);
+	list.images = &sig;
+	list.count = 1;
+
+	status = host_fw_verify_images (&flash, &pipeline, &list, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&other);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	flash_hash_pipeline_release (&pipeline);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_test_null (CuTest *test)
+static void host_fw_verify_images_test_null (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
@@ -2393,16 +2373,16 @@ static void host_fw_verify_offset_images_test_null (CuTest *test)
 	list.images = &sig;
 	list.count = 1;
 
-	status = host_fw_verify_offset_images (NULL, &list, 0x400000, &hash.base, &rsa.base);
+	status = host_fw_verify_images (NULL, NULL, &list, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images (&flash, NULL, 0x400000, &hash.base, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, NULL, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, NULL, &rsa.base);
+	status = host_fw_verify_images (&flash, NULL, &list, NULL, &rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images (&flash, &list, 0x400000, &hash.base, NULL);
+	status = host_fw_verify_images (&flash, NULL, &list, &hash.base, NULL);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -2413,13 +2393,11 @@ static void host_fw_verify_offset_images_test_null (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test (CuTest *test)
+static void host_fw_verify_offset_images_test (CuTest *test)
 {
-	struct flash_region img_region;
+	struct flash_region region;
 	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
@@ -2441,41 +2419,30 @@ static void host_fw_full_flash_verification_test (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
-		0x200 - strlen (data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	sig.regions = &img_region;
+	sig.regions = &region;
 	sig.count = 1;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
-
-	rw_region.start_addr = 0x200;
-	rw_region.length = 0x100;
-
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
-
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	list.images = &sig;
+	list.count = 1;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -2486,13 +2453,11 @@ static void host_fw_full_flash_verification_test (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_not_blank_byte (CuTest *test)
+static void host_fw_verify_offset_images_test_no_offset (CuTest *test)
 {
-	struct flash_region img_region;
+	struct flash_region region;
 	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
@@ -2514,41 +2479,30 @@ static void host_fw_full_flash_verification_test_not_blank_byte (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
-
-	status |= flash_master_mock_expect_value_check (&flash_mock, 0 + strlen (data),
-		0x200 - strlen (data), 0x55);
-	status |= flash_master_mock_expect_value_check (&flash_mock, 0x300, 0x1000 - 0x300, 0x55);
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	sig.regions = &img_region;
+	sig.regions = &region;
 	sig.count = 1;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
-
-	rw_region.start_addr = 0x200;
-	rw_region.length = 0x100;
-
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
-
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	list.images = &sig;
+	list.count = 1;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0x55, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -2559,13 +2513,11 @@ static void host_fw_full_flash_verification_test_not_blank_byte (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_multiple_rw_regions (CuTest *test)
+static void host_fw_verify_offset_images_test_invalid (CuTest *test)
 {
-	struct flash_region img_region;
+	struct flash_region region;
 	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
@@ -2587,45 +2539,31 @@ static void host_fw_full_flash_verification_test_multiple_rw_regions (CuTest *te
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
-		0x200 - strlen (data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x300);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x700, 0x1000 - 0x700);
+		FLASH_EXP_READ_CMD (0x03, 0x310000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	sig.regions = &img_region;
+	sig.regions = &region;
 	sig.count = 1;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
-
-	rw_region[0].start_addr = 0x200;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0x600;
-	rw_region[1].length = 0x100;
-
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
-
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	list.images = &sig;
+	list.count = 1;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x300000, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
@@ -2635,13 +2573,11 @@ static void host_fw_full_flash_verification_test_multiple_rw_regions (CuTest *te
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_image_between_rw_regions (CuTest *test)
+static void host_fw_verify_offset_images_test_not_contiguous (CuTest *test)
 {
-	struct flash_region img_region;
+	struct flash_region region[4];
 	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
@@ -2663,44 +2599,51 @@ static void host_fw_full_flash_verification_test_image_between_rw_regions (CuTes
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x900, 0, -1, strlen (data)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
 
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0, 0x800);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900 + strlen (data),
-		0xb00 - (0x900 + strlen (data)));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xc00, 0x1000 - 0xc00);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 1, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 2, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 3, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x440000, 0, -1, 1));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region.start_addr = 0x900;
-	img_region.length = strlen (data);
+	region[0].start_addr = 0x10000;
+	region[0].length = 1;
+	region[1].start_addr = 0x20000;
+	region[1].length = 1;
+	region[2].start_addr = 0x30000;
+	region[2].length = 1;
+	region[3].start_addr = 0x40000;
+	region[3].length = 1;
 
-	sig.regions = &img_region;
-	sig.count = 1;
+	sig.regions = region;
+	sig.count = 4;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
-
-	rw_region[0].start_addr = 0x800;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xb00;
-	rw_region[1].length = 0x100;
-
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
-
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	list.images = &sig;
+	list.count = 1;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -2711,13 +2654,11 @@ static void host_fw_full_flash_verification_test_image_between_rw_regions (CuTes
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_multiple_images (CuTest *test)
+static void host_fw_verify_offset_images_test_multiple (CuTest *test)
 {
-	struct flash_region img_region[2];
-	struct pfm_image_signature sig[2];
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
@@ -2725,6 +2666,7 @@ static void host_fw_full_flash_verification_test_multiple_images (CuTest *test)
 	int status;
 	char *data1 = "Test";
 	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
@@ -2740,59 +2682,58 @@ static void host_fw_full_flash_verification_test_multiple_images (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data1)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x900, 0, -1, strlen (data2)));
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data1),
-		0x800 - strlen (data1));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900 + strlen (data2),
-		0xc00 - (0x900 + strlen (data2)));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xd00, 0x1000 - 0xd00);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0x900;
-	img_region[1].length = strlen (data2);
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
 
-	sig[0].regions = &img_region[0];
+	sig[0].regions = &region[0];
 	sig[0].count = 1;
 	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig[0].sig_length = RSA_ENCRYPT_LEN;
 	sig[0].always_validate = 1;
 
-	sig[1].regions = &img_region[1];
+	sig[1].regions = &region[1];
 	sig[1].count = 1;
 	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
 	sig[1].sig_length = RSA_ENCRYPT_LEN;
 	sig[1].always_validate = 1;
 
-	img_list.images = sig;
-	img_list.count = 2;
-
-	rw_region[0].start_addr = 0x800;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xc00;
-	rw_region[1].length = 0x100;
-
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
+	sig[2].regions = &region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	list.images = sig;
+	list.count = 3;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -2803,13 +2744,11 @@ static void host_fw_full_flash_verification_test_multiple_images (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_offset_image (CuTest *test)
+static void host_fw_verify_offset_images_test_multiple_one_invalid (CuTest *test)
 {
-	struct flash_region img_region[2];
-	struct pfm_image_signature sig[2];
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
@@ -2817,6 +2756,7 @@ static void host_fw_full_flash_verification_test_offset_image (CuTest *test)
 	int status;
 	char *data1 = "Test";
 	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
@@ -2832,61 +2772,54 @@ static void host_fw_full_flash_verification_test_offset_image (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data1)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0xb00, 0, -1, strlen (data2)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data1),
-		0x800 - strlen (data1));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900, 0xb00 - 0x900);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xb00 + strlen (data2),
-		0xd00 - (0xb00 + strlen (data2)));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xe00, 0x1000 - 0xe00);
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0xb00;
-	img_region[1].length = strlen (data2);
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
 
-	sig[0].regions = &img_region[0];
+	sig[0].regions = &region[0];
 	sig[0].count = 1;
 	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig[0].sig_length = RSA_ENCRYPT_LEN;
 	sig[0].always_validate = 1;
 
-	sig[1].regions = &img_region[1];
+	sig[1].regions = &region[1];
 	sig[1].count = 1;
 	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&sig[1].signature, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN);
 	sig[1].sig_length = RSA_ENCRYPT_LEN;
 	sig[1].always_validate = 1;
 
-	img_list.images = sig;
-	img_list.count = 2;
-
-	rw_region[0].start_addr = 0x800;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xd00;
-	rw_region[1].length = 0x100;
-
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
+	sig[2].regions = &region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	list.images = sig;
+	list.count = 3;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
@@ -2896,13 +2829,11 @@ static void host_fw_full_flash_verification_test_offset_image (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_first_region_rw (CuTest *test)
+static void host_fw_verify_offset_images_test_partial_validation (CuTest *test)
 {
-	struct flash_region img_region[2];
-	struct pfm_image_signature sig[2];
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
@@ -2910,6 +2841,7 @@ static void host_fw_full_flash_verification_test_first_region_rw (CuTest *test)
 	int status;
 	char *data1 = "Test";
 	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
@@ -2925,60 +2857,53 @@ static void host_fw_full_flash_verification_test_first_region_rw (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, strlen (data1)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x100, 0x200);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300 + strlen (data1),
-		0xa00 - (0x300 + strlen (data1)));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
-		0xc00 - (0xa00 + strlen (data2)));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xd00, 0x1000 - 0xd00);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0x300;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0xa00;
-	img_region[1].length = strlen (data2);
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
 
-	sig[0].regions = &img_region[0];
+	sig[0].regions = &region[0];
 	sig[0].count = 1;
 	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig[0].sig_length = RSA_ENCRYPT_LEN;
 	sig[0].always_validate = 1;
 
-	sig[1].regions = &img_region[1];
+	sig[1].regions = &region[1];
 	sig[1].count = 1;
 	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
 	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
-
-	img_list.images = sig;
-	img_list.count = 2;
-
-	rw_region[0].start_addr = 0;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xc00;
-	rw_region[1].length = 0x100;
+	sig[1].always_validate = 0;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
+	sig[2].regions = &region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	list.images = sig;
+	list.count = 3;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -2989,20 +2914,14 @@ static void host_fw_full_flash_verification_test_first_region_rw (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_last_region_rw (CuTest *test)
+static void host_fw_verify_offset_images_test_no_images (CuTest *test)
 {
-	struct flash_region img_region[2];
-	struct pfm_image_signature sig[2];
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
 
 	TEST_START;
 
@@ -3018,83 +2937,34 @@ static void host_fw_full_flash_verification_test_last_region_rw (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data1)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data1),
-		0x200 - strlen (data1));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0xa00 - 0x300);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
-		0xf00 - (0xa00 + strlen (data2)));
+	list.images = NULL;
+	list.count = 0;
 
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0xa00;
-	img_region[1].length = strlen (data2);
-
-	sig[0].regions = &img_region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	sig[1].regions = &img_region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
 
-	img_list.images = sig;
-	img_list.count = 2;
-
-	rw_region[0].start_addr = 0x200;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xf00;
-	rw_region[1].length = 0x100;
-
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
-
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_validate_and_release (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
-}
-
-static void host_fw_full_flash_verification_test_multipart_image (CuTest *test)
+static void host_fw_verify_offset_images_test_null (CuTest *test)
 {
-	struct flash_region img_region[4];
-	struct pfm_image_signature sig[2];
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
+	char *data = "Test";
 
 	TEST_START;
 
@@ -3110,75 +2980,33 @@ static void host_fw_full_flash_verification_test_multipart_image (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, 1));
-
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 1, 3,
-		FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, 2));
-
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 3, 1,
-		FLASH_EXP_READ_CMD (0x03, 0xe00, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x001, 0x1ff);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300 + 2, 0xa00 - 0x302);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
-		0xc00 - (0xa00 + strlen (data2)));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xd00, 0x100);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xe01, 0x1000 - 0xe01);
-
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = 1;
-	img_region[1].start_addr = 0x300;
-	img_region[1].length = 2;
-	img_region[2].start_addr = 0xe00;
-	img_region[2].length = 1;
-	img_region[3].start_addr = 0xa00;
-	img_region[3].length = strlen (data2);
-
-	sig[0].regions = &img_region[0];
-	sig[0].count = 3;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	sig[1].regions = &img_region[3];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	img_list.images = sig;
-	img_list.count = 2;
+	list.images = &sig;
+	list.count = 1;
 
-	rw_region[0].start_addr = 0x200;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xc00;
-	rw_region[1].length = 0x100;
+	status = host_fw_verify_offset_images (NULL, NULL, &list, 0x400000, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
+	status = host_fw_verify_offset_images (&flash, NULL, NULL, 0x400000, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, NULL, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_offset_images (&flash, NULL, &list, 0x400000, &hash.base, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
@@ -3188,20 +3016,18 @@ static void host_fw_full_flash_verification_test_multipart_image (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_partial_validation (CuTest *test)
+static void host_fw_verify_images_batch_test (CuTest *test)
 {
-	struct flash_region img_region[2];
-	struct pfm_image_signature sig[2];
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
+	char *data = "Test";
 
 	TEST_START;
 
@@ -3217,59 +3043,32 @@ static void host_fw_full_flash_verification_test_partial_validation (CuTest *tes
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data1)));
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x900, 0, -1, strlen (data2)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data1),
-		0x800 - strlen (data1));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900 + strlen (data2),
-		0xc00 - (0x900 + strlen (data2)));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xd00, 0x1000 - 0xd00);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0x900;
-	img_region[1].length = strlen (data2);
-
-	sig[0].regions = &img_region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
-
-	sig[1].regions = &img_region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 0;
-
-	img_list.images = sig;
-	img_list.count = 2;
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	rw_region[0].start_addr = 0x800;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xc00;
-	rw_region[1].length = 0x100;
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
+	list.images = &sig;
+	list.count = 1;
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	engines[0] = &hash.base;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_images_batch (&flash, NULL, &list, engines, 1, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -3280,20 +3079,18 @@ static void host_fw_full_flash_verification_test_partial_validation (CuTest *tes
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_invalid_image (CuTest *test)
+static void host_fw_verify_images_batch_test_invalid (CuTest *test)
 {
-	struct flash_region img_region[2];
-	struct pfm_image_signature sig[2];
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[2];
-	struct pfm_read_write_regions rw_list;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
+	char *data = "Test";
 
 	TEST_START;
 
@@ -3309,48 +3106,32 @@ static void host_fw_full_flash_verification_test_invalid_image (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data1)));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0x900;
-	img_region[1].length = strlen (data2);
-
-	sig[0].regions = &img_region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
-
-	sig[1].regions = &img_region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
-
-	img_list.images = sig;
-	img_list.count = 2;
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	rw_region[0].start_addr = 0x800;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0xc00;
-	rw_region[1].length = 0x100;
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 2;
+	list.images = &sig;
+	list.count = 1;
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	engines[0] = &hash.base;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
+	status = host_fw_verify_images_batch (&flash, NULL, &list, engines, 1, &rsa.base);
 	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -3361,16 +3142,16 @@ static void host_fw_full_flash_verification_test_invalid_image (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_not_blank (CuTest *test)
+static void host_fw_verify_images_batch_test_hash_pipeline (CuTest *test)
 {
-	struct flash_region img_region;
+	struct flash_region region;
 	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
+	struct flash_hash_pipeline pipeline;
 	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
 	RSA_TESTING_ENGINE rsa;
 	int status;
 	char *data = "Test";
@@ -3389,62 +3170,56 @@ static void host_fw_full_flash_verification_test_not_blank (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN,
-		FLASH_EXP_READ_CMD (0x03, 0 + strlen (data), 0, -1, FLASH_VERIFICATION_BLOCK));
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	sig.regions = &img_region;
+	sig.regions = &region;
 	sig.count = 1;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
-
-	rw_region.start_addr = 0x200;
-	rw_region.length = 0x100;
+	list.images = &sig;
+	list.count = 1;
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	engines[0] = &hash.base;
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
+	status = host_fw_verify_images_batch (&flash, &pipeline, &list, engines, 1, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
-
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	flash_hash_pipeline_release (&pipeline);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_last_not_blank (CuTest *test)
+static void host_fw_verify_images_batch_test_null (CuTest *test)
 {
-	struct flash_region img_region;
+	struct flash_region region;
 	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
 	RSA_TESTING_ENGINE rsa;
 	int status;
 	char *data = "Test";
@@ -3463,45 +3238,42 @@ static void host_fw_full_flash_verification_test_last_not_blank (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
-		0x200 - strlen (data));
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN,
-		FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, FLASH_VERIFICATION_BLOCK));
-
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	sig.regions = &img_region;
+	sig.regions = &region;
 	sig.count = 1;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	list.images = &sig;
+	list.count = 1;
 
-	rw_region.start_addr = 0x200;
-	rw_region.length = 0x100;
+	engines[0] = &hash.base;
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	status = host_fw_verify_images_batch (NULL, NULL, &list, engines, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_images_batch (&flash, NULL, NULL, engines, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+	status = host_fw_verify_images_batch (&flash, NULL, &list, NULL, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_images_batch (&flash, NULL, &list, engines, 0, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_images_batch (&flash, NULL, &list, engines, 1, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	engines[0] = NULL;
+	status = host_fw_verify_images_batch (&flash, NULL, &list, engines, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
@@ -3511,16 +3283,15 @@ static void host_fw_full_flash_verification_test_last_not_blank (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_test_null (CuTest *test)
+static void host_fw_verify_offset_images_batch_test (CuTest *test)
 {
-	struct flash_region img_region;
+	struct flash_region region;
 	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
 	RSA_TESTING_ENGINE rsa;
 	int status;
 	char *data = "Test";
@@ -3539,47 +3310,34 @@ static void host_fw_full_flash_verification_test_null (CuTest *test)
 	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	sig.regions = &img_region;
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
 	sig.count = 1;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
 	sig.always_validate = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
-
-	rw_region.start_addr = 0x200;
-	rw_region.length = 0x100;
-
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
-
-	status = spi_flash_set_device_size (&flash, 0x1000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = host_fw_full_flash_verification (NULL, &img_list, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
-
-	status = host_fw_full_flash_verification (&flash, NULL, &rw_list, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	list.images = &sig;
+	list.count = 1;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, NULL, 0xff, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	engines[0] = &hash.base;
 
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, NULL,
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
 		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
-
-	status = host_fw_full_flash_verification (&flash, &img_list, &rw_list, 0xff, &hash.base,
-		NULL);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
@@ -3589,1420 +3347,5224 @@ static void host_fw_full_flash_verification_test_null (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_multiple (CuTest *test)
 {
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	/* Images are hashed in flash address order, not list order. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data2)));
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data3)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data1)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = RSA_ENCRYPT_LEN;
+	region[0].start_addr = 0x30000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x10000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x20000;
+	region[2].length = strlen (data3);
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list, &flash1, &rw_list);
-	CuAssertIntEquals (test, 0, status);
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	sig[2].regions = &region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
+
+	list.images = sig;
+	list.count = 3;
+
+	engines[0] = &hash.base;
+
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_multiple_regions (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_multiple_one_invalid (CuTest *test)
 {
-	struct flash_region rw_region[3];
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
-		0x30000, RSA_ENCRYPT_TEST2, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
-		0x50000, RSA_ENCRYPT_NOPE, 32);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = RSA_ENCRYPT_LEN;
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 16;
-	rw_region[2].start_addr = 0x50000;
-	rw_region[2].length = 32;
-
-	rw_list.regions = rw_region;
-	rw_list.count = 3;
-
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list, &flash1, &rw_list);
-	CuAssertIntEquals (test, 0, status);
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	sig[2].regions = &region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
+
+	list.images = sig;
+	list.count = 3;
+
+	engines[0] = &hash.base;
+
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
+		&rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_different_addresses (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_adjacent_regions (CuTest *test)
 {
-	struct flash_region rw_region1;
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2;
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "TestTest2";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, RSA_ENCRYPT_LEN);
+	/* Adjacent regions from different images are read from flash together. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1.start_addr = 0x10000;
-	rw_region1.length = RSA_ENCRYPT_LEN;
+	region[0].start_addr = 0x10000;
+	region[0].length = 4;
+	region[1].start_addr = 0x10004;
+	region[1].length = 5;
 
-	rw_list1.regions = &rw_region1;
-	rw_list1.count = 1;
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	rw_region2.start_addr = 0x50000;
-	rw_region2.length = RSA_ENCRYPT_LEN;
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	rw_list2.regions = &rw_region2;
-	rw_list2.count = 1;
+	list.images = sig;
+	list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_ADDR, status);
+	engines[0] = &hash.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_multiple_diff_addresses (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_interleaved (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash1;
+	HASH_TESTING_ENGINE hash2;
+	struct hash_engine *engines[2];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = HASH_TESTING_ENGINE_INIT (&hash1);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash2);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x40000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 1,
+		strlen (data1) - 1, FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data1) - 1));
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	region[0].start_addr = 0x10000;
+	region[0].length = 1;
+	region[1].start_addr = 0x30000;
+	region[1].length = strlen (data1) - 1;
+	region[2].start_addr = 0x20000;
+	region[2].length = strlen (data2);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	sig[0].regions = &region[0];
+	sig[0].count = 2;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = RSA_ENCRYPT_LEN;
-	rw_region2[1].start_addr = 0x40000;
-	rw_region2[1].length = 16;
-	rw_region2[2].start_addr = 0x50000;
-	rw_region2[2].length = 32;
+	sig[1].regions = &region[2];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	list.images = sig;
+	list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_ADDR, status);
+	engines[0] = &hash1.base;
+	engines[1] = &hash2.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 2,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash1);
+	HASH_TESTING_ENGINE_RELEASE (&hash2);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_dest_larger (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_interleaved_one_engine (CuTest *test)
 {
-	struct flash_region rw_region1;
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2;
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	/* Not enough hash engines, so each image is verified separately. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000,
-		RSA_ENCRYPT_LEN * 2);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 1,
+		strlen (data1) - 1, FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data1) - 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1.start_addr = 0x10000;
-	rw_region1.length = RSA_ENCRYPT_LEN;
+	region[0].start_addr = 0x10000;
+	region[0].length = 1;
+	region[1].start_addr = 0x30000;
+	region[1].length = strlen (data1) - 1;
+	region[2].start_addr = 0x20000;
+	region[2].length = strlen (data2);
 
-	rw_list1.regions = &rw_region1;
-	rw_list1.count = 1;
+	sig[0].regions = &region[0];
+	sig[0].count = 2;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	rw_region2.start_addr = 0x10000;
-	rw_region2.length = RSA_ENCRYPT_LEN * 2;
+	sig[1].regions = &region[2];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	rw_list2.regions = &rw_region2;
-	rw_list2.count = 1;
+	list.images = sig;
+	list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+	engines[0] = &hash.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_dest_smaller (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_overlapping_regions (CuTest *test)
 {
-	struct flash_region rw_region1;
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2;
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region;
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash1;
+	HASH_TESTING_ENGINE hash2;
+	struct hash_engine *engines[2];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = HASH_TESTING_ENGINE_INIT (&hash1);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash2);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000,
-		RSA_ENCRYPT_LEN - 1);
+	/* Overlapping images can't be hashed in a single pass, so each image is read separately. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1.start_addr = 0x10000;
-	rw_region1.length = RSA_ENCRYPT_LEN;
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	rw_list1.regions = &rw_region1;
-	rw_list1.count = 1;
+	sig[0].regions = &region;
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	rw_region2.start_addr = 0x10000;
-	rw_region2.length = RSA_ENCRYPT_LEN - 1;
+	sig[1].regions = &region;
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	rw_list2.regions = &rw_region2;
-	rw_list2.count = 1;
+	list.images = sig;
+	list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+	engines[0] = &hash1.base;
+	engines[1] = &hash2.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 2,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash1);
+	HASH_TESTING_ENGINE_RELEASE (&hash2);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_multiple_one_smaller (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_partial_validation (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test2";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 8);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	region[0].start_addr = 0x10000;
+	region[0].length = 4;
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 0;
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = RSA_ENCRYPT_LEN;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 8;
-	rw_region2[2].start_addr = 0x50000;
-	rw_region2[2].length = 32;
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	list.images = sig;
+	list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+	engines[0] = &hash.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_dest_more_regions (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_no_images (CuTest *test)
 {
-	struct flash_region rw_region1[2];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
 	int status;
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x60000, 32);
-
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 2;
-
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = RSA_ENCRYPT_LEN;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 16;
-	rw_region2[2].start_addr = 0x60000;
-	rw_region2[2].length = 32;
-
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	list.images = NULL;
+	list.count = 0;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_COUNT, status);
+	engines[0] = &hash.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_src_more_regions (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_read_error (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[2];
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct hash_engine_mock hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
+	status |= flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
 
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (data, 1), MOCK_ARG (1));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	region[0].start_addr = 0x10000;
+	region[0].length = 1;
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data) - 1;
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = RSA_ENCRYPT_LEN;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 16;
+	sig.regions = region;
+	sig.count = 2;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 2;
+	list.images = &sig;
+	list.count = 1;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_COUNT, status);
+	engines[0] = &hash.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 1,
+		&rsa.base);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = hash_mock_validate_and_release (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_diff_address_and_size (CuTest *test)
+static void host_fw_verify_offset_images_batch_test_hash_start_error (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region region[3];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct hash_engine_mock hash1;
+	struct hash_engine_mock hash2;
+	struct hash_engine *engines[2];
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = hash_mock_init (&hash1);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = hash_mock_init (&hash2);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x40000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 16);
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
+
+	status |= mock_expect (&hash2.mock, hash2.base.start_sha256, &hash2, 0);
+	status |= mock_expect (&hash2.mock, hash2.base.update, &hash2, 0,
+		MOCK_ARG_PTR_CONTAINS (data1, 1), MOCK_ARG (1));
+	status |= mock_expect (&hash2.mock, hash2.base.cancel, &hash2, 0);
+
+	status |= mock_expect (&hash1.mock, hash1.base.start_sha256, &hash1,
+		HASH_ENGINE_START_SHA256_FAILED);
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	region[0].start_addr = 0x10000;
+	region[0].length = 1;
+	region[1].start_addr = 0x30000;
+	region[1].length = strlen (data1) - 1;
+	region[2].start_addr = 0x20000;
+	region[2].length = strlen (data2);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	sig[0].regions = &region[0];
+	sig[0].count = 2;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = RSA_ENCRYPT_LEN;
-	rw_region2[1].start_addr = 0x40000;
-	rw_region2[1].length = 16;
-	rw_region2[2].start_addr = 0x50000;
-	rw_region2[2].length = 16;
+	sig[1].regions = &region[2];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	list.images = sig;
+	list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_ADDR, status);
+	engines[0] = &hash1.base;
+	engines[1] = &hash2.base;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_batch (&flash, NULL, &list, 0x400000, engines, 2,
+		&rsa.base);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = hash_mock_validate_and_release (&hash1);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = hash_mock_validate_and_release (&hash2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_diff_size_and_address (CuTest *test)
+/**
+ * Set up expectations for reading a region of flash during single pass verification.  The region is
+ * read in chunks of FLASH_DATA_CHECK_BLOCK bytes.
+ *
+ * @param flash_mock The mock for the flash being verified.
+ * @param flash_data The contents of the entire flash device.
+ * @param start The starting address of the region.
+ * @param end The address of the end of the region.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int host_fw_util_testing_expect_single_pass_read (struct flash_master_mock *flash_mock,
+	const uint8_t *flash_data, uint32_t start, uint32_t end)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	size_t read_len;
+	int status = 0;
+
+	while (start < end) {
+		read_len = min (end - start, FLASH_DATA_CHECK_BLOCK);
+
+		status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, &flash_data[start], read_len,
+			FLASH_EXP_READ_CMD (0x03, start, 0, -1, read_len));
+
+		start += read_len;
+	}
+
+	return status;
+}
+
+static void host_fw_full_flash_verification_test (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 8);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x60000, 32);
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x200);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300, 0x1000);
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = RSA_ENCRYPT_LEN;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 8;
-	rw_region2[2].start_addr = 0x60000;
-	rw_region2[2].length = 32;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_all_different (CuTest *test)
+static void host_fw_full_flash_verification_test_not_blank_byte (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	memset (flash_data, 0x55, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x20000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 8);
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x200);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300, 0x1000);
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_region2[0].start_addr = 0x20000;
-	rw_region2[0].length = RSA_ENCRYPT_LEN;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 8;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 2;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
-	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_COUNT, status);
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0x55, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
-}
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-static void host_fw_migrate_read_write_data_test_multiple_diff_ordering (CuTest *test)
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_multiple_rw_regions (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
-
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
-		0x30000, RSA_ENCRYPT_TEST2, 16);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
-		0x50000, RSA_ENCRYPT_NOPE, 32);
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x200);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300, 0x600);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x700, 0x1000);
 
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = RSA_ENCRYPT_LEN;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_region2[0].start_addr = 0x50000;
-	rw_region2[0].length = 32;
-	rw_region2[1].start_addr = 0x10000;
-	rw_region2[1].length = RSA_ENCRYPT_LEN;
-	rw_region2[2].start_addr = 0x30000;
-	rw_region2[2].length = 16;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	rw_region[0].start_addr = 0x200;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0x600;
+	rw_region[1].length = 0x100;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list2, &flash1, &rw_list1);
+	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_no_source_regions (CuTest *test)
+static void host_fw_full_flash_verification_test_image_between_rw_regions (CuTest *test)
 {
-	struct flash_region rw_region;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
 	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (&flash_data[0x900], data, strlen (data));
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x800);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x900, 0xb00);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0xc00, 0x1000);
+
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
-		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	img_region.start_addr = 0x900;
+	img_region.length = strlen (data);
 
-	CuAssertIntEquals (test, 0, status);
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = RSA_ENCRYPT_LEN;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	rw_region[0].start_addr = 0x800;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xb00;
+	rw_region[1].length = 0x100;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list, &flash1, NULL);
+	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_null (CuTest *test)
+static void host_fw_full_flash_verification_test_multiple_images (CuTest *test)
 {
-	struct flash_region rw_region;
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
 	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data1, strlen (data1));
+	memcpy (&flash_data[0x900], data2, strlen (data2));
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x800);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x900, 0xc00);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0xd00, 0x1000);
+
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = RSA_ENCRYPT_LEN;
+	img_region[0].start_addr = 0;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0x900;
+	img_region[1].length = strlen (data2);
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	status = host_fw_migrate_read_write_data (NULL, &rw_list, &flash1, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	status = host_fw_migrate_read_write_data (&flash2, NULL, &flash1, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	img_list.images = sig;
+	img_list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list, NULL, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	rw_region[0].start_addr = 0x800;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xc00;
+	rw_region[1].length = 0x100;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_erase_error (CuTest *test)
+static void host_fw_full_flash_verification_test_offset_image (CuTest *test)
 {
-	struct flash_region rw_region[3];
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
 	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data1, strlen (data1));
+	memcpy (&flash_data[0xb00], data2, strlen (data2));
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x800);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x900, 0xd00);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0xe00, 0x1000);
+
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	img_region[0].start_addr = 0;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0xb00;
+	img_region[1].length = strlen (data2);
 
-	CuAssertIntEquals (test, 0, status);
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = RSA_ENCRYPT_LEN;
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 16;
-	rw_region[2].start_addr = 0x50000;
-	rw_region[2].length = 32;
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region[0].start_addr = 0x800;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xd00;
+	rw_region[1].length = 0x100;
 
 	rw_list.regions = rw_region;
-	rw_list.count = 3;
+	rw_list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_migrate_read_write_data_test_copy_error (CuTest *test)
+static void host_fw_full_flash_verification_test_first_region_rw (CuTest *test)
 {
-	struct flash_region rw_region[3];
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
 	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (&flash_data[0x300], data1, strlen (data1));
+	memcpy (&flash_data[0xa00], data2, strlen (data2));
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x100, 0xc00);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0xd00, 0x1000);
+
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
-	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+	img_region[0].start_addr = 0x300;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0xa00;
+	img_region[1].length = strlen (data2);
 
-	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	CuAssertIntEquals (test, 0, status);
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = RSA_ENCRYPT_LEN;
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 16;
-	rw_region[2].start_addr = 0x50000;
-	rw_region[2].length = 32;
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region[0].start_addr = 0;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xc00;
+	rw_region[1].length = 0x100;
 
 	rw_list.regions = rw_region;
-	rw_list.count = 3;
+	rw_list.count = 2;
 
-	status = host_fw_migrate_read_write_data (&flash2, &rw_list, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_read_write_regions_different_test (CuTest *test)
+static void host_fw_full_flash_verification_test_last_region_rw (CuTest *test)
 {
-	struct flash_region rw_region1;
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2;
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	uint8_t flash_data[0x1000];
 
 	TEST_START;
 
-	rw_region1.start_addr = 0x10000;
-	rw_region1.length = 0x100;
-
-	rw_list1.regions = &rw_region1;
-	rw_list1.count = 1;
-
-	rw_region2.start_addr = 0x10000;
-	rw_region2.length = 0x100;
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data1, strlen (data1));
+	memcpy (&flash_data[0xa00], data2, strlen (data2));
 
-	rw_list2.regions = &rw_region2;
-	rw_list2.count = 1;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, false, status);
-}
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-static void host_fw_are_read_write_regions_different_test_different_address (CuTest *test)
-{
-	struct flash_region rw_region1;
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2;
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	TEST_START;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region1.start_addr = 0x10000;
-	rw_region1.length = 0x100;
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x200);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300, 0xf00);
 
-	rw_list1.regions = &rw_region1;
-	rw_list1.count = 1;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region2.start_addr = 0x50000;
-	rw_region2.length = 0x100;
+	img_region[0].start_addr = 0;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0xa00;
+	img_region[1].length = strlen (data2);
 
-	rw_list2.regions = &rw_region2;
-	rw_list2.count = 1;
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, true, status);
-}
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
 
-static void host_fw_are_read_write_regions_different_test_different_size (CuTest *test)
-{
-	struct flash_region rw_region1;
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2;
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	img_list.images = sig;
+	img_list.count = 2;
 
-	TEST_START;
+	rw_region[0].start_addr = 0x200;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xf00;
+	rw_region[1].length = 0x100;
 
-	rw_region1.start_addr = 0x10000;
-	rw_region1.length = 0x100;
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
 
-	rw_list1.regions = &rw_region1;
-	rw_list1.count = 1;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region2.start_addr = 0x10000;
-	rw_region2.length = 0x101;
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list2.regions = &rw_region2;
-	rw_list2.count = 1;
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, true, status);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_read_write_regions_different_test_multiple (CuTest *test)
+static void host_fw_full_flash_verification_test_multipart_image (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	struct flash_region img_region[4];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
 
 	TEST_START;
 
-	rw_region1[0].start_addr = 0x10000;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, 1));
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 1, 3,
+		FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, 2));
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 3, 1,
+		FLASH_EXP_READ_CMD (0x03, 0xe00, 0, -1, 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x001, 0x1ff);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300 + 2, 0xa00 - 0x302);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
+		0xc00 - (0xa00 + strlen (data2)));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xd00, 0x100);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xe01, 0x1000 - 0xe01);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0;
+	img_region[0].length = 1;
+	img_region[1].start_addr = 0x300;
+	img_region[1].length = 2;
+	img_region[2].start_addr = 0xe00;
+	img_region[2].length = 1;
+	img_region[3].start_addr = 0xa00;
+	img_region[3].length = strlen (data2);
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 3;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &img_region[3];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region[0].start_addr = 0x200;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xc00;
+	rw_region[1].length = 0x100;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_partial_validation (CuTest *test)
+{
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	uint8_t flash_data[0x1000];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data1, strlen (data1));
+	memcpy (&flash_data[0x900], data2, strlen (data2));
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x800);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x900, 0xc00);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0xd00, 0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0x900;
+	img_region[1].length = strlen (data2);
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 0;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region[0].start_addr = 0x800;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xc00;
+	rw_region[1].length = 0x100;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_invalid_image (CuTest *test)
+{
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	uint8_t flash_data[0x1000];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data1, strlen (data1));
+	memcpy (&flash_data[0x900], data2, strlen (data2));
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x800);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x900, 0xc00);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0xd00, 0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0x900;
+	img_region[1].length = strlen (data2);
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region[0].start_addr = 0x800;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0xc00;
+	rw_region[1].length = 0x100;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_not_blank (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+	flash_data[0x10] = 0;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0,
+		min (0x200, FLASH_DATA_CHECK_BLOCK));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_last_not_blank (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+	flash_data[0x300] = 0;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x200);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300,
+		0x300 + min (0x1000 - 0x300, FLASH_DATA_CHECK_BLOCK));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_hash_pipeline (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct flash_hash_pipeline pipeline;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, flash_data, 0x200,
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, 0x200));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &flash_data[0x300],
+		0x1000 - 0x300, FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, 0x1000 - 0x300));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (&flash, &pipeline, &img_list, &rw_list, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_hash_pipeline_not_blank (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct flash_hash_pipeline pipeline;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+	flash_data[0x100] = 0;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, flash_data, 0x200,
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, 0x200));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (&flash, &pipeline, &img_list, &rw_list, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_test_null (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification (NULL, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, NULL, &rw_list, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, NULL, 0xff, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, NULL,
+		&rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification (&flash, NULL, &img_list, &rw_list, 0xff, &hash.base,
+		NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x200);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300,
+		0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_interleaved_images (CuTest *test)
+{
+	struct flash_region img_region[3];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[2];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash1;
+	HASH_TESTING_ENGINE hash2;
+	struct hash_engine *engines[2];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	uint8_t flash_data[0x1000];
+
+	TEST_START;
+
+	memset (flash_data, 0, sizeof (flash_data));
+	memcpy (&flash_data[0x10], data1, 1);
+	memcpy (&flash_data[0x20], data2, strlen (data2));
+	memcpy (&flash_data[0x400], data1 + 1, strlen (data1) - 1);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x100);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300,
+		0xf00);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0x10;
+	img_region[0].length = 1;
+	img_region[1].start_addr = 0x400;
+	img_region[1].length = strlen (data1) - 1;
+	img_region[2].start_addr = 0x20;
+	img_region[2].length = strlen (data2);
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 2;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &img_region[2];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 0;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region[0].start_addr = 0xf00;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0x100;
+	rw_region[1].length = 0x200;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 2;
+
+	engines[0] = &hash1.base;
+	engines[1] = &hash2.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0,
+		engines, 2, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash1);
+	HASH_TESTING_ENGINE_RELEASE (&hash2);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_interleaved_images_one_engine (
+	CuTest *test)
+{
+	struct flash_region img_region[3];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Not enough hash engines, so the images are verified before checking unused regions. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, 1,
+		FLASH_EXP_READ_CMD (0x03, 0x10, 0, -1, 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 1,
+		strlen (data1) - 1, FLASH_EXP_READ_CMD (0x03, 0x400, 0, -1, strlen (data1) - 1));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x20, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0, 0x10);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x11, 0x20 - 0x11);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x20 + strlen (data2),
+		0x100 - (0x20 + strlen (data2)));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x400 - 0x300);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x400 + strlen (data1) - 1,
+		0x1000 - (0x400 + strlen (data1) - 1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0x10;
+	img_region[0].length = 1;
+	img_region[1].start_addr = 0x400;
+	img_region[1].length = strlen (data1) - 1;
+	img_region[2].start_addr = 0x20;
+	img_region[2].length = strlen (data2);
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 2;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &img_region[2];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region.start_addr = 0x100;
+	rw_region.length = 0x200;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_image_in_rw_region (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The image overlaps a read/write region, so the flash can't be checked in a single pass. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x200, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0, 0x200);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x200 + strlen (data),
+		0x1000 - (0x200 + strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0x200;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_no_images (CuTest *test)
+{
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_blank_check (&flash_mock, 0, 0x200);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_list.images = NULL;
+	img_list.count = 0;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_invalid_image (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0, 0x200);
+	status |= host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0x300,
+		0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_not_blank (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x200];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+	flash_data[0x80] = 0;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0,
+		min (sizeof (flash_data), FLASH_DATA_CHECK_BLOCK));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_read_error (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct hash_engine_mock hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[FLASH_DATA_CHECK_BLOCK];
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (&flash_data[FLASH_DATA_CHECK_BLOCK - 2], data, 2);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_single_pass_read (&flash_mock, flash_data, 0,
+		FLASH_DATA_CHECK_BLOCK);
+
+	status |= flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (data, 2), MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = FLASH_DATA_CHECK_BLOCK - 2;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_list.regions = NULL;
+	rw_list.count = 0;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, FLASH_DATA_CHECK_BLOCK * 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_hash_pipeline (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct flash_hash_pipeline pipeline;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+	uint8_t flash_data[0x1000];
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+	memcpy (flash_data, data, strlen (data));
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline, &flash.base, NULL,
+		FLASH_HASH_PIPELINE_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, flash_data, 0x200,
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, 0x200));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &flash_data[0x300],
+		0x1000 - 0x300, FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, 0x1000 - 0x300));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, &pipeline, &img_list, &rw_list,
+		0xff, engines, 1, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_single_pass_test_null (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	struct hash_engine *engines[1];
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	engines[0] = &hash.base;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_single_pass (NULL, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, NULL, &rw_list, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, NULL, 0xff,
+		engines, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		NULL, 1, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 0, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_single_pass (&flash, NULL, &img_list, &rw_list, 0xff,
+		engines, 1, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_migrate_read_write_data_test (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
+		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = RSA_ENCRYPT_LEN;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_multiple_regions (CuTest *test)
+{
+	struct flash_region rw_region[3];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
+		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
+		0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
+		0x50000, RSA_ENCRYPT_NOPE, 32);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = RSA_ENCRYPT_LEN;
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 16;
+	rw_region[2].start_addr = 0x50000;
+	rw_region[2].length = 32;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_different_addresses (CuTest *test)
+{
+	struct flash_region rw_region1;
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2;
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, RSA_ENCRYPT_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1.start_addr = 0x10000;
+	rw_region1.length = RSA_ENCRYPT_LEN;
+
+	rw_list1.regions = &rw_region1;
+	rw_list1.count = 1;
+
+	rw_region2.start_addr = 0x50000;
+	rw_region2.length = RSA_ENCRYPT_LEN;
+
+	rw_list2.regions = &rw_region2;
+	rw_list2.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_ADDR, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_multiple_diff_addresses (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x40000, 16);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = RSA_ENCRYPT_LEN;
+	rw_region2[1].start_addr = 0x40000;
+	rw_region2[1].length = 16;
+	rw_region2[2].start_addr = 0x50000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_ADDR, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_dest_larger (CuTest *test)
+{
+	struct flash_region rw_region1;
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2;
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000,
+		RSA_ENCRYPT_LEN * 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1.start_addr = 0x10000;
+	rw_region1.length = RSA_ENCRYPT_LEN;
+
+	rw_list1.regions = &rw_region1;
+	rw_list1.count = 1;
+
+	rw_region2.start_addr = 0x10000;
+	rw_region2.length = RSA_ENCRYPT_LEN * 2;
+
+	rw_list2.regions = &rw_region2;
+	rw_list2.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_dest_smaller (CuTest *test)
+{
+	struct flash_region rw_region1;
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2;
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000,
+		RSA_ENCRYPT_LEN - 1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1.start_addr = 0x10000;
+	rw_region1.length = RSA_ENCRYPT_LEN;
+
+	rw_list1.regions = &rw_region1;
+	rw_list1.count = 1;
+
+	rw_region2.start_addr = 0x10000;
+	rw_region2.length = RSA_ENCRYPT_LEN - 1;
+
+	rw_list2.regions = &rw_region2;
+	rw_list2.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_multiple_one_smaller (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 8);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = RSA_ENCRYPT_LEN;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 8;
+	rw_region2[2].start_addr = 0x50000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_dest_more_regions (CuTest *test)
+{
+	struct flash_region rw_region1[2];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x60000, 32);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 2;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = RSA_ENCRYPT_LEN;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 16;
+	rw_region2[2].start_addr = 0x60000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_COUNT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_src_more_regions (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = RSA_ENCRYPT_LEN;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 16;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 2;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_COUNT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_diff_address_and_size (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x40000, 16);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 16);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = RSA_ENCRYPT_LEN;
+	rw_region2[1].start_addr = 0x40000;
+	rw_region2[1].length = 16;
+	rw_region2[2].start_addr = 0x50000;
+	rw_region2[2].length = 16;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_ADDR, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_diff_size_and_address (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 8);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x60000, 32);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = RSA_ENCRYPT_LEN;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 8;
+	rw_region2[2].start_addr = 0x60000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_SIZE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_all_different (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x20000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 8);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x20000;
+	rw_region2[0].length = RSA_ENCRYPT_LEN;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 8;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 2;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_DIFF_REGION_COUNT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_multiple_diff_ordering (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
+		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x30000,
+		0x30000, RSA_ENCRYPT_TEST2, 16);
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x50000,
+		0x50000, RSA_ENCRYPT_NOPE, 32);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = RSA_ENCRYPT_LEN;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x50000;
+	rw_region2[0].length = 32;
+	rw_region2[1].start_addr = 0x10000;
+	rw_region2[1].length = RSA_ENCRYPT_LEN;
+	rw_region2[2].start_addr = 0x30000;
+	rw_region2[2].length = 16;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list2, &flash1, &rw_list1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_no_source_regions (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_copy_flash_verify (&flash_mock2, &flash_mock1, 0x10000,
+		0x10000, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = RSA_ENCRYPT_LEN;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list, &flash1, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_null (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = RSA_ENCRYPT_LEN;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = host_fw_migrate_read_write_data (NULL, NULL, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, NULL, &flash1, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list, NULL, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_erase_error (CuTest *test)
+{
+	struct flash_region rw_region[3];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = RSA_ENCRYPT_LEN;
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 16;
+	rw_region[2].start_addr = 0x50000;
+	rw_region[2].length = 32;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_copy_error (CuTest *test)
+{
+	struct flash_region rw_region[3];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, RSA_ENCRYPT_LEN);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x30000, 16);
+	status |= flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x50000, 32);
+
+	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = RSA_ENCRYPT_LEN;
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 16;
+	rw_region[2].start_addr = 0x50000;
+	rw_region[2].length = 32;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = host_fw_migrate_read_write_data (&flash2, NULL, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_copy_stream (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	struct flash_copy_stream stream;
+	uint8_t data[FLASH_PAGE_SIZE * 2];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_verify (&flash_mock2, 0x10000, sizeof (data));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, sizeof (data)));
+
+	status |= flash_master_mock_expect_write (&flash_mock2, 0x10000, data, FLASH_PAGE_SIZE);
+	status |= flash_master_mock_expect_write (&flash_mock2, 0x10000 + FLASH_PAGE_SIZE,
+		&data[FLASH_PAGE_SIZE], FLASH_PAGE_SIZE);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock2, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock2, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = sizeof (data);
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, &stream, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_migrate_read_write_data_test_copy_stream_wrong_flash (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	struct flash_copy_stream stream;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash1.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = RSA_ENCRYPT_LEN;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = host_fw_migrate_read_write_data (&flash2, &stream, &rw_list, &flash1, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_are_read_write_regions_different_test (CuTest *test)
+{
+	struct flash_region rw_region1;
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2;
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1.start_addr = 0x10000;
+	rw_region1.length = 0x100;
+
+	rw_list1.regions = &rw_region1;
+	rw_list1.count = 1;
+
+	rw_region2.start_addr = 0x10000;
+	rw_region2.length = 0x100;
+
+	rw_list2.regions = &rw_region2;
+	rw_list2.count = 1;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, false, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_different_address (CuTest *test)
+{
+	struct flash_region rw_region1;
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2;
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1.start_addr = 0x10000;
+	rw_region1.length = 0x100;
+
+	rw_list1.regions = &rw_region1;
+	rw_list1.count = 1;
+
+	rw_region2.start_addr = 0x50000;
+	rw_region2.length = 0x100;
+
+	rw_list2.regions = &rw_region2;
+	rw_list2.count = 1;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, true, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_different_size (CuTest *test)
+{
+	struct flash_region rw_region1;
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2;
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1.start_addr = 0x10000;
+	rw_region1.length = 0x100;
+
+	rw_list1.regions = &rw_region1;
+	rw_list1.count = 1;
+
+	rw_region2.start_addr = 0x10000;
+	rw_region2.length = 0x101;
+
+	rw_list2.regions = &rw_region2;
+	rw_list2.count = 1;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, true, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_multiple (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = 0x100;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = 0x100;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 16;
+	rw_region2[2].start_addr = 0x50000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, false, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_multiple_diff_addr (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = 0x100;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = 0x100;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 16;
+	rw_region2[2].start_addr = 0x60000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, true, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_multiple_diff_size (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = 0x100;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = 0x100;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 24;
+	rw_region2[2].start_addr = 0x50000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, true, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_second_fewer (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2[2];
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = 0x100;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+	rw_region1[2].start_addr = 0x50000;
+	rw_region1[2].length = 32;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = 0x100;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 16;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 2;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, true, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_first_fewer (CuTest *test)
+{
+	struct flash_region rw_region1[2];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1[0].start_addr = 0x10000;
+	rw_region1[0].length = 0x100;
+	rw_region1[1].start_addr = 0x30000;
+	rw_region1[1].length = 16;
+
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 2;
+
+	rw_region2[0].start_addr = 0x10000;
+	rw_region2[0].length = 0x100;
+	rw_region2[1].start_addr = 0x30000;
+	rw_region2[1].length = 16;
+	rw_region2[2].start_addr = 0x50000;
+	rw_region2[2].length = 32;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, true, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_multiple_reordered (CuTest *test)
+{
+	struct flash_region rw_region1[3];
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2[3];
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1[0].start_addr = 0x10000;
 	rw_region1[0].length = 0x100;
 	rw_region1[1].start_addr = 0x30000;
 	rw_region1[1].length = 16;
 	rw_region1[2].start_addr = 0x50000;
 	rw_region1[2].length = 32;
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	rw_list1.regions = rw_region1;
+	rw_list1.count = 3;
+
+	rw_region2[0].start_addr = 0x50000;
+	rw_region2[0].length = 32;
+	rw_region2[1].start_addr = 0x10000;
+	rw_region2[1].length = 0x100;
+	rw_region2[2].start_addr = 0x30000;
+	rw_region2[2].length = 16;
+
+	rw_list2.regions = rw_region2;
+	rw_list2.count = 3;
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
+	CuAssertIntEquals (test, false, status);
+}
+
+static void host_fw_are_read_write_regions_different_test_null (CuTest *test)
+{
+	struct flash_region rw_region1;
+	struct pfm_read_write_regions rw_list1;
+	struct flash_region rw_region2;
+	struct pfm_read_write_regions rw_list2;
+	bool status;
+
+	TEST_START;
+
+	rw_region1.start_addr = 0x10000;
+	rw_region1.length = 0x100;
+
+	rw_list1.regions = &rw_region1;
+	rw_list1.count = 1;
+
+	rw_region2.start_addr = 0x10000;
+	rw_region2.length = 0x100;
+
+	rw_list2.regions = &rw_region2;
+	rw_list2.count = 1;
+
+	status = host_fw_are_read_write_regions_different (NULL, &rw_list2);
+	CuAssertIntEquals (test, true, status);
+
+	status = host_fw_are_read_write_regions_different (&rw_list1, NULL);
+	CuAssertIntEquals (test, true, status);
+
+	status = host_fw_are_read_write_regions_different (NULL, NULL);
+	CuAssertIntEquals (test, false, status);
+}
+
+static void host_fw_restore_flash_device_test (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
+		(uint8_t*) data, strlen (data), 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_flash_device_test_multipart_image (CuTest *test)
+{
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
+		(uint8_t*) data, 1, 0);
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0x20000, 0x20000,
+		(uint8_t*) data + 1, strlen (data) - 1, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0;
+	img_region[0].length = 1;
+	img_region[1].start_addr = 0x20000;
+	img_region[1].length = strlen (data) - 1;
+
+	sig.regions = img_region;
+	sig.count = 2;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_flash_device_test_multiple_images (CuTest *test)
+{
+	struct flash_region img_region[2];
+	struct pfm_image_signature sig[2];
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
+		(uint8_t*) data1, strlen (data1), 0);
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0x20000, 0x20000,
+		(uint8_t*) data2, strlen (data2), 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0;
+	img_region[0].length = strlen (data1);
+
+	sig[0].regions = img_region;
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	img_region[1].start_addr = 0x20000;
+	img_region[1].length = strlen (data2);
+
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	img_list.images = sig;
+	img_list.count = 2;
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_flash_device_test_multiple_rw_regions (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[3];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x60000);
+
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
+		(uint8_t*) data, strlen (data), 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = 0x10000;
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 0x10000;
+	rw_region[2].start_addr = 0x50000;
+	rw_region[2].length = 0x10000;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = spi_flash_set_device_size (&flash2, 0x70000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_flash_device_test_rw_regions_not_ordered (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[3];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x60000);
+
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
+		(uint8_t*) data, strlen (data), 0);
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = 0x100;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 16;
-	rw_region2[2].start_addr = 0x50000;
-	rw_region2[2].length = 32;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, false, status);
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region[0].start_addr = 0x50000;
+	rw_region[0].length = 0x10000;
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 0x10000;
+	rw_region[2].start_addr = 0x10000;
+	rw_region[2].length = 0x10000;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = spi_flash_set_device_size (&flash2, 0x70000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
 }
 
-static void host_fw_are_read_write_regions_different_test_multiple_diff_addr (CuTest *test)
+static void host_fw_restore_flash_device_test_start_and_end_rw (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region[3];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = 0x100;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = 0x100;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 16;
-	rw_region2[2].start_addr = 0x60000;
-	rw_region2[2].length = 32;
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, true, status);
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0x10000);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x50000);
+
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0x20000, 0x20000,
+		(uint8_t*) data, strlen (data), 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0x20000;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region[0].start_addr = 0;
+	rw_region[0].length = 0x10000;
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 0x10000;
+	rw_region[2].start_addr = 0x60000;
+	rw_region[2].length = 0x10000;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = spi_flash_set_device_size (&flash2, 0x70000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
 }
 
-static void host_fw_are_read_write_regions_different_test_multiple_diff_size (CuTest *test)
+static void host_fw_restore_flash_device_test_null (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = 0x100;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = 0x100;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 24;
-	rw_region2[2].start_addr = 0x50000;
-	rw_region2[2].length = 32;
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (NULL, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, NULL, &img_list, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, NULL, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, true, status);
-}
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
 
-static void host_fw_are_read_write_regions_different_test_second_fewer (CuTest *test)
-{
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2[2];
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	TEST_START;
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = 0x100;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = 0x100;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 16;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 2;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, true, status);
-}
+	img_list.images = &sig;
+	img_list.count = 1;
 
-static void host_fw_are_read_write_regions_different_test_first_fewer (CuTest *test)
-{
-	struct flash_region rw_region1[2];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
 
-	TEST_START;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = 0x100;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 2;
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
-	rw_region2[0].start_addr = 0x10000;
-	rw_region2[0].length = 0x100;
-	rw_region2[1].start_addr = 0x30000;
-	rw_region2[1].length = 16;
-	rw_region2[2].start_addr = 0x50000;
-	rw_region2[2].length = 32;
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, true, status);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
 }
 
-static void host_fw_are_read_write_regions_different_test_multiple_reordered (CuTest *test)
+static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
 {
-	struct flash_region rw_region1[3];
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2[3];
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash flash2;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	rw_region1[0].start_addr = 0x10000;
-	rw_region1[0].length = 0x100;
-	rw_region1[1].start_addr = 0x30000;
-	rw_region1[1].length = 16;
-	rw_region1[2].start_addr = 0x50000;
-	rw_region1[2].length = 32;
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list1.regions = rw_region1;
-	rw_list1.count = 3;
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region2[0].start_addr = 0x50000;
-	rw_region2[0].length = 32;
-	rw_region2[1].start_addr = 0x10000;
-	rw_region2[1].length = 0x100;
-	rw_region2[2].start_addr = 0x30000;
-	rw_region2[2].length = 16;
+	status = spi_flash_init (&flash1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list2.regions = rw_region2;
-	rw_list2.count = 3;
+	status = spi_flash_init (&flash2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, &rw_list2);
-	CuAssertIntEquals (test, false, status);
-}
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-static void host_fw_are_read_write_regions_different_test_null (CuTest *test)
-{
-	struct flash_region rw_region1;
-	struct pfm_read_write_regions rw_list1;
-	struct flash_region rw_region2;
-	struct pfm_read_write_regions rw_list2;
-	bool status;
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	TEST_START;
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
 
-	rw_region1.start_addr = 0x10000;
-	rw_region1.length = 0x100;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list1.regions = &rw_region1;
-	rw_list1.count = 1;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	rw_region2.start_addr = 0x10000;
-	rw_region2.length = 0x100;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_list2.regions = &rw_region2;
-	rw_list2.count = 1;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	status = host_fw_are_read_write_regions_different (NULL, &rw_list2);
-	CuAssertIntEquals (test, true, status);
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
 
-	status = host_fw_are_read_write_regions_different (&rw_list1, NULL);
-	CuAssertIntEquals (test, true, status);
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	status = host_fw_are_read_write_regions_different (NULL, NULL);
-	CuAssertIntEquals (test, false, status);
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test (CuTest *test)
+static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
 {
 	struct flash_region img_region;
 	struct pfm_image_signature sig;
@@ -5039,8 +8601,8 @@ static void host_fw_restore_flash_device_test (CuTest *test)
 	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
 	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
 
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
-		(uint8_t*) data, strlen (data), 0);
+	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -5066,8 +8628,8 @@ static void host_fw_restore_flash_device_test (CuTest *test)
 	status = spi_flash_set_device_size (&flash2, 0x30000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_restore_flash_device (&flash2, NULL, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -5079,9 +8641,9 @@ static void host_fw_restore_flash_device_test (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_multipart_image (CuTest *test)
+static void host_fw_restore_flash_device_test_copy_stream (CuTest *test)
 {
-	struct flash_region img_region[2];
+	struct flash_region img_region;
 	struct pfm_image_signature sig;
 	struct pfm_image_list img_list;
 	struct flash_region rw_region;
@@ -5090,11 +8652,17 @@ static void host_fw_restore_flash_device_test_multipart_image (CuTest *test)
 	struct spi_flash flash1;
 	struct flash_master_mock flash_mock2;
 	struct spi_flash flash2;
+	struct flash_copy_stream stream;
+	uint8_t data[FLASH_PAGE_SIZE * 2];
+	size_t i;
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
 	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
@@ -5110,26 +8678,31 @@ static void host_fw_restore_flash_device_test_multipart_image (CuTest *test)
 	status = spi_flash_set_device_size (&flash1, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash2.base, FLASH_COPY_STREAM_MIN_CHUNK);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
 	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
 
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
-		(uint8_t*) data, 1, 0);
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0x20000, 0x20000,
-		(uint8_t*) data + 1, strlen (data) - 1, 0);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock1, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, sizeof (data)));
+
+	status |= flash_master_mock_expect_write (&flash_mock2, 0, data, FLASH_PAGE_SIZE);
+	status |= flash_master_mock_expect_write (&flash_mock2, FLASH_PAGE_SIZE,
+		&data[FLASH_PAGE_SIZE], FLASH_PAGE_SIZE);
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = 1;
-	img_region[1].start_addr = 0x20000;
-	img_region[1].length = strlen (data) - 1;
+	img_region.start_addr = 0;
+	img_region.length = sizeof (data);
 
-	sig.regions = img_region;
-	sig.count = 2;
+	sig.regions = &img_region;
+	sig.count = 1;
 	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig.sig_length = RSA_ENCRYPT_LEN;
@@ -5144,10 +8717,7 @@ static void host_fw_restore_flash_device_test_multipart_image (CuTest *test)
 	rw_list.regions = &rw_region;
 	rw_list.count = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
+	status = host_fw_restore_flash_device (&flash2, &stream, &flash1, &img_list, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
@@ -5156,14 +8726,16 @@ static void host_fw_restore_flash_device_test_multipart_image (CuTest *test)
 	status = flash_master_mock_validate_and_release (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
 
+	flash_copy_stream_release (&stream);
+
 	spi_flash_release (&flash1);
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_multiple_images (CuTest *test)
+static void host_fw_restore_flash_device_test_copy_stream_wrong_flash (CuTest *test)
 {
-	struct flash_region img_region[2];
-	struct pfm_image_signature sig[2];
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
 	struct pfm_image_list img_list;
 	struct flash_region rw_region;
 	struct pfm_read_write_regions rw_list;
@@ -5171,9 +8743,8 @@ static void host_fw_restore_flash_device_test_multiple_images (CuTest *test)
 	struct spi_flash flash1;
 	struct flash_master_mock flash_mock2;
 	struct spi_flash flash2;
+	struct flash_copy_stream stream;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
 
 	TEST_START;
 
@@ -5189,44 +8760,50 @@ static void host_fw_restore_flash_device_test_multiple_images (CuTest *test)
 	status = spi_flash_init (&flash2, &flash_mock2.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = flash_copy_stream_init (&stream, &flash1.base, FLASH_COPY_STREAM_MIN_CHUNK);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	img_region.start_addr = 0;
+	img_region.length = RSA_ENCRYPT_LEN;
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+	sig.regions = &img_region;
+	sig.count = 1;
 
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
-		(uint8_t*) data1, strlen (data1), 0);
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0x20000, 0x20000,
-		(uint8_t*) data2, strlen (data2), 0);
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = host_fw_restore_flash_device (&flash2, &stream, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
+	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = strlen (data1);
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	sig[0].regions = img_region;
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
+	flash_copy_stream_release (&stream);
 
-	img_region[1].start_addr = 0x20000;
-	img_region[1].length = strlen (data2);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
 
-	sig[1].regions = &img_region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
+static void host_fw_config_spi_filter_read_write_regions_test (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	int status;
 
-	img_list.images = sig;
-	img_list.count = 2;
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
 
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
@@ -5234,979 +8811,1254 @@ static void host_fw_restore_flash_device_test_multiple_images (CuTest *test)
 	rw_list.regions = &rw_region;
 	rw_list.count = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = spi_filter_interface_mock_validate_and_release (&filter);
 	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_multiple_rw_regions (CuTest *test)
+static void host_fw_config_spi_filter_read_write_regions_test_multiple_regions (CuTest *test)
 {
-	struct flash_region img_region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
+	struct spi_filter_interface_mock filter;
 	struct flash_region rw_region[3];
 	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = spi_filter_interface_mock_init (&filter);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = 0x10000;
+
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 0x20000;
+
+	rw_region[2].start_addr = 0x60000;
+	rw_region[2].length = 0x30000;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (3), MOCK_ARG (0x60000), MOCK_ARG (0x90000));
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_filter_interface_mock_validate_and_release (&filter);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+static void host_fw_config_spi_filter_read_write_regions_test_null (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x60000);
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
 
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
-		(uint8_t*) data, strlen (data), 0);
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = host_fw_config_spi_filter_read_write_regions (NULL, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
+	status = spi_filter_interface_mock_validate_and_release (&filter);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+static void host_fw_config_spi_filter_read_write_regions_test_filter_error (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	struct flash_region rw_region[3];
+	struct pfm_read_write_regions rw_list;
+	int status;
 
-	sig.regions = &img_region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	TEST_START;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
 
 	rw_region[0].start_addr = 0x10000;
 	rw_region[0].length = 0x10000;
+
 	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x10000;
-	rw_region[2].start_addr = 0x50000;
-	rw_region[2].length = 0x10000;
+	rw_region[1].length = 0x20000;
+
+	rw_region[2].start_addr = 0x60000;
+	rw_region[2].length = 0x30000;
 
 	rw_list.regions = rw_region;
 	rw_list.count = 3;
 
-	status = spi_flash_set_device_size (&flash2, 0x70000);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter,
+		SPI_FILTER_SET_RW_FAILED, MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
+	CuAssertIntEquals (test, SPI_FILTER_SET_RW_FAILED, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = spi_filter_interface_mock_validate_and_release (&filter);
 	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_rw_regions_not_ordered (CuTest *test)
+static void host_fw_config_spi_filter_read_write_regions_test_clear_error (CuTest *test)
 {
-	struct flash_region img_region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
+	struct spi_filter_interface_mock filter;
 	struct flash_region rw_region[3];
 	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = spi_filter_interface_mock_init (&filter);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = 0x10000;
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
-	CuAssertIntEquals (test, 0, status);
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 0x20000;
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
-	CuAssertIntEquals (test, 0, status);
+	rw_region[2].start_addr = 0x60000;
+	rw_region[2].length = 0x30000;
+
+	rw_list.regions = rw_region;
+	rw_list.count = 3;
+
+	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter,
+		SPI_FILTER_CLEAR_RW_FAILED);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
+	CuAssertIntEquals (test, SPI_FILTER_CLEAR_RW_FAILED, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x60000);
+static void host_fw_are_images_different_test (CuTest *test)
+{
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
-		(uint8_t*) data, strlen (data), 0);
+	TEST_START;
 
-	CuAssertIntEquals (test, 0, status);
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	sig.regions = &img_region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	list1.images = &sig1;
+	list1.count = 1;
+
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
+
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
+
+	list2.images = &sig2;
+	list2.count = 1;
+
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, false, status);
+}
+
+static void host_fw_are_images_different_test_different_key_mod_length (CuTest *test)
+{
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	TEST_START;
 
-	rw_region[0].start_addr = 0x50000;
-	rw_region[0].length = 0x10000;
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x10000;
-	rw_region[2].start_addr = 0x10000;
-	rw_region[2].length = 0x10000;
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 3;
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x70000);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = &sig1;
+	list1.count = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, 0, status);
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	sig2.key.mod_length -= 1;
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	list2.images = &sig2;
+	list2.count = 1;
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_restore_flash_device_test_start_and_end_rw (CuTest *test)
+static void host_fw_are_images_different_test_different_key_exponent(CuTest *test)
 {
-	struct flash_region img_region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region[3];
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
-	int status;
-	char *data = "Test";
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash1, &flash_mock1.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash2, &flash_mock2.base);
-	CuAssertIntEquals (test, 0, status);
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = &sig1;
+	list1.count = 1;
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0x10000);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x40000);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x50000);
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
 
-	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0x20000, 0x20000,
-		(uint8_t*) data, strlen (data), 0);
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	sig2.key.exponent = 3;
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	CuAssertIntEquals (test, 0, status);
+	list2.images = &sig2;
+	list2.count = 1;
 
-	img_region.start_addr = 0x20000;
-	img_region.length = strlen (data);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
+}
 
-	sig.regions = &img_region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+static void host_fw_are_images_different_test_different_key_modulus (CuTest *test)
+{
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	TEST_START;
 
-	rw_region[0].start_addr = 0;
-	rw_region[0].length = 0x10000;
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x10000;
-	rw_region[2].start_addr = 0x60000;
-	rw_region[2].length = 0x10000;
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 3;
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x70000);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = &sig1;
+	list1.count = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, 0, status);
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	list2.images = &sig2;
+	list2.count = 1;
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_restore_flash_device_test_null (CuTest *test)
+static void host_fw_are_images_different_test_different_sig_length (CuTest *test)
 {
-	struct flash_region img_region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
-	int status;
-	char *data = "Test";
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	status = spi_flash_init (&flash1, &flash_mock1.base);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = &sig1;
+	list1.count = 1;
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
-	CuAssertIntEquals (test, 0, status);
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN - 1;
+	sig2.always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	list2.images = &sig2;
+	list2.count = 1;
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
+}
 
-	sig.regions = &img_region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+static void host_fw_are_images_different_test_different_signature (CuTest *test)
+{
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
+
+	TEST_START;
+
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
+
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
+
+	list1.images = &sig1;
+	list1.count = 1;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	list2.images = &sig2;
+	list2.count = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
+}
 
-	status = host_fw_restore_flash_device (NULL, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+static void host_fw_are_images_different_test_different_validate_flag (CuTest *test)
+{
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
-	status = host_fw_restore_flash_device (&flash2, NULL, &img_list, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	TEST_START;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, NULL, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, NULL);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = &sig1;
+	list1.count = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 0;
+
+	list2.images = &sig2;
+	list2.count = 1;
+
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
+static void host_fw_are_images_different_test_different_region_addr (CuTest *test)
 {
-	struct flash_region img_region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
-	int status;
-	char *data = "Test";
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash1, &flash_mock1.base);
-	CuAssertIntEquals (test, 0, status);
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	status = spi_flash_init (&flash2, &flash_mock2.base);
-	CuAssertIntEquals (test, 0, status);
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = &sig1;
+	list1.count = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	region2.start_addr = 0x20000;
+	region2.length = 0x100;
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	CuAssertIntEquals (test, 0, status);
+	list2.images = &sig2;
+	list2.count = 1;
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
+}
 
-	sig.regions = &img_region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+static void host_fw_are_images_different_test_different_region_length (CuTest *test)
+{
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	TEST_START;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = &sig1;
+	list1.count = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	region2.start_addr = 0x10000;
+	region2.length = 0x200;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	list2.images = &sig2;
+	list2.count = 1;
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images (CuTest *test)
 {
-	struct flash_region img_region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
-	int status;
-	char *data = "Test";
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
+	struct pfm_image_list list1;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash1, &flash_mock1.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash2, &flash_mock2.base);
-	CuAssertIntEquals (test, 0, status);
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-	CuAssertIntEquals (test, 0, status);
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
 
-	sig.regions = &img_region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	list1.images = sig1;
+	list1.count = 3;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	region22.start_addr = 0x30000;
+	region22.length = 32;
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
-	CuAssertIntEquals (test, 0, status);
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN;
+	sig2[1].always_validate = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	region23.start_addr = 0x50000;
+	region23.length = 16;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	list2.images = sig2;
+	list2.count = 3;
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, false, status);
 }
 
-static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_diff_key_mod_length (CuTest *test)
 {
-	struct flash_region img_region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list img_list;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash flash2;
-	int status;
-	char *data = "Test";
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
+	struct pfm_image_list list1;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash1, &flash_mock1.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash2, &flash_mock2.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-	CuAssertIntEquals (test, 0, status);
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-	img_region.start_addr = 0;
-	img_region.length = strlen (data);
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
 
-	sig.regions = &img_region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	list1.images = sig1;
+	list1.count = 3;
 
-	img_list.images = &sig;
-	img_list.count = 1;
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
 
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	region22.start_addr = 0x30000;
+	region22.length = 32;
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
-	CuAssertIntEquals (test, 0, status);
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN;
+	sig2[1].always_validate = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	region23.start_addr = 0x50000;
+	region23.length = 16;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	sig2[2].key.mod_length -= 1;
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
-	CuAssertIntEquals (test, 0, status);
+	list2.images = sig2;
+	list2.count = 3;
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_diff_key_exponent (CuTest *test)
 {
-	struct spi_filter_interface_mock filter;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
-	int status;
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
+	struct pfm_image_list list1;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = spi_filter_interface_mock_init (&filter);
-	CuAssertIntEquals (test, 0, status);
-
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
-
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
-
-	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	CuAssertIntEquals (test, 0, status);
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
-	CuAssertIntEquals (test, 0, status);
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
-	CuAssertIntEquals (test, 0, status);
-}
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-static void host_fw_config_spi_filter_read_write_regions_test_multiple_regions (CuTest *test)
-{
-	struct spi_filter_interface_mock filter;
-	struct flash_region rw_region[3];
-	struct pfm_read_write_regions rw_list;
-	int status;
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-	TEST_START;
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
 
-	status = spi_filter_interface_mock_init (&filter);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = sig1;
+	list1.count = 3;
 
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = 0x10000;
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
 
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x20000;
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
 
-	rw_region[2].start_addr = 0x60000;
-	rw_region[2].length = 0x30000;
+	region22.start_addr = 0x30000;
+	region22.length = 32;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 3;
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN;
+	sig2[1].always_validate = 1;
 
-	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (3), MOCK_ARG (0x60000), MOCK_ARG (0x90000));
+	region23.start_addr = 0x50000;
+	region23.length = 16;
 
-	CuAssertIntEquals (test, 0, status);
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	sig2[2].key.exponent = 3;
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
-	CuAssertIntEquals (test, 0, status);
+	list2.images = sig2;
+	list2.count = 3;
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test_null (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_diff_key_modulus (CuTest *test)
 {
-	struct spi_filter_interface_mock filter;
-	struct flash_region rw_region;
-	struct pfm_read_write_regions rw_list;
-	int status;
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
+	struct pfm_image_list list1;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = spi_filter_interface_mock_init (&filter);
-	CuAssertIntEquals (test, 0, status);
-
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
-
-	rw_list.regions = &rw_region;
-	rw_list.count = 1;
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	status = host_fw_config_spi_filter_read_write_regions (NULL, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, NULL);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
-	CuAssertIntEquals (test, 0, status);
-}
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-static void host_fw_config_spi_filter_read_write_regions_test_filter_error (CuTest *test)
-{
-	struct spi_filter_interface_mock filter;
-	struct flash_region rw_region[3];
-	struct pfm_read_write_regions rw_list;
-	int status;
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-	TEST_START;
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
 
-	status = spi_filter_interface_mock_init (&filter);
-	CuAssertIntEquals (test, 0, status);
+	list1.images = sig1;
+	list1.count = 3;
 
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = 0x10000;
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
 
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x20000;
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
 
-	rw_region[2].start_addr = 0x60000;
-	rw_region[2].length = 0x30000;
+	region22.start_addr = 0x30000;
+	region22.length = 32;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 3;
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN;
+	sig2[1].always_validate = 1;
 
-	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter,
-		SPI_FILTER_SET_RW_FAILED, MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
+	region23.start_addr = 0x50000;
+	region23.length = 16;
 
-	CuAssertIntEquals (test, 0, status);
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
-	CuAssertIntEquals (test, SPI_FILTER_SET_RW_FAILED, status);
+	list2.images = sig2;
+	list2.count = 3;
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_are_images_different (&list1, &list2);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test_clear_error (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_diff_sig_length (CuTest *test)
 {
-	struct spi_filter_interface_mock filter;
-	struct flash_region rw_region[3];
-	struct pfm_read_write_regions rw_list;
-	int status;
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
+	struct pfm_image_list list1;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
+	struct pfm_image_list list2;
+	bool status;
 
 	TEST_START;
 
-	status = spi_filter_interface_mock_init (&filter);
-	CuAssertIntEquals (test, 0, status);
-
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = 0x10000;
-
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x20000;
-
-	rw_region[2].start_addr = 0x60000;
-	rw_region[2].length = 0x30000;
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	rw_list.regions = rw_region;
-	rw_list.count = 3;
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter,
-		SPI_FILTER_CLEAR_RW_FAILED);
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	CuAssertIntEquals (test, 0, status);
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
-	CuAssertIntEquals (test, SPI_FILTER_CLEAR_RW_FAILED, status);
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
-	CuAssertIntEquals (test, 0, status);
-}
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
 
-static void host_fw_are_images_different_test (CuTest *test)
-{
-	struct flash_region region1;
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2;
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	list1.images = sig1;
+	list1.count = 3;
 
-	TEST_START;
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	region22.start_addr = 0x30000;
+	region22.length = 32;
 
-	list1.images = &sig1;
-	list1.count = 1;
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN - 1;
+	sig2[1].always_validate = 1;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	region23.start_addr = 0x50000;
+	region23.length = 16;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
 
-	list2.images = &sig2;
-	list2.count = 1;
+	list2.images = sig2;
+	list2.count = 3;
 
 	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, false, status);
+	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_different_key_mod_length (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_diff_signature (CuTest *test)
 {
-	struct flash_region region1;
-	struct pfm_image_signature sig1;
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
 	struct pfm_image_list list1;
-	struct flash_region region2;
-	struct pfm_image_signature sig2;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	list1.images = &sig1;
-	list1.count = 1;
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	sig2.key.mod_length -= 1;
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-	list2.images = &sig2;
-	list2.count = 1;
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
+
+	list1.images = sig1;
+	list1.count = 3;
+
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
+
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
+
+	region22.start_addr = 0x30000;
+	region22.length = 32;
+
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN;
+	sig2[1].always_validate = 1;
+
+	region23.start_addr = 0x50000;
+	region23.length = 16;
+
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST2, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
+
+	list2.images = sig2;
+	list2.count = 3;
 
 	status = host_fw_are_images_different (&list1, &list2);
 	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_different_key_exponent(CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_diff_validate_flag (CuTest *test)
 {
-	struct flash_region region1;
-	struct pfm_image_signature sig1;
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
 	struct pfm_image_list list1;
-	struct flash_region region2;
-	struct pfm_image_signature sig2;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	list1.images = &sig1;
-	list1.count = 1;
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	sig2.key.exponent = 3;
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-	list2.images = &sig2;
-	list2.count = 1;
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
+
+	list1.images = sig1;
+	list1.count = 3;
+
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
+
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
+
+	region22.start_addr = 0x30000;
+	region22.length = 32;
+
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN;
+	sig2[1].always_validate = 0;
+
+	region23.start_addr = 0x50000;
+	region23.length = 16;
+
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
+
+	list2.images = sig2;
+	list2.count = 3;
 
 	status = host_fw_are_images_different (&list1, &list2);
 	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_different_key_modulus (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_diff_image_count (CuTest *test)
 {
-	struct flash_region region1;
-	struct pfm_image_signature sig1;
+	struct flash_region region11;
+	struct flash_region region12;
+	struct flash_region region13;
+	struct pfm_image_signature sig1[3];
 	struct pfm_image_list list1;
-	struct flash_region region2;
-	struct pfm_image_signature sig2;
+	struct flash_region region21;
+	struct flash_region region22;
+	struct flash_region region23;
+	struct pfm_image_signature sig2[3];
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
-
-	sig1.regions = &region1;
-	sig1.count = 1;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
-
-	list1.images = &sig1;
-	list1.count = 1;
+	region11.start_addr = 0x10000;
+	region11.length = 0x100;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	sig1[0].regions = &region11;
+	sig1[0].count = 1;
+	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1[0].sig_length = RSA_ENCRYPT_LEN;
+	sig1[0].always_validate = 1;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	region12.start_addr = 0x30000;
+	region12.length = 32;
 
-	list2.images = &sig2;
-	list2.count = 1;
+	sig1[1].regions = &region12;
+	sig1[1].count = 1;
+	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig1[1].sig_length = RSA_ENCRYPT_LEN;
+	sig1[1].always_validate = 1;
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
-}
+	region13.start_addr = 0x50000;
+	region13.length = 16;
 
-static void host_fw_are_images_different_test_different_sig_length (CuTest *test)
-{
-	struct flash_region region1;
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2;
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	sig1[2].regions = &region13;
+	sig1[2].count = 1;
+	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig1[2].sig_length = RSA_ENCRYPT_LEN;
+	sig1[2].always_validate = 1;
 
-	TEST_START;
+	list1.images = sig1;
+	list1.count = 3;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	region21.start_addr = 0x10000;
+	region21.length = 0x100;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	sig2[0].regions = &region21;
+	sig2[0].count = 1;
+	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2[0].sig_length = RSA_ENCRYPT_LEN;
+	sig2[0].always_validate = 1;
 
-	list1.images = &sig1;
-	list1.count = 1;
+	region22.start_addr = 0x30000;
+	region22.length = 32;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	sig2[1].regions = &region22;
+	sig2[1].count = 1;
+	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
+	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
+	sig2[1].sig_length = RSA_ENCRYPT_LEN;
+	sig2[1].always_validate = 1;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN - 1;
-	sig2.always_validate = 1;
+	region23.start_addr = 0x50000;
+	region23.length = 16;
 
-	list2.images = &sig2;
-	list2.count = 1;
+	sig2[2].regions = &region23;
+	sig2[2].count = 1;
+	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
+	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
+	sig2[2].sig_length = RSA_ENCRYPT_LEN;
+	sig2[2].always_validate = 1;
+
+	list2.images = sig2;
+	list2.count = 2;
 
 	status = host_fw_are_images_different (&list1, &list2);
 	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_different_signature (CuTest *test)
+static void host_fw_are_images_different_test_multiple_regions (CuTest *test)
 {
-	struct flash_region region1;
+	struct flash_region region1[3];
 	struct pfm_image_signature sig1;
 	struct pfm_image_list list1;
-	struct flash_region region2;
+	struct flash_region region2[3];
 	struct pfm_image_signature sig2;
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	region1[0].start_addr = 0x10000;
+	region1[0].length = 0x100;
+	region1[1].start_addr = 0x30000;
+	region1[1].length = 16;
+	region1[2].start_addr = 0x50000;
+	region1[2].length = 32;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
+	sig1.regions = region1;
+	sig1.count = 3;
 	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig1.sig_length = RSA_ENCRYPT_LEN;
@@ -6215,13 +10067,17 @@ static void host_fw_are_images_different_test_different_signature (CuTest *test)
 	list1.images = &sig1;
 	list1.count = 1;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	region2[0].start_addr = 0x10000;
+	region2[0].length = 0x100;
+	region2[1].start_addr = 0x30000;
+	region2[1].length = 16;
+	region2[2].start_addr = 0x50000;
+	region2[2].length = 32;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
+	sig2.regions = region2;
+	sig2.count = 3;
 	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig2.sig_length = RSA_ENCRYPT_LEN;
 	sig2.always_validate = 1;
 
@@ -6229,26 +10085,30 @@ static void host_fw_are_images_different_test_different_signature (CuTest *test)
 	list2.count = 1;
 
 	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
+	CuAssertIntEquals (test, false, status);
 }
 
-static void host_fw_are_images_different_test_different_validate_flag (CuTest *test)
+static void host_fw_are_images_different_test_multiple_regions_diff_addr (CuTest *test)
 {
-	struct flash_region region1;
+	struct flash_region region1[3];
 	struct pfm_image_signature sig1;
 	struct pfm_image_list list1;
-	struct flash_region region2;
+	struct flash_region region2[3];
 	struct pfm_image_signature sig2;
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	region1[0].start_addr = 0x10000;
+	region1[0].length = 0x100;
+	region1[1].start_addr = 0x30000;
+	region1[1].length = 16;
+	region1[2].start_addr = 0x50000;
+	region1[2].length = 32;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
+	sig1.regions = region1;
+	sig1.count = 3;
 	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig1.sig_length = RSA_ENCRYPT_LEN;
@@ -6257,15 +10117,19 @@ static void host_fw_are_images_different_test_different_validate_flag (CuTest *t
 	list1.images = &sig1;
 	list1.count = 1;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	region2[0].start_addr = 0x10000;
+	region2[0].length = 0x100;
+	region2[1].start_addr = 0x30000;
+	region2[1].length = 16;
+	region2[2].start_addr = 0x60000;
+	region2[2].length = 32;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
+	sig2.regions = region2;
+	sig2.count = 3;
 	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 0;
+	sig2.always_validate = 1;
 
 	list2.images = &sig2;
 	list2.count = 1;
@@ -6274,23 +10138,27 @@ static void host_fw_are_images_different_test_different_validate_flag (CuTest *t
 	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_different_region_addr (CuTest *test)
+static void host_fw_are_images_different_test_multiple_regions_diff_length (CuTest *test)
 {
-	struct flash_region region1;
+	struct flash_region region1[3];
 	struct pfm_image_signature sig1;
 	struct pfm_image_list list1;
-	struct flash_region region2;
+	struct flash_region region2[3];
 	struct pfm_image_signature sig2;
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	region1[0].start_addr = 0x10000;
+	region1[0].length = 0x100;
+	region1[1].start_addr = 0x30000;
+	region1[1].length = 16;
+	region1[2].start_addr = 0x50000;
+	region1[2].length = 32;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
+	sig1.regions = region1;
+	sig1.count = 3;
 	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig1.sig_length = RSA_ENCRYPT_LEN;
@@ -6299,11 +10167,15 @@ static void host_fw_are_images_different_test_different_region_addr (CuTest *tes
 	list1.images = &sig1;
 	list1.count = 1;
 
-	region2.start_addr = 0x20000;
-	region2.length = 0x100;
+	region2[0].start_addr = 0x10000;
+	region2[0].length = 0x100;
+	region2[1].start_addr = 0x30000;
+	region2[1].length = 24;
+	region2[2].start_addr = 0x50000;
+	region2[2].length = 32;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
+	sig2.regions = region2;
+	sig2.count = 3;
 	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig2.sig_length = RSA_ENCRYPT_LEN;
@@ -6316,23 +10188,27 @@ static void host_fw_are_images_different_test_different_region_addr (CuTest *tes
 	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_different_region_length (CuTest *test)
+static void host_fw_are_images_different_test_multiple_regions_diff_count (CuTest *test)
 {
-	struct flash_region region1;
+	struct flash_region region1[3];
 	struct pfm_image_signature sig1;
 	struct pfm_image_list list1;
-	struct flash_region region2;
+	struct flash_region region2[3];
 	struct pfm_image_signature sig2;
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	region1[0].start_addr = 0x10000;
+	region1[0].length = 0x100;
+	region1[1].start_addr = 0x30000;
+	region1[1].length = 16;
+	region1[2].start_addr = 0x50000;
+	region1[2].length = 32;
 
-	sig1.regions = &region1;
-	sig1.count = 1;
+	sig1.regions = region1;
+	sig1.count = 3;
 	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig1.sig_length = RSA_ENCRYPT_LEN;
@@ -6341,11 +10217,15 @@ static void host_fw_are_images_different_test_different_region_length (CuTest *t
 	list1.images = &sig1;
 	list1.count = 1;
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x200;
+	region2[0].start_addr = 0x10000;
+	region2[0].length = 0x100;
+	region2[1].start_addr = 0x30000;
+	region2[1].length = 16;
+	region2[2].start_addr = 0x50000;
+	region2[2].length = 32;
 
-	sig2.regions = &region2;
-	sig2.count = 1;
+	sig2.regions = region2;
+	sig2.count = 2;
 	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
 	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
 	sig2.sig_length = RSA_ENCRYPT_LEN;
@@ -6358,101 +10238,65 @@ static void host_fw_are_images_different_test_different_region_length (CuTest *t
 	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_multiple_images (CuTest *test)
+static void host_fw_are_images_different_test_multiple_regions_reordered (CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12;
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
+	struct flash_region region1[3];
+	struct pfm_image_signature sig1;
 	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22;
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
+	struct flash_region region2[3];
+	struct pfm_image_signature sig2;
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
-
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
-
-	region12.start_addr = 0x30000;
-	region12.length = 32;
-
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
-
-	region13.start_addr = 0x50000;
-	region13.length = 16;
-
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
-
-	list1.images = sig1;
-	list1.count = 3;
-
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
-
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	region1[0].start_addr = 0x10000;
+	region1[0].length = 0x100;
+	region1[1].start_addr = 0x30000;
+	region1[1].length = 16;
+	region1[2].start_addr = 0x50000;
+	region1[2].length = 32;
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	sig1.regions = region1;
+	sig1.count = 3;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN;
-	sig2[1].always_validate = 1;
+	list1.images = &sig1;
+	list1.count = 1;
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	region2[0].start_addr = 0x50000;
+	region2[0].length = 32;
+	region2[1].start_addr = 0x10000;
+	region2[1].length = 0x100;
+	region2[2].start_addr = 0x30000;
+	region2[2].length = 16;
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	sig2.regions = region2;
+	sig2.count = 3;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	list2.images = sig2;
-	list2.count = 3;
+	list2.images = &sig2;
+	list2.count = 1;
 
 	status = host_fw_are_images_different (&list1, &list2);
 	CuAssertIntEquals (test, false, status);
 }
 
-static void host_fw_are_images_different_test_multiple_images_diff_key_mod_length (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_multiple_regions (CuTest *test)
 {
 	struct flash_region region11;
-	struct flash_region region12;
+	struct flash_region region12[3];
 	struct flash_region region13;
 	struct pfm_image_signature sig1[3];
 	struct pfm_image_list list1;
 	struct flash_region region21;
-	struct flash_region region22;
+	struct flash_region region22[3];
 	struct flash_region region23;
 	struct pfm_image_signature sig2[3];
 	struct pfm_image_list list2;
@@ -6470,11 +10314,15 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_mod_lengt
 	sig1[0].sig_length = RSA_ENCRYPT_LEN;
 	sig1[0].always_validate = 1;
 
-	region12.start_addr = 0x30000;
-	region12.length = 32;
+	region12[0].start_addr = 0x30000;
+	region12[0].length = 32;
+	region12[1].start_addr = 0x60000;
+	region12[1].length = 64;
+	region12[2].start_addr = 0x90000;
+	region12[2].length = 128;
 
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
+	sig1[1].regions = region12;
+	sig1[1].count = 3;
 	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
 	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
 	sig1[1].sig_length = RSA_ENCRYPT_LEN;
@@ -6503,11 +10351,15 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_mod_lengt
 	sig2[0].sig_length = RSA_ENCRYPT_LEN;
 	sig2[0].always_validate = 1;
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	region22[0].start_addr = 0x30000;
+	region22[0].length = 32;
+	region22[1].start_addr = 0x60000;
+	region22[1].length = 64;
+	region22[2].start_addr = 0x90000;
+	region22[2].length = 128;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
+	sig2[1].regions = region22;
+	sig2[1].count = 3;
 	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
 	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
 	sig2[1].sig_length = RSA_ENCRYPT_LEN;
@@ -6519,7 +10371,6 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_mod_lengt
 	sig2[2].regions = &region23;
 	sig2[2].count = 1;
 	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	sig2[2].key.mod_length -= 1;
 	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
 	sig2[2].sig_length = RSA_ENCRYPT_LEN;
 	sig2[2].always_validate = 1;
@@ -6528,18 +10379,19 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_mod_lengt
 	list2.count = 3;
 
 	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
+	CuAssertIntEquals (test, false, status);
 }
 
-static void host_fw_are_images_different_test_multiple_images_diff_key_exponent (CuTest *test)
+static void host_fw_are_images_different_test_multiple_images_multiple_regions_diff_region_count (
+	CuTest *test)
 {
 	struct flash_region region11;
-	struct flash_region region12;
+	struct flash_region region12[3];
 	struct flash_region region13;
 	struct pfm_image_signature sig1[3];
 	struct pfm_image_list list1;
 	struct flash_region region21;
-	struct flash_region region22;
+	struct flash_region region22[3];
 	struct flash_region region23;
 	struct pfm_image_signature sig2[3];
 	struct pfm_image_list list2;
@@ -6557,11 +10409,15 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_exponent
 	sig1[0].sig_length = RSA_ENCRYPT_LEN;
 	sig1[0].always_validate = 1;
 
-	region12.start_addr = 0x30000;
-	region12.length = 32;
+	region12[0].start_addr = 0x30000;
+	region12[0].length = 32;
+	region12[1].start_addr = 0x60000;
+	region12[1].length = 64;
+	region12[2].start_addr = 0x90000;
+	region12[2].length = 128;
 
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
+	sig1[1].regions = region12;
+	sig1[1].count = 3;
 	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
 	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
 	sig1[1].sig_length = RSA_ENCRYPT_LEN;
@@ -6590,11 +10446,15 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_exponent
 	sig2[0].sig_length = RSA_ENCRYPT_LEN;
 	sig2[0].always_validate = 1;
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	region22[0].start_addr = 0x30000;
+	region22[0].length = 32;
+	region22[1].start_addr = 0x60000;
+	region22[1].length = 64;
+	region22[2].start_addr = 0x90000;
+	region22[2].length = 128;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
+	sig2[1].regions = region22;
+	sig2[1].count = 2;
 	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
 	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
 	sig2[1].sig_length = RSA_ENCRYPT_LEN;
@@ -6606,7 +10466,6 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_exponent
 	sig2[2].regions = &region23;
 	sig2[2].count = 1;
 	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	sig2[2].key.exponent = 3;
 	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
 	sig2[2].sig_length = RSA_ENCRYPT_LEN;
 	sig2[2].always_validate = 1;
@@ -6618,924 +10477,787 @@ static void host_fw_are_images_different_test_multiple_images_diff_key_exponent
 	CuAssertIntEquals (test, true, status);
 }
 
-static void host_fw_are_images_different_test_multiple_images_diff_key_modulus (CuTest *test)
+static void host_fw_are_images_different_test_null (CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12;
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
 	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22;
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
 	struct pfm_image_list list2;
 	bool status;
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
-
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
-
-	region12.start_addr = 0x30000;
-	region12.length = 32;
-
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
-
-	region13.start_addr = 0x50000;
-	region13.length = 16;
-
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
-
-	list1.images = sig1;
-	list1.count = 3;
-
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
 
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	list1.images = &sig1;
+	list1.count = 1;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN;
-	sig2[1].always_validate = 1;
+	region2.start_addr = 0x10000;
+	region2.length = 0x100;
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	sig2.regions = &region2;
+	sig2.count = 1;
+	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig2.sig_length = RSA_ENCRYPT_LEN;
+	sig2.always_validate = 1;
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	list2.images = &sig2;
+	list2.count = 1;
 
-	list2.images = sig2;
-	list2.count = 3;
+	status = host_fw_are_images_different (&list1, NULL);
+	CuAssertIntEquals (test, true, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
+	status = host_fw_are_images_different (NULL, &list2);
 	CuAssertIntEquals (test, true, status);
+
+	status = host_fw_are_images_different (NULL, NULL);
+	CuAssertIntEquals (test, false, status);
 }
 
-static void host_fw_are_images_different_test_multiple_images_diff_sig_length (CuTest *test)
+
+static void host_fw_full_flash_verification_incremental_test_no_dirty_map (CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12;
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
-	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22;
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	region12.start_addr = 0x30000;
-	region12.length = 32;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
 
-	region13.start_addr = 0x50000;
-	region13.length = 16;
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
 
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
+	CuAssertIntEquals (test, 0, status);
 
-	list1.images = sig1;
-	list1.count = 3;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN - 1;
-	sig2[1].always_validate = 1;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	memset (digests, 0, sizeof (digests));
 
-	list2.images = sig2;
-	list2.count = 3;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff, NULL,
+		digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
+	status = testing_validate_array (SIG_HASH_TEST, digests[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_images_diff_signature (CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_clean_image (CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12;
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
-	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22;
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	region12.start_addr = 0x30000;
-	region12.length = 32;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	region13.start_addr = 0x50000;
-	region13.length = 16;
+	status = flash_master_mock_expect_blank_check (&flash_mock, 0x500, 0x100);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	list1.images = sig1;
-	list1.count = 3;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN;
-	sig2[1].always_validate = 1;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	memset (map, 0, sizeof (map));
+	map[0] = 0x20;
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST2, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	memcpy (digests[0], SIG_HASH_TEST, SHA256_HASH_LENGTH);
 
-	list2.images = sig2;
-	list2.count = 3;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
+	status = testing_validate_array (SIG_HASH_TEST, digests[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_images_diff_validate_flag (CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_dirty_image (CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12;
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
-	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22;
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	region12.start_addr = 0x30000;
-	region12.length = 32;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	region13.start_addr = 0x50000;
-	region13.length = 16;
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
 
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x100 - strlen (data));
 
-	list1.images = sig1;
-	list1.count = 3;
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	memset (map, 0, sizeof (map));
+	map[0] = 0x01;
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN;
-	sig2[1].always_validate = 0;
+	memset (digests, 0, sizeof (digests));
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	status = testing_validate_array (SIG_HASH_TEST, digests[0], SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
-	list2.images = sig2;
-	list2.count = 3;
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_images_diff_image_count (CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_contiguous_dirty_blocks (
+	CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12;
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
-	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22;
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	region12.start_addr = 0x30000;
-	region12.length = 32;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[1].regions = &region12;
-	sig1[1].count = 1;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	region13.start_addr = 0x50000;
-	region13.length = 16;
+	status = flash_master_mock_expect_blank_check (&flash_mock, 0x400, 0x300);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xf00, 0x100);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	list1.images = sig1;
-	list1.count = 3;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	region22.start_addr = 0x30000;
-	region22.length = 32;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	sig2[1].regions = &region22;
-	sig2[1].count = 1;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN;
-	sig2[1].always_validate = 1;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	memset (map, 0, sizeof (map));
+	map[0] = 0x70;
+	map[1] = 0x80;
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	memcpy (digests[0], SIG_HASH_TEST, SHA256_HASH_LENGTH);
 
-	list2.images = sig2;
-	list2.count = 2;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_regions (CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_dirty_rw_region (CuTest *test)
 {
-	struct flash_region region1[3];
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2[3];
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region1[0].start_addr = 0x10000;
-	region1[0].length = 0x100;
-	region1[1].start_addr = 0x30000;
-	region1[1].length = 16;
-	region1[2].start_addr = 0x50000;
-	region1[2].length = 32;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1.regions = region1;
-	sig1.count = 3;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	list1.images = &sig1;
-	list1.count = 1;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	region2[0].start_addr = 0x10000;
-	region2[0].length = 0x100;
-	region2[1].start_addr = 0x30000;
-	region2[1].length = 16;
-	region2[2].start_addr = 0x50000;
-	region2[2].length = 32;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	sig2.regions = region2;
-	sig2.count = 3;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	list2.images = &sig2;
-	list2.count = 1;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, false, status);
+	img_list.images = &sig;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (map, 0, sizeof (map));
+	map[0] = 0x04;
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
+
+	memcpy (digests[0], SIG_HASH_TEST, SHA256_HASH_LENGTH);
+
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_regions_diff_addr (CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_short_map (CuTest *test)
 {
-	struct flash_region region1[3];
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2[3];
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region1[0].start_addr = 0x10000;
-	region1[0].length = 0x100;
-	region1[1].start_addr = 0x30000;
-	region1[1].length = 16;
-	region1[2].start_addr = 0x50000;
-	region1[2].length = 32;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1.regions = region1;
-	sig1.count = 3;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	list1.images = &sig1;
-	list1.count = 1;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	region2[0].start_addr = 0x10000;
-	region2[0].length = 0x100;
-	region2[1].start_addr = 0x30000;
-	region2[1].length = 16;
-	region2[2].start_addr = 0x60000;
-	region2[2].length = 32;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	sig2.regions = region2;
-	sig2.count = 3;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	status = flash_master_mock_expect_blank_check (&flash_mock, 0x800, 0x1000 - 0x800);
+	CuAssertIntEquals (test, 0, status);
 
-	list2.images = &sig2;
-	list2.count = 1;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
-}
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-static void host_fw_are_images_different_test_multiple_regions_diff_length (CuTest *test)
-{
-	struct flash_region region1[3];
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2[3];
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	TEST_START;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	region1[0].start_addr = 0x10000;
-	region1[0].length = 0x100;
-	region1[1].start_addr = 0x30000;
-	region1[1].length = 16;
-	region1[2].start_addr = 0x50000;
-	region1[2].length = 32;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	sig1.regions = region1;
-	sig1.count = 3;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	list1.images = &sig1;
-	list1.count = 1;
+	memset (map, 0, sizeof (map));
 
-	region2[0].start_addr = 0x10000;
-	region2[0].length = 0x100;
-	region2[1].start_addr = 0x30000;
-	region2[1].length = 24;
-	region2[2].start_addr = 0x50000;
-	region2[2].length = 32;
+	dirty.map = map;
+	dirty.length = 1;
+	dirty.block_size = 0x100;
 
-	sig2.regions = region2;
-	sig2.count = 3;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	memcpy (digests[0], SIG_HASH_TEST, SHA256_HASH_LENGTH);
 
-	list2.images = &sig2;
-	list2.count = 1;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_regions_diff_count (CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_clean_image_bad_digest (
+	CuTest *test)
 {
-	struct flash_region region1[3];
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2[3];
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region1[0].start_addr = 0x10000;
-	region1[0].length = 0x100;
-	region1[1].start_addr = 0x30000;
-	region1[1].length = 16;
-	region1[2].start_addr = 0x50000;
-	region1[2].length = 32;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1.regions = region1;
-	sig1.count = 3;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	list1.images = &sig1;
-	list1.count = 1;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	region2[0].start_addr = 0x10000;
-	region2[0].length = 0x100;
-	region2[1].start_addr = 0x30000;
-	region2[1].length = 16;
-	region2[2].start_addr = 0x50000;
-	region2[2].length = 32;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	sig2.regions = region2;
-	sig2.count = 2;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	list2.images = &sig2;
-	list2.count = 1;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
-}
+	img_list.images = &sig;
+	img_list.count = 1;
 
-static void host_fw_are_images_different_test_multiple_regions_reordered (CuTest *test)
-{
-	struct flash_region region1[3];
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2[3];
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	TEST_START;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	region1[0].start_addr = 0x10000;
-	region1[0].length = 0x100;
-	region1[1].start_addr = 0x30000;
-	region1[1].length = 16;
-	region1[2].start_addr = 0x50000;
-	region1[2].length = 32;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1.regions = region1;
-	sig1.count = 3;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	memset (map, 0, sizeof (map));
 
-	list1.images = &sig1;
-	list1.count = 1;
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
 
-	region2[0].start_addr = 0x50000;
-	region2[0].length = 32;
-	region2[1].start_addr = 0x10000;
-	region2[1].length = 0x100;
-	region2[2].start_addr = 0x30000;
-	region2[2].length = 16;
+	memset (digests, 0x55, sizeof (digests));
 
-	sig2.regions = region2;
-	sig2.count = 3;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
-	list2.images = &sig2;
-	list2.count = 1;
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, false, status);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_images_multiple_regions (CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_not_blank (CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12[3];
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
-	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22[3];
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	uint8_t read_data[0x100];
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
+	memset (read_data, 0xff, sizeof (read_data));
+	read_data[0x10] = 0;
 
-	region12[0].start_addr = 0x30000;
-	region12[0].length = 32;
-	region12[1].start_addr = 0x60000;
-	region12[1].length = 64;
-	region12[2].start_addr = 0x90000;
-	region12[2].length = 128;
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, read_data, sizeof (read_data),
+		FLASH_EXP_READ_CMD (0x03, 0x600, 0, -1, sizeof (read_data)));
 
-	sig1[1].regions = region12;
-	sig1[1].count = 3;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
+	CuAssertIntEquals (test, 0, status);
 
-	region13.start_addr = 0x50000;
-	region13.length = 16;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	list1.images = sig1;
-	list1.count = 3;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	region22[0].start_addr = 0x30000;
-	region22[0].length = 32;
-	region22[1].start_addr = 0x60000;
-	region22[1].length = 64;
-	region22[2].start_addr = 0x90000;
-	region22[2].length = 128;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	sig2[1].regions = region22;
-	sig2[1].count = 3;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN;
-	sig2[1].always_validate = 1;
+	memset (map, 0, sizeof (map));
+	map[0] = 0x40;
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	memcpy (digests[0], SIG_HASH_TEST, SHA256_HASH_LENGTH);
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
 
-	list2.images = sig2;
-	list2.count = 3;
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, false, status);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_are_images_different_test_multiple_images_multiple_regions_diff_region_count (
-	CuTest *test)
+static void host_fw_full_flash_verification_incremental_test_null (CuTest *test)
 {
-	struct flash_region region11;
-	struct flash_region region12[3];
-	struct flash_region region13;
-	struct pfm_image_signature sig1[3];
-	struct pfm_image_list list1;
-	struct flash_region region21;
-	struct flash_region region22[3];
-	struct flash_region region23;
-	struct pfm_image_signature sig2[3];
-	struct pfm_image_list list2;
-	bool status;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	uint8_t digests[1][SHA256_HASH_LENGTH];
+	uint8_t map[2];
+	struct host_fw_dirty_map dirty;
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	region11.start_addr = 0x10000;
-	region11.length = 0x100;
-
-	sig1[0].regions = &region11;
-	sig1[0].count = 1;
-	memcpy (&sig1[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1[0].sig_length = RSA_ENCRYPT_LEN;
-	sig1[0].always_validate = 1;
-
-	region12[0].start_addr = 0x30000;
-	region12[0].length = 32;
-	region12[1].start_addr = 0x60000;
-	region12[1].length = 64;
-	region12[2].start_addr = 0x90000;
-	region12[2].length = 128;
-
-	sig1[1].regions = region12;
-	sig1[1].count = 3;
-	memcpy (&sig1[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig1[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig1[1].sig_length = RSA_ENCRYPT_LEN;
-	sig1[1].always_validate = 1;
-
-	region13.start_addr = 0x50000;
-	region13.length = 16;
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1[2].regions = &region13;
-	sig1[2].count = 1;
-	memcpy (&sig1[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig1[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig1[2].sig_length = RSA_ENCRYPT_LEN;
-	sig1[2].always_validate = 1;
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
 
-	list1.images = sig1;
-	list1.count = 3;
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	region21.start_addr = 0x10000;
-	region21.length = 0x100;
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
 
-	sig2[0].regions = &region21;
-	sig2[0].count = 1;
-	memcpy (&sig2[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2[0].sig_length = RSA_ENCRYPT_LEN;
-	sig2[0].always_validate = 1;
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	region22[0].start_addr = 0x30000;
-	region22[0].length = 32;
-	region22[1].start_addr = 0x60000;
-	region22[1].length = 64;
-	region22[2].start_addr = 0x90000;
-	region22[2].length = 128;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	sig2[1].regions = region22;
-	sig2[1].count = 2;
-	memcpy (&sig2[1].key, &RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2));
-	memcpy (&sig2[1].signature, RSA_SIGNATURE2_TEST, RSA_ENCRYPT_LEN);
-	sig2[1].sig_length = RSA_ENCRYPT_LEN;
-	sig2[1].always_validate = 1;
+	img_list.images = &sig;
+	img_list.count = 1;
 
-	region23.start_addr = 0x50000;
-	region23.length = 16;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	sig2[2].regions = &region23;
-	sig2[2].count = 1;
-	memcpy (&sig2[2].key, &RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3));
-	memcpy (&sig2[2].signature, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN);
-	sig2[2].sig_length = RSA_ENCRYPT_LEN;
-	sig2[2].always_validate = 1;
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
 
-	list2.images = sig2;
-	list2.count = 3;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (&list1, &list2);
-	CuAssertIntEquals (test, true, status);
-}
+	memset (map, 0, sizeof (map));
 
-static void host_fw_are_images_different_test_null (CuTest *test)
-{
-	struct flash_region region1;
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2;
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	dirty.map = map;
+	dirty.length = sizeof (map);
+	dirty.block_size = 0x100;
 
-	TEST_START;
+	status = host_fw_full_flash_verification_incremental (NULL, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	status = host_fw_full_flash_verification_incremental (&flash, NULL, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	sig1.regions = &region1;
-	sig1.count = 1;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, NULL, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	list1.images = &sig1;
-	list1.count = 1;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, NULL, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	region2.start_addr = 0x10000;
-	region2.length = 0x100;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, NULL, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	sig2.regions = &region2;
-	sig2.count = 1;
-	memcpy (&sig2.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig2.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig2.sig_length = RSA_ENCRYPT_LEN;
-	sig2.always_validate = 1;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	list2.images = &sig2;
-	list2.count = 1;
+	dirty.block_size = 0;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_are_images_different (&list1, NULL);
-	CuAssertIntEquals (test, true, status);
+	dirty.block_size = 0x100;
+	dirty.map = NULL;
+	status = host_fw_full_flash_verification_incremental (&flash, &img_list, &rw_list, 0xff,
+		&dirty, digests, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_are_images_different (NULL, &list2);
-	CuAssertIntEquals (test, true, status);
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_are_images_different (NULL, NULL);
-	CuAssertIntEquals (test, false, status);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-
 CuSuite* get_host_fw_util_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -7570,8 +11292,16 @@ CuSuite* get_host_fw_util_suite ()
 	SUITE_ADD_TEST (suite, host_fw_verify_images_test_not_contiguous);
 	SUITE_ADD_TEST (suite, host_fw_verify_images_test_multiple);
 	SUITE_ADD_TEST (suite, host_fw_verify_images_test_multiple_one_invalid);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_cached_test);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_cached_test_cache_hit);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_cached_test_cache_not_trusted);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_cached_test_different_pfm);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_cached_test_invalid);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_cached_test_null);
 	SUITE_ADD_TEST (suite, host_fw_verify_images_test_partial_validation);
 	SUITE_ADD_TEST (suite, host_fw_verify_images_test_no_images);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_test_hash_pipeline);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_test_hash_pipeline_wrong_flash);
 	SUITE_ADD_TEST (suite, host_fw_verify_images_test_null);
 	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_test);
 	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_test_no_offset);
@@ -7582,6 +11312,21 @@ CuSuite* get_host_fw_util_suite ()
 	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_test_partial_validation);
 	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_test_no_images);
 	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_test_null);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_batch_test);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_batch_test_invalid);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_batch_test_hash_pipeline);
+	SUITE_ADD_TEST (suite, host_fw_verify_images_batch_test_null);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_multiple);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_multiple_one_invalid);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_adjacent_regions);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_interleaved);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_interleaved_one_engine);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_overlapping_regions);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_partial_validation);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_no_images);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_read_error);
+	SUITE_ADD_TEST (suite, host_fw_verify_offset_images_batch_test_hash_start_error);
 	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test);
 	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_not_blank_byte);
 	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_multiple_rw_regions);
@@ -7595,7 +11340,20 @@ CuSuite* get_host_fw_util_suite ()
 	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_invalid_image);
 	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_not_blank);
 	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_last_not_blank);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_hash_pipeline);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_hash_pipeline_not_blank);
 	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_test_null);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_interleaved_images);
+	SUITE_ADD_TEST (suite,
+		host_fw_full_flash_verification_single_pass_test_interleaved_images_one_engine);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_image_in_rw_region);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_no_images);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_invalid_image);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_not_blank);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_read_error);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_hash_pipeline);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_single_pass_test_null);
 	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test);
 	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test_multiple_regions);
 	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test_different_addresses);
@@ -7613,6 +11371,8 @@ CuSuite* get_host_fw_util_suite ()
 	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test_null);
 	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test_erase_error);
 	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test_copy_error);
+	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test_copy_stream);
+	SUITE_ADD_TEST (suite, host_fw_migrate_read_write_data_test_copy_stream_wrong_flash);
 	SUITE_ADD_TEST (suite, host_fw_are_read_write_regions_different_test);
 	SUITE_ADD_TEST (suite, host_fw_are_read_write_regions_different_test_different_address);
 	SUITE_ADD_TEST (suite, host_fw_are_read_write_regions_different_test_different_size);
@@ -7633,6 +11393,8 @@ CuSuite* get_host_fw_util_suite ()
 	SUITE_ADD_TEST (suite, host_fw_restore_flash_device_test_erase_error);
 	SUITE_ADD_TEST (suite, host_fw_restore_flash_device_test_last_erase_error);
 	SUITE_ADD_TEST (suite, host_fw_restore_flash_device_test_copy_error);
+	SUITE_ADD_TEST (suite, host_fw_restore_flash_device_test_copy_stream);
+	SUITE_ADD_TEST (suite, host_fw_restore_flash_device_test_copy_stream_wrong_flash);
 	SUITE_ADD_TEST (suite, host_fw_config_spi_filter_read_write_regions_test);
 	SUITE_ADD_TEST (suite, host_fw_config_spi_filter_read_write_regions_test_multiple_regions);
 	SUITE_ADD_TEST (suite, host_fw_config_spi_filter_read_write_regions_test_null);
@@ -7664,6 +11426,16 @@ CuSuite* get_host_fw_util_suite ()
 	SUITE_ADD_TEST (suite,
 		host_fw_are_images_different_test_multiple_images_multiple_regions_diff_region_count);
 	SUITE_ADD_TEST (suite, host_fw_are_images_different_test_null);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_no_dirty_map);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_clean_image);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_dirty_image);
+	SUITE_ADD_TEST (suite,
+		host_fw_full_flash_verification_incremental_test_contiguous_dirty_blocks);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_dirty_rw_region);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_short_map);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_clean_image_bad_digest);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_not_blank);
+	SUITE_ADD_TEST (suite, host_fw_full_flash_verification_incremental_test_null);
 
 	return suite;
 }
@@ -0,0 +1,986 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "testing.h"
+#include "host_fw/host_fw_verification_cache.h"
+#include "flash/flash_common.h"
+#include "mock/flash_mock.h"
+#include "engines/hash_testing_engine.h"
+
+
+static const char *SUITE = "host_fw_verification_cache";
+
+
+/**
+ * Dummy image ID for testing.
+ */
+static const uint8_t IMAGE_ID_TESTING[] = {
+	0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10,
+	0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,0x20
+};
+
+/**
+ * Device key used to authenticate the cache for testing.
+ */
+static const uint8_t CACHE_KEY_TESTING[] = {
+	0x51,0x52,0x53,0x54,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f,0x60,
+	0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,0x70
+};
+
+/**
+ * Dummy image digest for testing.
+ */
+static const uint8_t DIGEST_TESTING[] = {
+	0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf,0xb0,
+	0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0xc0
+};
+
+
+/**
+ * Build a valid cache record containing a single image entry.
+ *
+ * @param test The testing framework.
+ * @param hash The hash engine to use for the record HMAC.
+ * @param record The record to build.
+ * @param flash_id The flash ID for the record.
+ * @param pfm_id The PFM ID for the record.
+ */
+static void host_fw_verification_cache_testing_build_record (CuTest *test,
+	struct hash_engine *hash, struct host_fw_verification_cache_record *record, uint8_t flash_id,
+	uint32_t pfm_id)
+{
+	int status;
+
+	memset (record, 0, sizeof (*record));
+	record->marker = 0xcac4;
+	record->flash_id = flash_id;
+	record->count = 1;
+	record->pfm_id = pfm_id;
+	record->entry[0].image_index = 0;
+	memcpy (record->entry[0].image_id, IMAGE_ID_TESTING, SHA256_HASH_LENGTH);
+	memcpy (record->entry[0].digest, DIGEST_TESTING, SHA256_HASH_LENGTH);
+
+	status = hash_generate_hmac (hash, CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING),
+		(uint8_t*) record, offsetof (struct host_fw_verification_cache_record, check), HMAC_SHA256,
+		record->check, SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a verification cache for testing.
+ *
+ * @param test The testing framework.
+ * @param cache The cache to initialize.
+ * @param flash The mock for the cache flash.
+ * @param hash The hash engine to use.
+ * @param stored The contents of flash to load.
+ */
+static void host_fw_verification_cache_testing_init (CuTest *test,
+	struct host_fw_verification_cache *cache, struct flash_mock *flash, struct hash_engine *hash,
+	const struct host_fw_verification_cache_record *stored)
+{
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	status = flash_mock_init (flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash->mock, flash->base.get_sector_size, flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash->mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash->mock, flash->base.read, flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (*stored)));
+	status |= mock_expect_output (&flash->mock, 1, stored, sizeof (*stored), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_init (cache, &flash->base, 0x10000, hash,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash->mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a verification cache with blank flash for testing.
+ *
+ * @param test The testing framework.
+ * @param cache The cache to initialize.
+ * @param flash The mock for the cache flash.
+ * @param hash The hash engine to use.
+ */
+static void host_fw_verification_cache_testing_init_blank (CuTest *test,
+	struct host_fw_verification_cache *cache, struct flash_mock *flash, struct hash_engine *hash)
+{
+	struct host_fw_verification_cache_record blank;
+
+	memset (&blank, 0xff, sizeof (blank));
+	host_fw_verification_cache_testing_init (test, cache, flash, hash, &blank);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void host_fw_verification_cache_test_init_blank (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	status = host_fw_verification_cache_find (&cache, 0, 0, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = host_fw_verification_cache_find (&cache, 0xff, 0xffffffff, 0xff, IMAGE_ID_TESTING,
+		digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_stored_record (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (DIGEST_TESTING, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_bad_check (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	stored.entry[0].digest[0] ^= 0x55;
+
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_unauthenticated_record (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+
+	/* A record with a plain digest for the check, as could be generated without the device key. */
+	status = hash.base.calculate_sha256 (&hash.base, (uint8_t*) &stored,
+		offsetof (struct host_fw_verification_cache_record, check), stored.check,
+		SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_bad_count (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	stored.count = HOST_FW_VERIFICATION_CACHE_MAX_IMAGES + 1;
+
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_init (NULL, &flash.base, 0x10000, &hash.base,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_init (&cache, NULL, 0x10000, &hash.base,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_init (&cache, &flash.base, 0x10000, NULL,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_init (&cache, &flash.base, 0x10000, &hash.base, NULL,
+		sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_init (&cache, &flash.base, 0x10000, &hash.base,
+		CACHE_KEY_TESTING, 0);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_not_sector_aligned (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_init (&cache, &flash.base, 0x10100, &hash.base,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NOT_SECTOR_ALIGNED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_sector_too_small (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	uint32_t bytes = 256;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_init (&cache, &flash.base, 0x10000, &hash.base,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_SECTOR_TOO_SMALL, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_sector_size_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_init (&cache, &flash.base, 0x10000, &hash.base,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_init_read_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (struct host_fw_verification_cache_record)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_init (&cache, &flash.base, 0x10000, &hash.base,
+		CACHE_KEY_TESTING, sizeof (CACHE_KEY_TESTING));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	host_fw_verification_cache_release (NULL);
+}
+
+static void host_fw_verification_cache_test_find_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	status = host_fw_verification_cache_find (NULL, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, NULL, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, NULL);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_find_mismatch (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t image_id[SHA256_HASH_LENGTH];
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	memcpy (image_id, IMAGE_ID_TESTING, sizeof (image_id));
+	image_id[SHA256_HASH_LENGTH - 1] ^= 0x55;
+
+	status = host_fw_verification_cache_find (&cache, 0, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x11, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 1, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, image_id, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_update (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 2, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 2, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (DIGEST_TESTING, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_update_replace_entry (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t image_id[SHA256_HASH_LENGTH];
+	uint8_t new_digest[SHA256_HASH_LENGTH];
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	memcpy (image_id, IMAGE_ID_TESTING, sizeof (image_id));
+	image_id[0] ^= 0x55;
+
+	memcpy (new_digest, DIGEST_TESTING, sizeof (new_digest));
+	new_digest[0] ^= 0x55;
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 0, image_id, new_digest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, image_id, digest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (new_digest, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_update_different_pfm (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x11, 1, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x11, 1, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x11, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_update_full (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	for (i = 0; i < HOST_FW_VERIFICATION_CACHE_MAX_IMAGES; i++) {
+		status = host_fw_verification_cache_update (&cache, 1, 0x10, i, IMAGE_ID_TESTING,
+			DIGEST_TESTING);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, i, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_FULL, status);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 0, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_update_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	status = host_fw_verification_cache_update (NULL, 1, 0x10, 0, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 0, NULL, DIGEST_TESTING);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, NULL);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_store (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record expected;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &expected, 1, 0x10);
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 0, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, sizeof (expected),
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	status |= flash_mock_expect_data_check (&flash, 0x10000, (uint8_t*) &expected,
+		sizeof (expected));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_store (&cache);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Nothing has changed, so nothing will be written. */
+	status = host_fw_verification_cache_store (&cache);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_store_not_modified (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 0, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_store (&cache);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_store_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = host_fw_verification_cache_store (NULL);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+}
+
+static void host_fw_verification_cache_test_store_write_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record expected;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &expected, 1, 0x10);
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	status = host_fw_verification_cache_update (&cache, 1, 0x10, 0, IMAGE_ID_TESTING,
+		DIGEST_TESTING);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_store (&cache);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	/* The partially written sector must be erased. */
+	status = flash_mock_expect_erase_flash_sector (&flash, 0x10000, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_invalidate (&cache);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_invalidate (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = flash_mock_expect_erase_flash_sector (&flash, 0x10000, sizeof (stored));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_invalidate (&cache);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	/* The flash is already blank, so it will not be erased again. */
+	status = host_fw_verification_cache_invalidate (&cache);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_invalidate_blank (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_init_blank (test, &cache, &flash, &hash.base);
+
+	status = host_fw_verification_cache_invalidate (&cache);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void host_fw_verification_cache_test_invalidate_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = host_fw_verification_cache_invalidate (NULL);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_INVALID_ARGUMENT, status);
+}
+
+static void host_fw_verification_cache_test_invalidate_erase_error (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	struct host_fw_verification_cache cache;
+	struct host_fw_verification_cache_record stored;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_testing_build_record (test, &hash.base, &stored, 1, 0x10);
+	host_fw_verification_cache_testing_init (test, &cache, &flash, &hash.base, &stored);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verification_cache_invalidate (&cache);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	/* The cached images are discarded, even though the flash could not be erased. */
+	status = host_fw_verification_cache_find (&cache, 1, 0x10, 0, IMAGE_ID_TESTING, digest);
+	CuAssertIntEquals (test, HOST_FW_VERIFICATION_CACHE_NO_ENTRY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	host_fw_verification_cache_release (&cache);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+
+CuSuite* get_host_fw_verification_cache_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_blank);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_stored_record);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_bad_check);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_unauthenticated_record);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_bad_count);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_null);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_not_sector_aligned);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_sector_too_small);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_sector_size_error);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_init_read_error);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_release_null);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_find_null);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_find_mismatch);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_update);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_update_replace_entry);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_update_different_pfm);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_update_full);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_update_null);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_store);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_store_not_modified);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_store_null);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_store_write_error);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_invalidate);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_invalidate_blank);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_invalidate_null);
+	SUITE_ADD_TEST (suite, host_fw_verification_cache_test_invalidate_erase_error);
+
+	return suite;
+}
@@ -2132,6 +2132,122 @@ static void host_processor_dual_test_get_next_reset_verification_actions_null (C
 }
 
 
+static void host_processor_dual_test_enable_incremental_verification (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	CuAssertPtrEquals (test, NULL, host.test.dirty_map);
+	CuAssertPtrEquals (test, NULL, host.test.digests.digest);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 32);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, host.test.dirty_map);
+	CuAssertIntEquals (test, 32, host.test.dirty_map_length);
+	CuAssertPtrNotNull (test, host.test.digests.digest);
+	CuAssertIntEquals (test, 4, host.test.digests.max_images);
+	CuAssertIntEquals (test, false, host.test.digests.valid);
+	CuAssertPtrEquals (test, NULL, host.test.digests_pfm);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_enable_incremental_verification_twice (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 32);
+	CuAssertIntEquals (test, 0, status);
+
+	host.test.digests.valid = true;
+	host.test.digests_pfm = &host.pfm.base;
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 8, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, host.test.dirty_map);
+	CuAssertIntEquals (test, 64, host.test.dirty_map_length);
+	CuAssertPtrNotNull (test, host.test.digests.digest);
+	CuAssertIntEquals (test, 8, host.test.digests.max_images);
+	CuAssertIntEquals (test, false, host.test.digests.valid);
+	CuAssertPtrEquals (test, NULL, host.test.digests_pfm);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_enable_incremental_verification_null (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (NULL, 4, 32);
+	CuAssertIntEquals (test, HOST_PROCESSOR_INVALID_ARGUMENT, status);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 0, 32);
+	CuAssertIntEquals (test, HOST_PROCESSOR_INVALID_ARGUMENT, status);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 0);
+	CuAssertIntEquals (test, HOST_PROCESSOR_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, host.test.dirty_map);
+	CuAssertPtrEquals (test, NULL, host.test.digests.digest);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_set_verification_cache (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_fw_verification_cache cache;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	CuAssertPtrEquals (test, NULL, host.test.verify_cache);
+
+	host.test.verify_cache_trusted = true;
+
+	status = host_processor_dual_set_verification_cache (&host.test, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, &cache, host.test.verify_cache);
+	CuAssertIntEquals (test, false, host.test.verify_cache_trusted);
+
+	status = host_processor_dual_set_verification_cache (&host.test, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, host.test.verify_cache);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_set_verification_cache_null (CuTest *test)
+{
+	struct host_fw_verification_cache cache;
+	int status;
+
+	TEST_START;
+
+	status = host_processor_dual_set_verification_cache (NULL, &cache);
+	CuAssertIntEquals (test, HOST_PROCESSOR_INVALID_ARGUMENT, status);
+}
+
 CuSuite* get_host_processor_dual_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -2241,6 +2357,11 @@ CuSuite* get_host_processor_dual_suite ()
 	SUITE_ADD_TEST (suite,
 		host_processor_dual_test_get_next_reset_verification_actions_pending_pfm_with_active_dirty_checked_prevalidated_flash_and_pfm_bypass);
 	SUITE_ADD_TEST (suite, host_processor_dual_test_get_next_reset_verification_actions_null);
+	SUITE_ADD_TEST (suite, host_processor_dual_test_enable_incremental_verification);
+	SUITE_ADD_TEST (suite, host_processor_dual_test_enable_incremental_verification_twice);
+	SUITE_ADD_TEST (suite, host_processor_dual_test_enable_incremental_verification_null);
+	SUITE_ADD_TEST (suite, host_processor_dual_test_set_verification_cache);
+	SUITE_ADD_TEST (suite, host_processor_dual_test_set_verification_cache_null);
 
 	return suite;
 }
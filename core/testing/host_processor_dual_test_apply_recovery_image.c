@@ -45,7 +45,7 @@ static void host_processor_dual_test_apply_recovery_image (CuTest *test)
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -100,7 +100,7 @@ static void host_processor_dual_test_apply_recovery_image_pulse_reset (CuTest *t
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -161,7 +161,7 @@ static void host_processor_dual_test_apply_recovery_image_no_observer (CuTest *t
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -221,7 +221,7 @@ static void host_processor_dual_test_apply_recovery_image_bypass (CuTest *test)
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
 		&host.flash_mgr, 0, MOCK_ARG (&host.control));
@@ -270,7 +270,7 @@ static void host_processor_dual_test_apply_recovery_image_no_reset (CuTest *test
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -322,7 +322,7 @@ static void host_processor_dual_test_apply_recovery_image_no_reset_pulse_reset (
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -483,7 +483,7 @@ static void host_processor_dual_test_apply_recovery_image_bypass_unsupported_fla
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
 		&host.flash_mgr, 0, MOCK_ARG (&host.control));
@@ -790,7 +790,7 @@ static void host_processor_dual_test_apply_recovery_image_bad_image (CuTest *tes
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image,
-		RECOVERY_IMAGE_HEADER_BAD_FORMAT_LENGTH, MOCK_ARG_NOT_NULL);
+		RECOVERY_IMAGE_HEADER_BAD_FORMAT_LENGTH, MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
 		&host.flash_mgr, 0, MOCK_ARG (&host.control));
@@ -839,7 +839,7 @@ static void host_processor_dual_test_apply_recovery_image_bad_image_pulse_reset
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image,
-		RECOVERY_IMAGE_HEADER_BAD_FORMAT_LENGTH, MOCK_ARG_NOT_NULL);
+		RECOVERY_IMAGE_HEADER_BAD_FORMAT_LENGTH, MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
 		&host.flash_mgr, 0, MOCK_ARG (&host.control));
@@ -893,7 +893,7 @@ static void host_processor_dual_test_apply_recovery_image_clear_rw_region_error
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, SPI_FILTER_CLEAR_RW_FAILED);
@@ -957,7 +957,7 @@ static void host_processor_dual_test_apply_recovery_image_clear_rw_region_error_
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, SPI_FILTER_CLEAR_RW_FAILED);
@@ -1025,7 +1025,7 @@ static void host_processor_dual_test_apply_recovery_image_spi_filter_config_erro
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -1093,7 +1093,7 @@ static void host_processor_dual_test_apply_recovery_image_spi_filter_config_erro
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -1166,7 +1166,7 @@ static void host_processor_dual_test_apply_recovery_image_set_flash_for_host_acc
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
@@ -1230,7 +1230,7 @@ static void host_processor_dual_test_apply_recovery_image_set_flash_for_host_acc
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
-		MOCK_ARG_NOT_NULL);
+		MOCK_ARG_NOT_NULL, MOCK_ARG (NULL));
 
 	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
 		&host.filter, 0);
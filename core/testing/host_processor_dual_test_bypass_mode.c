@@ -373,6 +373,46 @@ static void host_processor_dual_test_bypass_mode_host_access_error (CuTest *test
 }
 
 
+static void host_processor_dual_test_bypass_mode_discard_image_digests (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 32);
+	CuAssertIntEquals (test, 0, status);
+
+	host.test.digests.valid = true;
+	host.test.digests_pfm = &host.pfm.base;
+
+	status = mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
+		&host.filter, 0);
+	status |= mock_expect (&host.filter.mock, host.filter.base.set_filter_rw_region, &host.filter,
+		0, MOCK_ARG (1), MOCK_ARG (0), MOCK_ARG (0xffff0000));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.set_ro_cs, &host.filter, 0,
+		MOCK_ARG (SPI_FILTER_CS_1));
+
+	status |= mock_expect (&host.observer.mock, host.observer.base.on_bypass_mode, &host.observer,
+		0);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.bypass_mode (&host.test.base, false);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, host.test.digests.valid);
+	CuAssertPtrEquals (test, NULL, host.test.digests_pfm);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
 CuSuite* get_host_processor_dual_bypass_mode_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -386,6 +426,7 @@ CuSuite* get_host_processor_dual_bypass_mode_suite ()
 	SUITE_ADD_TEST (suite, host_processor_dual_test_bypass_mode_null);
 	SUITE_ADD_TEST (suite, host_processor_dual_test_bypass_mode_filter_error);
 	SUITE_ADD_TEST (suite, host_processor_dual_test_bypass_mode_host_access_error);
+	SUITE_ADD_TEST (suite, host_processor_dual_test_bypass_mode_discard_image_digests);
 
 	return suite;
 }
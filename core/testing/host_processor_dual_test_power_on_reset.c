@@ -11115,6 +11115,366 @@ static void host_processor_dual_test_power_on_reset_pending_pfm_with_active_dirt
 }
 
 
+static void host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache (
+	CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_fw_verification_cache cache;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	bool enabled = true;
+	spi_filter_bypass_mode bypass = SPI_FILTER_OPERATE;
+	spi_filter_cs ro = SPI_FILTER_CS_0;
+	spi_filter_flash_state state = SPI_FILTER_FLASH_STATE_NORMAL;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	memset (&cache, 0, sizeof (cache));
+
+	status = host_processor_dual_set_verification_cache (&host.test, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = mock_expect (&host.filter.mock, host.filter.base.get_filter_enabled, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &enabled, sizeof (enabled), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_bypass_mode, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &bypass, sizeof (bypass), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_ro_cs, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &ro, sizeof (ro), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_flash_dirty_state,
+		&host.filter, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &state, sizeof (state), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.config_spi_filter_flash_type,
+		&host.flash_mgr, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_only_flash_cached, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (NULL), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa),
+		MOCK_ARG (&cache), MOCK_ARG (true), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 6, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 6, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
+		&host.filter, 0);
+	status |= mock_expect (&host.filter.mock, host.filter.base.set_filter_rw_region,
+		&host.filter, 0, MOCK_ARG (1), MOCK_ARG (0x200), MOCK_ARG (0x300));
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.config_spi_filter_flash_devices, &host.flash_mgr, 0);
+
+	status |= mock_expect (&host.observer.mock, host.observer.base.on_active_mode, &host.observer,
+		0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.power_on_reset (&host.test.base, &host.hash.base, &host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_bypass_mode (&host.host_state);
+	CuAssertIntEquals (test, false, status);
+
+	CuAssertIntEquals (test, false, host.test.verify_cache_trusted);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache_flash_dirty (
+	CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_fw_verification_cache cache;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	bool enabled = true;
+	spi_filter_bypass_mode bypass = SPI_FILTER_OPERATE;
+	spi_filter_cs ro = SPI_FILTER_CS_0;
+	spi_filter_flash_state state = SPI_FILTER_FLASH_STATE_DIRTY;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	memset (&cache, 0, sizeof (cache));
+
+	status = host_processor_dual_set_verification_cache (&host.test, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = mock_expect (&host.filter.mock, host.filter.base.get_filter_enabled, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &enabled, sizeof (enabled), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_bypass_mode, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &bypass, sizeof (bypass), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_ro_cs, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &ro, sizeof (ro), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_flash_dirty_state,
+		&host.filter, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &state, sizeof (state), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.config_spi_filter_flash_type,
+		&host.flash_mgr, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_only_flash_cached, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (NULL), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa),
+		MOCK_ARG (&cache), MOCK_ARG (false), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 6, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 6, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
+		&host.filter, 0);
+	status |= mock_expect (&host.filter.mock, host.filter.base.set_filter_rw_region,
+		&host.filter, 0, MOCK_ARG (1), MOCK_ARG (0x200), MOCK_ARG (0x300));
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.config_spi_filter_flash_devices, &host.flash_mgr, 0);
+
+	status |= mock_expect (&host.observer.mock, host.observer.base.on_active_mode, &host.observer,
+		0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.power_on_reset (&host.test.base, &host.hash.base, &host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_bypass_mode (&host.host_state);
+	CuAssertIntEquals (test, false, status);
+
+	CuAssertIntEquals (test, false, host.test.verify_cache_trusted);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache_filter_disabled (
+	CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_fw_verification_cache cache;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	bool enabled = false;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	memset (&cache, 0, sizeof (cache));
+
+	status = host_processor_dual_set_verification_cache (&host.test, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = mock_expect (&host.filter.mock, host.filter.base.get_filter_enabled, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &enabled, sizeof (enabled), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.config_spi_filter_flash_type,
+		&host.flash_mgr, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_only_flash_cached, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (NULL), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa),
+		MOCK_ARG (&cache), MOCK_ARG (false), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 6, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 6, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
+		&host.filter, 0);
+	status |= mock_expect (&host.filter.mock, host.filter.base.set_filter_rw_region,
+		&host.filter, 0, MOCK_ARG (1), MOCK_ARG (0x200), MOCK_ARG (0x300));
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.config_spi_filter_flash_devices, &host.flash_mgr, 0);
+
+	status |= mock_expect (&host.observer.mock, host.observer.base.on_active_mode, &host.observer,
+		0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.power_on_reset (&host.test.base, &host.hash.base, &host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_bypass_mode (&host.host_state);
+	CuAssertIntEquals (test, false, status);
+
+	CuAssertIntEquals (test, false, host.test.verify_cache_trusted);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache_ro_cs_mismatch (
+	CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_fw_verification_cache cache;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	bool enabled = true;
+	spi_filter_bypass_mode bypass = SPI_FILTER_OPERATE;
+	spi_filter_cs ro = SPI_FILTER_CS_1;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	memset (&cache, 0, sizeof (cache));
+
+	status = host_processor_dual_set_verification_cache (&host.test, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = mock_expect (&host.filter.mock, host.filter.base.get_filter_enabled, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &enabled, sizeof (enabled), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_bypass_mode, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &bypass, sizeof (bypass), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_ro_cs, &host.filter, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 0, &ro, sizeof (ro), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.config_spi_filter_flash_type,
+		&host.flash_mgr, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_only_flash_cached, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (NULL), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa),
+		MOCK_ARG (&cache), MOCK_ARG (false), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 6, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 6, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
+		&host.filter, 0);
+	status |= mock_expect (&host.filter.mock, host.filter.base.set_filter_rw_region,
+		&host.filter, 0, MOCK_ARG (1), MOCK_ARG (0x200), MOCK_ARG (0x300));
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.config_spi_filter_flash_devices, &host.flash_mgr, 0);
+
+	status |= mock_expect (&host.observer.mock, host.observer.base.on_active_mode, &host.observer,
+		0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.power_on_reset (&host.test.base, &host.hash.base, &host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_bypass_mode (&host.host_state);
+	CuAssertIntEquals (test, false, status);
+
+	CuAssertIntEquals (test, false, host.test.verify_cache_trusted);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
 CuSuite* get_host_processor_dual_power_on_reset_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -11381,6 +11741,14 @@ CuSuite* get_host_processor_dual_power_on_reset_suite ()
 		host_processor_dual_test_power_on_reset_pending_pfm_with_active_dirty_active_ro_config_error);
 	SUITE_ADD_TEST (suite,
 		host_processor_dual_test_power_on_reset_pending_pfm_with_active_dirty_active_ro_filter_error);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache_flash_dirty);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache_filter_disabled);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_power_on_reset_active_pfm_not_dirty_verification_cache_ro_cs_mismatch);
 
 	return suite;
 }
@@ -8658,6 +8658,760 @@ static void host_processor_dual_test_run_time_verification_pending_pfm_with_acti
 }
 
 
+static void host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	uint32_t pfm_id = 1;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_inactive_dirty (&host.host_state);
+	CuAssertIntEquals (test, true, status);
+
+	CuAssertIntEquals (test, HOST_STATE_PREVALIDATED_FLASH,
+		host_state_manager_get_run_time_validation (&host.host_state));
+
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+	CuAssertIntEquals (test, 1, host.test.digests_pfm_id);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_no_dirty_block_support (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+	host.filter.base.get_flash_dirty_blocks = NULL;
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.validate_read_write_flash,
+		&host.flash_mgr, 0, MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 3, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 3, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, HOST_STATE_PREVALIDATED_FLASH,
+		host_state_manager_get_run_time_validation (&host.host_state));
+
+	CuAssertPtrEquals (test, NULL, host.test.digests_pfm);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_dirty_blocks (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	uint32_t pfm_id = 1;
+	uint32_t block_size = 0x1000;
+	uint8_t map = 0x04;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	/* Populate the image digests with a full verification. */
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 1);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 1, &host.pfm.mock, 1);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+
+	status = mock_validate (&host.flash_mgr.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	host.test.digests.valid = true;
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_flash_dirty_blocks,
+		&host.filter, 1, MOCK_ARG (host.test.dirty_map), MOCK_ARG (2), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 2, &block_size, sizeof (block_size), -1);
+	status |= mock_expect_output (&host.filter.mock, 0, &map, sizeof (map), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_inactive_dirty (&host.host_state);
+	CuAssertIntEquals (test, true, status);
+
+	CuAssertIntEquals (test, HOST_STATE_PREVALIDATED_FLASH,
+		host_state_manager_get_run_time_validation (&host.host_state));
+
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+	CuAssertIntEquals (test, 1, host.test.digests_pfm_id);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_different_pfm_id (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	uint32_t pfm_id = 1;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	/* Populate the image digests with a full verification. */
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 1);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 1, &host.pfm.mock, 1);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+
+	status = mock_validate (&host.flash_mgr.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	host.test.digests.valid = true;
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_id = 2;
+
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_inactive_dirty (&host.host_state);
+	CuAssertIntEquals (test, true, status);
+
+	CuAssertIntEquals (test, HOST_STATE_PREVALIDATED_FLASH,
+		host_state_manager_get_run_time_validation (&host.host_state));
+
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+	CuAssertIntEquals (test, 2, host.test.digests_pfm_id);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_dirty_blocks_unsupported (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	uint32_t pfm_id = 1;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	/* Populate the image digests with a full verification. */
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 1);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 1, &host.pfm.mock, 1);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+
+	status = mock_validate (&host.flash_mgr.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	host.test.digests.valid = true;
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_flash_dirty_blocks,
+		&host.filter, SPI_FILTER_UNSUPPORTED_OPERATION, MOCK_ARG (host.test.dirty_map), MOCK_ARG (2), MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_inactive_dirty (&host.host_state);
+	CuAssertIntEquals (test, true, status);
+
+	CuAssertIntEquals (test, HOST_STATE_PREVALIDATED_FLASH,
+		host_state_manager_get_run_time_validation (&host.host_state));
+
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+	CuAssertIntEquals (test, 1, host.test.digests_pfm_id);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_pfm_id_error (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	uint32_t pfm_id = 1;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	/* Populate the image digests with a full verification. */
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 1);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 1, &host.pfm.mock, 1);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+
+	status = mock_validate (&host.flash_mgr.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	host.test.digests.valid = true;
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm,
+		MANIFEST_NO_MEMORY, MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 0);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 0, &host.pfm.mock, 0);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, HOST_STATE_PREVALIDATED_FLASH,
+		host_state_manager_get_run_time_validation (&host.host_state));
+
+	CuAssertPtrEquals (test, NULL, host.test.digests_pfm);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_validation_fail (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+	struct flash_region rw_region;
+	struct pfm_read_write_regions rw_list;
+	uint32_t pfm_id = 1;
+	uint32_t block_size = 0x1000;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	status = host_processor_dual_enable_incremental_verification (&host.test, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_list.regions = &rw_region;
+	rw_list.count = 1;
+
+	/* Populate the image digests with a full verification. */
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, 0,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG (NULL),
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.flash_mgr.mock, 5, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&host.flash_mgr.mock, 5, 1);
+	status |= mock_expect_share_save_arg (&host.flash_mgr.mock, 1, &host.pfm.mock, 1);
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.free_read_write_regions, &host.pfm, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &host.pfm, host.test.digests_pfm);
+
+	status = mock_validate (&host.flash_mgr.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	host.test.digests.valid = true;
+
+	status = host_state_manager_save_inactive_dirty (&host.host_state, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		(intptr_t) &host.pfm);
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_pending_pfm, &host.pfm_mgr,
+		(intptr_t) NULL);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	status |= mock_expect (&host.pfm.mock, host.pfm.base.base.get_id, &host.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.pfm.mock, 0, &pfm_id, sizeof (pfm_id), -1);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.get_flash_dirty_blocks,
+		&host.filter, 0, MOCK_ARG (host.test.dirty_map), MOCK_ARG (2), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&host.filter.mock, 2, &block_size, sizeof (block_size), -1);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.validate_read_write_flash_incremental, &host.flash_mgr, RSA_ENGINE_BAD_SIGNATURE,
+		MOCK_ARG (&host.pfm), MOCK_ARG (&host.hash), MOCK_ARG (&host.rsa), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (&host.test.digests), MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_flash_dirty_state,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.free_pfm, &host.pfm_mgr, 0,
+		MOCK_ARG (&host.pfm));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG (&host.control));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.run_time_verification (&host.test.base, &host.hash.base,
+		&host.rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = host_state_manager_is_inactive_dirty (&host.host_state);
+	CuAssertIntEquals (test, false, status);
+
+	CuAssertIntEquals (test, HOST_STATE_PREVALIDATED_NONE,
+		host_state_manager_get_run_time_validation (&host.host_state));
+
+	CuAssertPtrEquals (test, NULL, host.test.digests_pfm);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
 CuSuite* get_host_processor_dual_run_time_verification_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -8902,6 +9656,20 @@ CuSuite* get_host_processor_dual_run_time_verification_suite ()
 		host_processor_dual_test_run_time_verification_pending_pfm_with_active_dirty_bypass_active_init_error);
 	SUITE_ADD_TEST (suite,
 		host_processor_dual_test_run_time_verification_pending_pfm_with_active_dirty_bypass_active_filter_error);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_no_dirty_block_support);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_dirty_blocks);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_different_pfm_id);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_dirty_blocks_unsupported);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_pfm_id_error);
+	SUITE_ADD_TEST (suite,
+		host_processor_dual_test_run_time_verification_active_pfm_dirty_incremental_validation_fail);
 
 	return suite;
 }
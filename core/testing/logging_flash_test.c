@@ -21,6 +21,25 @@ struct logging_entry_header_ca {
 	uint32_t entry_id;
 } __attribute__ ((__packed__));
 
+/**
+ * Observer to track flash log notifications.
+ */
+struct logging_flash_testing_observer {
+	struct logging_flash_observer base;		/**< The base observer instance. */
+	int count;								/**< Number of flush notifications received. */
+	struct logging_flash *logging;			/**< The log sent with the last notification. */
+};
+
+static void logging_flash_testing_on_flush_needed (struct logging_flash_observer *observer,
+	struct logging_flash *logging)
+{
+	struct logging_flash_testing_observer *testing =
+		(struct logging_flash_testing_observer*) observer;
+
+	testing->count++;
+	testing->logging = logging;
+}
+
 
 /*******************
  * Test cases
@@ -18466,6 +18485,1233 @@ static void logging_flash_test_clear_erase_error (CuTest *test)
 }
 
 
+static void logging_flash_test_set_overflow_policy_drop_full_buffer (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t entry_data[entry_full + entry_len];
+	uint8_t output[entry_full + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < entry_count + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_dropped_count (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data, entry_full);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000, &entry_data[entry_full],
+		entry_len);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_drop_read_contents_offset (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t entry_data[entry_full + entry_len];
+	uint8_t output[entry_full + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < entry_count + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = logging.base.read_contents (&logging.base, entry_full - entry_len, output,
+		sizeof (output));
+	CuAssertIntEquals (test, entry_len * 2, status);
+
+	status = testing_validate_array (&entry_data[entry_full - entry_len], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, entry_full, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len, status);
+
+	status = testing_validate_array (&entry_data[entry_full], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_drop_both_buffers_full (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[(entry_count * 2) + 1][entry_size];
+	uint8_t entry_data[(entry_full * 2) + entry_len];
+	uint8_t output[(entry_full * 2) + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < (entry_count * 2) + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	/* The dropped entry does not consume an entry ID. */
+	header = (struct logging_entry_header*) &entry_data[entry_full * 2];
+	header->entry_id = entry_count * 2;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count * 2; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = logging.base.create_entry (&logging.base, entry[entry_count * 2], entry_size);
+	CuAssertIntEquals (test, LOGGING_BUFFER_FULL, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_dropped_count (&logging.base);
+	CuAssertIntEquals (test, 1, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, entry_full * 2, status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data, entry_full);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000, &entry_data[entry_full],
+		entry_full);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (&logging.base, entry[entry_count * 2], entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, entry_data, entry_full,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, entry_full));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &entry_data[entry_full],
+		entry_full, FLASH_EXP_READ_CMD (0x03, 0x11000, 0, -1, entry_full));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_dropped_count (&logging.base);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_drop_flush_partial_buffer (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t entry[2][entry_size];
+	uint8_t entry_data[entry_len * 2];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < 2; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (&logging.base, entry[0], entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data, entry_len);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (&logging.base, entry[1], entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_write (&flash_mock, 0x10000 + entry_len,
+		&entry_data[entry_len], entry_len);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_drop_flush_write_error (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t entry_data[entry_full + entry_len];
+	uint8_t output[entry_full + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < entry_count + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data, entry_full);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000, &entry_data[entry_full],
+		entry_len);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_drop_flush_incomplete_write (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t entry_data[entry_full + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < entry_count + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_PAGE_SIZE);
+	status |= flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_WRITE_ENABLE);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, LOGGING_INCOMPLETE_FLUSH, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_expect_write (&flash_mock, 0x10000 + FLASH_PAGE_SIZE,
+		&entry_data[FLASH_PAGE_SIZE], entry_full - FLASH_PAGE_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000, &entry_data[entry_full],
+		entry_len);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_block_after_drop (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t entry_data[entry_full + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < entry_count + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data, entry_full);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_BLOCK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000, &entry_data[entry_full],
+		entry_len);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_block_write_error (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t entry_data[entry_full + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < entry_count + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_BLOCK);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The log still drops entries, so the next entry does not trigger a flash update. */
+	status = logging.base.create_entry (&logging.base, entry[0], entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data) + entry_len, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	int i;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (NULL, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, (enum logging_overflow_policy) 2);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_get_dropped_count_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	int i;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_dropped_count (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_clear_drop_pending_buffer (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t entry_data[entry_full + entry_len];
+	uint8_t output[entry_full + entry_len];
+	struct logging_entry_header *header;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	pos = entry_data;
+	for (i = 0; i < entry_count + 1; ++i, pos += entry_size) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (entry[i], i, entry_size);
+		memcpy (pos, entry[i], entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.clear (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_set_overflow_policy_drop_full_log_erase_error (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_full[LOGGING_FLASH_SECTORS][FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	uint8_t entry[entry_count + 1][entry_size];
+	uint8_t output[entry_full];
+	struct logging_entry_header *header;
+	int i;
+	int j;
+	int size;
+
+	TEST_START;
+
+	memset (log_full, 0xff, sizeof (log_full));
+
+	for (j = 0; j < LOGGING_FLASH_SECTORS; ++j) {
+		for (i = 0; i < entry_count; ++i) {
+			header = (struct logging_entry_header*) &log_full[j][i * entry_len];
+			header->log_magic = 0xCB;
+			header->length = entry_len;
+			header->entry_id = i + (j * entry_count);
+		}
+	}
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		memset (entry[i], i, entry_size);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_full[i], FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count + 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry[i], entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	size = logging.base.get_size (&logging.base);
+
+	status = flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, size, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_full[0], FLASH_SECTOR_SIZE,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, entry_full));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, entry_full, status);
+
+	status = testing_validate_array (log_full[0], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_add_observer_flush_needed (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	struct logging_flash_testing_observer observer;
+	int status;
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	uint8_t entry[entry_size];
+	int i;
+
+	TEST_START;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+	memset (entry, 0x55, sizeof (entry));
+
+	memset (&observer, 0, sizeof (observer));
+	observer.base.on_flush_needed = logging_flash_testing_on_flush_needed;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_add_observer (&logging, &observer.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < entry_count; ++i) {
+		status = logging.base.create_entry (&logging.base, entry, entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	CuAssertIntEquals (test, 0, observer.count);
+
+	status = logging.base.create_entry (&logging.base, entry, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, observer.count);
+	CuAssertPtrEquals (test, &logging, observer.logging);
+
+	for (i = 0; i < entry_count - 1; ++i) {
+		status = logging.base.create_entry (&logging.base, entry, entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	CuAssertIntEquals (test, 1, observer.count);
+
+	status = logging_flash_remove_observer (&logging, &observer.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_add_observer_null (CuTest *test)
+{
+	struct logging_flash_testing_observer observer;
+	int status;
+
+	TEST_START;
+
+	status = logging_flash_add_observer (NULL, &observer.base);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void logging_flash_test_remove_observer_null (CuTest *test)
+{
+	struct logging_flash_testing_observer observer;
+	int status;
+
+	TEST_START;
+
+	status = logging_flash_remove_observer (NULL, &observer.base);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
 CuSuite* get_logging_flash_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -18709,6 +19955,21 @@ CuSuite* get_logging_flash_suite ()
 		logging_flash_test_clear_full_buffer_flush_after_incomplete_flush_unused_bytes_terminator_large);
 	SUITE_ADD_TEST (suite, logging_flash_test_clear_null);
 	SUITE_ADD_TEST (suite, logging_flash_test_clear_erase_error);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_drop_full_buffer);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_drop_read_contents_offset);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_drop_both_buffers_full);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_drop_flush_partial_buffer);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_drop_flush_write_error);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_drop_flush_incomplete_write);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_block_after_drop);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_block_write_error);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_null);
+	SUITE_ADD_TEST (suite, logging_flash_test_get_dropped_count_null);
+	SUITE_ADD_TEST (suite, logging_flash_test_clear_drop_pending_buffer);
+	SUITE_ADD_TEST (suite, logging_flash_test_set_overflow_policy_drop_full_log_erase_error);
+	SUITE_ADD_TEST (suite, logging_flash_test_add_observer_flush_needed);
+	SUITE_ADD_TEST (suite, logging_flash_test_add_observer_null);
+	SUITE_ADD_TEST (suite, logging_flash_test_remove_observer_null);
 
 	return suite;
 }
@@ -1158,6 +1158,96 @@ static void logging_memory_test_clear_null (CuTest *test)
 }
 
 
+static void logging_memory_test_set_overflow_policy (CuTest *test)
+{
+	struct logging_memory logging;
+	int status;
+	const int entry_size = 11;
+	const int entry_count = 32;
+
+	TEST_START;
+
+	status = logging_memory_init (&logging, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_BLOCK);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_set_overflow_policy_invalid_arg (CuTest *test)
+{
+	struct logging_memory logging;
+	int status;
+	const int entry_size = 11;
+	const int entry_count = 32;
+
+	TEST_START;
+
+	status = logging_memory_init (&logging, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (NULL, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, (enum logging_overflow_policy) 2);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_get_dropped_count (CuTest *test)
+{
+	struct logging_memory logging;
+	int status;
+	const int entry_size = 11;
+	const int entry_count = 32;
+	uint8_t entry[entry_size];
+	int i;
+
+	TEST_START;
+
+	memset (entry, 0, sizeof (entry));
+
+	status = logging_memory_init (&logging, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.set_overflow_policy (&logging.base, LOGGING_OVERFLOW_DROP);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < (entry_count + 1); ++i) {
+		status = logging.base.create_entry (&logging.base, entry, entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = logging.base.get_dropped_count (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_get_dropped_count_null (CuTest *test)
+{
+	struct logging_memory logging;
+	int status;
+	const int entry_size = 11;
+	const int entry_count = 32;
+
+	TEST_START;
+
+	status = logging_memory_init (&logging, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_dropped_count (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_memory_release (&logging);
+}
+
 CuSuite* get_logging_memory_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -1188,6 +1278,10 @@ CuSuite* get_logging_memory_suite ()
 	SUITE_ADD_TEST (suite, logging_memory_test_clear_log_wrap);
 	SUITE_ADD_TEST (suite, logging_memory_test_clear_add_after_clear);
 	SUITE_ADD_TEST (suite, logging_memory_test_clear_null);
+	SUITE_ADD_TEST (suite, logging_memory_test_set_overflow_policy);
+	SUITE_ADD_TEST (suite, logging_memory_test_set_overflow_policy_invalid_arg);
+	SUITE_ADD_TEST (suite, logging_memory_test_get_dropped_count);
+	SUITE_ADD_TEST (suite, logging_memory_test_get_dropped_count_null);
 
 	return suite;
 }
@@ -0,0 +1,703 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "manifest/manifest_arena.h"
+#include "manifest/manifest.h"
+
+
+static const char *SUITE = "manifest_arena";
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void manifest_arena_test_init (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 256, stats.size);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 0, stats.peak);
+	CuAssertIntEquals (test, 0, stats.results);
+	CuAssertIntEquals (test, 0, stats.failures);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_init_unaligned_size (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 253);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 256, stats.size);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_init_null (CuTest *test)
+{
+	struct manifest_arena arena;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (NULL, 256);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	status = manifest_arena_init (&arena, 0);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	status = manifest_arena_init (&arena, 15);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+}
+
+static void manifest_arena_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	manifest_arena_release (NULL);
+}
+
+static void manifest_arena_test_alloc (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t zero[20] = {0};
+	uint8_t *first;
+	uint8_t *second;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	first = manifest_arena_alloc (&arena, 10);
+	CuAssertPtrNotNull (test, first);
+	CuAssertIntEquals (test, 0, ((uintptr_t) first) % 8);
+
+	status = testing_validate_array (zero, first, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (first, 0x55, 10);
+
+	second = manifest_arena_alloc (&arena, 20);
+	CuAssertPtrNotNull (test, second);
+	CuAssertPtrEquals (test, first + 16, second);
+
+	status = testing_validate_array (zero, second, 20);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 8 + 16 + 24, stats.used);
+	CuAssertIntEquals (test, 8 + 16 + 24, stats.peak);
+	CuAssertIntEquals (test, 1, stats.results);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 8 + 16 + 24, stats.peak);
+	CuAssertIntEquals (test, 0, stats.results);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_alloc_zero_length (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	first = manifest_arena_alloc (&arena, 0);
+	CuAssertPtrNotNull (test, first);
+
+	second = manifest_arena_alloc (&arena, 0);
+	CuAssertPtrNotNull (test, second);
+	CuAssertTrue (test, (first != second));
+
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.results);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_alloc_full (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t zero[16] = {0};
+	uint8_t *first;
+	uint8_t *second;
+	uint8_t *third;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	first = manifest_arena_alloc (&arena, 48);
+	CuAssertPtrNotNull (test, first);
+
+	/* An allocation that doesn't fit in the arena is made from the heap. */
+	second = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, second);
+	CuAssertTrue (test, ((second < arena.buffer) || (second >= &arena.buffer[arena.size])));
+	CuAssertIntEquals (test, 0, ((uintptr_t) second) % 8);
+
+	status = testing_validate_array (zero, second, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (second, 0x55, 16);
+
+	third = manifest_arena_alloc (&arena, 8);
+	CuAssertPtrNotNull (test, third);
+	CuAssertPtrEquals (test, first + 48, third);
+
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 64, stats.used);
+	CuAssertIntEquals (test, 64, stats.peak);
+	CuAssertIntEquals (test, 1, stats.results);
+	CuAssertIntEquals (test, 1, stats.failures);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 0, stats.results);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_alloc_full_no_block (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	uint8_t *third;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	first = manifest_arena_alloc (&arena, 56);
+	CuAssertPtrNotNull (test, first);
+	manifest_arena_end (&arena, true);
+
+	/* There is no space for a new result, so the entire result is allocated from the heap. */
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	second = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, second);
+	CuAssertTrue (test, ((second < arena.buffer) || (second >= &arena.buffer[arena.size])));
+
+	third = manifest_arena_alloc (&arena, 0);
+	CuAssertPtrNotNull (test, third);
+	CuAssertTrue (test, ((third < arena.buffer) || (third >= &arena.buffer[arena.size])));
+
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 64, stats.used);
+	CuAssertIntEquals (test, 2, stats.results);
+	CuAssertIntEquals (test, 2, stats.failures);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, second));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 64, stats.used);
+	CuAssertIntEquals (test, 1, stats.results);
+
+	/* The heap result is no longer tracked by the arena. */
+	CuAssertIntEquals (test, false, manifest_arena_free (&arena, second));
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 0, stats.results);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_alloc_full_first_allocation (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	uint8_t *third;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	first = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, first);
+	manifest_arena_end (&arena, true);
+
+	/* The first allocation for the result is on the heap, but the rest fits in the arena. */
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	second = manifest_arena_alloc (&arena, 64);
+	CuAssertPtrNotNull (test, second);
+	CuAssertTrue (test, ((second < arena.buffer) || (second >= &arena.buffer[arena.size])));
+
+	third = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, third);
+	CuAssertPtrEquals (test, first + 16 + 8, third);
+
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 48, stats.used);
+	CuAssertIntEquals (test, 2, stats.results);
+	CuAssertIntEquals (test, 1, stats.failures);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, second));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 24, stats.used);
+	CuAssertIntEquals (test, 1, stats.results);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_alloc_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertPtrEquals (test, NULL, manifest_arena_alloc (NULL, 10));
+}
+
+static void manifest_arena_test_begin_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_begin (NULL);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	manifest_arena_end (NULL, true);
+}
+
+static void manifest_arena_test_end_discard (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	first = manifest_arena_alloc (&arena, 32);
+	CuAssertPtrNotNull (test, first);
+
+	manifest_arena_end (&arena, false);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 40, stats.peak);
+	CuAssertIntEquals (test, 0, stats.results);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	second = manifest_arena_alloc (&arena, 32);
+	CuAssertPtrEquals (test, first, second);
+
+	manifest_arena_end (&arena, true);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, second));
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_end_discard_heap_allocations (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	first = manifest_arena_alloc (&arena, 32);
+	CuAssertPtrNotNull (test, first);
+
+	second = manifest_arena_alloc (&arena, 64);
+	CuAssertPtrNotNull (test, second);
+
+	manifest_arena_end (&arena, false);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 0, stats.results);
+	CuAssertIntEquals (test, 1, stats.failures);
+
+	CuAssertIntEquals (test, false, manifest_arena_free (&arena, second));
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_release_heap_allocations (CuTest *test)
+{
+	struct manifest_arena arena;
+	uint8_t *first;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	first = manifest_arena_alloc (&arena, 128);
+	CuAssertPtrNotNull (test, first);
+
+	manifest_arena_end (&arena, true);
+
+	/* Heap allocations for results still in use are freed with the arena. */
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_end_no_allocations (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 0, stats.results);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_free_out_of_order (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	uint8_t *third;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	first = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, first);
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	second = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, second);
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	third = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, third);
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 72, stats.used);
+	CuAssertIntEquals (test, 3, stats.results);
+
+	/* Freeing an older result does not reclaim space while newer results are still in use. */
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, second));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 72, stats.used);
+	CuAssertIntEquals (test, 2, stats.results);
+
+	/* Freeing the newest result reclaims all unused space at the end. */
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, third));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 24, stats.used);
+	CuAssertIntEquals (test, 1, stats.results);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertIntEquals (test, 0, stats.results);
+	CuAssertIntEquals (test, 72, stats.peak);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_free_twice (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	first = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, first);
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	second = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, second);
+	manifest_arena_end (&arena, true);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.results);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, second));
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_free_not_in_arena (CuTest *test)
+{
+	struct manifest_arena arena;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, manifest_arena_free (&arena, data));
+	CuAssertIntEquals (test, false, manifest_arena_free (&arena, NULL));
+	CuAssertIntEquals (test, false, manifest_arena_free (&arena, arena.buffer));
+	CuAssertIntEquals (test, false, manifest_arena_free (NULL, data));
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_get_stats_null (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	status = manifest_arena_get_stats (&arena, NULL);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_reset_peak (CuTest *test)
+{
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	uint8_t *first;
+	uint8_t *second;
+	int status;
+
+	TEST_START;
+
+	status = manifest_arena_init (&arena, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	first = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, first);
+	manifest_arena_end (&arena, true);
+
+	status = manifest_arena_begin (&arena);
+	CuAssertIntEquals (test, 0, status);
+	second = manifest_arena_alloc (&arena, 16);
+	CuAssertPtrNotNull (test, second);
+	CuAssertPtrNotNull (test, manifest_arena_alloc (&arena, 64));
+	manifest_arena_end (&arena, true);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, second));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 24, stats.used);
+	CuAssertIntEquals (test, 48, stats.peak);
+	CuAssertIntEquals (test, 1, stats.failures);
+
+	manifest_arena_reset_peak (&arena);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 24, stats.used);
+	CuAssertIntEquals (test, 24, stats.peak);
+	CuAssertIntEquals (test, 0, stats.failures);
+
+	CuAssertIntEquals (test, true, manifest_arena_free (&arena, first));
+
+	manifest_arena_release (&arena);
+}
+
+static void manifest_arena_test_reset_peak_null (CuTest *test)
+{
+	TEST_START;
+
+	manifest_arena_reset_peak (NULL);
+}
+
+
+CuSuite* get_manifest_arena_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, manifest_arena_test_init);
+	SUITE_ADD_TEST (suite, manifest_arena_test_init_unaligned_size);
+	SUITE_ADD_TEST (suite, manifest_arena_test_init_null);
+	SUITE_ADD_TEST (suite, manifest_arena_test_release_null);
+	SUITE_ADD_TEST (suite, manifest_arena_test_alloc);
+	SUITE_ADD_TEST (suite, manifest_arena_test_alloc_zero_length);
+	SUITE_ADD_TEST (suite, manifest_arena_test_alloc_full);
+	SUITE_ADD_TEST (suite, manifest_arena_test_alloc_full_no_block);
+	SUITE_ADD_TEST (suite, manifest_arena_test_alloc_full_first_allocation);
+	SUITE_ADD_TEST (suite, manifest_arena_test_alloc_null);
+	SUITE_ADD_TEST (suite, manifest_arena_test_begin_null);
+	SUITE_ADD_TEST (suite, manifest_arena_test_end_discard);
+	SUITE_ADD_TEST (suite, manifest_arena_test_end_discard_heap_allocations);
+	SUITE_ADD_TEST (suite, manifest_arena_test_release_heap_allocations);
+	SUITE_ADD_TEST (suite, manifest_arena_test_end_no_allocations);
+	SUITE_ADD_TEST (suite, manifest_arena_test_free_out_of_order);
+	SUITE_ADD_TEST (suite, manifest_arena_test_free_twice);
+	SUITE_ADD_TEST (suite, manifest_arena_test_free_not_in_arena);
+	SUITE_ADD_TEST (suite, manifest_arena_test_get_stats_null);
+	SUITE_ADD_TEST (suite, manifest_arena_test_reset_peak);
+	SUITE_ADD_TEST (suite, manifest_arena_test_reset_peak_null);
+
+	return suite;
+}
@@ -2671,6 +2671,17 @@ static void manifest_flash_test_read_header_only_header_and_sig (CuTest *test)
 }
 
 
+static void manifest_flash_test_set_arena_null (CuTest *test)
+{
+	struct manifest_arena arena;
+	int status;
+
+	TEST_START;
+
+	status = manifest_flash_set_arena (NULL, &arena);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+}
+
 CuSuite* get_manifest_flash_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -2725,6 +2736,7 @@ CuSuite* get_manifest_flash_suite ()
 	SUITE_ADD_TEST (suite, manifest_flash_test_read_header_sig_same_length_as_pfm);
 	SUITE_ADD_TEST (suite, manifest_flash_test_read_header_sig_length_into_header);
 	SUITE_ADD_TEST (suite, manifest_flash_test_read_header_only_header_and_sig);
+	SUITE_ADD_TEST (suite, manifest_flash_test_set_arena_null);
 
 	return suite;
 }
@@ -3620,6 +3620,90 @@ static void manifest_verification_test_after_default_activated_match_stored (CuT
 }
 
 
+static void manifest_verification_test_on_pfm_activated_key_stored_match_default_invalidate_key (
+	CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct rsa_engine_mock rsa;
+	struct keystore_mock keystore;
+	struct manifest_verification_key manifest_key;
+	struct manifest_verification verification;
+	struct pfm_mock pfm;
+	int status;
+	struct pfm_observer *observer;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_init (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_verification_testing_initialize_stored_key (test, &keystore, &manifest_key, 11);
+
+	status = mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0,
+		MOCK_ARG_PTR_CONTAINS (&RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY)),
+		MOCK_ARG_PTR_CONTAINS (manifest_key.signature, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (SHA256_HASH_LENGTH));
+	status |= mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0,
+		MOCK_ARG_PTR_CONTAINS (&RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY)), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (RSA_ENCRYPT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (SHA256_HASH_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_verification_init (&verification, &hash.base, &rsa.base, &RSA_PUBLIC_KEY,
+		&manifest_key, &keystore.base, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&keystore.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pfm.mock, pfm.base.base.get_hash, &pfm, 0, MOCK_ARG (&hash),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (SHA256_HASH_LENGTH));
+	status |= mock_expect_output (&pfm.mock, 1, SIG_HASH_TEST, SIG_HASH_LEN, 2);
+
+	status |= mock_expect (&pfm.mock, pfm.base.base.get_signature, &pfm, RSA_ENCRYPT_LEN,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (RSA_MAX_KEY_LENGTH));
+	status |= mock_expect_output (&pfm.mock, 0, RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN, 1);
+
+	status |= mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0,
+		MOCK_ARG_PTR_CONTAINS (&RSA_PUBLIC_KEY3, sizeof (RSA_PUBLIC_KEY3)),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE3_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN),
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SHA256_HASH_LENGTH));
+
+	status |= mock_expect (&keystore.mock, keystore.base.save_key, &keystore, 0, MOCK_ARG (1),
+		MOCK_ARG_PTR_CONTAINS (&manifest_key, sizeof (manifest_key)),
+		MOCK_ARG (sizeof (manifest_key)));
+
+	status |= mock_expect (&rsa.mock, rsa.base.invalidate_public_key, &rsa, 0,
+		MOCK_ARG_PTR_CONTAINS (&RSA_PUBLIC_KEY2, sizeof (RSA_PUBLIC_KEY2)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	observer = manifest_verification_get_pfm_observer (&verification);
+	observer->on_pfm_activated (observer, &pfm.base);
+
+	status = keystore_mock_validate_and_release (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rsa_mock_validate_and_release (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_verification_release (&verification);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
 CuSuite* get_manifest_verification_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -3704,6 +3788,8 @@ CuSuite* get_manifest_verification_suite ()
 	SUITE_ADD_TEST (suite,
 		manifest_verification_test_after_default_activated_save_error_on_update_start_already_error);
 	SUITE_ADD_TEST (suite, manifest_verification_test_after_default_activated_match_stored);
+	SUITE_ADD_TEST (suite,
+		manifest_verification_test_on_pfm_activated_key_stored_match_default_invalidate_key);
 
 	return suite;
 }
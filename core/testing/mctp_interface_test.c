@@ -15,6 +15,7 @@
 #include "cmd_interface/cerberus_protocol.h"
 #include "cmd_interface/cerberus_protocol_master_commands.h"
 #include "cmd_interface/cmd_interface_system.h"
+#include "cmd_interface/cmd_async.h"
 
 
 static const char *SUITE = "mctp_interface";
@@ -83,6 +84,179 @@ static void complete_mctp_interface_with_interface_mock_test (CuTest *test,
 	mctp_interface_deinit (interface);
 }
 
+/**
+ * Helper function to construct a vendor defined request packet from a remote device.
+ *
+ * @param rx The packet to construct.
+ * @param src_eid EID of the device sending the request.
+ * @param msg_tag Message tag for the request.
+ * @param som Flag for the first packet of the request.
+ * @param eom Flag for the last packet of the request.
+ * @param packet_seq Sequence number for the packet.
+ * @param payload Payload data for the packet.
+ * @param length Length of the packet payload.
+ */
+static void mctp_interface_testing_build_request_packet (struct cmd_packet *rx, uint8_t src_eid,
+	uint8_t msg_tag, bool som, bool eom, uint8_t packet_seq, const uint8_t *payload, size_t length)
+{
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx->data;
+
+	memset (rx, 0, sizeof (struct cmd_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = length + 5;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = src_eid;
+	header->som = som;
+	header->eom = eom;
+	header->tag_owner = 1;
+	header->msg_tag = msg_tag;
+	header->packet_seq = packet_seq;
+
+	memcpy (&rx->data[7], payload, length);
+	rx->data[7 + length] = checksum_crc8 (0xBA, rx->data, 7 + length);
+	rx->pkt_size = 8 + length;
+	rx->dest_addr = 0x5D;
+}
+
+/**
+ * Helper function to set up the expectation for processing a reassembled request.  The response
+ * will be a short message to the requester.
+ *
+ * @param test The test framework.
+ * @param cmd_interface The cmd interface mock to update.
+ * @param src_eid EID of the device that sent the request.
+ * @param data The expected request data.
+ * @param length Length of the expected request.
+ * @param response_byte Data to send in the response.
+ */
+static void mctp_interface_testing_expect_request (CuTest *test,
+	struct cmd_interface_mock *cmd_interface, uint8_t src_eid, const uint8_t *data, size_t length,
+	uint8_t response_byte)
+{
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	int status;
+
+	memset (&request, 0, sizeof (request));
+	memcpy (request.data, data, length);
+	request.length = length;
+	request.source_eid = src_eid;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	request.channel_id = 0;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+
+	memset (&response, 0, sizeof (response));
+	response.data[0] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = response_byte;
+	response.length = 2;
+	response.source_eid = src_eid;
+	response.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	response.new_request = false;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&cmd_interface->mock, cmd_interface->base.process_request, cmd_interface,
+		0, MOCK_ARG_VALIDATOR_TMP (cmd_interface_mock_validate_request, &request,
+			sizeof (request)));
+	status |= mock_expect_output_tmp (&cmd_interface->mock, 0, &response, sizeof (response), -1);
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Request handler for testing deferred responses.  The response is a short message to the
+ * requester.
+ *
+ * @param intf The command interface that deferred the request.
+ * @param request The request to process.
+ *
+ * @return 0 always.
+ */
+static int mctp_interface_testing_execute_deferred (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	request->data[0] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	request->data[1] = 0x41;
+	request->length = 2;
+
+	return 0;
+}
+
+/**
+ * Request handler for testing deferred responses that fail processing.
+ *
+ * @param intf The command interface that deferred the request.
+ * @param request The request to process.
+ *
+ * @return CMD_HANDLER_PROCESS_FAILED always.
+ */
+static int mctp_interface_testing_execute_deferred_error (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	request->length = 0;
+	return CMD_HANDLER_PROCESS_FAILED;
+}
+
+/**
+ * Helper function to send a single packet request that will be deferred by the command interface.
+ * The request will be executed by the specified handler, but the response will not be retrieved.
+ *
+ * @param test The test framework.
+ * @param cmd_interface The cmd interface mock to use for the request.
+ * @param interface The MCTP interface that will receive the request.
+ * @param async The deferred execution context.
+ * @param msg_tag Message tag for the request.
+ * @param execute Handler to execute the deferred request.
+ */
+static void mctp_interface_testing_defer_request (CuTest *test,
+	struct cmd_interface_mock *cmd_interface, struct mctp_interface *interface,
+	struct cmd_async *async, uint8_t msg_tag, cmd_async_execute_request execute)
+{
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_request request;
+	uint8_t msg[] = {MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02};
+	size_t num_packets;
+	int status;
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, msg_tag, true, true,
+		0, msg, sizeof (msg));
+
+	memset (&request, 0, sizeof (request));
+	memcpy (request.data, msg, sizeof (msg));
+	request.length = sizeof (msg);
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.can_defer = true;
+
+	status = mock_expect (&cmd_interface->mock, cmd_interface->base.process_request, cmd_interface,
+		CMD_RESPONSE_DEFERRED_ESCAPE_SEQ,
+		MOCK_ARG_VALIDATOR_TMP (cmd_interface_mock_validate_request, &request, sizeof (request)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertPtrEquals (test, NULL, packets);
+
+	/* The mock does not defer the request, so submit it here. */
+	status = cmd_async_submit (async, &cmd_interface->base, execute, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_get_deferred_response (interface, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertPtrEquals (test, NULL, packets);
+
+	status = cmd_async_execute (async);
+	CuAssertIntEquals (test, 0, status);
+}
+
 
 /*******************
  * Test cases
@@ -1279,6 +1453,7 @@ static void mctp_interface_test_process_packet_cmd_interface_fail (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1366,6 +1541,7 @@ static void mctp_interface_test_process_packet_cmd_interface_fail_cmd_set_1 (CuT
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1447,6 +1623,7 @@ static void mctp_interface_test_process_packet_error_packet (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1524,6 +1701,7 @@ static void mctp_interface_test_process_packet_no_response (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1620,6 +1798,7 @@ static void mctp_interface_test_process_packet_no_response_cmd_set_1 (CuTest *te
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1900,6 +2079,7 @@ static void mctp_interface_test_process_packet_one_packet_request (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -1999,6 +2179,7 @@ static void mctp_interface_test_process_packet_one_packet_response (CuTest *test
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -2103,6 +2284,7 @@ static void mctp_interface_test_process_packet_two_packet_response (CuTest *test
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -2236,6 +2418,7 @@ static void mctp_interface_test_process_packet_channel_id_reset_next_som (CuTest
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 1;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -2320,6 +2503,7 @@ static void mctp_interface_test_process_packet_normal_timeout (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -2425,6 +2609,7 @@ static void mctp_interface_test_process_packet_crypto_timeout (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -2669,6 +2854,7 @@ static void mctp_interface_test_process_packet_max_message (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -2921,6 +3107,7 @@ static void mctp_interface_test_process_packet_response_length_limited (CuTest *
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY - 128;
 
@@ -3010,6 +3197,7 @@ static void mctp_interface_test_process_packet_response_too_large (CuTest *test)
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -3120,6 +3308,7 @@ static void mctp_interface_test_process_packet_response_too_large_length_limited
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY - 128;
 
@@ -3235,6 +3424,7 @@ static void mctp_interface_test_process_packet_two_packet_response_length_limite
 	request.target_eid = 0x0B;
 	request.new_request = false;
 	request.crypto_timeout = false;
+	request.can_defer = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
 
@@ -3586,6 +3776,1369 @@ static void mctp_interface_test_issue_request_construct_packet_fail (CuTest *tes
 }
 
 
+static void mctp_interface_test_process_packet_in_place_null (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	size_t num_packets;
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_process_packet_in_place (NULL, &rx, &num_packets);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_process_packet_in_place (&interface, NULL, &num_packets);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, NULL);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_in_place_invalid_crc (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet packet;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct cmd_packet rx;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx.data;
+	struct cerberus_protocol_header *cerberus_header;
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx.data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[17] = 0x00;
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+
+	memset (&packet, 0xff, sizeof (packet));
+
+	status = mctp_interface_get_response_packet (&interface, 0, &packet);
+	CuAssertIntEquals (test, 0, status);
+
+	header = (struct mctp_protocol_transport_header*) packet.data;
+	cerberus_header = (struct cerberus_protocol_header*) &packet.data[7];
+
+	CuAssertIntEquals (test, 0, packet.state);
+	CuAssertIntEquals (test, 18, packet.pkt_size);
+	CuAssertIntEquals (test, false, packet.timeout_valid);
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, 0, header->tag_owner);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, cerberus_header->msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, cerberus_header->pci_vendor_id);
+	CuAssertIntEquals (test, 0, cerberus_header->rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, cerberus_header->command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_INVALID_CHECKSUM, packet.data[12]);
+	CuAssertIntEquals (test, 0x55, packet.dest_addr);
+	CuAssertIntEquals (test, checksum_crc8 (0xBA, rx.data, 17), *((uint32_t*) &packet.data[13]));
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, packet.data, 17), packet.data[17]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_in_place_not_intended_target (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet packet;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct cmd_packet rx;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx.data;
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID + 1;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx.data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	status = mctp_interface_get_response_packet (&interface, 0, &packet);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_in_place_two_packet_response (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx.data;
+	struct cmd_packet packet;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	size_t num_packets;
+	int status;
+	int first_pkt = MCTP_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	int second_pkt = 48;
+	int second_pkt_total = second_pkt + MCTP_PROTOCOL_PACKET_OVERHEAD;
+	int response_size = first_pkt + second_pkt;
+	int i;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx.data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	request.length = 10;
+	memcpy (request.data, &rx.data[7], request.length);
+	request.source_eid = 0x0A;
+	request.target_eid = 0x0B;
+	request.new_request = false;
+	request.crypto_timeout = false;
+	request.can_defer = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+
+	memset (&response.data, 0, sizeof (response.data));
+	response.data[0] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 1; i < response_size; i++) {
+		response.data[i] = i;
+	}
+	response.length = response_size;
+	response.source_eid = 0x0A;
+	response.target_eid = 0x0B;
+	response.new_request = false;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&cmd_interface.mock, cmd_interface.base.process_request, &cmd_interface,
+		0, MOCK_ARG_VALIDATOR (cmd_interface_mock_validate_request, &request, sizeof (request)));
+	status |= mock_expect_output (&cmd_interface.mock, 0, &response, sizeof (response), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, num_packets);
+
+	status = mctp_interface_get_response_packet (&interface, 0, &packet);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, packet.state);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MAX_PACKET_LEN, packet.pkt_size);
+
+	header = (struct mctp_protocol_transport_header*) packet.data;
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MAX_PACKET_LEN - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 0, header->eom);
+	CuAssertIntEquals (test, 0, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+
+	status = testing_validate_array (response.data, &packet.data[7], first_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test,
+		checksum_crc8 (0xAA, packet.data, MCTP_PROTOCOL_MAX_PACKET_LEN - 1),
+		packet.data[MCTP_PROTOCOL_MAX_PACKET_LEN - 1]);
+	CuAssertIntEquals (test, 0x55, packet.dest_addr);
+
+	status = mctp_interface_get_response_packet (&interface, 1, &packet);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, packet.state);
+	CuAssertIntEquals (test, second_pkt_total, packet.pkt_size);
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, second_pkt_total - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, 0, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 1, header->packet_seq);
+
+	status = testing_validate_array (&response.data[first_pkt], &packet.data[7], second_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, packet.data, second_pkt_total - 1),
+		packet.data[second_pkt_total - 1]);
+	CuAssertIntEquals (test, 0x55, packet.dest_addr);
+
+	status = mctp_interface_get_response_packet (&interface, 2, &packet);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_get_response_packet_null (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct cmd_packet packet;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_get_response_packet (NULL, 0, &packet);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_get_response_packet (&interface, 0, NULL);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_set_reassembly_contexts (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 100);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, contexts[0].active);
+	CuAssertIntEquals (test, false, contexts[1].active);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, NULL, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_set_reassembly_contexts_null (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (NULL, contexts, 2, 100);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, NULL, 2, 100);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 0, 100);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_interleaved_requesters (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg_bmc[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	uint8_t msg_ac_rot[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_bmc, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertPtrEquals (test, NULL, packets);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, true, false, 0, msg_ac_rot, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertPtrEquals (test, NULL, packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, MCTP_PROTOCOL_BMC_EID, msg_bmc,
+		sizeof (msg_bmc), 0x21);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg_bmc[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertPtrNotNull (test, packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0x21, packets[0].data[8]);
+
+	platform_free (packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, 0x0C, msg_ac_rot,
+		sizeof (msg_ac_rot), 0x31);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, false, true, 1, &msg_ac_rot[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertPtrNotNull (test, packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+
+	CuAssertIntEquals (test, 0x0C, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0x31, packets[0].data[8]);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_interleaved_msg_tags (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg_tag1[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	uint8_t msg_tag2[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 1, true, false, 0,
+		msg_tag1, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 2, true, false, 0,
+		msg_tag2, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, MCTP_PROTOCOL_BMC_EID, msg_tag2,
+		sizeof (msg_tag2), 0x22);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 2, false, true, 1,
+		&msg_tag2[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, 2, header->msg_tag);
+	CuAssertIntEquals (test, 0x22, packets[0].data[8]);
+
+	platform_free (packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, MCTP_PROTOCOL_BMC_EID, msg_tag1,
+		sizeof (msg_tag1), 0x11);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 1, false, true, 1,
+		&msg_tag1[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, 1, header->msg_tag);
+	CuAssertIntEquals (test, 0x11, packets[0].data[8]);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_som_restarts_request (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg_old[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04
+	};
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_old, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertIntEquals (test, true, contexts[0].active);
+	CuAssertIntEquals (test, false, contexts[1].active);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, MCTP_PROTOCOL_BMC_EID, msg,
+		sizeof (msg), 0x11);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, 0x11, packets[0].data[8]);
+	CuAssertIntEquals (test, false, contexts[0].active);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_lru_eviction (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, true, false, 0, msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0D, 0, true, false, 0, msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	/* Activity on the first request makes the second request the least recently used. */
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, false, false, 1, msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0D, 0, false, true, 1, &msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, packets[0].data[11]);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, packets[0].data[12]);
+
+	platform_free (packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, MCTP_PROTOCOL_BMC_EID, msg,
+		sizeof (msg), 0x11);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, 0x11, packets[0].data[8]);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_timeout (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	platform_msleep (20);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, packets[0].data[11]);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, packets[0].data[12]);
+	CuAssertIntEquals (test, false, contexts[0].active);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_invalid_packet_seq (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	uint8_t other[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, true, false, 0, other, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, true, 2,
+		&msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, packets[0].data[11]);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW, packets[0].data[12]);
+
+	platform_free (packets);
+
+	/* The failed request is discarded. */
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, packets[0].data[12]);
+
+	platform_free (packets);
+
+	/* Other requests are not affected. */
+	mctp_interface_testing_expect_request (test, &cmd_interface, 0x0C, other, sizeof (other),
+		0x31);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, false, true, 1, &other[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, 0x31, packets[0].data[8]);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_invalid_msg_size (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg, 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, false, 1,
+		&msg[4], 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, packets[0].data[11]);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN, packets[0].data[12]);
+	CuAssertIntEquals (test, 8, *((uint32_t*) &packets[0].data[13]));
+	CuAssertIntEquals (test, false, contexts[0].active);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_interleaved_control_msg (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) rx.data;
+	struct mctp_protocol_control_header *ctrl_header = (struct mctp_protocol_control_header*)
+		&rx.data[sizeof (struct mctp_protocol_transport_header)];
+	struct mctp_control_set_eid_request_packet *rq = (struct mctp_control_set_eid_request_packet*)
+		&rx.data[sizeof (struct mctp_protocol_transport_header) + MCTP_PROTOCOL_MIN_CONTROL_MSG_LEN];
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, true, false, 0, msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = sizeof (struct mctp_protocol_transport_header) +
+		sizeof (struct mctp_protocol_control_header) +
+		sizeof (struct mctp_control_set_eid_request_packet) - 2;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	ctrl_header->msg_type = MCTP_PROTOCOL_MSG_TYPE_CONTROL_MSG;
+	ctrl_header->command_code = MCTP_PROTOCOL_SET_EID;
+	ctrl_header->rq = 1;
+
+	rq->operation = MCTP_CONTROL_SET_EID_OPERATION_SET_ID;
+	rq->eid = 0xAA;
+
+	rx.pkt_size = sizeof (struct mctp_protocol_transport_header) +
+		sizeof (struct mctp_protocol_control_header) +
+		sizeof (struct mctp_control_set_eid_request_packet);
+	rx.dest_addr = 0x5D;
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+
+	platform_free (packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, 0x0C, msg, sizeof (msg), 0x31);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, false, true, 1, &msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, packets[0].data[7]);
+	CuAssertIntEquals (test, 0x31, packets[0].data[8]);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_reassembly_reset_message_processing (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 0, true, false, 0, msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_reset_message_processing (&interface);
+	CuAssertIntEquals (test, false, contexts[0].active);
+	CuAssertIntEquals (test, false, contexts[1].active);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, packets[0].data[12]);
+
+	platform_free (packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_process_packet_in_place_reassembly_interleaved_requesters (
+	CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet tx;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) tx.data;
+	struct mctp_interface_rx_context contexts[2];
+	uint8_t msg_bmc[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	uint8_t msg_ac_rot[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_set_reassembly_contexts (&interface, contexts, 2, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 3, true, false, 0, msg_ac_rot, 8);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 5, true, false, 0,
+		msg_bmc, 8);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, 0x0C, msg_ac_rot,
+		sizeof (msg_ac_rot), 0x31);
+
+	mctp_interface_testing_build_request_packet (&rx, 0x0C, 3, false, true, 1, &msg_ac_rot[8], 4);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+
+	status = mctp_interface_get_response_packet (&interface, 0, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x0C, header->destination_eid);
+	CuAssertIntEquals (test, 3, header->msg_tag);
+	CuAssertIntEquals (test, 0x31, tx.data[8]);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, MCTP_PROTOCOL_BMC_EID, msg_bmc,
+		sizeof (msg_bmc), 0x21);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 5, false, true, 1,
+		&msg_bmc[8], 4);
+
+	status = mctp_interface_process_packet_in_place (&interface, &rx, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+
+	status = mctp_interface_get_response_packet (&interface, 0, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, 5, header->msg_tag);
+	CuAssertIntEquals (test, 0x21, tx.data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_set_async (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct cmd_async async;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_set_async (&interface, &async);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &async, interface.async);
+
+	status = mctp_interface_set_async (&interface, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, interface.async);
+
+	cmd_async_release (&async);
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_set_async_null (CuTest *test)
+{
+	struct cmd_async async;
+	int status;
+
+	TEST_START;
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_set_async (NULL, &async);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	cmd_async_release (&async);
+}
+
+static void mctp_interface_test_get_deferred_response (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header;
+	struct cmd_async async;
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_set_async (&interface, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_defer_request (test, &cmd_interface, &interface, &async, 3,
+		mctp_interface_testing_execute_deferred);
+
+	status = mctp_interface_get_deferred_response (&interface, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertPtrNotNull (test, packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+
+	CuAssertIntEquals (test, 10, packets[0].pkt_size);
+	CuAssertIntEquals (test, 0x55, packets[0].dest_addr);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, 0, header->tag_owner);
+	CuAssertIntEquals (test, 3, header->msg_tag);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, packets[0].data[7]);
+	CuAssertIntEquals (test, 0x41, packets[0].data[8]);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, packets[0].data, 9), packets[0].data[9]);
+
+	platform_free (packets);
+
+	/* The response is only sent once. */
+	status = mctp_interface_get_deferred_response (&interface, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertPtrEquals (test, NULL, packets);
+
+	cmd_async_release (&async);
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_get_deferred_response_in_place (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet packet;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) packet.data;
+	struct cmd_async async;
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_set_async (&interface, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_defer_request (test, &cmd_interface, &interface, &async, 5,
+		mctp_interface_testing_execute_deferred);
+
+	status = mctp_interface_get_deferred_response_in_place (&interface, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+
+	status = mctp_interface_get_response_packet (&interface, 0, &packet);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 10, packet.pkt_size);
+	CuAssertIntEquals (test, 0x55, packet.dest_addr);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 0, header->tag_owner);
+	CuAssertIntEquals (test, 5, header->msg_tag);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, packet.data[7]);
+	CuAssertIntEquals (test, 0x41, packet.data[8]);
+
+	status = mctp_interface_get_deferred_response_in_place (&interface, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	cmd_async_release (&async);
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_get_deferred_response_processing_error (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header;
+	struct cerberus_protocol_header *cerberus_header;
+	struct cmd_async async;
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_set_async (&interface, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_defer_request (test, &cmd_interface, &interface, &async, 2,
+		mctp_interface_testing_execute_deferred_error);
+
+	status = mctp_interface_get_deferred_response (&interface, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertPtrNotNull (test, packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+	cerberus_header = (struct cerberus_protocol_header*) &packets[0].data[7];
+
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, 2, header->msg_tag);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, cerberus_header->command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, packets[0].data[12]);
+	CuAssertIntEquals (test, CMD_HANDLER_PROCESS_FAILED, *((uint32_t*) &packets[0].data[13]));
+
+	platform_free (packets);
+
+	cmd_async_release (&async);
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_get_deferred_response_receiving_request (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet rx;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	struct mctp_protocol_transport_header *header;
+	struct cmd_async async;
+	uint8_t msg[] = {
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF,0x14,0x14,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08
+	};
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = cmd_async_init (&async);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_set_async (&interface, &async);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_defer_request (test, &cmd_interface, &interface, &async, 3,
+		mctp_interface_testing_execute_deferred);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 4, true, false, 0,
+		msg, 8);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	/* The deferred response is held until the partial request has been processed. */
+	status = mctp_interface_get_deferred_response (&interface, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertPtrEquals (test, NULL, packets);
+
+	mctp_interface_testing_expect_request (test, &cmd_interface, MCTP_PROTOCOL_BMC_EID, msg,
+		sizeof (msg), 0x21);
+
+	mctp_interface_testing_build_request_packet (&rx, MCTP_PROTOCOL_BMC_EID, 4, false, true, 1,
+		&msg[8], 4);
+
+	status = mctp_interface_process_packet (&interface, &rx, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertPtrNotNull (test, packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+
+	CuAssertIntEquals (test, 4, header->msg_tag);
+	CuAssertIntEquals (test, 0x21, packets[0].data[8]);
+
+	platform_free (packets);
+
+	status = mctp_interface_get_deferred_response (&interface, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_packets);
+	CuAssertPtrNotNull (test, packets);
+
+	header = (struct mctp_protocol_transport_header*) packets[0].data;
+
+	CuAssertIntEquals (test, 3, header->msg_tag);
+	CuAssertIntEquals (test, 0x41, packets[0].data[8]);
+
+	platform_free (packets);
+
+	cmd_async_release (&async);
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_get_deferred_response_no_async (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_get_deferred_response (&interface, &packets, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+	CuAssertPtrEquals (test, NULL, packets);
+
+	status = mctp_interface_get_deferred_response_in_place (&interface, &num_packets);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, num_packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
+static void mctp_interface_test_get_deferred_response_null (CuTest *test)
+{
+	struct mctp_interface interface;
+	struct cmd_packet *packets;
+	struct cmd_interface_mock cmd_interface;
+	struct device_manager device_mgr;
+	size_t num_packets;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr, &interface);
+
+	status = mctp_interface_get_deferred_response (NULL, &packets, &num_packets);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_get_deferred_response (&interface, NULL, &num_packets);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_get_deferred_response (&interface, &packets, NULL);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_get_deferred_response_in_place (NULL, &num_packets);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_get_deferred_response_in_place (&interface, NULL);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_INVALID_ARGUMENT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &cmd_interface, &device_mgr,
+		&interface);
+}
+
 CuSuite* get_mctp_interface_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -3639,6 +5192,32 @@ CuSuite* get_mctp_interface_suite ()
 	SUITE_ADD_TEST (suite, mctp_interface_test_issue_request_mctp_ctrl_msg_fail);
 	SUITE_ADD_TEST (suite, mctp_interface_test_issue_request_unsupported_msg_type);
 	SUITE_ADD_TEST (suite, mctp_interface_test_issue_request_construct_packet_fail);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_in_place_null);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_in_place_invalid_crc);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_in_place_not_intended_target);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_in_place_two_packet_response);
+	SUITE_ADD_TEST (suite, mctp_interface_test_get_response_packet_null);
+	SUITE_ADD_TEST (suite, mctp_interface_test_set_reassembly_contexts);
+	SUITE_ADD_TEST (suite, mctp_interface_test_set_reassembly_contexts_null);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_interleaved_requesters);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_interleaved_msg_tags);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_som_restarts_request);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_lru_eviction);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_timeout);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_invalid_packet_seq);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_invalid_msg_size);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_interleaved_control_msg);
+	SUITE_ADD_TEST (suite, mctp_interface_test_process_packet_reassembly_reset_message_processing);
+	SUITE_ADD_TEST (suite,
+		mctp_interface_test_process_packet_in_place_reassembly_interleaved_requesters);
+	SUITE_ADD_TEST (suite, mctp_interface_test_set_async);
+	SUITE_ADD_TEST (suite, mctp_interface_test_set_async_null);
+	SUITE_ADD_TEST (suite, mctp_interface_test_get_deferred_response);
+	SUITE_ADD_TEST (suite, mctp_interface_test_get_deferred_response_in_place);
+	SUITE_ADD_TEST (suite, mctp_interface_test_get_deferred_response_processing_error);
+	SUITE_ADD_TEST (suite, mctp_interface_test_get_deferred_response_receiving_request);
+	SUITE_ADD_TEST (suite, mctp_interface_test_get_deferred_response_no_async);
+	SUITE_ADD_TEST (suite, mctp_interface_test_get_deferred_response_null);
 
 	return suite;
 }
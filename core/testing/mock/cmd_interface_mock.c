@@ -191,6 +191,12 @@ int cmd_interface_mock_validate_request (const char *arg_info, void *expected, v
 		fail |= 1;
 	}
 
+	if (req_expected->can_defer != req_actual->can_defer) {
+		platform_printf ("%sUnexpected defer flag: expected=%d, actual=%d" NEWLINE,
+			arg_info, req_expected->can_defer, req_actual->can_defer);
+		fail |= 1;
+	}
+
 	if (req_expected->channel_id != req_actual->channel_id) {
 		platform_printf ("%sUnexpected request channel: expected=0x%x, actual=0x%x" NEWLINE,
 			arg_info, req_expected->channel_id, req_actual->channel_id);
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "flash_async_read_mock.h"
+
+
+static int flash_async_read_mock_start_read (struct flash_async_read *async, uint32_t address,
+	uint8_t *data, size_t length)
+{
+	struct flash_async_read_mock *mock = (struct flash_async_read_mock*) async;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, flash_async_read_mock_start_read, async, MOCK_ARG_CALL (address),
+		MOCK_ARG_CALL (data), MOCK_ARG_CALL (length));
+}
+
+static int flash_async_read_mock_wait_for_read (struct flash_async_read *async)
+{
+	struct flash_async_read_mock *mock = (struct flash_async_read_mock*) async;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN_NO_ARGS (&mock->mock, flash_async_read_mock_wait_for_read, async);
+}
+
+static int flash_async_read_mock_func_arg_count (void *func)
+{
+	if (func == flash_async_read_mock_start_read) {
+		return 3;
+	}
+	else {
+		return 0;
+	}
+}
+
+static const char* flash_async_read_mock_func_name_map (void *func)
+{
+	if (func == flash_async_read_mock_start_read) {
+		return "start_read";
+	}
+	else if (func == flash_async_read_mock_wait_for_read) {
+		return "wait_for_read";
+	}
+	else {
+		return "unknown";
+	}
+}
+
+static const char* flash_async_read_mock_arg_name_map (void *func, int arg)
+{
+	if (func == flash_async_read_mock_start_read) {
+		switch (arg) {
+			case 0:
+				return "address";
+
+			case 1:
+				return "data";
+
+			case 2:
+				return "length";
+		}
+	}
+
+	return "unknown";
+}
+
+/**
+ * Initialize a mock for background flash reads.
+ *
+ * @param mock The mock to initialize.
+ *
+ * @return 0 if the mock was successfully initialized or an error code.
+ */
+int flash_async_read_mock_init (struct flash_async_read_mock *mock)
+{
+	int status;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	memset (mock, 0, sizeof (struct flash_async_read_mock));
+
+	status = mock_init (&mock->mock);
+	if (status != 0) {
+		return status;
+	}
+
+	mock_set_name (&mock->mock, "flash_async_read");
+
+	mock->base.start_read = flash_async_read_mock_start_read;
+	mock->base.wait_for_read = flash_async_read_mock_wait_for_read;
+
+	mock->mock.func_arg_count = flash_async_read_mock_func_arg_count;
+	mock->mock.func_name_map = flash_async_read_mock_func_name_map;
+	mock->mock.arg_name_map = flash_async_read_mock_arg_name_map;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a background flash read mock.
+ *
+ * @param mock The mock to release.
+ */
+void flash_async_read_mock_release (struct flash_async_read_mock *mock)
+{
+	if (mock) {
+		mock_release (&mock->mock);
+	}
+}
+
+/**
+ * Validate the expectations on the mock and release the instance.
+ *
+ * @param mock The mock to validate.
+ *
+ * @return 0 if all expectations were met or 1 if not.
+ */
+int flash_async_read_mock_validate_and_release (struct flash_async_read_mock *mock)
+{
+	int status = 1;
+
+	if (mock != NULL) {
+		status = mock_validate (&mock->mock);
+		flash_async_read_mock_release (mock);
+	}
+
+	return status;
+}
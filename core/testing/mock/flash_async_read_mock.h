@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_ASYNC_READ_MOCK_H_
+#define FLASH_ASYNC_READ_MOCK_H_
+
+#include "flash/flash_async_read.h"
+#include "mock.h"
+
+
+/**
+ * A mock for background flash reads.
+ */
+struct flash_async_read_mock {
+	struct flash_async_read base;		/**< The base background read instance. */
+	struct mock mock;					/**< The base mock interface. */
+};
+
+
+int flash_async_read_mock_init (struct flash_async_read_mock *mock);
+void flash_async_read_mock_release (struct flash_async_read_mock *mock);
+
+int flash_async_read_mock_validate_and_release (struct flash_async_read_mock *mock);
+
+
+#endif /* FLASH_ASYNC_READ_MOCK_H_ */
@@ -314,7 +314,7 @@ static int flash_master_mock_expect_blank_check_ext (struct flash_master_mock *m
 	size_t page_len;
 
 	while (length > 0) {
-		page_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		page_len = (length > FLASH_DATA_CHECK_BLOCK) ? FLASH_DATA_CHECK_BLOCK : length;
 
 		status |= flash_master_mock_expect_rx_xfer (mock, 0, &WIP_STATUS, 1,
 			FLASH_EXP_READ_STATUS_REG);
@@ -395,12 +395,12 @@ static int flash_master_mock_expect_value_check_ext (struct flash_master_mock *m
 {
 	int status = 0;
 	size_t page_len;
-	uint8_t check[FLASH_VERIFICATION_BLOCK];
+	uint8_t check[FLASH_DATA_CHECK_BLOCK];
 
 	memset (check, value, sizeof (check));
 
 	while (length > 0) {
-		page_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		page_len = (length > FLASH_DATA_CHECK_BLOCK) ? FLASH_DATA_CHECK_BLOCK : length;
 
 		status |= flash_master_mock_expect_rx_xfer (mock, 0, &WIP_STATUS, 1,
 			FLASH_EXP_READ_STATUS_REG);
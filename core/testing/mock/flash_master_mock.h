@@ -23,7 +23,7 @@ extern const uint8_t WIP_STATUS;
 struct flash_master_mock {
 	struct flash_master base;					/**< The base flash master instance. */
 	struct mock mock;							/**< The base mock instance. */
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];	/**< Blank flash data. */
+	uint8_t blank[FLASH_DATA_CHECK_BLOCK];	/**< Blank flash data. */
 };
 
 
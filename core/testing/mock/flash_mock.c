@@ -337,7 +337,7 @@ int flash_mock_expect_blank_check (struct flash_mock *mock, uint32_t start, size
 	size_t page_len;
 
 	while (length > 0) {
-		page_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		page_len = (length > FLASH_DATA_CHECK_BLOCK) ? FLASH_DATA_CHECK_BLOCK : length;
 
 		status |= mock_expect (&mock->mock, mock->base.read, mock, 0, MOCK_ARG (start),
 			MOCK_ARG_NOT_NULL, MOCK_ARG (page_len));
@@ -584,23 +584,24 @@ int flash_mock_expect_erase_copy_verify (struct flash_mock *mock_dest, struct fl
 }
 
 /**
- * Set up expectations for successfully reading chunks of flash for verification.
+ * Set up expectations for successfully reading chunks of flash.
  *
- * @param mock The mock for the flash being verified.
- * @param start The address to start verification.
+ * @param mock The mock for the flash being read.
+ * @param start The address to start reading.
  * @param data The data that should be returned from the flash.
- * @param length The length of data being verified.
+ * @param length The length of data being read.
+ * @param block The maximum length of each read.
  *
  * @return 0 if the expectations were added successfully or non-zero if not.
  */
-int flash_mock_expect_verify_flash (struct flash_mock *mock, uint32_t start, const uint8_t *data,
-	size_t length)
+static int flash_mock_expect_read_blocks (struct flash_mock *mock, uint32_t start,
+	const uint8_t *data, size_t length, size_t block)
 {
 	int status = 0;
 	size_t read_len;
 
 	while (length != 0) {
-		read_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		read_len = (length > block) ? block : length;
 
 		status |= mock_expect (&mock->mock, mock->base.read, mock, 0, MOCK_ARG (start),
 			MOCK_ARG_NOT_NULL, MOCK_ARG (read_len));
@@ -614,6 +615,39 @@ int flash_mock_expect_verify_flash (struct flash_mock *mock, uint32_t start, con
 	return status;
 }
 
+/**
+ * Set up expectations for successfully reading chunks of flash for verification.
+ *
+ * @param mock The mock for the flash being verified.
+ * @param start The address to start verification.
+ * @param data The data that should be returned from the flash.
+ * @param length The length of data being verified.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_mock_expect_verify_flash (struct flash_mock *mock, uint32_t start, const uint8_t *data,
+	size_t length)
+{
+	return flash_mock_expect_read_blocks (mock, start, data, length, FLASH_VERIFICATION_BLOCK);
+}
+
+/**
+ * Set up expectations for successfully checking a region of flash against expected data, such as
+ * the check done by flash_verify_data.
+ *
+ * @param mock The mock for the flash being checked.
+ * @param start The address to start the check.
+ * @param data The data that should be returned from the flash.
+ * @param length The length of data being checked.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_mock_expect_data_check (struct flash_mock *mock, uint32_t start, const uint8_t *data,
+	size_t length)
+{
+	return flash_mock_expect_read_blocks (mock, start, data, length, FLASH_DATA_CHECK_BLOCK);
+}
+
 /**
  * Set up expectations for successfully comparing the contents of two regions of flash.
  *
@@ -15,7 +15,7 @@
 struct flash_mock {
 	struct flash base;							/**< The base flash API instance. */
 	struct mock mock;							/**< The base mock interface. */
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];	/**< Blank flash data. */
+	uint8_t blank[FLASH_DATA_CHECK_BLOCK];	/**< Blank flash data. */
 };
 
 
@@ -45,6 +45,8 @@ int flash_mock_expect_erase_copy_verify (struct flash_mock *mock_dest, struct fl
 
 int flash_mock_expect_verify_flash (struct flash_mock *mock, uint32_t start, const uint8_t *data,
 	size_t length);
+int flash_mock_expect_data_check (struct flash_mock *mock, uint32_t start, const uint8_t *data,
+	size_t length);
 int flash_mock_expect_verify_copy (struct flash_mock *mock1, uint32_t start1, const uint8_t *data1,
 	struct flash_mock *mock2, uint32_t start2, const uint8_t *data2, size_t length);
 
@@ -62,6 +62,38 @@ static int host_flash_manager_mock_validate_read_write_flash (struct host_flash_
 		MOCK_ARG_CALL (pfm), MOCK_ARG_CALL (hash), MOCK_ARG_CALL (rsa), MOCK_ARG_CALL (writable));
 }
 
+static int host_flash_manager_mock_validate_read_write_flash_incremental (
+	struct host_flash_manager *manager, struct pfm *pfm, struct hash_engine *hash,
+	struct rsa_engine *rsa, const struct host_fw_dirty_map *dirty,
+	struct host_fw_image_digests *digests, struct pfm_read_write_regions *writable)
+{
+	struct host_flash_manager_mock *mock = (struct host_flash_manager_mock*) manager;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, host_flash_manager_mock_validate_read_write_flash_incremental,
+		manager, MOCK_ARG_CALL (pfm), MOCK_ARG_CALL (hash), MOCK_ARG_CALL (rsa),
+		MOCK_ARG_CALL (dirty), MOCK_ARG_CALL (digests), MOCK_ARG_CALL (writable));
+}
+
+static int host_flash_manager_mock_validate_read_only_flash_cached (
+	struct host_flash_manager *manager, struct pfm *pfm, struct pfm *good_pfm,
+	struct hash_engine *hash, struct rsa_engine *rsa, struct host_fw_verification_cache *cache,
+	bool use_cache, struct pfm_read_write_regions *writable)
+{
+	struct host_flash_manager_mock *mock = (struct host_flash_manager_mock*) manager;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, host_flash_manager_mock_validate_read_only_flash_cached, manager,
+		MOCK_ARG_CALL (pfm), MOCK_ARG_CALL (good_pfm), MOCK_ARG_CALL (hash), MOCK_ARG_CALL (rsa),
+		MOCK_ARG_CALL (cache), MOCK_ARG_CALL (use_cache), MOCK_ARG_CALL (writable));
+}
+
 static int host_flash_manager_mock_get_flash_read_write_regions (struct host_flash_manager *manager,
 	struct pfm *pfm, bool rw_flash, struct pfm_read_write_regions *writable)
 {
@@ -173,6 +205,12 @@ static int host_flash_manager_mock_func_arg_count (void *func)
 	else if (func == host_flash_manager_mock_validate_read_write_flash) {
 		return 4;
 	}
+	else if (func == host_flash_manager_mock_validate_read_write_flash_incremental) {
+		return 6;
+	}
+	else if (func == host_flash_manager_mock_validate_read_only_flash_cached) {
+		return 7;
+	}
 	else if (func == host_flash_manager_mock_get_flash_read_write_regions) {
 		return 3;
 	}
@@ -204,6 +242,12 @@ static const char* host_flash_manager_mock_func_name_map (void *func)
 	else if (func == host_flash_manager_mock_validate_read_write_flash) {
 		return "validate_read_write_flash";
 	}
+	else if (func == host_flash_manager_mock_validate_read_write_flash_incremental) {
+		return "validate_read_write_flash_incremental";
+	}
+	else if (func == host_flash_manager_mock_validate_read_only_flash_cached) {
+		return "validate_read_only_flash_cached";
+	}
 	else if (func == host_flash_manager_mock_get_flash_read_write_regions) {
 		return "get_flash_read_write_regions";
 	}
@@ -271,6 +315,51 @@ static const char* host_flash_manager_mock_arg_name_map (void *func, int arg)
 				return "writable";
 		}
 	}
+	else if (func == host_flash_manager_mock_validate_read_write_flash_incremental) {
+		switch (arg) {
+			case 0:
+				return "pfm";
+
+			case 1:
+				return "hash";
+
+			case 2:
+				return "rsa";
+
+			case 3:
+				return "dirty";
+
+			case 4:
+				return "digests";
+
+			case 5:
+				return "writable";
+		}
+	}
+	else if (func == host_flash_manager_mock_validate_read_only_flash_cached) {
+		switch (arg) {
+			case 0:
+				return "pfm";
+
+			case 1:
+				return "good_pfm";
+
+			case 2:
+				return "hash";
+
+			case 3:
+				return "rsa";
+
+			case 4:
+				return "cache";
+
+			case 5:
+				return "use_cache";
+
+			case 6:
+				return "writable";
+		}
+	}
 	else if (func == host_flash_manager_mock_get_flash_read_write_regions) {
 		switch (arg) {
 			case 0:
@@ -348,6 +437,10 @@ int host_flash_manager_mock_init (struct host_flash_manager_mock *mock)
 	mock->base.get_read_write_flash = host_flash_manager_mock_get_read_write_flash;
 	mock->base.validate_read_only_flash = host_flash_manager_mock_validate_read_only_flash;
 	mock->base.validate_read_write_flash = host_flash_manager_mock_validate_read_write_flash;
+	mock->base.validate_read_write_flash_incremental =
+		host_flash_manager_mock_validate_read_write_flash_incremental;
+	mock->base.validate_read_only_flash_cached =
+		host_flash_manager_mock_validate_read_only_flash_cached;
 	mock->base.get_flash_read_write_regions = host_flash_manager_mock_get_flash_read_write_regions;
 	mock->base.config_spi_filter_flash_type = host_flash_manager_mock_config_spi_filter_flash_type;
 	mock->base.config_spi_filter_flash_devices =
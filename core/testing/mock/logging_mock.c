@@ -65,6 +65,29 @@ static int logging_mock_read_contents (struct logging *logging, uint32_t offset,
 		MOCK_ARG_CALL (contents), MOCK_ARG_CALL (length));
 }
 
+static int logging_mock_set_overflow_policy (struct logging *logging,
+	enum logging_overflow_policy policy)
+{
+	struct logging_mock *mock = (struct logging_mock*) logging;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, logging_mock_set_overflow_policy, logging, MOCK_ARG_CALL (policy));
+}
+
+static int logging_mock_get_dropped_count (struct logging *logging)
+{
+	struct logging_mock *mock = (struct logging_mock*) logging;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN_NO_ARGS (&mock->mock, logging_mock_get_dropped_count, logging);
+}
+
 static int logging_mock_func_arg_count (void *func)
 {
 	if (func == logging_mock_read_contents) {
@@ -73,6 +96,9 @@ static int logging_mock_func_arg_count (void *func)
 	else if (func == logging_mock_create_entry) {
 		return 2;
 	}
+	else if (func == logging_mock_set_overflow_policy) {
+		return 1;
+	}
 	else {
 		return 0;
 	}
@@ -95,6 +121,12 @@ static const char* logging_mock_func_name_map (void *func)
 	else if (func == logging_mock_read_contents) {
 		return "read_contents";
 	}
+	else if (func == logging_mock_set_overflow_policy) {
+		return "set_overflow_policy";
+	}
+	else if (func == logging_mock_get_dropped_count) {
+		return "get_dropped_count";
+	}
 	else {
 		return "unknown";
 	}
@@ -123,6 +155,12 @@ static const char* logging_mock_arg_name_map (void *func, int arg)
 				return "length";
 		}
 	}
+	else if (func == logging_mock_set_overflow_policy) {
+		switch (arg) {
+			case 0:
+				return "policy";
+		}
+	}
 
 	return "unknown";
 }
@@ -156,6 +194,8 @@ int logging_mock_init (struct logging_mock *mock)
 	mock->base.clear = logging_mock_clear;
 	mock->base.get_size = logging_mock_get_size;
 	mock->base.read_contents = logging_mock_read_contents;
+	mock->base.set_overflow_policy = logging_mock_set_overflow_policy;
+	mock->base.get_dropped_count = logging_mock_get_dropped_count;
 
 	mock->mock.func_arg_count = logging_mock_func_arg_count;
 	mock->mock.func_name_map = logging_mock_func_name_map;
@@ -46,7 +46,8 @@ static int recovery_image_mock_get_version (struct recovery_image *img, char *ve
 		MOCK_ARG_CALL (len));
 }
 
-static int recovery_image_mock_apply_to_flash (struct recovery_image *img, struct spi_flash *flash)
+static int recovery_image_mock_apply_to_flash (struct recovery_image *img, struct spi_flash *flash,
+	struct flash_copy_stream *stream)
 {
 	struct recovery_image_mock *mock = (struct recovery_image_mock*) img;
 
@@ -54,7 +55,8 @@ static int recovery_image_mock_apply_to_flash (struct recovery_image *img, struc
 		return MOCK_INVALID_ARGUMENT;
 	}
 
-	MOCK_RETURN (&mock->mock, recovery_image_mock_apply_to_flash, img, MOCK_ARG_CALL (flash));
+	MOCK_RETURN (&mock->mock, recovery_image_mock_apply_to_flash, img, MOCK_ARG_CALL (flash),
+		MOCK_ARG_CALL (stream));
 }
 
 static int recovery_image_mock_func_arg_count (void *func)
@@ -69,7 +71,7 @@ static int recovery_image_mock_func_arg_count (void *func)
 		return 2;
 	}
 	else if (func == recovery_image_mock_apply_to_flash) {
-		return 1;
+		return 2;
 	}
 	else {
 		return 0;
@@ -139,6 +141,9 @@ static const char* recovery_image_mock_arg_name_map (void *func, int arg)
 		switch (arg) {
 			case 0:
 				return "flash";
+
+			case 1:
+				return "stream";
 		}
 	}
 
@@ -112,6 +112,18 @@ static int rsa_mock_sig_verify (struct rsa_engine *engine, const struct rsa_publ
 		MOCK_ARG_CALL (match_length));
 }
 
+static void rsa_mock_invalidate_public_key (struct rsa_engine *engine,
+	const struct rsa_public_key *key)
+{
+	struct rsa_engine_mock *mock = (struct rsa_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return;
+	}
+
+	MOCK_VOID_RETURN (&mock->mock, rsa_mock_invalidate_public_key, engine, MOCK_ARG_CALL (key));
+}
+
 static int rsa_mock_func_arg_count (void *func)
 {
 	if (func == rsa_mock_decrypt) {
@@ -127,7 +139,7 @@ static int rsa_mock_func_arg_count (void *func)
 	else if (func == rsa_mock_generate_key) {
 		return 2;
 	}
-	else if (func == rsa_mock_release_key) {
+	else if ((func == rsa_mock_release_key) || (func == rsa_mock_invalidate_public_key)) {
 		return 1;
 	}
 	else {
@@ -161,6 +173,9 @@ static const char* rsa_mock_func_name_map (void *func)
 	else if (func == rsa_mock_sig_verify) {
 		return "sig_verify";
 	}
+	else if (func == rsa_mock_invalidate_public_key) {
+		return "invalidate_public_key";
+	}
 	else {
 		return "unknown";
 	}
@@ -207,6 +222,12 @@ static const char* rsa_mock_arg_name_map (void *func, int arg)
 				return "key";
 		}
 	}
+	else if (func == rsa_mock_invalidate_public_key) {
+		switch (arg) {
+			case 0:
+				return "key";
+		}
+	}
 	else if (func == rsa_mock_get_private_key_der) {
 		switch (arg) {
 			case 0:
@@ -312,6 +333,7 @@ int rsa_mock_init (struct rsa_engine_mock *mock)
 	mock->base.get_public_key_der = rsa_mock_get_public_key_der;
 	mock->base.decrypt = rsa_mock_decrypt;
 	mock->base.sig_verify = rsa_mock_sig_verify;
+	mock->base.invalidate_public_key = rsa_mock_invalidate_public_key;
 
 	mock->mock.func_arg_count = rsa_mock_func_arg_count;
 	mock->mock.func_name_map = rsa_mock_func_name_map;
@@ -223,6 +223,19 @@ static int spi_filter_interface_mock_clear_flash_dirty_state (struct spi_filter_
 	MOCK_RETURN_NO_ARGS (&mock->mock, spi_filter_interface_mock_clear_flash_dirty_state, filter);
 }
 
+static int spi_filter_interface_mock_get_flash_dirty_blocks (struct spi_filter_interface *filter,
+	uint8_t *map, size_t length, uint32_t *block_size)
+{
+	struct spi_filter_interface_mock *mock = (struct spi_filter_interface_mock*) filter;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, spi_filter_interface_mock_get_flash_dirty_blocks, filter,
+		MOCK_ARG_CALL (map), MOCK_ARG_CALL (length), MOCK_ARG_CALL (block_size));
+}
+
 static int spi_filter_interface_mock_get_bypass_mode (struct spi_filter_interface *filter,
 	spi_filter_bypass_mode *bypass)
 {
@@ -289,7 +302,8 @@ static int spi_filter_interface_mock_clear_filter_rw_regions (struct spi_filter_
 static int spi_filter_interface_mock_func_arg_count (void *func)
 {
 	if ((func == spi_filter_interface_mock_get_filter_rw_region) ||
-		(func == spi_filter_interface_mock_set_filter_rw_region)) {
+		(func == spi_filter_interface_mock_set_filter_rw_region) ||
+		(func == spi_filter_interface_mock_get_flash_dirty_blocks)) {
 		return 3;
 	}
 	else if ((func == spi_filter_interface_mock_get_mfg_id) ||
@@ -373,6 +387,9 @@ static const char* spi_filter_interface_mock_func_name_map (void *func)
 	else if (func == spi_filter_interface_mock_clear_flash_dirty_state) {
 		return "clear_flash_dirty_state";
 	}
+	else if (func == spi_filter_interface_mock_get_flash_dirty_blocks) {
+		return "get_flash_dirty_blocks";
+	}
 	else if (func == spi_filter_interface_mock_get_bypass_mode) {
 		return "get_bypass_mode";
 	}
@@ -487,6 +504,18 @@ static const char* spi_filter_interface_mock_arg_name_map (void *func, int arg)
 				return "state";
 		}
 	}
+	else if (func == spi_filter_interface_mock_get_flash_dirty_blocks) {
+		switch (arg) {
+			case 0:
+				return "map";
+
+			case 1:
+				return "length";
+
+			case 2:
+				return "block_size";
+		}
+	}
 	else if (func == spi_filter_interface_mock_get_bypass_mode) {
 		switch (arg) {
 			case 0:
@@ -572,6 +601,7 @@ int spi_filter_interface_mock_init (struct spi_filter_interface_mock *mock)
 	mock->base.set_addr_byte_mode = spi_filter_interface_mock_set_addr_byte_mode;
 	mock->base.get_flash_dirty_state = spi_filter_interface_mock_get_flash_dirty_state;
 	mock->base.clear_flash_dirty_state = spi_filter_interface_mock_clear_flash_dirty_state;
+	mock->base.get_flash_dirty_blocks = spi_filter_interface_mock_get_flash_dirty_blocks;
 	mock->base.get_bypass_mode = spi_filter_interface_mock_get_bypass_mode;
 	mock->base.set_bypass_mode = spi_filter_interface_mock_set_bypass_mode;
 	mock->base.get_filter_rw_region = spi_filter_interface_mock_get_filter_rw_region;
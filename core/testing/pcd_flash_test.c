@@ -44,6 +44,7 @@ static void pcd_flash_test_init (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	CuAssertPtrNotNull (test, pcd.base.get_devices_info);
+	CuAssertPtrNotNull (test, pcd.base.free_devices_info);
 	CuAssertPtrNotNull (test, pcd.base.get_rot_info);
 	CuAssertPtrNotNull (test, pcd.base.get_port_info);
 	CuAssertPtrNotNull (test, pcd.base.base.verify);
@@ -5655,6 +5656,192 @@ static void pcd_flash_test_get_port_info_port_id_invalid (CuTest *test)
 }
 
 
+static void pcd_flash_test_get_devices_info_free_devices_info (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct device_manager_info *devices_info;
+	struct spi_flash flash;
+	struct pcd_flash pcd;
+	size_t num_devices;
+	size_t pcd_offset;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcd_flash_init (&pcd, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA, PCD_HEADER_SIZE,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PCD_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + PCD_HEADER_OFFSET,
+		sizeof (struct pcd_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + PCD_HEADER_OFFSET, 0, -1,
+		sizeof (struct pcd_header)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + PCD_ROT_OFFSET,
+		sizeof (struct pcd_rot_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + PCD_ROT_OFFSET, 0, -1,
+		sizeof (struct pcd_rot_header)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + PCD_COMPONENTS_OFFSET,
+		sizeof (struct pcd_components_header), FLASH_EXP_READ_CMD (0x03,
+		0x10000 + PCD_COMPONENTS_OFFSET, 0, -1, sizeof (struct pcd_components_header)));
+
+	pcd_offset = PCD_COMPONENTS_OFFSET + sizeof (struct pcd_components_header);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + pcd_offset,
+		sizeof (struct pcd_component_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + pcd_offset, 0, -1,
+		sizeof (struct pcd_component_header)));
+
+	pcd_offset += sizeof (struct pcd_component_header);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + pcd_offset,
+		sizeof (struct pcd_component_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + pcd_offset, 0, -1,
+		sizeof (struct pcd_component_header)));
+
+	status = pcd.base.get_devices_info (&pcd.base, &devices_info, &num_devices);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, num_devices);
+	CuAssertPtrNotNull (test, devices_info);
+
+	CuAssertIntEquals (test, 0x10, devices_info[0].smbus_addr);
+	CuAssertIntEquals (test, 0x0C, devices_info[0].eid);
+	CuAssertIntEquals (test, 0x15, devices_info[1].smbus_addr);
+	CuAssertIntEquals (test, 0x0D, devices_info[1].eid);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pcd.base.free_devices_info (&pcd.base, devices_info);
+	pcd_flash_release (&pcd);
+	spi_flash_release (&flash);
+}
+
+static void pcd_flash_test_get_devices_info_arena (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct device_manager_info *devices_info;
+	struct spi_flash flash;
+	struct pcd_flash pcd;
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	size_t num_devices;
+	size_t pcd_offset;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcd_flash_init (&pcd, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_flash_set_arena (&pcd.base_flash, &arena);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA, PCD_HEADER_SIZE,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PCD_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + PCD_HEADER_OFFSET,
+		sizeof (struct pcd_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + PCD_HEADER_OFFSET, 0, -1,
+		sizeof (struct pcd_header)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + PCD_ROT_OFFSET,
+		sizeof (struct pcd_rot_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + PCD_ROT_OFFSET, 0, -1,
+		sizeof (struct pcd_rot_header)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + PCD_COMPONENTS_OFFSET,
+		sizeof (struct pcd_components_header), FLASH_EXP_READ_CMD (0x03,
+		0x10000 + PCD_COMPONENTS_OFFSET, 0, -1, sizeof (struct pcd_components_header)));
+
+	pcd_offset = PCD_COMPONENTS_OFFSET + sizeof (struct pcd_components_header);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + pcd_offset,
+		sizeof (struct pcd_component_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + pcd_offset, 0, -1,
+		sizeof (struct pcd_component_header)));
+
+	pcd_offset += sizeof (struct pcd_component_header);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PCD_DATA + pcd_offset,
+		sizeof (struct pcd_component_header), FLASH_EXP_READ_CMD (0x03, 0x10000 + pcd_offset, 0, -1,
+		sizeof (struct pcd_component_header)));
+
+	status = pcd.base.get_devices_info (&pcd.base, &devices_info, &num_devices);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, num_devices);
+	CuAssertPtrNotNull (test, devices_info);
+
+	CuAssertIntEquals (test, 0x10, devices_info[0].smbus_addr);
+	CuAssertIntEquals (test, 0x0C, devices_info[0].eid);
+	CuAssertIntEquals (test, 0x15, devices_info[1].smbus_addr);
+	CuAssertIntEquals (test, 0x0D, devices_info[1].eid);
+
+	CuAssertTrue (test, ((uint8_t*) devices_info > arena.buffer));
+	CuAssertTrue (test, ((uint8_t*) devices_info < &arena.buffer[arena.size]));
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.results);
+	CuAssertTrue (test, (stats.used >= (sizeof (struct device_manager_info) * 2)));
+	CuAssertIntEquals (test, stats.used, stats.peak);
+
+	pcd.base.free_devices_info (&pcd.base, devices_info);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.results);
+	CuAssertIntEquals (test, 0, stats.used);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pcd_flash_release (&pcd);
+	spi_flash_release (&flash);
+	manifest_arena_release (&arena);
+}
+
 CuSuite* get_pcd_flash_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -5735,6 +5922,8 @@ CuSuite* get_pcd_flash_suite ()
 	SUITE_ADD_TEST (suite, pcd_flash_test_get_port_info_rot_header_read_error);
 	SUITE_ADD_TEST (suite, pcd_flash_test_get_port_info_port_header_read_error);
 	SUITE_ADD_TEST (suite, pcd_flash_test_get_port_info_port_id_invalid);
+	SUITE_ADD_TEST (suite, pcd_flash_test_get_devices_info_free_devices_info);
+	SUITE_ADD_TEST (suite, pcd_flash_test_get_devices_info_arena);
 
 	return suite;
 }
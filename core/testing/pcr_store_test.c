@@ -8,6 +8,7 @@
 #include "platform.h"
 #include "testing.h"
 #include "attestation/pcr_store.h"
+#include "engines/hash_testing_engine.h"
 #include "mock/hash_mock.h"
 
 
@@ -2359,6 +2360,209 @@ static void pcr_store_test_get_measurement_data_invalid_pcr (CuTest *test)
 }
 
 
+static void pcr_store_test_get_tcg_log_cached (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_tcg_log_entry buf[2];
+	struct pcr_store_tcg_log_entry cached[2];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digests[2][PCR_DIGEST_LENGTH] = {
+		{
+			0xab,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+			0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+		},
+		{
+			0xcd,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+			0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+		}
+	};
+	int status;
+
+	TEST_START;
+
+	setup_pcr_store_mock_test (test, &store, &hash, 2, 0);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[0], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[1], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[1], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[1], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[0], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digests[0],
+		PCR_DIGEST_LENGTH);
+	status |= pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 1), digests[1],
+		PCR_DIGEST_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) cached, sizeof (cached));
+	CuAssertIntEquals (test, sizeof (cached), status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No measurements have changed, so no hashing is needed to read the log again. */
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (buf), status);
+
+	status = testing_validate_array ((uint8_t*) cached, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_tcg_log_update_event_type (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_tcg_log_entry buf[2];
+	struct pcr_store_tcg_log_entry expected[2];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digests[2][PCR_DIGEST_LENGTH] = {
+		{
+			0xab,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+			0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+		},
+		{
+			0xcd,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+			0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+		}
+	};
+	int status;
+
+	TEST_START;
+
+	setup_pcr_store_mock_test (test, &store, &hash, 0, 2);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[0], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[0], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[1], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) expected,
+		sizeof (expected));
+	CuAssertIntEquals (test, sizeof (expected), status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_event_type (&store, PCR_MEASUREMENT (1, 1), 0x0C);
+	CuAssertIntEquals (test, 0, status);
+
+	expected[1].entry.event_type = 0x0C;
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (buf), status);
+
+	status = testing_validate_array ((uint8_t*) expected, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, buf[1].header.entry_id);
+	CuAssertIntEquals (test, PCR_MEASUREMENT (1, 1), buf[1].entry.measurement_type);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_tcg_log_update_measurement (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct pcr_store store;
+	struct pcr_store full;
+	uint8_t num_pcr_measurements[3] = {4, 0, 3};
+	struct pcr_store_tcg_log_entry buf[7];
+	struct pcr_store_tcg_log_entry expected[7];
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	int i_measurement;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_init (&store, num_pcr_measurements, sizeof (num_pcr_measurements));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_init (&full, num_pcr_measurements, sizeof (num_pcr_measurements));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i_measurement = 0; i_measurement < 4; ++i_measurement) {
+		memset (digest, i_measurement + 1, sizeof (digest));
+		status = pcr_store_update_digest (&store, PCR_MEASUREMENT (0, i_measurement), digest,
+			sizeof (digest));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (buf), status);
+
+	memset (digest, 0x55, sizeof (digest));
+	status = pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 2), digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_digest (&store, PCR_MEASUREMENT (2, 1), digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_event_type (&store, PCR_MEASUREMENT (2, 2), 0x0A);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (buf), status);
+
+	for (i_measurement = 0; i_measurement < 4; ++i_measurement) {
+		memset (digest, (i_measurement == 2) ? 0x55 : (i_measurement + 1), sizeof (digest));
+		status = pcr_store_update_digest (&full, PCR_MEASUREMENT (0, i_measurement), digest,
+			sizeof (digest));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	memset (digest, 0x55, sizeof (digest));
+	status = pcr_store_update_digest (&full, PCR_MEASUREMENT (2, 1), digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_event_type (&full, PCR_MEASUREMENT (2, 2), 0x0A);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&full, &hash.base, 0, (uint8_t*) expected, sizeof (expected));
+	CuAssertIntEquals (test, sizeof (expected), status);
+
+	status = testing_validate_array ((uint8_t*) expected, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_release (&store);
+	pcr_store_release (&full);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
 CuSuite* get_pcr_store_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -2423,6 +2627,9 @@ CuSuite* get_pcr_store_suite ()
 	SUITE_ADD_TEST (suite, pcr_store_test_get_measurement_data_null);
 	SUITE_ADD_TEST (suite, pcr_store_test_get_measurement_data_no_data);
 	SUITE_ADD_TEST (suite, pcr_store_test_get_measurement_data_invalid_pcr);
+	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_cached);
+	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_update_event_type);
+	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_update_measurement);
 
 	return suite;
 }
@@ -11,6 +11,7 @@
 #include "attestation/pcr_data.h"
 #include "attestation/pcr_store.h"
 #include "flash/flash.h"
+#include "engines/hash_testing_engine.h"
 #include "mock/hash_mock.h"
 #include "mock/logging_mock.h"
 #include "mock/flash_mock.h"
@@ -2617,6 +2618,525 @@ static void pcr_test_get_measurement_data_bad_measurement_data_type (CuTest *tes
 }
 
 
+static void pcr_test_compute_no_changes (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (measurement, 0, sizeof (measurement));
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_incremental (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t buffer2[] = {
+		0xe6,0xe6,0x91,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint8_t digest3[] = {
+		0x7f,0xe6,0x9c,0x6f,0x7f,0x38,0x9d,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe9,0x4f,0x48,0x1a,0x4f,0x8d,0x1d,0x3d,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint8_t digest4[] = {
+		0x1d,0x3d,0xf6,0x5b,0x7f,0x38,0x9d,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe9,0x4f,0x48,0x1a,0x4f,0x8d,0x7f,0xe6,0x9c,0x6f,0x12,0xc7,0xe7,0x6e
+	};
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 3);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest2, sizeof (digest2)), MOCK_ARG (sizeof (digest2)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest3, sizeof (digest3), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 3, status);
+
+	status = testing_validate_array (digest3, measurement, sizeof (digest3));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only the last measurement needs to be extended again. */
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest2, sizeof (digest2)), MOCK_ARG (sizeof (digest2)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer2, sizeof (buffer2)), MOCK_ARG (sizeof (buffer2)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest4, sizeof (digest4), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 2, buffer2, sizeof (buffer2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 3, status);
+
+	status = testing_validate_array (digest4, measurement, sizeof (digest4));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (digest1, pcr.measurement_list[0].measurement,
+		sizeof (digest1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (digest2, pcr.measurement_list[1].measurement,
+		sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_incremental_invalidate (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint8_t digest3[] = {
+		0x7f,0xe6,0x9c,0x6f,0x7f,0x38,0x9d,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe9,0x4f,0x48,0x1a,0x4f,0x8d,0x1d,0x3d,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 1, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest3, sizeof (digest3), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_invalidate_measurement_index (&pcr, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest3, measurement, sizeof (digest3));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_incremental_after_hash_fail (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The computation resumes from the measurement that failed. */
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_incremental_matches_full (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct pcr_bank incremental;
+	struct pcr_bank full;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t expected[PCR_DIGEST_LENGTH];
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_init (&incremental, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 8; i++) {
+		memset (digest, i + 1, sizeof (digest));
+
+		status = pcr_update_digest (&incremental, i, digest, sizeof (digest));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = pcr_compute (&incremental, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 8, status);
+
+	memset (digest, 0x55, sizeof (digest));
+
+	status = pcr_update_digest (&incremental, 5, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_invalidate_measurement_index (&incremental, 6);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&incremental, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 8, status);
+
+	status = pcr_init (&full, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 8; i++) {
+		memset (digest, i + 1, sizeof (digest));
+		if (i == 5) {
+			memset (digest, 0x55, sizeof (digest));
+		}
+		else if (i == 6) {
+			memset (digest, 0, sizeof (digest));
+		}
+
+		status = pcr_update_digest (&full, i, digest, sizeof (digest));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = pcr_compute (&full, &hash.base, expected, true);
+	CuAssertIntEquals (test, 8, status);
+
+	status = testing_validate_array (expected, measurement, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array ((uint8_t*) full.measurement_list,
+		(uint8_t*) incremental.measurement_list, sizeof (struct pcr_measurement) * 8);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_release (&incremental);
+	pcr_release (&full);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void pcr_test_get_stale_log_index (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t digest[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 5);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_set_log_current (&pcr);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 5, status);
+
+	status = pcr_update_event_type (&pcr, 3, 0x0A);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 3, status);
+
+	status = pcr_update_digest (&pcr, 4, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 3, status);
+
+	status = pcr_invalidate_measurement_index (&pcr, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 1, status);
+
+	status = pcr_set_log_current (&pcr);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 5, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_get_stale_log_index_after_compute (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct pcr_bank pcr;
+	uint8_t digest[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_init (&pcr, 5);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, NULL, true);
+	CuAssertIntEquals (test, 5, status);
+
+	status = pcr_set_log_current (&pcr);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, NULL, true);
+	CuAssertIntEquals (test, 5, status);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 5, status);
+
+	status = pcr_update_digest (&pcr, 2, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_set_log_current (&pcr);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Aggregates that are recomputed change the log entries for those measurements. */
+	status = pcr_compute (&pcr, &hash.base, NULL, true);
+	CuAssertIntEquals (test, 5, status);
+
+	status = pcr_get_stale_log_index (&pcr);
+	CuAssertIntEquals (test, 2, status);
+
+	pcr_release (&pcr);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void pcr_test_get_stale_log_index_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = pcr_get_stale_log_index (NULL);
+	CuAssertIntEquals (test, PCR_INVALID_ARGUMENT, status);
+}
+
+static void pcr_test_set_log_current_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = pcr_set_log_current (NULL);
+	CuAssertIntEquals (test, PCR_INVALID_ARGUMENT, status);
+}
+
 CuSuite* get_pcr_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -2712,6 +3232,15 @@ CuSuite* get_pcr_suite ()
 	SUITE_ADD_TEST (suite, pcr_test_get_measurement_data_bad_measurement_index);
 	SUITE_ADD_TEST (suite, pcr_test_get_measurement_data_no_data);
 	SUITE_ADD_TEST (suite, pcr_test_get_measurement_data_bad_measurement_data_type);
+	SUITE_ADD_TEST (suite, pcr_test_compute_no_changes);
+	SUITE_ADD_TEST (suite, pcr_test_compute_incremental);
+	SUITE_ADD_TEST (suite, pcr_test_compute_incremental_invalidate);
+	SUITE_ADD_TEST (suite, pcr_test_compute_incremental_after_hash_fail);
+	SUITE_ADD_TEST (suite, pcr_test_compute_incremental_matches_full);
+	SUITE_ADD_TEST (suite, pcr_test_get_stale_log_index);
+	SUITE_ADD_TEST (suite, pcr_test_get_stale_log_index_after_compute);
+	SUITE_ADD_TEST (suite, pcr_test_get_stale_log_index_null);
+	SUITE_ADD_TEST (suite, pcr_test_set_log_current_null);
 
 	return suite;
 }
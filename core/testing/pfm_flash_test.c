@@ -3155,6 +3155,7 @@ static void pfm_flash_test_free_fw_versions_null_list (CuTest *test)
 
 	fw.count = 1;
 	fw.versions = NULL;
+	fw.context = NULL;
 	pfm.base.free_fw_versions (&pfm.base, &fw);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -7829,6 +7830,7 @@ static void pfm_flash_test_free_firmware_images_null_list (CuTest *test)
 
 	img_list.count = 1;
 	img_list.images = NULL;
+	img_list.context = NULL;
 	pfm.base.free_firmware_images (&pfm.base, &img_list);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -8251,6 +8253,1023 @@ static void pfm_flash_test_get_platform_id_bad_magic_num (CuTest *test)
 }
 
 
+/**
+ * Set up expectations for building the index for a PFM.
+ *
+ * @param test The test framework.
+ * @param flash_mock The flash mock for the PFM.
+ * @param data The PFM data.
+ * @param length The length of the PFM data.
+ * @param sig_length The length of the PFM signature.
+ */
+static void pfm_flash_testing_build_index (CuTest *test, struct flash_master_mock *flash_mock,
+	const uint8_t *data, size_t length, size_t sig_length)
+{
+	int status;
+
+	status = flash_master_mock_expect_rx_xfer (flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PFM_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, length - sig_length));
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void pfm_flash_test_build_index (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_firmware_versions fw;
+	struct pfm_read_write_regions writable;
+	struct pfm_image_list img_list;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	pfm_flash_testing_build_index (test, &flash_mock, PFM_DATA, PFM_DATA_LEN, PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No flash accesses are expected for queries once the index is built. */
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_supported_versions (&pfm.base, &fw);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, fw.count);
+	CuAssertPtrNotNull (test, fw.versions);
+	CuAssertStrEquals (test, PFM_VERSION_ID, fw.versions[0].fw_version_id);
+	CuAssertIntEquals (test, 0x012345, fw.versions[0].version_addr);
+	CuAssertIntEquals (test, 0xff, fw.versions[0].blank_byte);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, PFM_VERSION_ID, &writable);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, writable.count);
+	CuAssertPtrNotNull (test, writable.regions);
+	CuAssertIntEquals (test, 0x2000000, writable.regions[0].start_addr);
+	CuAssertIntEquals (test, 0x2000000, writable.regions[0].length);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, img_list.count);
+	CuAssertPtrNotNull (test, img_list.images);
+
+	CuAssertIntEquals (test, 1, img_list.images[0].count);
+	CuAssertPtrNotNull (test, img_list.images[0].regions);
+	CuAssertIntEquals (test, 1, img_list.images[0].always_validate);
+	CuAssertIntEquals (test, 0, img_list.images[0].regions[0].start_addr);
+	CuAssertIntEquals (test, 0x2000000, img_list.images[0].regions[0].length);
+
+	CuAssertIntEquals (test, 65537, img_list.images[0].key.exponent);
+	CuAssertIntEquals (test, PFM_IMG_KEY_SIZE, img_list.images[0].key.mod_length);
+	status = testing_validate_array (PFM_IMG_KEY, img_list.images[0].key.modulus, PFM_IMG_KEY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, PFM_IMG_KEY_SIZE, img_list.images[0].sig_length);
+	status = testing_validate_array (PFM_IMG_SIGNATURE, img_list.images[0].signature,
+		PFM_IMG_KEY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm.base.free_fw_versions (&pfm.base, &fw);
+	pfm.base.free_read_write_regions (&pfm.base, &writable);
+	pfm.base.free_firmware_images (&pfm.base, &img_list);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_lists_owned_by_index (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_read_write_regions writable;
+	struct pfm_read_write_regions writable2;
+	struct pfm_image_list img_list;
+	struct pfm_image_list img_list2;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, PFM_DATA, PFM_DATA_LEN, PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, PFM_VERSION_ID, &writable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm.base.free_read_write_regions (&pfm.base, &writable);
+	pfm.base.free_firmware_images (&pfm.base, &img_list);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, PFM_VERSION_ID, &writable2);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, (void*) writable.regions, (void*) writable2.regions);
+	CuAssertIntEquals (test, 0x2000000, writable2.regions[0].start_addr);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list2);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, (void*) img_list.images, (void*) img_list2.images);
+	CuAssertIntEquals (test, 0x2000000, img_list2.images[0].regions[0].length);
+
+	pfm.base.free_read_write_regions (&pfm.base, &writable2);
+	pfm.base.free_firmware_images (&pfm.base, &img_list2);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_wrong_version (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_read_write_regions writable;
+	struct pfm_image_list img_list;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, PFM_DATA, PFM_DATA_LEN, PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, "Testing2", &writable);
+	CuAssertIntEquals (test, PFM_UNSUPPORTED_VERSION, status);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, "Testin", &writable);
+	CuAssertIntEquals (test, PFM_UNSUPPORTED_VERSION, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, "Testing2", &img_list);
+	CuAssertIntEquals (test, PFM_UNSUPPORTED_VERSION, status);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, "", &writable);
+	CuAssertIntEquals (test, PFM_INVALID_ARGUMENT, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, "", &img_list);
+	CuAssertIntEquals (test, PFM_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_rebuild (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_image_list img_list;
+	uint8_t pfm_data[PFM_DATA_LEN];
+
+	TEST_START;
+
+	memcpy (pfm_data, PFM_DATA, sizeof (pfm_data));
+	pfm_data[PFM_IMG_FLAGS_OFFSET] = 0;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, PFM_DATA, PFM_DATA_LEN, PFM_SIGNATURE_LEN);
+	pfm_flash_testing_build_index (test, &flash_mock, pfm_data, sizeof (pfm_data),
+		PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, img_list.images[0].always_validate);
+
+	pfm.base.free_firmware_images (&pfm.base, &img_list);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, img_list.images[0].always_validate);
+
+	pfm.base.free_firmware_images (&pfm.base, &img_list);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_rebuild_outstanding_lists (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_firmware_versions fw;
+	struct pfm_read_write_regions writable;
+	struct pfm_image_list img_list;
+	struct pfm_image_list img_list2;
+	uint8_t pfm_data[PFM_DATA_LEN];
+
+	TEST_START;
+
+	memcpy (pfm_data, PFM_DATA, sizeof (pfm_data));
+	pfm_data[PFM_IMG_FLAGS_OFFSET] = 0;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, PFM_DATA, PFM_DATA_LEN, PFM_SIGNATURE_LEN);
+	pfm_flash_testing_build_index (test, &flash_mock, pfm_data, sizeof (pfm_data),
+		PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_supported_versions (&pfm.base, &fw);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, PFM_VERSION_ID, &writable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list2);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, img_list2.images[0].always_validate);
+
+	/* Lists from the previous index are still valid until they are freed. */
+	CuAssertIntEquals (test, 1, fw.count);
+	CuAssertStrEquals (test, PFM_VERSION_ID, fw.versions[0].fw_version_id);
+	CuAssertIntEquals (test, 1, writable.count);
+	CuAssertIntEquals (test, 0x2000000, writable.regions[0].start_addr);
+	CuAssertIntEquals (test, 1, img_list.count);
+	CuAssertIntEquals (test, 1, img_list.images[0].always_validate);
+	CuAssertIntEquals (test, 0x2000000, img_list.images[0].regions[0].length);
+
+	pfm.base.free_fw_versions (&pfm.base, &fw);
+	pfm.base.free_read_write_regions (&pfm.base, &writable);
+	pfm.base.free_firmware_images (&pfm.base, &img_list);
+	pfm.base.free_firmware_images (&pfm.base, &img_list2);
+
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = pfm_flash_build_index (NULL);
+	CuAssertIntEquals (test, PFM_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (NULL));
+}
+
+static void pfm_flash_test_build_index_bad_magic_number (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	uint8_t pfm_bad_data[PFM_SIGNATURE_OFFSET];
+
+	TEST_START;
+
+	memcpy (pfm_bad_data, PFM_DATA, sizeof (pfm_bad_data));
+	pfm_bad_data[2] ^= 0x55;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, pfm_bad_data, sizeof (pfm_bad_data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PFM_HEADER_SIZE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, MANIFEST_BAD_MAGIC_NUMBER, status);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_header_read_error (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_data_read_error (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA, PFM_DATA_LEN,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PFM_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_unknown_key (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	uint8_t pfm_data[PFM_DATA_LEN];
+
+	TEST_START;
+
+	memcpy (pfm_data, PFM_DATA, sizeof (pfm_data));
+	pfm_data[PFM_IMG_HEADER_OFFSET + 4] = 1;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, pfm_data, sizeof (pfm_data),
+		PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, PFM_UNKNOWN_KEY_ID, status);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_signature_too_long (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	uint8_t pfm_data[PFM_DATA_LEN];
+
+	TEST_START;
+
+	memcpy (pfm_data, PFM_DATA, sizeof (pfm_data));
+	pfm_data[PFM_IMG_HEADER_OFFSET + 6] = 0xff;
+	pfm_data[PFM_IMG_HEADER_OFFSET + 7] = 0xff;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, pfm_data, sizeof (pfm_data),
+		PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, MANIFEST_MALFORMED, status);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_build_index_truncated (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	uint8_t pfm_data[PFM_DATA_LEN];
+
+	TEST_START;
+
+	/* Make the signature cover the image data so the firmware descriptor is truncated. */
+	memcpy (pfm_data, PFM_DATA, sizeof (pfm_data));
+	pfm_data[8] = 0x00;
+	pfm_data[9] = 0x03;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, pfm_data, sizeof (pfm_data), 0x300);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, MANIFEST_MALFORMED, status);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_release_index (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_firmware_versions fw;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, PFM_DATA, PFM_DATA_LEN, PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release_index (&pfm);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	/* Queries are answered from flash once the index has been released. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA, PFM_DATA_LEN,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PFM_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_ALLOWED_HDR_OFFSET,
+		PFM_DATA_LEN - PFM_ALLOWED_HDR_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_ALLOWED_HDR_OFFSET, 0, -1, PFM_ALLOWED_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_FW_HEADER_OFFSET,
+		PFM_DATA_LEN - PFM_FW_HEADER_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_FW_HEADER_OFFSET, 0, -1, PFM_FW_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_VERSION_OFFSET,
+		PFM_DATA_LEN - PFM_VERSION_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_VERSION_OFFSET, 0, -1, strlen (PFM_VERSION_ID)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_supported_versions (&pfm.base, &fw);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, fw.count);
+	CuAssertStrEquals (test, PFM_VERSION_ID, fw.versions[0].fw_version_id);
+
+	pfm.base.free_fw_versions (&pfm.base, &fw);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_release_index_outstanding_lists (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_firmware_versions fw;
+	struct pfm_read_write_regions writable;
+	struct pfm_image_list img_list;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_testing_build_index (test, &flash_mock, PFM_DATA, PFM_DATA_LEN, PFM_SIGNATURE_LEN);
+
+	status = pfm_flash_build_index (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_supported_versions (&pfm.base, &fw);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_read_write_regions (&pfm.base, PFM_VERSION_ID, &writable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, PFM_VERSION_ID, &img_list);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release_index (&pfm);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&pfm));
+
+	/* Lists from the released index are still valid until they are freed. */
+	CuAssertIntEquals (test, 1, fw.count);
+	CuAssertStrEquals (test, PFM_VERSION_ID, fw.versions[0].fw_version_id);
+	CuAssertIntEquals (test, 1, writable.count);
+	CuAssertIntEquals (test, 0x2000000, writable.regions[0].length);
+	CuAssertIntEquals (test, 1, img_list.count);
+	CuAssertIntEquals (test, 0, img_list.images[0].regions[0].start_addr);
+
+	pfm.base.free_fw_versions (&pfm.base, &fw);
+	pfm.base.free_read_write_regions (&pfm.base, &writable);
+	pfm.base.free_firmware_images (&pfm.base, &img_list);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+}
+
+static void pfm_flash_test_release_index_null (CuTest *test)
+{
+	TEST_START;
+
+	pfm_flash_release_index (NULL);
+}
+
+static void pfm_flash_test_get_firmware_images_arena (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_image_list img_list;
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_init (&arena, 2048);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_flash_set_arena (&pfm.base_flash, &arena);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA, PFM_DATA_LEN,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PFM_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_ALLOWED_HDR_OFFSET,
+		PFM_DATA_LEN - PFM_ALLOWED_HDR_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_ALLOWED_HDR_OFFSET, 0, -1, PFM_ALLOWED_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_FW_HEADER_OFFSET,
+		PFM_DATA_LEN - PFM_FW_HEADER_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_FW_HEADER_OFFSET, 0, -1, PFM_FW_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_VERSION_OFFSET,
+		PFM_DATA_LEN - PFM_VERSION_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_VERSION_OFFSET, 0, -1, strlen (PFM_VERSION_ID)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_IMG_HEADER_OFFSET,
+		PFM_DATA_LEN - PFM_IMG_HEADER_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_IMG_HEADER_OFFSET, 0, -1, PFM_IMG_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_IMG_SIGNATURE, PFM_IMG_KEY_SIZE,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_IMG_SIG_OFFSET, 0, -1, PFM_IMG_KEY_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_IMG_REGION_OFFSET,
+		PFM_DATA_LEN - PFM_IMG_REGION_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_IMG_REGION_OFFSET, 0, -1, PFM_REGION_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_MANIFEST_OFFSET,
+		PFM_DATA_LEN - PFM_MANIFEST_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_MANIFEST_OFFSET, 0, -1, PFM_MANIFEST_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_DATA + PFM_KEY_HEADER_OFFSET,
+		PFM_DATA_LEN - PFM_KEY_HEADER_OFFSET,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_KEY_HEADER_OFFSET, 0, -1, PFM_KEY_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, PFM_IMG_KEY, PFM_IMG_KEY_SIZE,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_IMG_KEY_OFFSET, 0, -1, PFM_IMG_KEY_SIZE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_firmware_images (&pfm.base, "Testing", &img_list);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, img_list.count);
+	CuAssertPtrNotNull (test, img_list.images);
+
+	CuAssertIntEquals (test, 1, img_list.images[0].count);
+	CuAssertPtrNotNull (test, img_list.images[0].regions);
+	CuAssertIntEquals (test, 1, img_list.images[0].always_validate);
+	CuAssertIntEquals (test, 0, img_list.images[0].regions[0].start_addr);
+	CuAssertIntEquals (test, 0x2000000, img_list.images[0].regions[0].length);
+
+	CuAssertIntEquals (test, 65537, img_list.images[0].key.exponent);
+	CuAssertIntEquals (test, PFM_IMG_KEY_SIZE, img_list.images[0].key.mod_length);
+	status = testing_validate_array (PFM_IMG_KEY, img_list.images[0].key.modulus, PFM_IMG_KEY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, PFM_IMG_KEY_SIZE, img_list.images[0].sig_length);
+	status = testing_validate_array (PFM_IMG_SIGNATURE, img_list.images[0].signature,
+		PFM_IMG_KEY_SIZE);
+
+	CuAssertIntEquals (test, 0, status);
+
+	/* The complete result is stored contiguously in the arena. */
+	CuAssertTrue (test, ((uint8_t*) img_list.images > arena.buffer));
+	CuAssertPtrEquals (test, (void*) &img_list.images[1], (void*) img_list.images[0].regions);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.results);
+	CuAssertIntEquals (test, (size_t) ((uint8_t*) &img_list.images[0].regions[1] - arena.buffer),
+		stats.used);
+
+	pfm.base.free_firmware_images (&pfm.base, &img_list);
+
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.results);
+	CuAssertIntEquals (test, 0, stats.used);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+	manifest_arena_release (&arena);
+}
+
+static void pfm_flash_test_get_supported_versions_id_read_error_arena (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct pfm_flash pfm;
+	int status;
+	struct pfm_firmware_versions fw;
+	struct manifest_arena arena;
+	struct manifest_arena_stats stats;
+	const char *version1 = "Version1";
+	const char *version2 = "Version2";
+	const char *version3 = "Version3";
+	uint8_t pfm_data[PFM_HEADER_SIZE + PFM_ALLOWED_HEADER_SIZE + (PFM_FW_HEADER_SIZE * 3) +
+		(strlen (version1) * 3)];
+	struct manifest_header *header;
+	struct pfm_allowable_firmware_header *allowed_header;
+	struct pfm_firmware_header *fw_header;
+	int offset1 = PFM_HEADER_SIZE + PFM_ALLOWED_HEADER_SIZE;
+	int offset2 = offset1 + PFM_FW_HEADER_SIZE + strlen (version1);
+	int offset3 = offset2 + PFM_FW_HEADER_SIZE + strlen (version2);
+
+	TEST_START;
+
+	memset (pfm_data, 0, sizeof (pfm_data));
+
+	header = (struct manifest_header*) pfm_data;
+	header->length = sizeof (pfm_data);
+	header->magic = PFM_MAGIC_NUM;
+
+	allowed_header = (struct pfm_allowable_firmware_header*) &pfm_data[PFM_HEADER_SIZE];
+	allowed_header->length = PFM_ALLOWED_HEADER_SIZE;
+	allowed_header->fw_count = 3;
+
+	fw_header = (struct pfm_firmware_header*) &pfm_data[offset1];
+	fw_header->length = PFM_FW_HEADER_SIZE + strlen (version1);
+	fw_header->version_addr = 0x12345;
+	fw_header->version_length = strlen (version1);
+	memcpy (&pfm_data[offset1 + PFM_FW_HEADER_SIZE], version1, strlen (version1));
+	allowed_header->length += fw_header->length;
+
+	fw_header = (struct pfm_firmware_header*) &pfm_data[offset2];
+	fw_header->length = PFM_FW_HEADER_SIZE + strlen (version2);
+	fw_header->version_addr = 0x6789;
+	fw_header->version_length = strlen (version2);
+	memcpy (&pfm_data[offset2 + PFM_FW_HEADER_SIZE], version2, strlen (version2));
+	allowed_header->length += fw_header->length;
+
+	fw_header = (struct pfm_firmware_header*) &pfm_data[offset3];
+	fw_header->length = PFM_FW_HEADER_SIZE + strlen (version3);
+	fw_header->version_addr = 0x112233;
+	fw_header->version_length = strlen (version3);
+	memcpy (&pfm_data[offset3 + PFM_FW_HEADER_SIZE], version3, strlen (version3));
+	allowed_header->length += fw_header->length;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&pfm, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_arena_init (&arena, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_flash_set_arena (&pfm.base_flash, &arena);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, pfm_data, sizeof (pfm_data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, PFM_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, pfm_data + PFM_HEADER_SIZE,
+		sizeof (pfm_data) - PFM_HEADER_SIZE,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + PFM_HEADER_SIZE, 0, -1, PFM_ALLOWED_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, pfm_data + offset1,
+		sizeof (pfm_data) - offset1,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + offset1, 0, -1, PFM_FW_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0,
+		pfm_data + offset1 + PFM_FW_HEADER_SIZE, sizeof (pfm_data) - offset1 - PFM_FW_HEADER_SIZE,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + offset1 + PFM_FW_HEADER_SIZE, 0, -1, strlen (version1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, pfm_data + offset2,
+		sizeof (pfm_data) - offset2,
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + offset2, 0, -1, PFM_FW_HEADER_SIZE));
+
+	status |= flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm.base.get_supported_versions (&pfm.base, &fw);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	/* All memory allocated for the failed query is returned to the arena. */
+	status = manifest_arena_get_stats (&arena, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.results);
+	CuAssertIntEquals (test, 0, stats.used);
+	CuAssertTrue (test, (stats.peak != 0));
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_flash_release (&pfm);
+
+	spi_flash_release (&flash);
+	manifest_arena_release (&arena);
+}
+
 CuSuite* get_pfm_flash_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -8343,6 +9362,23 @@ CuSuite* get_pfm_flash_suite ()
 	SUITE_ADD_TEST (suite, pfm_flash_test_get_platform_id_platform_header_read_error);
 	SUITE_ADD_TEST (suite, pfm_flash_test_get_platform_id_identifier_read_error);
 	SUITE_ADD_TEST (suite, pfm_flash_test_get_platform_id_bad_magic_num);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_lists_owned_by_index);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_wrong_version);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_rebuild);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_rebuild_outstanding_lists);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_null);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_bad_magic_number);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_header_read_error);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_data_read_error);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_unknown_key);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_signature_too_long);
+	SUITE_ADD_TEST (suite, pfm_flash_test_build_index_truncated);
+	SUITE_ADD_TEST (suite, pfm_flash_test_release_index);
+	SUITE_ADD_TEST (suite, pfm_flash_test_release_index_outstanding_lists);
+	SUITE_ADD_TEST (suite, pfm_flash_test_release_index_null);
+	SUITE_ADD_TEST (suite, pfm_flash_test_get_firmware_images_arena);
+	SUITE_ADD_TEST (suite, pfm_flash_test_get_supported_versions_id_read_error_arena);
 
 	return suite;
 }
@@ -0,0 +1,340 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "manifest/pfm/pfm_observer_index.h"
+#include "mock/flash_master_mock.h"
+#include "mock/pfm_mock.h"
+#include "pfm_testing.h"
+
+
+static const char *SUITE = "pfm_observer_index";
+
+
+/**
+ * Dependencies for testing the PFM index observer.
+ */
+struct pfm_observer_index_testing {
+	struct flash_master_mock flash_mock;		/**< Flash mock for the PFM regions. */
+	struct spi_flash flash;						/**< Flash device for the PFM regions. */
+	struct pfm_flash region1;					/**< The first PFM region. */
+	struct pfm_flash region2;					/**< The second PFM region. */
+	struct pfm_observer_index observer;			/**< The observer under test. */
+};
+
+/**
+ * Initialize the dependencies for testing the PFM index observer.
+ *
+ * @param test The test framework.
+ * @param observer The testing components to initialize.
+ */
+static void pfm_observer_index_testing_init (CuTest *test,
+	struct pfm_observer_index_testing *observer)
+{
+	int status;
+
+	status = flash_master_mock_init (&observer->flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&observer->flash, &observer->flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&observer->flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&observer->region1, &observer->flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_flash_init (&observer->region2, &observer->flash, 0x20000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_observer_index_init (&observer->observer, &observer->region1,
+		&observer->region2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release the dependencies for testing the PFM index observer.
+ *
+ * @param test The test framework.
+ * @param observer The testing components to release.
+ */
+static void pfm_observer_index_testing_release (CuTest *test,
+	struct pfm_observer_index_testing *observer)
+{
+	int status;
+
+	status = flash_master_mock_validate_and_release (&observer->flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_observer_index_release (&observer->observer);
+	pfm_flash_release (&observer->region1);
+	pfm_flash_release (&observer->region2);
+	spi_flash_release (&observer->flash);
+}
+
+/**
+ * Set up expectations for building the index for a PFM.
+ *
+ * @param test The test framework.
+ * @param observer The testing components.
+ * @param addr The address of the PFM.
+ */
+static void pfm_observer_index_testing_expect_build (CuTest *test,
+	struct pfm_observer_index_testing *observer, uint32_t addr)
+{
+	int status;
+
+	status = flash_master_mock_expect_rx_xfer (&observer->flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&observer->flash_mock, 0, PFM_DATA, PFM_DATA_LEN,
+		FLASH_EXP_READ_CMD (0x03, addr, 0, -1, sizeof (struct manifest_header)));
+
+	status |= flash_master_mock_expect_rx_xfer (&observer->flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&observer->flash_mock, 0, PFM_DATA, PFM_DATA_LEN,
+		FLASH_EXP_READ_CMD (0x03, addr, 0, -1, PFM_SIGNATURE_OFFSET));
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void pfm_observer_index_test_init (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+
+	CuAssertPtrNotNull (test, observer.observer.base.on_pfm_verified);
+	CuAssertPtrNotNull (test, observer.observer.base.on_pfm_activated);
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_init_null (CuTest *test)
+{
+	struct pfm_flash region1;
+	struct pfm_flash region2;
+	struct pfm_observer_index observer;
+	int status;
+
+	TEST_START;
+
+	status = pfm_observer_index_init (NULL, &region1, &region2);
+	CuAssertIntEquals (test, PFM_OBSERVER_INVALID_ARGUMENT, status);
+
+	status = pfm_observer_index_init (&observer, NULL, &region2);
+	CuAssertIntEquals (test, PFM_OBSERVER_INVALID_ARGUMENT, status);
+
+	status = pfm_observer_index_init (&observer, &region1, NULL);
+	CuAssertIntEquals (test, PFM_OBSERVER_INVALID_ARGUMENT, status);
+}
+
+static void pfm_observer_index_test_release (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x10000);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x20000);
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region1.base);
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region2.base);
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region1));
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region2));
+
+	pfm_observer_index_release (&observer.observer);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region1));
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region2));
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	pfm_observer_index_release (NULL);
+}
+
+static void pfm_observer_index_test_on_pfm_verified_region1 (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x10000);
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region1.base);
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region1));
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region2));
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_on_pfm_verified_region2 (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x20000);
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region2.base);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region1));
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region2));
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_on_pfm_verified_rebuild (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x10000);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x10000);
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region1.base);
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region1));
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region1.base);
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region1));
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_on_pfm_verified_build_error (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+	int status;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+
+	status = flash_master_mock_expect_xfer (&observer.flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region1.base);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region1));
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_on_pfm_verified_unknown_pfm (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+	struct pfm_mock pfm;
+	int status;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &pfm.base);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region1));
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region2));
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_on_pfm_activated (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x20000);
+
+	observer.observer.base.on_pfm_activated (&observer.observer.base, &observer.region2.base);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region1));
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region2));
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_on_pfm_activated_already_indexed (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+	pfm_observer_index_testing_expect_build (test, &observer, 0x10000);
+
+	observer.observer.base.on_pfm_verified (&observer.observer.base, &observer.region1.base);
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region1));
+
+	observer.observer.base.on_pfm_activated (&observer.observer.base, &observer.region1.base);
+	CuAssertIntEquals (test, true, pfm_flash_is_indexed (&observer.region1));
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+static void pfm_observer_index_test_on_pfm_activated_unknown_pfm (CuTest *test)
+{
+	struct pfm_observer_index_testing observer;
+	struct pfm_mock pfm;
+	int status;
+
+	TEST_START;
+
+	pfm_observer_index_testing_init (test, &observer);
+
+	status = pfm_mock_init (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	observer.observer.base.on_pfm_activated (&observer.observer.base, &pfm.base);
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region1));
+	CuAssertIntEquals (test, false, pfm_flash_is_indexed (&observer.region2));
+
+	status = pfm_mock_validate_and_release (&pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	pfm_observer_index_testing_release (test, &observer);
+}
+
+
+CuSuite* get_pfm_observer_index_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_init);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_init_null);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_release);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_release_null);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_verified_region1);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_verified_region2);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_verified_rebuild);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_verified_build_error);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_verified_unknown_pfm);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_activated);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_activated_already_indexed);
+	SUITE_ADD_TEST (suite, pfm_observer_index_test_on_pfm_activated_unknown_pfm);
+
+	return suite;
+}
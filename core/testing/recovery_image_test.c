@@ -318,6 +318,53 @@ static int setup_expect_copy_to_host_flash (struct flash_master_mock *mock_dest,
 
 }
 
+/**
+ * Helper function to set up expectations for copying data to host flash through a copy stream.
+ *
+ * @param mock_dest The destination flash mock.
+ * @param mock_src The source flash mock.
+ * @param dest_addr The destination address to copy data to.
+ * @param src_addr The source address to copy data from.
+ * @param data The data to copy to host flash.
+ * @param length The size of data to copy.  This must fit in a single stream chunk.
+ *
+ * @return 0 if the mock expectation set-up was successful or an error code.
+ */
+static int setup_expect_stream_copy_to_host_flash (struct flash_master_mock *mock_dest,
+	struct flash_mock *mock_src, uint32_t dest_addr, uint32_t src_addr, const uint8_t *data,
+	size_t length)
+{
+	int status;
+	uint32_t page_offset = FLASH_REGION_OFFSET (dest_addr, FLASH_PAGE_SIZE);
+	uint32_t addr = dest_addr;
+	size_t remaining = length;
+	size_t pos = 0;
+	size_t block_len;
+
+	status = mock_expect (&mock_src->mock, mock_src->base.read, mock_src, 0, MOCK_ARG (src_addr),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (length));
+	status |= mock_expect_output (&mock_src->mock, 1, data, length, 2);
+
+	while (remaining > 0) {
+		block_len = FLASH_PAGE_SIZE - page_offset;
+		block_len = (remaining > block_len) ? block_len : remaining;
+
+		status |= flash_master_mock_expect_write (mock_dest, addr, &data[pos], block_len);
+
+		remaining -= block_len;
+		addr += block_len;
+		pos += block_len;
+		page_offset = 0;
+	}
+
+	status |= flash_master_mock_expect_rx_xfer (mock_dest, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (mock_dest, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, dest_addr, 0, -1, length));
+
+	return status;
+}
+
 /**
  * Helper function to setup the recovery image to use mocks.
  *
@@ -2996,7 +3043,7 @@ static void recovery_image_test_apply_to_flash (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, &host_flash);
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, NULL);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3099,7 +3146,7 @@ static void recovery_image_test_apply_to_flash_with_multiple_recovery_sections (
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, &host_flash);
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, NULL);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3190,7 +3237,7 @@ static void recovery_image_test_apply_to_flash_section_image_length_too_short (C
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, &host_flash);
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, NULL);
 	CuAssertIntEquals (test, IMAGE_HEADER_BAD_MARKER, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3275,7 +3322,7 @@ static void recovery_image_test_apply_to_flash_section_image_length_too_long (Cu
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, &host_flash);
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, NULL);
 	CuAssertIntEquals (test, RECOVERY_IMAGE_MALFORMED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3329,7 +3376,7 @@ static void recovery_image_test_apply_to_flash_bad_image_header (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, &host_flash);
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, NULL);
 	CuAssertIntEquals (test, RECOVERY_IMAGE_HEADER_BAD_FORMAT_LENGTH, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3390,7 +3437,7 @@ static void recovery_image_test_apply_to_flash_bad_section_header (CuTest *test)
 		2);
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, &host_flash);
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, NULL);
 	CuAssertIntEquals (test, RECOVERY_IMAGE_SECTION_HEADER_BAD_FORMAT_LENGTH, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3461,7 +3508,7 @@ static void recovery_image_test_apply_to_flash_read_data_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, &host_flash);
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, NULL);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3499,10 +3546,137 @@ static void recovery_image_test_apply_to_flash_null (CuTest *test)
 	status = recovery_image_init (&recovery_image, &flash.base, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = recovery_image.apply_to_flash (NULL, &host_flash);
+	status = recovery_image.apply_to_flash (NULL, &host_flash, NULL);
 	CuAssertIntEquals (test, RECOVERY_IMAGE_INVALID_ARGUMENT, status);
 
-	status = recovery_image.apply_to_flash (&recovery_image, NULL);
+	status = recovery_image.apply_to_flash (&recovery_image, NULL, NULL);
+	CuAssertIntEquals (test, RECOVERY_IMAGE_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&host_flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	recovery_image_release (&recovery_image);
+	spi_flash_release (&host_flash);
+}
+
+static void recovery_image_test_apply_to_flash_copy_stream (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_master_mock host_flash_mock;
+	struct spi_flash host_flash;
+	struct recovery_image recovery_image;
+	struct flash_copy_stream stream;
+	uint32_t src_addr;
+	uint32_t dest_addr;
+	uint32_t data_size;
+	const uint8_t *data;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&host_flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&host_flash, &host_flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&host_flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = recovery_image_init (&recovery_image, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &host_flash.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, RECOVERY_IMAGE_DATA,
+		RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + IMAGE_HEADER_BASE_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (RECOVERY_IMAGE_HEADER_FORMAT_0_LEN));
+	status |= mock_expect_output (&flash.mock, 1, RECOVERY_IMAGE_DATA +
+		IMAGE_HEADER_BASE_LEN, RECOVERY_IMAGE_HEADER_FORMAT_0_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000 +
+		RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (
+		IMAGE_HEADER_BASE_LEN));
+	status |= mock_expect_output (&flash.mock, 1, RECOVERY_IMAGE_DATA +
+		RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN, RECOVERY_IMAGE_SECTION_HEADER_FORMAT_0_TOTAL_LEN,
+		2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x10000 + RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN + IMAGE_HEADER_BASE_LEN),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (RECOVERY_IMAGE_SECTION_HEADER_FORMAT_0_LEN));
+	status |= mock_expect_output (&flash.mock, 1, RECOVERY_IMAGE_DATA +
+		RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN + IMAGE_HEADER_BASE_LEN,
+		RECOVERY_IMAGE_SECTION_HEADER_FORMAT_0_LEN, 2);
+
+	src_addr = 0x10000 + RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN +
+		RECOVERY_IMAGE_SECTION_HEADER_FORMAT_0_TOTAL_LEN;
+	dest_addr = *((uint32_t*) &RECOVERY_IMAGE_DATA[RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN +
+		IMAGE_HEADER_BASE_LEN]);
+	data = RECOVERY_IMAGE_DATA + RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN +
+		RECOVERY_IMAGE_SECTION_HEADER_FORMAT_0_TOTAL_LEN;
+	data_size = *((uint32_t*) &RECOVERY_IMAGE_DATA[RECOVERY_IMAGE_HEADER_FORMAT_0_TOTAL_LEN +
+		IMAGE_HEADER_BASE_LEN + 4]);
+	status |= setup_expect_stream_copy_to_host_flash (&host_flash_mock, &flash, dest_addr, src_addr,
+		data, data_size);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, &stream);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&host_flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_copy_stream_release (&stream);
+	recovery_image_release (&recovery_image);
+	spi_flash_release (&host_flash);
+}
+
+static void recovery_image_test_apply_to_flash_copy_stream_wrong_flash (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_master_mock host_flash_mock;
+	struct spi_flash host_flash;
+	struct recovery_image recovery_image;
+	struct flash_copy_stream stream;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&host_flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&host_flash, &host_flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&host_flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = recovery_image_init (&recovery_image, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_copy_stream_init (&stream, &flash.base, FLASH_COPY_STREAM_MIN_CHUNK);
+	CuAssertIntEquals (test, 0, status);
+
+	status = recovery_image.apply_to_flash (&recovery_image, &host_flash, &stream);
 	CuAssertIntEquals (test, RECOVERY_IMAGE_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -3511,6 +3685,7 @@ static void recovery_image_test_apply_to_flash_null (CuTest *test)
 	status = flash_master_mock_validate_and_release (&host_flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	flash_copy_stream_release (&stream);
 	recovery_image_release (&recovery_image);
 	spi_flash_release (&host_flash);
 }
@@ -3570,6 +3745,9 @@ CuSuite* get_recovery_image_suite ()
 	SUITE_ADD_TEST (suite, recovery_image_test_apply_to_flash_bad_section_header);
 	SUITE_ADD_TEST (suite, recovery_image_test_apply_to_flash_read_data_error);
 	SUITE_ADD_TEST (suite, recovery_image_test_apply_to_flash_null);
+	SUITE_ADD_TEST (suite, recovery_image_test_apply_to_flash_copy_stream);
+	SUITE_ADD_TEST (suite,
+		recovery_image_test_apply_to_flash_copy_stream_wrong_flash);
 
 	return suite;
 }
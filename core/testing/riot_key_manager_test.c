@@ -2561,6 +2561,16 @@ static void riot_key_manager_test_get_intermediate_ca_null (CuTest *test)
 	CuAssertPtrEquals (test, NULL, (struct der_cert*) int_ca);
 }
 
+static void riot_key_manager_test_get_ca_version_null (CuTest *test)
+{
+	uint32_t ca_version;
+
+	TEST_START;
+
+	ca_version = riot_key_manager_get_ca_version (NULL);
+	CuAssertIntEquals (test, 0, ca_version);
+}
+
 static void riot_key_manager_test_verify_stored_certs_no_signed_device_id (CuTest *test)
 {
 	X509_TESTING_ENGINE x509;
@@ -2738,6 +2748,7 @@ static void riot_key_manager_test_verify_stored_certs_signed_device_id (CuTest *
 	uint8_t *dev_id_der = NULL;
 	uint8_t *ca_der = NULL;
 	uint8_t *int_der = NULL;
+	uint32_t ca_version;
 
 	TEST_START;
 
@@ -2788,9 +2799,13 @@ static void riot_key_manager_test_verify_stored_certs_signed_device_id (CuTest *
 
 	CuAssertIntEquals (test, 0, status);
 
+	ca_version = riot_key_manager_get_ca_version (&manager);
+
 	status = riot_key_manager_verify_stored_certs (&manager);
 	CuAssertIntEquals (test, 0, status);
 
+	CuAssertTrue (test, (ca_version != riot_key_manager_get_ca_version (&manager)));
+
 	dev_keys = riot_key_manager_get_riot_keys (&manager);
 	CuAssertTrue (test, (&keys != dev_keys));
 
@@ -7189,6 +7204,7 @@ CuSuite* get_riot_key_manager_suite ()
 	SUITE_ADD_TEST (suite, riot_key_manager_test_get_riot_keys_null);
 	SUITE_ADD_TEST (suite, riot_key_manager_test_get_root_ca_null);
 	SUITE_ADD_TEST (suite, riot_key_manager_test_get_intermediate_ca_null);
+	SUITE_ADD_TEST (suite, riot_key_manager_test_get_ca_version_null);
 	SUITE_ADD_TEST (suite, riot_key_manager_test_verify_stored_certs_no_signed_device_id);
 	SUITE_ADD_TEST (suite, riot_key_manager_test_verify_stored_certs_bad_signed_device_id);
 	SUITE_ADD_TEST (suite, riot_key_manager_test_verify_stored_certs_signed_device_id);
@@ -94,6 +94,7 @@ static void rsa_mbedtls_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.get_public_key_der);
 	CuAssertPtrNotNull (test, engine.base.decrypt);
 	CuAssertPtrNotNull (test, engine.base.sig_verify);
+	CuAssertPtrNotNull (test, engine.base.invalidate_public_key);
 
 	rsa_mbedtls_release (&engine);
 }
@@ -959,6 +960,303 @@ static void rsa_mbedtls_test_decrypt_wrong_hash (CuTest *test)
 }
 
 
+/**
+ * Count the number of public keys loaded in the RSA engine key cache.
+ *
+ * @param engine The RSA engine to query.
+ *
+ * @return The number of cached keys.
+ */
+static int rsa_mbedtls_testing_cached_key_count (struct rsa_engine_mbedtls *engine)
+{
+	int count = 0;
+	int i;
+
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		if (engine->key_cache[i].valid) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Check if a public key is loaded in the RSA engine key cache.
+ *
+ * @param engine The RSA engine to query.
+ * @param key The public key to find.
+ *
+ * @return true if the key is in the cache.
+ */
+static bool rsa_mbedtls_testing_is_key_cached (struct rsa_engine_mbedtls *engine,
+	const struct rsa_public_key *key)
+{
+	int i;
+
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		if (engine->key_cache[i].valid && rsa_same_public_key (&engine->key_cache[i].key, key)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void rsa_mbedtls_test_sig_verify_cached_key (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, rsa_mbedtls_testing_cached_key_count (&engine));
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rsa_mbedtls_testing_cached_key_count (&engine));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY));
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_NOPE,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	CuAssertIntEquals (test, 1, rsa_mbedtls_testing_cached_key_count (&engine));
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, rsa_mbedtls_testing_cached_key_count (&engine));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY2));
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, rsa_mbedtls_testing_cached_key_count (&engine));
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_sig_verify_cache_full (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct rsa_public_key other_key;
+	int status;
+	int i;
+
+	TEST_START;
+
+	memcpy (&other_key, &RSA_PUBLIC_KEY2, sizeof (other_key));
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Fill the rest of the cache with keys that use different exponents.  Signatures will not
+	 * match, but the keys are still loaded. */
+	for (i = 0; i < (RSA_MBEDTLS_KEY_CACHE_SIZE - 1); i++) {
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, 0, status);
+
+		other_key.exponent = 3 + (i * 2);
+		status = engine.base.sig_verify (&engine.base, &other_key, RSA_SIGNATURE2_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	}
+
+	CuAssertIntEquals (test, RSA_MBEDTLS_KEY_CACHE_SIZE,
+		rsa_mbedtls_testing_cached_key_count (&engine));
+
+	/* The most recently used key stays loaded while the least recently used key is replaced. */
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY));
+	CuAssertIntEquals (test, false,
+		rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY2));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &other_key));
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, RSA_MBEDTLS_KEY_CACHE_SIZE,
+		rsa_mbedtls_testing_cached_key_count (&engine));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY2));
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_sig_verify_reuses_cached_context (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, true, engine.key_cache[0].valid);
+	CuAssertIntEquals (test, true,
+		rsa_same_public_key (&engine.key_cache[0].key, &RSA_PUBLIC_KEY));
+
+	/* Change the exponent in the cached context.  Verification will only fail if the cached
+	 * context is used instead of loading the key again. */
+	status = mbedtls_mpi_lset (&engine.key_cache[0].context.E, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 10; i++) {
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	}
+
+	CuAssertIntEquals (test, 1, rsa_mbedtls_testing_cached_key_count (&engine));
+	CuAssertIntEquals (test, 11, engine.key_cache[0].last_used);
+
+	/* Invalidating the key causes it to be loaded again on the next verification. */
+	engine.base.invalidate_public_key (&engine.base, &RSA_PUBLIC_KEY);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_invalidate_public_key (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.invalidate_public_key (&engine.base, &RSA_PUBLIC_KEY);
+
+	CuAssertIntEquals (test, 1, rsa_mbedtls_testing_cached_key_count (&engine));
+	CuAssertIntEquals (test, false, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY2));
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, rsa_mbedtls_testing_cached_key_count (&engine));
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_invalidate_public_key_not_cached (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.invalidate_public_key (&engine.base, &RSA_PUBLIC_KEY2);
+
+	CuAssertIntEquals (test, 1, rsa_mbedtls_testing_cached_key_count (&engine));
+	CuAssertIntEquals (test, true, rsa_mbedtls_testing_is_key_cached (&engine, &RSA_PUBLIC_KEY));
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_invalidate_public_key_all (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.invalidate_public_key (&engine.base, NULL);
+
+	CuAssertIntEquals (test, 0, rsa_mbedtls_testing_cached_key_count (&engine));
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_invalidate_public_key_null (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.invalidate_public_key (NULL, &RSA_PUBLIC_KEY);
+
+	CuAssertIntEquals (test, 1, rsa_mbedtls_testing_cached_key_count (&engine));
+
+	rsa_mbedtls_release (&engine);
+}
+
 CuSuite* get_rsa_mbedtls_suite ()
 {
 	CuSuite *suite = CuSuiteNew ();
@@ -1000,6 +1298,13 @@ CuSuite* get_rsa_mbedtls_suite ()
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_decrypt_wrong_key);
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_decrypt_with_wrong_label);
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_decrypt_wrong_hash);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_cached_key);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_cache_full);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_reuses_cached_context);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_invalidate_public_key);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_invalidate_public_key_not_cached);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_invalidate_public_key_all);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_invalidate_public_key_null);
 
 	return suite;
 }
@@ -0,0 +1,1858 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "testing.h"
+#include "crypto/checksum.h"
+#include "flash/flash.h"
+#include "flash/flash_common.h"
+#include "mock/flash_mock.h"
+#include "tpm/tpm_nv_log.h"
+
+
+static const char *SUITE = "tpm_nv_log";
+
+
+/**
+ * Length of a log record containing a storage segment.
+ */
+#define	TPM_NV_LOG_TESTING_SEGMENT_LEN	\
+	(sizeof (struct tpm_nv_log_record) + TPM_STORAGE_SEGMENT_SIZE)
+
+/**
+ * Length of a log record containing the TPM header.
+ */
+#define	TPM_NV_LOG_TESTING_HEADER_LEN	\
+	(sizeof (struct tpm_nv_log_record) + sizeof (struct tpm_header))
+
+
+/**
+ * Build a log record.
+ *
+ * @param buffer Output for the record.
+ * @param type The type of record.
+ * @param index The segment index for the record.
+ * @param data The record data.
+ * @param length Length of the record data.
+ *
+ * @return Length of the record.
+ */
+static size_t tpm_nv_log_testing_build_record (uint8_t *buffer, uint8_t type, uint8_t index,
+	const void *data, size_t length)
+{
+	struct tpm_nv_log_record *record = (struct tpm_nv_log_record*) buffer;
+	uint8_t crc;
+
+	record->type = type;
+	record->index = index;
+	record->length = length;
+	memcpy (&buffer[sizeof (struct tpm_nv_log_record)], data, length);
+
+	crc = checksum_update_crc8 (0, buffer, offsetof (struct tpm_nv_log_record, crc));
+	record->crc = checksum_update_crc8 (crc, data, length);
+
+	return sizeof (struct tpm_nv_log_record) + length;
+}
+
+/**
+ * Build a log record for the TPM header.
+ *
+ * @param buffer Output for the record.
+ * @param counter The NV counter value.
+ * @param clear The TPM clear flag.
+ *
+ * @return Length of the record.
+ */
+static size_t tpm_nv_log_testing_build_header_record (uint8_t *buffer, uint64_t counter,
+	uint8_t clear)
+{
+	struct tpm_header header;
+
+	memset (&header, 0, sizeof (header));
+	header.magic = TPM_MAGIC;
+	header.nv_counter = counter;
+	header.clear = clear;
+
+	return tpm_nv_log_testing_build_record (buffer, TPM_NV_LOG_RECORD_HEADER, 0, &header,
+		sizeof (header));
+}
+
+/**
+ * Build a log record for a storage segment.  The segment is filled with a single value.
+ *
+ * @param buffer Output for the record.
+ * @param index The segment index.
+ * @param value The value for the segment data.
+ *
+ * @return Length of the record.
+ */
+static size_t tpm_nv_log_testing_build_segment_record (uint8_t *buffer, uint8_t index,
+	uint8_t value)
+{
+	uint8_t data[TPM_STORAGE_SEGMENT_SIZE];
+
+	memset (data, value, sizeof (data));
+
+	return tpm_nv_log_testing_build_record (buffer, TPM_NV_LOG_RECORD_SEGMENT, index, data,
+		sizeof (data));
+}
+
+/**
+ * Set up expectations for a flash read.
+ *
+ * @param flash The flash mock to update.
+ * @param addr The address that will be read.
+ * @param data The data to return from the read.
+ * @param length Length of the read.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int tpm_nv_log_testing_expect_read (struct flash_mock *flash, uint32_t addr,
+	const void *data, size_t length)
+{
+	int status;
+
+	status = mock_expect (&flash->mock, flash->base.read, flash, 0, MOCK_ARG (addr),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (length));
+	status |= mock_expect_output_tmp (&flash->mock, 1, data, length, 2);
+
+	return status;
+}
+
+/**
+ * Set up expectations for a flash write.
+ *
+ * @param flash The flash mock to update.
+ * @param addr The address that will be written.
+ * @param data The data that will be written.
+ * @param length Length of the write.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int tpm_nv_log_testing_expect_write (struct flash_mock *flash, uint32_t addr,
+	const void *data, size_t length)
+{
+	return mock_expect (&flash->mock, flash->base.write, flash, length, MOCK_ARG (addr),
+		MOCK_ARG_PTR_CONTAINS_TMP (data, length), MOCK_ARG (length));
+}
+
+/**
+ * Set up expectations for writing a bank header.
+ *
+ * @param flash The flash mock to update.
+ * @param addr The address of the bank.
+ * @param sequence The bank sequence number.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int tpm_nv_log_testing_expect_bank_header (struct flash_mock *flash, uint32_t addr,
+	uint32_t sequence)
+{
+	struct tpm_nv_log_bank_header bank;
+
+	bank.magic = TPM_NV_LOG_MAGIC;
+	bank.format_id = TPM_NV_LOG_FORMAT;
+	bank.sequence = sequence;
+
+	return tpm_nv_log_testing_expect_write (flash, addr, &bank, sizeof (bank));
+}
+
+/**
+ * Set up expectations for reading the flash details during initialization.
+ *
+ * @param flash The flash mock to update.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int tpm_nv_log_testing_expect_flash_info (struct flash_mock *flash)
+{
+	uint32_t flash_size = 0x40000;
+	uint32_t sector_size = 4096;
+	int status;
+
+	status = mock_expect (&flash->mock, flash->base.get_device_size, flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&flash->mock, 0, &flash_size, sizeof (flash_size), -1);
+
+	status |= mock_expect (&flash->mock, flash->base.get_sector_size, flash, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&flash->mock, 0, &sector_size, sizeof (sector_size), -1);
+
+	return status;
+}
+
+/**
+ * Set up expectations for reading the bank headers during initialization.
+ *
+ * @param flash The flash mock to update.
+ * @param seq0 Sequence number for bank 0 or 0 if the bank is not valid.
+ * @param seq1 Sequence number for bank 1 or 0 if the bank is not valid.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int tpm_nv_log_testing_expect_bank_headers (struct flash_mock *flash, uint32_t seq0,
+	uint32_t seq1)
+{
+	struct tpm_nv_log_bank_header bank[2];
+	int status;
+
+	memset (bank, 0xff, sizeof (bank));
+	if (seq0 != 0) {
+		bank[0].magic = TPM_NV_LOG_MAGIC;
+		bank[0].format_id = TPM_NV_LOG_FORMAT;
+		bank[0].sequence = seq0;
+	}
+	if (seq1 != 0) {
+		bank[1].magic = TPM_NV_LOG_MAGIC;
+		bank[1].format_id = TPM_NV_LOG_FORMAT;
+		bank[1].sequence = seq1;
+	}
+
+	status = tpm_nv_log_testing_expect_read (flash, 0x10000, &bank[0], sizeof (bank[0]));
+	status |= tpm_nv_log_testing_expect_read (flash, 0x12000, &bank[1], sizeof (bank[1]));
+
+	return status;
+}
+
+/**
+ * Set up expectations for scanning the records in a bank.
+ *
+ * @param flash The flash mock to update.
+ * @param addr Address of the first record.
+ * @param records The records stored in the bank.
+ * @param length Length of the records.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int tpm_nv_log_testing_expect_scan (struct flash_mock *flash, uint32_t addr,
+	const uint8_t *records, size_t length)
+{
+	const struct tpm_nv_log_record *record;
+	uint8_t erased[sizeof (struct tpm_nv_log_record)];
+	size_t offset = 0;
+	int status = 0;
+
+	while (offset < length) {
+		record = (const struct tpm_nv_log_record*) &records[offset];
+
+		status |= tpm_nv_log_testing_expect_read (flash, addr + offset, record, sizeof (*record));
+		offset += sizeof (*record);
+
+		status |= tpm_nv_log_testing_expect_read (flash, addr + offset, &records[offset],
+			record->length);
+		offset += record->length;
+	}
+
+	memset (erased, 0xff, sizeof (erased));
+	status |= tpm_nv_log_testing_expect_read (flash, addr + offset, erased, sizeof (erased));
+
+	return status;
+}
+
+/**
+ * Helper function to set up TPM storage for testing.  Bank 0 is active and contains only a header
+ * record.
+ *
+ * @param test The test framework.
+ * @param tpm The TPM storage instance to initialize.
+ * @param flash The flash device mock to initialize.
+ */
+static void setup_tpm_nv_log_mock_test (CuTest *test, struct tpm_nv_log *tpm,
+	struct flash_mock *flash)
+{
+	uint8_t records[TPM_NV_LOG_TESTING_HEADER_LEN];
+	size_t length;
+	int status;
+
+	length = tpm_nv_log_testing_build_header_record (records, 0, 0);
+
+	status = flash_mock_init (flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (flash);
+	status |= tpm_nv_log_testing_expect_bank_headers (flash, 1, 0);
+	status |= tpm_nv_log_testing_expect_scan (flash, 0x10008, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (tpm, &flash->base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash->mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper function to release mock instances.
+ *
+ * @param test The test framework.
+ * @param tpm The TPM storage to release.
+ * @param flash The flash device mock to release.
+ */
+static void complete_tpm_nv_log_mock_test (CuTest *test, struct tpm_nv_log *tpm,
+	struct flash_mock *flash)
+{
+	int status;
+
+	status = flash_mock_validate_and_release (flash);
+	CuAssertIntEquals (test, 0, status);
+
+	tpm_nv_log_release (tpm);
+}
+
+/*******************
+ * Test cases
+ *******************/
+
+static void tpm_nv_log_test_init (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	CuAssertPtrNotNull (test, tpm.observer.on_soft_reset);
+	CuAssertIntEquals (test, 0x2000, tpm.bank_size);
+	CuAssertIntEquals (test, 0, tpm.active);
+	CuAssertIntEquals (test, 1, tpm.sequence);
+	CuAssertIntEquals (test, 8 + TPM_NV_LOG_TESTING_HEADER_LEN, tpm.write_offset);
+	CuAssertIntEquals (test, false, tpm.inactive_erased);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_init_blank_flash (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t record[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	tpm_nv_log_testing_build_header_record (record, 0, 0);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	status |= tpm_nv_log_testing_expect_bank_headers (&flash, 0, 0);
+	status |= flash_mock_expect_erase_flash_sector (&flash, 0x10000, 0x2000);
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x10008, record, sizeof (record));
+	status |= tpm_nv_log_testing_expect_bank_header (&flash, 0x10000, 1);
+	status |= flash_mock_expect_erase_flash_sector (&flash, 0x12000, 0x2000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, tpm.active);
+	CuAssertIntEquals (test, 1, tpm.sequence);
+	CuAssertIntEquals (test, 8 + TPM_NV_LOG_TESTING_HEADER_LEN, tpm.write_offset);
+	CuAssertIntEquals (test, true, tpm.inactive_erased);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_init_newest_bank (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_HEADER_LEN + TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t expected[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	uint64_t counter;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	memset (expected, 0x55, sizeof (expected));
+
+	length = tpm_nv_log_testing_build_header_record (records, 5, 0);
+	length += tpm_nv_log_testing_build_segment_record (&records[length], 2, 0x55);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	status |= tpm_nv_log_testing_expect_bank_headers (&flash, 1, 2);
+	status |= tpm_nv_log_testing_expect_scan (&flash, 0x12008, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.active);
+	CuAssertIntEquals (test, 2, tpm.sequence);
+	CuAssertIntEquals (test, 8 + length, tpm.write_offset);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 5, counter);
+
+	status = tpm_nv_log_testing_expect_read (&flash,
+		0x12008 + TPM_NV_LOG_TESTING_HEADER_LEN + sizeof (struct tpm_nv_log_record), expected,
+		sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_get_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, storage, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_init_sequence_wrap (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_HEADER_LEN];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = tpm_nv_log_testing_build_header_record (records, 0, 0);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	status |= tpm_nv_log_testing_expect_bank_headers (&flash, 2, 0xffffffff);
+	status |= tpm_nv_log_testing_expect_scan (&flash, 0x10008, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, tpm.active);
+	CuAssertIntEquals (test, 2, tpm.sequence);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_init_corrupt_record (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_HEADER_LEN * 2];
+	uint64_t counter;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = tpm_nv_log_testing_build_header_record (records, 1, 0);
+	tpm_nv_log_testing_build_header_record (&records[length], 2, 0);
+	records[length + 6] ^= 0x55;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	status |= tpm_nv_log_testing_expect_bank_headers (&flash, 1, 0);
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x10008, records,
+		sizeof (struct tpm_nv_log_record));
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x1000d, &records[5],
+		sizeof (struct tpm_header));
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x10008 + length, &records[length],
+		sizeof (struct tpm_nv_log_record));
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x1000d + length, &records[length + 5],
+		sizeof (struct tpm_header));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No more records can be added to the bank. */
+	CuAssertIntEquals (test, 0x2000, tpm.write_offset);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_init_invalid_record (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_HEADER_LEN];
+	struct tpm_nv_log_record bad;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = tpm_nv_log_testing_build_header_record (records, 0, 0);
+
+	bad.type = TPM_NV_LOG_RECORD_SEGMENT;
+	bad.index = 4;
+	bad.length = TPM_STORAGE_SEGMENT_SIZE;
+	bad.crc = 0;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	status |= tpm_nv_log_testing_expect_bank_headers (&flash, 1, 0);
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x10008, records,
+		sizeof (struct tpm_nv_log_record));
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x1000d, &records[5],
+		sizeof (struct tpm_header));
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x10008 + length, &bad, sizeof (bad));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0x2000, tpm.write_offset);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_init_clear_scheduled (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_HEADER_LEN + TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t cleared[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t expected[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	uint64_t counter;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	memset (expected, 0xff, sizeof (expected));
+
+	length = tpm_nv_log_testing_build_segment_record (records, 1, 0x11);
+	length += tpm_nv_log_testing_build_header_record (&records[length], 3, 1);
+	tpm_nv_log_testing_build_header_record (cleared, 0, 0);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	status |= tpm_nv_log_testing_expect_bank_headers (&flash, 1, 0);
+	status |= tpm_nv_log_testing_expect_scan (&flash, 0x10008, records, length);
+	status |= flash_mock_expect_erase_flash_sector (&flash, 0x12000, 0x2000);
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x12008, cleared, sizeof (cleared));
+	status |= tpm_nv_log_testing_expect_bank_header (&flash, 0x12000, 2);
+	status |= flash_mock_expect_erase_flash_sector (&flash, 0x10000, 0x2000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.active);
+	CuAssertIntEquals (test, 2, tpm.sequence);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, counter);
+
+	status = tpm_nv_log_get_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, storage, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_init_invalid_arg (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (NULL, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_init (&tpm, NULL, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 0, 2);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 0);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void tpm_nv_log_test_init_unaligned_address (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10100, 0x4000, 4, 2);
+	CuAssertIntEquals (test, TPM_STORAGE_NOT_ALIGNED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void tpm_nv_log_test_init_insufficient_storage (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 16, 2);
+	CuAssertIntEquals (test, TPM_INSUFFICIENT_STORAGE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void tpm_nv_log_test_init_end_of_flash (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x3e000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, TPM_INSUFFICIENT_STORAGE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void tpm_nv_log_test_init_read_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_flash_info (&flash);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (struct tpm_nv_log_bank_header)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_init (&tpm, &flash.base, 0x10000, 0x4000, 4, 2);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void tpm_nv_log_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	tpm_nv_log_release (NULL);
+}
+
+static void tpm_nv_log_test_get_counter_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	status = tpm_nv_log_get_counter (NULL, &counter);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_get_counter (&tpm, NULL);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_increment_counter (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t record[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (record, 1, 0);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, record, sizeof (record));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_increment_counter (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 8 + (TPM_NV_LOG_TESTING_HEADER_LEN * 2), tpm.write_offset);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_increment_counter_with_staged_updates (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN + TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	uint64_t counter;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	memset (storage, 0x22, sizeof (storage));
+
+	length = tpm_nv_log_testing_build_segment_record (records, 3, 0x22);
+	length += tpm_nv_log_testing_build_header_record (&records[length], 1, 0);
+
+	status = tpm_nv_log_stage_storage (&tpm, 3, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_increment_counter (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0x1001a + sizeof (struct tpm_nv_log_record),
+		tpm.segment_addr[3]);
+	CuAssertIntEquals (test, 0, tpm.batch_len);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_increment_counter_write_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t record[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (record, 1, 0);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x1001a), MOCK_ARG_PTR_CONTAINS_TMP (record, sizeof (record)),
+		MOCK_ARG (sizeof (record)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_increment_counter (&tpm);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	/* The rest of the active bank can't be used after a failed write. */
+	CuAssertIntEquals (test, 0x2000, tpm.write_offset);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_increment_counter_incomplete_write (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t record[TPM_NV_LOG_TESTING_HEADER_LEN];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (record, 1, 0);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (record) - 1,
+		MOCK_ARG (0x1001a), MOCK_ARG_PTR_CONTAINS_TMP (record, sizeof (record)),
+		MOCK_ARG (sizeof (record)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_increment_counter (&tpm);
+	CuAssertIntEquals (test, TPM_INCOMPLETE_WRITE, status);
+
+	CuAssertIntEquals (test, 0x2000, tpm.write_offset);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_increment_counter_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = tpm_nv_log_increment_counter (NULL);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+}
+
+static void tpm_nv_log_test_set_storage (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	length = tpm_nv_log_testing_build_segment_record (records, 0, 0x33);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (storage, 0x33, sizeof (storage));
+	status = tpm_nv_log_set_storage (&tpm, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, tpm.batch_count);
+	CuAssertIntEquals (test, 0, tpm.batch_len);
+	CuAssertIntEquals (test, 0x1001a + sizeof (struct tpm_nv_log_record),
+		tpm.segment_addr[0]);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_set_storage_staged_segment (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	length = tpm_nv_log_testing_build_segment_record (records, 1, 0x55);
+
+	memset (storage, 0x44, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only the final contents of the staged segment are written. */
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (storage, 0x55, sizeof (storage));
+	status = tpm_nv_log_set_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, tpm.batch_count);
+	CuAssertIntEquals (test, 0x1001a + sizeof (struct tpm_nv_log_record),
+		tpm.segment_addr[1]);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_set_storage_write_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t out[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	length = tpm_nv_log_testing_build_segment_record (records, 2, 0x66);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x1001a), MOCK_ARG_PTR_CONTAINS_TMP (records, length), MOCK_ARG (length));
+	CuAssertIntEquals (test, 0, status);
+
+	memset (storage, 0x66, sizeof (storage));
+	status = tpm_nv_log_set_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	/* The update remains staged so it will be written by the next flush. */
+	CuAssertIntEquals (test, 1, tpm.batch_count);
+	CuAssertIntEquals (test, 0, tpm.segment_addr[2]);
+
+	status = tpm_nv_log_get_storage (&tpm, 2, out, sizeof (out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (storage, out, sizeof (out));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_staged (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t out[TPM_STORAGE_SEGMENT_SIZE];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	memset (storage, 0x33, sizeof (storage));
+
+	status = tpm_nv_log_stage_storage (&tpm, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.batch_count);
+	CuAssertIntEquals (test, TPM_NV_LOG_TESTING_SEGMENT_LEN, tpm.batch_len);
+
+	/* Staged data is returned without accessing flash. */
+	status = tpm_nv_log_get_storage (&tpm, 0, out, sizeof (out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (storage, out, sizeof (out));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_batch (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN * 2];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	length = tpm_nv_log_testing_build_segment_record (records, 1, 0x44);
+	length += tpm_nv_log_testing_build_segment_record (&records[length], 2, 0x55);
+
+	memset (storage, 0x44, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (storage, 0x55, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, tpm.batch_count);
+	CuAssertIntEquals (test, 0, tpm.batch_len);
+	CuAssertIntEquals (test, 8 + TPM_NV_LOG_TESTING_HEADER_LEN + length, tpm.write_offset);
+	CuAssertIntEquals (test, 0x1001a + sizeof (struct tpm_nv_log_record),
+		tpm.segment_addr[1]);
+	CuAssertIntEquals (test,
+		0x1001a + TPM_NV_LOG_TESTING_SEGMENT_LEN + sizeof (struct tpm_nv_log_record),
+		tpm.segment_addr[2]);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_read (&flash, tpm.segment_addr[2], storage,
+		sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_get_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_same_segment (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN * 2];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	length = tpm_nv_log_testing_build_segment_record (records, 0, 0x66);
+	length += tpm_nv_log_testing_build_segment_record (&records[length], 3, 0x77);
+
+	memset (storage, 0x11, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Updating a staged segment replaces the staged data. */
+	memset (storage, 0x66, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.batch_count);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (storage, 0x77, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 3, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_partial_segment (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t data[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t storage[16];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	memset (storage, 0x12, sizeof (storage));
+	memset (data, 0xff, sizeof (data));
+	memcpy (data, storage, sizeof (storage));
+
+	tpm_nv_log_testing_build_record (records, TPM_NV_LOG_RECORD_SEGMENT, 2, data, sizeof (data));
+
+	status = tpm_nv_log_stage_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, sizeof (records));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_flush (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_partial_segment_stored (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t current[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t data[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t storage[16];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm.segment_addr[2] = 0x10100;
+
+	memset (current, 0x34, sizeof (current));
+	memset (storage, 0x12, sizeof (storage));
+	memcpy (data, current, sizeof (data));
+	memcpy (data, storage, sizeof (storage));
+
+	tpm_nv_log_testing_build_record (records, TPM_NV_LOG_RECORD_SEGMENT, 2, data, sizeof (data));
+
+	status = tpm_nv_log_testing_expect_read (&flash, 0x10100, current, sizeof (current));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_stage_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, sizeof (records));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_flush (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_partial_segment_read_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t storage[16];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm.segment_addr[2] = 0x10100;
+	memset (storage, 0x12, sizeof (storage));
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10100), MOCK_ARG_NOT_NULL, MOCK_ARG (TPM_STORAGE_SEGMENT_SIZE));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_stage_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	CuAssertIntEquals (test, 0, tpm.batch_count);
+	CuAssertIntEquals (test, 0, tpm.batch_len);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_retry_failed_batch (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t header[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN * 2];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (header, 0, 0);
+	length = tpm_nv_log_testing_build_segment_record (records, 0, 0x01);
+	length += tpm_nv_log_testing_build_segment_record (&records[length], 1, 0x02);
+
+	memset (storage, 0x01, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x1001a), MOCK_ARG_PTR_CONTAINS_TMP (records, length), MOCK_ARG (length));
+	CuAssertIntEquals (test, 0, status);
+
+	memset (storage, 0x02, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	CuAssertIntEquals (test, 2, tpm.batch_count);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The failed batch is written to the other bank before staging the new update. */
+	status = flash_mock_expect_erase_flash_sector (&flash, 0x12000, 0x2000);
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x12008, header, sizeof (header));
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x1201a, records, length);
+	status |= tpm_nv_log_testing_expect_bank_header (&flash, 0x12000, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (storage, 0x03, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 2, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.active);
+	CuAssertIntEquals (test, 1, tpm.batch_count);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_set_storage_invalid_arg (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE + 1];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	status = tpm_nv_log_set_storage (NULL, 0, storage, TPM_STORAGE_SEGMENT_SIZE);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_set_storage (&tpm, 0, NULL, TPM_STORAGE_SEGMENT_SIZE);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_set_storage (&tpm, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, TPM_INVALID_LEN, status);
+
+	status = tpm_nv_log_set_storage (&tpm, 4, storage, TPM_STORAGE_SEGMENT_SIZE);
+	CuAssertIntEquals (test, TPM_OUT_OF_RANGE, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_stage_storage_invalid_arg (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE + 1];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	status = tpm_nv_log_stage_storage (NULL, 0, storage, TPM_STORAGE_SEGMENT_SIZE);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_stage_storage (&tpm, 0, NULL, TPM_STORAGE_SEGMENT_SIZE);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_stage_storage (&tpm, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, TPM_INVALID_LEN, status);
+
+	status = tpm_nv_log_stage_storage (&tpm, 4, storage, TPM_STORAGE_SEGMENT_SIZE);
+	CuAssertIntEquals (test, TPM_OUT_OF_RANGE, status);
+
+	CuAssertIntEquals (test, 0, tpm.batch_count);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_get_storage_not_written (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t expected[TPM_STORAGE_SEGMENT_SIZE];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	memset (expected, 0xff, sizeof (expected));
+	memset (storage, 0, sizeof (storage));
+
+	status = tpm_nv_log_get_storage (&tpm, 3, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, storage, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_get_storage_read_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm.segment_addr[1] = 0x10200;
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10200), MOCK_ARG_NOT_NULL, MOCK_ARG (TPM_STORAGE_SEGMENT_SIZE));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_get_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_get_storage_invalid_arg (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	status = tpm_nv_log_get_storage (NULL, 0, storage, sizeof (storage));
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_get_storage (&tpm, 0, NULL, sizeof (storage));
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+
+	status = tpm_nv_log_get_storage (&tpm, 0, storage, sizeof (storage) - 1);
+	CuAssertIntEquals (test, TPM_INVALID_LEN, status);
+
+	status = tpm_nv_log_get_storage (&tpm, 4, storage, sizeof (storage));
+	CuAssertIntEquals (test, TPM_OUT_OF_RANGE, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_flush_no_updates (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	status = tpm_nv_log_flush (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_flush_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = tpm_nv_log_flush (NULL);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+}
+
+static void tpm_nv_log_test_compact (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t header[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t segment[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t update[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (header, 0, 0);
+	tpm_nv_log_testing_build_segment_record (segment, 1, 0x99);
+	tpm_nv_log_testing_build_header_record (update, 1, 0);
+
+	/* Segment 1 is stored in the active bank, which has no more space. */
+	tpm.segment_addr[1] = 0x10100 + sizeof (struct tpm_nv_log_record);
+	tpm.write_offset = 0x2000 - 10;
+
+	status = flash_mock_expect_erase_flash_sector (&flash, 0x12000, 0x2000);
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x12008, header, sizeof (header));
+	status |= tpm_nv_log_testing_expect_read (&flash, 0x10100, segment, sizeof (segment));
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x1201a, segment, sizeof (segment));
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x1201a + sizeof (segment), update,
+		sizeof (update));
+	status |= tpm_nv_log_testing_expect_bank_header (&flash, 0x12000, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_increment_counter (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.active);
+	CuAssertIntEquals (test, 2, tpm.sequence);
+	CuAssertIntEquals (test, false, tpm.inactive_erased);
+	CuAssertIntEquals (test, 0x1a + sizeof (segment) + sizeof (update), tpm.write_offset);
+	CuAssertIntEquals (test, 0x1201a + sizeof (struct tpm_nv_log_record), tpm.segment_addr[1]);
+	CuAssertIntEquals (test, 0, tpm.segment_addr[0]);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_compact_staged_segment (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t header[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t segment[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (header, 0, 0);
+	tpm_nv_log_testing_build_segment_record (segment, 1, 0x88);
+
+	tpm.segment_addr[1] = 0x10100 + sizeof (struct tpm_nv_log_record);
+	tpm.write_offset = 0x2000 - 10;
+	tpm.inactive_erased = true;
+
+	memset (storage, 0x88, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The old copy of the segment is not copied since there is a staged update. */
+	status = tpm_nv_log_testing_expect_write (&flash, 0x12008, header, sizeof (header));
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x1201a, segment, sizeof (segment));
+	status |= tpm_nv_log_testing_expect_bank_header (&flash, 0x12000, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_flush (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.active);
+	CuAssertIntEquals (test, 0x1201a + sizeof (struct tpm_nv_log_record), tpm.segment_addr[1]);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_compact_erase_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint32_t sector_size = 4096;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm.write_offset = 0x2000 - 10;
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&flash.mock, 0, &sector_size, sizeof (sector_size), -1);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x12000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_increment_counter (&tpm);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	CuAssertIntEquals (test, 0, tpm.active);
+	CuAssertIntEquals (test, 1, tpm.sequence);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_compact_bank_header_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	struct tpm_nv_log_bank_header bank;
+	uint8_t header[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t update[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (header, 0, 0);
+	tpm_nv_log_testing_build_header_record (update, 1, 0);
+
+	bank.magic = TPM_NV_LOG_MAGIC;
+	bank.format_id = TPM_NV_LOG_FORMAT;
+	bank.sequence = 2;
+
+	tpm.write_offset = 0x2000 - 10;
+	tpm.inactive_erased = true;
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x12008, header, sizeof (header));
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x1201a, update, sizeof (update));
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x12000), MOCK_ARG_PTR_CONTAINS_TMP (&bank, sizeof (bank)),
+		MOCK_ARG (sizeof (bank)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_increment_counter (&tpm);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	CuAssertIntEquals (test, 0, tpm.active);
+	CuAssertIntEquals (test, 1, tpm.sequence);
+	CuAssertIntEquals (test, false, tpm.inactive_erased);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_maintain (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t header[TPM_NV_LOG_TESTING_HEADER_LEN];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (header, 0, 0);
+
+	/* Erase the inactive bank. */
+	status = flash_mock_expect_erase_flash_sector (&flash, 0x12000, 0x2000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_maintain (&tpm);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, tpm.inactive_erased);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Nothing to do. */
+	status = tpm_nv_log_maintain (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Compact storage since there is not enough space for a batch of updates. */
+	tpm.write_offset = 0x2000 - (TPM_NV_LOG_TESTING_SEGMENT_LEN * 2);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x12008, header, sizeof (header));
+	status |= tpm_nv_log_testing_expect_bank_header (&flash, 0x12000, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_maintain (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, tpm.active);
+	CuAssertIntEquals (test, 8 + sizeof (header), tpm.write_offset);
+	CuAssertIntEquals (test, false, tpm.inactive_erased);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_maintain_erase_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint32_t sector_size = 4096;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&flash.mock, 0, &sector_size, sizeof (sector_size), -1);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x12000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_maintain (&tpm);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+	CuAssertIntEquals (test, false, tpm.inactive_erased);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_maintain_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = tpm_nv_log_maintain (NULL);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+}
+
+static void tpm_nv_log_test_schedule_clear (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t record[TPM_NV_LOG_TESTING_HEADER_LEN];
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (record, 0, 1);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, record, sizeof (record));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_schedule_clear (&tpm);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, tpm.header.clear);
+
+	/* Already scheduled. */
+	status = tpm_nv_log_schedule_clear (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_schedule_clear_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = tpm_nv_log_schedule_clear (NULL);
+	CuAssertIntEquals (test, TPM_INVALID_ARGUMENT, status);
+}
+
+static void tpm_nv_log_test_on_soft_reset (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t record[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t cleared[TPM_NV_LOG_TESTING_HEADER_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	uint64_t counter;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm_nv_log_testing_build_header_record (record, 0, 1);
+	tpm_nv_log_testing_build_header_record (cleared, 0, 0);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, record, sizeof (record));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_schedule_clear (&tpm);
+	CuAssertIntEquals (test, 0, status);
+
+	tpm.header.nv_counter = 10;
+	tpm.segment_addr[0] = 0x10200;
+
+	/* Staged updates are discarded. */
+	memset (storage, 0x10, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 1, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_expect_erase_flash_sector (&flash, 0x12000, 0x2000);
+	status |= tpm_nv_log_testing_expect_write (&flash, 0x12008, cleared, sizeof (cleared));
+	status |= tpm_nv_log_testing_expect_bank_header (&flash, 0x12000, 2);
+	status |= flash_mock_expect_erase_flash_sector (&flash, 0x10000, 0x2000);
+	CuAssertIntEquals (test, 0, status);
+
+	tpm.observer.on_soft_reset (&tpm.observer);
+
+	CuAssertIntEquals (test, 1, tpm.active);
+	CuAssertIntEquals (test, 0, tpm.header.clear);
+	CuAssertIntEquals (test, 0, tpm.segment_addr[0]);
+	CuAssertIntEquals (test, 0, tpm.batch_len);
+	CuAssertIntEquals (test, true, tpm.inactive_erased);
+
+	status = tpm_nv_log_get_counter (&tpm, &counter);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, counter);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_on_soft_reset_not_scheduled (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm.observer.on_soft_reset (&tpm.observer);
+
+	CuAssertIntEquals (test, 0, tpm.active);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_on_soft_reset_flush (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	length = tpm_nv_log_testing_build_segment_record (records, 3, 0x21);
+
+	memset (storage, 0x21, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 3, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = tpm_nv_log_testing_expect_write (&flash, 0x1001a, records, length);
+	CuAssertIntEquals (test, 0, status);
+
+	tpm.observer.on_soft_reset (&tpm.observer);
+
+	CuAssertIntEquals (test, 0, tpm.active);
+	CuAssertIntEquals (test, 0, tpm.batch_len);
+	CuAssertIntEquals (test, 0x1001a + sizeof (struct tpm_nv_log_record),
+		tpm.segment_addr[3]);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_on_soft_reset_flush_write_fail (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+	uint8_t records[TPM_NV_LOG_TESTING_SEGMENT_LEN];
+	uint8_t storage[TPM_STORAGE_SEGMENT_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	length = tpm_nv_log_testing_build_segment_record (records, 3, 0x21);
+
+	memset (storage, 0x21, sizeof (storage));
+	status = tpm_nv_log_stage_storage (&tpm, 3, storage, sizeof (storage));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x1001a), MOCK_ARG_PTR_CONTAINS_TMP (records, length), MOCK_ARG (length));
+	CuAssertIntEquals (test, 0, status);
+
+	tpm.observer.on_soft_reset (&tpm.observer);
+
+	CuAssertIntEquals (test, 1, tpm.batch_count);
+	CuAssertIntEquals (test, 0, tpm.segment_addr[3]);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+static void tpm_nv_log_test_on_soft_reset_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct tpm_nv_log tpm;
+
+	TEST_START;
+
+	setup_tpm_nv_log_mock_test (test, &tpm, &flash);
+
+	tpm.observer.on_soft_reset (NULL);
+
+	complete_tpm_nv_log_mock_test (test, &tpm, &flash);
+}
+
+
+CuSuite* get_tpm_nv_log_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_blank_flash);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_newest_bank);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_sequence_wrap);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_corrupt_record);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_invalid_record);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_clear_scheduled);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_invalid_arg);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_unaligned_address);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_insufficient_storage);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_end_of_flash);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_init_read_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_release_null);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_get_counter_null);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_increment_counter);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_increment_counter_with_staged_updates);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_increment_counter_write_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_increment_counter_incomplete_write);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_increment_counter_null);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_set_storage);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_set_storage_staged_segment);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_set_storage_write_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_staged);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_batch);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_same_segment);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_partial_segment);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_partial_segment_stored);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_partial_segment_read_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_retry_failed_batch);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_set_storage_invalid_arg);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_stage_storage_invalid_arg);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_get_storage_not_written);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_get_storage_read_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_get_storage_invalid_arg);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_flush_no_updates);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_flush_null);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_compact);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_compact_staged_segment);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_compact_erase_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_compact_bank_header_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_maintain);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_maintain_erase_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_maintain_null);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_schedule_clear);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_schedule_clear_null);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_on_soft_reset);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_on_soft_reset_not_scheduled);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_on_soft_reset_flush);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_on_soft_reset_flush_write_fail);
+	SUITE_ADD_TEST (suite, tpm_nv_log_test_on_soft_reset_null);
+
+	return suite;
+}
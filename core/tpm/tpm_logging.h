@@ -12,6 +12,7 @@
  */
 enum {
 	TPM_LOGGING_CLEAR_FAILED,				/**< TPM clear failed. */
+	TPM_LOGGING_FLUSH_FAILED,				/**< Staged TPM storage updates were not written. */
 };
 
 
@@ -0,0 +1,1060 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "crypto/checksum.h"
+#include "flash/flash_util.h"
+#include "logging/debug_log.h"
+#include "tpm_logging.h"
+#include "tpm_nv_log.h"
+
+
+/**
+ * Length of a log record containing a storage segment.
+ */
+#define	TPM_NV_LOG_SEGMENT_RECORD_LEN	\
+	(sizeof (struct tpm_nv_log_record) + TPM_STORAGE_SEGMENT_SIZE)
+
+/**
+ * Length of a log record containing the TPM header.
+ */
+#define	TPM_NV_LOG_HEADER_RECORD_LEN	\
+	(sizeof (struct tpm_nv_log_record) + sizeof (struct tpm_header))
+
+/**
+ * Get the flash address for a storage bank.
+ *
+ * @param tpm The TPM storage instance.
+ * @param bank Index of the bank.
+ */
+#define	TPM_NV_LOG_BANK_ADDR(tpm, bank)	((tpm)->base_addr + ((bank) * (tpm)->bank_size))
+
+
+/**
+ * Calculate the CRC for a log record.
+ *
+ * @param record The header for the record.  The CRC field is not included in the calculation.
+ * @param data The record data.
+ *
+ * @return The CRC for the record.
+ */
+static uint8_t tpm_nv_log_record_crc (const struct tpm_nv_log_record *record, const uint8_t *data)
+{
+	uint8_t crc;
+
+	crc = checksum_update_crc8 (0, (uint8_t*) record, offsetof (struct tpm_nv_log_record, crc));
+	return checksum_update_crc8 (crc, data, record->length);
+}
+
+/**
+ * Check if a record header describes a valid record.
+ *
+ * @param tpm The TPM storage instance.
+ * @param record The record header to check.
+ *
+ * @return true if the record header is valid.
+ */
+static bool tpm_nv_log_is_valid_record (struct tpm_nv_log *tpm,
+	const struct tpm_nv_log_record *record)
+{
+	switch (record->type) {
+		case TPM_NV_LOG_RECORD_HEADER:
+			return (record->index == 0) && (record->length == sizeof (struct tpm_header));
+
+		case TPM_NV_LOG_RECORD_SEGMENT:
+			return (record->index < tpm->num_segments) &&
+				(record->length == TPM_STORAGE_SEGMENT_SIZE);
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Write data to TPM storage.  The flash must already be erased.
+ *
+ * @param tpm The TPM storage instance.
+ * @param addr The flash address to write to.
+ * @param data The data to write.
+ * @param length Length of the data.
+ *
+ * @return 0 if all the data was written or an error code.
+ */
+static int tpm_nv_log_write (struct tpm_nv_log *tpm, uint32_t addr, const uint8_t *data,
+	size_t length)
+{
+	int status;
+
+	status = tpm->flash->write (tpm->flash, addr, data, length);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	else if ((size_t) status != length) {
+		return TPM_INCOMPLETE_WRITE;
+	}
+
+	return 0;
+}
+
+/**
+ * Write a TPM header record to flash.
+ *
+ * @param tpm The TPM storage instance.
+ * @param addr The flash address to write the record to.
+ * @param header The TPM header to write.
+ *
+ * @return 0 if the record was written or an error code.
+ */
+static int tpm_nv_log_write_header_record (struct tpm_nv_log *tpm, uint32_t addr,
+	const struct tpm_header *header)
+{
+	struct tpm_nv_log_record *record = (struct tpm_nv_log_record*) tpm->scratch;
+	uint8_t *data = &tpm->scratch[sizeof (struct tpm_nv_log_record)];
+
+	record->type = TPM_NV_LOG_RECORD_HEADER;
+	record->index = 0;
+	record->length = sizeof (struct tpm_header);
+	memcpy (data, header, sizeof (struct tpm_header));
+	record->crc = tpm_nv_log_record_crc (record, data);
+
+	return tpm_nv_log_write (tpm, addr, tpm->scratch, TPM_NV_LOG_HEADER_RECORD_LEN);
+}
+
+/**
+ * Write the header for a storage bank.  This completes the bank, making it the newest copy of TPM
+ * storage.
+ *
+ * @param tpm The TPM storage instance.
+ * @param bank Index of the bank to complete.
+ * @param sequence The sequence number for the bank.
+ *
+ * @return 0 if the bank header was written or an error code.
+ */
+static int tpm_nv_log_write_bank_header (struct tpm_nv_log *tpm, uint8_t bank, uint32_t sequence)
+{
+	struct tpm_nv_log_bank_header header;
+
+	header.magic = TPM_NV_LOG_MAGIC;
+	header.format_id = TPM_NV_LOG_FORMAT;
+	header.sequence = sequence;
+
+	return tpm_nv_log_write (tpm, TPM_NV_LOG_BANK_ADDR (tpm, bank), (uint8_t*) &header,
+		sizeof (header));
+}
+
+/**
+ * Make sure the inactive storage bank is erased and ready to receive data.
+ *
+ * @param tpm The TPM storage instance.
+ *
+ * @return 0 if the bank is erased or an error code.
+ */
+static int tpm_nv_log_erase_inactive_bank (struct tpm_nv_log *tpm)
+{
+	int status;
+
+	if (tpm->inactive_erased) {
+		return 0;
+	}
+
+	status = flash_sector_erase_region (tpm->flash, TPM_NV_LOG_BANK_ADDR (tpm, tpm->active ^ 1),
+		tpm->bank_size);
+	if (status == 0) {
+		tpm->inactive_erased = true;
+	}
+
+	return status;
+}
+
+/**
+ * Find a staged record.
+ *
+ * @param tpm The TPM storage instance.
+ * @param type The type of record to find.
+ * @param index The segment index of the record.
+ *
+ * @return The staged record or null if there is no staged record that matches.
+ */
+static struct tpm_nv_log_record* tpm_nv_log_find_staged (struct tpm_nv_log *tpm, uint8_t type,
+	uint8_t index)
+{
+	struct tpm_nv_log_record *record;
+	size_t offset = 0;
+
+	while (offset < tpm->batch_len) {
+		record = (struct tpm_nv_log_record*) &tpm->batch[offset];
+		if ((record->type == type) && (record->index == index)) {
+			return record;
+		}
+
+		offset += sizeof (struct tpm_nv_log_record) + record->length;
+	}
+
+	return NULL;
+}
+
+/**
+ * Add a new record to the staged records.  There must be space available for the record.
+ *
+ * @param tpm The TPM storage instance.
+ * @param type The type of record to add.
+ * @param index The segment index of the record.
+ * @param length Length of the record data.
+ *
+ * @return The new record.  The record data is not initialized.
+ */
+static struct tpm_nv_log_record* tpm_nv_log_stage_record (struct tpm_nv_log *tpm, uint8_t type,
+	uint8_t index, uint16_t length)
+{
+	struct tpm_nv_log_record *record = (struct tpm_nv_log_record*) &tpm->batch[tpm->batch_len];
+
+	record->type = type;
+	record->index = index;
+	record->length = length;
+
+	tpm->batch_len += sizeof (struct tpm_nv_log_record) + length;
+	if (type == TPM_NV_LOG_RECORD_SEGMENT) {
+		tpm->batch_count++;
+	}
+
+	return record;
+}
+
+/**
+ * Calculate the CRC for every staged record.
+ *
+ * @param tpm The TPM storage instance.
+ */
+static void tpm_nv_log_seal_batch (struct tpm_nv_log *tpm)
+{
+	struct tpm_nv_log_record *record;
+	size_t offset = 0;
+
+	while (offset < tpm->batch_len) {
+		record = (struct tpm_nv_log_record*) &tpm->batch[offset];
+		offset += sizeof (struct tpm_nv_log_record);
+
+		record->crc = tpm_nv_log_record_crc (record, &tpm->batch[offset]);
+		offset += record->length;
+	}
+}
+
+/**
+ * Update the storage state for staged records that have been written to flash.  The staged
+ * records are discarded.
+ *
+ * @param tpm The TPM storage instance.
+ * @param segment_addr The segment index to update.
+ * @param addr The flash address where the staged records were written.
+ */
+static void tpm_nv_log_commit_batch (struct tpm_nv_log *tpm, uint32_t *segment_addr,
+	uint32_t addr)
+{
+	struct tpm_nv_log_record *record;
+	size_t offset = 0;
+
+	while (offset < tpm->batch_len) {
+		record = (struct tpm_nv_log_record*) &tpm->batch[offset];
+		offset += sizeof (struct tpm_nv_log_record);
+
+		if (record->type == TPM_NV_LOG_RECORD_HEADER) {
+			memcpy (&tpm->header, &tpm->batch[offset], sizeof (struct tpm_header));
+		}
+		else {
+			segment_addr[record->index] = addr + offset;
+		}
+
+		offset += record->length;
+	}
+
+	tpm->batch_len = 0;
+	tpm->batch_count = 0;
+}
+
+/**
+ * Copy the latest version of all records to the inactive bank and make it the active bank.  Any
+ * staged records are written to the new bank.
+ *
+ * @param tpm The TPM storage instance.
+ *
+ * @return 0 if the storage was compacted or an error code.
+ */
+static int tpm_nv_log_compact (struct tpm_nv_log *tpm)
+{
+	uint32_t *new_addr = &tpm->segment_addr[tpm->num_segments];
+	uint8_t target = tpm->active ^ 1;
+	uint32_t bank_addr = TPM_NV_LOG_BANK_ADDR (tpm, target);
+	uint32_t offset = sizeof (struct tpm_nv_log_bank_header);
+	uint32_t batch_addr = 0;
+	int i;
+	int status;
+
+	status = tpm_nv_log_erase_inactive_bank (tpm);
+	if (status != 0) {
+		return status;
+	}
+
+	tpm->inactive_erased = false;
+	memset (new_addr, 0, sizeof (uint32_t) * tpm->num_segments);
+
+	status = tpm_nv_log_write_header_record (tpm, bank_addr + offset, &tpm->header);
+	if (status != 0) {
+		return status;
+	}
+
+	offset += TPM_NV_LOG_HEADER_RECORD_LEN;
+
+	for (i = 0; i < tpm->num_segments; i++) {
+		if ((tpm->segment_addr[i] == 0) ||
+			tpm_nv_log_find_staged (tpm, TPM_NV_LOG_RECORD_SEGMENT, i)) {
+			continue;
+		}
+
+		status = tpm->flash->read (tpm->flash,
+			tpm->segment_addr[i] - sizeof (struct tpm_nv_log_record), tpm->scratch,
+			TPM_NV_LOG_SEGMENT_RECORD_LEN);
+		if (status != 0) {
+			return status;
+		}
+
+		status = tpm_nv_log_write (tpm, bank_addr + offset, tpm->scratch,
+			TPM_NV_LOG_SEGMENT_RECORD_LEN);
+		if (status != 0) {
+			return status;
+		}
+
+		new_addr[i] = bank_addr + offset + sizeof (struct tpm_nv_log_record);
+		offset += TPM_NV_LOG_SEGMENT_RECORD_LEN;
+	}
+
+	if (tpm->batch_len != 0) {
+		tpm_nv_log_seal_batch (tpm);
+
+		batch_addr = bank_addr + offset;
+		status = tpm_nv_log_write (tpm, batch_addr, tpm->batch, tpm->batch_len);
+		if (status != 0) {
+			return status;
+		}
+
+		offset += tpm->batch_len;
+	}
+
+	status = tpm_nv_log_write_bank_header (tpm, target, tpm->sequence + 1);
+	if (status != 0) {
+		return status;
+	}
+
+	tpm->active = target;
+	tpm->sequence++;
+	tpm->write_offset = offset;
+	memcpy (tpm->segment_addr, new_addr, sizeof (uint32_t) * tpm->num_segments);
+
+	if (tpm->batch_len != 0) {
+		tpm_nv_log_commit_batch (tpm, tpm->segment_addr, batch_addr);
+	}
+
+	return 0;
+}
+
+/**
+ * Write all staged records to flash.  If there is not enough space in the active bank, the storage
+ * will be compacted.
+ *
+ * @param tpm The TPM storage instance.
+ *
+ * @return 0 if the staged records were written or an error code.  On error, the records remain
+ * staged.
+ */
+static int tpm_nv_log_flush_batch (struct tpm_nv_log *tpm)
+{
+	uint32_t addr;
+	int status;
+
+	if (tpm->batch_len == 0) {
+		return 0;
+	}
+
+	if ((tpm->write_offset + tpm->batch_len) > tpm->bank_size) {
+		return tpm_nv_log_compact (tpm);
+	}
+
+	tpm_nv_log_seal_batch (tpm);
+
+	addr = TPM_NV_LOG_BANK_ADDR (tpm, tpm->active) + tpm->write_offset;
+	status = tpm_nv_log_write (tpm, addr, tpm->batch, tpm->batch_len);
+	if (status != 0) {
+		/* Part of the batch may have been written, so the rest of the bank can't be used.  The next
+		 * write will move the storage to the other bank. */
+		tpm->write_offset = tpm->bank_size;
+		return status;
+	}
+
+	tpm->write_offset += tpm->batch_len;
+	tpm_nv_log_commit_batch (tpm, tpm->segment_addr, addr);
+
+	return 0;
+}
+
+/**
+ * Stage a new version of the TPM header and write it to flash.
+ *
+ * @param tpm The TPM storage instance.
+ * @param header The new TPM header.
+ *
+ * @return 0 if the header was written or an error code.
+ */
+static int tpm_nv_log_update_header (struct tpm_nv_log *tpm, const struct tpm_header *header)
+{
+	struct tpm_nv_log_record *record;
+
+	record = tpm_nv_log_find_staged (tpm, TPM_NV_LOG_RECORD_HEADER, 0);
+	if (record == NULL) {
+		record = tpm_nv_log_stage_record (tpm, TPM_NV_LOG_RECORD_HEADER, 0,
+			sizeof (struct tpm_header));
+	}
+
+	memcpy (&record[1], header, sizeof (struct tpm_header));
+
+	return tpm_nv_log_flush_batch (tpm);
+}
+
+/**
+ * Read the current contents of a storage segment.
+ *
+ * @param tpm The TPM storage instance.
+ * @param index The segment to read.
+ * @param storage Output for the segment data.  This must be at least TPM_STORAGE_SEGMENT_SIZE.
+ *
+ * @return 0 if the segment was read or an error code.
+ */
+static int tpm_nv_log_read_segment (struct tpm_nv_log *tpm, uint8_t index, uint8_t *storage)
+{
+	struct tpm_nv_log_record *record;
+
+	record = tpm_nv_log_find_staged (tpm, TPM_NV_LOG_RECORD_SEGMENT, index);
+	if (record != NULL) {
+		memcpy (storage, &record[1], TPM_STORAGE_SEGMENT_SIZE);
+		return 0;
+	}
+
+	if (tpm->segment_addr[index] == 0) {
+		memset (storage, 0xff, TPM_STORAGE_SEGMENT_SIZE);
+		return 0;
+	}
+
+	return tpm->flash->read (tpm->flash, tpm->segment_addr[index], storage,
+		TPM_STORAGE_SEGMENT_SIZE);
+}
+
+/**
+ * Clear TPM storage by starting a new, empty storage bank.  The old bank is erased.
+ *
+ * @param tpm The TPM storage instance.
+ *
+ * @return 0 if the storage was cleared or an error code.
+ */
+static int tpm_nv_log_perform_clear (struct tpm_nv_log *tpm)
+{
+	struct tpm_header header;
+	uint8_t target = tpm->active ^ 1;
+	uint32_t offset = sizeof (struct tpm_nv_log_bank_header);
+	int status;
+
+	tpm->batch_len = 0;
+	tpm->batch_count = 0;
+
+	status = tpm_nv_log_erase_inactive_bank (tpm);
+	if (status != 0) {
+		return status;
+	}
+
+	tpm->inactive_erased = false;
+
+	memset (&header, 0, sizeof (header));
+	header.magic = TPM_MAGIC;
+
+	status = tpm_nv_log_write_header_record (tpm, TPM_NV_LOG_BANK_ADDR (tpm, target) + offset,
+		&header);
+	if (status != 0) {
+		return status;
+	}
+
+	status = tpm_nv_log_write_bank_header (tpm, target, tpm->sequence + 1);
+	if (status != 0) {
+		return status;
+	}
+
+	tpm->active = target;
+	tpm->sequence++;
+	tpm->write_offset = offset + TPM_NV_LOG_HEADER_RECORD_LEN;
+	memcpy (&tpm->header, &header, sizeof (header));
+	memset (tpm->segment_addr, 0, sizeof (uint32_t) * tpm->num_segments);
+
+	return tpm_nv_log_erase_inactive_bank (tpm);
+}
+
+/**
+ * Load the storage state from the active bank.
+ *
+ * @param tpm The TPM storage instance.
+ *
+ * @return 0 if the storage state was loaded or an error code.
+ */
+static int tpm_nv_log_scan (struct tpm_nv_log *tpm)
+{
+	struct tpm_nv_log_record record;
+	uint32_t bank_addr = TPM_NV_LOG_BANK_ADDR (tpm, tpm->active);
+	uint32_t offset = sizeof (struct tpm_nv_log_bank_header);
+	int status;
+
+	memset (&tpm->header, 0, sizeof (tpm->header));
+	tpm->write_offset = tpm->bank_size;
+
+	while ((offset + sizeof (record)) <= tpm->bank_size) {
+		status = tpm->flash->read (tpm->flash, bank_addr + offset, (uint8_t*) &record,
+			sizeof (record));
+		if (status != 0) {
+			return status;
+		}
+
+		if (record.type == TPM_NV_LOG_RECORD_ERASED) {
+			tpm->write_offset = offset;
+			break;
+		}
+
+		/* A bad record means a write was interrupted.  The rest of the bank will not be used. */
+		if (!tpm_nv_log_is_valid_record (tpm, &record) ||
+			((offset + sizeof (record) + record.length) > tpm->bank_size)) {
+			break;
+		}
+
+		offset += sizeof (record);
+		status = tpm->flash->read (tpm->flash, bank_addr + offset, tpm->scratch, record.length);
+		if (status != 0) {
+			return status;
+		}
+
+		if (tpm_nv_log_record_crc (&record, tpm->scratch) != record.crc) {
+			break;
+		}
+
+		if (record.type == TPM_NV_LOG_RECORD_HEADER) {
+			memcpy (&tpm->header, tpm->scratch, sizeof (tpm->header));
+		}
+		else {
+			tpm->segment_addr[record.index] = bank_addr + offset;
+		}
+
+		offset += record.length;
+	}
+
+	if (tpm->header.magic != TPM_MAGIC) {
+		memset (&tpm->header, 0, sizeof (tpm->header));
+		tpm->header.magic = TPM_MAGIC;
+	}
+
+	return 0;
+}
+
+/**
+ * Find the active storage bank and load the storage state.  If there is no valid bank, storage
+ * will be initialized.
+ *
+ * @param tpm The TPM storage instance.
+ *
+ * @return 0 if the storage was loaded or an error code.
+ */
+static int tpm_nv_log_mount (struct tpm_nv_log *tpm)
+{
+	struct tpm_nv_log_bank_header bank[2];
+	bool valid[2];
+	int i;
+	int status;
+
+	for (i = 0; i < 2; i++) {
+		status = tpm->flash->read (tpm->flash, TPM_NV_LOG_BANK_ADDR (tpm, i), (uint8_t*) &bank[i],
+			sizeof (bank[i]));
+		if (status != 0) {
+			return status;
+		}
+
+		valid[i] = (bank[i].magic == TPM_NV_LOG_MAGIC) && (bank[i].format_id == TPM_NV_LOG_FORMAT);
+	}
+
+	if (valid[0] && valid[1]) {
+		tpm->active = ((int32_t) (bank[1].sequence - bank[0].sequence) > 0) ? 1 : 0;
+	}
+	else if (valid[0] || valid[1]) {
+		tpm->active = (valid[0]) ? 0 : 1;
+	}
+	else {
+		tpm->active = 1;
+		tpm->sequence = 0;
+
+		return tpm_nv_log_perform_clear (tpm);
+	}
+
+	tpm->sequence = bank[tpm->active].sequence;
+
+	return tpm_nv_log_scan (tpm);
+}
+
+/**
+ * Clear TPM storage if a clear has been scheduled.  Otherwise, write any staged storage updates to
+ * flash.
+ *
+ * @param observer The observer instance being notified.
+ */
+static void tpm_nv_log_on_soft_reset (struct host_processor_observer *observer)
+{
+	struct tpm_nv_log *tpm = (struct tpm_nv_log*) observer;
+	int status;
+
+	if (tpm == NULL) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_TPM,
+			TPM_LOGGING_CLEAR_FAILED, TPM_INVALID_ARGUMENT, 0);
+		return;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+
+	if (tpm->header.clear != 0) {
+		status = tpm_nv_log_perform_clear (tpm);
+		if (status != 0) {
+			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_TPM,
+				TPM_LOGGING_CLEAR_FAILED, status, 0);
+		}
+	}
+	else {
+		status = tpm_nv_log_flush_batch (tpm);
+		if (status != 0) {
+			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_TPM,
+				TPM_LOGGING_FLUSH_FAILED, status, 0);
+		}
+	}
+
+	platform_mutex_unlock (&tpm->lock);
+}
+
+/**
+ * Schedule TPM storage clear on next SoC reset.
+ *
+ * @param tpm The TPM to utilize.
+ *
+ * @return 0 if scheduled successfully or an error code.
+ */
+int tpm_nv_log_schedule_clear (struct tpm_nv_log *tpm)
+{
+	struct tpm_header header;
+	int status = 0;
+
+	if (tpm == NULL) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+
+	if (tpm->header.clear == 0) {
+		memcpy (&header, &tpm->header, sizeof (header));
+		header.clear = 1;
+
+		status = tpm_nv_log_update_header (tpm, &header);
+	}
+
+	platform_mutex_unlock (&tpm->lock);
+	return status;
+}
+
+/**
+ * Increment NV counter value and update TPM storage.  Any staged segment updates are written to
+ * flash with the new counter value.
+ *
+ * @param tpm The TPM to utilize.
+ *
+ * @return 0 if increment completed successfully or an error code.
+ */
+int tpm_nv_log_increment_counter (struct tpm_nv_log *tpm)
+{
+	struct tpm_header header;
+	int status;
+
+	if (tpm == NULL) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+
+	memcpy (&header, &tpm->header, sizeof (header));
+	++header.nv_counter;
+
+	status = tpm_nv_log_update_header (tpm, &header);
+
+	platform_mutex_unlock (&tpm->lock);
+	return status;
+}
+
+/**
+ * Get NV counter value from TPM storage.
+ *
+ * @param tpm The TPM to utilize.
+ * @param counter The buffer to fill with NV counter value.
+ *
+ * @return 0 if counter is retrieved successfully or an error code.
+ */
+int tpm_nv_log_get_counter (struct tpm_nv_log *tpm, uint64_t *counter)
+{
+	if ((tpm == NULL) || (counter == NULL)) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+	*counter = tpm->header.nv_counter;
+	platform_mutex_unlock (&tpm->lock);
+
+	return 0;
+}
+
+/**
+ * Stage an update to a storage block.  The TPM lock must be held by the caller.
+ *
+ * @param tpm The TPM to utilize.
+ * @param index Storage block index
+ * @param storage The buffer with storage block contents.
+ * @param storage_len Size of storage buffer.
+ *
+ * @return 0 if the update was staged successfully or an error code.
+ */
+static int tpm_nv_log_stage_segment (struct tpm_nv_log *tpm, uint8_t index,
+	const uint8_t *storage, size_t storage_len)
+{
+	struct tpm_nv_log_record *record;
+	int status;
+
+	record = tpm_nv_log_find_staged (tpm, TPM_NV_LOG_RECORD_SEGMENT, index);
+	if (record == NULL) {
+		if (tpm->batch_count == tpm->max_batch) {
+			/* A previous write failed.  Try again to make space for the update. */
+			status = tpm_nv_log_flush_batch (tpm);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		if (storage_len < TPM_STORAGE_SEGMENT_SIZE) {
+			status = tpm_nv_log_read_segment (tpm, index, tpm->scratch);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		record = tpm_nv_log_stage_record (tpm, TPM_NV_LOG_RECORD_SEGMENT, index,
+			TPM_STORAGE_SEGMENT_SIZE);
+
+		if (storage_len < TPM_STORAGE_SEGMENT_SIZE) {
+			memcpy (&record[1], tpm->scratch, TPM_STORAGE_SEGMENT_SIZE);
+		}
+	}
+
+	memcpy (&record[1], storage, storage_len);
+
+	return 0;
+}
+
+/**
+ * Check the arguments for a storage block update.
+ *
+ * @param tpm The TPM to utilize.
+ * @param index Storage block index
+ * @param storage The buffer with storage block contents.
+ * @param storage_len Size of storage buffer.
+ *
+ * @return 0 if the arguments are valid or an error code.
+ */
+static int tpm_nv_log_check_storage_args (struct tpm_nv_log *tpm, uint8_t index,
+	const uint8_t *storage, size_t storage_len)
+{
+	if ((tpm == NULL) || (storage == NULL)) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	if (storage_len > TPM_STORAGE_SEGMENT_SIZE) {
+		return TPM_INVALID_LEN;
+	}
+
+	if (index >= tpm->num_segments) {
+		return TPM_OUT_OF_RANGE;
+	}
+
+	return 0;
+}
+
+/**
+ * Write storage block to TPM storage.  The update, along with any other staged updates, is written
+ * to flash before returning.
+ *
+ * @param tpm The TPM to utilize.
+ * @param index Storage block index
+ * @param storage The buffer with storage block contents.
+ * @param storage_len Size of storage buffer.
+ *
+ * @return 0 if storage block is updated successfully or an error code.
+ */
+int tpm_nv_log_set_storage (struct tpm_nv_log *tpm, uint8_t index, uint8_t *storage,
+	size_t storage_len)
+{
+	int status;
+
+	status = tpm_nv_log_check_storage_args (tpm, index, storage, storage_len);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+
+	status = tpm_nv_log_stage_segment (tpm, index, storage, storage_len);
+	if (status == 0) {
+		status = tpm_nv_log_flush_batch (tpm);
+	}
+
+	platform_mutex_unlock (&tpm->lock);
+	return status;
+}
+
+/**
+ * Stage an update to a storage block without waiting for it to be written to flash.  Staged
+ * updates are written when the maximum number of updates have been staged, when the NV counter or
+ * TPM header changes, on a call to tpm_nv_log_set_storage, on host soft reset, or when storage is
+ * flushed.  Multiple updates to the same block before the updates are written to flash will only
+ * write the final block contents.
+ *
+ * A staged update will be lost if power is lost before it is written, so tpm_nv_log_flush must be
+ * called before reporting the update as complete.
+ *
+ * @param tpm The TPM to utilize.
+ * @param index Storage block index
+ * @param storage The buffer with storage block contents.
+ * @param storage_len Size of storage buffer.
+ *
+ * @return 0 if storage block update was staged successfully or an error code.
+ */
+int tpm_nv_log_stage_storage (struct tpm_nv_log *tpm, uint8_t index, uint8_t *storage,
+	size_t storage_len)
+{
+	int status;
+
+	status = tpm_nv_log_check_storage_args (tpm, index, storage, storage_len);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+
+	status = tpm_nv_log_stage_segment (tpm, index, storage, storage_len);
+	if ((status == 0) && (tpm->batch_count == tpm->max_batch)) {
+		status = tpm_nv_log_flush_batch (tpm);
+	}
+
+	platform_mutex_unlock (&tpm->lock);
+	return status;
+}
+
+/**
+ * Get storage block from TPM storage.  This includes any staged updates that have not yet been
+ * written to flash.
+ *
+ * @param tpm The TPM to utilize.
+ * @param index Storage block index
+ * @param storage The buffer to fill with storage block contents, buffer needs to be at least
+ * 	TPM_STORAGE_SEGMENT_SIZE.
+ * @param storage_len Size of storage buffer.
+ *
+ * @return 0 if storage block is retrieved successfully or an error code.
+ */
+int tpm_nv_log_get_storage (struct tpm_nv_log *tpm, uint8_t index, uint8_t *storage,
+	size_t storage_len)
+{
+	int status;
+
+	if ((tpm == NULL) || (storage == NULL)) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	if (storage_len < TPM_STORAGE_SEGMENT_SIZE) {
+		return TPM_INVALID_LEN;
+	}
+
+	if (index >= tpm->num_segments) {
+		return TPM_OUT_OF_RANGE;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+	status = tpm_nv_log_read_segment (tpm, index, storage);
+	platform_mutex_unlock (&tpm->lock);
+
+	return status;
+}
+
+/**
+ * Write all staged storage updates to flash.
+ *
+ * @param tpm The TPM to utilize.
+ *
+ * @return 0 if all updates have been written or an error code.
+ */
+int tpm_nv_log_flush (struct tpm_nv_log *tpm)
+{
+	int status;
+
+	if (tpm == NULL) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+	status = tpm_nv_log_flush_batch (tpm);
+	platform_mutex_unlock (&tpm->lock);
+
+	return status;
+}
+
+/**
+ * Run background maintenance on TPM storage so that flash erase operations do not delay storage
+ * updates.  Each call will do at most one of the following:
+ * 	- Erase the inactive bank so it is ready for the next compaction.
+ * 	- Compact storage if there is not enough space for a full batch of updates.
+ *
+ * This should be called periodically from a task that can block for flash erase operations.
+ *
+ * @param tpm The TPM to utilize.
+ *
+ * @return 0 if maintenance completed successfully or an error code.
+ */
+int tpm_nv_log_maintain (struct tpm_nv_log *tpm)
+{
+	uint32_t reserve;
+	int status = 0;
+
+	if (tpm == NULL) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&tpm->lock);
+
+	reserve = (tpm->max_batch * TPM_NV_LOG_SEGMENT_RECORD_LEN) + TPM_NV_LOG_HEADER_RECORD_LEN;
+
+	if (!tpm->inactive_erased) {
+		status = tpm_nv_log_erase_inactive_bank (tpm);
+	}
+	else if ((tpm->bank_size - tpm->write_offset) < reserve) {
+		status = tpm_nv_log_compact (tpm);
+	}
+
+	platform_mutex_unlock (&tpm->lock);
+	return status;
+}
+
+/**
+ * Initialize log-structured TPM storage.
+ *
+ * @param tpm The TPM to initialize.
+ * @param flash The flash device used for TPM storage.
+ * @param base_addr The flash starting address.  This must be aligned to the start of a sector.
+ * @param length Total amount of flash to use for TPM storage.  Half of this will be used for each
+ * storage bank.
+ * @param num_segments Number of storage segments to utilize.
+ * @param max_batch Maximum number of segment updates to stage before writing them to flash.
+ *
+ * @return 0 if the TPM was successfully initialized or an error code.
+ */
+int tpm_nv_log_init (struct tpm_nv_log *tpm, struct flash *flash, uint32_t base_addr,
+	uint32_t length, uint8_t num_segments, uint8_t max_batch)
+{
+	uint32_t flash_size;
+	uint32_t sector_size;
+	uint32_t min_bank;
+	int status;
+
+	if ((tpm == NULL) || (flash == NULL) || (num_segments == 0) || (max_batch == 0)) {
+		return TPM_INVALID_ARGUMENT;
+	}
+
+	status = flash->get_device_size (flash, &flash_size);
+	if (status != 0) {
+		return status;
+	}
+
+	status = flash->get_sector_size (flash, &sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	if (FLASH_REGION_OFFSET (base_addr, sector_size) != 0) {
+		return TPM_STORAGE_NOT_ALIGNED;
+	}
+
+	memset (tpm, 0, sizeof (struct tpm_nv_log));
+
+	tpm->flash = flash;
+	tpm->base_addr = base_addr;
+	tpm->num_segments = num_segments;
+	tpm->max_batch = max_batch;
+	tpm->bank_size = (length / 2) - FLASH_REGION_OFFSET (length / 2, sector_size);
+
+	/* A bank must be able to hold every segment and the header, plus one more header for a staged
+	 * update. */
+	min_bank = sizeof (struct tpm_nv_log_bank_header) + (TPM_NV_LOG_HEADER_RECORD_LEN * 2) +
+		(TPM_NV_LOG_SEGMENT_RECORD_LEN * num_segments);
+	if ((tpm->bank_size < min_bank) || ((base_addr + (tpm->bank_size * 2)) > flash_size)) {
+		return TPM_INSUFFICIENT_STORAGE;
+	}
+
+	tpm->segment_addr = platform_calloc (num_segments * 2, sizeof (uint32_t));
+	tpm->batch = platform_malloc ((TPM_NV_LOG_SEGMENT_RECORD_LEN * max_batch) +
+		TPM_NV_LOG_HEADER_RECORD_LEN);
+	tpm->scratch = platform_malloc (TPM_NV_LOG_SEGMENT_RECORD_LEN);
+	if ((tpm->segment_addr == NULL) || (tpm->batch == NULL) || (tpm->scratch == NULL)) {
+		status = TPM_NO_MEMORY;
+		goto error;
+	}
+
+	status = tpm_nv_log_mount (tpm);
+	if ((status == 0) && (tpm->header.clear != 0)) {
+		status = tpm_nv_log_perform_clear (tpm);
+	}
+	if (status != 0) {
+		goto error;
+	}
+
+	status = platform_mutex_init (&tpm->lock);
+	if (status != 0) {
+		goto error;
+	}
+
+	tpm->observer.on_soft_reset = tpm_nv_log_on_soft_reset;
+
+	return 0;
+
+error:
+	platform_free (tpm->segment_addr);
+	platform_free (tpm->batch);
+	platform_free (tpm->scratch);
+	return status;
+}
+
+/**
+ * Release the resources used by TPM storage.  Staged updates that have not been written to flash
+ * are discarded.
+ *
+ * @param tpm The TPM to release.
+ */
+void tpm_nv_log_release (struct tpm_nv_log *tpm)
+{
+	if (tpm != NULL) {
+		platform_mutex_free (&tpm->lock);
+		platform_free (tpm->segment_addr);
+		platform_free (tpm->batch);
+		platform_free (tpm->scratch);
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef TPM_NV_LOG_H_
+#define TPM_NV_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "platform.h"
+#include "status/rot_status.h"
+#include "flash/flash.h"
+#include "host_fw/host_processor_observer.h"
+#include "tpm.h"
+
+
+#define	TPM_NV_LOG_MAGIC							0x4E4C
+#define	TPM_NV_LOG_FORMAT							0
+
+
+/**
+ * Types of records that can be stored in the TPM NV log.
+ */
+enum tpm_nv_log_record_type {
+	TPM_NV_LOG_RECORD_HEADER = 0x01,				/**< A new version of the TPM header. */
+	TPM_NV_LOG_RECORD_SEGMENT = 0x02,				/**< A new version of a storage segment. */
+	TPM_NV_LOG_RECORD_ERASED = 0xff,				/**< Unused space at the end of the log. */
+};
+
+#pragma pack(push, 1)
+/**
+ * Header stored at the beginning of each bank of TPM NV storage.  The header is written only after
+ * all the data in the bank has been stored, so a bank with a valid header is always complete.
+ */
+struct tpm_nv_log_bank_header {
+	uint16_t magic;									/**< Value indicating the bank is valid. */
+	uint16_t format_id;								/**< Bank format ID. */
+	uint32_t sequence;								/**< Bank sequence number.  Higher is newer. */
+};
+
+/**
+ * Header for a single record in the TPM NV log.  The record data immediately follows the header.
+ */
+struct tpm_nv_log_record {
+	uint8_t type;									/**< The type of record. */
+	uint8_t index;									/**< Storage segment index for the record. */
+	uint16_t length;								/**< Length of the record data. */
+	uint8_t crc;									/**< CRC8 of the record header and data. */
+};
+#pragma pack(pop)
+
+/**
+ * TPM NV storage that appends new versions of the TPM header and storage segments to a log in
+ * pre-erased flash instead of rewriting sectors in place.  Storage is split into two banks.  When
+ * the active bank is full, the latest version of each record is copied to the other bank, which
+ * then becomes active.  Segment updates written with tpm_nv_log_set_storage are on flash before the
+ * call returns.  Updates can instead be staged in RAM with tpm_nv_log_stage_storage so multiple
+ * updates are written to flash with a single program operation.
+ */
+struct tpm_nv_log {
+	struct host_processor_observer observer;		/**< The base observer interface. */
+	struct flash *flash;							/**< The flash used for TPM storage. */
+	uint32_t base_addr;								/**< The base address of TPM storage on flash. */
+	uint32_t bank_size;								/**< Size of each storage bank. */
+	uint32_t sequence;								/**< Sequence number of the active bank. */
+	uint32_t write_offset;							/**< Offset of the next record in the active bank. */
+	uint8_t num_segments;							/**< Number of storage segments used by TPM. */
+	uint8_t max_batch;								/**< Maximum segment updates to write at once. */
+	uint8_t active;									/**< Index of the active storage bank. */
+	bool inactive_erased;							/**< Flag indicating the inactive bank is erased. */
+	struct tpm_header header;						/**< The current TPM header. */
+	uint32_t *segment_addr;							/**< Flash address of the data for each segment. */
+	uint8_t *batch;									/**< Records waiting to be written to flash. */
+	size_t batch_len;								/**< Length of the staged records. */
+	uint8_t batch_count;							/**< Number of staged segment updates. */
+	uint8_t *scratch;								/**< Buffer for a single record. */
+	platform_mutex lock;							/**< Synchronization for TPM storage. */
+};
+
+
+int tpm_nv_log_init (struct tpm_nv_log *tpm, struct flash *flash, uint32_t base_addr,
+	uint32_t length, uint8_t num_segments, uint8_t max_batch);
+void tpm_nv_log_release (struct tpm_nv_log *tpm);
+
+int tpm_nv_log_increment_counter (struct tpm_nv_log *tpm);
+int tpm_nv_log_get_counter (struct tpm_nv_log *tpm, uint64_t *counter);
+
+int tpm_nv_log_set_storage (struct tpm_nv_log *tpm, uint8_t index, uint8_t *storage,
+	size_t storage_len);
+int tpm_nv_log_stage_storage (struct tpm_nv_log *tpm, uint8_t index, uint8_t *storage,
+	size_t storage_len);
+int tpm_nv_log_get_storage (struct tpm_nv_log *tpm, uint8_t index, uint8_t *storage,
+	size_t storage_len);
+int tpm_nv_log_flush (struct tpm_nv_log *tpm);
+
+int tpm_nv_log_schedule_clear (struct tpm_nv_log *tpm);
+
+int tpm_nv_log_maintain (struct tpm_nv_log *tpm);
+
+
+#endif /* TPM_NV_LOG_H_ */
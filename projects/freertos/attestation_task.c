@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "cmd_interface/cmd_logging.h"
+#include "logging/debug_log.h"
+#include "attestation_task.h"
+
+
+/**
+ * Send the request to start attestation of a device.
+ *
+ * @param task The attestation task sending the request.
+ * @param request The request that should be sent.
+ *
+ * @return 0 if the request was sent successfully or an error code.
+ */
+static int attestation_task_send_request (struct attestation_task *task,
+	struct attestation_scheduler_request *request)
+{
+	struct cmd_channel *channel;
+	int status;
+
+	if (request->bus >= task->num_channels) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	channel = task->channel[request->bus];
+
+	status = mctp_interface_issue_request (task->mctp, request->smbus_addr, request->eid,
+		device_manager_get_device_addr (task->mctp->device_manager, 0),
+		device_manager_get_device_eid (task->mctp->device_manager, 0), request->command, NULL,
+		task->packet.data, sizeof (task->packet.data), MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	task->packet.pkt_size = status;
+	task->packet.dest_addr = request->smbus_addr;
+	task->packet.state = CMD_VALID_PACKET;
+	task->packet.timeout_valid = false;
+
+	status = channel->send_packet (channel, &task->packet);
+	if (status != 0) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
+			CMD_LOGGING_SEND_PACKET_FAIL, channel->id, status);
+	}
+
+	return status;
+}
+
+/**
+ * Run a single attestation sweep of all downstream devices.  Requests are sent to every device the
+ * scheduler allows to start, and the task waits for the sweep to complete before returning.
+ *
+ * @param task The attestation task running the sweep.
+ */
+static void attestation_task_run_sweep (struct attestation_task *task)
+{
+	struct attestation_scheduler_request request;
+	struct attestation_scheduler_results results;
+	int status;
+
+	status = attestation_scheduler_start_sweep (task->scheduler);
+	if (status <= 0) {
+		return;
+	}
+
+	do {
+		status = attestation_scheduler_get_next_request (task->scheduler, &request);
+		if (status == 0) {
+			status = attestation_task_send_request (task, &request);
+			if (status != 0) {
+				attestation_scheduler_update (task->scheduler, request.device_num, status,
+					ATTESTATION_SCHEDULER_NO_COMMAND);
+			}
+		}
+		else {
+			vTaskDelay (pdMS_TO_TICKS (ATTESTATION_TASK_POLL_MS));
+		}
+
+		attestation_scheduler_get_results (task->scheduler, &results);
+	} while (!results.complete);
+}
+
+/**
+ * Attestation task loop.  A sweep is run when the task starts and every time one is requested.
+ *
+ * @param data Pointer to attestation task instance
+ *
+ */
+static void attestation_task_loop (void *data)
+{
+	struct attestation_task *task = (struct attestation_task*) data;
+	TickType_t period = (ATTESTATION_TASK_SWEEP_PERIOD_MS == 0) ?
+		portMAX_DELAY : pdMS_TO_TICKS (ATTESTATION_TASK_SWEEP_PERIOD_MS);
+
+	while (1) {
+		attestation_task_run_sweep (task);
+		ulTaskNotifyTake (pdTRUE, period);
+	}
+}
+
+/**
+ * Initialize and start the task to attest downstream devices.  The first attestation sweep will
+ * be started immediately.
+ *
+ * The command interface processing the device responses must be configured with the same
+ * scheduler so attestation exchanges can be tracked.
+ *
+ * @param task The attestation task to initialize.
+ * @param scheduler The scheduler for the devices to attest.
+ * @param mctp The MCTP protocol handler to use for generating requests.
+ * @param channel The list of command channels for sending requests, indexed by the bus ID assigned
+ * to each device in the scheduler.
+ * @param num_channels The number of command channels in the list.
+ *
+ * @return Initialization status, 0 if success or an error code.
+ */
+int attestation_task_init (struct attestation_task *task, struct attestation_scheduler *scheduler,
+	struct mctp_interface *mctp, struct cmd_channel **channel, uint8_t num_channels)
+{
+	int status;
+
+	if ((task == NULL) || (scheduler == NULL) || (mctp == NULL) || (channel == NULL) ||
+		(num_channels == 0)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	memset (task, 0, sizeof (struct attestation_task));
+
+	task->scheduler = scheduler;
+	task->mctp = mctp;
+	task->channel = channel;
+	task->num_channels = num_channels;
+
+	status = xTaskCreate (attestation_task_loop, "ATTEST", 6 * 256, task, CERBERUS_PRIORITY_NORMAL,
+		&task->task);
+	if (status != pdPASS) {
+		task->task = NULL;
+		return ATTESTATION_SCHEDULER_NO_MEMORY;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop and release the attestation task.
+ *
+ * @param task The attestation task to release.
+ */
+void attestation_task_deinit (struct attestation_task *task)
+{
+	if ((task != NULL) && (task->task != NULL)) {
+		vTaskDelete (task->task);
+	}
+}
+
+/**
+ * Request an attestation sweep of all downstream devices.  If a sweep is already running, another
+ * sweep will be started after the current one completes.
+ *
+ * @param task The attestation task to run the sweep.
+ *
+ * @return 0 if the sweep was requested successfully or an error code.
+ */
+int attestation_task_start_sweep (struct attestation_task *task)
+{
+	if ((task == NULL) || (task->task == NULL)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	xTaskNotifyGive (task->task);
+	return 0;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef ATTESTATION_TASK_H_
+#define ATTESTATION_TASK_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "attestation/attestation_scheduler.h"
+#include "cmd_interface/cmd_channel.h"
+#include "mctp/mctp_interface.h"
+
+
+/**
+ * The interval, in milliseconds, for checking if another device can be sent a request while a
+ * sweep is in progress.
+ */
+#ifndef ATTESTATION_TASK_POLL_MS
+#define	ATTESTATION_TASK_POLL_MS			10
+#endif
+
+/**
+ * The interval, in milliseconds, between automatic attestation sweeps.  Set this to 0 to only run
+ * sweeps at startup and when requested.
+ */
+#ifndef ATTESTATION_TASK_SWEEP_PERIOD_MS
+#define	ATTESTATION_TASK_SWEEP_PERIOD_MS	0
+#endif
+
+
+/**
+ * Task context for attesting downstream devices.  Requests to start attestation are sent by this
+ * task, while the responses are received and processed by the MCTP command task for each channel.
+ */
+struct attestation_task {
+	struct attestation_scheduler *scheduler;	/**< Scheduler for the devices to attest. */
+	struct mctp_interface *mctp;				/**< MCTP protocol layer for generating requests. */
+	struct cmd_channel **channel;				/**< Command channel for each bus, indexed by bus ID. */
+	uint8_t num_channels;						/**< Number of command channels. */
+	TaskHandle_t task;							/**< Task handle for running attestation sweeps. */
+	struct cmd_packet packet;					/**< Buffer for the request being sent. */
+};
+
+
+int attestation_task_init (struct attestation_task *task, struct attestation_scheduler *scheduler,
+	struct mctp_interface *mctp, struct cmd_channel **channel, uint8_t num_channels);
+void attestation_task_deinit (struct attestation_task *task);
+
+int attestation_task_start_sweep (struct attestation_task *task);
+
+
+#endif /* ATTESTATION_TASK_H_ */
@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "platform.h"
+#include "flash_async_read_freertos.h"
+
+
+/**
+ * Task function for executing background flash reads.  Each notification represents a single read
+ * request, and completion is signaled back to the requesting task.
+ *
+ * @param async The background read instance being serviced.
+ */
+static void flash_async_read_freertos_task (struct flash_async_read_freertos *async)
+{
+	while (1) {
+		ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+
+		xSemaphoreTake (async->lock, portMAX_DELAY);
+		async->status = async->flash->read (async->flash, async->address, async->data,
+			async->length);
+		xSemaphoreGive (async->lock);
+
+		xSemaphoreGive (async->done);
+	}
+}
+
+static int flash_async_read_freertos_start_read (struct flash_async_read *async, uint32_t address,
+	uint8_t *data, size_t length)
+{
+	struct flash_async_read_freertos *freertos = (struct flash_async_read_freertos*) async;
+
+	if ((freertos == NULL) || (data == NULL)) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	if (freertos->pending) {
+		return FLASH_READ_IN_PROGRESS;
+	}
+
+	freertos->address = address;
+	freertos->data = data;
+	freertos->length = length;
+	freertos->pending = true;
+
+	xTaskNotifyGive (freertos->task);
+
+	return 0;
+}
+
+static int flash_async_read_freertos_wait_for_read (struct flash_async_read *async)
+{
+	struct flash_async_read_freertos *freertos = (struct flash_async_read_freertos*) async;
+
+	if (freertos == NULL) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	if (!freertos->pending) {
+		return FLASH_NO_READ_PENDING;
+	}
+
+	xSemaphoreTake (freertos->done, portMAX_DELAY);
+	freertos->pending = false;
+
+	return freertos->status;
+}
+
+/**
+ * Initialize and start a background task for executing flash reads.
+ *
+ * @param async The background read instance to initialize.
+ * @param flash The flash device that will be read.
+ *
+ * @return 0 if the task was initialized successfully or an error code.
+ */
+int flash_async_read_freertos_init (struct flash_async_read_freertos *async, struct flash *flash)
+{
+	int status;
+
+	if ((async == NULL) || (flash == NULL)) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	memset (async, 0, sizeof (struct flash_async_read_freertos));
+
+	async->base.start_read = flash_async_read_freertos_start_read;
+	async->base.wait_for_read = flash_async_read_freertos_wait_for_read;
+	async->flash = flash;
+
+	async->done = xSemaphoreCreateBinary ();
+	if (async->done == NULL) {
+		return FLASH_NO_MEMORY;
+	}
+
+	async->lock = xSemaphoreCreateMutex ();
+	if (async->lock == NULL) {
+		vSemaphoreDelete (async->done);
+		return FLASH_NO_MEMORY;
+	}
+
+	status = xTaskCreate ((TaskFunction_t) flash_async_read_freertos_task, "FlashRd", 1 * 256,
+		async, CERBERUS_PRIORITY_NORMAL, &async->task);
+	if (status != pdPASS) {
+		vSemaphoreDelete (async->lock);
+		vSemaphoreDelete (async->done);
+		return FLASH_NO_MEMORY;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop and release the background flash read task.  Any outstanding read request will be allowed
+ * to complete before the task is deleted.
+ *
+ * @param async The background read instance to release.
+ */
+void flash_async_read_freertos_release (struct flash_async_read_freertos *async)
+{
+	if (async) {
+		xSemaphoreTake (async->lock, portMAX_DELAY);
+		vTaskDelete (async->task);
+		vSemaphoreDelete (async->lock);
+		vSemaphoreDelete (async->done);
+	}
+}
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_ASYNC_READ_FREERTOS_H_
+#define FLASH_ASYNC_READ_FREERTOS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "flash/flash.h"
+#include "flash/flash_async_read.h"
+
+
+/**
+ * Background flash reads executed by a FreeRTOS task.  This allows flash transfers to run while the
+ * calling task processes previously read data for flash devices that do not provide native
+ * background reads.
+ */
+struct flash_async_read_freertos {
+	struct flash_async_read base;		/**< The base background read instance. */
+	struct flash *flash;				/**< The flash device to read from. */
+	TaskHandle_t task;					/**< The background read task. */
+	SemaphoreHandle_t done;				/**< Signal for completion of the read request. */
+	SemaphoreHandle_t lock;				/**< Synchronization to protect task deletion. */
+	uint32_t address;					/**< The address for the current read request. */
+	uint8_t *data;						/**< The output buffer for the current read request. */
+	size_t length;						/**< The length of the current read request. */
+	int status;							/**< The result of the last read request. */
+	bool pending;						/**< Flag indicating a read request is outstanding. */
+};
+
+
+int flash_async_read_freertos_init (struct flash_async_read_freertos *async, struct flash *flash);
+void flash_async_read_freertos_release (struct flash_async_read_freertos *async);
+
+
+#endif /* FLASH_ASYNC_READ_FREERTOS_H_ */
@@ -6,33 +6,53 @@
 #include <string.h>
 #include "platform.h"
 #include "logging_flush.h"
+#include "common/unused.h"
 
 
 /**
- * Task function for flushing the log.
+ * Task function for flushing the log.  Full entry buffers are written to flash by this task,
+ * so tasks adding log entries never wait for flash operations to complete.  The task runs as soon
+ * as a full buffer is waiting to be written and periodically to write any partial buffer.
  *
  * @param flush The management instance for flushing the log.
  */
 static void logging_flush_task (struct logging_flush *flush)
 {
 	while (1) {
-		platform_msleep (1000);
+		ulTaskNotifyTake (pdTRUE, pdMS_TO_TICKS (1000));
 
 		xSemaphoreTake (flush->lock, portMAX_DELAY);
-		flush->logger->flush (flush->logger);
+		flush->logger->base.flush (&flush->logger->base);
 		xSemaphoreGive (flush->lock);
 	}
 }
 
 /**
- * Initialize and start a background task to flush log contents to flash.
+ * Wake the flush task when a full buffer is waiting to be written to flash.
+ *
+ * @param observer The flush task being notified.
+ * @param logging The log that needs to be flushed.
+ */
+static void logging_flush_on_flush_needed (struct logging_flash_observer *observer,
+	struct logging_flash *logging)
+{
+	struct logging_flush *flush = (struct logging_flush*) observer;
+
+	UNUSED (logging);
+
+	xTaskNotifyGive (flush->task);
+}
+
+/**
+ * Initialize and start a background task to flush log contents to flash.  The log will be
+ * configured to drop new entries rather than wait for flash when its buffers are full.
  *
  * @param log_task The log flushing task to initialize.
  * @param logger The log instance to flush.
  *
  * @return 0 if the task was initialized successfully or an error code.
  */
-int logging_flush_init (struct logging_flush *log_task, struct logging *logger)
+int logging_flush_init (struct logging_flush *log_task, struct logging_flash *logger)
 {
 	int status;
 
@@ -42,8 +62,14 @@ int logging_flush_init (struct logging_flush *log_task, struct logging *logger)
 
 	memset (log_task, 0, sizeof (struct logging_flush));
 
+	log_task->base.on_flush_needed = logging_flush_on_flush_needed;
 	log_task->logger = logger;
 
+	status = logger->base.set_overflow_policy (&logger->base, LOGGING_OVERFLOW_DROP);
+	if (status != 0) {
+		return status;
+	}
+
 	log_task->lock = xSemaphoreCreateMutex ();
 	if (log_task->lock == NULL) {
 		return LOGGING_NO_MEMORY;
@@ -56,6 +82,13 @@ int logging_flush_init (struct logging_flush *log_task, struct logging *logger)
 		return LOGGING_NO_MEMORY;
 	}
 
+	status = logging_flash_add_observer (logger, &log_task->base);
+	if (status != 0) {
+		vTaskDelete (log_task->task);
+		vSemaphoreDelete (log_task->lock);
+		return status;
+	}
+
 	return 0;
 }
 
@@ -67,6 +100,8 @@ int logging_flush_init (struct logging_flush *log_task, struct logging *logger)
 void logging_flush_release (struct logging_flush *log_task)
 {
 	if (log_task) {
+		logging_flash_remove_observer (log_task->logger, &log_task->base);
+
 		xSemaphoreTake (log_task->lock, portMAX_DELAY);
 		vTaskDelete (log_task->task);
 		vSemaphoreDelete (log_task->lock);
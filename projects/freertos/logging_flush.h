@@ -7,20 +7,21 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
-#include "logging/logging.h"
+#include "logging/logging_flash.h"
 
 
 /**
  * Background task for flushing log contents to flash.
  */
 struct logging_flush {
-	struct logging *logger;				/**< The log instance to flush. */
+	struct logging_flash_observer base;	/**< Observer for log buffers waiting to be flushed. */
+	struct logging_flash *logger;		/**< The log instance to flush. */
 	TaskHandle_t task;					/**< The log background task. */
 	SemaphoreHandle_t lock;				/**< Synchronization to protect task deletion. */
 };
 
 
-int logging_flush_init (struct logging_flush *log_task, struct logging *logger);
+int logging_flush_init (struct logging_flush *log_task, struct logging_flash *logger);
 void logging_flush_release (struct logging_flush *log_task);
 
 
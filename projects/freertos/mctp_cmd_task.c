@@ -16,23 +16,65 @@
 static void mctp_cmd_task_loop (void *data)
 {
 	struct mctp_cmd_task *task = (struct mctp_cmd_task*) data;
+	bool deferred;
+	bool running = false;
 
 	while (1) {
-		cmd_channel_receive_and_process (task->channel, task->mctp, -1);
+		/* While a deferred request is outstanding, stop waiting for packets periodically to check
+		 * if the response is ready. */
+		deferred = (task->async != NULL) && task->mctp->deferred.pending;
+
+		cmd_channel_receive_and_process_in_place (task->channel, task->mctp,
+			deferred ? MCTP_CMD_TASK_DEFERRED_POLL_MS : -1);
+
+		if ((task->async != NULL) && task->mctp->deferred.pending) {
+			if (!running) {
+				running = true;
+				xTaskNotifyGive (task->worker_task);
+			}
+			else if (!cmd_async_is_pending (task->async)) {
+				cmd_channel_send_deferred_response_in_place (task->channel, task->mctp);
+				running = task->mctp->deferred.pending;
+			}
+		}
+	}
+}
+
+/**
+ * Worker loop to execute requests that were deferred by the command interface.
+ *
+ * @param data Pointer to MCTP command task instance
+ *
+ */
+static void mctp_cmd_task_worker (void *data)
+{
+	struct mctp_cmd_task *task = (struct mctp_cmd_task*) data;
+
+	while (1) {
+		ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+		cmd_async_execute (task->async);
 	}
 }
 
 /**
- * Initialize and start the task to process received MCTP messages.
+ * Initialize and start the task to process received MCTP messages.  Responses are generated in
+ * place from the MCTP message buffer, and the MCTP interface will be configured to reassemble
+ * requests from multiple requesters using contexts owned by the task.
+ *
+ * If a context for deferred requests is provided, a worker task will be started to execute
+ * requests deferred by the command interface, and the responses will be sent when they are ready.
+ * The same context must be provided to the command interface to enable deferring requests.
  *
  * @param task The MCTP command task to initialize.
  * @param channel The command channel for sending and receiving packets.
  * @param mctp The MCTP protocol handler to use for packet processing.
+ * @param async The context for deferred requests.  Set this to null to process all requests in the
+ * command task.
  *
  * @return Initialization status, 0 if success or an error code.
  */
 int mctp_cmd_task_init (struct mctp_cmd_task *task, struct cmd_channel *channel,
-	struct mctp_interface *mctp)
+	struct mctp_interface *mctp, struct cmd_async *async)
 {
 	int status;
 
@@ -44,14 +86,44 @@ int mctp_cmd_task_init (struct mctp_cmd_task *task, struct cmd_channel *channel,
 
 	task->channel = channel;
 	task->mctp = mctp;
+	task->async = async;
+
+	status = mctp_interface_set_reassembly_contexts (mctp, task->rx_ctx, MCTP_CMD_TASK_RX_CONTEXTS,
+		MCTP_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS);
+	if (status != 0) {
+		return status;
+	}
+
+	status = mctp_interface_set_async (mctp, async);
+	if (status != 0) {
+		goto err_ctx;
+	}
+
+	if (async != NULL) {
+		status = xTaskCreate (mctp_cmd_task_worker, "MCTP_WORK", 6 * 256, task,
+			CERBERUS_PRIORITY_NORMAL, &task->worker_task);
+		if (status != pdPASS) {
+			goto err_async;
+		}
+	}
 
 	status = xTaskCreate (mctp_cmd_task_loop, "MCTP_LOOP", 6 * 256, task, CERBERUS_PRIORITY_HIGH,
 		&task->cmd_loop_task);
 	if (status != pdPASS) {
-		return status;
+		goto err_worker;
 	}
 
 	return 0;
+
+err_worker:
+	if (task->worker_task != NULL) {
+		vTaskDelete (task->worker_task);
+	}
+err_async:
+	mctp_interface_set_async (mctp, NULL);
+err_ctx:
+	mctp_interface_set_reassembly_contexts (mctp, NULL, 0, 0);
+	return status;
 }
 
 /**
@@ -63,5 +135,11 @@ void mctp_cmd_task_deinit (struct mctp_cmd_task *task)
 {
 	if (task != NULL) {
 		vTaskDelete (task->cmd_loop_task);
+		if (task->worker_task != NULL) {
+			vTaskDelete (task->worker_task);
+		}
+
+		mctp_interface_set_async (task->mctp, NULL);
+		mctp_interface_set_reassembly_contexts (task->mctp, NULL, 0, 0);
 	}
 }
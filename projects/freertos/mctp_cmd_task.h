@@ -8,10 +8,25 @@
 #include "task.h"
 #include "mctp/mctp_interface.h"
 #include "cmd_interface/cmd_channel.h"
+#include "cmd_interface/cmd_async.h"
 
 
 #define MCTP_RESPONSE_TIMEOUT_MS 	100
 
+/**
+ * The number of requests from different requesters that can be reassembled concurrently.
+ */
+#ifndef MCTP_CMD_TASK_RX_CONTEXTS
+#define	MCTP_CMD_TASK_RX_CONTEXTS	2
+#endif
+
+/**
+ * The interval, in milliseconds, for checking if a deferred request has completed.
+ */
+#ifndef MCTP_CMD_TASK_DEFERRED_POLL_MS
+#define	MCTP_CMD_TASK_DEFERRED_POLL_MS	10
+#endif
+
 
 /**
  * Task context for processing MCTP messages.
@@ -19,12 +34,16 @@
 struct mctp_cmd_task {
 	struct cmd_channel *channel;			/**< Command channel for receiving messages. */
 	struct mctp_interface *mctp;  	  		/**< MCTP protocol layer. */
+	struct cmd_async *async;				/**< Context for deferred requests. */
 	TaskHandle_t cmd_loop_task;       		/**< Task handle for command processing loop. */
+	TaskHandle_t worker_task;				/**< Task handle for executing deferred requests. */
+	/** Reassembly contexts for received requests. */
+	struct mctp_interface_rx_context rx_ctx[MCTP_CMD_TASK_RX_CONTEXTS];
 };
 
 
 int mctp_cmd_task_init (struct mctp_cmd_task *task, struct cmd_channel *channel,
-	struct mctp_interface *mctp);
+	struct mctp_interface *mctp, struct cmd_async *async);
 void mctp_cmd_task_deinit (struct mctp_cmd_task *task);
 
 
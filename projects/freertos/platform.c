@@ -161,6 +161,23 @@ int platform_has_timeout_expired (platform_clock *timeout)
 	}
 }
 
+/**
+ * Get the amount of time that elapsed between two clock values.
+ *
+ * @param start The starting clock value.
+ * @param end The ending clock value.
+ *
+ * @return The elapsed time, in milliseconds.
+ */
+uint32_t platform_get_duration (const platform_clock *start, const platform_clock *end)
+{
+	if ((start == NULL) || (end == NULL)) {
+		return 0;
+	}
+
+	return (TickType_t) (end->ticks - start->ticks) * portTICK_PERIOD_MS;
+}
+
 
 #define	PLATFORM_MUTEX_ERROR(code)		ROT_ERROR (ROT_MODULE_PLATFORM_MUTEX, code)
 
@@ -10,6 +10,7 @@
 #include <openssl/err.h>
 #include "rsa_openssl.h"
 #include "platform.h"
+#include "common/unused.h"
 
 
 static int rsa_openssl_generate_key (struct rsa_engine *engine, struct rsa_private_key *key,
@@ -319,6 +320,14 @@ static int rsa_openssl_sig_verify (struct rsa_engine *engine, const struct rsa_p
 	return (status == 1) ? 0 : RSA_ENGINE_BAD_SIGNATURE;
 }
 
+static void rsa_openssl_invalidate_public_key (struct rsa_engine *engine,
+	const struct rsa_public_key *key)
+{
+	/* Public keys are loaded for every verification, so there is no retained state to discard. */
+	UNUSED (engine);
+	UNUSED (key);
+}
+
 /**
  * Initialize an openssl RSA engine.
  *
@@ -342,6 +351,7 @@ int rsa_openssl_init (struct rsa_engine_openssl *engine)
 	engine->base.get_public_key_der = rsa_openssl_get_public_key_der;
 	engine->base.decrypt = rsa_openssl_decrypt;
 	engine->base.sig_verify = rsa_openssl_sig_verify;
+	engine->base.invalidate_public_key = rsa_openssl_invalidate_public_key;
 
 	return 0;
 }
@@ -0,0 +1,1053 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "flash_master_sim.h"
+#include "flash/flash_common.h"
+
+
+/**
+ * Size of a programmable page.
+ */
+#define	FLASH_MASTER_SIM_PAGE_SIZE			256
+
+/**
+ * Delays shorter than this are implemented by spinning instead of sleeping.
+ */
+#define	FLASH_MASTER_SIM_SPIN_NS			100000
+
+/**
+ * Vendor specific status bits that indicate 4-byte address mode.
+ */
+#define	FLASH_MASTER_SIM_MACRONIX_4BYTE		(1U << 5)
+#define	FLASH_MASTER_SIM_WINBOND_4BYTE		(1U << 0)
+#define	FLASH_MASTER_SIM_MICRON_4BYTE		(1U << 0)
+
+
+static const uint32_t FLASH_MASTER_SIM_W25Q256JV_SFDP_HEADER[] = {
+	0x50444653,
+	0xff000105,
+	0x10010500,
+	0xff000080
+};
+
+static const uint32_t FLASH_MASTER_SIM_W25Q256JV_SFDP_PARAMS[] = {
+	0xfffb20e5,
+	0x0fffffff,
+	0x6b08eb44,
+	0xbb423b08,
+	0xfffffffe,
+	0x0000ffff,
+	0xeb40ffff,
+	0x520f200c,
+	0x0000d810,
+	0x00a60236,
+	0xd314ea82,
+	0x337663e9,
+	0x757a757a,
+	0x5cd5a2f7,
+	0xff4df719,
+	0xa5f970e9
+};
+
+const struct flash_master_sim_device FLASH_MASTER_SIM_W25Q256JV = {
+	.id = {0xef, 0x40, 0x19},
+	.size = 0x2000000,
+	.sfdp_header = FLASH_MASTER_SIM_W25Q256JV_SFDP_HEADER,
+	.sfdp_header_len = sizeof (FLASH_MASTER_SIM_W25Q256JV_SFDP_HEADER),
+	.sfdp_params_addr = 0x80,
+	.sfdp_params = FLASH_MASTER_SIM_W25Q256JV_SFDP_PARAMS,
+	.sfdp_params_len = sizeof (FLASH_MASTER_SIM_W25Q256JV_SFDP_PARAMS)
+};
+
+const struct flash_master_sim_timing FLASH_MASTER_SIM_TIMING_TYPICAL = {
+	.spi_clock_hz = 50000000,
+	.xfer_overhead_ns = 1000,
+	.page_program_us = 400,
+	.sector_erase_us = 45000,
+	.block_erase_us = 150000,
+	.chip_erase_ms = 80000,
+	.register_write_us = 10000,
+	.real_time = false
+};
+
+
+/**
+ * Get the current time for the simulated device.  With a virtual clock, this is the total simulated
+ * time.  In real time mode, this is the time elapsed since the device was initialized.
+ *
+ * @param sim The simulated device.
+ *
+ * @return The current time, in nanoseconds.
+ */
+static uint64_t flash_master_sim_now (struct flash_master_sim *sim)
+{
+	struct timespec now;
+
+	if (!sim->timing.real_time) {
+		return sim->stats.time_ns;
+	}
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return ((uint64_t) (now.tv_sec - sim->start.tv_sec) * 1000000000ULL) +
+		(uint64_t) now.tv_nsec - (uint64_t) sim->start.tv_nsec;
+}
+
+/**
+ * Advance the simulated time.  In real time mode, the caller is delayed for the same amount of
+ * time.
+ *
+ * @param sim The simulated device.
+ * @param ns The amount of time to add, in nanoseconds.
+ */
+static void flash_master_sim_advance (struct flash_master_sim *sim, uint64_t ns)
+{
+	struct timespec delay;
+	uint64_t end;
+
+	sim->stats.time_ns += ns;
+
+	if (sim->timing.real_time && (ns != 0)) {
+		end = flash_master_sim_now (sim) + ns;
+
+		if (ns >= FLASH_MASTER_SIM_SPIN_NS) {
+			delay.tv_sec = ns / 1000000000ULL;
+			delay.tv_nsec = ns % 1000000000ULL;
+			nanosleep (&delay, NULL);
+		}
+
+		while (flash_master_sim_now (sim) < end) {
+		}
+	}
+}
+
+/**
+ * Determine the number of SPI data lines used for a phase of a transaction.
+ *
+ * @param flags The transaction flags.
+ * @param dual The dual SPI flag for the phase.
+ * @param quad The quad SPI flag for the phase.
+ *
+ * @return The number of data lines.
+ */
+static int flash_master_sim_lanes (uint16_t flags, uint16_t dual, uint16_t quad)
+{
+	if (flags & quad) {
+		return 4;
+	}
+	else if (flags & dual) {
+		return 2;
+	}
+	else {
+		return 1;
+	}
+}
+
+/**
+ * Calculate the time required to execute a transaction on the SPI bus.
+ *
+ * @param sim The simulated device.
+ * @param xfer The transaction being executed.
+ *
+ * @return The transaction time, in nanoseconds.
+ */
+static uint64_t flash_master_sim_xfer_time (struct flash_master_sim *sim,
+	const struct flash_xfer *xfer)
+{
+	uint64_t clocks;
+	int addr_bytes;
+	int addr_lanes;
+
+	if (sim->timing.spi_clock_hz == 0) {
+		return sim->timing.xfer_overhead_ns;
+	}
+
+	if (xfer->flags & FLASH_FLAG_NO_ADDRESS) {
+		addr_bytes = 0;
+	}
+	else {
+		addr_bytes = (xfer->flags & FLASH_FLAG_4BYTE_ADDRESS) ? 4 : 3;
+	}
+
+	addr_lanes = flash_master_sim_lanes (xfer->flags, FLASH_FLAG_DUAL_ADDR, FLASH_FLAG_QUAD_ADDR);
+
+	clocks = 8 / flash_master_sim_lanes (xfer->flags, FLASH_FLAG_DUAL_CMD, FLASH_FLAG_QUAD_CMD);
+	clocks += ((addr_bytes + xfer->dummy_bytes + xfer->mode_bytes) * 8) / addr_lanes;
+	clocks += ((uint64_t) xfer->length * 8) /
+		flash_master_sim_lanes (xfer->flags, FLASH_FLAG_DUAL_DATA, FLASH_FLAG_QUAD_DATA);
+
+	return sim->timing.xfer_overhead_ns + ((clocks * 1000000000ULL) / sim->timing.spi_clock_hz);
+}
+
+/**
+ * Check if the SPI master supports the bus configuration used by a transaction.
+ *
+ * @param sim The simulated device.
+ * @param flags The transaction flags.
+ *
+ * @return true if the transaction is supported.
+ */
+static bool flash_master_sim_is_supported (struct flash_master_sim *sim, uint16_t flags)
+{
+	uint32_t required = 0;
+
+	if (flags & FLASH_FLAG_QUAD_CMD) {
+		required |= FLASH_CAP_QUAD_4_4_4;
+	}
+	else if (flags & FLASH_FLAG_QUAD_ADDR) {
+		required |= FLASH_CAP_QUAD_1_4_4;
+	}
+	else if (flags & FLASH_FLAG_QUAD_DATA) {
+		required |= FLASH_CAP_QUAD_1_1_4;
+	}
+	else if (flags & FLASH_FLAG_DUAL_CMD) {
+		required |= FLASH_CAP_DUAL_2_2_2;
+	}
+	else if (flags & FLASH_FLAG_DUAL_ADDR) {
+		required |= FLASH_CAP_DUAL_1_2_2;
+	}
+	else if (flags & FLASH_FLAG_DUAL_DATA) {
+		required |= FLASH_CAP_DUAL_1_1_2;
+	}
+
+	if (!(flags & FLASH_FLAG_NO_ADDRESS)) {
+		required |= (flags & FLASH_FLAG_4BYTE_ADDRESS) ?
+			FLASH_CAP_4BYTE_ADDR : FLASH_CAP_3BYTE_ADDR;
+	}
+
+	return ((sim->capabilities & required) == required);
+}
+
+/**
+ * Get a single byte of SFDP data.
+ *
+ * @param sim The simulated device.
+ * @param address The SFDP address to read.
+ *
+ * @return The SFDP data at the address.
+ */
+static uint8_t flash_master_sim_sfdp_byte (struct flash_master_sim *sim, uint32_t address)
+{
+	const struct flash_master_sim_device *device = &sim->device;
+	uint64_t bits;
+	uint32_t dword;
+	uint32_t offset;
+	int log2 = 0;
+
+	if (device->sfdp_header && (address < device->sfdp_header_len)) {
+		dword = device->sfdp_header[address / 4];
+	}
+	else if (device->sfdp_params && (address >= device->sfdp_params_addr) &&
+		((address - device->sfdp_params_addr) < device->sfdp_params_len)) {
+		offset = address - device->sfdp_params_addr;
+		dword = device->sfdp_params[offset / 4];
+
+		if ((offset / 4) == 1) {
+			/* Report the configured device size as the flash density. */
+			bits = (uint64_t) device->size * 8;
+			if (bits <= 0x80000000ULL) {
+				dword = bits - 1;
+			}
+			else {
+				while (bits > 1) {
+					bits >>= 1;
+					log2++;
+				}
+				dword = 0x80000000 | log2;
+			}
+		}
+	}
+	else {
+		return 0xff;
+	}
+
+	return (dword >> ((address % 4) * 8)) & 0xff;
+}
+
+/**
+ * Fill the data buffer for a transaction with a single value.
+ *
+ * @param xfer The transaction to update.
+ * @param value The value to use for every data byte.
+ */
+static void flash_master_sim_fill (const struct flash_xfer *xfer, uint8_t value)
+{
+	uint32_t i;
+
+	for (i = 0; i < xfer->length; i++) {
+		xfer->data[i] = value;
+	}
+}
+
+/**
+ * Get the value of status register 3 with the current address mode reflected in the vendor
+ * specific status bit.
+ *
+ * @param sim The simulated device.
+ *
+ * @return The register value.
+ */
+static uint8_t flash_master_sim_read_status3 (struct flash_master_sim *sim)
+{
+	uint8_t reg = sim->status[2];
+
+	if (sim->addr_4byte) {
+		switch (sim->device.id[0]) {
+			case FLASH_ID_MACRONIX:
+				reg |= FLASH_MASTER_SIM_MACRONIX_4BYTE;
+				break;
+
+			case FLASH_ID_WINBOND:
+				reg |= FLASH_MASTER_SIM_WINBOND_4BYTE;
+				break;
+		}
+	}
+
+	return reg;
+}
+
+/**
+ * Get the mask of status register 3 bits that are writable.
+ *
+ * @param sim The simulated device.
+ *
+ * @return The writable bits.
+ */
+static uint8_t flash_master_sim_status3_mask (struct flash_master_sim *sim)
+{
+	switch (sim->device.id[0]) {
+		case FLASH_ID_MACRONIX:
+			return (uint8_t) ~FLASH_MASTER_SIM_MACRONIX_4BYTE;
+
+		case FLASH_ID_WINBOND:
+			return (uint8_t) ~FLASH_MASTER_SIM_WINBOND_4BYTE;
+
+		default:
+			return 0xff;
+	}
+}
+
+/**
+ * Fill a buffer with data read from the flash contents.  Reads that reach the end of the device
+ * wrap to the beginning.
+ *
+ * @param sim The simulated device.
+ * @param address The address to start reading.
+ * @param data Output buffer for the data.
+ * @param length The number of bytes to read.
+ */
+static void flash_master_sim_read_memory (struct flash_master_sim *sim, uint32_t address,
+	uint8_t *data, size_t length)
+{
+	size_t chunk;
+
+	address %= sim->device.size;
+	while (length) {
+		chunk = sim->device.size - address;
+		if (chunk > length) {
+			chunk = length;
+		}
+
+		memcpy (data, &sim->memory[address], chunk);
+		data += chunk;
+		length -= chunk;
+		address = 0;
+	}
+}
+
+/**
+ * Program data into a single page of flash.  Programming can only clear bits.  Data that extends
+ * past the end of the page wraps to the beginning of the same page.
+ *
+ * @param sim The simulated device.
+ * @param address The address to start programming.
+ * @param data The data to program.
+ * @param length The number of bytes to program.
+ */
+static void flash_master_sim_program_page (struct flash_master_sim *sim, uint32_t address,
+	const uint8_t *data, size_t length)
+{
+	uint32_t page;
+	size_t i = 0;
+
+	address %= sim->device.size;
+	page = address & ~(FLASH_MASTER_SIM_PAGE_SIZE - 1);
+
+	/* Only the last page of data sent to the device is programmed. */
+	if (length > FLASH_MASTER_SIM_PAGE_SIZE) {
+		i = length - FLASH_MASTER_SIM_PAGE_SIZE;
+	}
+
+	for (; i < length; i++) {
+		sim->memory[page + ((address + i) & (FLASH_MASTER_SIM_PAGE_SIZE - 1))] &= data[i];
+	}
+}
+
+/**
+ * Erase a region of flash.
+ *
+ * @param sim The simulated device.
+ * @param address An address within the region to erase.
+ * @param size The size of the erase region.
+ */
+static void flash_master_sim_erase (struct flash_master_sim *sim, uint32_t address, uint32_t size)
+{
+	address = (address % sim->device.size) & ~(size - 1);
+	if (size > (sim->device.size - address)) {
+		size = sim->device.size - address;
+	}
+
+	memset (&sim->memory[address], 0xff, size);
+}
+
+/**
+ * Start a write operation on the device.  The write enable latch is cleared and the device will
+ * report a write in progress until the operation completes.
+ *
+ * @param sim The simulated device.
+ * @param busy_ns The time required to complete the operation.
+ */
+static void flash_master_sim_start_write (struct flash_master_sim *sim, uint64_t busy_ns)
+{
+	sim->wel = false;
+	sim->volatile_wel = false;
+	sim->busy_until = flash_master_sim_now (sim) + busy_ns;
+}
+
+/**
+ * Write a status or configuration register.
+ *
+ * @param sim The simulated device.
+ * @param reg The registers to update.
+ * @param mask Mask for the writable bits of each register.
+ * @param count The number of registers that can be written.
+ * @param xfer The transaction with the register data.
+ *
+ * @return true if the registers were written or false if the command was ignored.
+ */
+static bool flash_master_sim_write_register (struct flash_master_sim *sim, uint8_t *reg,
+	const uint8_t *mask, size_t count, const struct flash_xfer *xfer)
+{
+	bool non_volatile = sim->wel;
+	size_t i;
+
+	if (!sim->wel && !sim->volatile_wel) {
+		return false;
+	}
+
+	for (i = 0; (i < count) && (i < xfer->length); i++) {
+		reg[i] = (reg[i] & ~mask[i]) | (xfer->data[i] & mask[i]);
+	}
+
+	flash_master_sim_start_write (sim,
+		(non_volatile) ? (uint64_t) sim->timing.register_write_us * 1000 : 0);
+	return true;
+}
+
+/**
+ * Reset the volatile state of the device.
+ *
+ * @param sim The simulated device.
+ */
+static void flash_master_sim_reset (struct flash_master_sim *sim)
+{
+	sim->wel = false;
+	sim->volatile_wel = false;
+	sim->addr_4byte = false;
+	sim->busy_until = flash_master_sim_now (sim);
+}
+
+/**
+ * Determine if a command is allowed to execute while the device is busy.
+ *
+ * @param cmd The command code.
+ *
+ * @return true if the command can be executed.
+ */
+static bool flash_master_sim_is_status_command (uint8_t cmd)
+{
+	switch (cmd) {
+		case FLASH_CMD_RDSR:
+		case FLASH_CMD_RDSR2:
+		case FLASH_CMD_ALT_RDSR2:
+		case FLASH_CMD_RDSR3:
+		case FLASH_CMD_RDSR_FLAG:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Get the address used by a transaction and check that it matches the address mode expected by
+ * the device.  A real device would misinterpret a transaction with the wrong address length.
+ *
+ * @param sim The simulated device.
+ * @param xfer The transaction to check.
+ * @param force_4byte Flag indicating the command always uses a 4-byte address.
+ * @param address Output for the device address.
+ *
+ * @return true if the address is valid for the command.
+ */
+static bool flash_master_sim_get_address (struct flash_master_sim *sim,
+	const struct flash_xfer *xfer, bool force_4byte, uint32_t *address)
+{
+	bool is_4byte = force_4byte || sim->addr_4byte;
+
+	if ((xfer->flags & FLASH_FLAG_NO_ADDRESS) ||
+		(is_4byte != !!(xfer->flags & FLASH_FLAG_4BYTE_ADDRESS))) {
+		return false;
+	}
+
+	*address = (is_4byte) ? xfer->address : (xfer->address & 0xffffff);
+	return true;
+}
+
+/**
+ * Execute a single transaction against the simulated device.
+ *
+ * @param sim The simulated device.
+ * @param xfer The transaction to execute.
+ *
+ * @return 0 if the transaction was handled by the device, 1 if it was ignored, or an error code.
+ */
+static int flash_master_sim_execute (struct flash_master_sim *sim, const struct flash_xfer *xfer)
+{
+	bool busy = (flash_master_sim_now (sim) < sim->busy_until);
+	bool reset_enable = sim->reset_enable;
+	bool force_4byte = false;
+	uint8_t mask[2] = {0xff, 0xff};
+	uint32_t address;
+	uint32_t i;
+
+	sim->reset_enable = false;
+
+	if (sim->power_down && (xfer->cmd != FLASH_CMD_RDP)) {
+		return 1;
+	}
+
+	if (busy && !flash_master_sim_is_status_command (xfer->cmd)) {
+		return 1;
+	}
+
+	switch (xfer->cmd) {
+		case FLASH_CMD_4BYTE_READ:
+		case FLASH_CMD_4BYTE_FAST_READ:
+		case FLASH_CMD_4BYTE_DUAL_READ:
+		case FLASH_CMD_4BYTE_QUAD_READ:
+		case FLASH_CMD_4BYTE_DIO_READ:
+		case FLASH_CMD_4BYTE_QIO_READ:
+			force_4byte = true;
+			/* fall through */
+
+		case FLASH_CMD_READ:
+		case FLASH_CMD_FAST_READ:
+		case FLASH_CMD_DUAL_READ:
+		case FLASH_CMD_QUAD_READ:
+		case FLASH_CMD_DIO_READ:
+		case FLASH_CMD_QIO_READ:
+			if (!flash_master_sim_get_address (sim, xfer, force_4byte, &address)) {
+				return FLASH_MASTER_XFER_FAILED;
+			}
+
+			flash_master_sim_read_memory (sim, address, xfer->data, xfer->length);
+			sim->stats.reads++;
+			sim->stats.read_bytes += xfer->length;
+			break;
+
+		case FLASH_CMD_4BYTE_PP:
+			force_4byte = true;
+			/* fall through */
+
+		case FLASH_CMD_PP:
+			if (!flash_master_sim_get_address (sim, xfer, force_4byte, &address)) {
+				return FLASH_MASTER_XFER_FAILED;
+			}
+
+			if (!sim->wel) {
+				return 1;
+			}
+
+			flash_master_sim_program_page (sim, address, xfer->data, xfer->length);
+			flash_master_sim_start_write (sim, (uint64_t) sim->timing.page_program_us * 1000);
+			sim->stats.programs++;
+			sim->stats.program_bytes += xfer->length;
+			break;
+
+		case FLASH_CMD_4BYTE_4K_ERASE:
+			force_4byte = true;
+			/* fall through */
+
+		case FLASH_CMD_4K_ERASE:
+			if (!flash_master_sim_get_address (sim, xfer, force_4byte, &address)) {
+				return FLASH_MASTER_XFER_FAILED;
+			}
+
+			if (!sim->wel) {
+				return 1;
+			}
+
+			flash_master_sim_erase (sim, address, 0x1000);
+			flash_master_sim_start_write (sim, (uint64_t) sim->timing.sector_erase_us * 1000);
+			sim->stats.sector_erases++;
+			break;
+
+		case FLASH_CMD_4BYTE_64K_ERASE:
+			force_4byte = true;
+			/* fall through */
+
+		case FLASH_CMD_64K_ERASE:
+			if (!flash_master_sim_get_address (sim, xfer, force_4byte, &address)) {
+				return FLASH_MASTER_XFER_FAILED;
+			}
+
+			if (!sim->wel) {
+				return 1;
+			}
+
+			flash_master_sim_erase (sim, address, 0x10000);
+			flash_master_sim_start_write (sim, (uint64_t) sim->timing.block_erase_us * 1000);
+			sim->stats.block_erases++;
+			break;
+
+		case FLASH_CMD_CE:
+			if (!sim->wel) {
+				return 1;
+			}
+
+			memset (sim->memory, 0xff, sim->device.size);
+			flash_master_sim_start_write (sim, (uint64_t) sim->timing.chip_erase_ms * 1000000);
+			sim->stats.chip_erases++;
+			break;
+
+		case FLASH_CMD_WREN:
+			sim->wel = true;
+			break;
+
+		case FLASH_CMD_VOLATILE_WREN:
+			sim->volatile_wel = true;
+			break;
+
+		case FLASH_CMD_WRDI:
+			sim->wel = false;
+			sim->volatile_wel = false;
+			break;
+
+		case FLASH_CMD_RDSR:
+			for (i = 0; i < xfer->length; i++) {
+				if (i == 0) {
+					xfer->data[i] = sim->status[0] & ~(FLASH_STATUS_WIP | FLASH_STATUS_WEL);
+					if (busy) {
+						xfer->data[i] |= FLASH_STATUS_WIP;
+					}
+					if (sim->wel) {
+						xfer->data[i] |= FLASH_STATUS_WEL;
+					}
+				}
+				else {
+					xfer->data[i] = sim->status[1];
+				}
+			}
+			sim->stats.status_reads++;
+			break;
+
+		case FLASH_CMD_RDSR2:
+		case FLASH_CMD_ALT_RDSR2:
+			flash_master_sim_fill (xfer, sim->status[1]);
+			sim->stats.status_reads++;
+			break;
+
+		case FLASH_CMD_RDSR3:
+			flash_master_sim_fill (xfer, flash_master_sim_read_status3 (sim));
+			sim->stats.status_reads++;
+			break;
+
+		case FLASH_CMD_RDSR_FLAG:
+			flash_master_sim_fill (xfer, ((busy) ? 0 : FLASH_FLAG_STATUS_READY) |
+				((sim->addr_4byte) ? FLASH_MASTER_SIM_MICRON_4BYTE : 0));
+			sim->stats.status_reads++;
+			break;
+
+		case FLASH_CMD_WRSR:
+			mask[0] = (uint8_t) ~(FLASH_STATUS_WIP | FLASH_STATUS_WEL);
+			if (!flash_master_sim_write_register (sim, sim->status, mask, 2, xfer)) {
+				return 1;
+			}
+			break;
+
+		case FLASH_CMD_WRSR2:
+		case FLASH_CMD_ALT_WRSR2:
+			if (!flash_master_sim_write_register (sim, &sim->status[1], mask, 1, xfer)) {
+				return 1;
+			}
+			break;
+
+		case FLASH_CMD_WRSR3:
+			mask[0] = flash_master_sim_status3_mask (sim);
+			if (!flash_master_sim_write_register (sim, &sim->status[2], mask, 1, xfer)) {
+				return 1;
+			}
+			break;
+
+		case FLASH_CMD_WR_NV_CFG:
+			if (!flash_master_sim_write_register (sim, sim->nv_config, mask, 2, xfer)) {
+				return 1;
+			}
+			break;
+
+		case FLASH_CMD_RD_NV_CFG:
+			for (i = 0; i < xfer->length; i++) {
+				xfer->data[i] = sim->nv_config[i % 2];
+			}
+			break;
+
+		case FLASH_CMD_SFDP:
+			for (i = 0; i < xfer->length; i++) {
+				xfer->data[i] = flash_master_sim_sfdp_byte (sim, (xfer->address + i) & 0xffffff);
+			}
+			break;
+
+		case FLASH_CMD_RDID:
+			for (i = 0; i < xfer->length; i++) {
+				xfer->data[i] = (i < sizeof (sim->device.id)) ? sim->device.id[i] : 0xff;
+			}
+			break;
+
+		case FLASH_CMD_EN4B:
+			sim->addr_4byte = true;
+			break;
+
+		case FLASH_CMD_EX4B:
+			sim->addr_4byte = false;
+			break;
+
+		case FLASH_CMD_RSTEN:
+			sim->reset_enable = true;
+			break;
+
+		case FLASH_CMD_RST:
+			if (!reset_enable) {
+				return 1;
+			}
+
+			flash_master_sim_reset (sim);
+			break;
+
+		case FLASH_CMD_ALT_RST:
+			flash_master_sim_reset (sim);
+			break;
+
+		case FLASH_CMD_DP:
+			sim->power_down = true;
+			break;
+
+		case FLASH_CMD_RDP:
+			sim->power_down = false;
+			flash_master_sim_fill (xfer, sim->device.id[2]);
+			break;
+
+		default:
+			return 1;
+	}
+
+	return 0;
+}
+
+static int flash_master_sim_xfer (struct flash_master *spi, const struct flash_xfer *xfer)
+{
+	struct flash_master_sim *sim = (struct flash_master_sim*) spi;
+	uint64_t now;
+	int status;
+
+	if ((sim == NULL) || (xfer == NULL)) {
+		return FLASH_MASTER_INVALID_ARGUMENT;
+	}
+
+	if ((xfer->length != 0) && (xfer->data == NULL)) {
+		return FLASH_MASTER_NO_XFER_DATA;
+	}
+
+	if (!flash_master_sim_is_supported (sim, xfer->flags)) {
+		return FLASH_MASTER_UNSUPPORTED_XFER;
+	}
+
+	platform_mutex_lock (&sim->lock);
+
+	sim->stats.xfers++;
+	flash_master_sim_advance (sim, flash_master_sim_xfer_time (sim, xfer));
+
+	status = flash_master_sim_execute (sim, xfer);
+	if (status != 0) {
+		sim->stats.ignored++;
+		if (status == 1) {
+			status = 0;
+		}
+	}
+
+	now = flash_master_sim_now (sim);
+	if (flash_master_sim_is_status_command (xfer->cmd) && (now < sim->busy_until)) {
+		sim->stats.busy_polls++;
+
+		/* The caller will wait before polling again, so let the operation complete before the
+		 * next status read. */
+		if (!sim->timing.real_time) {
+			sim->stats.time_ns = sim->busy_until;
+		}
+	}
+
+	platform_mutex_unlock (&sim->lock);
+	return status;
+}
+
+static uint32_t flash_master_sim_capabilities (struct flash_master *spi)
+{
+	struct flash_master_sim *sim = (struct flash_master_sim*) spi;
+
+	if (sim == NULL) {
+		return 0;
+	}
+
+	return sim->capabilities;
+}
+
+/**
+ * Initialize the common state of a simulated flash device.
+ *
+ * @param sim The simulated device to initialize.
+ * @param device The flash device to simulate.
+ *
+ * @return 0 if the device was initialized successfully or an error code.
+ */
+static int flash_master_sim_init_state (struct flash_master_sim *sim,
+	const struct flash_master_sim_device *device)
+{
+	if ((sim == NULL) || (device == NULL) || (device->size == 0)) {
+		return FLASH_MASTER_INVALID_ARGUMENT;
+	}
+
+	memset (sim, 0, sizeof (struct flash_master_sim));
+
+	sim->base.xfer = flash_master_sim_xfer;
+	sim->base.capabilities = flash_master_sim_capabilities;
+
+	sim->device = *device;
+	sim->fd = -1;
+	sim->capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 |
+		FLASH_CAP_3BYTE_ADDR | FLASH_CAP_4BYTE_ADDR;
+
+	clock_gettime (CLOCK_MONOTONIC, &sim->start);
+
+	return platform_mutex_init (&sim->lock);
+}
+
+/**
+ * Initialize a SPI master connected to a simulated flash device stored in RAM.  The flash will
+ * initially be erased.
+ *
+ * The simulated device executes every transaction instantly.  Use
+ * {@link flash_master_sim_set_timing} to enable the timing model.  All dual and quad SPI modes are
+ * supported by default, but this can be restricted by updating the capabilities after
+ * initialization.
+ *
+ * @param sim The simulated device to initialize.
+ * @param device The flash device to simulate.
+ *
+ * @return 0 if the device was initialized successfully or an error code.
+ */
+int flash_master_sim_init (struct flash_master_sim *sim,
+	const struct flash_master_sim_device *device)
+{
+	int status;
+
+	status = flash_master_sim_init_state (sim, device);
+	if (status != 0) {
+		return status;
+	}
+
+	sim->memory = platform_malloc (device->size);
+	if (sim->memory == NULL) {
+		platform_mutex_free (&sim->lock);
+		return FLASH_MASTER_NO_MEMORY;
+	}
+
+	memset (sim->memory, 0xff, device->size);
+
+	return 0;
+}
+
+/**
+ * Initialize a SPI master connected to a simulated flash device stored in a file.  The file is
+ * mapped into memory, so changes to the flash contents are persisted.  If the file does not exist,
+ * it will be created.  If the file is smaller than the flash device, it will be extended with
+ * erased data.
+ *
+ * @param sim The simulated device to initialize.
+ * @param device The flash device to simulate.
+ * @param path Path to the file that holds the flash contents.
+ *
+ * @return 0 if the device was initialized successfully or an error code.
+ */
+int flash_master_sim_init_file (struct flash_master_sim *sim,
+	const struct flash_master_sim_device *device, const char *path)
+{
+	struct stat file_stat;
+	void *memory;
+	int status;
+
+	if (path == NULL) {
+		return FLASH_MASTER_INVALID_ARGUMENT;
+	}
+
+	status = flash_master_sim_init_state (sim, device);
+	if (status != 0) {
+		return status;
+	}
+
+	sim->fd = open (path, O_RDWR | O_CREAT, 0644);
+	if (sim->fd < 0) {
+		status = FLASH_MASTER_HW_NOT_INIT;
+		goto exit_mutex;
+	}
+
+	if (fstat (sim->fd, &file_stat) != 0) {
+		status = FLASH_MASTER_HW_NOT_INIT;
+		goto exit_file;
+	}
+
+	if (file_stat.st_size < device->size) {
+		if (ftruncate (sim->fd, device->size) != 0) {
+			status = FLASH_MASTER_HW_NOT_INIT;
+			goto exit_file;
+		}
+	}
+
+	memory = mmap (NULL, device->size, PROT_READ | PROT_WRITE, MAP_SHARED, sim->fd, 0);
+	if (memory == MAP_FAILED) {
+		status = FLASH_MASTER_NO_MEMORY;
+		goto exit_file;
+	}
+
+	sim->memory = memory;
+	if (file_stat.st_size < device->size) {
+		memset (&sim->memory[file_stat.st_size], 0xff, device->size - file_stat.st_size);
+	}
+
+	return 0;
+
+exit_file:
+	close (sim->fd);
+exit_mutex:
+	platform_mutex_free (&sim->lock);
+	return status;
+}
+
+/**
+ * Release the resources used by a simulated flash device.  File-backed flash contents are written
+ * back to the file.
+ *
+ * @param sim The simulated device to release.
+ */
+void flash_master_sim_release (struct flash_master_sim *sim)
+{
+	if (sim) {
+		if (sim->fd >= 0) {
+			msync (sim->memory, sim->device.size, MS_SYNC);
+			munmap (sim->memory, sim->device.size);
+			close (sim->fd);
+		}
+		else {
+			platform_free (sim->memory);
+		}
+
+		platform_mutex_free (&sim->lock);
+	}
+}
+
+/**
+ * Configure the timing model for the simulated device.
+ *
+ * @param sim The simulated device to configure.
+ * @param timing The timing model to use.  Null disables timing, so every transaction completes
+ * instantly.
+ */
+void flash_master_sim_set_timing (struct flash_master_sim *sim,
+	const struct flash_master_sim_timing *timing)
+{
+	if (sim) {
+		platform_mutex_lock (&sim->lock);
+
+		if (timing) {
+			sim->timing = *timing;
+		}
+		else {
+			memset (&sim->timing, 0, sizeof (sim->timing));
+		}
+
+		clock_gettime (CLOCK_MONOTONIC, &sim->start);
+		sim->busy_until = 0;
+		sim->stats.time_ns = 0;
+
+		platform_mutex_unlock (&sim->lock);
+	}
+}
+
+/**
+ * Get the operation counters for the simulated device.
+ *
+ * @param sim The simulated device to query.
+ * @param stats Output for the current counters.
+ */
+void flash_master_sim_get_stats (struct flash_master_sim *sim,
+	struct flash_master_sim_stats *stats)
+{
+	if (sim && stats) {
+		platform_mutex_lock (&sim->lock);
+		*stats = sim->stats;
+		platform_mutex_unlock (&sim->lock);
+	}
+}
+
+/**
+ * Clear the operation counters for the simulated device.  The simulated time is not reset.
+ *
+ * @param sim The simulated device to update.
+ */
+void flash_master_sim_reset_stats (struct flash_master_sim *sim)
+{
+	uint64_t time_ns;
+
+	if (sim) {
+		platform_mutex_lock (&sim->lock);
+
+		time_ns = sim->stats.time_ns;
+		memset (&sim->stats, 0, sizeof (sim->stats));
+		sim->stats.time_ns = time_ns;
+
+		platform_mutex_unlock (&sim->lock);
+	}
+}
+
+/**
+ * Get direct access to the contents of the simulated flash.  This can be used to load images into
+ * flash or inspect the flash contents without executing SPI transactions.
+ *
+ * @param sim The simulated device to query.
+ *
+ * @return The flash contents or null if the device is not valid.
+ */
+uint8_t* flash_master_sim_get_memory (struct flash_master_sim *sim)
+{
+	if (sim == NULL) {
+		return NULL;
+	}
+
+	return sim->memory;
+}
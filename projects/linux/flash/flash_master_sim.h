@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_MASTER_SIM_H_
+#define FLASH_MASTER_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "platform.h"
+#include "flash/flash_master.h"
+
+
+/**
+ * Description of the flash device being simulated.
+ */
+struct flash_master_sim_device {
+	uint8_t id[3];						/**< Data returned by the RDID command. */
+	uint32_t size;						/**< Total capacity of the device, in bytes. */
+	const uint32_t *sfdp_header;		/**< SFDP header and parameter headers, starting at address 0. */
+	size_t sfdp_header_len;				/**< Length of the SFDP header data, in bytes. */
+	uint32_t sfdp_params_addr;			/**< SFDP address of the basic parameter table. */
+	const uint32_t *sfdp_params;		/**< The basic parameter table. */
+	size_t sfdp_params_len;				/**< Length of the basic parameter table, in bytes. */
+};
+
+/**
+ * Timing model used by the simulated flash.  All times are added to a virtual clock.  Busy times
+ * determine how long the device reports WIP after a write command.
+ */
+struct flash_master_sim_timing {
+	uint32_t spi_clock_hz;				/**< SPI clock frequency.  0 ignores bus transfer time. */
+	uint32_t xfer_overhead_ns;			/**< Fixed cost added to every transaction. */
+	uint32_t page_program_us;			/**< Busy time for a page program. */
+	uint32_t sector_erase_us;			/**< Busy time for a 4kB erase. */
+	uint32_t block_erase_us;			/**< Busy time for a 64kB erase. */
+	uint32_t chip_erase_ms;				/**< Busy time for a chip erase. */
+	uint32_t register_write_us;			/**< Busy time for a register write. */
+	bool real_time;						/**< Delay the caller by the simulated transaction time. */
+};
+
+/**
+ * Counters for operations executed by the simulated flash.
+ */
+struct flash_master_sim_stats {
+	uint64_t xfers;						/**< Total number of SPI transactions. */
+	uint64_t reads;						/**< Number of data read commands. */
+	uint64_t read_bytes;				/**< Number of bytes returned by read commands. */
+	uint64_t programs;					/**< Number of page program commands. */
+	uint64_t program_bytes;				/**< Number of bytes sent with page program commands. */
+	uint64_t sector_erases;				/**< Number of 4kB erase commands. */
+	uint64_t block_erases;				/**< Number of 64kB erase commands. */
+	uint64_t chip_erases;				/**< Number of chip erase commands. */
+	uint64_t status_reads;				/**< Number of status register reads. */
+	uint64_t busy_polls;				/**< Number of status reads that reported a write in progress. */
+	uint64_t ignored;					/**< Number of commands ignored by the device. */
+	uint64_t time_ns;					/**< Total simulated time, in nanoseconds. */
+};
+
+/**
+ * SPI master connected to a simulated SPI flash device.  The flash contents are stored in RAM or in
+ * a file mapped into memory.  The device responds to the standard SPI flash command set, including
+ * the write enable latch, write in progress status, and SFDP tables.
+ */
+struct flash_master_sim {
+	struct flash_master base;				/**< The base SPI master instance. */
+	struct flash_master_sim_device device;	/**< The simulated flash device. */
+	struct flash_master_sim_timing timing;	/**< Timing model for the device. */
+	struct flash_master_sim_stats stats;	/**< Operation counters. */
+	uint32_t capabilities;					/**< Capabilities reported by the SPI master. */
+	uint8_t *memory;						/**< The flash contents. */
+	int fd;									/**< File backing the flash contents, or -1. */
+	uint8_t status[3];						/**< Status registers 1 through 3. */
+	uint8_t nv_config[2];					/**< Non-volatile configuration register. */
+	bool wel;								/**< Write enable latch. */
+	bool volatile_wel;						/**< Volatile write enable for status registers. */
+	bool addr_4byte;						/**< Flag indicating the device is in 4-byte mode. */
+	bool reset_enable;						/**< Flag indicating a reset has been enabled. */
+	bool power_down;						/**< Flag indicating the device is powered down. */
+	uint64_t busy_until;					/**< Time when the current write completes. */
+	struct timespec start;					/**< Reference time for real time operation. */
+	platform_mutex lock;					/**< Synchronization for device state. */
+};
+
+
+int flash_master_sim_init (struct flash_master_sim *sim,
+	const struct flash_master_sim_device *device);
+int flash_master_sim_init_file (struct flash_master_sim *sim,
+	const struct flash_master_sim_device *device, const char *path);
+void flash_master_sim_release (struct flash_master_sim *sim);
+
+void flash_master_sim_set_timing (struct flash_master_sim *sim,
+	const struct flash_master_sim_timing *timing);
+void flash_master_sim_get_stats (struct flash_master_sim *sim,
+	struct flash_master_sim_stats *stats);
+void flash_master_sim_reset_stats (struct flash_master_sim *sim);
+
+uint8_t* flash_master_sim_get_memory (struct flash_master_sim *sim);
+
+
+/**
+ * A 32MB Winbond W25Q256JV device.
+ */
+extern const struct flash_master_sim_device FLASH_MASTER_SIM_W25Q256JV;
+
+/**
+ * Typical timing for a 50MHz SPI bus connected to a NOR flash device.
+ */
+extern const struct flash_master_sim_timing FLASH_MASTER_SIM_TIMING_TYPICAL;
+
+
+#endif /* FLASH_MASTER_SIM_H_ */
@@ -141,6 +141,28 @@ int platform_has_timeout_expired (platform_clock *timeout)
 	}
 }
 
+/**
+ * Get the amount of time that elapsed between two clock values.
+ *
+ * @param start The starting clock value.
+ * @param end The ending clock value.
+ *
+ * @return The elapsed time, in milliseconds.  If the end is before the start, 0 is returned.
+ */
+uint32_t platform_get_duration (const platform_clock *start, const platform_clock *end)
+{
+	int64_t msec;
+
+	if ((start == NULL) || (end == NULL)) {
+		return 0;
+	}
+
+	msec = ((int64_t) (end->tv_sec - start->tv_sec) * 1000) +
+		((end->tv_nsec - start->tv_nsec) / 1000000);
+
+	return (msec > 0) ? msec : 0;
+}
+
 
 #define	PLATFORM_MUTEX_ERROR(code)		ROT_ERROR (ROT_MODULE_PLATFORM_MUTEX, code)
 
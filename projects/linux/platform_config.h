@@ -51,4 +51,25 @@
 // #define MCTP_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS				1000
 
 
+/*************
+ * Flash
+ *************/
+
+/**
+ * The maximum block size read from flash when checking flash contents against expected data.  Stack
+ * usage is not a concern on Linux, so read a full sector at a time.
+ */
+#define	FLASH_DATA_CHECK_BLOCK		4096
+
+/**
+ * The implementation used to compare data read from flash.  Use vector comparisons when the
+ * compiler supports them.
+ */
+#if defined (__SSE2__)
+#define	FLASH_COMPARE_KERNEL		FLASH_COMPARE_KERNEL_SSE2
+#elif defined (__aarch64__)
+#define	FLASH_COMPARE_KERNEL		FLASH_COMPARE_KERNEL_NEON
+#endif
+
+
 #endif /* PLATFORM_CONFIG_H_ */
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "flash/spi_flash.h"
+#include "flash/flash_master_sim.h"
+
+
+/**
+ * Scope of the code exercised by a benchmark.
+ */
+enum bench_type {
+	BENCH_TYPE_MICRO = 0,				/**< A single routine on a hot path. */
+	BENCH_TYPE_MACRO,					/**< A complete operation built from many routines. */
+};
+
+/**
+ * State for a single benchmark, populated during setup.
+ */
+struct bench_state {
+	void *context;						/**< Benchmark specific context. */
+	size_t bytes;						/**< Amount of data processed by each iteration. */
+	struct flash_master_sim *sim;		/**< Simulated flash used by the benchmark, if any. */
+};
+
+/**
+ * Definition of a single benchmark.
+ */
+struct bench_case {
+	const char *name;					/**< Name of the benchmark. */
+	enum bench_type type;				/**< The type of benchmark. */
+	uint32_t iterations;				/**< Number of iterations in each sample. */
+
+	/**
+	 * Prepare the benchmark for execution.
+	 *
+	 * @param state The benchmark state to initialize.
+	 *
+	 * @return 0 if setup was successful or an error code.
+	 */
+	int (*setup) (struct bench_state *state);
+
+	/**
+	 * Execute a single iteration of the benchmark.
+	 *
+	 * @param state The benchmark state.
+	 *
+	 * @return 0 if the iteration completed successfully or an error code.
+	 */
+	int (*run) (struct bench_state *state);
+
+	/**
+	 * Release the resources used by the benchmark.
+	 *
+	 * @param state The benchmark state to release.
+	 */
+	void (*teardown) (struct bench_state *state);
+};
+
+/**
+ * A list of benchmarks.
+ */
+struct bench_list {
+	const struct bench_case *cases;		/**< The benchmarks in the list. */
+	size_t count;						/**< The number of benchmarks. */
+};
+
+
+void bench_get_crypto (struct bench_list *list);
+void bench_get_flash (struct bench_list *list);
+void bench_get_mctp (struct bench_list *list);
+
+int bench_flash_init (struct flash_master_sim *sim, struct spi_flash *flash, uint32_t size);
+void bench_flash_release (struct flash_master_sim *sim, struct spi_flash *flash);
+
+
+#endif /* BENCH_H_ */
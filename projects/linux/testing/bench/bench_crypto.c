@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "platform.h"
+#include "bench.h"
+#include "crypto/checksum.h"
+#include "crypto/hash.h"
+#include "crypto/rsa.h"
+#include "testing/engines/hash_testing_engine.h"
+#include "testing/engines/rsa_testing_engine.h"
+#include "testing/rsa_testing.h"
+#include "testing/signature_testing.h"
+
+
+/**
+ * Length of the data hashed by each iteration of the SHA-256 benchmark.
+ */
+#define	BENCH_CRYPTO_HASH_LEN		(64 * 1024)
+
+/**
+ * Length of the data used for each iteration of the CRC-8 benchmark.  This is the largest packet
+ * supported by the SMBus byte count.
+ */
+#define	BENCH_CRYPTO_CRC8_LEN		255
+
+
+/**
+ * Context for the SHA-256 benchmark.
+ */
+struct bench_crypto_hash {
+	HASH_TESTING_ENGINE engine;			/**< The hash engine being measured. */
+	uint8_t *data;						/**< The data to hash. */
+};
+
+static int bench_crypto_sha256_setup (struct bench_state *state)
+{
+	struct bench_crypto_hash *hash;
+	int status;
+	int i;
+
+	hash = platform_calloc (1, sizeof (struct bench_crypto_hash));
+	if (hash == NULL) {
+		return HASH_ENGINE_NO_MEMORY;
+	}
+
+	hash->data = platform_malloc (BENCH_CRYPTO_HASH_LEN);
+	if (hash->data == NULL) {
+		platform_free (hash);
+		return HASH_ENGINE_NO_MEMORY;
+	}
+
+	for (i = 0; i < BENCH_CRYPTO_HASH_LEN; i++) {
+		hash->data[i] = (uint8_t) (i * 13);
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&hash->engine);
+	if (status != 0) {
+		platform_free (hash->data);
+		platform_free (hash);
+		return status;
+	}
+
+	state->context = hash;
+	state->bytes = BENCH_CRYPTO_HASH_LEN;
+
+	return 0;
+}
+
+static int bench_crypto_sha256_run (struct bench_state *state)
+{
+	struct bench_crypto_hash *hash = state->context;
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	return hash->engine.base.calculate_sha256 (&hash->engine.base, hash->data,
+		BENCH_CRYPTO_HASH_LEN, digest, sizeof (digest));
+}
+
+static void bench_crypto_sha256_teardown (struct bench_state *state)
+{
+	struct bench_crypto_hash *hash = state->context;
+
+	HASH_TESTING_ENGINE_RELEASE (&hash->engine);
+	platform_free (hash->data);
+	platform_free (hash);
+}
+
+static int bench_crypto_crc8_setup (struct bench_state *state)
+{
+	uint8_t *data;
+	int i;
+
+	data = platform_malloc (BENCH_CRYPTO_CRC8_LEN);
+	if (data == NULL) {
+		return HASH_ENGINE_NO_MEMORY;
+	}
+
+	for (i = 0; i < BENCH_CRYPTO_CRC8_LEN; i++) {
+		data[i] = (uint8_t) (i * 7);
+	}
+
+	state->context = data;
+	state->bytes = BENCH_CRYPTO_CRC8_LEN;
+
+	return 0;
+}
+
+static int bench_crypto_crc8_run (struct bench_state *state)
+{
+	uint8_t *data = state->context;
+
+	data[0] = checksum_crc8 (0x2A, data, BENCH_CRYPTO_CRC8_LEN);
+
+	return 0;
+}
+
+static void bench_crypto_crc8_teardown (struct bench_state *state)
+{
+	platform_free (state->context);
+}
+
+static int bench_crypto_rsa_sig_verify_setup (struct bench_state *state)
+{
+	RSA_TESTING_ENGINE *rsa;
+	int status;
+
+	rsa = platform_calloc (1, sizeof (RSA_TESTING_ENGINE));
+	if (rsa == NULL) {
+		return RSA_ENGINE_NO_MEMORY;
+	}
+
+	status = RSA_TESTING_ENGINE_INIT (rsa);
+	if (status != 0) {
+		platform_free (rsa);
+		return status;
+	}
+
+	state->context = rsa;
+
+	return 0;
+}
+
+static int bench_crypto_rsa_sig_verify_run (struct bench_state *state)
+{
+	RSA_TESTING_ENGINE *rsa = state->context;
+
+	return rsa->base.sig_verify (&rsa->base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		SIG_HASH_TEST, SIG_HASH_LEN);
+}
+
+static int bench_crypto_rsa_sig_verify_uncached_run (struct bench_state *state)
+{
+	RSA_TESTING_ENGINE *rsa = state->context;
+
+	rsa->base.invalidate_public_key (&rsa->base, &RSA_PUBLIC_KEY);
+
+	return rsa->base.sig_verify (&rsa->base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		SIG_HASH_TEST, SIG_HASH_LEN);
+}
+
+static void bench_crypto_rsa_sig_verify_teardown (struct bench_state *state)
+{
+	RSA_TESTING_ENGINE *rsa = state->context;
+
+	RSA_TESTING_ENGINE_RELEASE (rsa);
+	platform_free (rsa);
+}
+
+
+static const struct bench_case BENCH_CRYPTO[] = {
+	{
+		.name = "hash_sha256_64k",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 200,
+		.setup = bench_crypto_sha256_setup,
+		.run = bench_crypto_sha256_run,
+		.teardown = bench_crypto_sha256_teardown
+	},
+	{
+		.name = "crc8_smbus_255",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 20000,
+		.setup = bench_crypto_crc8_setup,
+		.run = bench_crypto_crc8_run,
+		.teardown = bench_crypto_crc8_teardown
+	},
+	{
+		.name = "rsa_sig_verify",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 500,
+		.setup = bench_crypto_rsa_sig_verify_setup,
+		.run = bench_crypto_rsa_sig_verify_run,
+		.teardown = bench_crypto_rsa_sig_verify_teardown
+	},
+	{
+		.name = "rsa_sig_verify_uncached",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 500,
+		.setup = bench_crypto_rsa_sig_verify_setup,
+		.run = bench_crypto_rsa_sig_verify_uncached_run,
+		.teardown = bench_crypto_rsa_sig_verify_teardown
+	}
+};
+
+/**
+ * Get the benchmarks for cryptographic operations.
+ *
+ * @param list Output for the list of benchmarks.
+ */
+void bench_get_crypto (struct bench_list *list)
+{
+	list->cases = BENCH_CRYPTO;
+	list->count = sizeof (BENCH_CRYPTO) / sizeof (BENCH_CRYPTO[0]);
+}
@@ -0,0 +1,622 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "bench.h"
+#include "firmware/app_image.h"
+#include "flash/flash_util.h"
+#include "host_fw/host_fw_util.h"
+#include "manifest/pfm/pfm_flash.h"
+#include "testing/engines/hash_testing_engine.h"
+#include "testing/engines/rsa_testing_engine.h"
+#include "testing/rsa_testing.h"
+#include "testing/pfm_testing.h"
+
+
+/**
+ * Size of the simulated flash device used by the flash benchmarks.
+ */
+#define	BENCH_FLASH_DEVICE_SIZE			(4 * 1024 * 1024)
+
+/**
+ * Length of the data hashed by each iteration of the flash hash benchmark.
+ */
+#define	BENCH_FLASH_HASH_LEN			(1024 * 1024)
+
+/**
+ * Flash address of the PFM used by the PFM benchmarks.
+ */
+#define	BENCH_FLASH_PFM_ADDR			0x10000
+
+/**
+ * Size of each region in the host firmware image.
+ */
+#define	BENCH_FLASH_HOST_REGION_LEN		(1024 * 1024)
+
+/**
+ * Length of the header on the application image used by the image load benchmarks.
+ */
+#define	BENCH_FLASH_APP_HEADER_LEN		64
+
+/**
+ * Length of the application image data used by the image load benchmarks.
+ */
+#define	BENCH_FLASH_APP_IMAGE_LEN		(1024 * 1024)
+
+
+/**
+ * Initialize a SPI flash interface connected to a simulated flash device.  The device uses the
+ * typical timing model with a virtual clock, so the simulated flash time is deterministic.
+ *
+ * @param sim The simulated device to initialize.
+ * @param flash The flash interface to initialize.
+ * @param size Size of the simulated device.
+ *
+ * @return 0 if the flash was initialized successfully or an error code.
+ */
+int bench_flash_init (struct flash_master_sim *sim, struct spi_flash *flash, uint32_t size)
+{
+	struct flash_master_sim_device device = FLASH_MASTER_SIM_W25Q256JV;
+	int status;
+
+	device.size = size;
+
+	status = flash_master_sim_init (sim, &device);
+	if (status != 0) {
+		return status;
+	}
+
+	flash_master_sim_set_timing (sim, &FLASH_MASTER_SIM_TIMING_TYPICAL);
+
+	status = spi_flash_initialize_device (flash, &sim->base, true, false, false, false);
+	if (status != 0) {
+		flash_master_sim_release (sim);
+		return status;
+	}
+
+	return 0;
+}
+
+/**
+ * Release a SPI flash interface connected to a simulated flash device.
+ *
+ * @param sim The simulated device to release.
+ * @param flash The flash interface to release.
+ */
+void bench_flash_release (struct flash_master_sim *sim, struct spi_flash *flash)
+{
+	spi_flash_release (flash);
+	flash_master_sim_release (sim);
+}
+
+/**
+ * Fill a region of simulated flash with non-blank data.
+ *
+ * @param sim The simulated device to update.
+ * @param addr The start of the region.
+ * @param length The length of the region.
+ */
+static void bench_flash_fill (struct flash_master_sim *sim, uint32_t addr, size_t length)
+{
+	uint8_t *memory = flash_master_sim_get_memory (sim);
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		memory[addr + i] = (uint8_t) ((i * 7) + (i >> 8));
+	}
+}
+
+
+/**
+ * Context for the flash hash benchmark.
+ */
+struct bench_flash_hash {
+	struct flash_master_sim sim;		/**< The simulated flash device. */
+	struct spi_flash flash;				/**< The flash interface. */
+	HASH_TESTING_ENGINE hash;			/**< The hash engine. */
+};
+
+static int bench_flash_hash_contents_setup (struct bench_state *state)
+{
+	struct bench_flash_hash *bench;
+	int status;
+
+	bench = platform_calloc (1, sizeof (struct bench_flash_hash));
+	if (bench == NULL) {
+		return FLASH_UTIL_NO_MEMORY;
+	}
+
+	status = bench_flash_init (&bench->sim, &bench->flash, BENCH_FLASH_DEVICE_SIZE);
+	if (status != 0) {
+		goto exit_free;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&bench->hash);
+	if (status != 0) {
+		goto exit_flash;
+	}
+
+	bench_flash_fill (&bench->sim, 0, BENCH_FLASH_HASH_LEN);
+
+	state->context = bench;
+	state->bytes = BENCH_FLASH_HASH_LEN;
+	state->sim = &bench->sim;
+
+	return 0;
+
+exit_flash:
+	bench_flash_release (&bench->sim, &bench->flash);
+exit_free:
+	platform_free (bench);
+	return status;
+}
+
+static int bench_flash_hash_contents_run (struct bench_state *state)
+{
+	struct bench_flash_hash *bench = state->context;
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	return flash_hash_contents (&bench->flash.base, 0, BENCH_FLASH_HASH_LEN, &bench->hash.base,
+		HASH_TYPE_SHA256, digest, sizeof (digest));
+}
+
+static void bench_flash_hash_contents_teardown (struct bench_state *state)
+{
+	struct bench_flash_hash *bench = state->context;
+
+	HASH_TESTING_ENGINE_RELEASE (&bench->hash);
+	bench_flash_release (&bench->sim, &bench->flash);
+	platform_free (bench);
+}
+
+
+/**
+ * Context for the PFM lookup benchmarks.
+ */
+struct bench_flash_pfm {
+	struct flash_master_sim sim;		/**< The simulated flash device. */
+	struct spi_flash flash;				/**< The flash interface. */
+	struct pfm_flash pfm;				/**< The PFM being queried. */
+};
+
+/**
+ * Prepare a PFM stored on simulated flash.
+ *
+ * @param state The benchmark state to initialize.
+ * @param indexed Flag indicating the PFM should be indexed.
+ *
+ * @return 0 if setup was successful or an error code.
+ */
+static int bench_flash_pfm_setup (struct bench_state *state, bool indexed)
+{
+	struct bench_flash_pfm *bench;
+	int status;
+
+	bench = platform_calloc (1, sizeof (struct bench_flash_pfm));
+	if (bench == NULL) {
+		return PFM_NO_MEMORY;
+	}
+
+	status = bench_flash_init (&bench->sim, &bench->flash, BENCH_FLASH_DEVICE_SIZE);
+	if (status != 0) {
+		goto exit_free;
+	}
+
+	memcpy (&flash_master_sim_get_memory (&bench->sim)[BENCH_FLASH_PFM_ADDR], PFM_DATA,
+		PFM_DATA_LEN);
+
+	status = pfm_flash_init (&bench->pfm, &bench->flash, BENCH_FLASH_PFM_ADDR);
+	if (status != 0) {
+		goto exit_flash;
+	}
+
+	if (indexed) {
+		status = pfm_flash_build_index (&bench->pfm);
+		if (status != 0) {
+			goto exit_pfm;
+		}
+	}
+
+	state->context = bench;
+	state->sim = &bench->sim;
+
+	return 0;
+
+exit_pfm:
+	pfm_flash_release (&bench->pfm);
+exit_flash:
+	bench_flash_release (&bench->sim, &bench->flash);
+exit_free:
+	platform_free (bench);
+	return status;
+}
+
+static int bench_flash_pfm_lookup_setup (struct bench_state *state)
+{
+	return bench_flash_pfm_setup (state, false);
+}
+
+static int bench_flash_pfm_lookup_indexed_setup (struct bench_state *state)
+{
+	return bench_flash_pfm_setup (state, true);
+}
+
+/**
+ * Execute the queries needed to validate host flash against the PFM: find the supported versions
+ * and then get the images and read/write regions for each version.
+ *
+ * @param state The benchmark state.
+ *
+ * @return 0 if the queries completed successfully or an error code.
+ */
+static int bench_flash_pfm_lookup_run (struct bench_state *state)
+{
+	struct bench_flash_pfm *bench = state->context;
+	struct pfm *pfm = &bench->pfm.base;
+	struct pfm_firmware_versions versions;
+	struct pfm_image_list img_list;
+	struct pfm_read_write_regions writable;
+	size_t i;
+	int status;
+
+	status = pfm->get_supported_versions (pfm, &versions);
+	if (status != 0) {
+		return status;
+	}
+
+	for (i = 0; i < versions.count; i++) {
+		status = pfm->get_firmware_images (pfm, versions.versions[i].fw_version_id, &img_list);
+		if (status != 0) {
+			break;
+		}
+
+		pfm->free_firmware_images (pfm, &img_list);
+
+		status = pfm->get_read_write_regions (pfm, versions.versions[i].fw_version_id,
+			&writable);
+		if (status != 0) {
+			break;
+		}
+
+		pfm->free_read_write_regions (pfm, &writable);
+	}
+
+	pfm->free_fw_versions (pfm, &versions);
+	return status;
+}
+
+static void bench_flash_pfm_lookup_teardown (struct bench_state *state)
+{
+	struct bench_flash_pfm *bench = state->context;
+
+	pfm_flash_release (&bench->pfm);
+	bench_flash_release (&bench->sim, &bench->flash);
+	platform_free (bench);
+}
+
+
+/**
+ * Context for the host flash verification benchmarks.  The flash contains a signed image made of
+ * two regions, a read/write region between them, and unused space at the end of flash.
+ */
+struct bench_flash_host {
+	struct flash_master_sim sim;		/**< The simulated flash device. */
+	struct spi_flash flash;				/**< The flash interface. */
+	HASH_TESTING_ENGINE hash;			/**< The hash engine. */
+	RSA_TESTING_ENGINE rsa;				/**< The RSA engine. */
+	struct flash_region img_region[2];	/**< Flash regions for the signed image. */
+	struct pfm_image_signature image;	/**< The signed image. */
+	struct pfm_image_list img_list;		/**< The list of signed images. */
+	struct flash_region rw_region;		/**< The read/write flash region. */
+	struct pfm_read_write_regions writable;	/**< The list of read/write regions. */
+	struct flash_hash_pipeline pipeline;	/**< Hash pipeline for reading the flash. */
+};
+
+static int bench_flash_host_setup (struct bench_state *state)
+{
+	struct bench_flash_host *bench;
+	uint8_t *memory;
+	uint8_t *signed_data;
+	int status;
+
+	bench = platform_calloc (1, sizeof (struct bench_flash_host));
+	if (bench == NULL) {
+		return HOST_FW_UTIL_NO_MEMORY;
+	}
+
+	status = bench_flash_init (&bench->sim, &bench->flash, BENCH_FLASH_DEVICE_SIZE);
+	if (status != 0) {
+		goto exit_free;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&bench->hash);
+	if (status != 0) {
+		goto exit_flash;
+	}
+
+	status = RSA_TESTING_ENGINE_INIT (&bench->rsa);
+	if (status != 0) {
+		goto exit_hash;
+	}
+
+	status = flash_hash_pipeline_init (&bench->pipeline, &bench->flash.base, NULL,
+		FLASH_HASH_PIPELINE_MAX_CHUNK);
+	if (status != 0) {
+		goto exit_rsa;
+	}
+
+	bench->img_region[0].start_addr = 0;
+	bench->img_region[0].length = BENCH_FLASH_HOST_REGION_LEN;
+	bench->img_region[1].start_addr = BENCH_FLASH_HOST_REGION_LEN * 2;
+	bench->img_region[1].length = BENCH_FLASH_HOST_REGION_LEN;
+
+	bench->rw_region.start_addr = BENCH_FLASH_HOST_REGION_LEN;
+	bench->rw_region.length = BENCH_FLASH_HOST_REGION_LEN;
+
+	bench_flash_fill (&bench->sim, 0, BENCH_FLASH_HOST_REGION_LEN * 3);
+
+	signed_data = platform_malloc (BENCH_FLASH_HOST_REGION_LEN * 2);
+	if (signed_data == NULL) {
+		status = HOST_FW_UTIL_NO_MEMORY;
+		goto exit_pipeline;
+	}
+
+	memory = flash_master_sim_get_memory (&bench->sim);
+	memcpy (signed_data, &memory[bench->img_region[0].start_addr], BENCH_FLASH_HOST_REGION_LEN);
+	memcpy (&signed_data[BENCH_FLASH_HOST_REGION_LEN], &memory[bench->img_region[1].start_addr],
+		BENCH_FLASH_HOST_REGION_LEN);
+
+	status = RSA_TESTING_ENGINE_SIGN (signed_data, BENCH_FLASH_HOST_REGION_LEN * 2,
+		RSA_PRIVKEY_DER, RSA_PRIVKEY_DER_LEN, bench->image.signature, RSA_ENCRYPT_LEN);
+	platform_free (signed_data);
+	if (status != 0) {
+		goto exit_pipeline;
+	}
+
+	bench->image.regions = bench->img_region;
+	bench->image.count = 2;
+	bench->image.key = RSA_PUBLIC_KEY;
+	bench->image.sig_length = RSA_ENCRYPT_LEN;
+	bench->image.always_validate = 1;
+
+	bench->img_list.images = &bench->image;
+	bench->img_list.count = 1;
+
+	bench->writable.regions = &bench->rw_region;
+	bench->writable.count = 1;
+
+	state->context = bench;
+	state->bytes = BENCH_FLASH_DEVICE_SIZE;
+	state->sim = &bench->sim;
+
+	return 0;
+
+exit_pipeline:
+	flash_hash_pipeline_release (&bench->pipeline);
+exit_rsa:
+	RSA_TESTING_ENGINE_RELEASE (&bench->rsa);
+exit_hash:
+	HASH_TESTING_ENGINE_RELEASE (&bench->hash);
+exit_flash:
+	bench_flash_release (&bench->sim, &bench->flash);
+exit_free:
+	platform_free (bench);
+	return status;
+}
+
+static int bench_flash_host_verify_run (struct bench_state *state)
+{
+	struct bench_flash_host *bench = state->context;
+
+	return host_fw_full_flash_verification (&bench->flash, NULL, &bench->img_list,
+		&bench->writable, 0xff, &bench->hash.base, &bench->rsa.base);
+}
+
+static int bench_flash_host_verify_pipeline_run (struct bench_state *state)
+{
+	struct bench_flash_host *bench = state->context;
+
+	return host_fw_full_flash_verification (&bench->flash, &bench->pipeline, &bench->img_list,
+		&bench->writable, 0xff, &bench->hash.base, &bench->rsa.base);
+}
+
+static int bench_flash_host_verify_single_pass_run (struct bench_state *state)
+{
+	struct bench_flash_host *bench = state->context;
+	struct hash_engine *hash = &bench->hash.base;
+
+	return host_fw_full_flash_verification_single_pass (&bench->flash, NULL, &bench->img_list,
+		&bench->writable, 0xff, &hash, 1, &bench->rsa.base);
+}
+
+static void bench_flash_host_teardown (struct bench_state *state)
+{
+	struct bench_flash_host *bench = state->context;
+
+	flash_hash_pipeline_release (&bench->pipeline);
+	RSA_TESTING_ENGINE_RELEASE (&bench->rsa);
+	HASH_TESTING_ENGINE_RELEASE (&bench->hash);
+	bench_flash_release (&bench->sim, &bench->flash);
+	platform_free (bench);
+}
+
+
+/**
+ * Context for the application image load benchmarks.
+ */
+struct bench_flash_app_image {
+	struct flash_master_sim sim;		/**< The simulated flash device. */
+	struct spi_flash flash;				/**< The flash interface. */
+	HASH_TESTING_ENGINE hash;			/**< The hash engine. */
+	struct rsa_engine rsa;				/**< RSA engine that accepts any signature. */
+	struct rsa_public_key key;			/**< Public key for the image signature. */
+	uint8_t *data;						/**< Buffer for the loaded image. */
+};
+
+static int bench_flash_app_image_sig_verify (struct rsa_engine *engine,
+	const struct rsa_public_key *key, const uint8_t *signature, size_t sig_length,
+	const uint8_t *match, size_t match_length)
+{
+	return 0;
+}
+
+static int bench_flash_app_image_setup (struct bench_state *state)
+{
+	struct bench_flash_app_image *bench;
+	uint32_t length = BENCH_FLASH_APP_IMAGE_LEN;
+	int status;
+
+	bench = platform_calloc (1, sizeof (struct bench_flash_app_image));
+	if (bench == NULL) {
+		return APP_IMAGE_NO_MEMORY;
+	}
+
+	bench->data = platform_malloc (BENCH_FLASH_APP_IMAGE_LEN);
+	if (bench->data == NULL) {
+		status = APP_IMAGE_NO_MEMORY;
+		goto exit_free;
+	}
+
+	status = bench_flash_init (&bench->sim, &bench->flash, BENCH_FLASH_DEVICE_SIZE);
+	if (status != 0) {
+		goto exit_free;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&bench->hash);
+	if (status != 0) {
+		goto exit_flash;
+	}
+
+	bench->rsa.sig_verify = bench_flash_app_image_sig_verify;
+
+	bench_flash_fill (&bench->sim, 0,
+		BENCH_FLASH_APP_HEADER_LEN + sizeof (length) + BENCH_FLASH_APP_IMAGE_LEN +
+		APP_IMAGE_SIG_LENGTH);
+	memcpy (&flash_master_sim_get_memory (&bench->sim)[BENCH_FLASH_APP_HEADER_LEN], &length,
+		sizeof (length));
+
+	state->context = bench;
+	state->bytes = BENCH_FLASH_APP_IMAGE_LEN;
+	state->sim = &bench->sim;
+
+	return 0;
+
+exit_flash:
+	bench_flash_release (&bench->sim, &bench->flash);
+exit_free:
+	platform_free (bench->data);
+	platform_free (bench);
+	return status;
+}
+
+static int bench_flash_app_image_load_run (struct bench_state *state)
+{
+	struct bench_flash_app_image *bench = state->context;
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	return app_image_load_and_verify_with_header (&bench->flash.base, 0,
+		BENCH_FLASH_APP_HEADER_LEN, bench->data, BENCH_FLASH_APP_IMAGE_LEN, &bench->hash.base,
+		&bench->rsa, &bench->key, digest, sizeof (digest), NULL);
+}
+
+static int bench_flash_app_image_load_streaming_run (struct bench_state *state)
+{
+	struct bench_flash_app_image *bench = state->context;
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	return app_image_load_and_verify_with_header_streaming (&bench->flash.base, 0,
+		BENCH_FLASH_APP_HEADER_LEN, bench->data, BENCH_FLASH_APP_IMAGE_LEN, &bench->hash.base,
+		&bench->rsa, &bench->key, digest, sizeof (digest), NULL);
+}
+
+static void bench_flash_app_image_teardown (struct bench_state *state)
+{
+	struct bench_flash_app_image *bench = state->context;
+
+	HASH_TESTING_ENGINE_RELEASE (&bench->hash);
+	bench_flash_release (&bench->sim, &bench->flash);
+	platform_free (bench->data);
+	platform_free (bench);
+}
+
+
+static const struct bench_case BENCH_FLASH[] = {
+	{
+		.name = "flash_hash_contents_1m",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 20,
+		.setup = bench_flash_hash_contents_setup,
+		.run = bench_flash_hash_contents_run,
+		.teardown = bench_flash_hash_contents_teardown
+	},
+	{
+		.name = "pfm_flash_lookup",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 2000,
+		.setup = bench_flash_pfm_lookup_setup,
+		.run = bench_flash_pfm_lookup_run,
+		.teardown = bench_flash_pfm_lookup_teardown
+	},
+	{
+		.name = "pfm_flash_lookup_indexed",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 20000,
+		.setup = bench_flash_pfm_lookup_indexed_setup,
+		.run = bench_flash_pfm_lookup_run,
+		.teardown = bench_flash_pfm_lookup_teardown
+	},
+	{
+		.name = "host_fw_full_flash_verification",
+		.type = BENCH_TYPE_MACRO,
+		.iterations = 5,
+		.setup = bench_flash_host_setup,
+		.run = bench_flash_host_verify_run,
+		.teardown = bench_flash_host_teardown
+	},
+	{
+		.name = "host_fw_full_flash_verification_pipeline",
+		.type = BENCH_TYPE_MACRO,
+		.iterations = 5,
+		.setup = bench_flash_host_setup,
+		.run = bench_flash_host_verify_pipeline_run,
+		.teardown = bench_flash_host_teardown
+	},
+	{
+		.name = "host_fw_full_flash_verification_single_pass",
+		.type = BENCH_TYPE_MACRO,
+		.iterations = 5,
+		.setup = bench_flash_host_setup,
+		.run = bench_flash_host_verify_single_pass_run,
+		.teardown = bench_flash_host_teardown
+	},
+	{
+		.name = "app_image_load",
+		.type = BENCH_TYPE_MACRO,
+		.iterations = 10,
+		.setup = bench_flash_app_image_setup,
+		.run = bench_flash_app_image_load_run,
+		.teardown = bench_flash_app_image_teardown
+	},
+	{
+		.name = "app_image_load_streaming",
+		.type = BENCH_TYPE_MACRO,
+		.iterations = 10,
+		.setup = bench_flash_app_image_setup,
+		.run = bench_flash_app_image_load_streaming_run,
+		.teardown = bench_flash_app_image_teardown
+	}
+};
+
+/**
+ * Get the benchmarks for flash, manifest, and host firmware operations.
+ *
+ * @param list Output for the list of benchmarks.
+ */
+void bench_get_flash (struct bench_list *list)
+{
+	list->cases = BENCH_FLASH;
+	list->count = sizeof (BENCH_FLASH) / sizeof (BENCH_FLASH[0]);
+}
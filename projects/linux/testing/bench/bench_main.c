@@ -0,0 +1,573 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include "bench.h"
+
+
+/**
+ * Default number of samples collected for each benchmark.
+ */
+#define	BENCH_DEFAULT_SAMPLES		5
+
+/**
+ * Default allowed slowdown, in percent, before a benchmark is reported as a regression.
+ */
+#define	BENCH_DEFAULT_THRESHOLD		10.0
+
+/**
+ * Maximum length of a benchmark name in a baseline file.
+ */
+#define	BENCH_MAX_NAME				64
+
+/**
+ * Process exit codes.
+ */
+enum {
+	BENCH_EXIT_OK = 0,					/**< All benchmarks ran with no regressions. */
+	BENCH_EXIT_REGRESSION = 1,			/**< At least one benchmark regressed from the baseline. */
+	BENCH_EXIT_ERROR = 2,				/**< A benchmark failed or the arguments were not valid. */
+};
+
+/**
+ * Output formats for benchmark results.
+ */
+enum bench_format {
+	BENCH_FORMAT_TEXT = 0,				/**< Human readable table. */
+	BENCH_FORMAT_JSON,					/**< JSON array of results. */
+	BENCH_FORMAT_CSV,					/**< CSV table of results.  This format is used for baselines. */
+};
+
+/**
+ * Measurements for a single benchmark.  All times are per iteration.
+ */
+struct bench_result {
+	const struct bench_case *bench;		/**< The benchmark that was run. */
+	int status;							/**< Result of the benchmark execution. */
+	uint32_t samples;					/**< Number of samples collected. */
+	double mean_ns;						/**< Mean time across all samples. */
+	double min_ns;						/**< Time for the fastest sample. */
+	double max_ns;						/**< Time for the slowest sample. */
+	double mb_per_sec;					/**< Throughput of the fastest sample. */
+	double flash_ns;					/**< Simulated flash time. */
+	double flash_xfers;					/**< Number of SPI transactions. */
+};
+
+/**
+ * Measurements for a single benchmark loaded from a baseline file.
+ */
+struct bench_baseline {
+	char name[BENCH_MAX_NAME];			/**< Name of the benchmark. */
+	double min_ns;						/**< Time for the fastest sample. */
+	double flash_ns;					/**< Simulated flash time. */
+};
+
+
+/**
+ * Get the current time.
+ *
+ * @return The current monotonic time, in nanoseconds.
+ */
+static uint64_t bench_now_ns (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * Get the name of a benchmark type.
+ *
+ * @param type The benchmark type.
+ *
+ * @return The type name.
+ */
+static const char* bench_type_name (enum bench_type type)
+{
+	return (type == BENCH_TYPE_MACRO) ? "macro" : "micro";
+}
+
+/**
+ * Run a single benchmark.  One iteration is executed before measurement starts to warm caches and
+ * lazily initialized state.
+ *
+ * @param bench The benchmark to run.
+ * @param samples The number of samples to collect.
+ * @param result Output for the benchmark measurements.
+ */
+static void bench_run (const struct bench_case *bench, uint32_t samples,
+	struct bench_result *result)
+{
+	struct bench_state state;
+	struct flash_master_sim_stats start_stats;
+	struct flash_master_sim_stats end_stats;
+	uint64_t start;
+	double sample_ns;
+	double total_ns = 0;
+	uint32_t s;
+	uint32_t i;
+
+	memset (result, 0, sizeof (struct bench_result));
+	memset (&state, 0, sizeof (state));
+	memset (&start_stats, 0, sizeof (start_stats));
+	memset (&end_stats, 0, sizeof (end_stats));
+	result->bench = bench;
+
+	result->status = bench->setup (&state);
+	if (result->status != 0) {
+		return;
+	}
+
+	result->status = bench->run (&state);
+	if (result->status != 0) {
+		goto exit;
+	}
+
+	flash_master_sim_get_stats (state.sim, &start_stats);
+
+	for (s = 0; s < samples; s++) {
+		start = bench_now_ns ();
+		for (i = 0; i < bench->iterations; i++) {
+			result->status = bench->run (&state);
+			if (result->status != 0) {
+				goto exit;
+			}
+		}
+		sample_ns = (double) (bench_now_ns () - start) / bench->iterations;
+
+		if ((s == 0) || (sample_ns < result->min_ns)) {
+			result->min_ns = sample_ns;
+		}
+		if (sample_ns > result->max_ns) {
+			result->max_ns = sample_ns;
+		}
+		total_ns += sample_ns;
+	}
+
+	flash_master_sim_get_stats (state.sim, &end_stats);
+
+	result->samples = samples;
+	result->mean_ns = total_ns / samples;
+	if ((state.bytes != 0) && (result->min_ns > 0)) {
+		result->mb_per_sec = (state.bytes / (1024.0 * 1024.0)) / (result->min_ns / 1e9);
+	}
+	result->flash_ns = (double) (end_stats.time_ns - start_stats.time_ns) /
+		((double) samples * bench->iterations);
+	result->flash_xfers = (double) (end_stats.xfers - start_stats.xfers) /
+		((double) samples * bench->iterations);
+
+exit:
+	bench->teardown (&state);
+}
+
+/**
+ * Write the benchmark results.
+ *
+ * @param out The output stream.
+ * @param format The output format.
+ * @param results The results to write.
+ * @param count The number of results.
+ */
+static void bench_write_results (FILE *out, enum bench_format format,
+	const struct bench_result *results, size_t count)
+{
+	const struct bench_result *r;
+	size_t i;
+
+	switch (format) {
+		case BENCH_FORMAT_JSON:
+			fprintf (out, "[\n");
+			for (i = 0; i < count; i++) {
+				r = &results[i];
+				fprintf (out, "  {\"name\": \"%s\", \"type\": \"%s\", \"status\": %d, "
+					"\"iterations\": %u, \"samples\": %u, \"mean_ns\": %.1f, \"min_ns\": %.1f, "
+					"\"max_ns\": %.1f, \"mb_per_sec\": %.2f, \"flash_ns\": %.1f, "
+					"\"flash_xfers\": %.2f}%s\n", r->bench->name, bench_type_name (r->bench->type),
+					r->status, r->bench->iterations, r->samples, r->mean_ns, r->min_ns, r->max_ns,
+					r->mb_per_sec, r->flash_ns, r->flash_xfers, (i == (count - 1)) ? "" : ",");
+			}
+			fprintf (out, "]\n");
+			break;
+
+		case BENCH_FORMAT_CSV:
+			fprintf (out, "name,type,status,iterations,samples,mean_ns,min_ns,max_ns,mb_per_sec,"
+				"flash_ns,flash_xfers\n");
+			for (i = 0; i < count; i++) {
+				r = &results[i];
+				fprintf (out, "%s,%s,%d,%u,%u,%.1f,%.1f,%.1f,%.2f,%.1f,%.2f\n", r->bench->name,
+					bench_type_name (r->bench->type), r->status, r->bench->iterations, r->samples,
+					r->mean_ns, r->min_ns, r->max_ns, r->mb_per_sec, r->flash_ns, r->flash_xfers);
+			}
+			break;
+
+		default:
+			fprintf (out, "%-45s %-5s %12s %12s %10s %14s %10s\n", "benchmark", "type", "mean ns",
+				"min ns", "MB/s", "flash ns", "xfers");
+			for (i = 0; i < count; i++) {
+				r = &results[i];
+				if (r->status != 0) {
+					fprintf (out, "%-45s %-5s failed: 0x%x\n", r->bench->name,
+						bench_type_name (r->bench->type), r->status);
+				}
+				else {
+					fprintf (out, "%-45s %-5s %12.1f %12.1f %10.2f %14.1f %10.2f\n",
+						r->bench->name, bench_type_name (r->bench->type), r->mean_ns, r->min_ns,
+						r->mb_per_sec, r->flash_ns, r->flash_xfers);
+				}
+			}
+			break;
+	}
+}
+
+/**
+ * Load benchmark results from a baseline file.  The baseline must be in the CSV output format.
+ *
+ * @param path Path to the baseline file.
+ * @param baseline Output for the baseline entries.  This must be freed by the caller.
+ * @param count Output for the number of baseline entries.
+ *
+ * @return 0 if the baseline was loaded successfully or -1 on error.
+ */
+static int bench_load_baseline (const char *path, struct bench_baseline **baseline, size_t *count)
+{
+	struct bench_baseline entry;
+	struct bench_baseline *list = NULL;
+	struct bench_baseline *grow;
+	char line[512];
+	FILE *file;
+	size_t max = 0;
+
+	*count = 0;
+
+	file = fopen (path, "r");
+	if (file == NULL) {
+		fprintf (stderr, "Failed to open baseline %s\n", path);
+		return -1;
+	}
+
+	while (fgets (line, sizeof (line), file) != NULL) {
+		if (sscanf (line, "%63[^,],%*[^,],%*d,%*u,%*u,%*f,%lf,%*f,%*f,%lf", entry.name,
+			&entry.min_ns, &entry.flash_ns) != 3) {
+			/* Skip the header and any malformed lines. */
+			continue;
+		}
+
+		if (*count == max) {
+			max = (max == 0) ? 16 : (max * 2);
+			grow = realloc (list, max * sizeof (struct bench_baseline));
+			if (grow == NULL) {
+				free (list);
+				fclose (file);
+				return -1;
+			}
+			list = grow;
+		}
+
+		list[(*count)++] = entry;
+	}
+
+	fclose (file);
+	*baseline = list;
+	return 0;
+}
+
+/**
+ * Calculate the percent change of a measurement from the baseline.
+ *
+ * @param base The baseline measurement.
+ * @param current The current measurement.
+ *
+ * @return The change, in percent.  Positive values are slower than the baseline.
+ */
+static double bench_change (double base, double current)
+{
+	if (base <= 0) {
+		return (current > 0) ? 100.0 : 0;
+	}
+
+	return ((current - base) * 100.0) / base;
+}
+
+/**
+ * Compare benchmark results against a baseline.  Host time is compared using the fastest sample,
+ * which is the least sensitive to system noise.  Simulated flash time is deterministic, so any
+ * change in flash access patterns is reported exactly.
+ *
+ * @param out The output stream for the comparison report.
+ * @param results The current results.
+ * @param count The number of results.
+ * @param baseline The baseline results.
+ * @param base_count The number of baseline results.
+ * @param threshold The allowed slowdown, in percent.
+ *
+ * @return true if any benchmark regressed from the baseline.
+ */
+static bool bench_compare (FILE *out, const struct bench_result *results, size_t count,
+	const struct bench_baseline *baseline, size_t base_count, double threshold)
+{
+	const struct bench_baseline *base;
+	const char *verdict;
+	double host_change;
+	double flash_change;
+	bool regressed = false;
+	size_t i;
+	size_t j;
+
+	fprintf (out, "\n%-45s %12s %12s %9s %14s %14s %9s  %s\n", "benchmark", "base min ns",
+		"min ns", "change", "base flash ns", "flash ns", "change", "result");
+
+	for (i = 0; i < count; i++) {
+		if (results[i].status != 0) {
+			continue;
+		}
+
+		base = NULL;
+		for (j = 0; j < base_count; j++) {
+			if (strcmp (baseline[j].name, results[i].bench->name) == 0) {
+				base = &baseline[j];
+				break;
+			}
+		}
+
+		if (base == NULL) {
+			fprintf (out, "%-45s %12s %12.1f %9s %14s %14.1f %9s  new\n", results[i].bench->name,
+				"-", results[i].min_ns, "-", "-", results[i].flash_ns, "-");
+			continue;
+		}
+
+		host_change = bench_change (base->min_ns, results[i].min_ns);
+		flash_change = bench_change (base->flash_ns, results[i].flash_ns);
+
+		if ((host_change > threshold) || (flash_change > threshold)) {
+			verdict = "REGRESSED";
+			regressed = true;
+		}
+		else if ((host_change < -threshold) || (flash_change < -threshold)) {
+			verdict = "improved";
+		}
+		else {
+			verdict = "ok";
+		}
+
+		fprintf (out, "%-45s %12.1f %12.1f %8.1f%% %14.1f %14.1f %8.1f%%  %s\n",
+			results[i].bench->name, base->min_ns, results[i].min_ns, host_change, base->flash_ns,
+			results[i].flash_ns, flash_change, verdict);
+	}
+
+	return regressed;
+}
+
+/**
+ * Determine if a benchmark was selected to run.
+ *
+ * @param name Name of the benchmark.
+ * @param filters Substrings to match against benchmark names.
+ * @param filter_count The number of filters.  If there are no filters, all benchmarks are run.
+ *
+ * @return true if the benchmark should be run.
+ */
+static bool bench_is_selected (const char *name, char *const *filters, int filter_count)
+{
+	int i;
+
+	if (filter_count == 0) {
+		return true;
+	}
+
+	for (i = 0; i < filter_count; i++) {
+		if (strstr (name, filters[i]) != NULL) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Print the command usage.
+ *
+ * @param name Name of the executable.
+ */
+static void bench_usage (const char *name)
+{
+	printf ("Usage: %s [options] [benchmark ...]\n\n", name);
+	printf ("Run benchmarks whose names contain any of the given strings, or all benchmarks.\n\n");
+	printf ("  -f, --format FMT     Output format: text, json, or csv.  Default: text\n");
+	printf ("  -o, --output FILE    Write results to a file instead of stdout.\n");
+	printf ("  -b, --baseline FILE  Compare results against a baseline generated with -f csv.\n");
+	printf ("  -t, --threshold PCT  Allowed slowdown from the baseline.  Default: %.0f\n",
+		BENCH_DEFAULT_THRESHOLD);
+	printf ("  -s, --samples N      Number of samples for each benchmark.  Default: %d\n",
+		BENCH_DEFAULT_SAMPLES);
+	printf ("  -l, --list           List the available benchmarks.\n");
+	printf ("  -h, --help           Show this message.\n\n");
+	printf ("Exit status is %d if a benchmark regressed from the baseline and %d on errors.\n",
+		BENCH_EXIT_REGRESSION, BENCH_EXIT_ERROR);
+}
+
+int main (int argc, char *argv[])
+{
+	static const struct option options[] = {
+		{"format", required_argument, NULL, 'f'},
+		{"output", required_argument, NULL, 'o'},
+		{"baseline", required_argument, NULL, 'b'},
+		{"threshold", required_argument, NULL, 't'},
+		{"samples", required_argument, NULL, 's'},
+		{"list", no_argument, NULL, 'l'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+	void (*const groups[]) (struct bench_list*) = {
+		bench_get_crypto,
+		bench_get_flash,
+		bench_get_mctp
+	};
+	enum bench_format format = BENCH_FORMAT_TEXT;
+	const char *output = NULL;
+	const char *baseline_path = NULL;
+	double threshold = BENCH_DEFAULT_THRESHOLD;
+	int samples = BENCH_DEFAULT_SAMPLES;
+	bool list_only = false;
+	struct bench_list list;
+	struct bench_result *results;
+	struct bench_baseline *baseline = NULL;
+	size_t base_count = 0;
+	size_t count = 0;
+	size_t max = 0;
+	FILE *out = stdout;
+	int exit_code = BENCH_EXIT_OK;
+	size_t g;
+	size_t i;
+	int opt;
+
+	while ((opt = getopt_long (argc, argv, "f:o:b:t:s:lh", options, NULL)) != -1) {
+		switch (opt) {
+			case 'f':
+				if (strcmp (optarg, "text") == 0) {
+					format = BENCH_FORMAT_TEXT;
+				}
+				else if (strcmp (optarg, "json") == 0) {
+					format = BENCH_FORMAT_JSON;
+				}
+				else if (strcmp (optarg, "csv") == 0) {
+					format = BENCH_FORMAT_CSV;
+				}
+				else {
+					fprintf (stderr, "Unknown format: %s\n", optarg);
+					return BENCH_EXIT_ERROR;
+				}
+				break;
+
+			case 'o':
+				output = optarg;
+				break;
+
+			case 'b':
+				baseline_path = optarg;
+				break;
+
+			case 't':
+				threshold = atof (optarg);
+				break;
+
+			case 's':
+				samples = atoi (optarg);
+				if (samples <= 0) {
+					fprintf (stderr, "Invalid sample count: %s\n", optarg);
+					return BENCH_EXIT_ERROR;
+				}
+				break;
+
+			case 'l':
+				list_only = true;
+				break;
+
+			case 'h':
+				bench_usage (argv[0]);
+				return BENCH_EXIT_OK;
+
+			default:
+				bench_usage (argv[0]);
+				return BENCH_EXIT_ERROR;
+		}
+	}
+
+	for (g = 0; g < (sizeof (groups) / sizeof (groups[0])); g++) {
+		groups[g] (&list);
+		max += list.count;
+	}
+
+	if (list_only) {
+		for (g = 0; g < (sizeof (groups) / sizeof (groups[0])); g++) {
+			groups[g] (&list);
+			for (i = 0; i < list.count; i++) {
+				printf ("%-45s %s\n", list.cases[i].name, bench_type_name (list.cases[i].type));
+			}
+		}
+
+		return BENCH_EXIT_OK;
+	}
+
+	if (baseline_path && (bench_load_baseline (baseline_path, &baseline, &base_count) != 0)) {
+		return BENCH_EXIT_ERROR;
+	}
+
+	results = calloc (max, sizeof (struct bench_result));
+	if (results == NULL) {
+		free (baseline);
+		return BENCH_EXIT_ERROR;
+	}
+
+	for (g = 0; g < (sizeof (groups) / sizeof (groups[0])); g++) {
+		groups[g] (&list);
+		for (i = 0; i < list.count; i++) {
+			if (bench_is_selected (list.cases[i].name, &argv[optind], argc - optind)) {
+				if (format == BENCH_FORMAT_TEXT) {
+					fprintf (stderr, "Running %s...\n", list.cases[i].name);
+				}
+
+				bench_run (&list.cases[i], samples, &results[count]);
+				if (results[count].status != 0) {
+					exit_code = BENCH_EXIT_ERROR;
+				}
+				count++;
+			}
+		}
+	}
+
+	if (output) {
+		out = fopen (output, "w");
+		if (out == NULL) {
+			fprintf (stderr, "Failed to open output %s\n", output);
+			free (results);
+			free (baseline);
+			return BENCH_EXIT_ERROR;
+		}
+	}
+
+	bench_write_results (out, format, results, count);
+
+	if (output) {
+		fclose (out);
+	}
+
+	if (baseline) {
+		/* Keep machine readable output on stdout free of the comparison report. */
+		out = ((format == BENCH_FORMAT_TEXT) || output) ? stdout : stderr;
+		if (bench_compare (out, results, count, baseline, base_count, threshold) &&
+			(exit_code == BENCH_EXIT_OK)) {
+			exit_code = BENCH_EXIT_REGRESSION;
+		}
+	}
+
+	free (results);
+	free (baseline);
+	return exit_code;
+}
@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "bench.h"
+#include "crypto/checksum.h"
+#include "mctp/mctp_interface.h"
+#include "mctp/mctp_protocol.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "cmd_interface/device_manager.h"
+
+
+/**
+ * Length of the response generated for each request.  This requires multiple response packets.
+ */
+#define	BENCH_MCTP_RESPONSE_LEN		1024
+
+
+/**
+ * Context for the MCTP benchmarks.
+ */
+struct bench_mctp {
+	struct cmd_interface cmd;			/**< Command handler that generates a fixed response. */
+	struct device_manager device_mgr;	/**< Device manager for the MCTP interface. */
+	struct mctp_interface mctp;			/**< The MCTP interface being measured. */
+	struct cmd_packet rx;				/**< The request packet to process. */
+	struct cmd_packet tx;				/**< Buffer for in place response packets. */
+};
+
+static int bench_mctp_process_request (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	request->data[1] = 0x12;
+	memset (&request->data[2], 0x55, BENCH_MCTP_RESPONSE_LEN - 2);
+	request->length = BENCH_MCTP_RESPONSE_LEN;
+	request->new_request = false;
+	request->crypto_timeout = false;
+
+	return 0;
+}
+
+static int bench_mctp_setup (struct bench_state *state)
+{
+	struct bench_mctp *bench;
+	struct device_manager_full_capabilities capabilities;
+	struct mctp_protocol_transport_header *header;
+	int status;
+	int i;
+
+	bench = platform_calloc (1, sizeof (struct bench_mctp));
+	if (bench == NULL) {
+		return MCTP_PROTOCOL_NO_MEMORY;
+	}
+
+	bench->cmd.process_request = bench_mctp_process_request;
+
+	status = device_manager_init (&bench->device_mgr, 2, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	if (status != 0) {
+		goto exit_free;
+	}
+
+	status = device_manager_update_device_entry (&bench->device_mgr, 0, DEVICE_MANAGER_SELF,
+		MCTP_PROTOCOL_PA_ROT_CTRL_EID, 0);
+	if (status != 0) {
+		goto exit_device_mgr;
+	}
+
+	status = device_manager_update_device_entry (&bench->device_mgr, 1, DEVICE_MANAGER_UPSTREAM,
+		MCTP_PROTOCOL_BMC_EID, 0);
+	if (status != 0) {
+		goto exit_device_mgr;
+	}
+
+	device_manager_get_device_capabilities (&bench->device_mgr, 0, &capabilities);
+	capabilities.request.hierarchy_role = DEVICE_MANAGER_PA_ROT_MODE;
+
+	status = device_manager_update_device_capabilities (&bench->device_mgr, 0, &capabilities);
+	if (status != 0) {
+		goto exit_device_mgr;
+	}
+
+	status = mctp_interface_init (&bench->mctp, &bench->cmd, &bench->device_mgr,
+		MCTP_PROTOCOL_PA_ROT_CTRL_EID, CERBERUS_PROTOCOL_MSFT_PCI_VID,
+		CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	if (status != 0) {
+		goto exit_device_mgr;
+	}
+
+	header = (struct mctp_protocol_transport_header*) bench->rx.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	bench->rx.data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 8; i < 17; i++) {
+		bench->rx.data[i] = i - 8;
+	}
+	bench->rx.data[17] = checksum_crc8 (0xBA, bench->rx.data, 17);
+	bench->rx.pkt_size = 18;
+	bench->rx.dest_addr = 0x5D;
+
+	state->context = bench;
+	state->bytes = BENCH_MCTP_RESPONSE_LEN;
+
+	return 0;
+
+exit_device_mgr:
+	device_manager_release (&bench->device_mgr);
+exit_free:
+	platform_free (bench);
+	return status;
+}
+
+static int bench_mctp_process_packet_run (struct bench_state *state)
+{
+	struct bench_mctp *bench = state->context;
+	struct cmd_packet *packets;
+	size_t num_packets;
+	int status;
+
+	status = mctp_interface_process_packet (&bench->mctp, &bench->rx, &packets, &num_packets);
+	if ((status == 0) && (num_packets != 0)) {
+		platform_free (packets);
+	}
+
+	return status;
+}
+
+static int bench_mctp_process_packet_in_place_run (struct bench_state *state)
+{
+	struct bench_mctp *bench = state->context;
+	size_t num_packets;
+	size_t i;
+	int status;
+
+	status = mctp_interface_process_packet_in_place (&bench->mctp, &bench->rx, &num_packets);
+	for (i = 0; (status == 0) && (i < num_packets); i++) {
+		status = mctp_interface_get_response_packet (&bench->mctp, i, &bench->tx);
+	}
+
+	return status;
+}
+
+static void bench_mctp_teardown (struct bench_state *state)
+{
+	struct bench_mctp *bench = state->context;
+
+	mctp_interface_deinit (&bench->mctp);
+	device_manager_release (&bench->device_mgr);
+	platform_free (bench);
+}
+
+
+static const struct bench_case BENCH_MCTP[] = {
+	{
+		.name = "mctp_interface_process_packet",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 20000,
+		.setup = bench_mctp_setup,
+		.run = bench_mctp_process_packet_run,
+		.teardown = bench_mctp_teardown
+	},
+	{
+		.name = "mctp_interface_process_packet_in_place",
+		.type = BENCH_TYPE_MICRO,
+		.iterations = 20000,
+		.setup = bench_mctp_setup,
+		.run = bench_mctp_process_packet_in_place_run,
+		.teardown = bench_mctp_teardown
+	}
+};
+
+/**
+ * Get the benchmarks for MCTP message processing.
+ *
+ * @param list Output for the list of benchmarks.
+ */
+void bench_get_mctp (struct bench_list *list)
+{
+	list->cases = BENCH_MCTP;
+	list->count = sizeof (BENCH_MCTP) / sizeof (BENCH_MCTP[0]);
+}
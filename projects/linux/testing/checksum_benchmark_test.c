@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "crypto/checksum.h"
+
+
+static const char *SUITE = "checksum_benchmark";
+
+
+/**
+ * Number of packets to checksum with each implementation.
+ */
+#define	CHECKSUM_BENCHMARK_ITERATIONS		20000
+
+/**
+ * Length of each packet.  This is the largest packet supported by the SMBus byte count.
+ */
+#define	CHECKSUM_BENCHMARK_PACKET_LEN		255
+
+
+/**
+ * Bit-wise CRC8 calculation used prior to the table-driven implementation.
+ *
+ * @param smbus_addr SMBUS address to prepend to buffer before computation
+ * @param data Data buffer to use for CRC calculation
+ * @param len Length of data buffer
+ *
+ * @return CRC8 value
+ */
+static uint8_t checksum_benchmark_crc8_bitwise (uint8_t smbus_addr, const uint8_t *data,
+	uint8_t len)
+{
+	uint8_t i;
+	uint8_t j;
+	uint8_t crc = smbus_addr;
+
+	for (j = 0; j < 8; ++j) {
+		crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+	}
+
+	for (i = 0; i < len; ++i) {
+		crc ^= data[i];
+
+		for (j = 0; j < 8; ++j) {
+			crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+/*******************
+ * Test cases
+ *******************/
+
+static void checksum_benchmark_test_crc8 (CuTest *test)
+{
+	uint8_t packet[CHECKSUM_BENCHMARK_PACKET_LEN];
+	uint8_t bitwise_crc;
+	uint8_t table_crc;
+	int i;
+	int len;
+
+	TEST_START;
+
+	for (i = 0; i < CHECKSUM_BENCHMARK_PACKET_LEN; i++) {
+		packet[i] = (uint8_t) (i * 7);
+	}
+
+	for (i = 0; i < CHECKSUM_BENCHMARK_ITERATIONS; i++) {
+		packet[0] = (uint8_t) i;
+		len = (i % CHECKSUM_BENCHMARK_PACKET_LEN) + 1;
+
+		bitwise_crc = checksum_benchmark_crc8_bitwise ((uint8_t) (i >> 8), packet, len);
+		table_crc = checksum_crc8 ((uint8_t) (i >> 8), packet, len);
+		CuAssertIntEquals (test, bitwise_crc, table_crc);
+	}
+}
+
+
+CuSuite* get_checksum_benchmark_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, checksum_benchmark_test_crc8);
+
+	return suite;
+}
@@ -12,10 +12,13 @@
 #define	TESTING_RUN_HASH_SUITE
 #define	TESTING_RUN_RSA_MBEDTLS_SUITE
 #define	TESTING_RUN_FLASH_UTIL_SUITE
+#define	TESTING_RUN_FLASH_COMPARE_SUITE
 #define	TESTING_RUN_APP_IMAGE_SUITE
 #define	TESTING_RUN_FIRMWARE_UPDATE_SUITE
 #define	TESTING_RUN_HOST_FW_UTIL_SUITE
+#define	TESTING_RUN_HOST_FW_VERIFICATION_CACHE_SUITE
 #define	TESTING_RUN_MANIFEST_FLASH_SUITE
+#define	TESTING_RUN_MANIFEST_ARENA_SUITE
 #define	TESTING_RUN_PFM_FLASH_SUITE
 #define	TESTING_RUN_CFM_FLASH_SUITE
 #define	TESTING_RUN_CERBERUS_PROTOCOL_REQUIRED_COMMANDS_SUITE
@@ -56,6 +59,7 @@
 #define	TESTING_RUN_SPI_FILTER_IRQ_HANDLER_DIRTY_SUITE
 #define	TESTING_RUN_HOST_IRQ_HANDLER_PFM_CHECK_SUITE
 #define	TESTING_RUN_ATTESTATION_MASTER_SUITE
+#define	TESTING_RUN_ATTESTATION_SCHEDULER_SUITE
 #define	TESTING_RUN_ATTESTATION_SLAVE_SUITE
 #define	TESTING_RUN_RNG_MBEDTLS_SUITE
 #define	TESTING_RUN_DEVICE_MANAGER_SUITE
@@ -71,6 +75,7 @@
 #define	TESTING_RUN_CFM_MANAGER_SUITE
 #define	TESTING_RUN_PFM_OBSERVER_PENDING_RESET_SUITE
 #define	TESTING_RUN_PFM_OBSERVER_PCR_SUITE
+#define	TESTING_RUN_PFM_OBSERVER_INDEX_SUITE
 #define	TESTING_RUN_CFM_OBSERVER_PCR_SUITE
 #define	TESTING_RUN_SIGNATURE_VERIFICATION_RSA_SUITE
 #define	TESTING_RUN_SIGNATURE_VERIFICATION_ECC_SUITE
@@ -85,9 +90,11 @@
 #define	TESTING_RUN_SPI_FILTER_SUITE
 #define	TESTING_RUN_IMAGE_HEADER_SUITE
 #define	TESTING_RUN_CMD_CHANNEL_SUITE
+#define	TESTING_RUN_CMD_ASYNC_SUITE
 #define	TESTING_RUN_FIRMWARE_COMPONENT_SUITE
 #define	TESTING_RUN_FLASH_UPDATER_SUITE
 #define	TESTING_RUN_TPM_SUITE
+#define	TESTING_RUN_TPM_NV_LOG_SUITE
 #define	TESTING_RUN_AUTHORIZATION_ALLOWED_SUITE
 #define	TESTING_RUN_AUTHORIZATION_DISALLOWED_SUITE
 #define	TESTING_RUN_AUTHORIZATION_CHALLENGE_SUITE
@@ -112,6 +119,8 @@
 #define	TESTING_RUN_AES_OPENSSL_SUITE
 #define	TESTING_RUN_BASE64_OPENSSL_SUITE
 #define	TESTING_RUN_RNG_OPENSSL_SUITE
+#define	TESTING_RUN_CHECKSUM_BENCHMARK_SUITE
+#define	TESTING_RUN_FLASH_MASTER_SIM_SUITE
 
 
 #include "testing/linux_all_tests.h"
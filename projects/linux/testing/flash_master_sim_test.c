@@ -0,0 +1,972 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "testing.h"
+#include "flash/flash_master_sim.h"
+#include "flash/flash_common.h"
+#include "flash/spi_flash.h"
+
+
+static const char *SUITE = "flash_master_sim";
+
+
+/**
+ * Create a unique file name to use for file-backed flash.
+ *
+ * @param test The test framework.
+ * @param path Buffer for the file name.
+ */
+static void flash_master_sim_testing_temp_file (CuTest *test, char *path)
+{
+	int fd;
+
+	strcpy (path, "/tmp/flash_master_sim_XXXXXX");
+	fd = mkstemp (path);
+	CuAssertTrue (test, (fd >= 0));
+
+	close (fd);
+}
+
+/**
+ * Initialize a SPI flash interface for the simulated device.
+ *
+ * @param test The test framework.
+ * @param sim The simulated device.
+ * @param flash The flash interface to initialize.
+ */
+static void flash_master_sim_testing_init_spi_flash (CuTest *test, struct flash_master_sim *sim,
+	struct spi_flash *flash)
+{
+	int status;
+
+	status = spi_flash_initialize_device (flash, &sim->base, false, false, false, false);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_master_sim_test_init (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_stats stats;
+	uint8_t *memory;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, sim.base.xfer);
+	CuAssertPtrNotNull (test, sim.base.capabilities);
+
+	memory = flash_master_sim_get_memory (&sim);
+	CuAssertPtrNotNull (test, memory);
+	CuAssertIntEquals (test, 0xff, memory[0]);
+	CuAssertIntEquals (test, 0xff, memory[FLASH_MASTER_SIM_W25Q256JV.size - 1]);
+
+	status = sim.base.capabilities (&sim.base);
+	CuAssertIntEquals (test, FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR, status);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 0, stats.xfers);
+	CuAssertIntEquals (test, 0, stats.time_ns);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_init_null (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_device device = FLASH_MASTER_SIM_W25Q256JV;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (NULL, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+
+	status = flash_master_sim_init (&sim, NULL);
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+
+	device.size = 0;
+	status = flash_master_sim_init (&sim, &device);
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+}
+
+static void flash_master_sim_test_init_file (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_device device = FLASH_MASTER_SIM_W25Q256JV;
+	struct spi_flash flash;
+	char path[64];
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read[sizeof (data)];
+	uint8_t *memory;
+	int status;
+
+	TEST_START;
+
+	flash_master_sim_testing_temp_file (test, path);
+	device.size = 0x100000;
+
+	status = flash_master_sim_init_file (&sim, &device, path);
+	CuAssertIntEquals (test, 0, status);
+
+	memory = flash_master_sim_get_memory (&sim);
+	CuAssertPtrNotNull (test, memory);
+	CuAssertIntEquals (test, 0xff, memory[0]);
+	CuAssertIntEquals (test, 0xff, memory[device.size - 1]);
+
+	flash_master_sim_testing_init_spi_flash (test, &sim, &flash);
+
+	status = spi_flash_write (&flash, 0x1000, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	spi_flash_release (&flash);
+	flash_master_sim_release (&sim);
+
+	status = flash_master_sim_init_file (&sim, &device, path);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_testing_init_spi_flash (test, &sim, &flash);
+
+	status = spi_flash_read (&flash, 0x1000, read, sizeof (read));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, read, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	flash_master_sim_release (&sim);
+	unlink (path);
+}
+
+static void flash_master_sim_test_init_file_null (CuTest *test)
+{
+	struct flash_master_sim sim;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init_file (NULL, &FLASH_MASTER_SIM_W25Q256JV, "/tmp/flash");
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+
+	status = flash_master_sim_init_file (&sim, NULL, "/tmp/flash");
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+
+	status = flash_master_sim_init_file (&sim, &FLASH_MASTER_SIM_W25Q256JV, NULL);
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+}
+
+static void flash_master_sim_test_init_file_open_error (CuTest *test)
+{
+	struct flash_master_sim sim;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init_file (&sim, &FLASH_MASTER_SIM_W25Q256JV,
+		"/tmp/flash_master_sim_no_dir/flash");
+	CuAssertIntEquals (test, FLASH_MASTER_HW_NOT_INIT, status);
+}
+
+static void flash_master_sim_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_master_sim_release (NULL);
+}
+
+static void flash_master_sim_test_spi_flash_initialize_device (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct spi_flash flash;
+	uint8_t vendor;
+	uint16_t device;
+	uint32_t bytes;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_testing_init_spi_flash (test, &sim, &flash);
+
+	status = spi_flash_get_device_id (&flash, &vendor, &device);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0xef, vendor);
+	CuAssertIntEquals (test, 0x4019, device);
+
+	status = spi_flash_get_device_size (&flash, &bytes);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x2000000, bytes);
+
+	status = spi_flash_is_4byte_address_mode (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_is_quad_spi_enabled (&flash);
+	CuAssertIntEquals (test, 1, status);
+
+	spi_flash_release (&flash);
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_spi_flash_initialize_device_size (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_device device = FLASH_MASTER_SIM_W25Q256JV;
+	struct spi_flash flash;
+	uint32_t bytes;
+	int status;
+
+	TEST_START;
+
+	device.size = 0x400000;
+
+	status = flash_master_sim_init (&sim, &device);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_testing_init_spi_flash (test, &sim, &flash);
+
+	status = spi_flash_get_device_size (&flash, &bytes);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x400000, bytes);
+
+	spi_flash_release (&flash);
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_spi_flash_4byte_address_mode (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct spi_flash flash;
+	uint8_t data[] = {0x11, 0x22, 0x33, 0x44};
+	uint8_t read[sizeof (data)];
+	uint8_t *memory;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_testing_init_spi_flash (test, &sim, &flash);
+
+	status = spi_flash_enable_4byte_address_mode (&flash, 1);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, sim.addr_4byte);
+
+	status = spi_flash_detect_4byte_address_mode (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_is_4byte_address_mode (&flash);
+	CuAssertIntEquals (test, 1, status);
+
+	status = spi_flash_write (&flash, 0x1234500, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	memory = flash_master_sim_get_memory (&sim);
+	status = testing_validate_array (data, &memory[0x1234500], sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234500, read, sizeof (read));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, read, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_spi_flash_write_read_erase (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_stats stats;
+	struct spi_flash flash;
+	uint8_t data[512];
+	uint8_t read[sizeof (data)];
+	uint8_t erased[sizeof (data)];
+	int status;
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+	memset (erased, 0xff, sizeof (erased));
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_testing_init_spi_flash (test, &sim, &flash);
+	flash_master_sim_reset_stats (&sim);
+
+	status = spi_flash_write (&flash, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = spi_flash_read (&flash, 0x10000, read, sizeof (read));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, read, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 2, stats.programs);
+	CuAssertIntEquals (test, sizeof (data), stats.program_bytes);
+	CuAssertIntEquals (test, 1, stats.reads);
+	CuAssertIntEquals (test, sizeof (data), stats.read_bytes);
+	CuAssertIntEquals (test, 0, stats.ignored);
+
+	status = spi_flash_sector_erase (&flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x10000, read, sizeof (read));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (erased, read, sizeof (read));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1f000, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = spi_flash_block_erase (&flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1f000, read, sizeof (read));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (erased, read, sizeof (read));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1ffff00, data, sizeof (data) / 2);
+	CuAssertIntEquals (test, sizeof (data) / 2, status);
+
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1ffff00, read, sizeof (read) / 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (erased, read, sizeof (read) / 2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 1, stats.sector_erases);
+	CuAssertIntEquals (test, 1, stats.block_erases);
+	CuAssertIntEquals (test, 1, stats.chip_erases);
+	CuAssertIntEquals (test, 0, stats.ignored);
+
+	spi_flash_release (&flash);
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_xfer_null (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WREN, 0);
+	status = sim.base.xfer (NULL, &xfer);
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+
+	status = sim.base.xfer (&sim.base, NULL);
+	CuAssertIntEquals (test, FLASH_MASTER_INVALID_ARGUMENT, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_READ, 0, 0, 0, NULL, 16, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, FLASH_MASTER_NO_XFER_DATA, status);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_xfer_unsupported (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	uint8_t data[16];
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	sim.capabilities = FLASH_CAP_DUAL_1_1_2 | FLASH_CAP_3BYTE_ADDR;
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_QUAD_READ, 0, 1, 0, data, sizeof (data),
+		FLASH_FLAG_QUAD_DATA);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, FLASH_MASTER_UNSUPPORTED_XFER, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_4BYTE_READ, 0, 0, 0, data, sizeof (data),
+		FLASH_FLAG_4BYTE_ADDRESS);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, FLASH_MASTER_UNSUPPORTED_XFER, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_DUAL_READ, 0, 1, 0, data, sizeof (data),
+		FLASH_FLAG_DUAL_DATA);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_program_only_clears_bits (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	uint8_t first[] = {0x0f, 0xf0, 0x55};
+	uint8_t second[] = {0xf0, 0xf0, 0xff};
+	uint8_t *memory;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WREN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_WRITE (xfer, FLASH_CMD_PP, 0x100, 0, first, sizeof (first), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WREN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_WRITE (xfer, FLASH_CMD_PP, 0x100, 0, second, sizeof (second), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	memory = flash_master_sim_get_memory (&sim);
+	CuAssertIntEquals (test, 0x00, memory[0x100]);
+	CuAssertIntEquals (test, 0xf0, memory[0x101]);
+	CuAssertIntEquals (test, 0x55, memory[0x102]);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_program_page_wrap (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t *memory;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WREN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_WRITE (xfer, FLASH_CMD_PP, 0x1fe, 0, data, sizeof (data), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	memory = flash_master_sim_get_memory (&sim);
+	CuAssertIntEquals (test, 0x01, memory[0x1fe]);
+	CuAssertIntEquals (test, 0x02, memory[0x1ff]);
+	CuAssertIntEquals (test, 0x03, memory[0x100]);
+	CuAssertIntEquals (test, 0x04, memory[0x101]);
+	CuAssertIntEquals (test, 0xff, memory[0x200]);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_write_without_write_enable (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_stats stats;
+	struct flash_xfer xfer;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t *memory;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	memory = flash_master_sim_get_memory (&sim);
+	memset (memory, 0, 0x1000);
+
+	FLASH_XFER_INIT_WRITE (xfer, FLASH_CMD_PP, 0x1000, 0, data, sizeof (data), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_NO_DATA (xfer, FLASH_CMD_4K_ERASE, 0, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WREN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WRDI, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_CE, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0xff, memory[0x1000]);
+	CuAssertIntEquals (test, 0x00, memory[0]);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 5, stats.xfers);
+	CuAssertIntEquals (test, 3, stats.ignored);
+	CuAssertIntEquals (test, 0, stats.programs);
+	CuAssertIntEquals (test, 0, stats.sector_erases);
+	CuAssertIntEquals (test, 0, stats.chip_erases);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_address_mode_mismatch (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	uint8_t data[4];
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_READ, 0, 0, 0, data, sizeof (data),
+		FLASH_FLAG_4BYTE_ADDRESS);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_4BYTE_READ, 0, 0, 0, data, sizeof (data), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_EN4B, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_READ, 0, 0, 0, data, sizeof (data), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_READ, 0, 0, 0, data, sizeof (data),
+		FLASH_FLAG_4BYTE_ADDRESS);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_read_sfdp (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	uint8_t header[8];
+	uint8_t density[4];
+	uint8_t unused[4];
+	uint8_t expected_header[] = {0x53, 0x46, 0x44, 0x50, 0x05, 0x01, 0x00, 0xff};
+	uint8_t expected_density[] = {0xff, 0xff, 0xff, 0x0f};
+	uint8_t expected_unused[] = {0xff, 0xff, 0xff, 0xff};
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_SFDP, 0, 1, 0, header, sizeof (header), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected_header, header, sizeof (header));
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_SFDP, 0x84, 1, 0, density, sizeof (density), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected_density, density, sizeof (density));
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_SFDP, 0x40, 1, 0, unused, sizeof (unused), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected_unused, unused, sizeof (unused));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_status_4byte_mode (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	uint8_t reg;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR3, &reg, 1, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x00, reg);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_EN4B, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR3, &reg, 1, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x01, reg);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR_FLAG, &reg, 1, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x81, reg);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_EX4B, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR3, &reg, 1, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x00, reg);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_write_status_register (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	uint8_t write[] = {0xff, 0x02};
+	uint8_t reg[2];
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_WRITE_REG (xfer, FLASH_CMD_WRSR, write, sizeof (write), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR, reg, sizeof (reg), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x00, reg[0]);
+	CuAssertIntEquals (test, 0x00, reg[1]);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_VOLATILE_WREN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_WRITE_REG (xfer, FLASH_CMD_WRSR, write, sizeof (write), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR, reg, sizeof (reg), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0xfc, reg[0]);
+	CuAssertIntEquals (test, 0x02, reg[1]);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR2, reg, 1, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x02, reg[0]);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_power_down (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_stats stats;
+	struct flash_xfer xfer;
+	uint8_t id[3];
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_DP, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (id, 0, sizeof (id));
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDID, id, sizeof (id), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, id[0]);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_RDP, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDID, id, sizeof (id), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0xef, id[0]);
+	CuAssertIntEquals (test, 0x40, id[1]);
+	CuAssertIntEquals (test, 0x19, id[2]);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 1, stats.ignored);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_reset (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_xfer xfer;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_EN4B, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_RST, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, sim.addr_4byte);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_RSTEN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_RST, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, sim.addr_4byte);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_timing_busy (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_timing timing;
+	struct flash_master_sim_stats stats;
+	struct flash_xfer xfer;
+	uint8_t data[4] = {0};
+	uint8_t reg;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&timing, 0, sizeof (timing));
+	timing.page_program_us = 500;
+	flash_master_sim_set_timing (&sim, &timing);
+
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WREN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_WRITE (xfer, FLASH_CMD_PP, 0, 0, data, sizeof (data), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Commands other than status reads are ignored while busy. */
+	FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_WREN, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR, &reg, 1, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_STATUS_WIP, reg);
+
+	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR, &reg, 1, 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, reg);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 5, stats.xfers);
+	CuAssertIntEquals (test, 1, stats.ignored);
+	CuAssertIntEquals (test, 2, stats.status_reads);
+	CuAssertIntEquals (test, 1, stats.busy_polls);
+	CuAssertIntEquals (test, 500000, stats.time_ns);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_timing_bus (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_timing timing;
+	struct flash_master_sim_stats stats;
+	struct flash_xfer xfer;
+	uint8_t data[64];
+	int status;
+
+	TEST_START;
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&timing, 0, sizeof (timing));
+	timing.spi_clock_hz = 1000000;
+	timing.xfer_overhead_ns = 500;
+	flash_master_sim_set_timing (&sim, &timing);
+
+	/* 8 command clocks, 24 address clocks, 512 data clocks. */
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_READ, 0, 0, 0, data, sizeof (data), 0);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 544500, stats.time_ns);
+
+	/* 8 command clocks, 12 address, mode, and dummy clocks, 128 data clocks. */
+	FLASH_XFER_INIT_READ (xfer, FLASH_CMD_QIO_READ, 0, 2, 1, data, sizeof (data),
+		FLASH_FLAG_QUAD_ADDR | FLASH_FLAG_QUAD_DATA);
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 544500 + 148500, stats.time_ns);
+
+	flash_master_sim_reset_stats (&sim);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 0, stats.xfers);
+	CuAssertIntEquals (test, 0, stats.reads);
+	CuAssertIntEquals (test, 544500 + 148500, stats.time_ns);
+
+	flash_master_sim_set_timing (&sim, NULL);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 0, stats.time_ns);
+
+	status = sim.base.xfer (&sim.base, &xfer);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 0, stats.time_ns);
+
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_timing_spi_flash (CuTest *test)
+{
+	struct flash_master_sim sim;
+	struct flash_master_sim_stats stats;
+	struct spi_flash flash;
+	uint8_t data[256];
+	int status;
+
+	TEST_START;
+
+	memset (data, 0x55, sizeof (data));
+
+	status = flash_master_sim_init (&sim, &FLASH_MASTER_SIM_W25Q256JV);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_sim_set_timing (&sim, &FLASH_MASTER_SIM_TIMING_TYPICAL);
+	flash_master_sim_testing_init_spi_flash (test, &sim, &flash);
+	flash_master_sim_reset_stats (&sim);
+
+	status = spi_flash_sector_erase (&flash, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	flash_master_sim_get_stats (&sim, &stats);
+	CuAssertIntEquals (test, 1, stats.sector_erases);
+	CuAssertIntEquals (test, 1, stats.programs);
+	CuAssertIntEquals (test, 0, stats.ignored);
+	CuAssertTrue (test, (stats.time_ns >= ((45000 + 400) * 1000ULL)));
+
+	spi_flash_release (&flash);
+	flash_master_sim_release (&sim);
+}
+
+static void flash_master_sim_test_get_memory_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertPtrEquals (test, NULL, flash_master_sim_get_memory (NULL));
+}
+
+
+CuSuite* get_flash_master_sim_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, flash_master_sim_test_init);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_init_null);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_init_file);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_init_file_null);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_init_file_open_error);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_release_null);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_spi_flash_initialize_device);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_spi_flash_initialize_device_size);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_spi_flash_4byte_address_mode);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_spi_flash_write_read_erase);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_xfer_null);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_xfer_unsupported);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_program_only_clears_bits);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_program_page_wrap);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_write_without_write_enable);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_address_mode_mismatch);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_read_sfdp);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_status_4byte_mode);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_write_status_register);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_power_down);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_reset);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_timing_busy);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_timing_bus);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_timing_spi_flash);
+	SUITE_ADD_TEST (suite, flash_master_sim_test_get_memory_null);
+
+	return suite;
+}
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testing.h"
+#include "firmware/app_image.h"
+#include "crypto/hash_openssl.h"
+
+
+static const char *SUITE = "image_load_benchmark";
+
+
+/**
+ * Length of the image data to load.
+ */
+#define	IMAGE_LOAD_BENCHMARK_IMAGE_LEN		(4 * 1024 * 1024)
+
+/**
+ * Length of the header prepended to the image.
+ */
+#define	IMAGE_LOAD_BENCHMARK_HEADER_LEN		64
+
+/**
+ * Total length of the image on flash.
+ */
+#define	IMAGE_LOAD_BENCHMARK_FLASH_LEN		\
+	(IMAGE_LOAD_BENCHMARK_HEADER_LEN + 4 + IMAGE_LOAD_BENCHMARK_IMAGE_LEN + APP_IMAGE_SIG_LENGTH)
+
+
+/**
+ * Flash device backed by a buffer in memory.
+ */
+struct image_load_benchmark_flash {
+	struct flash base;			/**< The base flash interface. */
+	const uint8_t *data;		/**< The flash contents. */
+	size_t length;				/**< The size of the flash. */
+};
+
+static int image_load_benchmark_flash_read (struct flash *flash, uint32_t address, uint8_t *data,
+	size_t length)
+{
+	struct image_load_benchmark_flash *ram = (struct image_load_benchmark_flash*) flash;
+
+	if ((address + length) > ram->length) {
+		return FLASH_ADDRESS_OUT_OF_RANGE;
+	}
+
+	memcpy (data, &ram->data[address], length);
+	return 0;
+}
+
+static int image_load_benchmark_sig_verify (struct rsa_engine *engine,
+	const struct rsa_public_key *key, const uint8_t *signature, size_t sig_length,
+	const uint8_t *match, size_t match_length)
+{
+	return 0;
+}
+
+/*******************
+ * Test cases
+ *******************/
+
+static void image_load_benchmark_test_app_image (CuTest *test)
+{
+	struct hash_engine_openssl hash;
+	struct rsa_engine rsa;
+	struct rsa_public_key pub_key;
+	struct image_load_benchmark_flash flash;
+	uint8_t *image;
+	uint8_t *load_data;
+	uint8_t *load_streaming;
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t hash_streaming[SHA256_HASH_LENGTH];
+	size_t load_length = 0;
+	size_t streaming_length = 0;
+	uint32_t image_len = IMAGE_LOAD_BENCHMARK_IMAGE_LEN;
+	int status;
+	int i;
+
+	TEST_START;
+
+	image = malloc (IMAGE_LOAD_BENCHMARK_FLASH_LEN);
+	load_data = malloc (IMAGE_LOAD_BENCHMARK_IMAGE_LEN);
+	load_streaming = malloc (IMAGE_LOAD_BENCHMARK_IMAGE_LEN);
+	CuAssertPtrNotNull (test, image);
+	CuAssertPtrNotNull (test, load_data);
+	CuAssertPtrNotNull (test, load_streaming);
+
+	for (i = 0; i < IMAGE_LOAD_BENCHMARK_FLASH_LEN; i++) {
+		image[i] = (uint8_t) (i * 7);
+	}
+	memcpy (&image[IMAGE_LOAD_BENCHMARK_HEADER_LEN], &image_len, sizeof (image_len));
+
+	memset (&flash, 0, sizeof (flash));
+	flash.base.read = image_load_benchmark_flash_read;
+	flash.data = image;
+	flash.length = IMAGE_LOAD_BENCHMARK_FLASH_LEN;
+
+	memset (&rsa, 0, sizeof (rsa));
+	rsa.sig_verify = image_load_benchmark_sig_verify;
+	memset (&pub_key, 0, sizeof (pub_key));
+
+	status = hash_openssl_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_with_header (&flash.base, 0,
+		IMAGE_LOAD_BENCHMARK_HEADER_LEN, load_data, IMAGE_LOAD_BENCHMARK_IMAGE_LEN, &hash.base,
+		&rsa, &pub_key, hash_out, sizeof (hash_out), &load_length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_load_and_verify_with_header_streaming (&flash.base, 0,
+		IMAGE_LOAD_BENCHMARK_HEADER_LEN, load_streaming, IMAGE_LOAD_BENCHMARK_IMAGE_LEN,
+		&hash.base, &rsa, &pub_key, hash_streaming, sizeof (hash_streaming), &streaming_length);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, IMAGE_LOAD_BENCHMARK_IMAGE_LEN, load_length);
+	CuAssertIntEquals (test, load_length, streaming_length);
+
+	status = testing_validate_array (hash_out, hash_streaming, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (load_data, load_streaming, IMAGE_LOAD_BENCHMARK_IMAGE_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_openssl_release (&hash);
+	free (image);
+	free (load_data);
+	free (load_streaming);
+}
+
+
+CuSuite* get_image_load_benchmark_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, image_load_benchmark_test_app_image);
+
+	return suite;
+}
@@ -15,6 +15,9 @@
 //#define	TESTING_RUN_AES_OPENSSL_SUITE
 //#define	TESTING_RUN_BASE64_OPENSSL_SUITE
 //#define	TESTING_RUN_RNG_OPENSSL_SUITE
+//#define	TESTING_RUN_CHECKSUM_BENCHMARK_SUITE
+//#define	TESTING_RUN_IMAGE_LOAD_BENCHMARK_SUITE
+//#define	TESTING_RUN_FLASH_MASTER_SIM_SUITE
 
 
 CuSuite* get_hash_openssl_suite (void);
@@ -24,6 +27,9 @@ CuSuite* get_x509_openssl_suite (void);
 CuSuite* get_aes_openssl_suite (void);
 CuSuite* get_base64_openssl_suite (void);
 CuSuite* get_rng_openssl_suite (void);
+CuSuite* get_checksum_benchmark_suite (void);
+CuSuite* get_image_load_benchmark_suite (void);
+CuSuite* get_flash_master_sim_suite (void);
 
 void linux_teardown (CuTest *test)
 {
@@ -55,6 +61,15 @@ void add_all_linux_tests (CuSuite *suite)
 #ifdef TESTING_RUN_RNG_OPENSSL_SUITE
 	CuSuiteAddSuite (suite, get_rng_openssl_suite ());
 #endif
+#ifdef TESTING_RUN_CHECKSUM_BENCHMARK_SUITE
+	CuSuiteAddSuite (suite, get_checksum_benchmark_suite ());
+#endif
+#ifdef TESTING_RUN_IMAGE_LOAD_BENCHMARK_SUITE
+	CuSuiteAddSuite (suite, get_image_load_benchmark_suite ());
+#endif
+#ifdef TESTING_RUN_FLASH_MASTER_SIM_SUITE
+	CuSuiteAddSuite (suite, get_flash_master_sim_suite ());
+#endif
 
 	SUITE_ADD_TEST (suite, linux_teardown);
 }
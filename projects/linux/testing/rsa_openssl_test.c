@@ -96,6 +96,7 @@ static void rsa_openssl_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.get_public_key_der);
 	CuAssertPtrNotNull (test, engine.base.decrypt);
 	CuAssertPtrNotNull (test, engine.base.sig_verify);
+	CuAssertPtrNotNull (test, engine.base.invalidate_public_key);
 
 	rsa_openssl_release (&engine);
 }